@@ -201,7 +201,8 @@ void eae6320::Application::iApplication::UpdateUntilExit()
 			}
 		}
 		// Submit data for the render thread to use to render a new frame
-		// after it has finished rendering the current frame with the previously-submitted data
+		// as soon as one of the graphics frame packets is free
+		// (the render thread might still be rendering previously-submitted frames)
 		{
 			// Wait until the render thread is ready to accept new submitted data
 			{
@@ -253,6 +254,9 @@ void eae6320::Application::iApplication::UpdateUntilExit()
 					}();
 					Graphics::SubmitElapsedTime( elapsedSecondCount_systemTime, elapsedSecondCount_simulationTime );
 				}
+				// Submit when the input for this frame was read
+				// (UpdateBasedOnInput() was called right after the current loop's time was recorded)
+				Graphics::SubmitInputTime( tickCount_systemTime_currentLoop );
 			}
 			// Let the graphics system know that all of the data for this frame has been submitted
 			// (which means that it can start using it to render)
@@ -318,6 +322,7 @@ eae6320::cResult eae6320::Application::iApplication::Initialize_all( const sEntr
 		Logging::OutputError( "The application loop thread couldn't be started" );
 		return result;
 	}
+	m_applicationLoopThread.SetName( "Application Loop" );
 
 	return result;
 }
@@ -326,6 +331,14 @@ eae6320::cResult eae6320::Application::iApplication::Initialize_engine()
 {
 	auto result = Results::Success;
 
+	// Job System
+	{
+		if ( !( result = m_jobSystem.Initialize( GetJobSystemWorkerThreadCount() ) ) )
+		{
+			EAE6320_ASSERTF( false, "Application can't be initialized without the job system" );
+			return result;
+		}
+	}
 	// User Output
 	{
 		UserOutput::sInitializationParameters initializationParameters;
@@ -346,6 +359,7 @@ eae6320::cResult eae6320::Application::iApplication::Initialize_engine()
 	// Graphics
 	{
 		Graphics::sInitializationParameters initializationParameters;
+		initializationParameters.framePacketCount = GetGraphicsFramePacketCount();
 		if ( result = PopulateGraphicsInitializationParameters( initializationParameters ) )
 		{
 			if ( !( result = Graphics::Initialize( initializationParameters ) ) )
@@ -477,6 +491,18 @@ eae6320::cResult eae6320::Application::iApplication::CleanUp_engine()
 			}
 		}
 	}
+	// Job System
+	{
+		const auto result_jobSystem = m_jobSystem.CleanUp();
+		if ( !result_jobSystem )
+		{
+			EAE6320_ASSERTF( false, "The job system wasn't successfully cleaned up" );
+			if ( result )
+			{
+				result = result_jobSystem;
+			}
+		}
+	}
 
 	return result;
 }
@@ -12,6 +12,7 @@
 //=========
 
 #include <cstdint>
+#include <Engine/Concurrency/cJobSystem.h>
 #include <Engine/Concurrency/cThread.h>
 #include <Engine/Results/Results.h>
 
@@ -95,6 +96,9 @@ namespace eae6320
 			double GetElapsedSecondCount_systemTime() const;
 			double GetElapsedSecondCount_simulation() const;
 			void SetSimulationRate( const float i_simulationRate );
+			// Any thread can submit jobs,
+			// but the job system is only available between initialization and clean up
+			Concurrency::cJobSystem& GetJobSystem() { return m_jobSystem; }
 
 			// Run
 			//------
@@ -139,6 +143,20 @@ namespace eae6320
 			// and observe the change in responsiveness or simulation accuracy.
 			virtual float GetSimulationUpdatePeriod_inSeconds() const { return 1.0f / 15.0f; }
 
+			// The job system's worker threads share the CPU with the application loop thread and the render thread,
+			// and so by default there is one worker for every other hardware thread
+			// (but always at least one)
+			virtual unsigned int GetJobSystemWorkerThreadCount() const
+			{
+				const auto hardwareThreadCount = Concurrency::cJobSystem::GetHardwareThreadCount();
+				return ( hardwareThreadCount > 3 ) ? ( hardwareThreadCount - 2 ) : 1;
+			}
+
+			// The application loop can get ahead of the renderer by one frame less than this (see Graphics::sInitializationParameters).
+			// More packets let the two threads absorb each other's slow frames
+			// at the cost of showing input later
+			virtual unsigned int GetGraphicsFramePacketCount() const { return 2; }
+
 			// Run
 			//----
 
@@ -219,6 +237,8 @@ namespace eae6320
 			// (The original process thread (or "main thread") services operating system requests and the render loop,
 			// because many operating systems require those to use the same thread that they were created/initialized with)
 			Concurrency::cThread m_applicationLoopThread;
+			// The worker threads that run jobs submitted by the application and the engine
+			Concurrency::cJobSystem m_jobSystem;
 			// The rate that simulation time elapses relative to system time.
 			// At its default value of 1 the simulation runs in real time
 			// (this is usually what you want).
@@ -0,0 +1,21 @@
+/*
+	This file provides configurable settings
+	that can be used to modify the concurrency project
+*/
+
+#ifndef EAE6320_CONCURRENCY_CONFIGURATION_H
+#define EAE6320_CONCURRENCY_CONFIGURATION_H
+
+// The job system benchmark runs the same workloads with every possible number of worker threads at initialization
+// and writes how the time scales with the number of cores to the log
+//#define EAE6320_CONCURRENCY_ISJOBBENCHMARKENABLED
+
+// The synchronization benchmark measures cMutex and cEvent with and without contention at initialization
+// and writes how they compare to std::mutex and std::condition_variable to the log
+//#define EAE6320_CONCURRENCY_ISSYNCHRONIZATIONBENCHMARKENABLED
+
+// The queue benchmark stress tests the lock-free queues with different numbers of threads at initialization
+// and writes their throughput and latency compared to a mutex-protected queue to the log
+//#define EAE6320_CONCURRENCY_ISQUEUEBENCHMARKENABLED
+
+#endif	// EAE6320_CONCURRENCY_CONFIGURATION_H
@@ -5,13 +5,21 @@
 #ifndef EAE6320_CONCURRENCY_CONSTANTS_H
 #define EAE6320_CONCURRENCY_CONSTANTS_H
 
+// Includes
+//=========
+
+#include <cstddef>
+
 namespace eae6320
 {
 	namespace Concurrency
 	{
 		namespace Constants
 		{
-			constexpr auto DontTimeOut = ~unsigned int( 0u );
+			constexpr auto DontTimeOut = ~0u;
+			// Variables that are changed by different threads are kept this far apart
+			// so that they don't share a cache line ("false sharing")
+			constexpr size_t CacheLineSize = 64;
 		}
 	}
 }
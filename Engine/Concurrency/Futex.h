@@ -0,0 +1,48 @@
+/*
+	A futex ("fast user-space mutex") lets a thread sleep until another thread changes a word in memory
+
+	Unlike cEvent there is no kernel object:
+	the word is an ordinary atomic variable that threads can check and change without any system calls,
+	and the operating system is only asked to sleep or wake when a thread actually has to wait.
+	Windows implements this with WaitOnAddress() and Linux with the futex() system call.
+
+	Builds for Linux must define EAE6320_PLATFORM_LINUX
+	(the Linux implementations of this project are in the Linux folder).
+*/
+
+#ifndef EAE6320_CONCURRENCY_FUTEX_H
+#define EAE6320_CONCURRENCY_FUTEX_H
+
+// Includes
+//=========
+
+#include <atomic>
+#include <cstdint>
+#include <Engine/Results/Results.h>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		namespace Futex
+		{
+			// The calling thread sleeps while the word is equal to the value.
+			// This can return even if the word hasn't changed (a "spurious" wake up),
+			// and so it should always be called in a loop that checks the word again
+			void WaitWhileEqual( const std::atomic<uint32_t>& i_word, const uint32_t i_value );
+			// This version gives up after the time-out period elapses and returns Results::TimeOut
+			// (the caller is responsible for keeping track of how much time is left if it calls this in a loop)
+			cResult WaitWhileEqual( const std::atomic<uint32_t>& i_word, const uint32_t i_value, const unsigned int i_timeToWait_inMilliseconds );
+
+			// These wake threads that are sleeping in WaitWhileEqual() on the same word.
+			// The word should be changed before calling them
+			void WakeOne( std::atomic<uint32_t>& io_word );
+			void WakeAll( std::atomic<uint32_t>& io_word );
+		}
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_FUTEX_H
@@ -0,0 +1,68 @@
+// Includes
+//=========
+
+#include "../Futex.h"
+
+#include <cerrno>
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	long CallFutex( const std::atomic<uint32_t>& i_word, const int i_operation, const uint32_t i_value,
+		const struct timespec* const i_timeOut = nullptr );
+}
+
+// Interface
+//==========
+
+void eae6320::Concurrency::Futex::WaitWhileEqual( const std::atomic<uint32_t>& i_word, const uint32_t i_value )
+{
+	// The kernel returns immediately if the word has already changed (EAGAIN)
+	// and can also be interrupted by a signal (EINTR),
+	// and both of these are spurious wake ups that the caller handles
+	CallFutex( i_word, FUTEX_WAIT_PRIVATE, i_value );
+}
+
+eae6320::cResult eae6320::Concurrency::Futex::WaitWhileEqual( const std::atomic<uint32_t>& i_word, const uint32_t i_value,
+	const unsigned int i_timeToWait_inMilliseconds )
+{
+	// Unlike most pthread functions the futex time out is relative
+	struct timespec timeOut;
+	timeOut.tv_sec = static_cast<time_t>( i_timeToWait_inMilliseconds / 1000 );
+	timeOut.tv_nsec = static_cast<long>( i_timeToWait_inMilliseconds % 1000 ) * 1000000;
+	if ( ( CallFutex( i_word, FUTEX_WAIT_PRIVATE, i_value, &timeOut ) == -1 ) && ( errno == ETIMEDOUT ) )
+	{
+		return Results::TimeOut;
+	}
+	return Results::Success;
+}
+
+void eae6320::Concurrency::Futex::WakeOne( std::atomic<uint32_t>& io_word )
+{
+	CallFutex( io_word, FUTEX_WAKE_PRIVATE, 1 );
+}
+
+void eae6320::Concurrency::Futex::WakeAll( std::atomic<uint32_t>& io_word )
+{
+	CallFutex( io_word, FUTEX_WAKE_PRIVATE, INT_MAX );
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	long CallFutex( const std::atomic<uint32_t>& i_word, const int i_operation, const uint32_t i_value,
+		const struct timespec* const i_timeOut )
+	{
+		static_assert( sizeof( std::atomic<uint32_t> ) == sizeof( uint32_t ), "The kernel compares the atomic's memory directly" );
+		return syscall( SYS_futex, const_cast<std::atomic<uint32_t>*>( &i_word ), i_operation, i_value, i_timeOut, nullptr, 0 );
+	}
+}
@@ -0,0 +1,152 @@
+// Includes
+//=========
+
+#include "../cEvent.h"
+
+#include "../Futex.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <ctime>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	constexpr uint32_t s_state_unsignaled = 0;
+	constexpr uint32_t s_state_signaled = 1;
+
+	uint64_t GetCurrentTime_inMilliseconds();
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Concurrency::WaitForEvent( const eae6320::Concurrency::cEvent& i_event, const unsigned int i_timeToWait_inMilliseconds )
+{
+	if ( !i_event.m_isInitialized )
+	{
+		EAE6320_ASSERTF( false, "An event can't be waited for until it has been initialized" );
+		eae6320::Logging::OutputError( "An attempt was made to wait for an event that hadn't been initialized" );
+		return eae6320::Results::Failure;
+	}
+
+	// Waiting for an automatically-resetting event consumes the signal,
+	// and only one of the waiting threads can do that
+	const auto TryToConsumeSignal = [&i_event]()
+	{
+		if ( i_event.m_type == EventType::RemainSignaledUntilReset )
+		{
+			return i_event.m_state.load() == s_state_signaled;
+		}
+		else
+		{
+			auto state = s_state_signaled;
+			return i_event.m_state.compare_exchange_strong( state, s_state_unsignaled );
+		}
+	};
+
+	// If the event has already happened then no system call is needed
+	if ( TryToConsumeSignal() )
+	{
+		return eae6320::Results::Success;
+	}
+	else if ( i_timeToWait_inMilliseconds == 0 )
+	{
+		return eae6320::Results::TimeOut;
+	}
+
+	const auto shouldTimeOut = i_timeToWait_inMilliseconds != eae6320::Concurrency::Constants::DontTimeOut;
+	const auto timeToStopWaiting = shouldTimeOut ? ( GetCurrentTime_inMilliseconds() + i_timeToWait_inMilliseconds ) : 0;
+	auto result = eae6320::Results::Success;
+	// The waiting count is incremented before the state is checked again,
+	// and Signal() changes the state before it checks the waiting count,
+	// and so either this thread will see the signal or the signaling thread will see this one and wake it up
+	i_event.m_waitingThreadCount.fetch_add( 1 );
+	while ( !TryToConsumeSignal() )
+	{
+		if ( shouldTimeOut )
+		{
+			const auto currentTime = GetCurrentTime_inMilliseconds();
+			if ( currentTime >= timeToStopWaiting )
+			{
+				result = eae6320::Results::TimeOut;
+				break;
+			}
+			eae6320::Concurrency::Futex::WaitWhileEqual( i_event.m_state, s_state_unsignaled,
+				static_cast<unsigned int>( timeToStopWaiting - currentTime ) );
+		}
+		else
+		{
+			eae6320::Concurrency::Futex::WaitWhileEqual( i_event.m_state, s_state_unsignaled );
+		}
+	}
+	i_event.m_waitingThreadCount.fetch_sub( 1 );
+
+	return result;
+}
+
+eae6320::cResult eae6320::Concurrency::cEvent::Signal()
+{
+	EAE6320_ASSERTF( m_isInitialized, "An event can't be signaled until it has been initialized" );
+	m_state.exchange( s_state_signaled );
+	if ( m_waitingThreadCount.load() > 0 )
+	{
+		// Only one thread can consume the signal of an automatically-resetting event
+		if ( m_type == EventType::ResetAutomaticallyAfterBeingSignaled )
+		{
+			Futex::WakeOne( m_state );
+		}
+		else
+		{
+			Futex::WakeAll( m_state );
+		}
+	}
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Concurrency::cEvent::ResetToUnsignaled()
+{
+	EAE6320_ASSERTF( m_isInitialized, "An event can't be reset until it has been initialized" );
+	m_state.store( s_state_unsignaled );
+	return Results::Success;
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Concurrency::cEvent::Initialize( const EventType i_type, const EventState i_initialState )
+{
+	// Unlike a Windows event there is nothing to create
+	m_type = i_type;
+	m_state.store( ( i_initialState == EventState::Signaled ) ? s_state_signaled : s_state_unsignaled );
+	m_isInitialized = true;
+	return Results::Success;
+}
+
+eae6320::Concurrency::cEvent::cEvent()
+{
+
+}
+
+eae6320::cResult eae6320::Concurrency::cEvent::CleanUp()
+{
+	EAE6320_ASSERTF( m_waitingThreadCount.load() == 0, "An event is being cleaned up while threads are waiting for it" );
+	m_isInitialized = false;
+	return Results::Success;
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	uint64_t GetCurrentTime_inMilliseconds()
+	{
+		// The monotonic clock isn't affected by changes to the system time
+		struct timespec currentTime;
+		clock_gettime( CLOCK_MONOTONIC, &currentTime );
+		return ( static_cast<uint64_t>( currentTime.tv_sec ) * 1000u ) + ( static_cast<uint64_t>( currentTime.tv_nsec ) / 1000000u );
+	}
+}
@@ -0,0 +1,110 @@
+// Includes
+//=========
+
+#include "../cMutex.h"
+
+#include "../Futex.h"
+
+#if defined( __SSE2__ )
+	#include <emmintrin.h>
+#else
+	#include <thread>
+#endif
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	constexpr uint32_t s_state_unlocked = 0;
+	constexpr uint32_t s_state_locked = 1;
+	constexpr uint32_t s_state_lockedWithWaiters = 2;
+
+	// A mutex is usually only held for a short time,
+	// and so a thread that can't acquire it tries again this many times before it sleeps
+	constexpr unsigned int s_spinCountBeforeSleeping = 128;
+
+	void Pause();
+}
+
+// Interface
+//==========
+
+// This is the three-state futex mutex described in Ulrich Drepper's "Futexes Are Tricky"
+
+void eae6320::Concurrency::cMutex::Lock()
+{
+	// Uncontended
+	auto state = s_state_unlocked;
+	if ( m_state.compare_exchange_strong( state, s_state_locked, std::memory_order_acquire, std::memory_order_relaxed ) )
+	{
+		return;
+	}
+	// Spin briefly in case the thread that holds the lock releases it soon
+	for ( unsigned int i = 0; ( i < s_spinCountBeforeSleeping ) && ( state != s_state_lockedWithWaiters ); ++i )
+	{
+		Pause();
+		state = m_state.load( std::memory_order_relaxed );
+		if ( ( state == s_state_unlocked )
+			&& m_state.compare_exchange_strong( state, s_state_locked, std::memory_order_acquire, std::memory_order_relaxed ) )
+		{
+			return;
+		}
+	}
+	// Sleep until the lock is released.
+	// Once a thread has slept it can't know whether other threads are still sleeping,
+	// and so it always acquires the lock in the "with waiters" state
+	// (which can cause an unnecessary wake up but never a missed one)
+	if ( state != s_state_lockedWithWaiters )
+	{
+		state = m_state.exchange( s_state_lockedWithWaiters, std::memory_order_acquire );
+	}
+	while ( state != s_state_unlocked )
+	{
+		Futex::WaitWhileEqual( m_state, s_state_lockedWithWaiters );
+		state = m_state.exchange( s_state_lockedWithWaiters, std::memory_order_acquire );
+	}
+}
+
+eae6320::cResult eae6320::Concurrency::cMutex::LockIfPossible()
+{
+	auto state = s_state_unlocked;
+	return m_state.compare_exchange_strong( state, s_state_locked, std::memory_order_acquire, std::memory_order_relaxed )
+		? Results::Success : Results::Failure;
+}
+
+void eae6320::Concurrency::cMutex::Unlock()
+{
+	if ( m_state.exchange( s_state_unlocked, std::memory_order_release ) == s_state_lockedWithWaiters )
+	{
+		Futex::WakeOne( m_state );
+	}
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::Concurrency::cMutex::cMutex()
+{
+
+}
+
+eae6320::Concurrency::cMutex::~cMutex()
+{
+
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	void Pause()
+	{
+#if defined( __SSE2__ )
+		_mm_pause();
+#else
+		std::this_thread::yield();
+#endif
+	}
+}
@@ -0,0 +1,220 @@
+// Includes
+//=========
+
+#include "../cThread.h"
+
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <new>
+#include <sched.h>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// pthreads requires a different function signature for its thread functions,
+	// and so the user-provided data is passed to a generic pthread-appropriate function
+	struct sThreadData
+	{
+		eae6320::Concurrency::fThreadFunction threadFunction;
+		void* userData;
+	};
+	void* EntryPoint_thread( void* const io_threadData );
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Concurrency::cThread::Start( fThreadFunction const i_threadFunction, void* const io_userData )
+{
+	if ( m_isRunning )
+	{
+		EAE6320_ASSERTF( false, "A thread can't be started if it is already running" );
+		Logging::OutputError( "An attempt was made to start a thread that was already running" );
+		return Results::Failure;
+	}
+
+	// Unlike Windows the new thread owns its data
+	// (and so the calling thread doesn't have to wait for the data to be extracted)
+	auto* const threadData = new ( std::nothrow ) sThreadData{ i_threadFunction, io_userData };
+	if ( !threadData )
+	{
+		EAE6320_ASSERTF( false, "Couldn't allocate thread data" );
+		Logging::OutputError( "Failed to allocate data for a new thread" );
+		return Results::OutOfMemory;
+	}
+	constexpr pthread_attr_t* const useDefaultAttributes = nullptr;
+	const auto errorCode = pthread_create( &m_thread, useDefaultAttributes, EntryPoint_thread, threadData );
+	if ( errorCode != 0 )
+	{
+		delete threadData;
+		EAE6320_ASSERTF( false, "Couldn't start a thread: %s", strerror( errorCode ) );
+		Logging::OutputError( "pthreads failed to start a thread: %s", strerror( errorCode ) );
+		return Results::Failure;
+	}
+	m_isRunning = true;
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Concurrency::cThread::SetName( const char* const i_name )
+{
+	if ( !m_isRunning )
+	{
+		EAE6320_ASSERTF( false, "A thread can't be named until it has been started" );
+		Logging::OutputError( "An attempt was made to name a thread that hadn't been started" );
+		return Results::Failure;
+	}
+	// Linux thread names are limited to 16 bytes (including the terminating null),
+	// and pthreads fails rather than truncating a longer name
+	char name[16];
+	strncpy( name, i_name, sizeof( name ) - 1 );
+	name[sizeof( name ) - 1] = '\0';
+	const auto errorCode = pthread_setname_np( m_thread, name );
+	if ( errorCode == 0 )
+	{
+		return Results::Success;
+	}
+	else
+	{
+		EAE6320_ASSERTF( false, "Couldn't name a thread \"%s\": %s", i_name, strerror( errorCode ) );
+		Logging::OutputError( "pthreads failed to name a thread \"%s\": %s", i_name, strerror( errorCode ) );
+		return Results::Failure;
+	}
+}
+
+eae6320::cResult eae6320::Concurrency::cThread::SetAffinity( const uint64_t i_hardwareThreadMask )
+{
+	if ( !m_isRunning )
+	{
+		EAE6320_ASSERTF( false, "A thread's affinity can't be set until it has been started" );
+		Logging::OutputError( "An attempt was made to set the affinity of a thread that hadn't been started" );
+		return Results::Failure;
+	}
+	cpu_set_t hardwareThreads;
+	CPU_ZERO( &hardwareThreads );
+	for ( unsigned int i = 0; i < 64; ++i )
+	{
+		if ( ( i_hardwareThreadMask & ( uint64_t( 1 ) << i ) ) != 0 )
+		{
+			CPU_SET( i, &hardwareThreads );
+		}
+	}
+	const auto errorCode = pthread_setaffinity_np( m_thread, sizeof( hardwareThreads ), &hardwareThreads );
+	if ( errorCode == 0 )
+	{
+		return Results::Success;
+	}
+	else
+	{
+		EAE6320_ASSERTF( false, "Couldn't set a thread's affinity to 0x%llx: %s",
+			static_cast<unsigned long long>( i_hardwareThreadMask ), strerror( errorCode ) );
+		Logging::OutputError( "pthreads failed to set a thread's affinity to 0x%llx: %s",
+			static_cast<unsigned long long>( i_hardwareThreadMask ), strerror( errorCode ) );
+		return Results::Failure;
+	}
+}
+
+eae6320::cResult eae6320::Concurrency::WaitForThreadToStop( cThread& io_thread, const unsigned int i_timeToWait_inMilliseconds )
+{
+	if ( io_thread.m_isRunning )
+	{
+		constexpr void** const dontReturnValue = nullptr;
+		int errorCode;
+		if ( i_timeToWait_inMilliseconds == Constants::DontTimeOut )
+		{
+			errorCode = pthread_join( io_thread.m_thread, dontReturnValue );
+		}
+		else if ( i_timeToWait_inMilliseconds == 0 )
+		{
+			errorCode = pthread_tryjoin_np( io_thread.m_thread, dontReturnValue );
+		}
+		else
+		{
+			// The time out is an absolute time
+			timespec timeOut;
+			clock_gettime( CLOCK_REALTIME, &timeOut );
+			const auto nanosecondCount = static_cast<uint64_t>( timeOut.tv_nsec ) + ( uint64_t( i_timeToWait_inMilliseconds ) * 1000000u );
+			timeOut.tv_sec += static_cast<time_t>( nanosecondCount / 1000000000u );
+			timeOut.tv_nsec = static_cast<long>( nanosecondCount % 1000000000u );
+			errorCode = pthread_timedjoin_np( io_thread.m_thread, dontReturnValue, &timeOut );
+		}
+		switch ( errorCode )
+		{
+		// The thread exited
+		case 0:
+			// The thread has been joined, and so there is nothing left to clean up
+			io_thread.m_isRunning = false;
+			return Results::Success;
+		// The time-out period elapsed before the thread exited
+		case EBUSY:
+		case ETIMEDOUT:
+			return Results::TimeOut;
+		default:
+			EAE6320_ASSERTF( false, "Failed to wait for a thread to exit: %s", strerror( errorCode ) );
+			Logging::OutputError( "pthreads failed waiting for a thread to exit: %s", strerror( errorCode ) );
+		}
+		return Results::Failure;
+	}
+	else
+	{
+		EAE6320_ASSERTF( false, "A thread can't be waited on to exit if it hasn't been started" );
+		return Results::Success;
+	}
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::Concurrency::cThread::cThread()
+{
+
+}
+
+// Implementation
+//===============
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Concurrency::cThread::CleanUp()
+{
+	auto result = Results::Success;
+
+	if ( m_isRunning )
+	{
+		// A thread that is still running when its cThread goes away keeps running
+		// (the same as closing the handle of a Windows thread),
+		// and detaching it lets pthreads free it when it exits
+		const auto errorCode = pthread_detach( m_thread );
+		if ( errorCode != 0 )
+		{
+			EAE6320_ASSERTF( false, "Couldn't detach a thread: %s", strerror( errorCode ) );
+			Logging::OutputError( "pthreads failed to detach a thread: %s", strerror( errorCode ) );
+			result = Results::Failure;
+		}
+		m_isRunning = false;
+	}
+
+	return result;
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	void* EntryPoint_thread( void* const io_threadData )
+	{
+		auto* const threadData = static_cast<sThreadData*>( io_threadData );
+		const auto threadFunction = std::move( threadData->threadFunction );
+		auto* const userData = threadData->userData;
+		delete threadData;
+		// Call the user-provided function with the user-provided data
+		threadFunction( userData );
+		return nullptr;
+	}
+}
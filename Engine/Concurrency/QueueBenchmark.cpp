@@ -0,0 +1,285 @@
+// Includes
+//=========
+
+#include "QueueBenchmark.h"
+
+#ifdef EAE6320_CONCURRENCY_ISQUEUEBENCHMARKENABLED
+	#include "cMpmcQueue.h"
+	#include "cMpscQueue.h"
+	#include "cMutex.h"
+	#include "cSpscQueue.h"
+	#include "cThread.h"
+
+	#include <algorithm>
+	#include <atomic>
+	#include <deque>
+	#include <Engine/Asserts/Asserts.h>
+	#include <Engine/Logging/Logging.h>
+	#include <Engine/Time/Time.h>
+	#include <memory>
+	#include <thread>
+	#include <vector>
+#endif
+
+#ifdef EAE6320_CONCURRENCY_ISQUEUEBENCHMARKENABLED
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	constexpr size_t s_queueCapacity = 1024;
+	// Every configuration transfers this many messages in total
+	// (split evenly between the producers)
+	constexpr uint32_t s_messageCount = 1 << 21;
+	// Reading the time for every message would slow the producers down more than the queue does,
+	// and so only every nth message records when it was pushed
+	constexpr uint32_t s_latencySampleInterval = 16;
+
+	struct sMessage
+	{
+		uint32_t producerIndex = 0;
+		uint32_t sequence = 0;
+		uint64_t tickCount_pushed = 0;
+	};
+
+	// The lock-free queues are compared with this
+	class cLockedQueue
+	{
+	public:
+		bool TryToPush( const sMessage& i_message );
+		bool TryToPop( sMessage& o_message );
+	private:
+		eae6320::Concurrency::cMutex m_mutex;
+		std::deque<sMessage> m_messages;
+	};
+
+	struct sMeasurement
+	{
+		double messagesPerSecond = 0.0;
+		double latency_99thPercentile_inMicroseconds = 0.0;
+		bool wereMessagesCorrect = false;
+	};
+
+	template<typename tQueue>
+	sMeasurement Measure( tQueue& io_queue, const unsigned int i_producerCount, const unsigned int i_consumerCount );
+	void OutputMeasurements( const char* const i_queueName, const unsigned int i_producerCount, const unsigned int i_consumerCount,
+		const sMeasurement& i_measurement, const sMeasurement& i_measurement_locked );
+}
+
+// Interface
+//==========
+
+void eae6320::Concurrency::RunQueueBenchmark()
+{
+	constexpr unsigned int producerCounts_mpsc[] = { 1, 2, 4, 8 };
+	constexpr unsigned int threadCounts_mpmc[] = { 1, 2, 4 };
+
+	Logging::OutputMessage( "Queue benchmark (%u messages per configuration, capacity %zu):", s_messageCount, s_queueCapacity );
+	// The queues are allocated rather than put on the stack because of their size
+	{
+		auto queue = std::make_unique<cSpscQueue<sMessage, s_queueCapacity>>();
+		auto queue_locked = std::make_unique<cLockedQueue>();
+		const auto measurement = Measure( *queue, 1, 1 );
+		OutputMeasurements( "cSpscQueue", 1, 1, measurement, Measure( *queue_locked, 1, 1 ) );
+	}
+	for ( const auto producerCount : producerCounts_mpsc )
+	{
+		auto queue = std::make_unique<cMpscQueue<sMessage, s_queueCapacity>>();
+		auto queue_locked = std::make_unique<cLockedQueue>();
+		const auto measurement = Measure( *queue, producerCount, 1 );
+		OutputMeasurements( "cMpscQueue", producerCount, 1, measurement, Measure( *queue_locked, producerCount, 1 ) );
+	}
+	for ( const auto threadCount : threadCounts_mpmc )
+	{
+		auto queue = std::make_unique<cMpmcQueue<sMessage, s_queueCapacity>>();
+		auto queue_locked = std::make_unique<cLockedQueue>();
+		const auto measurement = Measure( *queue, threadCount, threadCount );
+		OutputMeasurements( "cMpmcQueue", threadCount, threadCount, measurement, Measure( *queue_locked, threadCount, threadCount ) );
+	}
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	bool cLockedQueue::TryToPush( const sMessage& i_message )
+	{
+		eae6320::Concurrency::cMutex::cScopeLock scopeLock( m_mutex );
+		if ( m_messages.size() >= s_queueCapacity )
+		{
+			return false;
+		}
+		m_messages.push_back( i_message );
+		return true;
+	}
+
+	bool cLockedQueue::TryToPop( sMessage& o_message )
+	{
+		eae6320::Concurrency::cMutex::cScopeLock scopeLock( m_mutex );
+		if ( m_messages.empty() )
+		{
+			return false;
+		}
+		o_message = m_messages.front();
+		m_messages.pop_front();
+		return true;
+	}
+
+	template<typename tQueue>
+	sMeasurement Measure( tQueue& io_queue, const unsigned int i_producerCount, const unsigned int i_consumerCount )
+	{
+		sMeasurement measurement;
+
+		const auto messageCountPerProducer = s_messageCount / i_producerCount;
+		const auto messageCount = messageCountPerProducer * i_producerCount;
+		std::atomic<bool> shouldStart = false;
+		// If a thread can't be started then the others give up
+		// rather than waiting for messages that will never come
+		std::atomic<bool> shouldQuit = false;
+		std::atomic<uint32_t> poppedMessageCount = 0;
+		std::atomic<uint64_t> poppedMessageSum = 0;
+		std::atomic<bool> wereMessagesInOrder = true;
+		std::vector<std::vector<uint64_t>> latencies_inTicks( i_consumerCount );
+
+		const auto threadCount = i_producerCount + i_consumerCount;
+		std::unique_ptr<eae6320::Concurrency::cThread[]> threads( new eae6320::Concurrency::cThread[threadCount] );
+		unsigned int startedThreadCount = 0;
+		for ( ; startedThreadCount < threadCount; ++startedThreadCount )
+		{
+			eae6320::cResult result;
+			if ( startedThreadCount < i_producerCount )
+			{
+				const auto producerIndex = startedThreadCount;
+				result = threads[startedThreadCount].Start(
+					[&io_queue, &shouldStart, &shouldQuit, messageCountPerProducer, producerIndex]( void* const )
+					{
+						while ( !shouldStart.load() )
+						{
+							std::this_thread::yield();
+						}
+						for ( uint32_t i = 0; i < messageCountPerProducer; ++i )
+						{
+							const sMessage message{ producerIndex, i,
+								( ( i % s_latencySampleInterval ) == 0 ) ? eae6320::Time::GetCurrentSystemTimeTickCount() : 0 };
+							while ( !io_queue.TryToPush( message ) )
+							{
+								if ( shouldQuit.load( std::memory_order_relaxed ) )
+								{
+									return;
+								}
+								std::this_thread::yield();
+							}
+						}
+					} );
+			}
+			else
+			{
+				auto& latencies = latencies_inTicks[startedThreadCount - i_producerCount];
+				latencies.reserve( ( messageCount / s_latencySampleInterval ) + i_producerCount );
+				result = threads[startedThreadCount].Start(
+					[&io_queue, &shouldStart, &shouldQuit, &poppedMessageCount, &poppedMessageSum, &wereMessagesInOrder, &latencies,
+						i_producerCount, messageCountPerProducer, messageCount]( void* const )
+					{
+						// Other consumers can take some of a producer's messages,
+						// but the ones that this consumer pops must still be in the order that they were pushed
+						std::vector<uint32_t> nextSequences( i_producerCount, 0 );
+						bool wereMessagesInOrder_thisConsumer = true;
+						uint64_t messageSum = 0;
+						while ( !shouldStart.load() )
+						{
+							std::this_thread::yield();
+						}
+						while ( ( poppedMessageCount.load( std::memory_order_relaxed ) < messageCount ) && !shouldQuit.load( std::memory_order_relaxed ) )
+						{
+							sMessage message;
+							if ( io_queue.TryToPop( message ) )
+							{
+								if ( message.tickCount_pushed != 0 )
+								{
+									latencies.push_back( eae6320::Time::GetCurrentSystemTimeTickCount() - message.tickCount_pushed );
+								}
+								if ( ( message.producerIndex < i_producerCount ) && ( message.sequence >= nextSequences[message.producerIndex] ) )
+								{
+									nextSequences[message.producerIndex] = message.sequence + 1;
+								}
+								else
+								{
+									wereMessagesInOrder_thisConsumer = false;
+								}
+								messageSum += ( uint64_t( message.producerIndex ) * messageCountPerProducer ) + message.sequence;
+								poppedMessageCount.fetch_add( 1, std::memory_order_relaxed );
+							}
+							else
+							{
+								std::this_thread::yield();
+							}
+						}
+						poppedMessageSum += messageSum;
+						if ( !wereMessagesInOrder_thisConsumer )
+						{
+							wereMessagesInOrder = false;
+						}
+					} );
+			}
+			if ( !result )
+			{
+				eae6320::Logging::OutputError( "\tA benchmark thread couldn't be started" );
+				shouldQuit = true;
+				break;
+			}
+		}
+
+		const auto tickCount_start = eae6320::Time::GetCurrentSystemTimeTickCount();
+		shouldStart = true;
+		for ( unsigned int i = 0; i < startedThreadCount; ++i )
+		{
+			WaitForThreadToStop( threads[i] );
+		}
+		const auto secondCount = eae6320::Time::ConvertTicksToSeconds( eae6320::Time::GetCurrentSystemTimeTickCount() - tickCount_start );
+		if ( shouldQuit )
+		{
+			return measurement;
+		}
+
+		// Every message must have been popped exactly once
+		// (the sum of every message's unique number would be wrong if any were lost or duplicated)
+		{
+			const auto expectedSum = ( uint64_t( messageCount ) * ( messageCount - 1 ) ) / 2;
+			sMessage message;
+			measurement.wereMessagesCorrect = wereMessagesInOrder && ( poppedMessageSum == expectedSum ) && !io_queue.TryToPop( message );
+		}
+		measurement.messagesPerSecond = ( secondCount > 0.0 ) ? ( messageCount / secondCount ) : 0.0;
+		{
+			std::vector<uint64_t> latencies;
+			for ( const auto& latencies_consumer : latencies_inTicks )
+			{
+				latencies.insert( latencies.end(), latencies_consumer.begin(), latencies_consumer.end() );
+			}
+			if ( !latencies.empty() )
+			{
+				const auto percentileIndex = ( latencies.size() * 99 ) / 100;
+				std::nth_element( latencies.begin(), latencies.begin() + percentileIndex, latencies.end() );
+				measurement.latency_99thPercentile_inMicroseconds = eae6320::Time::ConvertTicksToSeconds( latencies[percentileIndex] ) * 1.0e6;
+			}
+		}
+
+		return measurement;
+	}
+
+	void OutputMeasurements( const char* const i_queueName, const unsigned int i_producerCount, const unsigned int i_consumerCount,
+		const sMeasurement& i_measurement, const sMeasurement& i_measurement_locked )
+	{
+		EAE6320_ASSERTF( i_measurement.wereMessagesCorrect, "%s lost, duplicated, or reordered messages with %u producer(s) and %u consumer(s)",
+			i_queueName, i_producerCount, i_consumerCount );
+		eae6320::Logging::OutputMessage( "\t%s, %u -> %u: %.2f million messages/s (99th percentile latency %.1f us),"
+			" cMutex + std::deque %.2f million messages/s (99th percentile latency %.1f us)%s",
+			i_queueName, i_producerCount, i_consumerCount,
+			i_measurement.messagesPerSecond * 1.0e-6, i_measurement.latency_99thPercentile_inMicroseconds,
+			i_measurement_locked.messagesPerSecond * 1.0e-6, i_measurement_locked.latency_99thPercentile_inMicroseconds,
+			i_measurement.wereMessagesCorrect ? "" : " (THE MESSAGES WERE WRONG!)" );
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_ISQUEUEBENCHMARKENABLED
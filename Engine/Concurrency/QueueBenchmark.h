@@ -0,0 +1,34 @@
+/*
+	The queue benchmark stress tests cSpscQueue, cMpscQueue, and cMpmcQueue
+	and measures their throughput and latency with different numbers of threads
+*/
+
+#ifndef EAE6320_CONCURRENCY_QUEUEBENCHMARK_H
+#define EAE6320_CONCURRENCY_QUEUEBENCHMARK_H
+
+// Includes
+//=========
+
+#include "Configuration.h"
+
+// Interface
+//==========
+
+#ifdef EAE6320_CONCURRENCY_ISQUEUEBENCHMARKENABLED
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		// Every configuration checks that each element was popped exactly once
+		// and that no consumer saw a producer's elements out of order
+		// (a failure is asserted and written to the log),
+		// and then the operations per second and the 99th percentile push-to-pop latency are written to the log.
+		// A mutex-protected queue is measured with the same configurations for comparison
+		void RunQueueBenchmark();
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_ISQUEUEBENCHMARKENABLED
+
+#endif	// EAE6320_CONCURRENCY_QUEUEBENCHMARK_H
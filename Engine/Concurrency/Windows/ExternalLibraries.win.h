@@ -8,3 +8,5 @@
 //===================
 
 #pragma comment( lib, "Kernel32.lib" )
+// WaitOnAddress() and WakeByAddress*() (see Futex.h)
+#pragma comment( lib, "Synchronization.lib" )
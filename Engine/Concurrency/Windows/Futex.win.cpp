@@ -0,0 +1,57 @@
+// Includes
+//=========
+
+#include "../Futex.h"
+
+#include "ExternalLibraries.win.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Windows/Functions.h>
+#include <Engine/Windows/Includes.h>
+
+// Interface
+//==========
+
+void eae6320::Concurrency::Futex::WaitWhileEqual( const std::atomic<uint32_t>& i_word, const uint32_t i_value )
+{
+	static_assert( sizeof( std::atomic<uint32_t> ) == sizeof( uint32_t ), "Windows compares the atomic's memory directly" );
+	auto value = i_value;
+	// The only error is a time out, which can't happen without a time-out period
+	WaitOnAddress( const_cast<std::atomic<uint32_t>*>( &i_word ), &value, sizeof( value ), INFINITE );
+}
+
+eae6320::cResult eae6320::Concurrency::Futex::WaitWhileEqual( const std::atomic<uint32_t>& i_word, const uint32_t i_value,
+	const unsigned int i_timeToWait_inMilliseconds )
+{
+	auto value = i_value;
+	if ( WaitOnAddress( const_cast<std::atomic<uint32_t>*>( &i_word ), &value, sizeof( value ), static_cast<DWORD>( i_timeToWait_inMilliseconds ) ) != FALSE )
+	{
+		return Results::Success;
+	}
+	else
+	{
+		const auto errorCode = GetLastError();
+		if ( errorCode == ERROR_TIMEOUT )
+		{
+			return Results::TimeOut;
+		}
+		else
+		{
+			const auto errorMessage = Windows::GetFormattedSystemMessage( errorCode );
+			EAE6320_ASSERTF( false, "Failed to wait on an address: %s", errorMessage.c_str() );
+			Logging::OutputError( "Windows failed waiting on an address: %s", errorMessage.c_str() );
+			return Results::Failure;
+		}
+	}
+}
+
+void eae6320::Concurrency::Futex::WakeOne( std::atomic<uint32_t>& io_word )
+{
+	WakeByAddressSingle( &io_word );
+}
+
+void eae6320::Concurrency::Futex::WakeAll( std::atomic<uint32_t>& io_word )
+{
+	WakeByAddressAll( &io_word );
+}
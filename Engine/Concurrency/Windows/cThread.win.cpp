@@ -140,6 +140,50 @@ eae6320::cResult eae6320::Concurrency::cThread::Start( fThreadFunction const i_t
 	return result;
 }
 
+eae6320::cResult eae6320::Concurrency::cThread::SetName( const char* const i_name )
+{
+	if ( !m_handle )
+	{
+		EAE6320_ASSERTF( false, "A thread can't be named until it has been started" );
+		Logging::OutputError( "An attempt was made to name a thread that hadn't been started" );
+		return Results::Failure;
+	}
+	const auto name = Windows::ConvertUtf8ToUtf16( i_name );
+	const auto result = SetThreadDescription( m_handle, name.c_str() );
+	if ( SUCCEEDED( result ) )
+	{
+		return Results::Success;
+	}
+	else
+	{
+		const auto errorMessage = Windows::GetFormattedSystemMessage( static_cast<DWORD>( result ) );
+		EAE6320_ASSERTF( false, "Couldn't name a thread \"%s\": %s", i_name, errorMessage.c_str() );
+		Logging::OutputError( "Windows failed to name a thread \"%s\": %s", i_name, errorMessage.c_str() );
+		return Results::Failure;
+	}
+}
+
+eae6320::cResult eae6320::Concurrency::cThread::SetAffinity( const uint64_t i_hardwareThreadMask )
+{
+	if ( !m_handle )
+	{
+		EAE6320_ASSERTF( false, "A thread's affinity can't be set until it has been started" );
+		Logging::OutputError( "An attempt was made to set the affinity of a thread that hadn't been started" );
+		return Results::Failure;
+	}
+	if ( SetThreadAffinityMask( m_handle, static_cast<DWORD_PTR>( i_hardwareThreadMask ) ) != 0 )
+	{
+		return Results::Success;
+	}
+	else
+	{
+		const auto errorMessage = Windows::GetLastSystemError();
+		EAE6320_ASSERTF( false, "Couldn't set a thread's affinity to 0x%llx: %s", i_hardwareThreadMask, errorMessage.c_str() );
+		Logging::OutputError( "Windows failed to set a thread's affinity to 0x%llx: %s", i_hardwareThreadMask, errorMessage.c_str() );
+		return Results::Failure;
+	}
+}
+
 eae6320::cResult eae6320::Concurrency::WaitForThreadToStop( cThread& io_thread, const unsigned int i_timeToWait_inMilliseconds )
 {
 	if ( io_thread.m_handle )
@@ -5,9 +5,129 @@
 
 #include <Engine/Asserts/Asserts.h>
 
+#ifdef EAE6320_CONCURRENCY_ISSYNCHRONIZATIONBENCHMARKENABLED
+	#include "cThread.h"
+
+	#include <condition_variable>
+	#include <Engine/Logging/Logging.h>
+	#include <Engine/Time/Time.h>
+	#include <mutex>
+#endif
+
 // Interface
 //==========
 
+#ifdef EAE6320_CONCURRENCY_ISSYNCHRONIZATIONBENCHMARKENABLED
+
+void eae6320::Concurrency::cEvent::RunBenchmark()
+{
+	constexpr unsigned int signalCount_uncontended = 1000000;
+	constexpr unsigned int roundTripCount = 20000;
+
+	// The two kinds of event are wrapped in the same interface
+	// so that the same code can measure both of them
+	// (both behave like an automatically-resetting event)
+	struct sEngineEvent
+	{
+		cEvent event;
+		sEngineEvent()
+		{
+			const auto result = event.Initialize( EventType::ResetAutomaticallyAfterBeingSignaled );
+			EAE6320_ASSERT( result );
+		}
+		void Signal() { event.Signal(); }
+		void Wait() { WaitForEvent( event ); }
+	};
+	struct sStandardEvent
+	{
+		std::mutex mutex;
+		std::condition_variable conditionVariable;
+		bool isSignaled = false;
+		void Signal()
+		{
+			{
+				std::lock_guard<std::mutex> lock( mutex );
+				isSignaled = true;
+			}
+			conditionVariable.notify_one();
+		}
+		void Wait()
+		{
+			std::unique_lock<std::mutex> lock( mutex );
+			conditionVariable.wait( lock, [this]() { return isSignaled; } );
+			isSignaled = false;
+		}
+	};
+
+	const auto GetMilliseconds = []( const uint64_t i_tickCount )
+	{
+		return Time::ConvertTicksToSeconds( i_tickCount ) * 1000.0;
+	};
+	// No thread is waiting when the event is signaled
+	// and the event has already been signaled when the thread waits
+	const auto MeasureUncontended = [&GetMilliseconds]( auto& io_event )
+	{
+		const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+		for ( unsigned int i = 0; i < signalCount_uncontended; ++i )
+		{
+			io_event.Signal();
+			io_event.Wait();
+		}
+		return GetMilliseconds( Time::GetCurrentSystemTimeTickCount() - tickCount_start );
+	};
+	// Two threads take turns signaling each other
+	// (like the application loop thread and the render thread do every frame)
+	const auto MeasureRoundTrips = [&GetMilliseconds]( auto& io_event_ping, auto& io_event_pong )
+	{
+		cThread thread;
+		const auto result = thread.Start(
+			[&io_event_ping, &io_event_pong]( void* const )
+			{
+				for ( unsigned int i = 0; i < roundTripCount; ++i )
+				{
+					io_event_ping.Wait();
+					io_event_pong.Signal();
+				}
+			} );
+		if ( !result )
+		{
+			Logging::OutputError( "\tA benchmark thread couldn't be started" );
+			return 0.0;
+		}
+		const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+		for ( unsigned int i = 0; i < roundTripCount; ++i )
+		{
+			io_event_ping.Signal();
+			io_event_pong.Wait();
+		}
+		const auto milliseconds = GetMilliseconds( Time::GetCurrentSystemTimeTickCount() - tickCount_start );
+		WaitForThreadToStop( thread );
+		return milliseconds;
+	};
+
+	Logging::OutputMessage( "Event benchmark:" );
+	{
+		sEngineEvent engineEvent;
+		sStandardEvent standardEvent;
+		const auto milliseconds_engine = MeasureUncontended( engineEvent );
+		const auto milliseconds_standard = MeasureUncontended( standardEvent );
+		Logging::OutputMessage( "\tUncontended (%u signals): cEvent %.2f ns, std::condition_variable %.2f ns per signal and wait",
+			signalCount_uncontended,
+			( milliseconds_engine * 1.0e6 ) / signalCount_uncontended, ( milliseconds_standard * 1.0e6 ) / signalCount_uncontended );
+	}
+	{
+		sEngineEvent engineEvents[2];
+		sStandardEvent standardEvents[2];
+		const auto milliseconds_engine = MeasureRoundTrips( engineEvents[0], engineEvents[1] );
+		const auto milliseconds_standard = MeasureRoundTrips( standardEvents[0], standardEvents[1] );
+		Logging::OutputMessage( "\tTwo threads (%u round trips): cEvent %.2f us, std::condition_variable %.2f us per round trip",
+			roundTripCount,
+			( milliseconds_engine * 1.0e3 ) / roundTripCount, ( milliseconds_standard * 1.0e3 ) / roundTripCount );
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_ISSYNCHRONIZATIONBENCHMARKENABLED
+
 // Initialize / Clean Up
 //----------------------
 
@@ -14,12 +14,16 @@
 // Includes
 //=========
 
+#include "Configuration.h"
 #include "Constants.h"
 
 #include <Engine/Results/Results.h>
 
 #if defined( EAE6320_PLATFORM_WINDOWS )
 	#include <Engine/Windows/Includes.h>
+#elif defined( EAE6320_PLATFORM_LINUX )
+	#include <atomic>
+	#include <cstdint>
 #endif
 
 // Constants
@@ -49,6 +53,12 @@ namespace eae6320
 {
 	namespace Concurrency
 	{
+		class cEvent;
+
+		// This is declared before the class so that it can have a default argument
+		// (the class's friend declaration can't)
+		cResult WaitForEvent( const cEvent& i_event, const unsigned int i_timeToWait_inMilliseconds = Constants::DontTimeOut );
+
 		class cEvent
 		{
 			// Interface
@@ -67,7 +77,7 @@ namespace eae6320
 			//	* The specified time-out period elapses
 			//		* If the caller doesn't specify a time-out period then the function will never return until the event happens
 			//		* If the caller specifies a time-out period of zero then the function will return immediately
-			friend cResult WaitForEvent( const cEvent& i_event, const unsigned int i_timeToWait_inMilliseconds = Constants::DontTimeOut );
+			friend cResult WaitForEvent( const cEvent& i_event, const unsigned int i_timeToWait_inMilliseconds );
 
 			// This function should be called when an event happens
 			// (which "signals" the event happening to any waiting threads)
@@ -76,6 +86,12 @@ namespace eae6320
 			// (it resets the event as if it had never happened)
 			cResult ResetToUnsignaled();
 
+#ifdef EAE6320_CONCURRENCY_ISSYNCHRONIZATIONBENCHMARKENABLED
+			// Signals and waits with one thread and with two threads taking turns
+			// and writes how long it takes compared to std::condition_variable to the log
+			static void RunBenchmark();
+#endif
+
 			// Initialization / Clean Up
 			//--------------------------
 
@@ -92,6 +108,14 @@ namespace eae6320
 
 #if defined( EAE6320_PLATFORM_WINDOWS )
 			HANDLE m_handle = NULL;
+#elif defined( EAE6320_PLATFORM_LINUX )
+			// The futex word is 1 when the event is signaled and 0 when it isn't
+			// (waiting for an automatically-resetting event changes it, and so it is mutable)
+			mutable std::atomic<uint32_t> m_state = 0;
+			// Signaling only needs a system call when there are threads sleeping in WaitForEvent()
+			mutable std::atomic<uint32_t> m_waitingThreadCount = 0;
+			EventType m_type = EventType::ResetAutomaticallyAfterBeingSignaled;
+			bool m_isInitialized = false;
 #endif
 
 			// Implementation
@@ -107,11 +131,6 @@ namespace eae6320
 			cEvent& operator =( const cEvent& ) = delete;
 			cEvent& operator =( cEvent&& ) = delete;
 		};
-
-		// Friends
-		//========
-
-		cResult WaitForEvent( const cEvent& i_event, const unsigned int i_timeToWait_inMilliseconds );
 	}
 }
 
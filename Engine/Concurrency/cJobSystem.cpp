@@ -0,0 +1,910 @@
+// Includes
+//=========
+
+#include "cJobSystem.h"
+
+#include "cThread.h"
+#include "Futex.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <new>
+#include <thread>
+
+#if defined( _M_IX86 ) || defined( _M_X64 ) || defined( __SSE2__ )
+	#include <emmintrin.h>
+	#define EAE6320_CONCURRENCY_CANPAUSE
+#endif
+
+#ifdef EAE6320_CONCURRENCY_ISJOBBENCHMARKENABLED
+	#include <cmath>
+	#include <cstring>
+	#include <Engine/Time/Time.h>
+	#include <memory>
+	#include <vector>
+#endif
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// An idle thread checks for jobs this many times before it sleeps (or yields)
+	constexpr unsigned int s_spinCountBeforeSleeping = 128;
+
+	// Each thread remembers which job system it is a worker for (if any)
+	struct sThreadContext
+	{
+		const eae6320::Concurrency::cJobSystem* jobSystem = nullptr;
+		unsigned int workerIndex = 0;
+		uint32_t randomState = 0;
+	};
+	thread_local sThreadContext s_threadContext;
+
+	// Tells the CPU that the thread is spinning
+	// (which frees execution resources for another hardware thread on the same core)
+	void Pause();
+	// Used to choose which worker to start stealing from
+	// so that thieves don't all try the same worker
+	uint32_t GetRandomNumber();
+}
+
+// Job Definitions
+//================
+
+struct eae6320::Concurrency::cJobCounter::sDependentJob
+{
+	fJobFunction function;
+	void* userData;
+	cJobCounter* counter;
+	sDependentJob* next;
+};
+
+// This is the Chase-Lev work-stealing deque with a fixed-size ring buffer
+// (following the C11 version by Lê, Pop, Cohen, and Zappa Nardelli):
+// The worker that owns it pushes and pops at the bottom,
+// and any other thread can steal from the top.
+// The owner only needs a compare-and-swap when the deque has a single job left
+// and so it might be racing a thief for it.
+class eae6320::Concurrency::cJobSystem::cWorkStealingDeque
+{
+	// Interface
+	//==========
+
+public:
+
+	// Only the owner can call these
+	// (Push() fails if the deque is full)
+	bool Push( const sJobRecord& i_job );
+	bool Pop( sJobRecord& o_job );
+	// Any thread can call this
+	// (it can fail because of a race even if the deque isn't empty)
+	bool Steal( sJobRecord& o_job );
+
+	// This is only a hint unless it is called by the owner
+	bool IsEmpty() const
+	{
+		return m_bottom.load( std::memory_order_relaxed ) <= m_top.load( std::memory_order_relaxed );
+	}
+
+	// Data
+	//=====
+
+private:
+
+	static constexpr int64_t s_capacity = 1 << 12;
+	static_assert( ( s_capacity & ( s_capacity - 1 ) ) == 0, "The capacity must be a power of two" );
+
+	// A thief can read a slot at the same time that the owner writes it
+	// (the thief discards what it read when it loses the race for the job
+	// but the read itself still mustn't be a data race),
+	// and so every field is atomic and accessed with relaxed ordering
+	struct sSlot
+	{
+		std::atomic<fJobFunction> function;
+		std::atomic<void*> userData;
+		std::atomic<cJobCounter*> counter;
+	};
+
+	// The top and bottom are changed by different threads
+	// and so they are kept on separate cache lines
+	alignas( 64 ) std::atomic<int64_t> m_top = 0;
+	alignas( 64 ) std::atomic<int64_t> m_bottom = 0;
+	alignas( 64 ) sSlot m_slots[s_capacity];
+
+	// Implementation
+	//===============
+
+private:
+
+	void Write( const int64_t i_index, const sJobRecord& i_job )
+	{
+		auto& slot = m_slots[i_index & ( s_capacity - 1 )];
+		slot.function.store( i_job.function, std::memory_order_relaxed );
+		slot.userData.store( i_job.userData, std::memory_order_relaxed );
+		slot.counter.store( i_job.counter, std::memory_order_relaxed );
+	}
+	void Read( const int64_t i_index, sJobRecord& o_job ) const
+	{
+		const auto& slot = m_slots[i_index & ( s_capacity - 1 )];
+		o_job.function = slot.function.load( std::memory_order_relaxed );
+		o_job.userData = slot.userData.load( std::memory_order_relaxed );
+		o_job.counter = slot.counter.load( std::memory_order_relaxed );
+	}
+};
+
+struct eae6320::Concurrency::cJobSystem::sWorker
+{
+	cWorkStealingDeque deque;
+	cThread thread;
+};
+
+// Interface
+//==========
+
+// Job Counter
+//------------
+
+bool eae6320::Concurrency::cJobCounter::IsDone() const
+{
+	// The job count is checked first:
+	// A thread increments the finishing count before it decrements the job count,
+	// and so if the job count is zero then any thread that is still finishing a job will be seen
+	return ( m_jobCount.load() == 0 ) && ( m_finishingJobCount.load() == 0 );
+}
+
+eae6320::Concurrency::cJobCounter::~cJobCounter()
+{
+	EAE6320_ASSERTF( IsDone(), "A job counter is being destroyed before its jobs have finished" );
+	EAE6320_ASSERTF( m_dependentJobs.load() == nullptr, "A job counter is being destroyed with jobs that are waiting for it" );
+}
+
+// Jobs
+//-----
+
+void eae6320::Concurrency::cJobSystem::Submit( const sJob& i_job, cJobCounter* const io_counter )
+{
+	EAE6320_ASSERT( i_job.function );
+	if ( io_counter )
+	{
+		io_counter->m_jobCount.fetch_add( 1 );
+	}
+	PushJob( sJobRecord{ i_job.function, i_job.userData, io_counter } );
+	WakeUpWorkers( 1 );
+}
+
+void eae6320::Concurrency::cJobSystem::Submit( const sJob* const i_jobs, const size_t i_jobCount, cJobCounter* const io_counter )
+{
+	if ( i_jobCount == 0 )
+	{
+		return;
+	}
+	EAE6320_ASSERT( i_jobs );
+	if ( io_counter )
+	{
+		io_counter->m_jobCount.fetch_add( static_cast<uint32_t>( i_jobCount ) );
+	}
+	for ( size_t i = 0; i < i_jobCount; ++i )
+	{
+		EAE6320_ASSERT( i_jobs[i].function );
+		PushJob( sJobRecord{ i_jobs[i].function, i_jobs[i].userData, io_counter } );
+	}
+	WakeUpWorkers( i_jobCount );
+}
+
+eae6320::cResult eae6320::Concurrency::cJobSystem::SubmitAfter( cJobCounter& io_dependency, const sJob& i_job, cJobCounter* const io_counter )
+{
+	EAE6320_ASSERT( i_job.function );
+	auto* const dependentJob = new ( std::nothrow ) cJobCounter::sDependentJob{ i_job.function, i_job.userData, io_counter, nullptr };
+	if ( !dependentJob )
+	{
+		EAE6320_ASSERTF( false, "Couldn't allocate a dependent job" );
+		Logging::OutputError( "Failed to allocate memory for a job that depends on a counter" );
+		return Results::OutOfMemory;
+	}
+	if ( io_counter )
+	{
+		io_counter->m_jobCount.fetch_add( 1 );
+	}
+	// Add the job to the dependency's list
+	{
+		auto* head = io_dependency.m_dependentJobs.load();
+		do
+		{
+			dependentJob->next = head;
+		} while ( !io_dependency.m_dependentJobs.compare_exchange_weak( head, dependentJob ) );
+	}
+	// If the dependency's jobs finished before the new job was added then nothing else will submit it.
+	// The thread that finishes the last job decrements the job count before it takes the list,
+	// and so at least one of the two threads will find the new job
+	// (taking the whole list at once means that each dependent job is only submitted once
+	// even if more than one thread tries to submit them)
+	if ( io_dependency.m_jobCount.load() == 0 )
+	{
+		// The thread that finished the last job might still be using the dependency,
+		// and this waits for it so that the dependent job can't finish
+		// (and let its waiter destroy the dependency) before that thread is done with it
+		while ( io_dependency.m_finishingJobCount.load() != 0 )
+		{
+			Pause();
+		}
+		SubmitDependentJobs( io_dependency.m_dependentJobs.exchange( nullptr ) );
+	}
+	return Results::Success;
+}
+
+void eae6320::Concurrency::cJobSystem::WaitForCounter( const cJobCounter& i_counter )
+{
+	unsigned int idleCount = 0;
+	sJobRecord job;
+	while ( !i_counter.IsDone() )
+	{
+		if ( TryToGetJob( job ) )
+		{
+			ExecuteJob( job );
+			idleCount = 0;
+		}
+		else if ( idleCount < s_spinCountBeforeSleeping )
+		{
+			Pause();
+			++idleCount;
+		}
+		else
+		{
+			// The remaining jobs are running on other threads
+			std::this_thread::yield();
+		}
+	}
+}
+
+// Access
+//-------
+
+unsigned int eae6320::Concurrency::cJobSystem::GetHardwareThreadCount()
+{
+	// This can return zero if the count can't be determined
+	return std::max( std::thread::hardware_concurrency(), 1u );
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Concurrency::cJobSystem::Initialize( const unsigned int i_workerThreadCount )
+{
+	if ( m_isInitialized )
+	{
+		EAE6320_ASSERTF( false, "The job system is already initialized" );
+		Logging::OutputError( "An attempt was made to initialize a job system that was already initialized" );
+		return Results::Failure;
+	}
+
+	auto result = Results::Success;
+
+	m_shouldWorkersExit = false;
+	if ( i_workerThreadCount > 0 )
+	{
+		m_workers = new ( std::nothrow ) sWorker[i_workerThreadCount];
+		if ( !m_workers )
+		{
+			EAE6320_ASSERTF( false, "Couldn't allocate the job system's workers" );
+			Logging::OutputError( "Failed to allocate memory for %u job system workers", i_workerThreadCount );
+			return Results::OutOfMemory;
+		}
+		// The count must be set before any thread starts
+		// (a worker that doesn't start just has an empty deque)
+		m_workerCount = i_workerThreadCount;
+		for ( unsigned int i = 0; i < i_workerThreadCount; ++i )
+		{
+			if ( !( result = m_workers[i].thread.Start(
+				[this, i]( void* const )
+				{
+					RunWorkerUntilExit( i );
+				} ) ) )
+			{
+				EAE6320_ASSERTF( false, "Couldn't start job system worker thread #%u", i );
+				Logging::OutputError( "Failed to start job system worker thread #%u", i );
+				const auto result_stop = StopWorkers( i );
+				EAE6320_ASSERT( result_stop );
+				return result;
+			}
+			// The name makes the workers easy to find in a debugger or profiler
+			// (but it isn't required, and so a failure is ignored)
+			{
+				char name[32];
+				snprintf( name, sizeof( name ), "Job Worker #%u", i + 1 );
+				m_workers[i].thread.SetName( name );
+			}
+		}
+	}
+	m_isInitialized = true;
+
+	Logging::OutputMessage( "Initialized the job system with %u worker thread(s)", m_workerCount );
+
+	return result;
+}
+
+eae6320::cResult eae6320::Concurrency::cJobSystem::CleanUp()
+{
+	auto result = Results::Success;
+
+	if ( m_workers )
+	{
+		if ( !( result = StopWorkers( m_workerCount ) ) )
+		{
+			// If a worker is still running then it's not safe to free the memory that it uses
+			return result;
+		}
+	}
+	{
+		size_t jobCount = 0;
+		sJobRecord job;
+		while ( m_sharedQueue.TryToPop( job ) )
+		{
+			++jobCount;
+		}
+		cMutex::cScopeLock scopeLock( m_overflowQueueMutex );
+		jobCount += m_overflowQueue.size();
+		EAE6320_ASSERTF( jobCount == 0, "The job system is being cleaned up with %zu jobs that never ran", jobCount );
+		m_overflowQueue.clear();
+		m_overflowQueueJobCount = 0;
+	}
+	m_isInitialized = false;
+
+	return result;
+}
+
+eae6320::Concurrency::cJobSystem::cJobSystem()
+{
+
+}
+
+eae6320::Concurrency::cJobSystem::~cJobSystem()
+{
+	const auto result = CleanUp();
+	EAE6320_ASSERT( result );
+}
+
+// Implementation
+//===============
+
+// Parallel For
+//-------------
+
+void eae6320::Concurrency::cJobSystem::ParallelFor( sParallelFor& io_parallelFor )
+{
+	if ( io_parallelFor.end <= io_parallelFor.begin )
+	{
+		return;
+	}
+	EAE6320_ASSERTF( io_parallelFor.grainSize > 0, "A parallel for needs a grain size of at least one" );
+	const uint64_t grainSize = std::max( io_parallelFor.grainSize, 1u );
+	io_parallelFor.rangeCount = static_cast<uint32_t>( ( uint64_t( io_parallelFor.end - io_parallelFor.begin ) + ( grainSize - 1 ) ) / grainSize );
+
+	// Rather than submitting a job for every range
+	// a helper job is submitted for every worker that could help,
+	// and each helper keeps claiming ranges until there are none left
+	// (a helper that starts after all of the ranges have been claimed just returns)
+	const auto helperJobCount = std::min<uint32_t>( io_parallelFor.rangeCount - 1, m_workerCount );
+	if ( helperJobCount > 0 )
+	{
+		constexpr uint32_t maxHelperJobCount = 64;
+		sJob helperJobs[maxHelperJobCount];
+		const auto jobCount = std::min( helperJobCount, maxHelperJobCount );
+		for ( uint32_t i = 0; i < jobCount; ++i )
+		{
+			helperJobs[i] = sJob{ ProcessRanges, &io_parallelFor };
+		}
+		cJobCounter counter;
+		Submit( helperJobs, jobCount, &counter );
+		ProcessRanges( &io_parallelFor );
+		// The helpers reference the parallel for data on this thread's stack,
+		// and so this can't return until they have all finished (even the ones that have nothing to do)
+		WaitForCounter( counter );
+	}
+	else
+	{
+		ProcessRanges( &io_parallelFor );
+	}
+}
+
+void eae6320::Concurrency::cJobSystem::ProcessRanges( void* const io_parallelFor )
+{
+	auto& parallelFor = *static_cast<sParallelFor*>( io_parallelFor );
+	const auto grainSize = std::max( parallelFor.grainSize, 1u );
+	while ( true )
+	{
+		const auto rangeIndex = parallelFor.nextRangeIndex.fetch_add( 1, std::memory_order_relaxed );
+		if ( rangeIndex >= parallelFor.rangeCount )
+		{
+			break;
+		}
+		const auto rangeBegin = parallelFor.begin + ( rangeIndex * grainSize );
+		const auto rangeEnd = rangeBegin + std::min( grainSize, parallelFor.end - rangeBegin );
+		parallelFor.processRange( parallelFor.function, rangeBegin, rangeEnd );
+	}
+}
+
+// Jobs
+//-----
+
+void eae6320::Concurrency::cJobSystem::PushJob( const sJobRecord& i_job )
+{
+	const auto workerIndex = GetWorkerIndexOfCallingThread();
+	if ( ( workerIndex < m_workerCount ) && m_workers[workerIndex].deque.Push( i_job ) )
+	{
+		return;
+	}
+	if ( m_sharedQueue.TryToPush( i_job ) )
+	{
+		return;
+	}
+	cMutex::cScopeLock scopeLock( m_overflowQueueMutex );
+	m_overflowQueue.push_back( i_job );
+	m_overflowQueueJobCount.fetch_add( 1, std::memory_order_relaxed );
+}
+
+void eae6320::Concurrency::cJobSystem::WakeUpWorkers( const size_t i_jobCount )
+{
+	// A worker that is going to sleep increments the sleeping count and then checks for jobs,
+	// and this thread adds jobs and then checks the sleeping count.
+	// The full fences on both sides mean that at least one of them will see the other's change,
+	// and so a job can never be left in a queue while every worker sleeps
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	if ( m_sleepingWorkerCount.load( std::memory_order_relaxed ) > 0 )
+	{
+		m_wakeUpCount.fetch_add( 1 );
+		if ( i_jobCount == 1 )
+		{
+			Futex::WakeOne( m_wakeUpCount );
+		}
+		else
+		{
+			Futex::WakeAll( m_wakeUpCount );
+		}
+	}
+}
+
+bool eae6320::Concurrency::cJobSystem::TryToGetJob( sJobRecord& o_job )
+{
+	// A worker looks in its own deque first
+	const auto workerIndex = GetWorkerIndexOfCallingThread();
+	if ( ( workerIndex < m_workerCount ) && m_workers[workerIndex].deque.Pop( o_job ) )
+	{
+		return true;
+	}
+	// The shared queue
+	if ( m_sharedQueue.TryToPop( o_job ) )
+	{
+		return true;
+	}
+	if ( m_overflowQueueJobCount.load( std::memory_order_relaxed ) > 0 )
+	{
+		cMutex::cScopeLock scopeLock( m_overflowQueueMutex );
+		if ( !m_overflowQueue.empty() )
+		{
+			o_job = m_overflowQueue.front();
+			m_overflowQueue.pop_front();
+			m_overflowQueueJobCount.fetch_sub( 1, std::memory_order_relaxed );
+			return true;
+		}
+	}
+	// Other workers' deques
+	if ( m_workerCount > 0 )
+	{
+		auto victimIndex = GetRandomNumber() % m_workerCount;
+		for ( unsigned int i = 0; i < m_workerCount; ++i )
+		{
+			if ( ( victimIndex != workerIndex ) && m_workers[victimIndex].deque.Steal( o_job ) )
+			{
+				return true;
+			}
+			victimIndex = ( ( victimIndex + 1 ) < m_workerCount ) ? ( victimIndex + 1 ) : 0;
+		}
+	}
+	return false;
+}
+
+bool eae6320::Concurrency::cJobSystem::HasJobs() const
+{
+	// The shared queue's count includes jobs that are still being pushed,
+	// and so a worker won't go to sleep while a job is about to become available
+	if ( ( m_sharedQueue.GetApproximateCount() > 0 ) || ( m_overflowQueueJobCount.load( std::memory_order_relaxed ) > 0 ) )
+	{
+		return true;
+	}
+	for ( unsigned int i = 0; i < m_workerCount; ++i )
+	{
+		if ( !m_workers[i].deque.IsEmpty() )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void eae6320::Concurrency::cJobSystem::ExecuteJob( const sJobRecord& i_job )
+{
+	i_job.function( i_job.userData );
+	if ( i_job.counter )
+	{
+		FinishJob( *i_job.counter );
+	}
+}
+
+void eae6320::Concurrency::cJobSystem::FinishJob( cJobCounter& io_counter )
+{
+	// A waiting thread could destroy the counter as soon as it sees that it is done,
+	// and so this thread stays registered as finishing until it won't touch the counter again.
+	// The dependent jobs are only submitted after that
+	// (so that nothing that they do can happen before this thread is finished with the counter)
+	cJobCounter::sDependentJob* dependentJobs = nullptr;
+	io_counter.m_finishingJobCount.fetch_add( 1 );
+	if ( io_counter.m_jobCount.fetch_sub( 1 ) == 1 )
+	{
+		if ( io_counter.m_dependentJobs.load() != nullptr )
+		{
+			dependentJobs = io_counter.m_dependentJobs.exchange( nullptr );
+		}
+	}
+	io_counter.m_finishingJobCount.fetch_sub( 1 );
+	SubmitDependentJobs( dependentJobs );
+}
+
+void eae6320::Concurrency::cJobSystem::SubmitDependentJobs( cJobCounter::sDependentJob* io_dependentJobs )
+{
+	size_t jobCount = 0;
+	while ( io_dependentJobs )
+	{
+		auto* const nextDependentJob = io_dependentJobs->next;
+		PushJob( sJobRecord{ io_dependentJobs->function, io_dependentJobs->userData, io_dependentJobs->counter } );
+		delete io_dependentJobs;
+		io_dependentJobs = nextDependentJob;
+		++jobCount;
+	}
+	if ( jobCount > 0 )
+	{
+		WakeUpWorkers( jobCount );
+	}
+}
+
+// Worker Threads
+//---------------
+
+void eae6320::Concurrency::cJobSystem::RunWorkerUntilExit( const unsigned int i_workerIndex )
+{
+	s_threadContext.jobSystem = this;
+	s_threadContext.workerIndex = i_workerIndex;
+
+	unsigned int idleCount = 0;
+	sJobRecord job;
+	while ( true )
+	{
+		if ( TryToGetJob( job ) )
+		{
+			ExecuteJob( job );
+			idleCount = 0;
+			continue;
+		}
+		if ( m_shouldWorkersExit.load() )
+		{
+			break;
+		}
+		// Jobs often come in bursts, and so a worker spins for a short time before it sleeps
+		if ( idleCount < s_spinCountBeforeSleeping )
+		{
+			Pause();
+			++idleCount;
+			continue;
+		}
+		// Sleep until more jobs are submitted
+		{
+			// The wake up count is read before checking for jobs
+			// so that if a job is submitted after the check the count will have changed
+			// and the futex won't let this thread sleep
+			const auto wakeUpCount = m_wakeUpCount.load();
+			m_sleepingWorkerCount.fetch_add( 1 );
+			std::atomic_thread_fence( std::memory_order_seq_cst );
+			if ( !HasJobs() && !m_shouldWorkersExit.load() )
+			{
+				Futex::WaitWhileEqual( m_wakeUpCount, wakeUpCount );
+			}
+			m_sleepingWorkerCount.fetch_sub( 1 );
+		}
+		idleCount = 0;
+	}
+
+	s_threadContext.jobSystem = nullptr;
+}
+
+unsigned int eae6320::Concurrency::cJobSystem::GetWorkerIndexOfCallingThread() const
+{
+	return ( s_threadContext.jobSystem == this ) ? s_threadContext.workerIndex : m_workerCount;
+}
+
+eae6320::cResult eae6320::Concurrency::cJobSystem::StopWorkers( const unsigned int i_startedWorkerCount )
+{
+	auto result = Results::Success;
+
+	// Tell the workers to exit once they can't find any more jobs
+	// and wake up any that are sleeping
+	m_shouldWorkersExit = true;
+	m_wakeUpCount.fetch_add( 1 );
+	Futex::WakeAll( m_wakeUpCount );
+	for ( unsigned int i = 0; i < i_startedWorkerCount; ++i )
+	{
+		const auto result_thread = WaitForThreadToStop( m_workers[i].thread );
+		if ( !result_thread )
+		{
+			EAE6320_ASSERTF( false, "Couldn't wait for job system worker thread #%u to exit", i );
+			Logging::OutputError( "Failed to wait for job system worker thread #%u to exit", i );
+			if ( result )
+			{
+				result = result_thread;
+			}
+		}
+	}
+	if ( result )
+	{
+		delete [] m_workers;
+		m_workers = nullptr;
+		m_workerCount = 0;
+	}
+
+	return result;
+}
+
+#ifdef EAE6320_CONCURRENCY_ISJOBBENCHMARKENABLED
+
+void eae6320::Concurrency::cJobSystem::RunBenchmark()
+{
+	constexpr uint32_t elementCount = 1 << 20;
+	constexpr uint32_t grainSize = 1 << 12;
+	constexpr unsigned int iterationCountPerElement = 64;
+	constexpr unsigned int spawnerJobCount = 64;
+	constexpr unsigned int tinyJobCountPerSpawner = 1024;
+	constexpr unsigned int dependencyChainLength = 256;
+
+	const auto GetMilliseconds = []( const uint64_t i_tickCount )
+	{
+		return Time::ConvertTicksToSeconds( i_tickCount ) * 1000.0;
+	};
+	// Every element does the same fixed amount of floating point work,
+	// and its result only depends on its index
+	// (and so every worker count must calculate exactly the same results)
+	const auto CalculateElements = []( float* const o_elements, const uint32_t i_begin, const uint32_t i_end )
+	{
+		for ( auto i = i_begin; i < i_end; ++i )
+		{
+			auto value = static_cast<float>( i );
+			for ( unsigned int j = 0; j < iterationCountPerElement; ++j )
+			{
+				value = std::sqrt( ( value * 1.0001f ) + 1.0f );
+			}
+			o_elements[i] = value;
+		}
+	};
+
+	std::vector<float> elements_expected( elementCount );
+	CalculateElements( elements_expected.data(), 0, elementCount );
+	std::vector<float> elements( elementCount );
+
+	// Fine-grained jobs are submitted from inside of other jobs
+	// (which puts them in the workers' own deques and so exercises stealing)
+	struct sSpawnerData
+	{
+		cJobSystem* jobSystem;
+		cJobCounter* counter;
+		std::atomic<uint32_t>* tinyJobRunCount;
+	};
+	const fJobFunction RunSpawnerJob = []( void* const io_spawnerData )
+	{
+		const auto& spawnerData = *static_cast<const sSpawnerData*>( io_spawnerData );
+		sJob tinyJobs[tinyJobCountPerSpawner];
+		for ( auto& tinyJob : tinyJobs )
+		{
+			tinyJob = sJob{ []( void* const io_tinyJobRunCount )
+				{
+					static_cast<std::atomic<uint32_t>*>( io_tinyJobRunCount )->fetch_add( 1, std::memory_order_relaxed );
+				},
+				spawnerData.tinyJobRunCount };
+		}
+		spawnerData.jobSystem->Submit( tinyJobs, tinyJobCountPerSpawner, spawnerData.counter );
+	};
+
+	// Each job in the chain records its position,
+	// and it can only be correct if every job ran after the one before it
+	struct sChainData
+	{
+		std::atomic<uint32_t>* nextPosition;
+		uint32_t position;
+		bool* wasInOrder;
+	};
+
+	Logging::OutputMessage( "Job system benchmark (%u hardware threads):", GetHardwareThreadCount() );
+	Logging::OutputMessage( "\tParallel for: %u elements with %u iterations each in ranges of %u", elementCount, iterationCountPerElement, grainSize );
+	Logging::OutputMessage( "\tFine-grained: %u jobs submitted by %u jobs", spawnerJobCount * tinyJobCountPerSpawner, spawnerJobCount );
+	double milliseconds_parallelFor_oneCore = 0.0, milliseconds_fineGrained_oneCore = 0.0;
+	for ( unsigned int workerCount = 0; workerCount < GetHardwareThreadCount(); ++workerCount )
+	{
+		cJobSystem jobSystem;
+		if ( !jobSystem.Initialize( workerCount ) )
+		{
+			Logging::OutputError( "\tThe job system couldn't be initialized with %u worker threads", workerCount );
+			break;
+		}
+		const auto coreCount = workerCount + 1;
+
+		// Parallel for
+		double milliseconds_parallelFor;
+		bool areElementsCorrect;
+		{
+			std::fill( elements.begin(), elements.end(), 0.0f );
+			auto* const elementData = elements.data();
+			const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+			jobSystem.ParallelFor( 0, elementCount, grainSize,
+				[elementData, &CalculateElements]( const uint32_t i_rangeBegin, const uint32_t i_rangeEnd )
+				{
+					CalculateElements( elementData, i_rangeBegin, i_rangeEnd );
+				} );
+			milliseconds_parallelFor = GetMilliseconds( Time::GetCurrentSystemTimeTickCount() - tickCount_start );
+			areElementsCorrect = memcmp( elements.data(), elements_expected.data(), elementCount * sizeof( float ) ) == 0;
+		}
+		// Fine-grained jobs
+		double milliseconds_fineGrained;
+		uint32_t tinyJobRunCount_final;
+		{
+			std::atomic<uint32_t> tinyJobRunCount = 0;
+			cJobCounter counter;
+			sSpawnerData spawnerData{ &jobSystem, &counter, &tinyJobRunCount };
+			sJob spawnerJobs[spawnerJobCount];
+			for ( auto& spawnerJob : spawnerJobs )
+			{
+				spawnerJob = sJob{ RunSpawnerJob, &spawnerData };
+			}
+			const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+			jobSystem.Submit( spawnerJobs, spawnerJobCount, &counter );
+			jobSystem.WaitForCounter( counter );
+			milliseconds_fineGrained = GetMilliseconds( Time::GetCurrentSystemTimeTickCount() - tickCount_start );
+			tinyJobRunCount_final = tinyJobRunCount.load();
+		}
+		// Dependencies
+		bool wasChainInOrder = true;
+		{
+			std::atomic<uint32_t> nextPosition = 0;
+			std::unique_ptr<cJobCounter[]> counters( new cJobCounter[dependencyChainLength] );
+			std::vector<sChainData> chainData( dependencyChainLength );
+			const fJobFunction RunChainJob = []( void* const io_chainData )
+			{
+				const auto& chainData = *static_cast<const sChainData*>( io_chainData );
+				if ( chainData.nextPosition->fetch_add( 1 ) != chainData.position )
+				{
+					*chainData.wasInOrder = false;
+				}
+			};
+			for ( uint32_t i = 0; i < dependencyChainLength; ++i )
+			{
+				chainData[i] = sChainData{ &nextPosition, i, &wasChainInOrder };
+			}
+			// Each job's counter is incremented when the job is submitted,
+			// and so the next job in the chain can be made to depend on it even if it hasn't run yet
+			jobSystem.Submit( sJob{ RunChainJob, &chainData[0] }, &counters[0] );
+			for ( uint32_t i = 1; i < dependencyChainLength; ++i )
+			{
+				const auto result = jobSystem.SubmitAfter( counters[i - 1], sJob{ RunChainJob, &chainData[i] }, &counters[i] );
+				EAE6320_ASSERT( result );
+			}
+			jobSystem.WaitForCounter( counters[dependencyChainLength - 1] );
+			wasChainInOrder = wasChainInOrder && ( nextPosition.load() == dependencyChainLength );
+		}
+
+		if ( workerCount == 0 )
+		{
+			milliseconds_parallelFor_oneCore = milliseconds_parallelFor;
+			milliseconds_fineGrained_oneCore = milliseconds_fineGrained;
+		}
+		Logging::OutputMessage( "\t%u core(s): parallel for %.3f ms (%.2fx), fine-grained %.3f ms (%.2fx)%s%s%s",
+			coreCount,
+			milliseconds_parallelFor, milliseconds_parallelFor_oneCore / milliseconds_parallelFor,
+			milliseconds_fineGrained, milliseconds_fineGrained_oneCore / milliseconds_fineGrained,
+			areElementsCorrect ? "" : " (PARALLEL FOR RESULTS DIDN'T MATCH!)",
+			( tinyJobRunCount_final == ( spawnerJobCount * tinyJobCountPerSpawner ) ) ? "" : " (NOT EVERY FINE-GRAINED JOB RAN!)",
+			wasChainInOrder ? "" : " (DEPENDENT JOBS RAN OUT OF ORDER!)" );
+
+		const auto result = jobSystem.CleanUp();
+		EAE6320_ASSERT( result );
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_ISJOBBENCHMARKENABLED
+
+// Helper Definitions
+//===================
+
+bool eae6320::Concurrency::cJobSystem::cWorkStealingDeque::Push( const sJobRecord& i_job )
+{
+	const auto bottom = m_bottom.load( std::memory_order_relaxed );
+	const auto top = m_top.load( std::memory_order_acquire );
+	if ( ( bottom - top ) >= s_capacity )
+	{
+		return false;
+	}
+	Write( bottom, i_job );
+	// A thief that sees the new bottom must also see the job
+	// (the paper uses a release fence followed by a relaxed store,
+	// but a release store is just as cheap and tools like ThreadSanitizer understand it)
+	m_bottom.store( bottom + 1, std::memory_order_release );
+	return true;
+}
+
+bool eae6320::Concurrency::cJobSystem::cWorkStealingDeque::Pop( sJobRecord& o_job )
+{
+	// The bottom is reserved first
+	// so that any thief that reads the top after this will see that the job is taken
+	const auto bottom = m_bottom.load( std::memory_order_relaxed ) - 1;
+	m_bottom.store( bottom, std::memory_order_relaxed );
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	auto top = m_top.load( std::memory_order_relaxed );
+	if ( top <= bottom )
+	{
+		Read( bottom, o_job );
+		if ( top != bottom )
+		{
+			// There is more than one job, and so no thief can be trying to take this one
+			return true;
+		}
+		// This is the last job, and a thief might be trying to take it too
+		const auto wasJobTaken = m_top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed );
+		m_bottom.store( bottom + 1, std::memory_order_relaxed );
+		return wasJobTaken;
+	}
+	else
+	{
+		// The deque was empty
+		m_bottom.store( bottom + 1, std::memory_order_relaxed );
+		return false;
+	}
+}
+
+bool eae6320::Concurrency::cJobSystem::cWorkStealingDeque::Steal( sJobRecord& o_job )
+{
+	auto top = m_top.load( std::memory_order_acquire );
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	const auto bottom = m_bottom.load( std::memory_order_acquire );
+	if ( top < bottom )
+	{
+		Read( top, o_job );
+		// The job only belongs to this thread if no other thread (including the owner) took it first
+		return m_top.compare_exchange_strong( top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed );
+	}
+	return false;
+}
+
+namespace
+{
+	void Pause()
+	{
+#if defined( EAE6320_CONCURRENCY_CANPAUSE )
+		_mm_pause();
+#else
+		std::this_thread::yield();
+#endif
+	}
+
+	uint32_t GetRandomNumber()
+	{
+		// xorshift32
+		auto randomState = s_threadContext.randomState;
+		if ( randomState == 0 )
+		{
+			// Every thread's context has a different address
+			randomState = static_cast<uint32_t>( reinterpret_cast<uintptr_t>( &s_threadContext ) >> 4 ) | 1u;
+		}
+		randomState ^= randomState << 13;
+		randomState ^= randomState >> 17;
+		randomState ^= randomState << 5;
+		s_threadContext.randomState = randomState;
+		return randomState;
+	}
+}
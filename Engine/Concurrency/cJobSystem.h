@@ -0,0 +1,260 @@
+/*
+	A job system runs small independent pieces of work ("jobs") on a pool of worker threads
+
+	Each worker thread owns a work-stealing deque:
+	jobs that a worker submits go to the bottom of its own deque and it takes them back from the bottom
+	(the most recently submitted job is the one most likely to still be in its cache),
+	and a worker that runs out of jobs steals from the top of another worker's deque
+	(the oldest job, which tends to be the biggest).
+	Jobs submitted by threads that aren't workers (like the application loop thread) go to a shared lock-free queue.
+
+	A thread that needs the results of jobs waits on a counter,
+	and while it waits it runs jobs itself rather than sleeping.
+	Worker threads that can't find anything to do spin briefly and then sleep on a futex
+	until more jobs are submitted.
+*/
+
+#ifndef EAE6320_CONCURRENCY_CJOBSYSTEM_H
+#define EAE6320_CONCURRENCY_CJOBSYSTEM_H
+
+// Includes
+//=========
+
+#include "Configuration.h"
+#include "cMpmcQueue.h"
+#include "cMutex.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <Engine/Results/Results.h>
+
+// Job Declarations
+//=================
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		// A job function takes a single void pointer as input
+		// (a plain function pointer is used rather than std::function
+		// so that submitting a job never allocates memory)
+		using fJobFunction = void (*)( void* const io_userData );
+
+		struct sJob
+		{
+			fJobFunction function = nullptr;
+			void* userData = nullptr;
+		};
+
+		// A counter keeps track of how many of the jobs that were submitted with it haven't finished yet.
+		// Any number of jobs can share a counter,
+		// and a counter can be reused once all of its jobs have finished
+		class cJobCounter
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Returns true when every job that was submitted with the counter has finished
+			bool IsDone() const;
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cJobCounter() = default;
+			~cJobCounter();
+
+			// Data
+			//=====
+
+		private:
+
+			struct sDependentJob;
+
+			// The number of jobs that haven't finished yet
+			std::atomic<uint32_t> m_jobCount = 0;
+			// The number of threads that are in the middle of finishing one of this counter's jobs
+			// (a waiting thread must not be told that the counter is done
+			// until no other thread will touch it again)
+			std::atomic<uint32_t> m_finishingJobCount = 0;
+			// Jobs that will be submitted when the job count reaches zero
+			std::atomic<sDependentJob*> m_dependentJobs = nullptr;
+
+			// Implementation
+			//===============
+
+		private:
+
+			friend class cJobSystem;
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cJobCounter( const cJobCounter& ) = delete;
+			cJobCounter( cJobCounter&& ) = delete;
+			cJobCounter& operator =( const cJobCounter& ) = delete;
+			cJobCounter& operator =( cJobCounter&& ) = delete;
+		};
+	}
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		class cJobSystem
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Jobs
+			//-----
+
+			// If a counter is provided it is incremented before the job is submitted
+			// and decremented once the job has finished
+			void Submit( const sJob& i_job, cJobCounter* const io_counter = nullptr );
+			void Submit( const sJob* const i_jobs, const size_t i_jobCount, cJobCounter* const io_counter = nullptr );
+			// The job won't be submitted until every job that was submitted with the dependency counter has finished
+			// (if they have already finished then it is submitted immediately).
+			// The provided counter is incremented immediately,
+			// and so waiting on it also waits for the dependency
+			cResult SubmitAfter( cJobCounter& io_dependency, const sJob& i_job, cJobCounter* const io_counter = nullptr );
+
+			// This doesn't return until every job that was submitted with the counter has finished.
+			// The calling thread runs other jobs while it waits
+			// (and so it's fine to call this from inside of a job)
+			void WaitForCounter( const cJobCounter& i_counter );
+
+			// Calls the function for every index in [i_begin, i_end) with ranges of (at most) i_grainSize indices
+			// that are spread across the worker threads and the calling thread:
+			//	void function( const uint32_t i_rangeBegin, const uint32_t i_rangeEnd )
+			// The function must be safe to call for different ranges at the same time,
+			// and this doesn't return until it has been called for every range
+			template<typename tFunction>
+			void ParallelFor( const uint32_t i_begin, const uint32_t i_end, const uint32_t i_grainSize, const tFunction& i_function );
+
+			// Access
+			//-------
+
+			unsigned int GetWorkerThreadCount() const { return m_workerCount; }
+			// The number of threads that the hardware can run at the same time
+			// (this is never less than 1)
+			static unsigned int GetHardwareThreadCount();
+
+#ifdef EAE6320_CONCURRENCY_ISJOBBENCHMARKENABLED
+			// Runs compute-bound and fine-grained workloads with every possible number of worker threads
+			// (from just the calling thread up to one thread per hardware thread)
+			// and writes how the time scales to the log
+			static void RunBenchmark();
+#endif
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// A job system can be initialized with no worker threads,
+			// in which case jobs only run when a thread waits on a counter
+			cResult Initialize( const unsigned int i_workerThreadCount );
+			cResult CleanUp();
+
+			cJobSystem();
+			~cJobSystem();
+
+			// Data
+			//=====
+
+		private:
+
+			struct sJobRecord
+			{
+				fJobFunction function = nullptr;
+				void* userData = nullptr;
+				cJobCounter* counter = nullptr;
+			};
+			class cWorkStealingDeque;
+			struct sWorker;
+
+			sWorker* m_workers = nullptr;
+			unsigned int m_workerCount = 0;
+			bool m_isInitialized = false;
+			std::atomic<bool> m_shouldWorkersExit = false;
+
+			// Jobs that are submitted by threads that aren't workers
+			// (or that don't fit in a worker's deque)
+			cMpmcQueue<sJobRecord, 1024> m_sharedQueue;
+			// Jobs go here instead if the shared queue is full
+			std::deque<sJobRecord> m_overflowQueue;
+			cMutex m_overflowQueueMutex;
+			// This lets threads check whether the overflow queue is empty without locking the mutex
+			std::atomic<size_t> m_overflowQueueJobCount = 0;
+
+			// Sleeping worker threads wait for this to change,
+			// and it is incremented whenever they need to be woken up
+			std::atomic<uint32_t> m_wakeUpCount = 0;
+			std::atomic<uint32_t> m_sleepingWorkerCount = 0;
+
+			// Implementation
+			//===============
+
+		private:
+
+			// Parallel For
+			//-------------
+
+			struct sParallelFor
+			{
+				using fProcessRange = void (*)( const void* const i_function, const uint32_t i_rangeBegin, const uint32_t i_rangeEnd );
+
+				const fProcessRange processRange;
+				const void* const function;
+				const uint32_t begin;
+				const uint32_t end;
+				const uint32_t grainSize;
+				uint32_t rangeCount = 0;
+				// The calling thread and the helper jobs all claim ranges from this index
+				std::atomic<uint32_t> nextRangeIndex = 0;
+			};
+
+			void ParallelFor( sParallelFor& io_parallelFor );
+			static void ProcessRanges( void* const io_parallelFor );
+
+			// Jobs
+			//-----
+
+			void PushJob( const sJobRecord& i_job );
+			void WakeUpWorkers( const size_t i_jobCount );
+			bool TryToGetJob( sJobRecord& o_job );
+			bool HasJobs() const;
+			void ExecuteJob( const sJobRecord& i_job );
+			void FinishJob( cJobCounter& io_counter );
+			void SubmitDependentJobs( cJobCounter::sDependentJob* io_dependentJobs );
+
+			// Worker Threads
+			//---------------
+
+			void RunWorkerUntilExit( const unsigned int i_workerIndex );
+			// This returns the worker count if the calling thread isn't one of this job system's workers
+			unsigned int GetWorkerIndexOfCallingThread() const;
+			cResult StopWorkers( const unsigned int i_startedWorkerCount );
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cJobSystem( const cJobSystem& ) = delete;
+			cJobSystem( cJobSystem&& ) = delete;
+			cJobSystem& operator =( const cJobSystem& ) = delete;
+			cJobSystem& operator =( cJobSystem&& ) = delete;
+		};
+	}
+}
+
+#include "cJobSystem.inl"
+
+#endif	// EAE6320_CONCURRENCY_CJOBSYSTEM_H
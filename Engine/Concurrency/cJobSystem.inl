@@ -0,0 +1,30 @@
+#ifndef EAE6320_CONCURRENCY_CJOBSYSTEM_INL
+#define EAE6320_CONCURRENCY_CJOBSYSTEM_INL
+
+// Includes
+//=========
+
+#include "cJobSystem.h"
+
+// Interface
+//==========
+
+// Jobs
+//-----
+
+	template<typename tFunction>
+void eae6320::Concurrency::cJobSystem::ParallelFor( const uint32_t i_begin, const uint32_t i_end, const uint32_t i_grainSize,
+	const tFunction& i_function )
+{
+	// The type of the function is erased here
+	// so that the scheduling can be implemented once in the .cpp file
+	sParallelFor parallelFor{
+		[]( const void* const i_function, const uint32_t i_rangeBegin, const uint32_t i_rangeEnd )
+		{
+			( *static_cast<const tFunction*>( i_function ) )( i_rangeBegin, i_rangeEnd );
+		},
+		&i_function, i_begin, i_end, i_grainSize };
+	ParallelFor( parallelFor );
+}
+
+#endif	// EAE6320_CONCURRENCY_CJOBSYSTEM_INL
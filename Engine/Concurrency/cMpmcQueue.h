@@ -0,0 +1,117 @@
+/*
+	A multiple-producer/multiple-consumer queue is a bounded ring buffer
+	that any number of threads can push to and pop from without any locks
+
+	This is Dmitry Vyukov's bounded MPMC queue:
+	every slot has a sequence number that says whether it is waiting for the producer or the consumer of a given lap around the ring,
+	and threads claim a slot by incrementing the push (or pop) index with a compare-and-swap
+	and then only touch that slot.
+
+	Memory ordering:
+		* Everything that a producer did before a successful push
+			(including constructing the element) happens before the pop of that element returns
+		* Everything that a consumer did before a successful pop
+			(including destroying the element) happens before the slot's next push
+		* Slots are claimed for popping in the same order that they were claimed for pushing,
+			and so one consumer never sees two elements that one producer pushed out of order.
+			There is no order between elements pushed by different producers unless the producers order their pushes themselves
+
+	A push (or pop) claims a slot before it finishes constructing (or moving out) the element,
+	and so a thread can see the queue as empty (or full) for the short time that another thread is in the middle of using the next slot.
+	Neither operation ever blocks, though: they both fail instead
+*/
+
+#ifndef EAE6320_CONCURRENCY_CMPMCQUEUE_H
+#define EAE6320_CONCURRENCY_CMPMCQUEUE_H
+
+// Includes
+//=========
+
+#include "Constants.h"
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		template<typename tElement, size_t tCapacity>
+		class cMpmcQueue
+		{
+			static_assert( ( tCapacity > 1 ) && ( ( tCapacity & ( tCapacity - 1 ) ) == 0 ), "The capacity must be a power of two (and at least 2)" );
+			static_assert( std::is_nothrow_move_constructible<tElement>::value && std::is_nothrow_destructible<tElement>::value,
+				"Elements are moved and destroyed while other threads are using the queue and so mustn't throw" );
+
+			// Interface
+			//==========
+
+		public:
+
+			// Any thread can call these
+			// (they fail without changing anything if the queue is full or empty)
+			bool TryToPush( const tElement& i_element ) { return TryToEmplace( i_element ); }
+			bool TryToPush( tElement&& i_element ) { return TryToEmplace( std::move( i_element ) ); }
+			template<typename... tArguments>
+			bool TryToEmplace( tArguments&&... i_arguments );
+			bool TryToPop( tElement& o_element );
+
+			// Access
+			//-------
+
+			// The count can already be out of date when this returns
+			// (it includes elements that are in the middle of being pushed or popped)
+			size_t GetApproximateCount() const;
+			static constexpr size_t GetCapacity() { return tCapacity; }
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cMpmcQueue();
+			// Any elements that are still in the queue are destroyed
+			// (no other thread can be using the queue)
+			~cMpmcQueue();
+
+			// Data
+			//=====
+
+		private:
+
+			struct sSlot
+			{
+				// When this equals a push index the slot is waiting to be pushed to,
+				// and when it equals a pop index + 1 the slot is waiting to be popped from
+				std::atomic<size_t> sequence;
+				alignas( tElement ) unsigned char storage[sizeof( tElement )];
+			};
+
+			// Producers and consumers compete for different indices
+			// and so they are kept on separate cache lines (and away from the slots)
+			alignas( Constants::CacheLineSize ) std::atomic<size_t> m_pushIndex = 0;
+			alignas( Constants::CacheLineSize ) std::atomic<size_t> m_popIndex = 0;
+			alignas( Constants::CacheLineSize ) sSlot m_slots[tCapacity];
+
+			// Implementation
+			//===============
+
+		private:
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cMpmcQueue( const cMpmcQueue& ) = delete;
+			cMpmcQueue( cMpmcQueue&& ) = delete;
+			cMpmcQueue& operator =( const cMpmcQueue& ) = delete;
+			cMpmcQueue& operator =( cMpmcQueue&& ) = delete;
+		};
+	}
+}
+
+#include "cMpmcQueue.inl"
+
+#endif	// EAE6320_CONCURRENCY_CMPMCQUEUE_H
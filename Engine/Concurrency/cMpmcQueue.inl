@@ -0,0 +1,121 @@
+#ifndef EAE6320_CONCURRENCY_CMPMCQUEUE_INL
+#define EAE6320_CONCURRENCY_CMPMCQUEUE_INL
+
+// Includes
+//=========
+
+#include "cMpmcQueue.h"
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+// Interface
+//==========
+
+template<typename tElement, size_t tCapacity> template<typename... tArguments>
+bool eae6320::Concurrency::cMpmcQueue<tElement, tCapacity>::TryToEmplace( tArguments&&... i_arguments )
+{
+	auto pushIndex = m_pushIndex.load( std::memory_order_relaxed );
+	while ( true )
+	{
+		auto& slot = m_slots[pushIndex & ( tCapacity - 1 )];
+		// The acquire means that the previous lap's consumer has finished with the slot
+		const auto sequence = slot.sequence.load( std::memory_order_acquire );
+		const auto difference = static_cast<ptrdiff_t>( sequence - pushIndex );
+		if ( difference == 0 )
+		{
+			// The slot is free, but another producer could claim it first
+			if ( m_pushIndex.compare_exchange_weak( pushIndex, pushIndex + 1, std::memory_order_relaxed ) )
+			{
+				new ( slot.storage ) tElement( std::forward<tArguments>( i_arguments )... );
+				// The release publishes the element to consumers
+				slot.sequence.store( pushIndex + 1, std::memory_order_release );
+				return true;
+			}
+			// A failed compare-and-swap has already updated the push index
+		}
+		else if ( difference < 0 )
+		{
+			// The slot still holds the element from the previous lap
+			return false;
+		}
+		else
+		{
+			// Another producer claimed the slot since the push index was read
+			pushIndex = m_pushIndex.load( std::memory_order_relaxed );
+		}
+	}
+}
+
+template<typename tElement, size_t tCapacity>
+bool eae6320::Concurrency::cMpmcQueue<tElement, tCapacity>::TryToPop( tElement& o_element )
+{
+	auto popIndex = m_popIndex.load( std::memory_order_relaxed );
+	while ( true )
+	{
+		auto& slot = m_slots[popIndex & ( tCapacity - 1 )];
+		// The acquire means that the producer has finished constructing the element
+		const auto sequence = slot.sequence.load( std::memory_order_acquire );
+		const auto difference = static_cast<ptrdiff_t>( sequence - ( popIndex + 1 ) );
+		if ( difference == 0 )
+		{
+			// The slot has an element, but another consumer could claim it first
+			if ( m_popIndex.compare_exchange_weak( popIndex, popIndex + 1, std::memory_order_relaxed ) )
+			{
+				auto* const element = std::launder( reinterpret_cast<tElement*>( slot.storage ) );
+				o_element = std::move( *element );
+				element->~tElement();
+				// The release gives the slot to the next lap's producer
+				slot.sequence.store( popIndex + tCapacity, std::memory_order_release );
+				return true;
+			}
+		}
+		else if ( difference < 0 )
+		{
+			// The slot hasn't been pushed to yet
+			return false;
+		}
+		else
+		{
+			// Another consumer claimed the slot since the pop index was read
+			popIndex = m_popIndex.load( std::memory_order_relaxed );
+		}
+	}
+}
+
+// Access
+//-------
+
+template<typename tElement, size_t tCapacity>
+size_t eae6320::Concurrency::cMpmcQueue<tElement, tCapacity>::GetApproximateCount() const
+{
+	// The pop index is read first because it can never pass the push index
+	const auto popIndex = m_popIndex.load( std::memory_order_relaxed );
+	const auto pushIndex = m_pushIndex.load( std::memory_order_relaxed );
+	return std::min( pushIndex - popIndex, tCapacity );
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+template<typename tElement, size_t tCapacity>
+eae6320::Concurrency::cMpmcQueue<tElement, tCapacity>::cMpmcQueue()
+{
+	for ( size_t i = 0; i < tCapacity; ++i )
+	{
+		m_slots[i].sequence.store( i, std::memory_order_relaxed );
+	}
+}
+
+template<typename tElement, size_t tCapacity>
+eae6320::Concurrency::cMpmcQueue<tElement, tCapacity>::~cMpmcQueue()
+{
+	const auto pushIndex = m_pushIndex.load( std::memory_order_acquire );
+	for ( auto popIndex = m_popIndex.load( std::memory_order_relaxed ); popIndex != pushIndex; ++popIndex )
+	{
+		std::launder( reinterpret_cast<tElement*>( m_slots[popIndex & ( tCapacity - 1 )].storage ) )->~tElement();
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_CMPMCQUEUE_INL
@@ -0,0 +1,129 @@
+/*
+	A multiple-producer/single-consumer queue is a bounded ring buffer
+	that any number of threads can push to and one thread pops from without any locks
+
+	Pushing works the same way as cMpmcQueue
+	(producers claim slots with a compare-and-swap on the push index),
+	but since only one thread pops, popping doesn't need a compare-and-swap.
+	This makes it a good fit for things like messages or deferred releases
+	that many threads produce and one thread processes.
+
+	Memory ordering:
+		* Everything that a producer did before a successful push
+			(including constructing the element) happens before the consumer's pop of that element returns
+		* Everything that the consumer did before a successful pop
+			(including destroying the element) happens before the slot's next push
+		* The consumer pops elements in the order that producers claimed their slots,
+			and so it never sees two elements that one producer pushed out of order.
+			There is no order between elements pushed by different producers unless the producers order their pushes themselves
+
+	A producer claims a slot before it finishes constructing the element,
+	and the consumer can't pop any later elements until that one has been published.
+	The pop doesn't block, though: it fails as if the queue were empty
+*/
+
+#ifndef EAE6320_CONCURRENCY_CMPSCQUEUE_H
+#define EAE6320_CONCURRENCY_CMPSCQUEUE_H
+
+// Includes
+//=========
+
+#include "Constants.h"
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		template<typename tElement, size_t tCapacity>
+		class cMpscQueue
+		{
+			static_assert( ( tCapacity > 1 ) && ( ( tCapacity & ( tCapacity - 1 ) ) == 0 ), "The capacity must be a power of two (and at least 2)" );
+			static_assert( std::is_nothrow_move_constructible<tElement>::value && std::is_nothrow_destructible<tElement>::value,
+				"Elements are moved and destroyed while other threads are using the queue and so mustn't throw" );
+
+			// Interface
+			//==========
+
+		public:
+
+			// Producers
+			//----------
+
+			// Any thread can call these
+			// (they fail without changing anything if the queue is full)
+			bool TryToPush( const tElement& i_element ) { return TryToEmplace( i_element ); }
+			bool TryToPush( tElement&& i_element ) { return TryToEmplace( std::move( i_element ) ); }
+			template<typename... tArguments>
+			bool TryToEmplace( tArguments&&... i_arguments );
+
+			// Consumer
+			//---------
+
+			// Only the consumer thread can call this
+			// (it fails without changing anything if the queue is empty)
+			bool TryToPop( tElement& o_element );
+
+			// Access
+			//-------
+
+			// The count can already be out of date when this returns
+			// (it includes elements that are in the middle of being pushed)
+			size_t GetApproximateCount() const;
+			static constexpr size_t GetCapacity() { return tCapacity; }
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cMpscQueue();
+			// Any elements that are still in the queue are destroyed
+			// (no other thread can be using the queue)
+			~cMpscQueue();
+
+			// Data
+			//=====
+
+		private:
+
+			struct sSlot
+			{
+				// When this equals a push index the slot is waiting to be pushed to,
+				// and when it equals a pop index + 1 the slot is waiting to be popped from
+				std::atomic<size_t> sequence;
+				alignas( tElement ) unsigned char storage[sizeof( tElement )];
+			};
+
+			// The producers' cache line
+			alignas( Constants::CacheLineSize ) std::atomic<size_t> m_pushIndex = 0;
+			// The consumer's cache line
+			// (only the consumer changes this,
+			// but it is atomic so that other threads can read it in GetApproximateCount())
+			alignas( Constants::CacheLineSize ) std::atomic<size_t> m_popIndex = 0;
+			alignas( Constants::CacheLineSize ) sSlot m_slots[tCapacity];
+
+			// Implementation
+			//===============
+
+		private:
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cMpscQueue( const cMpscQueue& ) = delete;
+			cMpscQueue( cMpscQueue&& ) = delete;
+			cMpscQueue& operator =( const cMpscQueue& ) = delete;
+			cMpscQueue& operator =( cMpscQueue&& ) = delete;
+		};
+	}
+}
+
+#include "cMpscQueue.inl"
+
+#endif	// EAE6320_CONCURRENCY_CMPSCQUEUE_H
@@ -0,0 +1,111 @@
+#ifndef EAE6320_CONCURRENCY_CMPSCQUEUE_INL
+#define EAE6320_CONCURRENCY_CMPSCQUEUE_INL
+
+// Includes
+//=========
+
+#include "cMpscQueue.h"
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+// Interface
+//==========
+
+// Producers
+//----------
+
+template<typename tElement, size_t tCapacity> template<typename... tArguments>
+bool eae6320::Concurrency::cMpscQueue<tElement, tCapacity>::TryToEmplace( tArguments&&... i_arguments )
+{
+	auto pushIndex = m_pushIndex.load( std::memory_order_relaxed );
+	while ( true )
+	{
+		auto& slot = m_slots[pushIndex & ( tCapacity - 1 )];
+		// The acquire means that the consumer has finished with the slot
+		const auto sequence = slot.sequence.load( std::memory_order_acquire );
+		const auto difference = static_cast<ptrdiff_t>( sequence - pushIndex );
+		if ( difference == 0 )
+		{
+			// The slot is free, but another producer could claim it first
+			if ( m_pushIndex.compare_exchange_weak( pushIndex, pushIndex + 1, std::memory_order_relaxed ) )
+			{
+				new ( slot.storage ) tElement( std::forward<tArguments>( i_arguments )... );
+				// The release publishes the element to the consumer
+				slot.sequence.store( pushIndex + 1, std::memory_order_release );
+				return true;
+			}
+			// A failed compare-and-swap has already updated the push index
+		}
+		else if ( difference < 0 )
+		{
+			// The slot still holds the element from the previous lap
+			return false;
+		}
+		else
+		{
+			// Another producer claimed the slot since the push index was read
+			pushIndex = m_pushIndex.load( std::memory_order_relaxed );
+		}
+	}
+}
+
+// Consumer
+//---------
+
+template<typename tElement, size_t tCapacity>
+bool eae6320::Concurrency::cMpscQueue<tElement, tCapacity>::TryToPop( tElement& o_element )
+{
+	// Only the consumer changes the pop index
+	const auto popIndex = m_popIndex.load( std::memory_order_relaxed );
+	auto& slot = m_slots[popIndex & ( tCapacity - 1 )];
+	// The acquire means that the producer has finished constructing the element
+	if ( slot.sequence.load( std::memory_order_acquire ) != ( popIndex + 1 ) )
+	{
+		return false;
+	}
+	auto* const element = std::launder( reinterpret_cast<tElement*>( slot.storage ) );
+	o_element = std::move( *element );
+	element->~tElement();
+	// The release gives the slot to the next lap's producer
+	slot.sequence.store( popIndex + tCapacity, std::memory_order_release );
+	m_popIndex.store( popIndex + 1, std::memory_order_relaxed );
+	return true;
+}
+
+// Access
+//-------
+
+template<typename tElement, size_t tCapacity>
+size_t eae6320::Concurrency::cMpscQueue<tElement, tCapacity>::GetApproximateCount() const
+{
+	// The pop index is read first because it can never pass the push index
+	const auto popIndex = m_popIndex.load( std::memory_order_relaxed );
+	const auto pushIndex = m_pushIndex.load( std::memory_order_relaxed );
+	return std::min( pushIndex - popIndex, tCapacity );
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+template<typename tElement, size_t tCapacity>
+eae6320::Concurrency::cMpscQueue<tElement, tCapacity>::cMpscQueue()
+{
+	for ( size_t i = 0; i < tCapacity; ++i )
+	{
+		m_slots[i].sequence.store( i, std::memory_order_relaxed );
+	}
+}
+
+template<typename tElement, size_t tCapacity>
+eae6320::Concurrency::cMpscQueue<tElement, tCapacity>::~cMpscQueue()
+{
+	const auto pushIndex = m_pushIndex.load( std::memory_order_acquire );
+	for ( auto popIndex = m_popIndex.load( std::memory_order_relaxed ); popIndex != pushIndex; ++popIndex )
+	{
+		std::launder( reinterpret_cast<tElement*>( m_slots[popIndex & ( tCapacity - 1 )].storage ) )->~tElement();
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_CMPSCQUEUE_INL
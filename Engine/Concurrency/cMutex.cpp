@@ -0,0 +1,121 @@
+// Includes
+//=========
+
+#include "cMutex.h"
+
+#ifdef EAE6320_CONCURRENCY_ISSYNCHRONIZATIONBENCHMARKENABLED
+	#include "cThread.h"
+
+	#include <atomic>
+	#include <Engine/Logging/Logging.h>
+	#include <Engine/Time/Time.h>
+	#include <memory>
+	#include <mutex>
+	#include <thread>
+#endif
+
+// Interface
+//==========
+
+#ifdef EAE6320_CONCURRENCY_ISSYNCHRONIZATIONBENCHMARKENABLED
+
+void eae6320::Concurrency::cMutex::RunBenchmark()
+{
+	constexpr unsigned int lockCount_uncontended = 10000000;
+	constexpr unsigned int lockCountPerThread_contended = 200000;
+	constexpr unsigned int threadCounts_contended[] = { 2, 4, 8 };
+
+	// The two kinds of mutex are wrapped in the same interface
+	// so that the same code can measure both of them
+	struct sEngineMutex
+	{
+		cMutex mutex;
+		void Lock() { mutex.Lock(); }
+		void Unlock() { mutex.Unlock(); }
+	};
+	struct sStandardMutex
+	{
+		std::mutex mutex;
+		void Lock() { mutex.lock(); }
+		void Unlock() { mutex.unlock(); }
+	};
+
+	const auto GetMilliseconds = []( const uint64_t i_tickCount )
+	{
+		return Time::ConvertTicksToSeconds( i_tickCount ) * 1000.0;
+	};
+	const auto MeasureUncontended = [&GetMilliseconds]( auto& io_mutex )
+	{
+		const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+		for ( unsigned int i = 0; i < lockCount_uncontended; ++i )
+		{
+			io_mutex.Lock();
+			io_mutex.Unlock();
+		}
+		return GetMilliseconds( Time::GetCurrentSystemTimeTickCount() - tickCount_start );
+	};
+	// Every thread repeatedly locks the mutex and increments a shared count
+	// (and so the final count shows whether the mutex really was mutually exclusive)
+	const auto MeasureContended = [&GetMilliseconds]( auto& io_mutex, const unsigned int i_threadCount, bool& o_wasCountCorrect )
+	{
+		std::atomic<bool> shouldStart = false;
+		uint64_t sharedCount = 0;
+		std::unique_ptr<cThread[]> threads( new cThread[i_threadCount] );
+		for ( unsigned int i = 0; i < i_threadCount; ++i )
+		{
+			const auto result = threads[i].Start(
+				[&io_mutex, &shouldStart, &sharedCount]( void* const )
+				{
+					// Wait for the other threads to start so that they all compete for the mutex
+					while ( !shouldStart.load() )
+					{
+						std::this_thread::yield();
+					}
+					for ( unsigned int j = 0; j < lockCountPerThread_contended; ++j )
+					{
+						io_mutex.Lock();
+						++sharedCount;
+						io_mutex.Unlock();
+					}
+				} );
+			if ( !result )
+			{
+				Logging::OutputError( "\tA benchmark thread couldn't be started" );
+				return 0.0;
+			}
+		}
+		const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+		shouldStart = true;
+		for ( unsigned int i = 0; i < i_threadCount; ++i )
+		{
+			WaitForThreadToStop( threads[i] );
+		}
+		const auto milliseconds = GetMilliseconds( Time::GetCurrentSystemTimeTickCount() - tickCount_start );
+		o_wasCountCorrect = sharedCount == ( uint64_t( i_threadCount ) * lockCountPerThread_contended );
+		return milliseconds;
+	};
+
+	Logging::OutputMessage( "Mutex benchmark:" );
+	{
+		sEngineMutex engineMutex;
+		sStandardMutex standardMutex;
+		const auto milliseconds_engine = MeasureUncontended( engineMutex );
+		const auto milliseconds_standard = MeasureUncontended( standardMutex );
+		Logging::OutputMessage( "\tUncontended (%u locks): cMutex %.2f ns, std::mutex %.2f ns per lock and unlock",
+			lockCount_uncontended,
+			( milliseconds_engine * 1.0e6 ) / lockCount_uncontended, ( milliseconds_standard * 1.0e6 ) / lockCount_uncontended );
+	}
+	for ( const auto threadCount : threadCounts_contended )
+	{
+		sEngineMutex engineMutex;
+		sStandardMutex standardMutex;
+		bool wasCountCorrect_engine = false, wasCountCorrect_standard = false;
+		const auto milliseconds_engine = MeasureContended( engineMutex, threadCount, wasCountCorrect_engine );
+		const auto milliseconds_standard = MeasureContended( standardMutex, threadCount, wasCountCorrect_standard );
+		Logging::OutputMessage( "\t%u threads (%u locks each): cMutex %.3f ms, std::mutex %.3f ms%s",
+			threadCount, lockCountPerThread_contended, milliseconds_engine, milliseconds_standard,
+			( wasCountCorrect_engine && wasCountCorrect_standard ) ? "" : " (THE SHARED COUNT WAS WRONG!)" );
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_ISSYNCHRONIZATIONBENCHMARKENABLED
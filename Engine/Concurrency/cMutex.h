@@ -12,10 +12,15 @@
 // Includes
 //=========
 
+#include "Configuration.h"
+
 #include <Engine/Results/Results.h>
 
 #if defined( EAE6320_PLATFORM_WINDOWS )
 	#include <Engine/Windows/Includes.h>
+#elif defined( EAE6320_PLATFORM_LINUX )
+	#include <atomic>
+	#include <cstdint>
 #endif
 
 // Class Declaration
@@ -63,6 +68,12 @@ namespace eae6320
 			// The results are undefined if this is called when a lock isn't held.
 			void Unlock();
 
+#ifdef EAE6320_CONCURRENCY_ISSYNCHRONIZATIONBENCHMARKENABLED
+			// Locks and unlocks with one thread and with several threads competing for the lock
+			// and writes how long it takes compared to std::mutex to the log
+			static void RunBenchmark();
+#endif
+
 			// Initialization / Clean Up
 			//--------------------------
 
@@ -76,6 +87,11 @@ namespace eae6320
 
 #if defined( EAE6320_PLATFORM_WINDOWS )
 			SRWLOCK m_srwLock;
+#elif defined( EAE6320_PLATFORM_LINUX )
+			// The futex word is 0 when the mutex is unlocked, 1 when it is locked,
+			// and 2 when it is locked and other threads might be sleeping while they wait for it
+			// (unlocking only needs a system call in that last state)
+			std::atomic<uint32_t> m_state = 0;
 #endif
 
 			// Implementation
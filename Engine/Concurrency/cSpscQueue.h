@@ -0,0 +1,118 @@
+/*
+	A single-producer/single-consumer queue is a bounded ring buffer
+	that one thread pushes to and one (other) thread pops from without any locks
+
+	Memory ordering:
+		* Everything that the producer did before a successful push
+			(including constructing the element) happens before the consumer's pop of that element returns
+		* Everything that the consumer did before a successful pop
+			(including destroying the element) happens before the producer reuses that slot
+		* Elements are popped in exactly the order that they were pushed
+
+	Each thread keeps a copy of the other thread's index on its own cache line
+	and only reads the real one when its copy says that the queue is full (or empty),
+	and so in the steady state the two threads don't touch each other's cache lines except for the elements themselves.
+*/
+
+#ifndef EAE6320_CONCURRENCY_CSPSCQUEUE_H
+#define EAE6320_CONCURRENCY_CSPSCQUEUE_H
+
+// Includes
+//=========
+
+#include "Constants.h"
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Concurrency
+	{
+		template<typename tElement, size_t tCapacity>
+		class cSpscQueue
+		{
+			static_assert( ( tCapacity > 0 ) && ( ( tCapacity & ( tCapacity - 1 ) ) == 0 ), "The capacity must be a power of two" );
+			static_assert( std::is_nothrow_move_constructible<tElement>::value && std::is_nothrow_destructible<tElement>::value,
+				"Elements are moved and destroyed while another thread is using the queue and so mustn't throw" );
+
+			// Interface
+			//==========
+
+		public:
+
+			// Producer
+			//---------
+
+			// Only the producer thread can call these
+			// (they fail without changing anything if the queue is full)
+			bool TryToPush( const tElement& i_element ) { return TryToEmplace( i_element ); }
+			bool TryToPush( tElement&& i_element ) { return TryToEmplace( std::move( i_element ) ); }
+			template<typename... tArguments>
+			bool TryToEmplace( tArguments&&... i_arguments );
+
+			// Consumer
+			//---------
+
+			// Only the consumer thread can call this
+			// (it fails without changing anything if the queue is empty)
+			bool TryToPop( tElement& o_element );
+
+			// Access
+			//-------
+
+			// Any thread can call this,
+			// but unless it is called by the producer or consumer the count can already be out of date when it returns
+			size_t GetApproximateCount() const;
+			static constexpr size_t GetCapacity() { return tCapacity; }
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cSpscQueue() = default;
+			// Any elements that are still in the queue are destroyed
+			// (no other thread can be using the queue)
+			~cSpscQueue();
+
+			// Data
+			//=====
+
+		private:
+
+			struct sSlot
+			{
+				alignas( tElement ) unsigned char storage[sizeof( tElement )];
+			};
+
+			// The producer's cache line
+			alignas( Constants::CacheLineSize ) std::atomic<size_t> m_pushIndex = 0;
+			size_t m_popIndex_producerCopy = 0;
+			// The consumer's cache line
+			alignas( Constants::CacheLineSize ) std::atomic<size_t> m_popIndex = 0;
+			size_t m_pushIndex_consumerCopy = 0;
+			alignas( Constants::CacheLineSize ) sSlot m_slots[tCapacity];
+
+			// Implementation
+			//===============
+
+		private:
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cSpscQueue( const cSpscQueue& ) = delete;
+			cSpscQueue( cSpscQueue&& ) = delete;
+			cSpscQueue& operator =( const cSpscQueue& ) = delete;
+			cSpscQueue& operator =( cSpscQueue&& ) = delete;
+		};
+	}
+}
+
+#include "cSpscQueue.inl"
+
+#endif	// EAE6320_CONCURRENCY_CSPSCQUEUE_H
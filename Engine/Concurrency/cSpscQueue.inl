@@ -0,0 +1,89 @@
+#ifndef EAE6320_CONCURRENCY_CSPSCQUEUE_INL
+#define EAE6320_CONCURRENCY_CSPSCQUEUE_INL
+
+// Includes
+//=========
+
+#include "cSpscQueue.h"
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+// Interface
+//==========
+
+// Producer
+//---------
+
+template<typename tElement, size_t tCapacity> template<typename... tArguments>
+bool eae6320::Concurrency::cSpscQueue<tElement, tCapacity>::TryToEmplace( tArguments&&... i_arguments )
+{
+	// Only the producer changes the push index
+	const auto pushIndex = m_pushIndex.load( std::memory_order_relaxed );
+	if ( ( pushIndex - m_popIndex_producerCopy ) >= tCapacity )
+	{
+		// The acquire means that the consumer has finished with the slot that is about to be reused
+		m_popIndex_producerCopy = m_popIndex.load( std::memory_order_acquire );
+		if ( ( pushIndex - m_popIndex_producerCopy ) >= tCapacity )
+		{
+			return false;
+		}
+	}
+	new ( m_slots[pushIndex & ( tCapacity - 1 )].storage ) tElement( std::forward<tArguments>( i_arguments )... );
+	// The release publishes the element to the consumer
+	m_pushIndex.store( pushIndex + 1, std::memory_order_release );
+	return true;
+}
+
+// Consumer
+//---------
+
+template<typename tElement, size_t tCapacity>
+bool eae6320::Concurrency::cSpscQueue<tElement, tCapacity>::TryToPop( tElement& o_element )
+{
+	// Only the consumer changes the pop index
+	const auto popIndex = m_popIndex.load( std::memory_order_relaxed );
+	if ( popIndex == m_pushIndex_consumerCopy )
+	{
+		// The acquire means that the producer has finished constructing the element
+		m_pushIndex_consumerCopy = m_pushIndex.load( std::memory_order_acquire );
+		if ( popIndex == m_pushIndex_consumerCopy )
+		{
+			return false;
+		}
+	}
+	auto* const element = std::launder( reinterpret_cast<tElement*>( m_slots[popIndex & ( tCapacity - 1 )].storage ) );
+	o_element = std::move( *element );
+	element->~tElement();
+	// The release gives the slot back to the producer
+	m_popIndex.store( popIndex + 1, std::memory_order_release );
+	return true;
+}
+
+// Access
+//-------
+
+template<typename tElement, size_t tCapacity>
+size_t eae6320::Concurrency::cSpscQueue<tElement, tCapacity>::GetApproximateCount() const
+{
+	// The pop index is read first because it can never pass the push index
+	const auto popIndex = m_popIndex.load( std::memory_order_relaxed );
+	const auto pushIndex = m_pushIndex.load( std::memory_order_relaxed );
+	return std::min( pushIndex - popIndex, tCapacity );
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+template<typename tElement, size_t tCapacity>
+eae6320::Concurrency::cSpscQueue<tElement, tCapacity>::~cSpscQueue()
+{
+	const auto pushIndex = m_pushIndex.load( std::memory_order_acquire );
+	for ( auto popIndex = m_popIndex.load( std::memory_order_relaxed ); popIndex != pushIndex; ++popIndex )
+	{
+		std::launder( reinterpret_cast<tElement*>( m_slots[popIndex & ( tCapacity - 1 )].storage ) )->~tElement();
+	}
+}
+
+#endif	// EAE6320_CONCURRENCY_CSPSCQUEUE_INL
@@ -12,11 +12,14 @@
 
 #include "Constants.h"
 
+#include <cstdint>
 #include <Engine/Results/Results.h>
 #include <functional>
 
 #if defined( EAE6320_PLATFORM_WINDOWS )
 	#include <Engine/Windows/Includes.h>
+#elif defined( EAE6320_PLATFORM_LINUX )
+	#include <pthread.h>
 #endif
 
 // Class Declaration
@@ -32,6 +35,13 @@ namespace eae6320
 		// which allows shared data to be passed to the new thread.
 		using fThreadFunction = std::function<void(void* const)>;
 
+		class cThread;
+
+		// A default argument can't be given in a friend declaration
+		// (unless it is also the definition),
+		// and so the function is declared here and befriended by the class
+		cResult WaitForThreadToStop( cThread& io_thread, const unsigned int i_timeToWait_inMilliseconds = Constants::DontTimeOut );
+
 		class cThread
 		{
 			// Interface
@@ -49,7 +59,17 @@ namespace eae6320
 			//	* The specified time-out period elapses
 			//		* If the caller doesn't specify a time-out period then the function will never return until the thread stops
 			//		* If the caller specifies a time-out period of zero then the function will return immediately
-			friend cResult WaitForThreadToStop( cThread& io_thread, const unsigned int i_timeToWait_inMilliseconds = Constants::DontTimeOut );
+			friend cResult WaitForThreadToStop( cThread& io_thread, const unsigned int i_timeToWait_inMilliseconds );
+
+			// The following functions can only be called after the thread has been started
+
+			// The name is shown in debuggers and profilers
+			// (Linux only keeps the first 15 characters)
+			cResult SetName( const char* const i_name );
+			// Each bit of the mask is a hardware thread that the thread is allowed to run on
+			// (only the first 64 hardware threads can be specified,
+			// and only the first 32 in a 32-bit Windows build)
+			cResult SetAffinity( const uint64_t i_hardwareThreadMask );
 
 			// Initialization / Clean Up
 			//--------------------------
@@ -64,6 +84,10 @@ namespace eae6320
 
 #if defined( EAE6320_PLATFORM_WINDOWS )
 			HANDLE m_handle = NULL;
+#elif defined( EAE6320_PLATFORM_LINUX )
+			pthread_t m_thread;
+			// A pthread_t doesn't have an invalid value
+			bool m_isRunning = false;
 #endif
 
 			// Implementation
@@ -79,11 +103,6 @@ namespace eae6320
 			cThread& operator =( const cThread& ) = delete;
 			cThread& operator =( cThread&& ) = delete;
 		};
-
-		// Friends
-		//========
-
-		cResult WaitForThreadToStop( cThread& io_thread, const unsigned int i_timeToWait_inMilliseconds );
 	}
 }
 
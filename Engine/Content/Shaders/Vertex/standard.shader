@@ -27,6 +27,11 @@ DeclareConstantBuffer( g_constantBuffer_frame, 0 )
 DeclareConstantBuffer( g_constantBuffer_drawCall, 2 )
 {
     float4x4 g_transform_localToWorld;
+
+	float3 g_vertexPosition_offset;
+	float g_padding_drawCall0;
+	float3 g_vertexPosition_scale;
+	float g_padding_drawCall1;
 };
 
 // Input
@@ -44,7 +49,7 @@ vertex_main(void)
 	{
 		// This will be done in a future assignment.
 		// For now, however, local space is treated as if it is the same as world space.
-		float4 vertexPosition_local = float4( i_vertexPosition_local, 1.0 );
+		float4 vertexPosition_local = float4( DecodeVertexPosition( i_vertexPosition_local, g_vertexPosition_offset, g_vertexPosition_scale ), 1.0 );
 		vertexPosition_world = mul( g_transform_localToWorld, vertexPosition_local );
 	}
 	// Calculate the position of this vertex projected onto the display
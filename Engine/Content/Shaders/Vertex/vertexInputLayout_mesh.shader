@@ -21,7 +21,10 @@ vertex_main(void)
 {
 	// The shader program is only used to generate a vertex input layout object;
 	// the actual shading code is never used
-	o_vertex2frag.position = float4( i_vertexData.position, 1.0 );
+	// (The instance transform is used so that it is part of the input signature)
+	float4x4 transform_localToWorld = CreateMatrixFromColumns( i_vertexData.transform_localToWorld_column0, i_vertexData.transform_localToWorld_column1,
+		i_vertexData.transform_localToWorld_column2, i_vertexData.transform_localToWorld_column3 );
+	o_vertex2frag.position = mul( transform_localToWorld, float4( i_vertexData.position, 1.0 ) );
 	o_vertex2frag.uv = i_vertexData.texcoord;
 	o_vertex2frag.color = i_vertexData.color;
 
@@ -17,4 +17,21 @@
 	#define EAE6320_GRAPHICS_AREDEBUGSHADERSENABLED
 #endif
 
+// The render queue benchmark sorts synthetic scenes at initialization
+// and writes the sort cost and bind counts to the log
+//#define EAE6320_GRAPHICS_ISRENDERQUEUEBENCHMARKENABLED
+
+// The occlusion culling benchmark rasterizes a synthetic interior at initialization
+// and writes the rasterization and testing costs to the log
+//#define EAE6320_GRAPHICS_ISOCCLUSIONBENCHMARKENABLED
+
+// The occlusion culling test rasterizes fixed occluders at initialization
+// and asserts that the depth image and the visibility of test boxes match a stored reference
+//#define EAE6320_GRAPHICS_ISOCCLUSIONTESTENABLED
+
+// The submission tests fill every frame packet with more render commands for one mesh than its reference count can hold
+// at initialization and assert that the renderer's references to the mesh are balanced,
+// and submit a frame from several jobs and assert that its commands are drawn in the same order as when one thread submits them
+//#define EAE6320_GRAPHICS_ISSUBMISSIONTESTENABLED
+
 #endif	// EAE6320_GRAPHICS_CONFIGURATION_H
@@ -41,7 +41,13 @@ namespace eae6320
 			// Data that is constant for a material
 			struct sMaterial
 			{
+				float g_baseColor[3] = { 1.0f, 1.0f, 1.0f };
+				// 1 - the authored transparency
+				float g_opacity = 1.0f;
 
+				float g_specularColor[3] = {};
+				// For float4 alignment
+				float padding;
 			};
 
 			// Data that is constant for a single draw call
@@ -49,7 +55,14 @@ namespace eae6320
 			{
 				Math::cMatrix_transformation g_transform_localToWorld;
 
-				
+				// Mesh vertex positions are stored relative to the mesh's bounds
+				// (position = offset + ( quantized position * scale ))
+				float g_vertexPosition_offset[3] = {};
+				// For float4 alignment
+				float padding0;
+				float g_vertexPosition_scale[3] = { 1.0f, 1.0f, 1.0f };
+				// For float4 alignment
+				float padding1;
 
 				float g_light_position[3];
 				float g_light_color[3];
@@ -6,13 +6,26 @@
 #include "Includes.h"
 #include "../cShader.h"
 #include "../sContext.h"
+#include "../sStateCache.h"
 
+#include <algorithm>
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Logging/Logging.h>
 #include <Engine/Math/Functions.h>
 #include <Engine/ScopeGuard/cScopeGuard.h>
 #include <limits>
 
+// Static Data
+//============
+
+namespace
+{
+	// Direct3D 11.1 requires bound ranges to start at (and be a multiple of) 16 constants,
+	// where each constant is 16 bytes
+	constexpr unsigned int s_bytesPerConstant = 16;
+	constexpr unsigned int s_ringBlockAlignment = 16 * s_bytesPerConstant;
+}
+
 // Interface
 //==========
 
@@ -21,20 +34,9 @@
 
 void eae6320::Graphics::cConstantBuffer::Bind( const uint_fast8_t i_shaderTypesToBindTo ) const
 {
-	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
-	EAE6320_ASSERT( direct3dImmediateContext );
-
 	EAE6320_ASSERT( m_buffer );
 
-	constexpr unsigned int bufferCount = 1;
-	if ( i_shaderTypesToBindTo & static_cast<decltype( i_shaderTypesToBindTo )>( eShaderType::Vertex ) )
-	{
-		direct3dImmediateContext->VSSetConstantBuffers( static_cast<unsigned int>( m_type ), bufferCount, &m_buffer );
-	}
-	if ( i_shaderTypesToBindTo & static_cast<decltype( i_shaderTypesToBindTo )>( eShaderType::Fragment ) )
-	{
-		direct3dImmediateContext->PSSetConstantBuffers( static_cast<unsigned int>( m_type ), bufferCount, &m_buffer );
-	}
+	sStateCache::g_stateCache.BindConstantBuffer( i_shaderTypesToBindTo, static_cast<unsigned int>( m_type ), m_buffer );
 }
 
 void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data )
@@ -43,6 +45,7 @@ void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data )
 	EAE6320_ASSERT( direct3dImmediateContext );
 
 	EAE6320_ASSERT( m_buffer );
+	EAE6320_ASSERTF( m_ringBlockStride == 0, "A dynamic ring must be written with MapRing()" );
 
 	auto mustConstantBufferBeUnmapped = false;
 	cScopeGuard scopeGuard( [this, direct3dImmediateContext, &mustConstantBufferBeUnmapped]
@@ -83,6 +86,83 @@ void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data )
 	memcpy( memoryToWriteTo, i_data, m_size );
 }
 
+// Dynamic Ring
+//-------------
+
+void* eae6320::Graphics::cConstantBuffer::MapRing( const uint32_t i_blockCount )
+{
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+	EAE6320_ASSERT( direct3dImmediateContext );
+
+	EAE6320_ASSERT( m_buffer );
+	EAE6320_ASSERTF( m_ringBlockStride > 0, "The constant buffer wasn't initialized as a dynamic ring" );
+
+	if ( i_blockCount == 0 )
+	{
+		return nullptr;
+	}
+
+	// Grow the ring if this frame needs more blocks than it can hold
+	if ( i_blockCount > m_ringBlockCountPerFrame )
+	{
+		const auto blockCountPerFrame_previous = m_ringBlockCountPerFrame;
+		m_ringBlockCountPerFrame = std::max( i_blockCount, m_ringBlockCountPerFrame * 2 );
+		if ( !AllocateRing_platformSpecific() )
+		{
+			m_ringBlockCountPerFrame = blockCountPerFrame_previous;
+			return nullptr;
+		}
+		Logging::OutputMessage( "The dynamic ring for constant buffer %u grew to %u blocks per frame",
+			static_cast<unsigned int>( m_type ), m_ringBlockCountPerFrame );
+	}
+
+	// Discarding gives the CPU new memory if the GPU is still reading the previous frame's blocks
+	// (Direct3D tracks this internally, and so the ring doesn't need its own fences)
+	D3D11_MAPPED_SUBRESOURCE mappedSubResource;
+	{
+		constexpr unsigned int noSubResources = 0;
+		constexpr D3D11_MAP mapType = D3D11_MAP_WRITE_DISCARD;
+		constexpr unsigned int noFlags = 0;
+		const auto d3dResult = direct3dImmediateContext->Map( m_buffer, noSubResources, mapType, noFlags, &mappedSubResource );
+		if ( FAILED( d3dResult ) )
+		{
+			EAE6320_ASSERTF( false, "Couldn't map the dynamic ring (HRESULT %#010x)", d3dResult );
+			Logging::OutputError( "Direct3D failed to map the dynamic ring for constant buffer %u with HRESULT %#010x",
+				static_cast<unsigned int>( m_type ), d3dResult );
+			return nullptr;
+		}
+	}
+	return mappedSubResource.pData;
+}
+
+void eae6320::Graphics::cConstantBuffer::UnmapRing()
+{
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+	EAE6320_ASSERT( direct3dImmediateContext );
+
+	EAE6320_ASSERT( m_buffer );
+
+	constexpr unsigned int noSubResources = 0;
+	direct3dImmediateContext->Unmap( m_buffer, noSubResources );
+}
+
+void eae6320::Graphics::cConstantBuffer::BindRange( const uint_fast8_t i_shaderTypesToBindTo, const uint32_t i_blockIndex ) const
+{
+	EAE6320_ASSERT( m_buffer );
+	EAE6320_ASSERT( i_blockIndex < m_ringBlockCountPerFrame );
+
+	const auto constantCount = static_cast<unsigned int>( m_ringBlockStride / s_bytesPerConstant );
+	const auto firstConstant = constantCount * i_blockIndex;
+	sStateCache::g_stateCache.BindConstantBuffer( i_shaderTypesToBindTo, static_cast<unsigned int>( m_type ), m_buffer,
+		firstConstant, constantCount );
+}
+
+void eae6320::Graphics::cConstantBuffer::EndRingFrame()
+{
+	// Mapping with D3D11_MAP_WRITE_DISCARD already guarantees
+	// that the CPU never writes to memory that the GPU is reading
+}
+
 // Initialize / Clean Up
 //----------------------
 
@@ -156,3 +236,55 @@ eae6320::cResult eae6320::Graphics::cConstantBuffer::Initialize_platformSpecific
 		return Results::Failure;
 	}
 }
+
+eae6320::cResult eae6320::Graphics::cConstantBuffer::InitializeRing_platformSpecific()
+{
+	// Each draw call binds a range of the ring
+	if ( !sStateCache::g_stateCache.CanBindConstantBufferRanges() )
+	{
+		EAE6320_ASSERTF( false, "A dynamic ring constant buffer requires Direct3D 11.1" );
+		eae6320::Logging::OutputError( "A dynamic ring constant buffer can't be created because Direct3D 11.1 isn't available" );
+		return Results::Failure;
+	}
+	m_ringBlockStride = Math::RoundUpToMultiple_powerOf2( m_size, static_cast<size_t>( s_ringBlockAlignment ) );
+
+	return AllocateRing_platformSpecific();
+}
+
+eae6320::cResult eae6320::Graphics::cConstantBuffer::AllocateRing_platformSpecific()
+{
+	auto* const direct3dDevice = sContext::g_context.direct3dDevice;
+	EAE6320_ASSERT( direct3dDevice );
+
+	if ( m_buffer )
+	{
+		m_buffer->Release();
+		m_buffer = nullptr;
+	}
+
+	const auto size = m_ringBlockStride * m_ringBlockCountPerFrame;
+	EAE6320_ASSERTF( size <= std::numeric_limits<unsigned int>::max(),
+		"The dynamic ring's size (%u) is too large to fit into a D3D11_BUFFER_DESC", size );
+	D3D11_BUFFER_DESC bufferDescription{};
+	{
+		bufferDescription.ByteWidth = static_cast<unsigned int>( size );
+		bufferDescription.Usage = D3D11_USAGE_DYNAMIC;	// The CPU must be able to update the buffer
+		bufferDescription.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+		bufferDescription.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;	// The CPU must write, but doesn't read
+		bufferDescription.MiscFlags = 0;
+		bufferDescription.StructureByteStride = 0;	// Not used
+	}
+
+	const auto d3dResult = direct3dDevice->CreateBuffer( &bufferDescription, nullptr, &m_buffer );
+	if ( SUCCEEDED( d3dResult ) )
+	{
+		return Results::Success;
+	}
+	else
+	{
+		EAE6320_ASSERTF( false, "Couldn't create the dynamic ring (HRESULT %#010x)", d3dResult );
+		eae6320::Logging::OutputError( "Direct3D failed to create a %u byte dynamic ring constant buffer with HRESULT %#010x",
+			static_cast<unsigned int>( size ), d3dResult );
+		return Results::Failure;
+	}
+}
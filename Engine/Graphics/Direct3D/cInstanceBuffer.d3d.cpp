@@ -0,0 +1,129 @@
+// Includes
+//=========
+
+#include "../cInstanceBuffer.h"
+
+#include "Includes.h"
+#include "../sContext.h"
+#include "../VertexFormats.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <limits>
+
+// Interface
+//==========
+
+// Update
+//-------
+
+eae6320::Graphics::VertexFormats::sInstance_mesh* eae6320::Graphics::cInstanceBuffer::Map()
+{
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+	EAE6320_ASSERT( direct3dImmediateContext );
+
+	EAE6320_ASSERT( m_buffer );
+
+	D3D11_MAPPED_SUBRESOURCE mappedSubResource;
+	{
+		// Discard previous contents when writing
+		constexpr unsigned int noSubResources = 0;
+		constexpr D3D11_MAP mapType = D3D11_MAP_WRITE_DISCARD;
+		constexpr unsigned int noFlags = 0;
+		const auto d3dResult = direct3dImmediateContext->Map( m_buffer, noSubResources, mapType, noFlags, &mappedSubResource );
+		if ( FAILED( d3dResult ) )
+		{
+			EAE6320_ASSERTF( false, "Couldn't map instance buffer (HRESULT %#010x)", d3dResult );
+			Logging::OutputError( "Direct3D failed to map an instance buffer (HRESULT %#010x)", d3dResult );
+			return nullptr;
+		}
+	}
+	return reinterpret_cast<VertexFormats::sInstance_mesh*>( mappedSubResource.pData );
+}
+
+void eae6320::Graphics::cInstanceBuffer::Unmap()
+{
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+	EAE6320_ASSERT( direct3dImmediateContext );
+
+	EAE6320_ASSERT( m_buffer );
+
+	// Let Direct3D know that the memory contains the data
+	// (the pointer will be invalid after this call)
+	constexpr unsigned int noSubResources = 0;
+	direct3dImmediateContext->Unmap( m_buffer, noSubResources );
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cInstanceBuffer::CleanUp()
+{
+	auto result = Results::Success;
+
+	if ( m_buffer )
+	{
+		m_buffer->Release();
+		m_buffer = nullptr;
+	}
+
+	return result;
+}
+
+// Implementation
+//===============
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cInstanceBuffer::Initialize_platformSpecific()
+{
+	return Allocate_platformSpecific();
+}
+
+eae6320::cResult eae6320::Graphics::cInstanceBuffer::Allocate_platformSpecific()
+{
+	// A Direct3D buffer can't be resized, and so a new one is created
+	if ( m_buffer )
+	{
+		m_buffer->Release();
+		m_buffer = nullptr;
+	}
+
+	auto* const direct3dDevice = sContext::g_context.direct3dDevice;
+	EAE6320_ASSERT( direct3dDevice );
+
+	const auto bufferSize = static_cast<uint64_t>( sizeof( VertexFormats::sInstance_mesh ) ) * m_capacity;
+	if ( bufferSize > std::numeric_limits<decltype( D3D11_BUFFER_DESC::ByteWidth )>::max() )
+	{
+		EAE6320_ASSERTF( false, "The instance buffer is too big" );
+		Logging::OutputError( "An instance buffer of %u instances is too big for a D3D11_BUFFER_DESC", m_capacity );
+		return Results::Failure;
+	}
+
+	const auto bufferDescription = [bufferSize]
+	{
+		D3D11_BUFFER_DESC bufferDescription{};
+
+		bufferDescription.ByteWidth = static_cast<unsigned int>( bufferSize );
+		bufferDescription.Usage = D3D11_USAGE_DYNAMIC;	// The CPU rewrites the buffer every frame
+		bufferDescription.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+		bufferDescription.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;	// The CPU must write, but doesn't read
+		bufferDescription.MiscFlags = 0;
+		bufferDescription.StructureByteStride = 0;	// Not used
+
+		return bufferDescription;
+	}();
+
+	const auto d3dResult = direct3dDevice->CreateBuffer( &bufferDescription, nullptr, &m_buffer );
+	if ( SUCCEEDED( d3dResult ) )
+	{
+		return Results::Success;
+	}
+	else
+	{
+		EAE6320_ASSERTF( false, "Instance buffer creation failed (HRESULT %#010x)", d3dResult );
+		Logging::OutputError( "Direct3D failed to create an instance buffer with HRESULT %#010x", d3dResult );
+		return Results::Failure;
+	}
+}
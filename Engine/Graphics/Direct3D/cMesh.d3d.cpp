@@ -2,10 +2,12 @@
 //=========
 
 #include "../cMesh.h"
+#include "../cInstanceBuffer.h"
 #include "../cMaterial.h"
 
 #include "Includes.h"
 #include "../sContext.h"
+#include "../sStateCache.h"
 #include "../cVertexFormat.h"
 #include "../VertexFormats.h"
 
@@ -157,68 +159,73 @@ eae6320::cResult eae6320::Graphics::cMesh::CleanUp()
 		delete[] m_materials;
 	}
 
+	delete[] m_submeshes;
+	m_submeshes = nullptr;
+	delete[] m_submeshBounds;
+	m_submeshBounds = nullptr;
+	delete[] m_occluder.positions;
+	delete[] m_occluder.indices;
+	m_occluder = sOccluder();
+	delete[] m_meshlets;
+	m_meshlets = nullptr;
+	delete[] m_submeshMeshletRanges;
+	m_submeshMeshletRanges = nullptr;
+	m_meshletCount = 0;
+
 	return result;
 }
 
-void eae6320::Graphics::cMesh::Draw()
+// Render
+//-------
+
+eae6320::cResult eae6320::Graphics::cMesh::BindGeometry( const cInstanceBuffer& i_instanceBuffer )
 {
 	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
 	EAE6320_ASSERT(direct3dImmediateContext);
 
-	// Draw the geometry
+	// Bind the vertex buffer (slot 0) and the instance buffer (slot 1) to the device as data sources
+	{
+		EAE6320_ASSERT( m_vertexBuffer != nullptr );
+		EAE6320_ASSERT( i_instanceBuffer.GetBuffer() != nullptr );
+		// The "stride" defines how large a single vertex (or instance) is in the stream of data
+		// (the first instance is chosen by the draw call rather than by an offset)
+		sStateCache::g_stateCache.BindVertexBuffer( 0, m_vertexBuffer, sizeof( VertexFormats::sVertex_mesh ) );
+		sStateCache::g_stateCache.BindVertexBuffer( 1, i_instanceBuffer.GetBuffer(), sizeof( VertexFormats::sInstance_mesh ) );
+	}
+	// Specify what kind of data the vertex buffer holds
 	{
-		// Bind a specific vertex buffer to the device as a data source
+		// Bind the vertex format (which defines how to interpret a single vertex)
 		{
-			EAE6320_ASSERT( m_vertexBuffer != nullptr );
-			constexpr unsigned int startingSlot = 0;
-			constexpr unsigned int vertexBufferCount = 1;
-			// The "stride" defines how large a single vertex is in the stream of data
-			constexpr unsigned int bufferStride = sizeof( VertexFormats::sVertex_mesh );
-			// It's possible to start streaming data in the middle of a vertex buffer
-			constexpr unsigned int bufferOffset = 0;
-			direct3dImmediateContext->IASetVertexBuffers( startingSlot, vertexBufferCount, &m_vertexBuffer, &bufferStride, &bufferOffset );
+			EAE6320_ASSERT( m_vertexFormat != nullptr );
+			m_vertexFormat->Bind();
 		}
-		// Specify what kind of data the vertex buffer holds
-		{
-			// Bind the vertex format (which defines how to interpret a single vertex)
-			{
-				EAE6320_ASSERT( m_vertexFormat != nullptr );
-				m_vertexFormat->Bind();
-			}
-			// Set the topology (which defines how to interpret multiple vertices as a single "primitive";
-			// the vertex buffer was defined as a triangle list
-			// (meaning that every primitive is a triangle and will be defined by three vertices)
-			direct3dImmediateContext->IASetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
-		}
-
-		constexpr unsigned int vertexCountPerTriangle = 3;
-		unsigned int indexCountToRender = m_triangleCount * vertexCountPerTriangle;
-		bool is32 = indexCountToRender > std::numeric_limits<uint16_t>::max() ? true : false;
+		// Set the topology (which defines how to interpret multiple vertices as a single "primitive";
+		// the vertex buffer was defined as a triangle list
+		// (meaning that every primitive is a triangle and will be defined by three vertices)
+		direct3dImmediateContext->IASetPrimitiveTopology( D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST );
+	}
 
-		// Bind the index buffer
-		{
-			EAE6320_ASSERT( m_indexBuffer );
-			constexpr unsigned int offset = 0;
-			direct3dImmediateContext->IASetIndexBuffer( m_indexBuffer, is32 ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT, offset );
-		}
-		// Render triangles from the currently-bound index buffer
-		{
-			// It's possible to start streaming data in the middle of a vertex buffer
-			constexpr unsigned int indexOfFirstIndexToUse = 0;
-			constexpr unsigned int offsetToAddToEachIndex = 0;
+	// The index size depends on every level of detail's indices
+	constexpr unsigned int vertexCountPerTriangle = 3;
+	unsigned int indexCount_total = m_triangleCount * vertexCountPerTriangle;
+	bool is32 = indexCount_total > std::numeric_limits<uint16_t>::max() ? true : false;
 
-			if ( m_materialsCount > 0 )
-			{
-				for ( auto i = 0; i < m_materialsCount; ++i )
-				{
-					m_materials[i]->Bind();
-					direct3dImmediateContext->DrawIndexed( m_materials[i]->m_indexRange.last - m_materials[i]->m_indexRange.first + 1, m_materials[i]->m_indexRange.first, offsetToAddToEachIndex );
-				}
-			}
-			else
-			{
-				direct3dImmediateContext->DrawIndexed( indexCountToRender, indexOfFirstIndexToUse, offsetToAddToEachIndex );
-			}
-		}
+	// Bind the index buffer
+	{
+		EAE6320_ASSERT( m_indexBuffer );
+		sStateCache::g_stateCache.BindIndexBuffer( m_indexBuffer, is32 );
 	}
+
+	return Results::Success;
+}
+
+void eae6320::Graphics::cMesh::DrawIndices( const uint32_t i_firstIndex, const uint32_t i_indexCount, const uint32_t i_firstInstance, const uint32_t i_instanceCount )
+{
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+	EAE6320_ASSERT( direct3dImmediateContext );
+
+	// Render triangles from the currently-bound index buffer
+	// (it's possible to start streaming data in the middle of a vertex buffer)
+	constexpr unsigned int offsetToAddToEachIndex = 0;
+	direct3dImmediateContext->DrawIndexedInstanced( i_indexCount, i_instanceCount, i_firstIndex, offsetToAddToEachIndex, i_firstInstance );
 }
\ No newline at end of file
@@ -0,0 +1,283 @@
+// Includes
+//=========
+
+#include "../cTexture.h"
+#include "../sContext.h"
+#include "../sStateCache.h"
+
+#include "Includes.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// Creates the shader resource view and the sampler state that every texture is bound with
+	eae6320::cResult CreateViews( ID3D11Texture2D* const i_texture, const std::string& i_path, const DXGI_FORMAT i_format, const unsigned int i_mipCount,
+		ID3D11ShaderResourceView*& o_shaderResourceView, ID3D11SamplerState*& o_samplerState );
+}
+
+// Interface
+//==========
+
+// Render
+//-------
+
+void eae6320::Graphics::cTexture::Bind( const unsigned int i_unit ) const
+{
+	EAE6320_ASSERT( m_shaderResourceView && m_samplerState );
+	sStateCache::g_stateCache.BindShaderResource( i_unit, m_shaderResourceView );
+	sStateCache::g_stateCache.BindSampler( i_unit, m_samplerState );
+}
+
+// Implementation
+//===============
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Graphics::cTexture::Initialize( const std::string& i_path, const uint8_t* const i_data,
+	const unsigned int i_width, const unsigned int i_height, const unsigned int i_componentCount )
+{
+	auto result = Results::Success;
+
+	auto* const direct3dDevice = sContext::g_context.direct3dDevice;
+	EAE6320_ASSERT( direct3dDevice );
+
+	// The image is always decoded as RGBA
+	EAE6320_ASSERT( i_componentCount == 4 );
+
+	const auto textureDescription = [i_width, i_height]
+	{
+		D3D11_TEXTURE2D_DESC textureDescription{};
+
+		textureDescription.Width = i_width;
+		textureDescription.Height = i_height;
+		textureDescription.MipLevels = 1;
+		textureDescription.ArraySize = 1;
+		textureDescription.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+		textureDescription.SampleDesc.Count = 1;
+		textureDescription.SampleDesc.Quality = 0;
+		textureDescription.Usage = D3D11_USAGE_IMMUTABLE;
+		textureDescription.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+		textureDescription.CPUAccessFlags = 0;
+		textureDescription.MiscFlags = 0;
+
+		return textureDescription;
+	}();
+
+	const auto textureInitialData = [i_width, i_height, i_data]
+	{
+		D3D11_SUBRESOURCE_DATA textureInitialData{};
+
+		textureInitialData.pSysMem = i_data;
+		textureInitialData.SysMemPitch = i_width * sizeof( uint32_t );
+		textureInitialData.SysMemSlicePitch = i_width * i_height * sizeof( uint32_t );
+
+		return textureInitialData;
+	}();
+
+	{
+		const auto result_create = direct3dDevice->CreateTexture2D( &textureDescription, &textureInitialData, &m_texture );
+		if ( FAILED( result_create ) )
+		{
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, "Texture2D object creation failed (HRESULT %#010x)", result_create );
+			Logging::OutputError( "Direct3D failed to create a Texture2D object for %s (HRESULT %#010x)", i_path.c_str(), result_create );
+			return result;
+		}
+	}
+
+	if ( !( result = CreateViews( m_texture, i_path, DXGI_FORMAT_R8G8B8A8_UNORM, 1, m_shaderResourceView, m_samplerState ) ) )
+	{
+		return result;
+	}
+
+	// The texture doesn't have any mips
+	m_memorySize = static_cast<uint64_t>( i_width ) * i_height * sizeof( uint32_t );
+
+	return result;
+}
+
+eae6320::cResult eae6320::Graphics::cTexture::Initialize( const std::string& i_path, const TextureFormats::sHeader& i_header, const uint8_t* const i_mipData )
+{
+	auto result = Results::Success;
+
+	auto* const direct3dDevice = sContext::g_context.direct3dDevice;
+	EAE6320_ASSERT( direct3dDevice );
+
+	// The color textures are sampled as they were before they were compressed
+	// (i.e. without converting sRGB to linear)
+	DXGI_FORMAT format = DXGI_FORMAT_BC7_UNORM;
+	switch ( i_header.format )
+	{
+	case TextureFormats::eFormat::BC1: format = DXGI_FORMAT_BC1_UNORM; break;
+	case TextureFormats::eFormat::BC3: format = DXGI_FORMAT_BC3_UNORM; break;
+	case TextureFormats::eFormat::BC5: format = DXGI_FORMAT_BC5_UNORM; break;
+	case TextureFormats::eFormat::BC7: format = DXGI_FORMAT_BC7_UNORM; break;
+	default:
+		// Uploading the blocks as a different format would give the driver data of the wrong size
+		result = Results::Failure;
+		EAE6320_ASSERTF( false, "Unknown texture format %u", static_cast<unsigned int>( i_header.format ) );
+		Logging::OutputError( "The texture %s has an unknown format (%u)", i_path.c_str(), static_cast<unsigned int>( i_header.format ) );
+		return result;
+	}
+
+	const auto textureDescription = [&i_header, format]
+	{
+		D3D11_TEXTURE2D_DESC textureDescription{};
+
+		textureDescription.Width = i_header.width;
+		textureDescription.Height = i_header.height;
+		textureDescription.MipLevels = i_header.mipCount;
+		textureDescription.ArraySize = 1;
+		textureDescription.Format = format;
+		textureDescription.SampleDesc.Count = 1;
+		textureDescription.SampleDesc.Quality = 0;
+		textureDescription.Usage = D3D11_USAGE_IMMUTABLE;
+		textureDescription.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+		textureDescription.CPUAccessFlags = 0;
+		textureDescription.MiscFlags = 0;
+
+		return textureDescription;
+	}();
+
+	// Every mip was built offline
+	EAE6320_ASSERT( i_header.mipCount <= D3D11_REQ_MIP_LEVELS );
+	D3D11_SUBRESOURCE_DATA textureInitialData[D3D11_REQ_MIP_LEVELS]{};
+	uint64_t memorySize = 0;
+	{
+		auto* mipData = i_mipData;
+		for ( uint8_t i = 0; i < i_header.mipCount; ++i )
+		{
+			const auto width = TextureFormats::GetMipDimension( i_header.width, i );
+			const auto height = TextureFormats::GetMipDimension( i_header.height, i );
+			const auto mipSize = TextureFormats::GetMipSize( i_header.format, width, height );
+
+			textureInitialData[i].pSysMem = mipData;
+			// The pitch of a block-compressed texture is the size of a row of blocks
+			textureInitialData[i].SysMemPitch = TextureFormats::GetBlockCount( width ) * TextureFormats::GetBytesPerBlock( i_header.format );
+			textureInitialData[i].SysMemSlicePitch = mipSize;
+
+			mipData += mipSize;
+			memorySize += mipSize;
+		}
+	}
+
+	{
+		const auto result_create = direct3dDevice->CreateTexture2D( &textureDescription, textureInitialData, &m_texture );
+		if ( FAILED( result_create ) )
+		{
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, "Texture2D object creation failed (HRESULT %#010x)", result_create );
+			Logging::OutputError( "Direct3D failed to create a Texture2D object for %s (HRESULT %#010x)", i_path.c_str(), result_create );
+			return result;
+		}
+	}
+
+	if ( !( result = CreateViews( m_texture, i_path, format, i_header.mipCount, m_shaderResourceView, m_samplerState ) ) )
+	{
+		return result;
+	}
+
+	m_memorySize = memorySize;
+
+	return result;
+}
+
+eae6320::cResult eae6320::Graphics::cTexture::CleanUp()
+{
+	if ( m_samplerState )
+	{
+		m_samplerState->Release();
+		m_samplerState = nullptr;
+	}
+	if ( m_shaderResourceView )
+	{
+		m_shaderResourceView->Release();
+		m_shaderResourceView = nullptr;
+	}
+	if ( m_texture )
+	{
+		m_texture->Release();
+		m_texture = nullptr;
+	}
+
+	return Results::Success;
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	eae6320::cResult CreateViews( ID3D11Texture2D* const i_texture, const std::string& i_path, const DXGI_FORMAT i_format, const unsigned int i_mipCount,
+		ID3D11ShaderResourceView*& o_shaderResourceView, ID3D11SamplerState*& o_samplerState )
+	{
+		auto result = eae6320::Results::Success;
+
+		auto* const direct3dDevice = eae6320::Graphics::sContext::g_context.direct3dDevice;
+		EAE6320_ASSERT( direct3dDevice );
+		EAE6320_ASSERT( i_texture );
+
+		const auto shaderResourceViewDescription = [i_format, i_mipCount]
+		{
+			D3D11_SHADER_RESOURCE_VIEW_DESC shaderResourceViewDescription;
+
+			shaderResourceViewDescription.Format = i_format;
+			shaderResourceViewDescription.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+			shaderResourceViewDescription.Texture2D.MipLevels = i_mipCount;
+			shaderResourceViewDescription.Texture2D.MostDetailedMip = 0;
+
+			return shaderResourceViewDescription;
+		}();
+
+		{
+			const auto result_create = direct3dDevice->CreateShaderResourceView( i_texture, &shaderResourceViewDescription, &o_shaderResourceView );
+			if ( FAILED( result_create ) )
+			{
+				result = eae6320::Results::Failure;
+				EAE6320_ASSERTF( false, "Shader Resource View object creation failed (HRESULT %#010x)", result_create );
+				eae6320::Logging::OutputError( "Direct3D failed to create a Shader Resource View object for %s (HRESULT %#010x)", i_path.c_str(), result_create );
+				return result;
+			}
+		}
+
+		const auto samplerStateDescription = []
+		{
+			D3D11_SAMPLER_DESC samplerStateDescription{};
+
+			samplerStateDescription.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+			samplerStateDescription.AddressU = D3D11_TEXTURE_ADDRESS_WRAP;
+			samplerStateDescription.AddressV = D3D11_TEXTURE_ADDRESS_WRAP;
+			samplerStateDescription.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
+			samplerStateDescription.MipLODBias = 0.0f;
+			samplerStateDescription.MaxAnisotropy = 1;
+			samplerStateDescription.ComparisonFunc = D3D11_COMPARISON_NEVER;
+			samplerStateDescription.BorderColor[0] = 0;
+			samplerStateDescription.BorderColor[1] = 0;
+			samplerStateDescription.BorderColor[2] = 0;
+			samplerStateDescription.BorderColor[3] = 0;
+			samplerStateDescription.MinLOD = 0;
+			samplerStateDescription.MaxLOD = D3D11_FLOAT32_MAX;
+
+			return samplerStateDescription;
+		}();
+
+		{
+			const auto result_create = direct3dDevice->CreateSamplerState( &samplerStateDescription, &o_samplerState );
+			if ( FAILED( result_create ) )
+			{
+				result = eae6320::Results::Failure;
+				EAE6320_ASSERTF( false, "Sampler State creation failed (HRESULT %#010x)", result_create );
+				eae6320::Logging::OutputError( "Direct3D failed to create a Sampler State for %s (HRESULT %#010x)", i_path.c_str(), result_create );
+				return result;
+			}
+		}
+
+		return result;
+	}
+}
@@ -5,6 +5,7 @@
 
 #include "Includes.h"
 #include "../sContext.h"
+#include "../sStateCache.h"
 #include "../VertexFormats.h"
 
 #include <Engine/Asserts/Asserts.h>
@@ -19,12 +20,9 @@
 
 void eae6320::Graphics::cVertexFormat::Bind()
 {
-	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
-	EAE6320_ASSERT( direct3dImmediateContext );
-
 	// Set the layout (which defines how to interpret a single vertex)
 	EAE6320_ASSERT( m_vertexInputLayout );
-	direct3dImmediateContext->IASetInputLayout( m_vertexInputLayout );
+	sStateCache::g_stateCache.BindInputLayout( m_vertexInputLayout );
 }
 
 // Implementation
@@ -51,59 +49,49 @@ eae6320::cResult eae6320::Graphics::cVertexFormat::Initialize( const eVertexType
 		{
 		case eVertexType::Mesh:
 			{
-				constexpr unsigned int vertexElementCount = 5;
+				constexpr unsigned int vertexElementCount = 8;
 				D3D11_INPUT_ELEMENT_DESC layoutDescription[vertexElementCount] = {};
 				{
 					// Slot 0
 
 					// POSITION
-					// 3 floats == 12 bytes
+					// 4 uint16_ts == 8 bytes
+					// (the fourth is padding)
 					// Offset = 0
 					{
 						auto& positionElement = layoutDescription[0];
 
 						positionElement.SemanticName = "POSITION";
 						positionElement.SemanticIndex = 0;	// (Semantics without modifying indices at the end can always use zero)
-						positionElement.Format = DXGI_FORMAT_R32G32B32_FLOAT;
+						positionElement.Format = DXGI_FORMAT_R16G16B16A16_UNORM;
 						positionElement.InputSlot = 0;
 						positionElement.AlignedByteOffset = offsetof( VertexFormats::sVertex_mesh, x );
 						positionElement.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
 						positionElement.InstanceDataStepRate = 0;	// (Must be zero for per-vertex data)
 					}
 
-					// NORMAL
+					// TANGENT_FRAME
+					// 4 int16_ts == 8 bytes
 					{
-						auto& normalElement = layoutDescription[1];
-
-						normalElement.SemanticName = "NORMAL";
-						normalElement.SemanticIndex = 0;	// (Semantics without modifying indices at the end can always use zero)
-						normalElement.Format = DXGI_FORMAT_R32G32B32_FLOAT;
-						normalElement.InputSlot = 0;
-						normalElement.AlignedByteOffset = offsetof( VertexFormats::sVertex_mesh, nx );
-						normalElement.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-						normalElement.InstanceDataStepRate = 0;	// (Must be zero for per-vertex data)
+						auto& tangentFrameElement = layoutDescription[1];
+
+						tangentFrameElement.SemanticName = "TANGENT_FRAME";
+						tangentFrameElement.SemanticIndex = 0;	// (Semantics without modifying indices at the end can always use zero)
+						tangentFrameElement.Format = DXGI_FORMAT_R16G16B16A16_SNORM;
+						tangentFrameElement.InputSlot = 0;
+						tangentFrameElement.AlignedByteOffset = offsetof( VertexFormats::sVertex_mesh, qx );
+						tangentFrameElement.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+						tangentFrameElement.InstanceDataStepRate = 0;	// (Must be zero for per-vertex data)
 					}
 
-					// TANGENT
+					// TEXCOORD
+					// 2 halfs == 4 bytes
 					{
-						auto& tangertElement = layoutDescription[2];
-
-						tangertElement.SemanticName = "TANGENT";
-						tangertElement.SemanticIndex = 0;	// (Semantics without modifying indices at the end can always use zero)
-						tangertElement.Format = DXGI_FORMAT_R32G32B32_FLOAT;
-						tangertElement.InputSlot = 0;
-						tangertElement.AlignedByteOffset = offsetof( VertexFormats::sVertex_mesh, tx );
-						tangertElement.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-						tangertElement.InstanceDataStepRate = 0;	// (Must be zero for per-vertex data)
-					}
-
-					// TANGENT
-					{
-						auto& texcoordElement = layoutDescription[3];
+						auto& texcoordElement = layoutDescription[2];
 
 						texcoordElement.SemanticName = "TEXCOORD";
 						texcoordElement.SemanticIndex = 0;	// (Semantics without modifying indices at the end can always use zero)
-						texcoordElement.Format = DXGI_FORMAT_R32G32_FLOAT;
+						texcoordElement.Format = DXGI_FORMAT_R16G16_FLOAT;
 						texcoordElement.InputSlot = 0;
 						texcoordElement.AlignedByteOffset = offsetof( VertexFormats::sVertex_mesh, u );
 						texcoordElement.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
@@ -111,8 +99,9 @@ eae6320::cResult eae6320::Graphics::cVertexFormat::Initialize( const eVertexType
 					}
 
 					// COLOR
+					// 4 uint8_ts == 4 bytes
 					{
-						auto& colorElement = layoutDescription[4];
+						auto& colorElement = layoutDescription[3];
 
 						colorElement.SemanticName = "COLOR";
 						colorElement.SemanticIndex = 0;	// (Semantics without modifying indices at the end can always use zero)
@@ -122,7 +111,25 @@ eae6320::cResult eae6320::Graphics::cVertexFormat::Initialize( const eVertexType
 						colorElement.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
 						colorElement.InstanceDataStepRate = 0;	// (Must be zero for per-vertex data)
 					}
-					
+				}
+				{
+					// Slot 1
+
+					// INSTANCE_TRANSFORM
+					// 4 columns of 4 floats == 64 bytes
+					// Offset = 0
+					for ( unsigned int i = 0; i < 4; ++i )
+					{
+						auto& transformElement = layoutDescription[4 + i];
+
+						transformElement.SemanticName = "INSTANCE_TRANSFORM";
+						transformElement.SemanticIndex = i;	// (Each column is a separate element)
+						transformElement.Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+						transformElement.InputSlot = 1;
+						transformElement.AlignedByteOffset = offsetof( VertexFormats::sInstance_mesh, transform_localToWorld ) + ( i * 4 * sizeof( float ) );
+						transformElement.InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
+						transformElement.InstanceDataStepRate = 1;	// Advance once per instance
+					}
 				}
 
 				const auto d3dResult = direct3dDevice->CreateInputLayout( layoutDescription, vertexElementCount,
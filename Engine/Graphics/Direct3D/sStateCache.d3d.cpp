@@ -0,0 +1,246 @@
+// Includes
+//=========
+
+#include "../sStateCache.h"
+
+#include "Includes.h"
+#include "../cShader.h"
+#include "../sContext.h"
+
+#include <d3d11_1.h>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+
+// Interface
+//==========
+
+// Render
+//-------
+
+void eae6320::Graphics::sStateCache::BindVertexShader( ID3D11VertexShader* const i_vertexShader )
+{
+	if ( !CountBind( i_vertexShader == m_vertexShader ) )
+	{
+		auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+		EAE6320_ASSERT( direct3dImmediateContext );
+
+		constexpr ID3D11ClassInstance* const* noInterfaces = nullptr;
+		constexpr unsigned int interfaceCount = 0;
+		direct3dImmediateContext->VSSetShader( i_vertexShader, noInterfaces, interfaceCount );
+		m_vertexShader = i_vertexShader;
+	}
+}
+
+void eae6320::Graphics::sStateCache::BindFragmentShader( ID3D11PixelShader* const i_fragmentShader )
+{
+	if ( !CountBind( i_fragmentShader == m_fragmentShader ) )
+	{
+		auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+		EAE6320_ASSERT( direct3dImmediateContext );
+
+		constexpr ID3D11ClassInstance* const* noInterfaces = nullptr;
+		constexpr unsigned int interfaceCount = 0;
+		direct3dImmediateContext->PSSetShader( i_fragmentShader, noInterfaces, interfaceCount );
+		m_fragmentShader = i_fragmentShader;
+	}
+}
+
+void eae6320::Graphics::sStateCache::BindInputLayout( ID3D11InputLayout* const i_inputLayout )
+{
+	if ( !CountBind( i_inputLayout == m_inputLayout ) )
+	{
+		auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+		EAE6320_ASSERT( direct3dImmediateContext );
+
+		direct3dImmediateContext->IASetInputLayout( i_inputLayout );
+		m_inputLayout = i_inputLayout;
+	}
+}
+
+void eae6320::Graphics::sStateCache::BindVertexBuffer( const unsigned int i_slot, ID3D11Buffer* const i_buffer, const unsigned int i_stride )
+{
+	EAE6320_ASSERT( i_slot < ( sizeof( m_vertexBuffers ) / sizeof( m_vertexBuffers[0] ) ) );
+	if ( !CountBind( ( i_buffer == m_vertexBuffers[i_slot] ) && ( i_stride == m_vertexBufferStrides[i_slot] ) ) )
+	{
+		auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+		EAE6320_ASSERT( direct3dImmediateContext );
+
+		constexpr unsigned int bufferCount = 1;
+		// It's possible to start streaming data in the middle of a vertex buffer
+		// (but the cache always binds from the start)
+		constexpr unsigned int bufferOffset = 0;
+		direct3dImmediateContext->IASetVertexBuffers( i_slot, bufferCount, &i_buffer, &i_stride, &bufferOffset );
+		m_vertexBuffers[i_slot] = i_buffer;
+		m_vertexBufferStrides[i_slot] = i_stride;
+	}
+}
+
+void eae6320::Graphics::sStateCache::BindIndexBuffer( ID3D11Buffer* const i_buffer, const bool i_are32BitIndices )
+{
+	if ( !CountBind( ( i_buffer == m_indexBuffer ) && ( i_are32BitIndices == m_are32BitIndices ) ) )
+	{
+		auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+		EAE6320_ASSERT( direct3dImmediateContext );
+
+		constexpr unsigned int offset = 0;
+		direct3dImmediateContext->IASetIndexBuffer( i_buffer, i_are32BitIndices ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT, offset );
+		m_indexBuffer = i_buffer;
+		m_are32BitIndices = i_are32BitIndices;
+	}
+}
+
+void eae6320::Graphics::sStateCache::BindShaderResource( const unsigned int i_unit, ID3D11ShaderResourceView* const i_shaderResourceView )
+{
+	EAE6320_ASSERT( i_unit < s_textureUnitCount );
+	if ( !CountBind( i_shaderResourceView == m_shaderResourceViews[i_unit] ) )
+	{
+		auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+		EAE6320_ASSERT( direct3dImmediateContext );
+
+		constexpr unsigned int viewCount = 1;
+		direct3dImmediateContext->PSSetShaderResources( i_unit, viewCount, &i_shaderResourceView );
+		m_shaderResourceViews[i_unit] = i_shaderResourceView;
+	}
+}
+
+void eae6320::Graphics::sStateCache::BindSampler( const unsigned int i_unit, ID3D11SamplerState* const i_samplerState )
+{
+	EAE6320_ASSERT( i_unit < s_textureUnitCount );
+	if ( !CountBind( i_samplerState == m_samplerStates[i_unit] ) )
+	{
+		auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+		EAE6320_ASSERT( direct3dImmediateContext );
+
+		constexpr unsigned int samplerCount = 1;
+		direct3dImmediateContext->PSSetSamplers( i_unit, samplerCount, &i_samplerState );
+		m_samplerStates[i_unit] = i_samplerState;
+	}
+}
+
+void eae6320::Graphics::sStateCache::BindConstantBuffer( const uint_fast8_t i_shaderTypesToBindTo, const unsigned int i_slot, ID3D11Buffer* const i_buffer,
+	const unsigned int i_firstConstant, const unsigned int i_constantCount )
+{
+	EAE6320_ASSERT( i_slot < s_constantBufferSlotCount );
+	EAE6320_ASSERT( i_buffer );
+
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+	EAE6320_ASSERT( direct3dImmediateContext );
+
+	constexpr unsigned int bufferCount = 1;
+	const auto isRange = i_constantCount > 0;
+	EAE6320_ASSERTF( !isRange || m_direct3dImmediateContext1, "Binding a range of a constant buffer requires Direct3D 11.1" );
+	const sConstantBufferRange range{ i_buffer, i_firstConstant, i_constantCount };
+	const auto isBound = [&range]( const sConstantBufferRange& i_bound )
+	{
+		return ( i_bound.buffer == range.buffer ) && ( i_bound.firstConstant == range.firstConstant ) && ( i_bound.constantCount == range.constantCount );
+	};
+	if ( i_shaderTypesToBindTo & static_cast<decltype( i_shaderTypesToBindTo )>( eShaderType::Vertex ) )
+	{
+		auto& constantBuffer = m_constantBuffers_vertex[i_slot];
+		if ( !CountBind( isBound( constantBuffer ) ) )
+		{
+			if ( isRange )
+			{
+				m_direct3dImmediateContext1->VSSetConstantBuffers1( i_slot, bufferCount, &i_buffer, &i_firstConstant, &i_constantCount );
+			}
+			else
+			{
+				direct3dImmediateContext->VSSetConstantBuffers( i_slot, bufferCount, &i_buffer );
+			}
+			constantBuffer = range;
+		}
+	}
+	if ( i_shaderTypesToBindTo & static_cast<decltype( i_shaderTypesToBindTo )>( eShaderType::Fragment ) )
+	{
+		auto& constantBuffer = m_constantBuffers_fragment[i_slot];
+		if ( !CountBind( isBound( constantBuffer ) ) )
+		{
+			if ( isRange )
+			{
+				m_direct3dImmediateContext1->PSSetConstantBuffers1( i_slot, bufferCount, &i_buffer, &i_firstConstant, &i_constantCount );
+			}
+			else
+			{
+				direct3dImmediateContext->PSSetConstantBuffers( i_slot, bufferCount, &i_buffer );
+			}
+			constantBuffer = range;
+		}
+	}
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::sStateCache::Initialize()
+{
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+	EAE6320_ASSERT( direct3dImmediateContext );
+
+	Invalidate();
+
+	// The Direct3D 11.1 interface is only needed to bind ranges of constant buffers,
+	// and so it's not an error if it isn't available (but ranges can't be bound)
+	const auto d3dResult = direct3dImmediateContext->QueryInterface( __uuidof( ID3D11DeviceContext1 ),
+		reinterpret_cast<void**>( &m_direct3dImmediateContext1 ) );
+	if ( FAILED( d3dResult ) )
+	{
+		m_direct3dImmediateContext1 = nullptr;
+		Logging::OutputMessage( "The Direct3D 11.1 device context isn't available (QueryInterface() failed with HRESULT %#010x)", d3dResult );
+	}
+
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Graphics::sStateCache::CleanUp()
+{
+	if ( m_direct3dImmediateContext1 )
+	{
+		m_direct3dImmediateContext1->Release();
+		m_direct3dImmediateContext1 = nullptr;
+	}
+	Invalidate();
+
+	return Results::Success;
+}
+
+// Access
+//-------
+
+bool eae6320::Graphics::sStateCache::CanBindConstantBufferRanges() const
+{
+	return m_direct3dImmediateContext1 != nullptr;
+}
+
+// Implementation
+//===============
+
+void eae6320::Graphics::sStateCache::Invalidate_platformSpecific()
+{
+	// Binding null is valid,
+	// and so a pointer that won't ever be returned by Direct3D is used to mean "unknown"
+	const auto unknown = reinterpret_cast<void*>( ~uintptr_t( 0 ) );
+	m_vertexShader = static_cast<ID3D11VertexShader*>( unknown );
+	m_fragmentShader = static_cast<ID3D11PixelShader*>( unknown );
+	m_inputLayout = static_cast<ID3D11InputLayout*>( unknown );
+	for ( auto& vertexBuffer : m_vertexBuffers )
+	{
+		vertexBuffer = static_cast<ID3D11Buffer*>( unknown );
+	}
+	m_indexBuffer = static_cast<ID3D11Buffer*>( unknown );
+	for ( auto& shaderResourceView : m_shaderResourceViews )
+	{
+		shaderResourceView = static_cast<ID3D11ShaderResourceView*>( unknown );
+	}
+	for ( auto& samplerState : m_samplerStates )
+	{
+		samplerState = static_cast<ID3D11SamplerState*>( unknown );
+	}
+	for ( auto& constantBuffer : m_constantBuffers_vertex )
+	{
+		constantBuffer = { static_cast<ID3D11Buffer*>( unknown ), 0, 0 };
+	}
+	for ( auto& constantBuffer : m_constantBuffers_fragment )
+	{
+		constantBuffer = { static_cast<ID3D11Buffer*>( unknown ), 0, 0 };
+	}
+}
@@ -8,19 +8,38 @@
 #include "cRenderTarget.h"
 #include "cShader.h"
 #include "cEffect.h"
+#include "cFrameAllocator.h"
+#include "cInstanceBuffer.h"
 #include "cMesh.h"
+#include "cMeshletCuller.h"
+#include "cOcclusionCuller.h"
+#include "cRenderQueue.h"
+#include "cTexture.h"
 #include "cVertexFormat.h"
 #include "sContext.h"
 #include "sRenderCommand.h"
+#include "sStateCache.h"
 #include "VertexFormats.h"
 
 #include <Engine/Asserts/Asserts.h>
-#include <Engine/Concurrency/cEvent.h>
+#include <Engine/Concurrency/Constants.h>
+#include <Engine/Concurrency/Futex.h>
 #include <Engine/Logging/Logging.h>
 #include <Engine/Time/Time.h>
-#include <Engine/UserOutput/UserOutput.h>
+#include <algorithm>
+#include <atomic>
 #include <utility>
 #include <cmath>
+#include <cstring>
+
+#ifdef EAE6320_ASSERTS_AREENABLED
+	#include <Engine/ScopeGuard/cScopeGuard.h>
+#endif
+#ifdef EAE6320_GRAPHICS_ISSUBMISSIONTESTENABLED
+	#include <Engine/Concurrency/cJobSystem.h>
+	#include <Engine/Math/cQuaternion.h>
+	#include <vector>
+#endif
 
 // Static Data
 //============
@@ -31,12 +50,71 @@ namespace
 
 	// Constant buffer object
 	eae6320::Graphics::cConstantBuffer s_constantBuffer_frame( eae6320::Graphics::ConstantBufferTypes::Frame );
-	eae6320::Graphics::cConstantBuffer s_constantBuffer_material( eae6320::Graphics::ConstantBufferTypes::Material );
 	eae6320::Graphics::cConstantBuffer s_constantBuffer_drawCall( eae6320::Graphics::ConstantBufferTypes::DrawCall );
 
+	// The render commands are drawn in the order of their sort keys rather than the order they were submitted in
+	eae6320::Graphics::cRenderQueue s_renderQueue;
+	// The per-instance data for every render command in a frame
+	eae6320::Graphics::cInstanceBuffer s_instanceBuffer;
+	// Meshes that were built with meshlets only draw the parts that the camera might see
+	// (this is only used by the render thread)
+	eae6320::Graphics::cMeshletCuller s_meshletCuller;
+
+	// Level of Detail
+	//----------------
+
+	// The height of a pixel in projected space
+	// (a mesh's level of detail is lowered as long as the difference would be smaller than this;
+	// OpenGL doesn't provide the resolution at initialization and so it assumes 1080 rows)
+	float s_maximumLodError_projected = 2.0f / 1080.0f;
+	// This is only used by the application loop thread
+	// (it is copied into the data for every frame that is submitted)
+	float s_lodBias = 1.0f;
+
 	// Submission Data
 	//----------------
 
+	// Consecutive render commands that are drawn together (see RenderFrame())
+	struct sDrawBatch
+	{
+		uint32_t firstInstance;
+		uint32_t instanceCount;
+	};
+
+	// Each call to SubmitRenderCommands() adds a contiguous run of commands
+	struct sRenderCommandRun
+	{
+		eae6320::Graphics::sRenderCommand* renderCommands = nullptr;
+		uint32_t renderCommandCount = 0;
+		sRenderCommandRun* next = nullptr;
+	};
+
+	// Every thread that submits render commands for a frame gets its own bucket to submit them to,
+	// and so jobs on different threads can submit at the same time without any locks.
+	// The buckets are linked into a single list when the application signals that the frame has been submitted
+	struct alignas( eae6320::Concurrency::Constants::CacheLineSize ) sRenderCommandBucket
+	{
+		// A frame allocator can only be used by one thread at a time,
+		// and so every bucket has its own
+		// (it is initialized the first time that a thread claims the bucket)
+		eae6320::Graphics::cFrameAllocator frameAllocator;
+		sRenderCommandRun* renderCommandRun_first = nullptr;
+		sRenderCommandRun* renderCommandRun_last = nullptr;
+		uint32_t renderCommandCount = 0;
+		// The bucket holds a single reference to every mesh that its commands use
+		// rather than one for every command
+		// (a mesh's reference count is only 16 bits and every frame in flight could draw it tens of thousands of times,
+		// and incrementing it for every command would make every submitting thread write to the mesh's cache line).
+		// This is an open-addressing hash set allocated from the bucket's frame allocator
+		eae6320::Graphics::cMesh** referencedMeshes = nullptr;
+		uint32_t referencedMeshCount = 0;
+		uint32_t referencedMeshCapacity = 0;
+		bool isFrameAllocatorInitialized = false;
+	};
+	// This is more than the number of threads that are expected to submit render commands for a single frame
+	constexpr unsigned int s_renderCommandBucketCount_maximum = 64;
+	constexpr size_t s_renderCommandBucketAllocatorInitialSize = 16 * 1024;
+
 	// This struct's data is populated at submission time;
 	// it must cache whatever is necessary in order to render a frame
 	struct sDataRequiredToRenderAFrame
@@ -44,26 +122,98 @@ namespace
 		float clearColor[4];
 		eae6320::Graphics::ConstantBufferFormats::sFrame constantData_frame;
 		eae6320::Graphics::ConstantBufferFormats::sDrawCall constantData_drawCall;
-		eae6320::Graphics::sRenderCommand renderCommands[std::numeric_limits<uint16_t>::max()];
-		uint16_t renderCommandNums;
+		// Converts a distance in world space divided by its distance from the camera into projected space
+		// (i.e. 1 / tan( verticalFieldOfView / 2 ))
+		float lodErrorScale = 1.0f;
+		float lodBias = 1.0f;
+		// The system time when the application read the input that this frame shows
+		uint64_t tickCount_input = 0;
+		// The render thread allocates anything else that only lives for a single frame from here
+		// and resets it after the frame has been shown
+		eae6320::Graphics::cFrameAllocator frameAllocator;
+		// The render commands are allocated from the bucket of whichever thread submitted them,
+		// and all of the buckets' runs are in this list once the frame has been submitted
+		sRenderCommandRun* renderCommandRun_first = nullptr;
+		sRenderCommandRun* renderCommandRun_last = nullptr;
+		uint32_t renderCommandCount = 0;
+		sRenderCommandBucket renderCommandBuckets[s_renderCommandBucketCount_maximum];
+		// The number of buckets that threads have claimed for this frame
+		// (this can be more than the maximum if too many threads have submitted)
+		std::atomic<uint32_t> renderCommandBucketCount = 0;
+		// Says which thread can use this data (see s_framePackets below)
+		std::atomic<uint32_t> fence = 0;
+		// The number of times that this packet's frame allocators had grown when it was last rendered
+		// (the difference is how many times they grew for the latest frame)
+		uint32_t frameAllocatorGrowthCount = 0;
+#ifdef EAE6320_ASSERTS_AREENABLED
+		// These catch render commands that are still being submitted to the packet's buckets
+		// after the application has signaled that the frame has been submitted
+		// (i.e. from a job that the application didn't wait for)
+		std::atomic<uint32_t> renderCommandSubmissionCount_inProgress = 0;
+		std::atomic<bool> hasBeenSubmitted = false;
+#endif
 	};
-	// In our class there will be two copies of the data required to render a frame:
-	//	* One of them will be in the process of being populated by the data currently being submitted by the application loop thread
-	//	* One of them will be fully populated and in the process of being rendered from in the render thread
-	// (In other words, one is being produced while the other is being consumed)
-	sDataRequiredToRenderAFrame s_dataRequiredToRenderAFrame[2];
-	auto* s_dataBeingSubmittedByApplicationThread = &s_dataRequiredToRenderAFrame[0];
-	auto* s_dataBeingRenderedByRenderThread = &s_dataRequiredToRenderAFrame[1];
-	// The following two events work together to make sure that
-	// the main/render thread and the application loop thread can work in parallel but stay in sync:
-	// This event is signaled by the application loop thread when it has finished submitting render data for a frame
-	// (the main/render thread waits for the signal)
-	eae6320::Concurrency::cEvent s_whenAllDataHasBeenSubmittedFromApplicationThread;
-	// This event is signaled by the main/render thread when it has swapped render data pointers.
-	// This means that the renderer is now working with all the submitted data it needs to render the next frame,
-	// and the application loop thread can start submitting data for the following frame
-	// (the application loop thread waits for the signal)
-	eae6320::Concurrency::cEvent s_whenDataForANewFrameCanBeSubmittedFromApplicationThread;
+	// The first chunk is big enough to sort and batch a couple of thousand render commands;
+	// more chunks are added if a frame needs them
+	constexpr size_t s_frameAllocatorInitialSize = 64 * 1024;
+	// The data required to render a frame is kept in a ring of "frame packets":
+	// The application loop thread fills the packets in order
+	// and the main/render thread renders them in the same order,
+	// and so the application can get ahead of the renderer by one frame less than the number of packets
+	// (with two packets one is being populated by the application while the other is being rendered from,
+	// and with more the submitted frames can queue up so that a slow frame on one thread doesn't immediately stall the other).
+	// Every packet has a fence that holds a frame number and says which thread can use it:
+	//	* When the fence is n the application can submit frame n to it
+	//	* When the fence is n + 1 frame n has been submitted and can be rendered
+	//	* When frame n has been rendered the fence becomes n + the packet count (the next frame that will use the packet)
+	// Each thread only waits on the fence of the packet that it needs next,
+	// and so the threads only block when the ring is full (or empty)
+	constexpr unsigned int s_framePacketCount_minimum = 2;
+	constexpr unsigned int s_framePacketCount_maximum = 4;
+	sDataRequiredToRenderAFrame s_framePackets[s_framePacketCount_maximum];
+	unsigned int s_framePacketCount = s_framePacketCount_minimum;
+	// This is only used by the application loop thread
+	// (it is only valid between waiting for a packet and signaling that its data has been submitted)
+	sDataRequiredToRenderAFrame* s_dataBeingSubmittedByApplicationThread = nullptr;
+	unsigned int s_framePacketIndex_submission = 0;
+	// This is only changed by the application loop thread,
+	// but the render thread reads it to know how many frames are waiting
+	std::atomic<uint32_t> s_frameNumber_submission = 0;
+	// These are only used by the render thread
+	unsigned int s_framePacketIndex_render = 0;
+	uint32_t s_frameNumber_render = 0;
+	// Each thread remembers the bucket that it claimed for the frame that it last submitted render commands for
+	struct sClaimedRenderCommandBucket
+	{
+		sRenderCommandBucket* bucket = nullptr;
+		uint32_t frameNumber = 0;
+	};
+	thread_local sClaimedRenderCommandBucket s_claimedRenderCommandBucket;
+
+	// These show how much latency the frame packets are adding
+	// and how often each thread is stalled by the other
+	// (the waiting time of the application is only changed by the application loop thread
+	// and everything else is only changed by the render thread)
+	struct sFramePipelineStatistics
+	{
+		uint64_t frameCount = 0;
+		// The number of submitted frames that hadn't been rendered yet when a frame started rendering (including that frame)
+		uint64_t queueDepth_total = 0;
+		uint32_t queueDepth_maximum = 0;
+		// The time from the application reading the input to the frame being shown
+		uint64_t frameCount_shown = 0;
+		uint64_t tickCount_inputToDisplay_total = 0;
+		uint64_t tickCount_inputToDisplay_maximum = 0;
+		uint64_t tickCount_applicationWaiting = 0;
+		uint64_t tickCount_renderWaiting = 0;
+		// The memory that a frame allocated from its packet's frame allocator and every bucket's
+		uint64_t byteCount_frameAllocators_total = 0;
+		size_t byteCount_frameAllocators_maximum = 0;
+		// The number of times that a frame needed more memory than had been reserved
+		uint32_t frameAllocatorGrowthCount_total = 0;
+		uint32_t frameAllocatorGrowthCount_maximum = 0;
+		uint64_t frameCount_frameAllocatorsGrew = 0;
+	} s_framePipelineStatistics;
 }
 
 // Helper Declarations
@@ -72,6 +222,23 @@ namespace
 namespace
 {
 	eae6320::cResult InitializeRenderTarget( const eae6320::Graphics::sInitializationParameters& i_initializationParameters );
+
+	// Releases the mesh references held by the render command buckets and makes the frame allocators' memory available again
+	void ResetSubmittedData( sDataRequiredToRenderAFrame& io_dataRequiredToRenderAFrame );
+	// Resets the packet that was just rendered and gives it back to the application loop thread
+	void ReleaseFramePacket( sDataRequiredToRenderAFrame& io_framePacket, const bool i_wasShown );
+
+	// Returns null if the bucket can't be claimed
+	sRenderCommandBucket* GetRenderCommandBucketOfCallingThread( sDataRequiredToRenderAFrame& io_framePacket );
+	// Links every bucket's runs into the frame's list
+	void MergeRenderCommandBuckets( sDataRequiredToRenderAFrame& io_framePacket );
+	// Takes a reference to the mesh the first time that the bucket sees it
+	// (it returns failure if there isn't enough memory to remember the mesh)
+	eae6320::cResult ReferenceMesh( sRenderCommandBucket& io_bucket, eae6320::Graphics::cMesh& i_mesh );
+
+	// Chooses the least detailed level of the command's mesh
+	// whose difference from the full detail mesh is smaller than a pixel (scaled by the bias)
+	uint8_t SelectLod( const eae6320::Graphics::sRenderCommand& i_renderCommand, const sDataRequiredToRenderAFrame& i_dataRequiredToRenderAFrame );
 }
 
 // Interface
@@ -88,6 +255,12 @@ void eae6320::Graphics::SubmitElapsedTime( const float i_elapsedSecondCount_syst
 	constantData_frame.g_elapsedSecondCount_simulationTime = i_elapsedSecondCount_simulationTime;
 }
 
+void eae6320::Graphics::SubmitInputTime( const uint64_t i_tickCount_systemTime )
+{
+	EAE6320_ASSERT( s_dataBeingSubmittedByApplicationThread );
+	s_dataBeingSubmittedByApplicationThread->tickCount_input = i_tickCount_systemTime;
+}
+
 void eae6320::Graphics::SubmitClearColor( const float i_clearColor[4] )
 {
 	EAE6320_ASSERT( s_dataBeingSubmittedByApplicationThread );
@@ -97,23 +270,90 @@ void eae6320::Graphics::SubmitClearColor( const float i_clearColor[4] )
 	s_dataBeingSubmittedByApplicationThread->clearColor[3] = i_clearColor[3];
 }
 
-void eae6320::Graphics::SubmitRenderCommands( const sRenderCommand* i_renderCommands, const uint16_t i_commandNums )
+void eae6320::Graphics::SubmitRenderCommands( const sRenderCommand* i_renderCommands, const uint32_t i_commandCount )
 {
 	EAE6320_ASSERT( s_dataBeingSubmittedByApplicationThread );
 
-	uint16_t offset = s_dataBeingSubmittedByApplicationThread->renderCommandNums;
-	for ( size_t i = 0; i < i_commandNums; ++i )
+#ifdef EAE6320_ASSERTS_AREENABLED
+	// A submission is counted before the packet's flag is checked
+	// and SignalThatAllDataForAFrameHasBeenSubmitted() sets the flag before it checks the count
+	// (both sequentially consistent),
+	// and so a submission that overlaps the signal is always caught by one side or the other
+	auto& framePacket = *s_dataBeingSubmittedByApplicationThread;
+	framePacket.renderCommandSubmissionCount_inProgress.fetch_add( 1 );
+	cScopeGuard scopeGuard_submissionCount( [&framePacket]
+		{
+			EAE6320_ASSERTF( !framePacket.hasBeenSubmitted.load(),
+				"Render commands were written to a frame after SignalThatAllDataForAFrameHasBeenSubmitted() was called" );
+			framePacket.renderCommandSubmissionCount_inProgress.fetch_sub( 1 );
+		} );
+	EAE6320_ASSERTF( !framePacket.hasBeenSubmitted.load(),
+		"Render commands can't be submitted after SignalThatAllDataForAFrameHasBeenSubmitted() is called" );
+#endif
+
+	if ( i_commandCount == 0 )
 	{
-		s_dataBeingSubmittedByApplicationThread->renderCommands[i + offset].m_mesh = i_renderCommands[i].m_mesh;
-		s_dataBeingSubmittedByApplicationThread->renderCommands[i + offset].m_transformation = i_renderCommands[i].m_transformation;
+		return;
+	}
+
+	auto* const bucket = GetRenderCommandBucketOfCallingThread( *s_dataBeingSubmittedByApplicationThread );
+	if ( !bucket )
+	{
+		Logging::OutputError( "There was no render command bucket for %u render commands; they won't be rendered", i_commandCount );
+		return;
+	}
+	auto* const renderCommandRun = bucket->frameAllocator.Allocate<sRenderCommandRun>( 1 );
+	auto* const renderCommands = bucket->frameAllocator.Allocate<sRenderCommand>( i_commandCount );
+	if ( !renderCommandRun || !renderCommands )
+	{
+		EAE6320_ASSERTF( false, "Couldn't allocate memory for the submitted render commands" );
+		Logging::OutputError( "Failed to allocate memory for %u render commands; they won't be rendered", i_commandCount );
+		return;
+	}
+
+	// The renderer keeps its own reference to each mesh until the frame has been rendered
+	// (commands that use the same mesh are usually next to each other, and so only a change of mesh needs to be looked up)
+	const cMesh* mesh_previous = nullptr;
+	for ( uint32_t i = 0; i < i_commandCount; ++i )
+	{
+		renderCommands[i] = i_renderCommands[i];
+		auto* const mesh = renderCommands[i].m_mesh;
+		if ( mesh && ( mesh != mesh_previous ) )
+		{
+			if ( !ReferenceMesh( *bucket, *mesh ) )
+			{
+				// The commands that were already copied are dropped along with the rest
+				// (none of them have been linked into the bucket yet)
+				EAE6320_ASSERTF( false, "Couldn't allocate memory for the submitted render commands' meshes" );
+				Logging::OutputError( "Failed to allocate memory for the meshes of %u render commands; they won't be rendered", i_commandCount );
+				return;
+			}
+			mesh_previous = mesh;
+		}
 	}
-	s_dataBeingSubmittedByApplicationThread->renderCommandNums += i_commandNums;
 
+	renderCommandRun->renderCommands = renderCommands;
+	renderCommandRun->renderCommandCount = i_commandCount;
+	if ( bucket->renderCommandRun_last )
+	{
+		bucket->renderCommandRun_last->next = renderCommandRun;
+	}
+	else
+	{
+		bucket->renderCommandRun_first = renderCommandRun;
+	}
+	bucket->renderCommandRun_last = renderCommandRun;
+	bucket->renderCommandCount += i_commandCount;
 }
 
-void eae6320::Graphics::SubmitCamera( const Math::cMatrix_transformation& i_g_transform_worldToCamera, const Math::cMatrix_transformation& i_g_transform_cameraToProjected, const eae6320::Math::sVector& i_g_camera_position )
+void eae6320::Graphics::SubmitCamera( const Math::cMatrix_transformation& i_g_transform_worldToCamera, const Math::cMatrix_transformation& i_g_transform_cameraToProjected, const eae6320::Math::sVector& i_g_camera_position,
+	const float i_verticalFieldOfView_inRadians )
 {
 	EAE6320_ASSERT( s_dataBeingSubmittedByApplicationThread );
+	EAE6320_ASSERT( ( i_verticalFieldOfView_inRadians > 0.0f ) && ( i_verticalFieldOfView_inRadians < 3.14159f ) );
+
+	s_dataBeingSubmittedByApplicationThread->lodErrorScale = 1.0f / std::tan( i_verticalFieldOfView_inRadians * 0.5f );
+	s_dataBeingSubmittedByApplicationThread->lodBias = s_lodBias;
 
 	auto& constantData_frame = s_dataBeingSubmittedByApplicationThread->constantData_frame;
 	constantData_frame.g_transform_worldToCamera = i_g_transform_worldToCamera;
@@ -124,14 +364,72 @@ void eae6320::Graphics::SubmitCamera( const Math::cMatrix_transformation& i_g_tr
 	constantData_frame.g_view_position[2] = i_g_camera_position.z;
 }
 
+void eae6320::Graphics::SetLodBias( const float i_lodBias )
+{
+	EAE6320_ASSERT( i_lodBias > 0.0f );
+	s_lodBias = i_lodBias;
+}
+
 eae6320::cResult eae6320::Graphics::WaitUntilDataForANewFrameCanBeSubmitted( const unsigned int i_timeToWait_inMilliseconds )
 {
-	return Concurrency::WaitForEvent( s_whenDataForANewFrameCanBeSubmittedFromApplicationThread, i_timeToWait_inMilliseconds );
+	auto& framePacket = s_framePackets[s_framePacketIndex_submission];
+	const auto frameNumber = s_frameNumber_submission.load( std::memory_order_relaxed );
+	// The acquire means that the render thread has finished with the packet's previous frame
+	auto fence = framePacket.fence.load( std::memory_order_acquire );
+	if ( fence != frameNumber )
+	{
+		// The application is as far ahead of the renderer as the packets allow
+		const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+		do
+		{
+			if ( i_timeToWait_inMilliseconds == Concurrency::Constants::DontTimeOut )
+			{
+				Concurrency::Futex::WaitWhileEqual( framePacket.fence, fence );
+			}
+			else
+			{
+				const auto elapsedMillisecondCount = static_cast<unsigned int>(
+					Time::ConvertTicksToSeconds( Time::GetCurrentSystemTimeTickCount() - tickCount_start ) * 1000.0 );
+				const auto result = ( elapsedMillisecondCount < i_timeToWait_inMilliseconds )
+					? Concurrency::Futex::WaitWhileEqual( framePacket.fence, fence, i_timeToWait_inMilliseconds - elapsedMillisecondCount )
+					: Results::TimeOut;
+				if ( !result )
+				{
+					s_framePipelineStatistics.tickCount_applicationWaiting += Time::GetCurrentSystemTimeTickCount() - tickCount_start;
+					return result;
+				}
+			}
+			fence = framePacket.fence.load( std::memory_order_acquire );
+		} while ( fence != frameNumber );
+		s_framePipelineStatistics.tickCount_applicationWaiting += Time::GetCurrentSystemTimeTickCount() - tickCount_start;
+	}
+#ifdef EAE6320_ASSERTS_AREENABLED
+	// Any jobs that submit to the packet are started after this
+	framePacket.hasBeenSubmitted.store( false, std::memory_order_relaxed );
+#endif
+	s_dataBeingSubmittedByApplicationThread = &framePacket;
+	return Results::Success;
 }
 
 eae6320::cResult eae6320::Graphics::SignalThatAllDataForAFrameHasBeenSubmitted()
 {
-	return s_whenAllDataHasBeenSubmittedFromApplicationThread.Signal();
+	auto& framePacket = s_framePackets[s_framePacketIndex_submission];
+	EAE6320_ASSERTF( s_dataBeingSubmittedByApplicationThread == &framePacket,
+		"Data for a frame can't be submitted before WaitUntilDataForANewFrameCanBeSubmitted() succeeds" );
+	const auto frameNumber = s_frameNumber_submission.load( std::memory_order_relaxed );
+#ifdef EAE6320_ASSERTS_AREENABLED
+	framePacket.hasBeenSubmitted.store( true );
+	EAE6320_ASSERTF( framePacket.renderCommandSubmissionCount_inProgress.load() == 0,
+		"Render commands were still being submitted when the frame was signaled (every job that submits must be waited for first)" );
+#endif
+	MergeRenderCommandBuckets( framePacket );
+	s_dataBeingSubmittedByApplicationThread = nullptr;
+	s_framePacketIndex_submission = ( s_framePacketIndex_submission + 1 ) % s_framePacketCount;
+	s_frameNumber_submission.store( frameNumber + 1, std::memory_order_relaxed );
+	// The release publishes the submitted data to the render thread
+	framePacket.fence.store( frameNumber + 1, std::memory_order_release );
+	Concurrency::Futex::WakeAll( framePacket.fence );
+	return Results::Success;
 }
 
 // Render
@@ -140,36 +438,37 @@ eae6320::cResult eae6320::Graphics::SignalThatAllDataForAFrameHasBeenSubmitted()
 void eae6320::Graphics::RenderFrame()
 {
 	// Wait for the application loop to submit data to be rendered
+	auto& framePacket = s_framePackets[s_framePacketIndex_render];
 	{
-		if ( Concurrency::WaitForEvent( s_whenAllDataHasBeenSubmittedFromApplicationThread ) )
+		const auto frameNumber_submitted = s_frameNumber_render + 1;
+		// The acquire means that the application has finished submitting the data
+		auto fence = framePacket.fence.load( std::memory_order_acquire );
+		if ( fence != frameNumber_submitted )
 		{
-			// Switch the render data pointers so that
-			// the data that the application just submitted becomes the data that will now be rendered
-			std::swap( s_dataBeingSubmittedByApplicationThread, s_dataBeingRenderedByRenderThread );
-			// Once the pointers have been swapped the application loop can submit new data
-			if ( !s_whenDataForANewFrameCanBeSubmittedFromApplicationThread.Signal() )
+			const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+			do
 			{
-				EAE6320_ASSERTF( false, "Couldn't signal that new graphics data can be submitted" );
-				Logging::OutputError( "Failed to signal that new render data can be submitted" );
-				UserOutput::Print( "The renderer failed to signal to the application that new graphics data can be submitted."
-					" The application is probably in a bad state and should be exited" );
-				return;
-			}
-		}
-		else
-		{
-			EAE6320_ASSERTF( false, "Waiting for the graphics data to be submitted failed" );
-			Logging::OutputError( "Waiting for the application loop to submit data to be rendered failed" );
-			UserOutput::Print( "The renderer failed to wait for the application to submit data to be rendered."
-				" The application is probably in a bad state and should be exited" );
-			return;
+				Concurrency::Futex::WaitWhileEqual( framePacket.fence, fence );
+				fence = framePacket.fence.load( std::memory_order_acquire );
+			} while ( fence != frameNumber_submitted );
+			s_framePipelineStatistics.tickCount_renderWaiting += Time::GetCurrentSystemTimeTickCount() - tickCount_start;
 		}
+		// The application may have submitted more frames since this one
+		const auto queueDepth = s_frameNumber_submission.load( std::memory_order_relaxed ) - s_frameNumber_render;
+		++s_framePipelineStatistics.frameCount;
+		s_framePipelineStatistics.queueDepth_total += queueDepth;
+		s_framePipelineStatistics.queueDepth_maximum = std::max( s_framePipelineStatistics.queueDepth_maximum, queueDepth );
 	}
 
-	EAE6320_ASSERT( s_dataBeingRenderedByRenderThread );
-	auto* const dataRequiredToRenderFrame = s_dataBeingRenderedByRenderThread;
+	auto* const dataRequiredToRenderFrame = &framePacket;
 
-	if( dataRequiredToRenderFrame->renderCommandNums == 0 ) return;
+	sStateCache::g_stateCache.BeginFrame();
+
+	if ( dataRequiredToRenderFrame->renderCommandCount == 0 )
+	{
+		ReleaseFramePacket( *dataRequiredToRenderFrame, false );
+		return;
+	}
 
 	// Update the frame constant buffer
 	{
@@ -180,12 +479,34 @@ void eae6320::Graphics::RenderFrame()
 
 	s_renderTarget->ClearBackBuffer(dataRequiredToRenderFrame->clearColor);
 
-	for ( size_t i = 0; i < dataRequiredToRenderFrame->renderCommandNums; ++i )
+	// Sort the render commands so that binds are grouped
+	// (the queue's memory comes from the same frame allocator as the commands)
+	if ( s_renderQueue.Begin( dataRequiredToRenderFrame->frameAllocator, dataRequiredToRenderFrame->renderCommandCount ) )
 	{
-		auto& renderCommand = dataRequiredToRenderFrame->renderCommands[i];
+		const auto& transform_worldToCamera = dataRequiredToRenderFrame->constantData_frame.g_transform_worldToCamera;
+		for ( auto* renderCommandRun = dataRequiredToRenderFrame->renderCommandRun_first; renderCommandRun; renderCommandRun = renderCommandRun->next )
+		{
+			for ( uint32_t i = 0; i < renderCommandRun->renderCommandCount; ++i )
+			{
+				auto& renderCommand = renderCommandRun->renderCommands[i];
+				if ( renderCommand.m_mesh )
+				{
+					renderCommand.m_lod = SelectLod( renderCommand, *dataRequiredToRenderFrame );
+					s_renderQueue.Push( cRenderQueue::CreateSortKey( renderCommand, transform_worldToCamera ), &renderCommand );
+				}
+			}
+		}
+		s_renderQueue.Sort();
+	}
+	else
+	{
+		ReleaseFramePacket( *dataRequiredToRenderFrame, false );
+		return;
+	}
 
+	// The light is the same for every draw call in the frame
+	{
 		auto& constantData_drawCall = dataRequiredToRenderFrame->constantData_drawCall;
-		constantData_drawCall.g_transform_localToWorld = renderCommand.m_transformation;
 
 		constantData_drawCall.g_light_position[0] = 10.0f;
 		constantData_drawCall.g_light_position[1] = 5.0f;
@@ -194,17 +515,112 @@ void eae6320::Graphics::RenderFrame()
 		constantData_drawCall.g_light_color[0] = 1.0f;
 		constantData_drawCall.g_light_color[1] = 1.0f;
 		constantData_drawCall.g_light_color[2] = 1.0f;
+	}
 
-		s_constantBuffer_drawCall.Bind( static_cast<uint_fast8_t>( eShaderType::Vertex ) | static_cast<uint_fast8_t>( eShaderType::Fragment ) );
-		s_constantBuffer_drawCall.Update( &constantData_drawCall );
+	// Consecutive commands that use the same mesh (and therefore the same materials) at the same level of detail
+	// are drawn with a single instanced draw call,
+	// and so the number of draw calls depends on the number of unique meshes rather than the number of objects
+	const auto commandCount = s_renderQueue.GetCount();
+	auto* const drawBatches = dataRequiredToRenderFrame->frameAllocator.Allocate<sDrawBatch>( commandCount );
+	uint32_t drawBatchCount = 0;
+	if ( drawBatches )
+	{
+		for ( uint32_t i = 0; i < commandCount; )
+		{
+			const auto& renderCommand = *s_renderQueue.GetCommand( i );
+			EAE6320_ASSERT( renderCommand.m_mesh );
 
-		EAE6320_ASSERT( renderCommand.m_mesh );
-		renderCommand.m_mesh->Draw();
+			uint32_t instanceCount = 1;
+			if ( renderCommand.m_isInstancingAllowed )
+			{
+				for ( ; ( i + instanceCount ) < commandCount; ++instanceCount )
+				{
+					const auto& nextRenderCommand = *s_renderQueue.GetCommand( i + instanceCount );
+					if ( ( nextRenderCommand.m_mesh != renderCommand.m_mesh ) || ( nextRenderCommand.m_renderPass != renderCommand.m_renderPass )
+						|| ( nextRenderCommand.m_lod != renderCommand.m_lod ) || !nextRenderCommand.m_isInstancingAllowed )
+					{
+						break;
+					}
+				}
+			}
 
-		renderCommand.CleanUp();
+			auto& drawBatch = drawBatches[drawBatchCount++];
+			drawBatch.firstInstance = i;
+			drawBatch.instanceCount = instanceCount;
+			i += instanceCount;
+		}
 	}
 
-	dataRequiredToRenderFrame->renderCommandNums = 0;
+	// Copy every transform into the instance buffer in sorted order
+	// (instance i belongs to the i-th command in the render queue)
+	// and the constant data for every draw call into the ring (block i belongs to the i-th draw call)
+	// so that each buffer is only uploaded once per frame
+	auto* const instances = ( drawBatches && s_instanceBuffer.Reserve( commandCount ) ) ? s_instanceBuffer.Map() : nullptr;
+	if ( instances )
+	{
+		for ( uint32_t i = 0; i < commandCount; ++i )
+		{
+			instances[i].transform_localToWorld = s_renderQueue.GetCommand( i )->m_transformation;
+		}
+		s_instanceBuffer.Unmap();
+
+		if ( auto* const blocks = static_cast<uint8_t*>( s_constantBuffer_drawCall.MapRing( drawBatchCount ) ) )
+		{
+			const auto blockStride = s_constantBuffer_drawCall.GetRingBlockStride();
+			auto constantData_drawCall = dataRequiredToRenderFrame->constantData_drawCall;
+			for ( uint32_t i = 0; i < drawBatchCount; ++i )
+			{
+				// Shaders that don't read the per-instance transform use the first instance's
+				const auto& renderCommand = *s_renderQueue.GetCommand( drawBatches[i].firstInstance );
+				constantData_drawCall.g_transform_localToWorld = renderCommand.m_transformation;
+				{
+					const auto& bounds = renderCommand.m_mesh->GetBounds();
+					for ( size_t j = 0; j < 3; ++j )
+					{
+						constantData_drawCall.g_vertexPosition_offset[j] = bounds.minimum[j];
+						constantData_drawCall.g_vertexPosition_scale[j] = bounds.maximum[j] - bounds.minimum[j];
+					}
+				}
+				memcpy( blocks + ( blockStride * i ), &constantData_drawCall, sizeof( constantData_drawCall ) );
+			}
+			s_constantBuffer_drawCall.UnmapRing();
+
+			{
+				const auto& constantData_frame = dataRequiredToRenderFrame->constantData_frame;
+				s_meshletCuller.SetView( constantData_frame.g_transform_worldToCamera, constantData_frame.g_transform_cameraToProjected,
+					Math::sVector( constantData_frame.g_view_position[0], constantData_frame.g_view_position[1], constantData_frame.g_view_position[2] ) );
+			}
+			for ( uint32_t i = 0; i < drawBatchCount; ++i )
+			{
+				const auto& drawBatch = drawBatches[i];
+				s_constantBuffer_drawCall.BindRange( static_cast<uint_fast8_t>( eShaderType::Vertex ) | static_cast<uint_fast8_t>( eShaderType::Fragment ), i );
+				const auto& renderCommand = *s_renderQueue.GetCommand( drawBatch.firstInstance );
+				auto* const mesh = renderCommand.m_mesh;
+				// Meshlets only exist at full detail,
+				// and a batch with many instances is drawn whole (see cMeshletCuller::s_maximumInstanceCount)
+				cMesh::sDrawRange* drawRanges = nullptr;
+				if ( ( renderCommand.m_lod == 0 ) && ( mesh->GetMeshletCount() > 0 ) && ( drawBatch.instanceCount <= cMeshletCuller::s_maximumInstanceCount ) )
+				{
+					drawRanges = dataRequiredToRenderFrame->frameAllocator.Allocate<cMesh::sDrawRange>( mesh->GetMeshletCount() );
+				}
+				if ( drawRanges )
+				{
+					s_meshletCuller.Begin( *mesh );
+					for ( uint32_t j = 0; j < drawBatch.instanceCount; ++j )
+					{
+						s_meshletCuller.AddInstance( s_renderQueue.GetCommand( drawBatch.firstInstance + j )->m_transformation );
+					}
+					const auto drawRangeCount = s_meshletCuller.End( drawRanges );
+					mesh->Draw( s_instanceBuffer, drawBatch.firstInstance, drawBatch.instanceCount, drawRanges, drawRangeCount );
+				}
+				else
+				{
+					mesh->Draw( s_instanceBuffer, drawBatch.firstInstance, drawBatch.instanceCount, renderCommand.m_lod );
+				}
+			}
+			s_constantBuffer_drawCall.EndRingFrame();
+		}
+	}
 
 	// Swap back buffers
 	{
@@ -215,11 +631,195 @@ void eae6320::Graphics::RenderFrame()
 	// you must make sure that it is all cleaned up and cleared out
 	// so that the struct can be re-used (i.e. so that data for a new frame can be submitted to it)
 	{
-		// (At this point in the class there isn't anything that needs to be cleaned up)
-		//dataRequiredToRenderFrame	// TODO
+		ReleaseFramePacket( *dataRequiredToRenderFrame, true );
+	}
+}
+
+#ifdef EAE6320_GRAPHICS_ISSUBMISSIONTESTENABLED
+
+// Test
+//-----
+
+void eae6320::Graphics::RunSubmissionTest( cMesh& i_mesh )
+{
+	EAE6320_ASSERTF( !s_dataBeingSubmittedByApplicationThread, "The submission test can't run while a frame is being submitted" );
+
+	// Decrementing returns the new count
+	const auto GetReferenceCount = [&i_mesh]()
+	{
+		i_mesh.IncrementReferenceCount();
+		return static_cast<uint32_t>( i_mesh.DecrementReferenceCount() );
+	};
+	const auto referenceCount_initial = GetReferenceCount();
+
+	// The commands are submitted in several calls
+	// so that the same mesh is seen in more than one run of the same bucket
+	constexpr uint32_t commandCount = 70000;
+	constexpr uint32_t commandCount_perSubmission = 10000;
+	std::vector<sRenderCommand> renderCommands( commandCount_perSubmission );
+	for ( auto& renderCommand : renderCommands )
+	{
+		renderCommand.m_mesh = &i_mesh;
+	}
+
+	bool wasTestSuccessful = true;
+	{
+		// The application can get ahead of the renderer by every packet,
+		// and so every packet is filled before any are rendered
+		const float clearColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+		for ( unsigned int i = 0; i < s_framePacketCount; ++i )
+		{
+			if ( !WaitUntilDataForANewFrameCanBeSubmitted( 0 ) )
+			{
+				EAE6320_ASSERTF( false, "A frame packet wasn't available for the submission test" );
+				Logging::OutputError( "The submission test couldn't get frame packet %u", i );
+				wasTestSuccessful = false;
+				break;
+			}
+			SubmitClearColor( clearColor );
+			for ( uint32_t j = 0; j < commandCount; j += commandCount_perSubmission )
+			{
+				SubmitRenderCommands( renderCommands.data(), std::min( commandCount - j, commandCount_perSubmission ) );
+			}
+			SignalThatAllDataForAFrameHasBeenSubmitted();
+		}
+		const auto framePacketCount_submitted = s_frameNumber_submission.load( std::memory_order_relaxed ) - s_frameNumber_render;
+		// Each packet only submitted from this thread and so only has one bucket
+		const auto referenceCount_submitted = GetReferenceCount();
+		if ( referenceCount_submitted != ( referenceCount_initial + framePacketCount_submitted ) )
+		{
+			wasTestSuccessful = false;
+			EAE6320_ASSERTF( false, "%u frames of %u render commands should have added %u mesh references, but they added %u",
+				framePacketCount_submitted, commandCount, framePacketCount_submitted, referenceCount_submitted - referenceCount_initial );
+			Logging::OutputError( "%u frames of %u render commands should have added %u mesh references, but they added %u",
+				framePacketCount_submitted, commandCount, framePacketCount_submitted, referenceCount_submitted - referenceCount_initial );
+		}
+		for ( uint32_t i = 0; i < framePacketCount_submitted; ++i )
+		{
+			RenderFrame();
+		}
+	}
+	{
+		const auto referenceCount_rendered = GetReferenceCount();
+		if ( referenceCount_rendered != referenceCount_initial )
+		{
+			wasTestSuccessful = false;
+			EAE6320_ASSERTF( false, "The mesh had %u references before the submission test and %u after",
+				referenceCount_initial, referenceCount_rendered );
+			Logging::OutputError( "The mesh had %u references before the submission test and %u after",
+				referenceCount_initial, referenceCount_rendered );
+		}
+	}
+	if ( wasTestSuccessful )
+	{
+		Logging::OutputMessage( "The submission test rendered %u frames of %u render commands for one mesh with balanced references",
+			s_framePacketCount, commandCount );
+	}
+}
+
+void eae6320::Graphics::RunJobSubmissionTest( cMesh& i_mesh, Concurrency::cJobSystem& i_jobSystem )
+{
+	EAE6320_ASSERTF( !s_dataBeingSubmittedByApplicationThread, "The job submission test can't run while a frame is being submitted" );
+
+	// Every command is at a different whole-number depth in front of the camera
+	// (up to 2^15 these all quantize to different sort keys),
+	// and so there is only one correct order no matter which bucket each command ends up in.
+	// The depths are shuffled so that sorting has to move the commands
+	constexpr uint32_t commandCount = 20000;
+	constexpr uint32_t commandCount_perJob = 250;
+	std::vector<sRenderCommand> renderCommands( commandCount );
+	for ( uint32_t i = 0; i < commandCount; ++i )
+	{
+		auto& renderCommand = renderCommands[i];
+		renderCommand.m_mesh = &i_mesh;
+		const auto depth = static_cast<float>( ( ( i * 7919u ) % commandCount ) + 1u );
+		renderCommand.m_transformation = Math::cMatrix_transformation( Math::cQuaternion(), Math::sVector( 0.0f, 0.0f, -depth ) );
+	}
+
+	// Submits a frame with the given function and returns the commands' depths in the order that the render thread would draw them
+	// (or an empty list if the frame couldn't be submitted)
+	const auto SubmitAndSort = []( const auto& i_submitRenderCommands, uint32_t& o_bucketCount )
+	{
+		std::vector<float> depths;
+		o_bucketCount = 0;
+		if ( !WaitUntilDataForANewFrameCanBeSubmitted( 0 ) )
+		{
+			EAE6320_ASSERTF( false, "A frame packet wasn't available for the job submission test" );
+			Logging::OutputError( "The job submission test couldn't get a frame packet" );
+			return depths;
+		}
+		auto& framePacket = *s_dataBeingSubmittedByApplicationThread;
+		{
+			const float clearColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+			SubmitClearColor( clearColor );
+			// The camera is at the origin looking down the negative Z axis
+			constexpr float verticalFieldOfView_inRadians = 1.0f;
+			SubmitCamera( Math::cMatrix_transformation(), Math::cMatrix_transformation(), Math::sVector(), verticalFieldOfView_inRadians );
+		}
+		i_submitRenderCommands();
+		SignalThatAllDataForAFrameHasBeenSubmitted();
+		o_bucketCount = std::min( framePacket.renderCommandBucketCount.load( std::memory_order_relaxed ), s_renderCommandBucketCount_maximum );
+		// The commands are sorted the same way that RenderFrame() sorts them
+		// (this is the render thread, and the packet can't be used by the application again until it has been rendered)
+		cRenderQueue renderQueue;
+		if ( renderQueue.Begin( framePacket.frameAllocator, framePacket.renderCommandCount ) )
+		{
+			const auto& transform_worldToCamera = framePacket.constantData_frame.g_transform_worldToCamera;
+			for ( auto* renderCommandRun = framePacket.renderCommandRun_first; renderCommandRun; renderCommandRun = renderCommandRun->next )
+			{
+				for ( uint32_t i = 0; i < renderCommandRun->renderCommandCount; ++i )
+				{
+					auto& renderCommand = renderCommandRun->renderCommands[i];
+					renderQueue.Push( cRenderQueue::CreateSortKey( renderCommand, transform_worldToCamera ), &renderCommand );
+				}
+			}
+			renderQueue.Sort();
+			depths.reserve( renderQueue.GetCount() );
+			for ( uint32_t i = 0; i < renderQueue.GetCount(); ++i )
+			{
+				depths.push_back( -renderQueue.GetCommand( i )->m_transformation.GetTranslation().z );
+			}
+		}
+		RenderFrame();
+		return depths;
+	};
+
+	uint32_t bucketCount_singleThread, bucketCount_jobs;
+	const auto depths_singleThread = SubmitAndSort( [&renderCommands]
+		{
+			SubmitRenderCommands( renderCommands.data(), commandCount );
+		}, bucketCount_singleThread );
+	const auto depths_jobs = SubmitAndSort( [&renderCommands, &i_jobSystem]
+		{
+			// The calling thread runs ranges too while it waits for the job system's threads
+			i_jobSystem.ParallelFor( 0, commandCount, commandCount_perJob, [&renderCommands]( const uint32_t i_rangeBegin, const uint32_t i_rangeEnd )
+				{
+					SubmitRenderCommands( renderCommands.data() + i_rangeBegin, i_rangeEnd - i_rangeBegin );
+				} );
+		}, bucketCount_jobs );
+
+	if ( ( depths_singleThread.size() == commandCount ) && ( depths_jobs == depths_singleThread ) )
+	{
+		Logging::OutputMessage( "The job submission test drew %u render commands submitted from %u threads in the same order as when they were submitted from one thread",
+			commandCount, bucketCount_jobs );
+	}
+	else
+	{
+		uint32_t firstDifferentIndex = 0;
+		while ( ( firstDifferentIndex < depths_singleThread.size() ) && ( firstDifferentIndex < depths_jobs.size() )
+			&& ( depths_singleThread[firstDifferentIndex] == depths_jobs[firstDifferentIndex] ) )
+		{
+			++firstDifferentIndex;
+		}
+		EAE6320_ASSERTF( false, "%u render commands from one thread and %u from %u threads were sorted differently starting at command %u",
+			static_cast<unsigned int>( depths_singleThread.size() ), static_cast<unsigned int>( depths_jobs.size() ), bucketCount_jobs, firstDifferentIndex );
+		Logging::OutputError( "%u render commands from one thread and %u from %u threads were sorted differently starting at command %u",
+			static_cast<unsigned int>( depths_singleThread.size() ), static_cast<unsigned int>( depths_jobs.size() ), bucketCount_jobs, firstDifferentIndex );
 	}
 }
 
+#endif	// EAE6320_GRAPHICS_ISSUBMISSIONTESTENABLED
+
 // Initialize / Clean Up
 //----------------------
 
@@ -233,6 +833,45 @@ eae6320::cResult eae6320::Graphics::Initialize( const sInitializationParameters&
 		EAE6320_ASSERTF( false, "Can't initialize Graphics without context" );
 		return result;
 	}
+	if ( !( result = sStateCache::g_stateCache.Initialize() ) )
+	{
+		EAE6320_ASSERTF( false, "Can't initialize Graphics without the state cache" );
+		return result;
+	}
+	if ( !( result = cShader::s_manager.Initialize() ) )
+	{
+		EAE6320_ASSERTF( false, "Can't initialize Graphics without the shader manager" );
+		return result;
+	}
+	if ( !( result = cEffect::s_manager.Initialize() ) )
+	{
+		EAE6320_ASSERTF( false, "Can't initialize Graphics without the effect manager" );
+		return result;
+	}
+	if ( !( result = cTexture::s_manager.Initialize() ) )
+	{
+		EAE6320_ASSERTF( false, "Can't initialize Graphics without the texture manager" );
+		return result;
+	}
+	// Initialize the frame packets
+	{
+		const auto framePacketCount = i_initializationParameters.framePacketCount;
+		EAE6320_ASSERTF( ( framePacketCount >= s_framePacketCount_minimum ) && ( framePacketCount <= s_framePacketCount_maximum ),
+			"There must be between %u and %u frame packets", s_framePacketCount_minimum, s_framePacketCount_maximum );
+		s_framePacketCount = std::min( std::max( framePacketCount, s_framePacketCount_minimum ), s_framePacketCount_maximum );
+		if ( s_framePacketCount != framePacketCount )
+		{
+			Logging::OutputError( "%u frame packets were requested but %u will be used", framePacketCount, s_framePacketCount );
+		}
+		// Every packet starts out ready for the first frame that will use it
+		for ( unsigned int i = 0; i < s_framePacketCount; ++i )
+		{
+			s_framePackets[i].fence.store( i, std::memory_order_relaxed );
+		}
+		s_framePacketIndex_submission = s_framePacketIndex_render = 0;
+		s_frameNumber_submission = s_frameNumber_render = 0;
+		s_framePipelineStatistics = sFramePipelineStatistics();
+	}
 	// Initialize the platform-independent graphics objects
 	{
 		if ( result = s_constantBuffer_frame.Initialize() )
@@ -249,31 +888,44 @@ eae6320::cResult eae6320::Graphics::Initialize( const sInitializationParameters&
 			return result;
 		}
 
-		if ( !( result = s_constantBuffer_material.Initialize() ) )
+		// The ring grows if a frame has more draw calls than this
+		if ( !( result = s_constantBuffer_drawCall.InitializeRing( 256 ) ) )
 		{
-			EAE6320_ASSERTF( false, "Can't initialize Graphics without frame material buffer" );
+			EAE6320_ASSERTF( false, "Can't initialize Graphics without frame draw call buffer" );
 			return result;
 		}
 
-		if ( !( result = s_constantBuffer_drawCall.Initialize() ) )
+		for ( unsigned int i = 0; i < s_framePacketCount; ++i )
 		{
-			EAE6320_ASSERTF( false, "Can't initialize Graphics without frame draw call buffer" );
-			return result;
+			if ( !( result = s_framePackets[i].frameAllocator.Initialize( s_frameAllocatorInitialSize ) ) )
+			{
+				EAE6320_ASSERTF( false, "Can't initialize Graphics without frame allocators" );
+				return result;
+			}
 		}
-	}
-	// Initialize the events
-	{
-		if ( !( result = s_whenAllDataHasBeenSubmittedFromApplicationThread.Initialize( Concurrency::EventType::ResetAutomaticallyAfterBeingSignaled ) ) )
+
+#if defined( EAE6320_PLATFORM_D3D )
+		if ( i_initializationParameters.resolutionHeight > 0 )
 		{
-			EAE6320_ASSERTF( false, "Can't initialize Graphics without event for when data has been submitted from the application thread" );
-			return result;
+			s_maximumLodError_projected = 2.0f / i_initializationParameters.resolutionHeight;
 		}
-		if ( !( result = s_whenDataForANewFrameCanBeSubmittedFromApplicationThread.Initialize( Concurrency::EventType::ResetAutomaticallyAfterBeingSignaled,
-			Concurrency::EventState::Signaled ) ) )
+#endif
+
+		// The instance buffer grows if a frame has more commands than this
+		if ( !( result = s_instanceBuffer.Initialize( 1024 ) ) )
 		{
-			EAE6320_ASSERTF( false, "Can't initialize Graphics without event for when data can be submitted from the application thread" );
+			EAE6320_ASSERTF( false, "Can't initialize Graphics without instance buffer" );
 			return result;
 		}
+#ifdef EAE6320_GRAPHICS_ISRENDERQUEUEBENCHMARKENABLED
+		cRenderQueue::RunBenchmark();
+#endif
+#ifdef EAE6320_GRAPHICS_ISOCCLUSIONBENCHMARKENABLED
+		cOcclusionCuller::RunBenchmark();
+#endif
+#ifdef EAE6320_GRAPHICS_ISOCCLUSIONTESTENABLED
+		cOcclusionCuller::RunReferenceTest();
+#endif
 	}
 	// Initialize the views
 	{
@@ -297,37 +949,64 @@ eae6320::cResult eae6320::Graphics::CleanUp()
 		s_renderTarget = nullptr;
 	}
 
-	// Exit before render frame
-	// clean up
-	if ( s_dataBeingRenderedByRenderThread )
+	// Any commands that were submitted but never rendered still hold references
+	for ( auto& framePacket : s_framePackets )
 	{
-		auto* const dataRequiredToRenderFrame = s_dataBeingRenderedByRenderThread;
-		for ( size_t i = 0; i < std::numeric_limits<uint16_t>::max(); ++i )
+		ResetSubmittedData( framePacket );
+		framePacket.frameAllocator.CleanUp();
+		framePacket.frameAllocatorGrowthCount = 0;
+		for ( auto& bucket : framePacket.renderCommandBuckets )
 		{
-			dataRequiredToRenderFrame->renderCommands[i].CleanUp();
+			bucket.frameAllocator.CleanUp();
+			bucket.isFrameAllocatorInitialized = false;
 		}
 	}
+	s_dataBeingSubmittedByApplicationThread = nullptr;
 
 	{
-		const auto result_constantBuffer_frame = s_constantBuffer_frame.CleanUp();
-		if ( !result_constantBuffer_frame )
+		const auto& statistics = s_framePipelineStatistics;
+		if ( statistics.frameCount > 0 )
+		{
+			const auto GetMilliseconds = []( const uint64_t i_tickCount )
+			{
+				return Time::ConvertTicksToSeconds( i_tickCount ) * 1000.0;
+			};
+			Logging::OutputMessage( "%u frame packets rendered %llu frames with an average of %.2f (and a maximum of %u) submitted frames waiting to be rendered,"
+				" and the input was shown after an average of %.2f ms (and a maximum of %.2f ms);"
+				" the application waited %.1f ms for a packet and the renderer waited %.1f ms for a frame",
+				s_framePacketCount, statistics.frameCount,
+				static_cast<double>( statistics.queueDepth_total ) / static_cast<double>( statistics.frameCount ), statistics.queueDepth_maximum,
+				( statistics.frameCount_shown > 0 ) ? ( GetMilliseconds( statistics.tickCount_inputToDisplay_total ) / static_cast<double>( statistics.frameCount_shown ) ) : 0.0,
+				GetMilliseconds( statistics.tickCount_inputToDisplay_maximum ),
+				GetMilliseconds( statistics.tickCount_applicationWaiting ), GetMilliseconds( statistics.tickCount_renderWaiting ) );
+			Logging::OutputMessage( "The frame allocators used an average of %.1f KB (and a maximum of %.1f KB) per frame"
+				" and grew %u times in %llu frames (at most %u times in one frame)",
+				( static_cast<double>( statistics.byteCount_frameAllocators_total ) / static_cast<double>( statistics.frameCount ) ) / 1024.0,
+				static_cast<double>( statistics.byteCount_frameAllocators_maximum ) / 1024.0,
+				statistics.frameAllocatorGrowthCount_total, statistics.frameCount_frameAllocatorsGrew, statistics.frameAllocatorGrowthCount_maximum );
+		}
+	}
+
+	{
+		const auto result_instanceBuffer = s_instanceBuffer.CleanUp();
+		if ( !result_instanceBuffer )
 		{
 			EAE6320_ASSERT( false );
 			if ( result )
 			{
-				result = result_constantBuffer_frame;
+				result = result_instanceBuffer;
 			}
 		}
 	}
 
 	{
-		const auto result_constantBuffer_material = s_constantBuffer_material.CleanUp();
-		if ( !result_constantBuffer_material )
+		const auto result_constantBuffer_frame = s_constantBuffer_frame.CleanUp();
+		if ( !result_constantBuffer_frame )
 		{
 			EAE6320_ASSERT( false );
 			if ( result )
 			{
-				result = result_constantBuffer_material;
+				result = result_constantBuffer_frame;
 			}
 		}
 	}
@@ -344,6 +1023,84 @@ eae6320::cResult eae6320::Graphics::CleanUp()
 		}
 	}
 
+	{
+		// Every material has been cleaned up by now
+		// and so any texture that is still resident has leaked
+		if ( cTexture::GetResidentTextureCount() > 0 )
+		{
+			Logging::OutputError( "%u textures (%.2f MB) were never released",
+				cTexture::GetResidentTextureCount(), static_cast<double>( cTexture::GetResidentMemorySize() ) / ( 1024.0 * 1024.0 ) );
+		}
+		const auto result_textureManager = cTexture::s_manager.CleanUp();
+		if ( !result_textureManager )
+		{
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = result_textureManager;
+			}
+		}
+	}
+
+	// Effects hold handles to shaders
+	// and so they must be cleaned up first
+	{
+		const auto result_effectManager = cEffect::s_manager.CleanUp();
+		if ( !result_effectManager )
+		{
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = result_effectManager;
+			}
+		}
+	}
+	{
+		const auto result_shaderManager = cShader::s_manager.CleanUp();
+		if ( !result_shaderManager )
+		{
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = result_shaderManager;
+			}
+		}
+	}
+
+	{
+		const auto& statistics = s_meshletCuller.GetStatistics();
+		if ( statistics.testedCount > 0 )
+		{
+			const auto triangleCount_total = statistics.triangleCount_drawn + statistics.triangleCount_culled;
+			Logging::OutputMessage( "The meshlet culler skipped %llu of %llu triangles (%.1f%%) in %.3f ms:"
+				" %llu meshlet tests were off-screen and %llu were back-facing out of %llu, and %llu ranges were drawn",
+				statistics.triangleCount_culled, triangleCount_total,
+				100.0 * static_cast<double>( statistics.triangleCount_culled ) / static_cast<double>( triangleCount_total ),
+				Time::ConvertTicksToSeconds( statistics.tickCount ) * 1000.0,
+				statistics.culledCount_frustum, statistics.culledCount_backFacing, statistics.testedCount, statistics.drawRangeCount );
+		}
+	}
+	{
+		auto& stateCache = sStateCache::g_stateCache;
+		stateCache.BeginFrame();
+		const auto bindCount_total = stateCache.GetBindCount_issued_total() + stateCache.GetBindCount_skipped_total();
+		if ( bindCount_total > 0 )
+		{
+			Logging::OutputMessage( "The state cache skipped %llu of %llu binds (%.1f%%)",
+				stateCache.GetBindCount_skipped_total(), bindCount_total,
+				100.0 * static_cast<double>( stateCache.GetBindCount_skipped_total() ) / static_cast<double>( bindCount_total ) );
+		}
+		const auto result_stateCache = stateCache.CleanUp();
+		if ( !result_stateCache )
+		{
+			EAE6320_ASSERT( false );
+			if ( result )
+			{
+				result = result_stateCache;
+			}
+		}
+	}
+
 	{
 		const auto result_context = sContext::g_context.CleanUp();
 		if ( !result_context )
@@ -382,4 +1139,230 @@ namespace
 
 		return result;
 	}
-}
\ No newline at end of file
+
+	void ResetSubmittedData( sDataRequiredToRenderAFrame& io_dataRequiredToRenderAFrame )
+	{
+		// The commands don't own their meshes (the buckets do),
+		// and so nothing in them needs to be cleaned up
+		io_dataRequiredToRenderAFrame.renderCommandRun_first = nullptr;
+		io_dataRequiredToRenderAFrame.renderCommandRun_last = nullptr;
+		io_dataRequiredToRenderAFrame.renderCommandCount = 0;
+		{
+			const auto bucketCount = std::min( io_dataRequiredToRenderAFrame.renderCommandBucketCount.load( std::memory_order_relaxed ),
+				s_renderCommandBucketCount_maximum );
+			for ( uint32_t i = 0; i < bucketCount; ++i )
+			{
+				auto& bucket = io_dataRequiredToRenderAFrame.renderCommandBuckets[i];
+				for ( uint32_t j = 0; j < bucket.referencedMeshCapacity; ++j )
+				{
+					if ( auto* const mesh = bucket.referencedMeshes[j] )
+					{
+						mesh->DecrementReferenceCount();
+					}
+				}
+				bucket.referencedMeshes = nullptr;
+				bucket.referencedMeshCount = 0;
+				bucket.referencedMeshCapacity = 0;
+				// A bucket only still has runs if the frame was never submitted
+				bucket.renderCommandRun_first = nullptr;
+				bucket.renderCommandRun_last = nullptr;
+				bucket.renderCommandCount = 0;
+				bucket.frameAllocator.Reset();
+			}
+			io_dataRequiredToRenderAFrame.renderCommandBucketCount.store( 0, std::memory_order_relaxed );
+		}
+
+		// Nothing in the frame allocator needs to be destructed,
+		// and so resetting it doesn't depend on how much was allocated
+		io_dataRequiredToRenderAFrame.frameAllocator.Reset();
+	}
+
+	void ReleaseFramePacket( sDataRequiredToRenderAFrame& io_framePacket, const bool i_wasShown )
+	{
+		EAE6320_ASSERT( &io_framePacket == &s_framePackets[s_framePacketIndex_render] );
+		if ( i_wasShown && ( io_framePacket.tickCount_input != 0 ) )
+		{
+			const auto tickCount_inputToDisplay = eae6320::Time::GetCurrentSystemTimeTickCount() - io_framePacket.tickCount_input;
+			++s_framePipelineStatistics.frameCount_shown;
+			s_framePipelineStatistics.tickCount_inputToDisplay_total += tickCount_inputToDisplay;
+			s_framePipelineStatistics.tickCount_inputToDisplay_maximum = std::max( s_framePipelineStatistics.tickCount_inputToDisplay_maximum, tickCount_inputToDisplay );
+		}
+		io_framePacket.tickCount_input = 0;
+		// The allocators' usage must be read before they are reset
+		{
+			size_t byteCount_used = io_framePacket.frameAllocator.GetStatistics().byteCount_usedThisFrame;
+			uint32_t growthCount = io_framePacket.frameAllocator.GetStatistics().growthCount;
+			// A bucket that wasn't claimed this frame has used nothing since it was last reset,
+			// but its growth still counts towards the packet's total
+			for ( const auto& bucket : io_framePacket.renderCommandBuckets )
+			{
+				if ( bucket.isFrameAllocatorInitialized )
+				{
+					byteCount_used += bucket.frameAllocator.GetStatistics().byteCount_usedThisFrame;
+					growthCount += bucket.frameAllocator.GetStatistics().growthCount;
+				}
+			}
+			const auto growthCount_thisFrame = growthCount - io_framePacket.frameAllocatorGrowthCount;
+			io_framePacket.frameAllocatorGrowthCount = growthCount;
+			auto& statistics = s_framePipelineStatistics;
+			statistics.byteCount_frameAllocators_total += byteCount_used;
+			statistics.byteCount_frameAllocators_maximum = std::max( statistics.byteCount_frameAllocators_maximum, byteCount_used );
+			if ( growthCount_thisFrame > 0 )
+			{
+				statistics.frameAllocatorGrowthCount_total += growthCount_thisFrame;
+				statistics.frameAllocatorGrowthCount_maximum = std::max( statistics.frameAllocatorGrowthCount_maximum, growthCount_thisFrame );
+				++statistics.frameCount_frameAllocatorsGrew;
+			}
+		}
+		ResetSubmittedData( io_framePacket );
+
+		// The packet will next be used for the frame that is a full ring later
+		const auto frameNumber = s_frameNumber_render;
+		s_frameNumber_render = frameNumber + 1;
+		s_framePacketIndex_render = ( s_framePacketIndex_render + 1 ) % s_framePacketCount;
+		// The release means that the render thread has finished with the data before the application submits to it again
+		io_framePacket.fence.store( frameNumber + s_framePacketCount, std::memory_order_release );
+		eae6320::Concurrency::Futex::WakeAll( io_framePacket.fence );
+	}
+
+	sRenderCommandBucket* GetRenderCommandBucketOfCallingThread( sDataRequiredToRenderAFrame& io_framePacket )
+	{
+		// A thread only needs to claim a bucket the first time that it submits render commands for a frame
+		const auto frameNumber = s_frameNumber_submission.load( std::memory_order_relaxed );
+		if ( s_claimedRenderCommandBucket.bucket && ( s_claimedRenderCommandBucket.frameNumber == frameNumber ) )
+		{
+			return s_claimedRenderCommandBucket.bucket;
+		}
+		const auto bucketIndex = io_framePacket.renderCommandBucketCount.fetch_add( 1, std::memory_order_relaxed );
+		if ( bucketIndex >= s_renderCommandBucketCount_maximum )
+		{
+			EAE6320_ASSERTF( false, "More than %u threads submitted render commands for a single frame", s_renderCommandBucketCount_maximum );
+			return nullptr;
+		}
+		// No other thread can use the bucket until the frame has been rendered
+		auto& bucket = io_framePacket.renderCommandBuckets[bucketIndex];
+		if ( !bucket.isFrameAllocatorInitialized )
+		{
+			if ( !bucket.frameAllocator.Initialize( s_renderCommandBucketAllocatorInitialSize ) )
+			{
+				EAE6320_ASSERTF( false, "Couldn't initialize a render command bucket's frame allocator" );
+				return nullptr;
+			}
+			bucket.isFrameAllocatorInitialized = true;
+		}
+		s_claimedRenderCommandBucket.bucket = &bucket;
+		s_claimedRenderCommandBucket.frameNumber = frameNumber;
+		return &bucket;
+	}
+
+	void MergeRenderCommandBuckets( sDataRequiredToRenderAFrame& io_framePacket )
+	{
+		// Every thread that submitted must have finished by now
+		// (the application is responsible for waiting for any jobs that submit render commands),
+		// and the render thread sorts every command in the frame anyway
+		// and so the order of the buckets doesn't matter
+		const auto bucketCount = std::min( io_framePacket.renderCommandBucketCount.load( std::memory_order_relaxed ), s_renderCommandBucketCount_maximum );
+		for ( uint32_t i = 0; i < bucketCount; ++i )
+		{
+			auto& bucket = io_framePacket.renderCommandBuckets[i];
+			if ( !bucket.renderCommandRun_first )
+			{
+				continue;
+			}
+			if ( io_framePacket.renderCommandRun_last )
+			{
+				io_framePacket.renderCommandRun_last->next = bucket.renderCommandRun_first;
+			}
+			else
+			{
+				io_framePacket.renderCommandRun_first = bucket.renderCommandRun_first;
+			}
+			io_framePacket.renderCommandRun_last = bucket.renderCommandRun_last;
+			io_framePacket.renderCommandCount += bucket.renderCommandCount;
+			// The runs belong to the frame's list now
+			bucket.renderCommandRun_first = nullptr;
+			bucket.renderCommandRun_last = nullptr;
+			bucket.renderCommandCount = 0;
+		}
+	}
+
+	eae6320::cResult ReferenceMesh( sRenderCommandBucket& io_bucket, eae6320::Graphics::cMesh& i_mesh )
+	{
+		const auto FindSlot = []( eae6320::Graphics::cMesh* const* const i_meshes, const uint32_t i_capacity, const eae6320::Graphics::cMesh* const i_mesh )
+		{
+			// The capacity is a power of two,
+			// and the low bits of a pointer are always the same because of alignment and so they are shifted away
+			auto index = static_cast<uint32_t>( ( reinterpret_cast<uintptr_t>( i_mesh ) >> 4 ) * 2654435761u ) & ( i_capacity - 1 );
+			while ( i_meshes[index] && ( i_meshes[index] != i_mesh ) )
+			{
+				index = ( index + 1 ) & ( i_capacity - 1 );
+			}
+			return index;
+		};
+
+		if ( io_bucket.referencedMeshCapacity > 0 )
+		{
+			if ( io_bucket.referencedMeshes[FindSlot( io_bucket.referencedMeshes, io_bucket.referencedMeshCapacity, &i_mesh )] == &i_mesh )
+			{
+				return eae6320::Results::Success;
+			}
+		}
+		// The set is kept at most half full so that probing stays short
+		if ( ( ( io_bucket.referencedMeshCount + 1 ) * 2 ) > io_bucket.referencedMeshCapacity )
+		{
+			const auto capacity_new = std::max( io_bucket.referencedMeshCapacity * 2, 64u );
+			auto* const meshes_new = io_bucket.frameAllocator.Allocate<eae6320::Graphics::cMesh*>( capacity_new );
+			if ( !meshes_new )
+			{
+				return eae6320::Results::OutOfMemory;
+			}
+			// The old array is left in the frame allocator until the frame is reset
+			for ( uint32_t i = 0; i < io_bucket.referencedMeshCapacity; ++i )
+			{
+				if ( auto* const mesh = io_bucket.referencedMeshes[i] )
+				{
+					meshes_new[FindSlot( meshes_new, capacity_new, mesh )] = mesh;
+				}
+			}
+			io_bucket.referencedMeshes = meshes_new;
+			io_bucket.referencedMeshCapacity = capacity_new;
+		}
+		io_bucket.referencedMeshes[FindSlot( io_bucket.referencedMeshes, io_bucket.referencedMeshCapacity, &i_mesh )] = &i_mesh;
+		++io_bucket.referencedMeshCount;
+		i_mesh.IncrementReferenceCount();
+		return eae6320::Results::Success;
+	}
+
+	uint8_t SelectLod( const eae6320::Graphics::sRenderCommand& i_renderCommand, const sDataRequiredToRenderAFrame& i_dataRequiredToRenderAFrame )
+	{
+		const auto* const mesh = i_renderCommand.m_mesh;
+		EAE6320_ASSERT( mesh );
+		if ( mesh->GetLodCount() <= 1 )
+		{
+			return 0;
+		}
+
+		// The mesh is treated as the sphere around its bounds
+		const auto& bounds = mesh->GetBounds();
+		const eae6320::Math::sVector center_local( ( bounds.minimum[0] + bounds.maximum[0] ) * 0.5f,
+			( bounds.minimum[1] + bounds.maximum[1] ) * 0.5f, ( bounds.minimum[2] + bounds.maximum[2] ) * 0.5f );
+		const eae6320::Math::sVector extents( bounds.maximum[0] - bounds.minimum[0],
+			bounds.maximum[1] - bounds.minimum[1], bounds.maximum[2] - bounds.minimum[2] );
+		const auto& transform_localToWorld = i_renderCommand.m_transformation;
+		const auto scale = std::max( transform_localToWorld.GetRightDirection().GetLength(),
+			std::max( transform_localToWorld.GetUpDirection().GetLength(), transform_localToWorld.GetBackDirection().GetLength() ) );
+		const auto radius = extents.GetLength() * 0.5f * scale;
+
+		const auto& cameraPosition = i_dataRequiredToRenderAFrame.constantData_frame.g_view_position;
+		const auto offset = ( transform_localToWorld * center_local ) - eae6320::Math::sVector( cameraPosition[0], cameraPosition[1], cameraPosition[2] );
+		// The closest point of the sphere is used so that a large mesh that the camera is close to stays detailed
+		const auto distance = offset.GetLength() - radius;
+		if ( distance <= 0.0f )
+		{
+			return 0;
+		}
+
+		return mesh->SelectLod( ( scale * i_dataRequiredToRenderAFrame.lodErrorScale ) / distance,
+			s_maximumLodError_projected * i_dataRequiredToRenderAFrame.lodBias );
+	}
+}
@@ -27,6 +27,12 @@ namespace eae6320
 	{
 		struct sRenderCommand;
 	}
+#ifdef EAE6320_GRAPHICS_ISSUBMISSIONTESTENABLED
+	namespace Concurrency
+	{
+		class cJobSystem;
+	}
+#endif
 }
 
 namespace eae6320
@@ -43,17 +49,34 @@ namespace eae6320
 		// of how the application submits the total elapsed times
 		// for the frame currently being submitted
 		void SubmitElapsedTime( const float i_elapsedSecondCount_systemTime, const float i_elapsedSecondCount_simulationTime );
+		// This is also called automatically with the system time when the application read the input for the frame
+		// (it is used to measure how long it takes for input to be shown on the screen)
+		void SubmitInputTime( const uint64_t i_tickCount_systemTime );
 
 		void SubmitClearColor( const float i_clearColor[4] );
 
-		void SubmitRenderCommands( const sRenderCommand* i_renderCommands, const uint16_t i_commandNums );
+		// The commands are copied (the renderer takes its own references to their meshes),
+		// and so the caller is still responsible for cleaning up the commands that it passes in.
+		// Unlike the other submission functions this can be called from any thread (e.g. from jobs that each handle part of a scene)
+		// and from many threads at the same time:
+		// Every thread submits to its own bucket without locking,
+		// but every call must have finished before SignalThatAllDataForAFrameHasBeenSubmitted() is called
+		void SubmitRenderCommands( const sRenderCommand* i_renderCommands, const uint32_t i_commandCount );
 
-		void SubmitCamera( const eae6320::Math::cMatrix_transformation& i_g_transform_worldToCamera, const eae6320::Math::cMatrix_transformation& i_g_transform_cameraToProjected, const eae6320::Math::sVector& i_g_camera_position );
+		// The vertical field of view is used to choose each mesh's level of detail
+		void SubmitCamera( const eae6320::Math::cMatrix_transformation& i_g_transform_worldToCamera, const eae6320::Math::cMatrix_transformation& i_g_transform_cameraToProjected, const eae6320::Math::sVector& i_g_camera_position,
+			const float i_verticalFieldOfView_inRadians );
+
+		// Meshes switch to a lower level of detail when the difference would cover less than a pixel or so;
+		// a bias greater than 1 switches sooner (trading quality for speed) and a bias less than 1 switches later
+		void SetLodBias( const float i_lodBias );
 
 		// When the application is ready to submit data for a new frame
 		// it should call this before submitting anything
 		// (or, said another way, it is not safe to submit data for a new frame
-		// until this function returns successfully)
+		// until this function returns successfully).
+		// The application can get ahead of the render thread by up to sInitializationParameters::framePacketCount - 1 frames,
+		// and this waits if it is already that far ahead
 		cResult WaitUntilDataForANewFrameCanBeSubmitted( const unsigned int i_timeToWait_inMilliseconds );
 		// When the application has finished submitting data for a frame
 		// it must call this function
@@ -67,11 +90,33 @@ namespace eae6320
 		// (i.e. as soon as SignalThatAllDataForAFrameHasBeenSubmitted() has been called)
 		void RenderFrame();
 
+#ifdef EAE6320_GRAPHICS_ISSUBMISSIONTESTENABLED
+		// Test
+		//-----
+
+		// This must be called from the main/render thread before the application loop thread has started
+		// (it submits and renders frames itself).
+		// It fills every frame packet with more render commands for the mesh than a 16-bit reference count could hold
+		// and asserts (and writes to the log) if the mesh's reference count grows with the number of commands
+		// or doesn't come back to where it started after the frames have been rendered
+		void RunSubmissionTest( class cMesh& i_mesh );
+		// This has the same restrictions as the test above.
+		// It submits the same frame of render commands for the mesh twice,
+		// once from the calling thread and once from jobs that are spread across the job system's threads,
+		// and asserts (and writes to the log) if the sorted commands aren't in the same order both times
+		void RunJobSubmissionTest( class cMesh& i_mesh, Concurrency::cJobSystem& i_jobSystem );
+#endif
+
 		// Initialize / Clean Up
 		//----------------------
 
 		struct sInitializationParameters
 		{
+			// The number of frames whose data can exist at the same time (between 2 and 4):
+			// Two means that the application can submit one frame while the previous one is being rendered,
+			// and more lets the application get further ahead
+			// (which keeps a spike on one thread from stalling the other but adds a frame of input latency for each one)
+			unsigned int framePacketCount = 2;
 #if defined( EAE6320_PLATFORM_WINDOWS )
 			HWND mainWindow = NULL;
 	#if defined( EAE6320_PLATFORM_D3D )
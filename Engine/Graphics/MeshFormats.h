@@ -0,0 +1,165 @@
+/*
+	This file defines the layout of built mesh files
+
+	A built mesh starts with a header and a table of sections.
+	Every section starts at an aligned offset
+	so that vertex and index data can be used directly from a read-only mapping of the file
+	(see Platform::MapFileReadOnly()),
+	and a loader can go straight to the sections that it needs
+	and ignore any that it doesn't know about
+*/
+
+#ifndef EAE6320_GRAPHICS_MESHFORMATS_H
+#define EAE6320_GRAPHICS_MESHFORMATS_H
+
+// Includes
+//=========
+
+#include <cstddef>
+#include <cstdint>
+
+// Format Definitions
+//===================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace MeshFormats
+		{
+			enum class eSection : uint32_t
+			{
+				// The vertex array (sHeader::vertexCount vertices of sHeader::vertexSize bytes each)
+				Vertices,
+				// The index array (sHeader::indexCount indices of sHeader::indexSize bytes each)
+				Indices,
+				// An sSubmesh for every material
+				Submeshes,
+				// An sBounds that contains every vertex
+				Bounds,
+				// The serialized materials (see cMaterial::Load())
+				Materials,
+				// An sLod for every level of detail after the first,
+				// followed by the sSubmeshes of each of them (in the same order as the Submeshes section)
+				// (their indices come after the full detail ones in the index array)
+				Lods,
+				// An sBounds for every submesh (of the full detail mesh)
+				SubmeshBounds,
+				// An sOccluder followed by its positions and indices
+				// (the count is zero unless the mesh was built as an occluder)
+				Occluder,
+				// An sMeshlet for every meshlet of the full detail mesh,
+				// in the order of the submeshes and then of their indices
+				// (every submesh's index range is split exactly into consecutive meshlets)
+				Meshlets,
+			};
+
+			struct sHeader
+			{
+				static constexpr uint32_t s_fourCc = 0x48534d45;	// "EMSH"
+				// This must be incremented whenever the layout of any section changes
+				// so that stale files are rejected instead of misinterpreted
+				static constexpr uint16_t s_version = 5;
+
+				uint32_t fourCc = s_fourCc;
+				uint16_t version = s_version;
+				uint16_t vertexSize = 0;
+				// 2 or 4
+				uint8_t indexSize = 0;
+				uint8_t sectionCount = 0;
+				uint16_t padding = 0;
+				uint32_t vertexCount = 0;
+				uint32_t indexCount = 0;
+				// The checksum of everything after the section table
+				uint32_t checksum = 0;
+			};
+			// The header is immediately followed by sHeader::sectionCount sections
+
+			struct sSection
+			{
+				eSection type = eSection::Vertices;
+				// The number of elements (e.g. vertices or materials)
+				uint32_t count = 0;
+				// The offset from the beginning of the file (always a multiple of dataAlignment)
+				uint32_t offset = 0;
+				uint32_t size = 0;
+			};
+
+			// The part of the mesh that is drawn with one material
+			struct sSubmesh
+			{
+				uint32_t firstIndex = 0;
+				uint32_t indexCount = 0;
+				uint32_t firstVertex = 0;
+				uint32_t vertexCount = 0;
+			};
+
+			struct sLod
+			{
+				// How far the simplified surface is from the original one (in model space)
+				float error = 0.0f;
+			};
+			// The full detail mesh is level 0
+			constexpr uint8_t maxLodCount = 8;
+
+			// A box and a sphere that contain the same vertices
+			// (whichever is tighter can be tested)
+			struct sBounds
+			{
+				float minimum[3] = {};
+				float maximum[3] = {};
+				float center[3] = {};
+				float radius = 0.0f;
+			};
+
+			// The simplified geometry that the occlusion culler draws,
+			// which is followed by vertexCount positions (three floats each, in model space)
+			// and then indexCount 32-bit indices.
+			// Front faces are clockwise on every platform
+			struct sOccluder
+			{
+				uint32_t vertexCount = 0;
+				uint32_t indexCount = 0;
+			};
+
+			// A small cluster of neighboring triangles that can be culled on its own
+			struct sMeshlet
+			{
+				uint32_t firstIndex = 0;
+				uint32_t indexCount = 0;
+				// The sphere around the meshlet's vertices (in model space)
+				float center[3] = {};
+				float radius = 0.0f;
+				// Every triangle's (front-facing) normal is within the cone around the axis,
+				// and so the whole meshlet faces away from a camera at position p if
+				//	dot( center - p, coneAxis ) >= ( coneCutoff * ( length( center - p ) + radius ) ) + radius
+				// (a cutoff of 1 means that the meshlet is never back-facing)
+				float coneAxis[3] = {};
+				float coneCutoff = 1.0f;
+			};
+			constexpr unsigned int maxMeshletVertexCount = 64;
+			constexpr unsigned int maxMeshletTriangleCount = 124;
+
+			constexpr size_t dataAlignment = 16;
+
+			constexpr size_t GetAlignedOffset( const size_t i_offset )
+			{
+				return ( i_offset + ( dataAlignment - 1 ) ) & ~( dataAlignment - 1 );
+			}
+
+			// FNV-1a
+			inline uint32_t CalculateChecksum( const void* const i_data, const size_t i_size )
+			{
+				auto checksum = 0x811c9dc5u;
+				const auto* const bytes = static_cast<const uint8_t*>( i_data );
+				for ( size_t i = 0; i < i_size; ++i )
+				{
+					checksum = ( checksum ^ bytes[i] ) * 0x01000193u;
+				}
+				return checksum;
+			}
+		}
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_MESHFORMATS_H
@@ -3,9 +3,12 @@
 
 #include "../cConstantBuffer.h"
 
+#include "../sStateCache.h"
+
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Logging/Logging.h>
 #include <Engine/Math/Functions.h>
+#include <algorithm>
 
 // Interface
 //==========
@@ -19,13 +22,13 @@ void eae6320::Graphics::cConstantBuffer::Bind( const uint_fast8_t ) const
 
 	// OpenGL doesn't have a way to only bind the constant buffer to specific shader types,
 	// and so the input parameter isn't used
-	glBindBufferBase( GL_UNIFORM_BUFFER, static_cast<GLuint>( m_type ), m_bufferId );
-	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	sStateCache::g_stateCache.BindConstantBuffer( static_cast<GLuint>( m_type ), m_bufferId );
 }
 
 void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data )
 {
 	EAE6320_ASSERT( m_bufferId != 0 );
+	EAE6320_ASSERTF( m_ringBlockStride == 0, "A dynamic ring must be written with MapRing()" );
 
 	// Make the uniform buffer active
 	{
@@ -40,6 +43,101 @@ void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data )
 	}
 }
 
+// Dynamic Ring
+//-------------
+
+void* eae6320::Graphics::cConstantBuffer::MapRing( const uint32_t i_blockCount )
+{
+	EAE6320_ASSERT( m_bufferId != 0 );
+	EAE6320_ASSERTF( m_ringBlockStride > 0, "The constant buffer wasn't initialized as a dynamic ring" );
+
+	if ( i_blockCount == 0 )
+	{
+		return nullptr;
+	}
+
+	// Grow the ring if this frame needs more blocks than a segment can hold
+	if ( i_blockCount > m_ringBlockCountPerFrame )
+	{
+		const auto blockCountPerFrame_previous = m_ringBlockCountPerFrame;
+		m_ringBlockCountPerFrame = std::max( i_blockCount, m_ringBlockCountPerFrame * 2 );
+		// The storage is immutable and so growing replaces the whole buffer
+		// (OpenGL keeps the old buffer alive until the GPU is done with it),
+		// and so the fences for the old segments aren't needed anymore
+		for ( auto& fence : m_ringFences )
+		{
+			if ( fence )
+			{
+				glDeleteSync( fence );
+				fence = nullptr;
+			}
+		}
+		m_ringFrameIndex = 0;
+		if ( !AllocateRing_platformSpecific() )
+		{
+			m_ringBlockCountPerFrame = blockCountPerFrame_previous;
+			return nullptr;
+		}
+		Logging::OutputMessage( "The dynamic ring for constant buffer %u grew to %u blocks per frame",
+			static_cast<unsigned int>( m_type ), m_ringBlockCountPerFrame );
+	}
+	// Wait until the GPU has finished reading the segment that is about to be overwritten
+	// (this only happens if the CPU is more than s_ringFrameCount frames ahead)
+	{
+		auto& fence = m_ringFences[m_ringFrameIndex];
+		if ( fence )
+		{
+			constexpr GLuint64 timeout_nanoseconds = 1000000000;
+			auto waitResult = glClientWaitSync( fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout_nanoseconds );
+			while ( waitResult == GL_TIMEOUT_EXPIRED )
+			{
+				waitResult = glClientWaitSync( fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout_nanoseconds );
+			}
+			EAE6320_ASSERTF( waitResult != GL_WAIT_FAILED, "Waiting for a constant buffer fence failed" );
+			glDeleteSync( fence );
+			fence = nullptr;
+		}
+	}
+	// The whole ring stays mapped,
+	// and the fence guarantees that the GPU isn't using this frame's segment
+	EAE6320_ASSERT( m_ringMappedMemory != nullptr );
+	const auto segmentSize = m_ringBlockStride * m_ringBlockCountPerFrame;
+	return static_cast<uint8_t*>( m_ringMappedMemory ) + ( segmentSize * m_ringFrameIndex );
+}
+
+void eae6320::Graphics::cConstantBuffer::UnmapRing()
+{
+	EAE6320_ASSERT( m_bufferId != 0 );
+
+	// The mapping is coherent,
+	// and so the blocks that were written are visible to every draw call that is issued after this
+	// without unmapping or flushing anything
+	EAE6320_ASSERT( m_ringMappedMemory != nullptr );
+}
+
+void eae6320::Graphics::cConstantBuffer::BindRange( const uint_fast8_t, const uint32_t i_blockIndex ) const
+{
+	EAE6320_ASSERT( m_bufferId != 0 );
+	EAE6320_ASSERT( i_blockIndex < m_ringBlockCountPerFrame );
+
+	const auto segmentSize = m_ringBlockStride * m_ringBlockCountPerFrame;
+	const auto offset = ( segmentSize * m_ringFrameIndex ) + ( m_ringBlockStride * i_blockIndex );
+	sStateCache::g_stateCache.BindConstantBuffer( static_cast<GLuint>( m_type ), m_bufferId,
+		static_cast<GLintptr>( offset ), static_cast<GLsizeiptr>( m_size ) );
+}
+
+void eae6320::Graphics::cConstantBuffer::EndRingFrame()
+{
+	EAE6320_ASSERT( m_ringFences[m_ringFrameIndex] == nullptr );
+
+	// The fence is signaled once the GPU has executed every command issued so far
+	// (including all of this frame's draw calls that read from the segment)
+	constexpr GLbitfield noFlags = 0;
+	m_ringFences[m_ringFrameIndex] = glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, noFlags );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	m_ringFrameIndex = ( m_ringFrameIndex + 1 ) % s_ringFrameCount;
+}
+
 // Initialize / Clean Up
 //----------------------
 
@@ -47,8 +145,18 @@ eae6320::cResult eae6320::Graphics::cConstantBuffer::CleanUp()
 {
 	auto result = Results::Success;
 
+	for ( auto& fence : m_ringFences )
+	{
+		if ( fence )
+		{
+			glDeleteSync( fence );
+			fence = nullptr;
+		}
+	}
 	if ( m_bufferId != 0 )
 	{
+		// Deleting a buffer also unmaps it
+		m_ringMappedMemory = nullptr;
 		constexpr GLsizei bufferCount = 1;
 		glDeleteBuffers( bufferCount, &m_bufferId );
 		const auto errorCode = glGetError();
@@ -120,3 +228,96 @@ eae6320::cResult eae6320::Graphics::cConstantBuffer::Initialize_platformSpecific
 
 	return result;
 }
+
+eae6320::cResult eae6320::Graphics::cConstantBuffer::InitializeRing_platformSpecific()
+{
+	auto result = Results::Success;
+
+	// Every bound range must start at a multiple of the implementation's alignment
+	{
+		GLint alignment = 0;
+		glGetIntegerv( GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment );
+		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+		m_ringBlockStride = Math::RoundUpToMultiple( m_size, static_cast<size_t>( std::max( alignment, 1 ) ) );
+	}
+
+	return AllocateRing_platformSpecific();
+}
+
+eae6320::cResult eae6320::Graphics::cConstantBuffer::AllocateRing_platformSpecific()
+{
+	auto result = Results::Success;
+
+	// Immutable storage can't be re-specified,
+	// and so a ring that grows gets a new buffer
+	if ( m_bufferId != 0 )
+	{
+		m_ringMappedMemory = nullptr;
+		constexpr GLsizei bufferCount = 1;
+		glDeleteBuffers( bufferCount, &m_bufferId );
+		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+		m_bufferId = 0;
+		// The new buffer could be given the old ID,
+		// and so the cache mustn't think that it is still bound
+		sStateCache::g_stateCache.Invalidate();
+	}
+	// Create a uniform buffer object and make it active
+	{
+		constexpr GLsizei bufferCount = 1;
+		glGenBuffers( bufferCount, &m_bufferId );
+		const auto errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			eae6320::Logging::OutputError( "OpenGL failed to get an unused uniform buffer ID for a dynamic ring: %s",
+				reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			return result;
+		}
+	}
+	glBindBuffer( GL_UNIFORM_BUFFER, m_bufferId );
+	{
+		const auto errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			eae6320::Logging::OutputError( "OpenGL failed to bind the uniform buffer %u: %s",
+				m_bufferId, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			return result;
+		}
+	}
+	// Allocate one segment for each frame that can be in flight
+	// and keep it mapped for as long as the buffer exists
+	// (the fences in MapRing() are what keep the CPU from overwriting a segment that the GPU is reading)
+	constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	const auto size = m_ringBlockStride * m_ringBlockCountPerFrame * s_ringFrameCount;
+	{
+		glBufferStorage( GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>( size ), nullptr, flags );
+		const auto errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			eae6320::Logging::OutputError( "OpenGL failed to allocate %u bytes for the uniform buffer %u: %s",
+				static_cast<unsigned int>( size ), m_bufferId, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			return result;
+		}
+	}
+	{
+		constexpr GLintptr mapFromTheBeginning = 0;
+		m_ringMappedMemory = glMapBufferRange( GL_UNIFORM_BUFFER, mapFromTheBeginning, static_cast<GLsizeiptr>( size ), flags );
+		const auto errorCode = glGetError();
+		if ( ( errorCode != GL_NO_ERROR ) || !m_ringMappedMemory )
+		{
+			result = Results::Failure;
+			m_ringMappedMemory = nullptr;
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			eae6320::Logging::OutputError( "OpenGL failed to map the dynamic ring for the uniform buffer %u: %s",
+				m_bufferId, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			return result;
+		}
+	}
+
+	return result;
+}
@@ -3,11 +3,15 @@
 
 #include "../cEffect.h"
 #include "../cShader.h"
+#include "../sStateCache.h"
 
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Logging/Logging.h>
 #include <Engine/ScopeGuard/cScopeGuard.h>
 
+#include <algorithm>
+#include <cstring>
+
 // Implementation
 //===============
 
@@ -179,6 +183,108 @@ eae6320::cResult eae6320::Graphics::cEffect::InitializeShadingProgram()
 			return result;
 		}
 	}
+	// Find the shader parameters
+	if ( !( result = ReflectShaderParameters() ) )
+	{
+		return result;
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Graphics::cEffect::ReflectShaderParameters()
+{
+	auto result = eae6320::Results::Success;
+
+	EAE6320_ASSERT( m_parameters == nullptr );
+
+	GLint uniformCount = 0;
+	GLint maxNameLength = 0;
+	{
+		glGetProgramiv( m_programId, GL_ACTIVE_UNIFORMS, &uniformCount );
+		glGetProgramiv( m_programId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength );
+		const auto errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			result = eae6320::Results::Failure;
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			eae6320::Logging::OutputError( "OpenGL failed to get the active uniforms of the program: %s",
+				reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			return result;
+		}
+	}
+	if ( ( uniformCount <= 0 ) || ( maxNameLength <= 0 ) )
+	{
+		return result;
+	}
+
+	auto* const name = new ( std::nothrow ) GLchar[maxNameLength];
+	m_parameters = new ( std::nothrow ) sShaderParameter[uniformCount];
+	eae6320::cScopeGuard scopeGuard_name( [name]
+		{
+			delete[] name;
+		} );
+	if ( !name || !m_parameters )
+	{
+		result = eae6320::Results::OutOfMemory;
+		EAE6320_ASSERTF( false, "Couldn't allocate memory for the shader parameters" );
+		eae6320::Logging::OutputError( "Failed to allocate memory for the shader parameters" );
+		return result;
+	}
+
+	for ( GLint i = 0; i < uniformCount; ++i )
+	{
+		GLsizei nameLength = 0;
+		GLint arraySize = 0;
+		GLenum type = GL_NONE;
+		glGetActiveUniform( m_programId, static_cast<GLuint>( i ), static_cast<GLsizei>( maxNameLength ), &nameLength, &arraySize, &type, name );
+		const auto location = glGetUniformLocation( m_programId, name );
+		// Members of uniform blocks don't have a location
+		// (they are set with constant buffers instead)
+		if ( location < 0 )
+		{
+			continue;
+		}
+		// Arrays are reported with the name of their first element
+		{
+			auto* const arraySuffix = std::strstr( name, "[0]" );
+			if ( arraySuffix )
+			{
+				*arraySuffix = '\0';
+			}
+		}
+
+		auto& parameter = m_parameters[m_parameterCount++];
+		parameter.nameHash = HashShaderParameterName( name );
+		parameter.location = location;
+		parameter.textureUnit = -1;
+		if ( ( type == GL_SAMPLER_2D ) || ( type == GL_SAMPLER_3D ) || ( type == GL_SAMPLER_CUBE ) || ( type == GL_SAMPLER_2D_ARRAY ) )
+		{
+			// The unit is assigned by the shader
+			// (see DeclareSampler2D() in shaders.inc)
+			glGetUniformiv( m_programId, location, &parameter.textureUnit );
+		}
+	}
+	{
+		const auto errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			result = eae6320::Results::Failure;
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			eae6320::Logging::OutputError( "OpenGL failed to reflect the uniforms of the program: %s",
+				reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			return result;
+		}
+	}
+
+	std::sort( m_parameters, m_parameters + m_parameterCount,
+		[]( const sShaderParameter& i_lhs, const sShaderParameter& i_rhs ) { return i_lhs.nameHash < i_rhs.nameHash; } );
+#ifdef EAE6320_ASSERTS_AREENABLED
+	for ( uint16_t i = 1; i < m_parameterCount; ++i )
+	{
+		EAE6320_ASSERTF( m_parameters[i - 1].nameHash != m_parameters[i].nameHash, "Two shader parameters have the same name hash" );
+	}
+#endif
 
 	return result;
 }
@@ -187,6 +293,13 @@ eae6320::cResult eae6320::Graphics::cEffect::CleanUpShadingProgram()
 {
 	auto result = Results::Success;
 
+	if ( m_parameters )
+	{
+		delete[] m_parameters;
+		m_parameters = nullptr;
+		m_parameterCount = 0;
+	}
+
 	if ( m_programId != 0 )
 	{
 		glDeleteProgram( m_programId );
@@ -207,19 +320,23 @@ eae6320::cResult eae6320::Graphics::cEffect::CleanUpShadingProgram()
 	return result;
 }
 
+const eae6320::Graphics::cEffect::sShaderParameter* eae6320::Graphics::cEffect::FindParameter( const uint32_t i_nameHash ) const
+{
+	const sShaderParameter* const parameters_begin = m_parameters;
+	const auto* const parameters_end = parameters_begin + m_parameterCount;
+	const auto* const parameter = std::lower_bound( parameters_begin, parameters_end, i_nameHash,
+		[]( const sShaderParameter& i_parameter, const uint32_t i_nameHash ) { return i_parameter.nameHash < i_nameHash; } );
+	return ( ( parameter != parameters_end ) && ( parameter->nameHash == i_nameHash ) ) ? parameter : nullptr;
+}
+
 void eae6320::Graphics::cEffect::Bind()
 {
 	{
 		EAE6320_ASSERT( m_programId != 0 );
-		glUseProgram( m_programId );
-		if ( glGetError() != GL_NO_ERROR )
-		{
-			m_programId = 0;
-		}
-		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+		sStateCache::g_stateCache.BindProgram( m_programId );
 	}
 	// Render state
 	{
-		m_renderState.Bind();
+		sStateCache::g_stateCache.BindRenderState( m_renderState );
 	}
 }
\ No newline at end of file
@@ -0,0 +1,143 @@
+// Includes
+//=========
+
+#include "../cInstanceBuffer.h"
+
+#include "../VertexFormats.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+
+// Interface
+//==========
+
+// Update
+//-------
+
+eae6320::Graphics::VertexFormats::sInstance_mesh* eae6320::Graphics::cInstanceBuffer::Map()
+{
+	EAE6320_ASSERT( m_bufferId != 0 );
+
+	glBindBuffer( GL_ARRAY_BUFFER, m_bufferId );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+
+	// Invalidating the buffer lets the driver hand back new memory
+	// instead of waiting for draw calls from a previous frame that are still reading the old contents
+	constexpr GLintptr mapFromTheBeginning = 0;
+	constexpr GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT;
+	auto* const memoryToWriteTo = glMapBufferRange( GL_ARRAY_BUFFER, mapFromTheBeginning,
+		static_cast<GLsizeiptr>( sizeof( VertexFormats::sInstance_mesh ) * m_capacity ), access );
+	if ( !memoryToWriteTo )
+	{
+		const auto errorCode = glGetError();
+		EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+		Logging::OutputError( "OpenGL failed to map the instance buffer: %s",
+			reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+	}
+	return reinterpret_cast<VertexFormats::sInstance_mesh*>( memoryToWriteTo );
+}
+
+void eae6320::Graphics::cInstanceBuffer::Unmap()
+{
+	EAE6320_ASSERT( m_bufferId != 0 );
+
+	glBindBuffer( GL_ARRAY_BUFFER, m_bufferId );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	const auto wasDataPreserved = glUnmapBuffer( GL_ARRAY_BUFFER );
+	EAE6320_ASSERTF( wasDataPreserved == GL_TRUE, "The instance buffer's contents were lost while it was mapped" );
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cInstanceBuffer::CleanUp()
+{
+	auto result = Results::Success;
+
+	if ( m_bufferId != 0 )
+	{
+		constexpr GLsizei bufferCount = 1;
+		glDeleteBuffers( bufferCount, &m_bufferId );
+		const auto errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			Logging::OutputError( "OpenGL failed to delete the instance buffer: %s",
+				reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+		}
+		m_bufferId = 0;
+	}
+
+	return result;
+}
+
+// Implementation
+//===============
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cInstanceBuffer::Initialize_platformSpecific()
+{
+	auto result = Results::Success;
+
+	// Create a vertex buffer object and make it active
+	{
+		constexpr GLsizei bufferCount = 1;
+		glGenBuffers( bufferCount, &m_bufferId );
+		const auto errorCode = glGetError();
+		if ( errorCode == GL_NO_ERROR )
+		{
+			glBindBuffer( GL_ARRAY_BUFFER, m_bufferId );
+			const auto errorCode = glGetError();
+			if ( errorCode != GL_NO_ERROR )
+			{
+				result = Results::Failure;
+				EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+				Logging::OutputError( "OpenGL failed to bind the new instance buffer %u: %s",
+					m_bufferId, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+				return result;
+			}
+		}
+		else
+		{
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			Logging::OutputError( "OpenGL failed to get an unused instance buffer ID: %s",
+				reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			return result;
+		}
+	}
+
+	return Allocate_platformSpecific();
+}
+
+eae6320::cResult eae6320::Graphics::cInstanceBuffer::Allocate_platformSpecific()
+{
+	auto result = Results::Success;
+
+	EAE6320_ASSERT( m_bufferId != 0 );
+	glBindBuffer( GL_ARRAY_BUFFER, m_bufferId );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+
+	// Allocate space for the instance data
+	// (the buffer ID stays the same when it is reallocated,
+	// and so vertex arrays that have recorded it don't need to be updated)
+	{
+		constexpr GLenum usage = GL_DYNAMIC_DRAW;	// The buffer will be rewritten every frame and used to draw
+		glBufferData( GL_ARRAY_BUFFER, static_cast<GLsizeiptr>( sizeof( VertexFormats::sInstance_mesh ) * m_capacity ),
+			nullptr, usage );
+		const auto errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			Logging::OutputError( "OpenGL failed to allocate the new instance buffer %u: %s",
+				m_bufferId, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			return result;
+		}
+	}
+
+	return result;
+}
@@ -2,14 +2,15 @@
 //=========
 
 #include "../cMesh.h"
+#include "../cInstanceBuffer.h"
 #include "../cMaterial.h"
+#include "../sStateCache.h"
 
 #include "../VertexFormats.h"
 
 #include <cstdlib>
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Logging/Logging.h>
-#include <Engine/ScopeGuard/cScopeGuard.h>
 #include <new>
 
 // Implementation
@@ -126,15 +127,16 @@ eae6320::cResult eae6320::Graphics::cMesh::Initialize( const VertexFormats::sVer
 		// The "stride" defines how large a single vertex is in the stream of data
 		// (or, said another way, how far apart each position element is)
 		constexpr auto stride = static_cast<GLsizei>( sizeof(eae6320::Graphics::VertexFormats::sVertex_mesh ) );
+		// The integers are converted to floats between 0 and 1 (or -1 and 1 if they are signed)
+		constexpr GLboolean normalized = GL_TRUE;
 
 		// Position (0)
-		// 3 floats == 12 bytes
+		// 3 uint16_ts == 6 bytes
 		// Offset = 0
 		{
 			constexpr GLuint vertexElementLocation = 0;
 			constexpr GLint elementCount = 3;
-			constexpr GLboolean notNormalized = GL_FALSE;	// The given floats should be used as-is
-			glVertexAttribPointer( vertexElementLocation, elementCount, GL_FLOAT, notNormalized, stride,
+			glVertexAttribPointer( vertexElementLocation, elementCount, GL_UNSIGNED_SHORT, normalized, stride,
 				reinterpret_cast<GLvoid*>( offsetof( eae6320::Graphics::VertexFormats::sVertex_mesh, x ) ) );
 			const auto errorCode = glGetError();
 			if ( errorCode == GL_NO_ERROR )
@@ -145,7 +147,7 @@ eae6320::cResult eae6320::Graphics::cMesh::Initialize( const VertexFormats::sVer
 				{
 					result = eae6320::Results::Failure;
 					EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
-					eae6320::Logging::OutputError("OpenGL failed to enable the POSITION vertex attribute at location %u: %s",
+					eae6320::Logging::OutputError( "OpenGL failed to enable the POSITION vertex attribute at location %u: %s",
 						vertexElementLocation, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
 					return result;
 				}
@@ -160,13 +162,13 @@ eae6320::cResult eae6320::Graphics::cMesh::Initialize( const VertexFormats::sVer
 			}
 		}
 
-		// Normal (1)
+		// Tangent Frame (1)
+		// 4 int16_ts == 8 bytes
 		{
 			constexpr GLuint vertexElementLocation = 1;
-			constexpr GLint elementCount = 3;
-
-			glVertexAttribPointer( vertexElementLocation, elementCount, GL_FLOAT, GL_FALSE, stride,
-				reinterpret_cast<GLvoid*>( offsetof( eae6320::Graphics::VertexFormats::sVertex_mesh, nx ) ) );
+			constexpr GLint elementCount = 4;
+			glVertexAttribPointer( vertexElementLocation, elementCount, GL_SHORT, normalized, stride,
+				reinterpret_cast<GLvoid*>( offsetof( eae6320::Graphics::VertexFormats::sVertex_mesh, qx ) ) );
 			const auto errorCode = glGetError();
 			if ( errorCode == GL_NO_ERROR )
 			{
@@ -176,7 +178,7 @@ eae6320::cResult eae6320::Graphics::cMesh::Initialize( const VertexFormats::sVer
 				{
 					result = eae6320::Results::Failure;
 					EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
-					eae6320::Logging::OutputError( "OpenGL failed to enable the NORMAL vertex attribute at location %u: %s",
+					eae6320::Logging::OutputError( "OpenGL failed to enable the TANGENT_FRAME vertex attribute at location %u: %s",
 						vertexElementLocation, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
 					return result;
 				}
@@ -185,51 +187,19 @@ eae6320::cResult eae6320::Graphics::cMesh::Initialize( const VertexFormats::sVer
 			{
 				result = eae6320::Results::Failure;
 				EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
-				eae6320::Logging::OutputError( "OpenGL failed to set the NORMAL vertex attribute at location %u: %s",
+				eae6320::Logging::OutputError( "OpenGL failed to set the TANGENT_FRAME vertex attribute at location %u: %s",
 					vertexElementLocation, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
 				return result;
 			}
 		}
 
-		// Tangent (2)
+		// UV (2)
+		// 2 halfs == 4 bytes
 		{
 			constexpr GLuint vertexElementLocation = 2;
-			constexpr GLint elementCount = 3;
-
-			glVertexAttribPointer( vertexElementLocation, elementCount, GL_FLOAT, GL_FALSE, stride,
-				reinterpret_cast<GLvoid*>( offsetof( eae6320::Graphics::VertexFormats::sVertex_mesh, tx ) ) );
-			const auto errorCode = glGetError();
-			if ( errorCode == GL_NO_ERROR )
-			{
-				glEnableVertexAttribArray( vertexElementLocation );
-				const GLenum errorCode = glGetError();
-				if ( errorCode != GL_NO_ERROR )
-				{
-					result = eae6320::Results::Failure;
-					EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
-					eae6320::Logging::OutputError( "OpenGL failed to enable the TANGENT vertex attribute at location %u: %s",
-						vertexElementLocation, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
-					return result;
-				}
-			}
-			else
-			{
-				result = eae6320::Results::Failure;
-				EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
-				eae6320::Logging::OutputError( "OpenGL failed to set the TANGENT vertex attribute at location %u: %s",
-					vertexElementLocation, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
-				return result;
-			}
-		}
-
-		// BiTangent
-
-		// UV (3)
-		{
-			constexpr GLuint vertexElementLocation = 3;
 			constexpr GLint elementCount = 2;
-
-			glVertexAttribPointer( vertexElementLocation, elementCount, GL_FLOAT, GL_FALSE, stride,
+			constexpr GLboolean notNormalized = GL_FALSE;	// The given floats should be used as-is
+			glVertexAttribPointer( vertexElementLocation, elementCount, GL_HALF_FLOAT, notNormalized, stride,
 				reinterpret_cast<GLvoid*>( offsetof( eae6320::Graphics::VertexFormats::sVertex_mesh, u ) ) );
 			const auto errorCode = glGetError();
 			if ( errorCode == GL_NO_ERROR )
@@ -255,12 +225,12 @@ eae6320::cResult eae6320::Graphics::cMesh::Initialize( const VertexFormats::sVer
 			}
 		}
 
-		// Color (4)
+		// Color (3)
+		// 4 uint8_ts == 4 bytes
 		{
-			constexpr GLuint vertexElementLocation = 4;
+			constexpr GLuint vertexElementLocation = 3;
 			constexpr GLint elementCount = 4;
-			//constexpr GLboolean notNormalized = GL_FALSE;	// The given floats should be used as-is
-			glVertexAttribPointer( vertexElementLocation, elementCount, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+			glVertexAttribPointer( vertexElementLocation, elementCount, GL_UNSIGNED_BYTE, normalized, stride,
 				reinterpret_cast<GLvoid*>( offsetof( eae6320::Graphics::VertexFormats::sVertex_mesh, r ) ) );
 			const auto errorCode = glGetError();
 			if ( errorCode == GL_NO_ERROR )
@@ -270,7 +240,7 @@ eae6320::cResult eae6320::Graphics::cMesh::Initialize( const VertexFormats::sVer
 				if ( errorCode != GL_NO_ERROR )
 				{
 					result = eae6320::Results::Failure;
-					EAE6320_ASSERTF(false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+					EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
 					eae6320::Logging::OutputError( "OpenGL failed to enable the COLOR vertex attribute at location %u: %s",
 						vertexElementLocation, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
 					return result;
@@ -288,49 +258,15 @@ eae6320::cResult eae6320::Graphics::cMesh::Initialize( const VertexFormats::sVer
 	}
 	// Assign the data to the element buffer
 	{
-		// const uint16_t* i_indices
-		// re-arrange indices order
+		// The mesh builder already swapped the winding order for OpenGL
+		// and so the indices can be uploaded straight from the mesh file
 		constexpr unsigned int vertexCountPerTriangle = 3;
-		const auto indiceCnt = i_triangleCount * vertexCountPerTriangle;
-		void* indices;
-
-		bool is32 = false;
-		
-		if ( indiceCnt > std::numeric_limits<uint16_t>::max())
-		{
-			indices = new (std::nothrow) uint32_t[indiceCnt];
-			is32 = true;
-		}
-		else
-		{
-			indices = new (std::nothrow) uint16_t[indiceCnt];
-		}
-
-		auto dataSize = is32 ? sizeof(uint32_t) : sizeof(uint16_t);
-
-		if( indices )
-		{ 
-			auto dst = reinterpret_cast<uintptr_t>( indices );
-			auto src = reinterpret_cast<uintptr_t>( i_indices );
-
-			for ( size_t i = 0; i < indiceCnt; i += vertexCountPerTriangle)
-			{
-				memcpy(reinterpret_cast<void*>(dst + i * dataSize), reinterpret_cast<void*>(src + i * dataSize), dataSize);
-				memcpy(reinterpret_cast<void*>(dst + ( i + 2 ) * dataSize), reinterpret_cast<void*>(src + ( i + 1 ) * dataSize), dataSize);
-				memcpy(reinterpret_cast<void*>(dst + ( i + 1 ) * dataSize), reinterpret_cast<void*>(src + ( i + 2 ) * dataSize), dataSize);	
-			}
-		}
-
-		// Safely clear dynamic memory
-		cScopeGuard scopeGuard( [indices]
-		{
-			delete[] indices;
-		});
+		const auto is32 = ( i_triangleCount * vertexCountPerTriangle ) > std::numeric_limits<uint16_t>::max();
 
 		const int bufferSize = ( is32 ? sizeof( uint32_t ) : sizeof( uint16_t ) ) * i_triangleCount * vertexCountPerTriangle;
 		EAE6320_ASSERT( bufferSize <= std::numeric_limits<GLsizeiptr>::max() );
 
-		glBufferData( GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>( bufferSize ), reinterpret_cast<GLvoid*>( indices ),
+		glBufferData( GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>( bufferSize ), i_indices,
 			GL_STATIC_DRAW);
 		const auto errorCode = glGetError();
 		if ( errorCode != GL_NO_ERROR )
@@ -438,53 +374,88 @@ eae6320::cResult eae6320::Graphics::cMesh::CleanUp()
 		delete[] m_materials;
 	}
 
+	delete[] m_submeshes;
+	m_submeshes = nullptr;
+	delete[] m_submeshBounds;
+	m_submeshBounds = nullptr;
+	delete[] m_occluder.positions;
+	delete[] m_occluder.indices;
+	m_occluder = sOccluder();
+	delete[] m_meshlets;
+	m_meshlets = nullptr;
+	delete[] m_submeshMeshletRanges;
+	m_submeshMeshletRanges = nullptr;
+	m_meshletCount = 0;
+
 	return result;
 }
 
-void eae6320::Graphics::cMesh::Draw()
+// Render
+//-------
+
+eae6320::cResult eae6320::Graphics::cMesh::BindGeometry( const cInstanceBuffer& i_instanceBuffer )
 {
-	// Draw the geometry
+	// Bind a specific vertex buffer to the device as a data source
+	{
+		EAE6320_ASSERT( m_vertexArrayId != 0 );
+		sStateCache::g_stateCache.BindVertexArray( m_vertexArrayId );
+	}
+	// Record the per-instance attributes in the vertex array
+	// (this only has to happen the first time a mesh is drawn with a given instance buffer)
+	if ( m_instanceBufferId != i_instanceBuffer.GetBufferId() )
 	{
-		// Bind a specific vertex buffer to the device as a data source
+		glBindBuffer( GL_ARRAY_BUFFER, i_instanceBuffer.GetBufferId() );
+		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+
+		// The local-to-world transform takes the four locations after the per-vertex attributes (4-7),
+		// one for each column
+		constexpr GLuint firstVertexElementLocation = 4;
+		constexpr GLint elementCount = 4;
+		constexpr auto stride = static_cast<GLsizei>( sizeof( VertexFormats::sInstance_mesh ) );
+		constexpr GLuint advanceOncePerInstance = 1;
+		for ( GLuint i = 0; i < 4; ++i )
 		{
-			EAE6320_ASSERT( m_vertexArrayId != 0 );
-			glBindVertexArray( m_vertexArrayId );
-			EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+			const auto vertexElementLocation = firstVertexElementLocation + i;
+			glVertexAttribPointer( vertexElementLocation, elementCount, GL_FLOAT, GL_FALSE, stride,
+				reinterpret_cast<GLvoid*>( i * elementCount * sizeof( float ) ) );
+			glEnableVertexAttribArray( vertexElementLocation );
+			glVertexAttribDivisor( vertexElementLocation, advanceOncePerInstance );
 		}
-		// Render triangles from the currently-bound vertex buffer
+		const auto errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
 		{
-			// The mode defines how to interpret multiple vertices as a single "primitive";
-			// a triangle list is defined
-			// (meaning that every primitive is a triangle and will be defined by three vertices)
-			constexpr GLenum mode = GL_TRIANGLES;
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			Logging::OutputError( "OpenGL failed to set the INSTANCE_TRANSFORM vertex attributes: %s",
+				reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			return Results::Failure;
+		}
+		m_instanceBufferId = i_instanceBuffer.GetBufferId();
+	}
 
-			// It's possible to start rendering primitives in the middle of the stream
-			const GLvoid* const offset = 0;
-			constexpr unsigned int vertexCountPerTriangle = 3;
+	return Results::Success;
+}
 
-			const auto indexCountToRender = m_triangleCount * vertexCountPerTriangle;
-			bool is32 = indexCountToRender > std::numeric_limits<uint16_t>::max() ? true : false;
+void eae6320::Graphics::cMesh::DrawIndices( const uint32_t i_firstIndex, const uint32_t i_indexCount, const uint32_t i_firstInstance, const uint32_t i_instanceCount )
+{
+	// Render triangles from the currently-bound vertex buffer
+	{
+		// The mode defines how to interpret multiple vertices as a single "primitive";
+		// a triangle list is defined
+		// (meaning that every primitive is a triangle and will be defined by three vertices)
+		constexpr GLenum mode = GL_TRIANGLES;
 
-			if ( m_materialsCount > 0 )
-			{
-				for ( auto i = 0; i < m_materialsCount; ++i )
-				{
-					m_materials[i]->Bind();
-					uint32_t elementsCount = m_materials[i]->m_indexRange.last - m_materials[i]->m_indexRange.first + 1;
-					size_t elementSize = is32 ? sizeof(uint32_t) : sizeof(uint16_t);
-					glDrawElements( mode, elementsCount, is32 ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, reinterpret_cast<GLvoid*>( m_materials[i]->m_indexRange.first * elementSize ) );
-				}
-			}
-			else
-			{ 
-				if ( is32 )
-					glDrawElements( mode, m_triangleCount * vertexCountPerTriangle, GL_UNSIGNED_INT, offset );
-				else
-					glDrawElements( mode, m_triangleCount * vertexCountPerTriangle, GL_UNSIGNED_SHORT, offset );
-			}
+		constexpr unsigned int vertexCountPerTriangle = 3;
 
-			const auto errorCode = glGetError();
-			EAE6320_ASSERT( errorCode == GL_NO_ERROR );
-		}
+		// The index size depends on every level of detail's indices
+		const auto indexCount_total = m_triangleCount * vertexCountPerTriangle;
+		bool is32 = indexCount_total > std::numeric_limits<uint16_t>::max() ? true : false;
+		const auto indexType = is32 ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+		const size_t indexSize = is32 ? sizeof( uint32_t ) : sizeof( uint16_t );
+
+		glDrawElementsInstancedBaseInstance( mode, static_cast<GLsizei>( i_indexCount ), indexType,
+			reinterpret_cast<GLvoid*>( i_firstIndex * indexSize ), static_cast<GLsizei>( i_instanceCount ), i_firstInstance );
+
+		const auto errorCode = glGetError();
+		EAE6320_ASSERT( errorCode == GL_NO_ERROR );
 	}
 }
\ No newline at end of file
@@ -0,0 +1,175 @@
+// Includes
+//=========
+
+#include "../cTexture.h"
+#include "../sStateCache.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+
+// Interface
+//==========
+
+// Render
+//-------
+
+void eae6320::Graphics::cTexture::Bind( const unsigned int i_unit ) const
+{
+	EAE6320_ASSERT( m_textureId != 0 );
+	sStateCache::g_stateCache.BindTexture( static_cast<GLuint>( i_unit ), m_textureId );
+}
+
+// Implementation
+//===============
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Graphics::cTexture::Initialize( const std::string& i_path, const uint8_t* const i_data,
+	const unsigned int i_width, const unsigned int i_height, const unsigned int i_componentCount )
+{
+	auto result = Results::Success;
+
+	GLenum format = GL_RED;
+	if ( i_componentCount == 3 )
+	{
+		format = GL_RGB;
+	}
+	else if ( i_componentCount == 4 )
+	{
+		format = GL_RGBA;
+	}
+
+	glGenTextures( 1, &m_textureId );
+	if ( m_textureId == 0 )
+	{
+		result = Results::Failure;
+		EAE6320_ASSERTF( false, "Generate texture failed!" );
+		Logging::OutputError( "OpenGL failed to generate a texture for %s", i_path.c_str() );
+		return result;
+	}
+
+	// Binding the texture here bypasses the state cache
+	// (which is invalidated at the start of every frame)
+	glBindTexture( GL_TEXTURE_2D, m_textureId );
+	glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+	glTexImage2D( GL_TEXTURE_2D, 0, format, static_cast<GLsizei>( i_width ), static_cast<GLsizei>( i_height ), 0, format, GL_UNSIGNED_BYTE, i_data );
+	glGenerateMipmap( GL_TEXTURE_2D );
+
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
+
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+
+	{
+		const auto errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			Logging::OutputError( "OpenGL failed to upload the texture %s: %s",
+				i_path.c_str(), reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			return result;
+		}
+	}
+
+	// A full mip chain adds a third to the size of the top level
+	const auto topLevelSize = static_cast<uint64_t>( i_width ) * i_height * i_componentCount;
+	m_memorySize = topLevelSize + ( topLevelSize / 3 );
+
+	return result;
+}
+
+eae6320::cResult eae6320::Graphics::cTexture::Initialize( const std::string& i_path, const TextureFormats::sHeader& i_header, const uint8_t* const i_mipData )
+{
+	auto result = Results::Success;
+
+	// The color textures are sampled as they were before they were compressed
+	// (i.e. without converting sRGB to linear)
+	GLenum format = GL_COMPRESSED_RGBA_BPTC_UNORM;
+	switch ( i_header.format )
+	{
+	case TextureFormats::eFormat::BC1: format = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT; break;
+	case TextureFormats::eFormat::BC3: format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
+	case TextureFormats::eFormat::BC5: format = GL_COMPRESSED_RG_RGTC2; break;
+	case TextureFormats::eFormat::BC7: format = GL_COMPRESSED_RGBA_BPTC_UNORM; break;
+	default:
+		// Uploading the blocks as a different format would give the driver data of the wrong size
+		result = Results::Failure;
+		EAE6320_ASSERTF( false, "Unknown texture format %u", static_cast<unsigned int>( i_header.format ) );
+		Logging::OutputError( "The texture %s has an unknown format (%u)", i_path.c_str(), static_cast<unsigned int>( i_header.format ) );
+		return result;
+	}
+
+	glGenTextures( 1, &m_textureId );
+	if ( m_textureId == 0 )
+	{
+		result = Results::Failure;
+		EAE6320_ASSERTF( false, "Generate texture failed!" );
+		Logging::OutputError( "OpenGL failed to generate a texture for %s", i_path.c_str() );
+		return result;
+	}
+
+	// Binding the texture here bypasses the state cache
+	// (which is invalidated at the start of every frame)
+	glBindTexture( GL_TEXTURE_2D, m_textureId );
+	// Every mip was built offline
+	m_memorySize = 0;
+	{
+		auto* mipData = i_mipData;
+		for ( uint8_t i = 0; i < i_header.mipCount; ++i )
+		{
+			const auto width = TextureFormats::GetMipDimension( i_header.width, i );
+			const auto height = TextureFormats::GetMipDimension( i_header.height, i );
+			const auto mipSize = TextureFormats::GetMipSize( i_header.format, width, height );
+			glCompressedTexImage2D( GL_TEXTURE_2D, static_cast<GLint>( i ), format,
+				static_cast<GLsizei>( width ), static_cast<GLsizei>( height ), 0, static_cast<GLsizei>( mipSize ), mipData );
+			mipData += mipSize;
+			m_memorySize += mipSize;
+		}
+	}
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>( i_header.mipCount ) - 1 );
+
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
+
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+
+	{
+		const auto errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			result = Results::Failure;
+			m_memorySize = 0;
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			Logging::OutputError( "OpenGL failed to upload the texture %s: %s",
+				i_path.c_str(), reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			return result;
+		}
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Graphics::cTexture::CleanUp()
+{
+	auto result = Results::Success;
+
+	if ( m_textureId != 0 )
+	{
+		glDeleteTextures( 1, &m_textureId );
+		const auto errorCode = glGetError();
+		if ( errorCode != GL_NO_ERROR )
+		{
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+			Logging::OutputError( "OpenGL failed to delete a texture: %s",
+				reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+		}
+		m_textureId = 0;
+	}
+
+	return result;
+}
@@ -193,11 +193,12 @@ namespace
 				// Create a key/value list of attributes that the context should have
 				constexpr int desiredAttributes[] =
 				{
-					// Request at least version 4.2
+					// Request at least version 4.4
+					// (persistently-mapped buffers need glBufferStorage())
 					WGL_CONTEXT_MAJOR_VERSION_ARB, 4,
-					WGL_CONTEXT_MINOR_VERSION_ARB, 2,
+					WGL_CONTEXT_MINOR_VERSION_ARB, 4,
 					// Request only "core" functionality and not "compatibility"
-					// (i.e. only use modern features of version 4.2)
+					// (i.e. only use modern features of version 4.4)
 					WGL_CONTEXT_PROFILE_MASK_ARB, WGL_CONTEXT_CORE_PROFILE_BIT_ARB,
 #ifdef EAE6320_GRAPHICS_ISDEVICEDEBUGINFOENABLED
 					WGL_CONTEXT_FLAGS_ARB, WGL_CONTEXT_DEBUG_BIT_ARB,
@@ -0,0 +1,130 @@
+// Includes
+//=========
+
+#include "../sStateCache.h"
+
+#include <Engine/Asserts/Asserts.h>
+
+// Interface
+//==========
+
+// Render
+//-------
+
+void eae6320::Graphics::sStateCache::BindProgram( const GLuint i_programId )
+{
+	EAE6320_ASSERT( i_programId != 0 );
+	if ( !CountBind( i_programId == m_programId ) )
+	{
+		glUseProgram( i_programId );
+		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+		m_programId = i_programId;
+	}
+}
+
+void eae6320::Graphics::sStateCache::BindVertexArray( const GLuint i_vertexArrayId )
+{
+	EAE6320_ASSERT( i_vertexArrayId != 0 );
+	if ( !CountBind( i_vertexArrayId == m_vertexArrayId ) )
+	{
+		glBindVertexArray( i_vertexArrayId );
+		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+		m_vertexArrayId = i_vertexArrayId;
+	}
+}
+
+void eae6320::Graphics::sStateCache::BindTexture( const GLuint i_unit, const GLuint i_textureId )
+{
+	EAE6320_ASSERT( i_unit < s_textureUnitCount );
+	if ( !CountBind( i_textureId == m_textureIds[i_unit] ) )
+	{
+		// The texture unit that a texture is bound to is itself state,
+		// and so it only needs to change when a texture is actually bound
+		if ( i_unit != m_activeTextureUnit )
+		{
+			glActiveTexture( GL_TEXTURE0 + i_unit );
+			EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+			m_activeTextureUnit = i_unit;
+		}
+		glBindTexture( GL_TEXTURE_2D, i_textureId );
+		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+		m_textureIds[i_unit] = i_textureId;
+	}
+}
+
+void eae6320::Graphics::sStateCache::BindSampler( const GLuint i_unit, const GLuint i_samplerId )
+{
+	EAE6320_ASSERT( i_unit < s_textureUnitCount );
+	if ( !CountBind( i_samplerId == m_samplerIds[i_unit] ) )
+	{
+		glBindSampler( i_unit, i_samplerId );
+		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+		m_samplerIds[i_unit] = i_samplerId;
+	}
+}
+
+void eae6320::Graphics::sStateCache::BindConstantBuffer( const GLuint i_slot, const GLuint i_bufferId, const GLintptr i_offset, const GLsizeiptr i_size )
+{
+	EAE6320_ASSERT( i_slot < s_constantBufferSlotCount );
+	EAE6320_ASSERT( i_bufferId != 0 );
+	auto& constantBuffer = m_constantBuffers[i_slot];
+	if ( !CountBind( ( i_bufferId == constantBuffer.bufferId ) && ( i_offset == constantBuffer.offset ) && ( i_size == constantBuffer.size ) ) )
+	{
+		if ( i_size > 0 )
+		{
+			glBindBufferRange( GL_UNIFORM_BUFFER, i_slot, i_bufferId, i_offset, i_size );
+		}
+		else
+		{
+			EAE6320_ASSERT( i_offset == 0 );
+			glBindBufferBase( GL_UNIFORM_BUFFER, i_slot, i_bufferId );
+		}
+		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+		constantBuffer.bufferId = i_bufferId;
+		constantBuffer.offset = i_offset;
+		constantBuffer.size = i_size;
+	}
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::sStateCache::Initialize()
+{
+	Invalidate();
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Graphics::sStateCache::CleanUp()
+{
+	Invalidate();
+	return Results::Success;
+}
+
+// Implementation
+//===============
+
+void eae6320::Graphics::sStateCache::Invalidate_platformSpecific()
+{
+	// Zero is never bound as a program, vertex array, or constant buffer by the cache,
+	// and so it can be used to mean "unknown"
+	m_programId = 0;
+	m_vertexArrayId = 0;
+	// Zero is a valid texture or sampler to bind, though,
+	// and so an ID that won't ever be generated is used instead
+	constexpr auto unknownId = ~GLuint( 0 );
+	// There is no unit with this number
+	m_activeTextureUnit = s_textureUnitCount;
+	for ( auto& textureId : m_textureIds )
+	{
+		textureId = unknownId;
+	}
+	for ( auto& samplerId : m_samplerIds )
+	{
+		samplerId = unknownId;
+	}
+	for ( auto& constantBuffer : m_constantBuffers )
+	{
+		constantBuffer = sConstantBufferRange{};
+	}
+}
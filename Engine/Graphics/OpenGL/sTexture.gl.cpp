@@ -1,10 +0,0 @@
-// Includes
-//=========
-
-#include "../sTexture.h"
-#include "Includes.h"
-
-eae6320::cResult eae6320::Graphics::sTexture::CleanUp()
-{
-	return Results::Success;
-}
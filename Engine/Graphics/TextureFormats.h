@@ -0,0 +1,99 @@
+/*
+	This file defines the layout of built texture files
+
+	A built texture is written by TextureBuilder
+	and contains a complete mip chain of block-compressed data
+	that can be uploaded to the GPU without being decoded
+*/
+
+#ifndef EAE6320_GRAPHICS_TEXTUREFORMATS_H
+#define EAE6320_GRAPHICS_TEXTUREFORMATS_H
+
+// Includes
+//=========
+
+#include <cstdint>
+
+// Format Definitions
+//===================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace TextureFormats
+		{
+			// Every format is made of 4x4 texel blocks
+			enum class eFormat : uint8_t
+			{
+				// RGB with 1 bit alpha (8 bytes per block)
+				BC1,
+				// RGBA with interpolated alpha (16 bytes per block)
+				BC3,
+				// Two independent channels, e.g. for normal maps (16 bytes per block)
+				BC5,
+				// High quality RGBA (16 bytes per block)
+				BC7,
+
+				Count
+			};
+
+			enum eFlags : uint8_t
+			{
+				// The texels are colors that were authored in sRGB space
+				// (the mips were filtered in linear space)
+				IsSRGB = 1 << 0,
+			};
+
+			struct sHeader
+			{
+				static constexpr uint32_t s_fourCc = 0x58455445;	// "ETEX"
+				static constexpr uint8_t s_version = 1;
+
+				uint32_t fourCc = s_fourCc;
+				uint8_t version = s_version;
+				eFormat format = eFormat::BC7;
+				uint8_t mipCount = 0;
+				uint8_t flags = 0;
+				uint32_t width = 0;
+				uint32_t height = 0;
+			};
+			// The header is followed by the data of each mip level
+			// (the largest first), each immediately after the previous one
+
+			constexpr uint32_t blockWidth = 4;
+
+			constexpr uint32_t GetBytesPerBlock( const eFormat i_format )
+			{
+				return ( i_format == eFormat::BC1 ) ? 8 : 16;
+			}
+			// A mip that is smaller than a block still needs a whole block
+			constexpr uint32_t GetBlockCount( const uint32_t i_texelCount )
+			{
+				return ( i_texelCount + ( blockWidth - 1 ) ) / blockWidth;
+			}
+			constexpr uint32_t GetMipDimension( const uint32_t i_dimension, const uint32_t i_mipLevel )
+			{
+				const auto dimension = i_dimension >> i_mipLevel;
+				return ( dimension > 0 ) ? dimension : 1;
+			}
+			constexpr uint32_t GetMipSize( const eFormat i_format, const uint32_t i_width, const uint32_t i_height )
+			{
+				return GetBlockCount( i_width ) * GetBlockCount( i_height ) * GetBytesPerBlock( i_format );
+			}
+			constexpr uint8_t GetFullMipCount( uint32_t i_width, uint32_t i_height )
+			{
+				uint8_t mipCount = 1;
+				while ( ( i_width > 1 ) || ( i_height > 1 ) )
+				{
+					i_width = ( i_width > 1 ) ? ( i_width / 2 ) : 1;
+					i_height = ( i_height > 1 ) ? ( i_height / 2 ) : 1;
+					++mipCount;
+				}
+				return mipCount;
+			}
+		}
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_TEXTUREFORMATS_H
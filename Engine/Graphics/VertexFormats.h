@@ -14,6 +14,7 @@
 #include "Configuration.h"
 
 #include <cstdint>
+#include <Engine/Math/cMatrix_transformation.h>
 
 #if defined( EAE6320_PLATFORM_D3D )
 	#include <dxgiformat.h>
@@ -37,20 +38,32 @@ namespace eae6320
 			struct sVertex_mesh
 			{
 				// Position
-				float x, y, z;
-				// Normal
-				float nx, ny, nz;
-				// Tangent
-				float tx, ty, tz;
-				// Bitangent
-				float btx, bty, btz;
+				// (16 bit normalized integers that are relative to the mesh's bounds,
+				// which are passed to the vertex shader in the draw call constant buffer)
+				uint16_t x, y, z;
+				// (The input assembler can only read 16 bit integers in groups of 2 or 4)
+				uint16_t padding;
+				// Tangent frame
+				// (a quaternion of 16 bit normalized integers that rotates tangent space into model space;
+				// w is negative if the bitangent is mirrored)
+				int16_t qx, qy, qz, qw;
 				// Texture coordinates
-				float u, v;
+				// (16 bit floats)
+				uint16_t u, v;
 				// Color
 				uint8_t r, g, b, a;
-				// Material
-				uint8_t mat;
 			};
+			static_assert( sizeof( sVertex_mesh ) == 24, "The mesh vertex must be tightly packed" );
+
+			// Per-instance data is streamed from a second vertex buffer
+			// so that many copies of the same mesh can be drawn with a single draw call
+			// (see cInstanceBuffer.h)
+			struct sInstance_mesh
+			{
+				// The four columns are read as separate vertex elements
+				Math::cMatrix_transformation transform_localToWorld;
+			};
+			static_assert( sizeof( sInstance_mesh ) == ( 16 * sizeof( float ) ), "The instance transform must be tightly packed" );
 		}
 	}
 }
@@ -18,39 +18,33 @@ eae6320::cResult eae6320::Graphics::cConstantBuffer::Initialize( const void* con
 {
 	auto result = Results::Success;
 
-	if ( m_type < ConstantBufferTypes::Count )
+	if ( !( result = InitializeSize() ) )
 	{
-		// Find the size of the type's struct
-		{
-			switch ( m_type )
-			{
-				case ConstantBufferTypes::Frame: m_size = sizeof( ConstantBufferFormats::sFrame ); break;
-				case ConstantBufferTypes::Material: m_size = sizeof( ConstantBufferFormats::sMaterial ); break;
-				case ConstantBufferTypes::DrawCall: m_size = sizeof( ConstantBufferFormats::sDrawCall ); break;
-
-			// This should never happen
-			default:
-
-				result = Results::Failure;
-				EAE6320_ASSERTF( false, "Unrecognized constant buffer type %u", m_type );
-				Logging::OutputError( "The size couldn't be calculated for a constant buffer of type %u", m_type );
-				return result;
-			}
-			EAE6320_ASSERT( m_size > 0 );
-		}
-		// Initialize the platform-specific constant buffer
-		{
-			result = Initialize_platformSpecific( i_initialData );
-			EAE6320_ASSERT( result );
-		}
+		return result;
 	}
-	else
+	// Initialize the platform-specific constant buffer
+	{
+		result = Initialize_platformSpecific( i_initialData );
+		EAE6320_ASSERT( result );
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Graphics::cConstantBuffer::InitializeRing( const uint32_t i_blockCountPerFrame )
+{
+	auto result = Results::Success;
+
+	if ( !( result = InitializeSize() ) )
 	{
-		result = Results::Failure;
-		EAE6320_ASSERTF( false, "Invalid constant buffer type %u", m_type );
-		Logging::OutputError( "A constant buffer is being initialized with the invalid type %u", m_type );
 		return result;
 	}
+	m_ringBlockCountPerFrame = ( i_blockCountPerFrame > 0 ) ? i_blockCountPerFrame : 1;
+	// Initialize the platform-specific ring
+	{
+		result = InitializeRing_platformSpecific();
+		EAE6320_ASSERT( result );
+	}
 
 	return result;
 }
@@ -67,3 +61,43 @@ eae6320::Graphics::cConstantBuffer::~cConstantBuffer()
 	const auto result = CleanUp();
 	EAE6320_ASSERT( result );
 }
+
+// Implementation
+//===============
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cConstantBuffer::InitializeSize()
+{
+	auto result = Results::Success;
+
+	if ( m_type < ConstantBufferTypes::Count )
+	{
+		// Find the size of the type's struct
+		switch ( m_type )
+		{
+			case ConstantBufferTypes::Frame: m_size = sizeof( ConstantBufferFormats::sFrame ); break;
+			case ConstantBufferTypes::Material: m_size = sizeof( ConstantBufferFormats::sMaterial ); break;
+			case ConstantBufferTypes::DrawCall: m_size = sizeof( ConstantBufferFormats::sDrawCall ); break;
+
+		// This should never happen
+		default:
+
+			result = Results::Failure;
+			EAE6320_ASSERTF( false, "Unrecognized constant buffer type %u", m_type );
+			Logging::OutputError( "The size couldn't be calculated for a constant buffer of type %u", m_type );
+			return result;
+		}
+		EAE6320_ASSERT( m_size > 0 );
+	}
+	else
+	{
+		result = Results::Failure;
+		EAE6320_ASSERTF( false, "Invalid constant buffer type %u", m_type );
+		Logging::OutputError( "A constant buffer is being initialized with the invalid type %u", m_type );
+		return result;
+	}
+
+	return result;
+}
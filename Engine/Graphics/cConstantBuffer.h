@@ -103,10 +103,32 @@ namespace eae6320
 			// This function only needs to be called when the constant data that the GPU is using needs to change.
 			void Update( const void* const i_data );
 
+			// Dynamic Ring
+			//-------------
+
+			// A constant buffer that is initialized as a dynamic ring holds one block of constant data per draw call:
+			// All of the blocks for a frame are written contiguously between MapRing() and UnmapRing()
+			// (i.e. there is a single upload per frame),
+			// and then each draw call only binds the range of its own block.
+			// EndRingFrame() must be called after the last draw call of the frame
+			// so that the CPU never overwrites blocks that the GPU might still be reading.
+
+			// Returns memory for i_blockCount blocks that are GetRingBlockStride() bytes apart
+			// (the ring grows if a frame needs more blocks than it can hold).
+			// Returns null if the memory couldn't be mapped.
+			void* MapRing( const uint32_t i_blockCount );
+			void UnmapRing();
+			void BindRange( const uint_fast8_t i_shaderTypesToBindTo, const uint32_t i_blockIndex ) const;
+			void EndRingFrame();
+
+			size_t GetRingBlockStride() const { return m_ringBlockStride; }
+
 			// Initialize / Clean Up
 			//----------------------
 
 			cResult Initialize( const void* const i_initialData = nullptr );
+			// i_blockCountPerFrame is the number of draw calls in a frame that the ring can hold before it must grow
+			cResult InitializeRing( const uint32_t i_blockCountPerFrame );
 			cResult CleanUp();
 
 			cConstantBuffer( const ConstantBufferTypes i_type );
@@ -126,6 +148,21 @@ namespace eae6320
 #elif defined( EAE6320_PLATFORM_GL )
 			GLuint m_bufferId = 0;
 #endif
+
+			// These are only used by a dynamic ring:
+			// The distance between blocks (m_size rounded up to the platform's offset alignment)
+			size_t m_ringBlockStride = 0;
+			// The number of blocks that a single frame can use
+			uint32_t m_ringBlockCountPerFrame = 0;
+#if defined( EAE6320_PLATFORM_GL )
+			// The ring is split into one segment for each frame that the GPU can still be reading,
+			// and each segment has a fence that is signaled when the GPU is done with it
+			static constexpr unsigned int s_ringFrameCount = 3;
+			GLsync m_ringFences[s_ringFrameCount] = {};
+			unsigned int m_ringFrameIndex = 0;
+			// The whole ring is mapped persistently when it is allocated
+			void* m_ringMappedMemory = nullptr;
+#endif
 			
 			// The constant buffer type defines the size of the constant data
 			// and is used to bind the constant buffer (the type enumeration is used as an ID)
@@ -139,7 +176,12 @@ namespace eae6320
 			// Initialize / Clean Up
 			//----------------------
 
+			cResult InitializeSize();
 			cResult Initialize_platformSpecific( const void* const i_initialData );
+			cResult InitializeRing_platformSpecific();
+			// Allocates storage for m_ringBlockCountPerFrame blocks
+			// (discarding the previous contents, and on OpenGL the previous buffer)
+			cResult AllocateRing_platformSpecific();
 
 			cConstantBuffer( const cConstantBuffer& ) = delete;
 			cConstantBuffer( cConstantBuffer&& ) = delete;
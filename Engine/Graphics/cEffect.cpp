@@ -4,24 +4,44 @@
 #include "cEffect.h"
 
 #include "cShader.h"
+#include "cSortIdAllocator.h"
 
 #include <Engine/Asserts/Asserts.h>
-#include <Engine/Concurrency/cMutex.h>
 #include <Engine/Logging/Logging.h>
 #include <Engine/ScopeGuard/cScopeGuard.h>
 #include <new>
-#include <vector>
 
-// Helper Class Declaration
-//=========================
+// Static Data
+//============
+
+namespace
+{
+	// This is defined before the manager so that it is still alive when the manager destroys any effects that are left
+	eae6320::Graphics::cSortIdAllocator s_sortIdAllocator;
+}
+
+eae6320::Assets::cManager<eae6320::Graphics::cEffect, eae6320::Graphics::cEffect::sKey> eae6320::Graphics::cEffect::s_manager;
 
 // Interface
 //==========
 
+bool eae6320::Graphics::cEffect::sKey::operator <( const sKey& i_rhs ) const
+{
+	if ( renderStateBits != i_rhs.renderStateBits )
+	{
+		return renderStateBits < i_rhs.renderStateBits;
+	}
+	if ( vertexShaderPath != i_rhs.vertexShaderPath )
+	{
+		return vertexShaderPath < i_rhs.vertexShaderPath;
+	}
+	return fragmentShaderPath < i_rhs.fragmentShaderPath;
+}
+
 // Initialize / Clean Up
 //----------------------
 
-eae6320::cResult eae6320::Graphics::cEffect::Load( const std::string& i_vertexShaderPath, const std::string& i_fragmentShaderPath, cEffect*& o_effect )
+eae6320::cResult eae6320::Graphics::cEffect::Load( const sKey& i_key, cEffect*& o_effect )
 {
 	auto result = Results::Success;
 
@@ -57,7 +77,7 @@ eae6320::cResult eae6320::Graphics::cEffect::Load( const std::string& i_vertexSh
 	}
 
 	// Initialize the graphics API effect object
-	if ( !( result = newEffect->Initialize( i_vertexShaderPath, i_fragmentShaderPath ) ) )
+	if ( !( result = newEffect->Initialize( i_key ) ) )
 	{
 		EAE6320_ASSERTF( false, "Initialization of new effect failed" );
 		return result;
@@ -74,49 +94,38 @@ eae6320::cResult eae6320::Graphics::cEffect::Load( const std::string& i_vertexSh
 
 eae6320::Graphics::cEffect::cEffect()
 {
-
+	m_sortId = s_sortIdAllocator.Acquire();
 }
 
 eae6320::Graphics::cEffect::~cEffect()
 {
 	const auto result = CleanUp();
 	EAE6320_ASSERT( result );
+
+	s_sortIdAllocator.Release( m_sortId );
 }
 
-eae6320::cResult eae6320::Graphics::cEffect::Initialize( const std::string& i_vertexShaderPath, const std::string& i_fragmentShaderPath )
+eae6320::cResult eae6320::Graphics::cEffect::Initialize( const sKey& i_key )
 {
 	auto result = eae6320::Results::Success;
 
-	if ( !( result = eae6320::Graphics::cShader::Load( i_vertexShaderPath,
-		m_vertexShader, eae6320::Graphics::eShaderType::Vertex ) ) )
+	// The shaders are shared with every other effect that uses them
+	if ( !( result = cShader::s_manager.Load( i_key.vertexShaderPath, m_vertexShaderHandle, eShaderType::Vertex ) ) )
 	{
 		EAE6320_ASSERTF( false, "Can't initialize shading data without vertex shader" );
 		return result;
 	}
-	if ( !( result = eae6320::Graphics::cShader::Load( i_fragmentShaderPath,
-		m_fragmentShader, eae6320::Graphics::eShaderType::Fragment ) ) )
+	m_vertexShader = cShader::s_manager.Get( m_vertexShaderHandle );
+	if ( !( result = cShader::s_manager.Load( i_key.fragmentShaderPath, m_fragmentShaderHandle, eShaderType::Fragment ) ) )
 	{
 		EAE6320_ASSERTF( false, "Can't initialize shading data without fragment shader" );
 		return result;
 	}
+	m_fragmentShader = cShader::s_manager.Get( m_fragmentShaderHandle );
+	if ( !( result = m_renderState.Initialize( i_key.renderStateBits ) ) )
 	{
-		constexpr auto renderStateBits = []
-		{
-			uint8_t renderStateBits = 0;
-
-			eae6320::Graphics::RenderStates::DisableAlphaTransparency( renderStateBits );
-			eae6320::Graphics::RenderStates::EnableDepthTesting( renderStateBits );
-			eae6320::Graphics::RenderStates::EnableDepthWriting( renderStateBits );
-			eae6320::Graphics::RenderStates::EnableAlphaTransparency( renderStateBits );
-			eae6320::Graphics::RenderStates::DisableDrawingBothTriangleSides( renderStateBits );
-
-			return renderStateBits;
-		}();
-		if ( !( result = m_renderState.Initialize( renderStateBits ) ) )
-		{
-			EAE6320_ASSERTF(false, "Can't initialize shading data without render state");
-			return result;
-		}
+		EAE6320_ASSERTF( false, "Can't initialize shading data without render state" );
+		return result;
 	}
 
 #if defined( EAE6320_PLATFORM_GL )
@@ -134,16 +143,24 @@ eae6320::cResult eae6320::Graphics::cEffect::CleanUp()
 	result = CleanUpShadingProgram();
 #endif
 
-	if ( m_vertexShader )
+	m_vertexShader = nullptr;
+	if ( m_vertexShaderHandle )
 	{
-		m_vertexShader->DecrementReferenceCount();
-		m_vertexShader = nullptr;
+		const auto result_vertexShader = cShader::s_manager.Release( m_vertexShaderHandle );
+		if ( !result_vertexShader && result )
+		{
+			result = result_vertexShader;
+		}
 	}
 
-	if ( m_fragmentShader )
+	m_fragmentShader = nullptr;
+	if ( m_fragmentShaderHandle )
 	{
-		m_fragmentShader->DecrementReferenceCount();
-		m_fragmentShader = nullptr;
+		const auto result_fragmentShader = cShader::s_manager.Release( m_fragmentShaderHandle );
+		if ( !result_fragmentShader && result )
+		{
+			result = result_fragmentShader;
+		}
 	}
 
 	return result;
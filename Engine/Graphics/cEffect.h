@@ -6,6 +6,7 @@
 
 #include "cRenderState.h"
 
+#include <Engine/Assets/cManager.h>
 #include <Engine/Assets/ReferenceCountedAssets.h>
 
 #include <cstdint>
@@ -16,6 +17,27 @@
 #include "OpenGL/Includes.h"
 #endif
 
+// Shader Parameters
+//==================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		// Shader parameters are looked up by a hash of their name (32-bit FNV-1a)
+		// so that callers can calculate it at compile time and never compare strings while rendering
+		constexpr uint32_t HashShaderParameterName( const char* const i_name )
+		{
+			uint32_t hash = 2166136261u;
+			for ( auto* character = i_name; *character != '\0'; ++character )
+			{
+				hash = ( hash ^ static_cast<uint8_t>( *character ) ) * 16777619u;
+			}
+			return hash;
+		}
+	}
+}
+
 // Forward Declarations
 //=====================
 
@@ -45,7 +67,22 @@ namespace eae6320
 			// Initialization / Clean Up
 			//--------------------------
 
-			static cResult Load( const std::string& i_vertexShaderPath, const std::string& i_fragmentShaderPath, cEffect*& o_effect );
+			// Effects are shared:
+			// Every request for the same shaders and render state gets the same effect from s_manager
+			// (and so each unique program is only compiled and linked once)
+			struct sKey
+			{
+				std::string vertexShaderPath;
+				std::string fragmentShaderPath;
+				uint8_t renderStateBits = 0;
+
+				bool operator <( const sKey& i_rhs ) const;
+			};
+
+			static Assets::cManager<cEffect, sKey> s_manager;
+
+			// This is called by s_manager
+			static cResult Load( const sKey& i_key, cEffect*& o_effect );
 
 			EAE6320_ASSETS_DECLAREDELETEDREFERENCECOUNTEDFUNCTIONS( cEffect );
 
@@ -54,6 +91,24 @@ namespace eae6320
 
 			EAE6320_ASSETS_DECLAREREFERENCECOUNTINGFUNCTIONS();
 
+#if defined( EAE6320_PLATFORM_GL )
+			// Shader Parameters
+			//------------------
+
+			// The active uniforms of the program are found once when it is linked
+			struct sShaderParameter
+			{
+				uint32_t nameHash;
+				GLint location;
+				// The unit that a sampler reads from (or -1 if the parameter isn't a sampler)
+				GLint textureUnit;
+			};
+
+			// Returns null if the program doesn't have an active uniform with the name
+			// (e.g. because the shader compiler optimized it away)
+			const sShaderParameter* FindParameter( const uint32_t i_nameHash ) const;
+#endif
+
 			// Data
 			//=====
 
@@ -61,26 +116,36 @@ namespace eae6320
 		
 		protected:
 
+			// The shaders are looked up once when the effect is loaded
+			// (the pointers stay valid for as long as the handles are held)
+			Assets::cHandle<cShader> m_vertexShaderHandle;
+			Assets::cHandle<cShader> m_fragmentShaderHandle;
 			cShader* m_vertexShader = nullptr;
 			cShader* m_fragmentShader = nullptr;
 
 #if defined( EAE6320_PLATFORM_GL )
 			GLuint m_programId = 0;
+			// Sorted by name hash
+			sShaderParameter* m_parameters = nullptr;
+			uint16_t m_parameterCount = 0;
 #endif
 
 			cRenderState m_renderState;
 
 		private:
 
+			uint16_t m_sortId = 0;
+
 			EAE6320_ASSETS_DECLAREREFERENCECOUNT();
 
 			// Initialization / Clean Up
 			//--------------------------
 
-			cResult Initialize( const std::string& i_vertexShaderPath, const std::string& i_fragmentShaderPath );
+			cResult Initialize( const sKey& i_key );
 
 #if defined( EAE6320_PLATFORM_GL )
 			cResult InitializeShadingProgram();
+			cResult ReflectShaderParameters();
 #endif
 
 			cResult CleanUp();
@@ -95,6 +160,8 @@ namespace eae6320
 		public:
 			void Bind();
 
+			uint16_t GetSortId() const { return m_sortId; }
+
 #if defined( EAE6320_PLATFORM_GL )
 			const GLuint GetShaderId() { return m_programId; }
 #endif
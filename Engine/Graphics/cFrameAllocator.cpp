@@ -0,0 +1,141 @@
+// Includes
+//=========
+
+#include "cFrameAllocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+
+// Static Data
+//============
+
+namespace
+{
+	// The chunk header is padded so that the memory after it has the strictest fundamental alignment
+	constexpr size_t s_chunkHeaderSize = ( ( 2 * sizeof( void* ) ) + alignof( std::max_align_t ) - 1 ) & ~( alignof( std::max_align_t ) - 1 );
+}
+
+// Interface
+//==========
+
+// Allocation
+//-----------
+
+void* eae6320::Graphics::cFrameAllocator::Allocate( const size_t i_size, const size_t i_alignment )
+{
+	EAE6320_ASSERTF( m_firstChunk, "The frame allocator hasn't been initialized" );
+	EAE6320_ASSERTF( ( i_alignment != 0 ) && ( ( i_alignment & ( i_alignment - 1 ) ) == 0 ), "Alignment must be a power of 2" );
+
+	const auto GetAlignedOffset = [i_alignment]( const sChunk* const i_chunk, const size_t i_offset )
+	{
+		const auto address = reinterpret_cast<uintptr_t>( i_chunk ) + s_chunkHeaderSize + i_offset;
+		const auto address_aligned = ( address + i_alignment - 1 ) & ~static_cast<uintptr_t>( i_alignment - 1 );
+		return static_cast<size_t>( address_aligned - ( reinterpret_cast<uintptr_t>( i_chunk ) + s_chunkHeaderSize ) );
+	};
+
+	auto offset = GetAlignedOffset( m_currentChunk, m_offsetInCurrentChunk );
+	if ( ( offset + i_size ) > m_currentChunk->size )
+	{
+		// Move on to the next chunk that was reserved in a previous frame if it is big enough,
+		// otherwise insert a new one
+		m_byteCount_usedInPreviousChunks += m_offsetInCurrentChunk;
+		auto* nextChunk = m_currentChunk->next;
+		if ( !nextChunk || ( ( GetAlignedOffset( nextChunk, 0 ) + i_size ) > nextChunk->size ) )
+		{
+			// Chunks grow geometrically so that the number of chunks stays small
+			const auto chunkSize = std::max( m_currentChunk->size * 2, i_size + i_alignment );
+			auto* const newChunk = CreateChunk( chunkSize );
+			if ( !newChunk )
+			{
+				return nullptr;
+			}
+			newChunk->next = nextChunk;
+			m_currentChunk->next = newChunk;
+			nextChunk = newChunk;
+			++m_statistics.growthCount;
+			Logging::OutputMessage( "The frame allocator grew to %u chunks (%u bytes reserved, %u bytes used this frame)",
+				m_statistics.chunkCount, static_cast<unsigned int>( m_statistics.byteCount_reserved ),
+				static_cast<unsigned int>( m_byteCount_usedInPreviousChunks ) );
+		}
+		m_currentChunk = nextChunk;
+		offset = GetAlignedOffset( m_currentChunk, 0 );
+	}
+
+	m_offsetInCurrentChunk = offset + i_size;
+	m_statistics.byteCount_usedThisFrame = m_byteCount_usedInPreviousChunks + m_offsetInCurrentChunk;
+	m_statistics.byteCount_usedPeak = std::max( m_statistics.byteCount_usedPeak, m_statistics.byteCount_usedThisFrame );
+
+	return reinterpret_cast<uint8_t*>( m_currentChunk ) + s_chunkHeaderSize + offset;
+}
+
+void eae6320::Graphics::cFrameAllocator::Reset()
+{
+	m_currentChunk = m_firstChunk;
+	m_offsetInCurrentChunk = 0;
+	m_byteCount_usedInPreviousChunks = 0;
+	m_statistics.byteCount_usedThisFrame = 0;
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cFrameAllocator::Initialize( const size_t i_initialChunkSize )
+{
+	EAE6320_ASSERT( !m_firstChunk );
+
+	m_firstChunk = CreateChunk( i_initialChunkSize );
+	if ( !m_firstChunk )
+	{
+		return Results::OutOfMemory;
+	}
+	m_firstChunk->next = nullptr;
+	Reset();
+
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Graphics::cFrameAllocator::CleanUp()
+{
+	auto* chunk = m_firstChunk;
+	while ( chunk )
+	{
+		auto* const nextChunk = chunk->next;
+		free( chunk );
+		chunk = nextChunk;
+	}
+	m_firstChunk = nullptr;
+	m_currentChunk = nullptr;
+	m_offsetInCurrentChunk = 0;
+	m_byteCount_usedInPreviousChunks = 0;
+	m_statistics = sStatistics();
+
+	return Results::Success;
+}
+
+eae6320::Graphics::cFrameAllocator::~cFrameAllocator()
+{
+	const auto result = CleanUp();
+	EAE6320_ASSERT( result );
+}
+
+// Implementation
+//===============
+
+eae6320::Graphics::cFrameAllocator::sChunk* eae6320::Graphics::cFrameAllocator::CreateChunk( const size_t i_size )
+{
+	auto* const chunk = static_cast<sChunk*>( malloc( s_chunkHeaderSize + i_size ) );
+	if ( !chunk )
+	{
+		EAE6320_ASSERTF( false, "Couldn't allocate memory for a frame allocator chunk" );
+		Logging::OutputError( "Failed to allocate a frame allocator chunk of %u bytes", static_cast<unsigned int>( i_size ) );
+		return nullptr;
+	}
+	chunk->next = nullptr;
+	chunk->size = i_size;
+	m_statistics.byteCount_reserved += i_size;
+	++m_statistics.chunkCount;
+
+	return chunk;
+}
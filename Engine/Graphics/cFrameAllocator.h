@@ -0,0 +1,110 @@
+/*
+	A frame allocator is a linear ("bump") allocator for data that only lives for a single frame
+
+	Allocating just moves an offset forward in the current chunk of memory,
+	and resetting moves it back to the start of the first chunk
+	(nothing is ever freed individually, and objects in the allocator must not need to be destructed).
+	If a frame needs more memory than has been reserved a new chunk is added,
+	and the chunks are kept so that the next frames of the same size don't need to allocate anything
+*/
+
+#ifndef EAE6320_GRAPHICS_CFRAMEALLOCATOR_H
+#define EAE6320_GRAPHICS_CFRAMEALLOCATOR_H
+
+// Includes
+//=========
+
+#include "Configuration.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Results/Results.h>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class cFrameAllocator
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Allocation
+			//-----------
+
+			// Returns null if there isn't enough memory
+			void* Allocate( const size_t i_size, const size_t i_alignment = alignof( std::max_align_t ) );
+			// Default-constructs i_count objects
+			template <typename tObject>
+				tObject* Allocate( const size_t i_count );
+
+			// Makes all of the memory available again (any objects allocated before are invalid after this call)
+			void Reset();
+
+			// Telemetry
+			//----------
+
+			struct sStatistics
+			{
+				size_t byteCount_usedThisFrame = 0;
+				size_t byteCount_usedPeak = 0;
+				// The total size of all chunks
+				size_t byteCount_reserved = 0;
+				uint32_t chunkCount = 0;
+				// The number of times that a frame needed more memory than was reserved
+				uint32_t growthCount = 0;
+			};
+			const sStatistics& GetStatistics() const { return m_statistics; }
+
+			// Initialize / Clean Up
+			//----------------------
+
+			cResult Initialize( const size_t i_initialChunkSize );
+			cResult CleanUp();
+
+			cFrameAllocator() = default;
+			~cFrameAllocator();
+
+			// Data
+			//=====
+
+		private:
+
+			// Each chunk's header is stored at the beginning of its memory
+			struct sChunk
+			{
+				sChunk* next;
+				size_t size;	// (Not including the header)
+			};
+
+			sChunk* m_firstChunk = nullptr;
+			sChunk* m_currentChunk = nullptr;
+			size_t m_offsetInCurrentChunk = 0;
+			// The memory used by the chunks before the current one in this frame
+			size_t m_byteCount_usedInPreviousChunks = 0;
+
+			sStatistics m_statistics;
+
+			// Implementation
+			//===============
+
+		private:
+
+			sChunk* CreateChunk( const size_t i_size );
+
+			cFrameAllocator( const cFrameAllocator& ) = delete;
+			cFrameAllocator( cFrameAllocator&& ) = delete;
+			cFrameAllocator& operator =( const cFrameAllocator& ) = delete;
+			cFrameAllocator& operator =( cFrameAllocator&& ) = delete;
+		};
+	}
+}
+
+#include "cFrameAllocator.inl"
+
+#endif	// EAE6320_GRAPHICS_CFRAMEALLOCATOR_H
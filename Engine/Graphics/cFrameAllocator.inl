@@ -0,0 +1,31 @@
+#ifndef EAE6320_GRAPHICS_CFRAMEALLOCATOR_INL
+#define EAE6320_GRAPHICS_CFRAMEALLOCATOR_INL
+
+// Includes
+//=========
+
+#include "cFrameAllocator.h"
+
+#include <new>
+
+// Interface
+//==========
+
+// Allocation
+//-----------
+
+template <typename tObject>
+	tObject* eae6320::Graphics::cFrameAllocator::Allocate( const size_t i_count )
+{
+	auto* const objects = static_cast<tObject*>( Allocate( sizeof( tObject ) * i_count, alignof( tObject ) ) );
+	if ( objects )
+	{
+		for ( size_t i = 0; i < i_count; ++i )
+		{
+			new ( objects + i ) tObject();
+		}
+	}
+	return objects;
+}
+
+#endif	// EAE6320_GRAPHICS_CFRAMEALLOCATOR_INL
@@ -0,0 +1,173 @@
+// Includes
+//=========
+
+#include "cFrustumCuller.h"
+
+#include "cMesh.h"
+#include "sRenderCommand.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Math/cMatrix_transformation.h>
+#include <Engine/Math/sVector.h>
+#include <utility>
+
+#if defined( _M_IX86 ) || defined( _M_X64 ) || defined( __SSE__ )
+	#define EAE6320_GRAPHICS_ISFRUSTUMCULLINGVECTORIZED
+	#include <xmmintrin.h>
+#endif
+
+// Interface
+//==========
+
+// Frustum
+//--------
+
+void eae6320::Graphics::cFrustumCuller::SetFrustum( const Math::cMatrix_transformation& i_transform_worldToCamera, const Math::cMatrix_transformation& i_transform_cameraToProjected )
+{
+	// A point is inside the frustum if its projected position is inside the clip volume,
+	// and so every plane is a sum of rows of the world-to-projected transform
+	// (Gribb and Hartmann's "Fast Extraction of Viewing Frustum Planes from the World-View-Projection Matrix")
+	const auto transform_worldToProjected = i_transform_cameraToProjected * i_transform_worldToCamera;
+	const auto GetRow = [&transform_worldToProjected]( const unsigned int i_row, float* const o_row )
+	{
+		for ( unsigned int i = 0; i < 4; ++i )
+		{
+			o_row[i] = transform_worldToProjected.GetElement( i_row, i );
+		}
+	};
+	float rows[4][4];
+	for ( unsigned int i = 0; i < 4; ++i )
+	{
+		GetRow( i, rows[i] );
+	}
+	for ( unsigned int i = 0; i < 4; ++i )
+	{
+		m_planes[0][i] = rows[3][i] + rows[0][i];	// Left
+		m_planes[1][i] = rows[3][i] - rows[0][i];	// Right
+		m_planes[2][i] = rows[3][i] + rows[1][i];	// Bottom
+		m_planes[3][i] = rows[3][i] - rows[1][i];	// Top
+#if defined( EAE6320_PLATFORM_D3D )
+		// Direct3D's projected depth goes from 0 to 1
+		m_planes[4][i] = rows[2][i];	// Near
+#elif defined( EAE6320_PLATFORM_GL )
+		// OpenGL's projected depth goes from -1 to 1
+		m_planes[4][i] = rows[3][i] + rows[2][i];	// Near
+#endif
+		m_planes[5][i] = rows[3][i] - rows[2][i];	// Far
+	}
+	for ( auto& plane : m_planes )
+	{
+		const auto length = std::sqrt( ( plane[0] * plane[0] ) + ( plane[1] * plane[1] ) + ( plane[2] * plane[2] ) );
+		EAE6320_ASSERT( length > 0.0f );
+		for ( auto& component : plane )
+		{
+			component /= length;
+		}
+	}
+}
+
+// Culling
+//--------
+
+uint32_t eae6320::Graphics::cFrustumCuller::Cull( sRenderCommand* const io_renderCommands, const uint32_t i_commandCount )
+{
+	if ( i_commandCount == 0 )
+	{
+		return 0;
+	}
+
+	// Transform every bounding sphere into world space
+	// (the arrays are padded to a multiple of four with spheres that are never visible)
+	const auto paddedCount = ( static_cast<size_t>( i_commandCount ) + 3 ) & ~size_t( 3 );
+	m_centers_x.resize( paddedCount );
+	m_centers_y.resize( paddedCount );
+	m_centers_z.resize( paddedCount );
+	m_radii.resize( paddedCount );
+	m_isVisible.resize( paddedCount );
+	for ( size_t i = 0; i < paddedCount; ++i )
+	{
+		const auto* const mesh = ( i < i_commandCount ) ? io_renderCommands[i].m_mesh : nullptr;
+		if ( !mesh )
+		{
+			m_centers_x[i] = m_centers_y[i] = m_centers_z[i] = 0.0f;
+			m_radii[i] = -FLT_MAX;
+			continue;
+		}
+		const auto& bounds = mesh->GetBounds();
+		const auto& transform_localToWorld = io_renderCommands[i].m_transformation;
+		const auto center_world = transform_localToWorld * Math::sVector( bounds.center[0], bounds.center[1], bounds.center[2] );
+		const auto scale = std::max( transform_localToWorld.GetRightDirection().GetLength(),
+			std::max( transform_localToWorld.GetUpDirection().GetLength(), transform_localToWorld.GetBackDirection().GetLength() ) );
+		m_centers_x[i] = center_world.x;
+		m_centers_y[i] = center_world.y;
+		m_centers_z[i] = center_world.z;
+		m_radii[i] = bounds.radius * scale;
+	}
+
+	// A sphere is visible unless it is completely behind one of the planes
+#ifdef EAE6320_GRAPHICS_ISFRUSTUMCULLINGVECTORIZED
+	{
+		__m128 planes[6][4];
+		for ( size_t i = 0; i < 6; ++i )
+		{
+			for ( size_t j = 0; j < 4; ++j )
+			{
+				planes[i][j] = _mm_set1_ps( m_planes[i][j] );
+			}
+		}
+		for ( size_t i = 0; i < paddedCount; i += 4 )
+		{
+			const auto x = _mm_loadu_ps( &m_centers_x[i] );
+			const auto y = _mm_loadu_ps( &m_centers_y[i] );
+			const auto z = _mm_loadu_ps( &m_centers_z[i] );
+			const auto negativeRadius = _mm_sub_ps( _mm_setzero_ps(), _mm_loadu_ps( &m_radii[i] ) );
+			auto isVisible = _mm_cmpge_ps( _mm_loadu_ps( &m_radii[i] ), _mm_setzero_ps() );
+			for ( const auto& plane : planes )
+			{
+				const auto distance = _mm_add_ps( _mm_add_ps( _mm_mul_ps( plane[0], x ), _mm_mul_ps( plane[1], y ) ),
+					_mm_add_ps( _mm_mul_ps( plane[2], z ), plane[3] ) );
+				isVisible = _mm_and_ps( isVisible, _mm_cmpge_ps( distance, negativeRadius ) );
+			}
+			const auto mask = _mm_movemask_ps( isVisible );
+			for ( size_t j = 0; j < 4; ++j )
+			{
+				m_isVisible[i + j] = static_cast<uint8_t>( ( mask >> j ) & 1 );
+			}
+		}
+	}
+#else
+	for ( size_t i = 0; i < paddedCount; ++i )
+	{
+		auto isVisible = m_radii[i] >= 0.0f;
+		for ( const auto& plane : m_planes )
+		{
+			const auto distance = ( plane[0] * m_centers_x[i] ) + ( plane[1] * m_centers_y[i] ) + ( plane[2] * m_centers_z[i] ) + plane[3];
+			isVisible = isVisible && ( distance >= -m_radii[i] );
+		}
+		m_isVisible[i] = isVisible ? 1 : 0;
+	}
+#endif
+
+	// Move the visible commands to the front
+	uint32_t visibleCount = 0;
+	for ( uint32_t i = 0; i < i_commandCount; ++i )
+	{
+		if ( m_isVisible[i] )
+		{
+			if ( i != visibleCount )
+			{
+				std::swap( io_renderCommands[visibleCount], io_renderCommands[i] );
+			}
+			++visibleCount;
+		}
+	}
+
+	m_statistics.testedCount += i_commandCount;
+	m_statistics.culledCount += i_commandCount - visibleCount;
+	m_statistics.submittedCount += visibleCount;
+
+	return visibleCount;
+}
@@ -0,0 +1,97 @@
+/*
+	A frustum culler removes render commands whose meshes can't be seen by the camera
+	before they are submitted
+
+	The planes of the view frustum are extracted from the camera's matrices,
+	and each mesh's bounding sphere is tested against them four at a time
+*/
+
+#ifndef EAE6320_GRAPHICS_CFRUSTUMCULLER_H
+#define EAE6320_GRAPHICS_CFRUSTUMCULLER_H
+
+// Includes
+//=========
+
+#include <cstdint>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		struct sRenderCommand;
+	}
+
+	namespace Math
+	{
+		class cMatrix_transformation;
+	}
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class cFrustumCuller
+		{
+			// Interface
+			//==========
+
+		public:
+
+			struct sStatistics
+			{
+				uint32_t testedCount = 0;
+				uint32_t culledCount = 0;
+				uint32_t submittedCount = 0;
+			};
+
+			// Frustum
+			//--------
+
+			// This must be called with the same matrices that are submitted to Graphics
+			void SetFrustum( const Math::cMatrix_transformation& i_transform_worldToCamera, const Math::cMatrix_transformation& i_transform_cameraToProjected );
+			// The planes can also be used to query a spatial hierarchy for the objects that might be visible
+			const float ( &GetPlanes() const )[6][4] { return m_planes; }
+
+			// Culling
+			//--------
+
+			// Moves the commands whose meshes might be visible to the front of the array (in their original order)
+			// and returns how many there are.
+			// The culled commands are moved to the back rather than cleaned up,
+			// and so the caller is still responsible for cleaning up every command
+			uint32_t Cull( sRenderCommand* const io_renderCommands, const uint32_t i_commandCount );
+
+			// The statistics accumulate over every call to Cull() until they are reset
+			const sStatistics& GetStatistics() const { return m_statistics; }
+			void ResetStatistics() { m_statistics = sStatistics(); }
+
+			// Data
+			//=====
+
+		private:
+
+			// The left, right, bottom, top, near, and far planes in world space,
+			// stored as ( a, b, c, d ) where a point is inside if ax + by + cz + d >= 0
+			// (the normals are normalized so that d is a distance)
+			float m_planes[6][4] = {};
+
+			// The bounding spheres of the commands being culled (in world space),
+			// stored in separate arrays so that they can be tested four at a time
+			// (the arrays are kept between frames so that they only grow occasionally)
+			std::vector<float> m_centers_x, m_centers_y, m_centers_z, m_radii;
+			std::vector<uint8_t> m_isVisible;
+
+			sStatistics m_statistics;
+		};
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_CFRUSTUMCULLER_H
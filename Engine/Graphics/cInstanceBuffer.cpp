@@ -0,0 +1,64 @@
+// Includes
+//=========
+
+#include "cInstanceBuffer.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+
+// Interface
+//==========
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cInstanceBuffer::Initialize( const uint32_t i_capacity )
+{
+	auto result = Results::Success;
+
+	if ( i_capacity == 0 )
+	{
+		result = Results::Failure;
+		EAE6320_ASSERTF( false, "An instance buffer must be able to hold at least one instance" );
+		Logging::OutputError( "An instance buffer can't be initialized with a capacity of zero" );
+		return result;
+	}
+	m_capacity = i_capacity;
+
+	// Initialize the platform-specific instance buffer
+	{
+		result = Initialize_platformSpecific();
+		EAE6320_ASSERT( result );
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Graphics::cInstanceBuffer::Reserve( const uint32_t i_capacity )
+{
+	if ( i_capacity <= m_capacity )
+	{
+		return Results::Success;
+	}
+
+	// The capacity at least doubles so that growing is rare
+	const auto previousCapacity = m_capacity;
+	m_capacity = ( i_capacity > ( previousCapacity * 2 ) ) ? i_capacity : ( previousCapacity * 2 );
+	const auto result = Allocate_platformSpecific();
+	if ( result )
+	{
+		Logging::OutputMessage( "The instance buffer grew from %u to %u instances", previousCapacity, m_capacity );
+	}
+	else
+	{
+		EAE6320_ASSERTF( false, "Couldn't grow the instance buffer" );
+		m_capacity = previousCapacity;
+	}
+	return result;
+}
+
+eae6320::Graphics::cInstanceBuffer::~cInstanceBuffer()
+{
+	const auto result = CleanUp();
+	EAE6320_ASSERT( result );
+}
@@ -0,0 +1,121 @@
+/*
+	An instance buffer is a vertex buffer that holds per-instance data
+	(see VertexFormats::sInstance_mesh)
+
+	The renderer writes the data for every render command of a frame into it once,
+	and then each instanced draw call reads a contiguous range of instances from it
+*/
+
+#ifndef EAE6320_GRAPHICS_CINSTANCEBUFFER_H
+#define EAE6320_GRAPHICS_CINSTANCEBUFFER_H
+
+// Includes
+//=========
+
+#include "Configuration.h"
+
+#include <cstdint>
+#include <Engine/Results/Results.h>
+
+#ifdef EAE6320_PLATFORM_GL
+	#include "OpenGL/Includes.h"
+#endif
+
+// Forward Declarations
+//=====================
+
+#ifdef EAE6320_PLATFORM_D3D
+	struct ID3D11Buffer;
+#endif
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace VertexFormats
+		{
+			struct sInstance_mesh;
+		}
+	}
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class cInstanceBuffer
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Update
+			//-------
+
+			// Makes sure that the buffer can hold at least i_capacity instances
+			// (the contents are lost if the buffer has to grow)
+			cResult Reserve( const uint32_t i_capacity );
+
+			// Returns memory for GetCapacity() instances that can be written to until Unmap() is called
+			// (the previous contents are discarded, and so every instance that will be drawn must be written).
+			// Returns null if the buffer couldn't be mapped.
+			VertexFormats::sInstance_mesh* Map();
+			void Unmap();
+
+			// Access
+			//-------
+
+			uint32_t GetCapacity() const { return m_capacity; }
+#if defined( EAE6320_PLATFORM_D3D )
+			ID3D11Buffer* GetBuffer() const { return m_buffer; }
+#elif defined( EAE6320_PLATFORM_GL )
+			GLuint GetBufferId() const { return m_bufferId; }
+#endif
+
+			// Initialize / Clean Up
+			//----------------------
+
+			cResult Initialize( const uint32_t i_capacity );
+			cResult CleanUp();
+
+			cInstanceBuffer() = default;
+			~cInstanceBuffer();
+
+			// Data
+			//=====
+
+		private:
+
+			uint32_t m_capacity = 0;
+
+#if defined( EAE6320_PLATFORM_D3D )
+			ID3D11Buffer* m_buffer = nullptr;
+#elif defined( EAE6320_PLATFORM_GL )
+			GLuint m_bufferId = 0;
+#endif
+
+			// Implementation
+			//---------------
+
+		private:
+
+			// Initialize / Clean Up
+			//----------------------
+
+			cResult Initialize_platformSpecific();
+			// Allocates storage for m_capacity instances
+			cResult Allocate_platformSpecific();
+
+			cInstanceBuffer( const cInstanceBuffer& ) = delete;
+			cInstanceBuffer( cInstanceBuffer&& ) = delete;
+			cInstanceBuffer& operator =( const cInstanceBuffer& ) = delete;
+			cInstanceBuffer& operator =( cInstanceBuffer&& ) = delete;
+		};
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_CINSTANCEBUFFER_H
@@ -1,17 +1,27 @@
 #include "cMaterial.h"
 #include "cEffect.h"
+#include "ConstantBufferFormats.h"
+#include "cSortIdAllocator.h"
 
 #include <Engine/ScopeGuard/cScopeGuard.h>
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Logging/Logging.h>
 #include <Engine/Platform/Platform.h>
 
+// Static Data
+//============
+
+namespace
+{
+	eae6320::Graphics::cSortIdAllocator s_sortIdAllocator;
+}
+
 // Helper Class Declaration
 //=========================
 
 namespace
 {
-	eae6320::cResult Loadmaterial( const void* i_dataBuffer, uint32_t& o_dataOffset, eae6320::Graphics::sMaterialInfo& o_materialInfo );
+	eae6320::cResult Loadmaterial( const void* i_dataBuffer, const uint32_t i_dataSize, uint32_t& o_dataOffset, eae6320::Graphics::sMaterialInfo& o_materialInfo );
 }
 
 // Interface
@@ -20,7 +30,7 @@ namespace
 // Initialize / Clean Up
 //----------------------
 
-eae6320::cResult eae6320::Graphics::cMaterial::Load( const void* i_dataBuffer, uint32_t& o_dataOffset, cMaterial*& o_material )
+eae6320::cResult eae6320::Graphics::cMaterial::Load( const void* i_dataBuffer, const uint32_t i_dataSize, uint32_t& o_dataOffset, cMaterial*& o_material )
 {
 	auto result = Results::Success;
 
@@ -59,7 +69,7 @@ eae6320::cResult eae6320::Graphics::cMaterial::Load( const void* i_dataBuffer, u
 	uint32_t currentOffset = 0;
 	sMaterialInfo materialInfo;
 
-	if ( !( result = Loadmaterial( i_dataBuffer, currentOffset, materialInfo ) ) )
+	if ( !( result = Loadmaterial( i_dataBuffer, i_dataSize, currentOffset, materialInfo ) ) )
 	{
 		EAE6320_ASSERTF( false, "Load material info failed!" );
 		return result;
@@ -79,10 +89,11 @@ eae6320::cResult eae6320::Graphics::cMaterial::Load( const void* i_dataBuffer, u
 
 eae6320::cResult eae6320::Graphics::cMaterial::CleanUp()
 {
-	if ( m_effect )
+	m_effect = nullptr;
+	if ( m_effectHandle )
 	{
-		m_effect->DecrementReferenceCount();
-		m_effect = nullptr;
+		const auto result_effect = cEffect::s_manager.Release( m_effectHandle );
+		EAE6320_ASSERT( result_effect );
 	}
 
 	m_baseColorTexture.CleanUp();
@@ -91,11 +102,18 @@ eae6320::cResult eae6320::Graphics::cMaterial::CleanUp()
 	m_transparencyTexture.CleanUp();
 	m_normalTexture.CleanUp();
 
-	return Results::Success;
+	auto result = m_constantBuffer.CleanUp();
+	EAE6320_ASSERT( result );
+
+	return result;
 }
 
 eae6320::Graphics::cMaterial::cMaterial()
+	:
+	m_constantBuffer( ConstantBufferTypes::Material )
 {
+	m_sortId = s_sortIdAllocator.Acquire();
+
 	m_baseColorTexture.m_textureType = eTextureType::BaseColorTexture;
 
 	m_specularColorTexture.m_textureType = eTextureType::SpecularTexture;
@@ -111,154 +129,142 @@ eae6320::Graphics::cMaterial::~cMaterial()
 {
 	const auto result = CleanUp();
 	EAE6320_ASSERT( result );
+
+	s_sortIdAllocator.Release( m_sortId );
 }
 
-namespace
+eae6320::cResult eae6320::Graphics::cMaterial::LoadEffect()
 {
-	eae6320::cResult Loadmaterial( const void* i_dataBuffer, uint32_t& o_dataOffset, eae6320::Graphics::sMaterialInfo& o_materialInfo )
-	{
-		auto result = eae6320::Results::Success;
-
-		auto currentOffset = reinterpret_cast<uintptr_t>( i_dataBuffer );
+	auto result = Results::Success;
 
-		char* filePath = new ( std::nothrow ) char[255];
-		if ( !filePath )
-		{
-			return eae6320::Results::Failure;
-		}
-		// Load Base Color Texture
+	// Every material currently uses the same lighting model
+	cEffect::sKey effectKey;
+	{
+		effectKey.vertexShaderPath = "data/Shaders/Vertex/lambert.shader";
+		effectKey.fragmentShaderPath = "data/Shaders/Fragment/lambert.shader";
+		constexpr auto renderStateBits = []
 		{
-			memcpy( reinterpret_cast<void*>( o_materialInfo.m_baseColor ), reinterpret_cast<void*>( currentOffset ), 3 * sizeof( float ) );
-			currentOffset += 3 * sizeof( float );
-			o_dataOffset += 3 * sizeof( float );
-
-			uint8_t filePathLen = 0;
-			memcpy( &filePathLen, reinterpret_cast<void*>( currentOffset ), sizeof( uint8_t ) );
-			currentOffset += sizeof( uint8_t );
-			o_dataOffset += sizeof( uint8_t );
+			uint8_t renderStateBits = 0;
 
-			if ( filePathLen > 0 )
-			{
-				memset( filePath, 0, 255 );
-				memcpy( reinterpret_cast<void*>( filePath ), reinterpret_cast<void*>( currentOffset ), filePathLen );
+			RenderStates::EnableAlphaTransparency( renderStateBits );
+			RenderStates::EnableDepthTesting( renderStateBits );
+			RenderStates::EnableDepthWriting( renderStateBits );
+			RenderStates::DisableDrawingBothTriangleSides( renderStateBits );
 
-				o_materialInfo.m_baseColorTexturePath = filePath;
-			}
+			return renderStateBits;
+		}();
+		effectKey.renderStateBits = renderStateBits;
+	}
+	if ( !( result = cEffect::s_manager.Load( effectKey, m_effectHandle ) ) )
+	{
+		EAE6320_ASSERTF( false, "Can't initialize the material without an effect" );
+		return result;
+	}
+	m_effect = cEffect::s_manager.Get( m_effectHandle );
+	EAE6320_ASSERT( m_effect );
 
-			currentOffset += filePathLen;
-			o_dataOffset += filePathLen;
-		}
+	return result;
+}
 
-		// Load Specular Color Texture
-		{
-			memcpy( reinterpret_cast<void*>( o_materialInfo.m_specularColor ), reinterpret_cast<void*>( currentOffset ), 3 * sizeof( float ) );
-			currentOffset += 3 * sizeof( float );
-			o_dataOffset += 3 * sizeof( float );
+eae6320::cResult eae6320::Graphics::cMaterial::InitializeConstantBuffer()
+{
+	ConstantBufferFormats::sMaterial constantData_material;
+	for ( auto i = 0; i < 3; ++i )
+	{
+		constantData_material.g_baseColor[i] = m_baseColor[i];
+		constantData_material.g_specularColor[i] = m_specularColor[i];
+	}
+	constantData_material.g_opacity = 1.0f - m_transparency[0];
 
-			uint8_t filePathLen = 0;
-			memcpy( &filePathLen, reinterpret_cast<void*>( currentOffset ), sizeof( uint8_t ) );
-			currentOffset += sizeof( uint8_t );
-			o_dataOffset += sizeof( uint8_t );
+	const auto result = m_constantBuffer.Initialize( &constantData_material );
+	if ( !result )
+	{
+		EAE6320_ASSERTF( false, "Can't initialize the material constant buffer" );
+		Logging::OutputError( "Failed to initialize the material constant buffer" );
+	}
 
-			if ( filePathLen > 0 )
-			{
-				memset( filePath, 0, 255 );
-				memcpy( reinterpret_cast<void*>( filePath ), reinterpret_cast<void*>( currentOffset ), filePathLen );
+	return result;
+}
 
-				o_materialInfo.m_specularColorTexturePath = filePath;
-			}
+eae6320::cResult eae6320::Graphics::cMaterial::LoadTextures( const sMaterialInfo& i_materialInfo )
+{
+	auto result = Results::Success;
 
-			currentOffset += filePathLen;
-			o_dataOffset += filePathLen;
-		}
+	const std::string meshPathDictionary = "data/Meshes/";
 
-		// Load Ambient Texture 
+	const struct
+	{
+		const std::string& path;
+		sTexture& texture;
+	} texturesToLoad[] =
+	{
+		{ i_materialInfo.m_baseColorTexturePath, m_baseColorTexture },
+		{ i_materialInfo.m_specularColorTexturePath, m_specularColorTexture },
+		{ i_materialInfo.m_ambientColorTexturePath, m_ambientColorTexture },
+		{ i_materialInfo.m_normalTexturePath, m_normalTexture },
+		{ i_materialInfo.m_transparencyTexturePath, m_transparencyTexture },
+	};
+	for ( const auto& textureToLoad : texturesToLoad )
+	{
+		if ( !textureToLoad.path.empty() )
 		{
-			memcpy( reinterpret_cast<void*>( o_materialInfo.m_ambient ), reinterpret_cast<void*>( currentOffset ), 3 * sizeof( float ) );
-			currentOffset += 3 * sizeof( float );
-			o_dataOffset += 3 * sizeof( float );
-
-			uint8_t filePathLen = 0;
-			memcpy( &filePathLen, reinterpret_cast<void*>( currentOffset ), sizeof( uint8_t ) );
-			currentOffset += sizeof( uint8_t );
-			o_dataOffset += sizeof( uint8_t );
-
-			if ( filePathLen > 0 )
+			if ( !( result = textureToLoad.texture.Load( meshPathDictionary + textureToLoad.path ) ) )
 			{
-				memset( filePath, 0, 255 );
-				memcpy( reinterpret_cast<void*>( filePath ), reinterpret_cast<void*>( currentOffset ), filePathLen );
-
-				o_materialInfo.m_ambientColorTexturePath = filePath;
+				return result;
 			}
-
-			currentOffset += filePathLen;
-			o_dataOffset += filePathLen;
 		}
+	}
 
-		// Load Transparency Texture 
-		{
-			memcpy( reinterpret_cast<void*>( o_materialInfo.m_transparency ), reinterpret_cast<void*>( currentOffset ), 3 * sizeof( float ) );
-			currentOffset += 3 * sizeof( float );
-			o_dataOffset += 3 * sizeof( float );
+	return result;
+}
 
-			uint8_t filePathLen = 0;
-			memcpy( &filePathLen, reinterpret_cast<void*>( currentOffset ), sizeof( uint8_t ) );
-			currentOffset += sizeof( uint8_t );
-			o_dataOffset += sizeof( uint8_t );
+namespace
+{
+	eae6320::cResult Loadmaterial( const void* i_dataBuffer, const uint32_t i_dataSize, uint32_t& o_dataOffset, eae6320::Graphics::sMaterialInfo& o_materialInfo )
+	{
+		const auto* const data = static_cast<const uint8_t*>( i_dataBuffer );
+		o_dataOffset = 0;
 
-			if ( filePathLen > 0 )
+		// Every read is checked against the size of the data that is left
+		// so that a truncated or corrupt file fails instead of reading past the end of its materials
+		const auto Read = [data, i_dataSize, &o_dataOffset]( void* const o_destination, const size_t i_size )
+		{
+			if ( i_size > ( i_dataSize - o_dataOffset ) )
 			{
-				memset( filePath, 0, 255 );
-				memcpy( reinterpret_cast<void*>( filePath ), reinterpret_cast<void*>( currentOffset ), filePathLen );
-
-				o_materialInfo.m_transparencyTexturePath = filePath;
+				return false;
 			}
-
-			currentOffset += filePathLen;
-			o_dataOffset += filePathLen;
-		}
-
-		// Load Normal Texture
+			memcpy( o_destination, data + o_dataOffset, i_size );
+			o_dataOffset += static_cast<uint32_t>( i_size );
+			return true;
+		};
+		// Each texture path is stored as its length (a single byte) followed by its characters
+		const auto ReadTexturePath = [data, i_dataSize, &o_dataOffset, &Read]( std::string& o_path )
 		{
 			uint8_t filePathLen = 0;
-			memcpy( &filePathLen, reinterpret_cast<void*>( currentOffset ), sizeof( uint8_t ) );
-			currentOffset += sizeof( uint8_t );
-			o_dataOffset += sizeof( uint8_t );
-
+			if ( !Read( &filePathLen, sizeof( filePathLen ) ) || ( filePathLen > ( i_dataSize - o_dataOffset ) ) )
+			{
+				return false;
+			}
 			if ( filePathLen > 0 )
 			{
-				memset( filePath, 0, 255 );
-				memcpy( reinterpret_cast<void*>( filePath ), reinterpret_cast<void*>( currentOffset ), filePathLen );
-
-				o_materialInfo.m_normalTexturePath = filePath;
+				o_path.assign( reinterpret_cast<const char*>( data + o_dataOffset ), filePathLen );
 			}
-
-			currentOffset += filePathLen;
 			o_dataOffset += filePathLen;
-		}
-
-		// Load vertex range
-		{
-			memcpy( &o_materialInfo.m_vertexRange.first, reinterpret_cast<void*>( currentOffset ), sizeof( uint32_t ) );
-			currentOffset += sizeof( uint32_t );
-			o_dataOffset += sizeof( uint32_t );
-
-			memcpy( &o_materialInfo.m_vertexRange.last, reinterpret_cast<void*>( currentOffset ), sizeof( uint32_t ) );
-			currentOffset += sizeof( uint32_t );
-			o_dataOffset += sizeof( uint32_t );
-		}
-
-		// Load index range
+			return true;
+		};
+
+		if ( !Read( o_materialInfo.m_baseColor, 3 * sizeof( float ) ) || !ReadTexturePath( o_materialInfo.m_baseColorTexturePath )
+			|| !Read( o_materialInfo.m_specularColor, 3 * sizeof( float ) ) || !ReadTexturePath( o_materialInfo.m_specularColorTexturePath )
+			|| !Read( o_materialInfo.m_ambient, 3 * sizeof( float ) ) || !ReadTexturePath( o_materialInfo.m_ambientColorTexturePath )
+			|| !Read( o_materialInfo.m_transparency, 3 * sizeof( float ) ) || !ReadTexturePath( o_materialInfo.m_transparencyTexturePath )
+			|| !ReadTexturePath( o_materialInfo.m_normalTexturePath )
+			|| !Read( &o_materialInfo.m_vertexRange.first, sizeof( uint32_t ) ) || !Read( &o_materialInfo.m_vertexRange.last, sizeof( uint32_t ) )
+			|| !Read( &o_materialInfo.m_indexRange.first, sizeof( uint32_t ) ) || !Read( &o_materialInfo.m_indexRange.last, sizeof( uint32_t ) ) )
 		{
-			memcpy( &o_materialInfo.m_indexRange.first, reinterpret_cast<void*>( currentOffset ), sizeof( uint32_t ) );
-			currentOffset += sizeof( uint32_t );
-			o_dataOffset += sizeof( uint32_t );
-
-			memcpy( &o_materialInfo.m_indexRange.last, reinterpret_cast<void*>( currentOffset ), sizeof( uint32_t ) );
-			currentOffset += sizeof( uint32_t );
-			o_dataOffset += sizeof( uint32_t );
+			eae6320::Logging::OutputError( "A material's data would continue past the end of the %u bytes that are left", i_dataSize );
+			return eae6320::Results::InvalidFile;
 		}
 
-		return result;
+		return eae6320::Results::Success;
 	}
 }
\ No newline at end of file
@@ -5,10 +5,12 @@
 // Includes
 //=========
 
+#include <Engine/Assets/cHandle.h>
 #include <Engine/Assets/ReferenceCountedAssets.h>
 
 #include <Engine/Results/Results.h>
 
+#include "cConstantBuffer.h"
 #include "sTexture.h"
 
 // Class Declaration
@@ -58,7 +60,9 @@ namespace eae6320
 			// Initialization / Clean Up
 			//--------------------------
 
-			static cResult Load( const void* i_dataBuffer, uint32_t& o_dataOffset, cMaterial*& o_material );
+			// The material's data can't be bigger than i_dataSize,
+			// and o_dataOffset is set to how much of it was read
+			static cResult Load( const void* i_dataBuffer, const uint32_t i_dataSize, uint32_t& o_dataOffset, cMaterial*& o_material );
 
 			EAE6320_ASSETS_DECLAREDELETEDREFERENCECOUNTEDFUNCTIONS( cMaterial );
 
@@ -87,6 +91,13 @@ namespace eae6320
 			//--------------------------
 
 			cResult Initialize( const sMaterialInfo& i_materialInfo );
+			// The effect is shared with every other material that uses the same shaders and render state
+			cResult LoadEffect();
+			// Uploads the authored colors once
+			// (binding the material then only binds the constant buffer)
+			cResult InitializeConstantBuffer();
+			// Textures are shared with every other material that uses the same file
+			cResult LoadTextures( const sMaterialInfo& i_materialInfo );
 
 			cResult CleanUp();
 
@@ -96,6 +107,9 @@ namespace eae6320
 			// Data
 			//=====
 
+			// The effect is looked up once when it is loaded
+			// (the pointer stays valid for as long as the handle is held)
+			Assets::cHandle<class cEffect> m_effectHandle;
 			class cEffect* m_effect = nullptr;
 
 			float m_baseColor[3] = { 0 };
@@ -112,9 +126,21 @@ namespace eae6320
 
 			sTexture m_normalTexture;
 
+			cConstantBuffer m_constantBuffer;
+
+			uint16_t m_sortId = 0;
+
 		public:
 			
 			void Bind();
+
+			// Access
+			//-------
+
+			uint16_t GetSortId() const { return m_sortId; }
+			class cEffect* GetEffect() const { return m_effect; }
+			// A material with any transparency has to be drawn after the opaque geometry
+			bool IsTranslucent() const { return m_transparency[0] > 0.0f; }
 		};
 	}
 }
@@ -2,21 +2,38 @@
 //=========
 
 #include "cMesh.h"
+#include "cInstanceBuffer.h"
 #include "cMaterial.h"
+#include "cSortIdAllocator.h"
+#include "MeshFormats.h"
 
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Concurrency/cMutex.h>
 #include <Engine/Logging/Logging.h>
 #include <Engine/Platform/Platform.h>
 #include <Engine/ScopeGuard/cScopeGuard.h>
+#include <cstring>
+#include <limits>
 #include "VertexFormats.h"
 
+// Static Data
+//============
+
+namespace
+{
+	eae6320::Graphics::cSortIdAllocator s_sortIdAllocator;
+}
+
 // Helper Class Declaration
 //=========================
 
 namespace
 {
-	eae6320::cResult LoadMesh( const char* const i_path, eae6320::Graphics::VertexFormats::sVertex_mesh*& o_vertexData, void*& o_indices, uint32_t& o_triangleCount, uint32_t& o_vertexCount, uint16_t& o_materialsCount, eae6320::Graphics::cMaterial**& o_materials );
+	// The vertex and index data point into the mapped file
+	eae6320::cResult LoadMesh( const char* const i_path, eae6320::Platform::sMappedFile& o_mappedFile, const eae6320::Graphics::VertexFormats::sVertex_mesh*& o_vertexData, const void*& o_indices, uint32_t& o_triangleCount, uint32_t& o_vertexCount, eae6320::Graphics::MeshFormats::sBounds& o_bounds,
+		eae6320::Graphics::MeshFormats::sBounds*& o_submeshBounds, eae6320::Graphics::MeshFormats::sSubmesh*& o_submeshes, uint8_t& o_lodCount, float* const o_lodErrors,
+		eae6320::Graphics::cMesh::sOccluder& o_occluder, eae6320::Graphics::MeshFormats::sMeshlet*& o_meshlets, uint32_t*& o_submeshMeshletRanges, uint32_t& o_meshletCount,
+		uint16_t& o_materialsCount, eae6320::Graphics::cMaterial**& o_materials );
 }
 
 // Interface
@@ -31,10 +48,7 @@ eae6320::cResult eae6320::Graphics::cMesh::Load( const std::string& i_meshPath,
 
 	cMesh* newMesh = nullptr;
 
-	VertexFormats::sVertex_mesh* vertexData = nullptr;
-	void* indices = nullptr;
-
-	cScopeGuard scopeGuard( [&o_mesh, &result, &newMesh, &vertexData, &indices]
+	cScopeGuard scopeGuard( [&o_mesh, &result, &newMesh]
 		{
 			if (result)
 			{
@@ -50,18 +64,6 @@ eae6320::cResult eae6320::Graphics::cMesh::Load( const std::string& i_meshPath,
 				}
 				o_mesh = newMesh;
 			}
-
-			if ( vertexData )
-			{
-				delete[] vertexData;
-				vertexData = nullptr;
-			}
-
-			if ( indices )
-			{
-				delete[] indices;
-				indices = nullptr;
-			}
 		} );
 
 	// Allocate a new mesh
@@ -78,13 +80,42 @@ eae6320::cResult eae6320::Graphics::cMesh::Load( const std::string& i_meshPath,
 
 	// Load Mesh Data
 
+	// The file is mapped rather than read
+	// so that the vertices and indices are uploaded without being copied first
+	Platform::sMappedFile mappedFile;
+	const VertexFormats::sVertex_mesh* vertexData = nullptr;
+	const void* indices = nullptr;
+
 	uint32_t triangleCount = 0;
 	uint32_t vertexCount = 0;
 
 	uint16_t materialsCount = 0;
 	eae6320::Graphics::cMaterial** materials = nullptr;
+	// The materials only belong to the mesh once it has been initialized,
+	// and so if loading fails before then (including partway through the materials)
+	// the ones that were loaded are released here
+	cScopeGuard scopeGuard_materials( [&result, &materialsCount, &materials]
+		{
+			if ( !result && materials )
+			{
+				for ( uint16_t i = 0; i < materialsCount; ++i )
+				{
+					if ( materials[i] )
+					{
+						materials[i]->DecrementReferenceCount();
+					}
+				}
+				delete[] materials;
+				materials = nullptr;
+			}
+		} );
 
-	LoadMesh( i_meshPath.c_str(), vertexData, indices, triangleCount, vertexCount, materialsCount, materials );
+	if ( !( result = LoadMesh( i_meshPath.c_str(), mappedFile, vertexData, indices, triangleCount, vertexCount, newMesh->m_bounds,
+		newMesh->m_submeshBounds, newMesh->m_submeshes, newMesh->m_lodCount, newMesh->m_lodErrors, newMesh->m_occluder,
+		newMesh->m_meshlets, newMesh->m_submeshMeshletRanges, newMesh->m_meshletCount, materialsCount, materials ) ) )
+	{
+		return result;
+	}
 
 	// Initialize the platform-specific graphics API mesh object
 	if ( !( result = newMesh->Initialize( vertexData, indices, triangleCount, vertexCount, materialsCount, materials ) ) )
@@ -93,9 +124,80 @@ eae6320::cResult eae6320::Graphics::cMesh::Load( const std::string& i_meshPath,
 		return result;
 	}
 
+	// The GPU has its own copy of the data now
+	mappedFile.Unmap();
+
 	return result;
 }
 
+// Render
+//-------
+
+void eae6320::Graphics::cMesh::Draw( const cInstanceBuffer& i_instanceBuffer, const uint32_t i_firstInstance, const uint32_t i_instanceCount, const uint8_t i_lod )
+{
+	EAE6320_ASSERT( ( i_firstInstance + i_instanceCount ) <= i_instanceBuffer.GetCapacity() );
+
+	if ( !BindGeometry( i_instanceBuffer ) )
+	{
+		return;
+	}
+	// Each submesh is a range of the index buffer
+	EAE6320_ASSERT( i_lod < m_lodCount );
+	const auto submeshCount = GetSubmeshCount();
+	const auto* const submeshes = m_submeshes + ( static_cast<size_t>( ( i_lod < m_lodCount ) ? i_lod : 0 ) * submeshCount );
+	for ( uint16_t i = 0; i < submeshCount; ++i )
+	{
+		if ( submeshes[i].indexCount == 0 )
+		{
+			continue;
+		}
+		if ( m_materialsCount > 0 )
+		{
+			m_materials[i]->Bind();
+		}
+		DrawIndices( submeshes[i].firstIndex, submeshes[i].indexCount, i_firstInstance, i_instanceCount );
+	}
+}
+
+void eae6320::Graphics::cMesh::Draw( const cInstanceBuffer& i_instanceBuffer, const uint32_t i_firstInstance, const uint32_t i_instanceCount,
+	const sDrawRange* const i_ranges, const uint32_t i_rangeCount )
+{
+	EAE6320_ASSERT( ( i_firstInstance + i_instanceCount ) <= i_instanceBuffer.GetCapacity() );
+
+	if ( ( i_rangeCount == 0 ) || !BindGeometry( i_instanceBuffer ) )
+	{
+		return;
+	}
+	// Neither Direct3D 11 nor OpenGL 4.2 can draw several ranges of instances with one call,
+	// and so each range is its own draw call (but nothing else is bound between them)
+	auto submeshIndex_bound = std::numeric_limits<uint16_t>::max();
+	for ( uint32_t i = 0; i < i_rangeCount; ++i )
+	{
+		const auto& range = i_ranges[i];
+		EAE6320_ASSERT( range.submeshIndex < GetSubmeshCount() );
+		if ( ( m_materialsCount > 0 ) && ( range.submeshIndex != submeshIndex_bound ) )
+		{
+			m_materials[range.submeshIndex]->Bind();
+			submeshIndex_bound = range.submeshIndex;
+		}
+		DrawIndices( range.firstIndex, range.indexCount, i_firstInstance, i_instanceCount );
+	}
+}
+
+// Level of Detail
+//----------------
+
+uint8_t eae6320::Graphics::cMesh::SelectLod( const float i_errorScale, const float i_maximumError ) const
+{
+	// The errors increase with each level
+	uint8_t lod = 0;
+	while ( ( ( lod + 1 ) < m_lodCount ) && ( ( m_lodErrors[lod + 1] * i_errorScale ) <= i_maximumError ) )
+	{
+		++lod;
+	}
+	return lod;
+}
+
 // Implementation
 //===============
 
@@ -104,6 +206,8 @@ eae6320::cResult eae6320::Graphics::cMesh::Load( const std::string& i_meshPath,
 
 eae6320::Graphics::cMesh::cMesh()
 {
+	m_sortId = s_sortIdAllocator.Acquire();
+
 	m_triangleCount = 0;
 }
 
@@ -111,6 +215,8 @@ eae6320::Graphics::cMesh::~cMesh()
 {
 	const auto result = CleanUp();
 	EAE6320_ASSERT(result);
+
+	s_sortIdAllocator.Release( m_sortId );
 }
 
 // Helper Definitions
@@ -118,90 +224,319 @@ eae6320::Graphics::cMesh::~cMesh()
 
 namespace
 {
-	eae6320::cResult LoadMesh( const char* const i_path, eae6320::Graphics::VertexFormats::sVertex_mesh*& o_vertexData, void*& o_indices, uint32_t& o_triangleCount, uint32_t& o_vertexCount, uint16_t& o_materialsCount, eae6320::Graphics::cMaterial**& o_materials )
+	eae6320::cResult LoadMesh( const char* const i_path, eae6320::Platform::sMappedFile& o_mappedFile, const eae6320::Graphics::VertexFormats::sVertex_mesh*& o_vertexData, const void*& o_indices, uint32_t& o_triangleCount, uint32_t& o_vertexCount, eae6320::Graphics::MeshFormats::sBounds& o_bounds,
+		eae6320::Graphics::MeshFormats::sBounds*& o_submeshBounds, eae6320::Graphics::MeshFormats::sSubmesh*& o_submeshes, uint8_t& o_lodCount, float* const o_lodErrors,
+		eae6320::Graphics::cMesh::sOccluder& o_occluder, eae6320::Graphics::MeshFormats::sMeshlet*& o_meshlets, uint32_t*& o_submeshMeshletRanges, uint32_t& o_meshletCount,
+		uint16_t& o_materialsCount, eae6320::Graphics::cMaterial**& o_materials )
 	{
+		using namespace eae6320::Graphics;
+
 		auto result = eae6320::Results::Success;
 
-		eae6320::Platform::sDataFromFile dataFromFile;
 		std::string errorMessage;
 
-		if ( !( result = eae6320::Platform::LoadBinaryFile( i_path, dataFromFile, &errorMessage ) ) )
+		if ( !( result = eae6320::Platform::MapFileReadOnly( i_path, o_mappedFile, &errorMessage ) ) )
 		{
 			EAE6320_ASSERTF( false, errorMessage.c_str() );
 			eae6320::Logging::OutputError( "Failed to load mesh from file %s: %s", i_path, errorMessage.c_str() );
 			return result;
 		}
 
-		auto currentOffset = reinterpret_cast<uintptr_t>( dataFromFile.data );
-		memcpy( &o_vertexCount, reinterpret_cast<void*>( currentOffset ), sizeof( o_vertexCount ) );
-
-		currentOffset += sizeof( o_vertexCount );
-		o_vertexData = new (std::nothrow) eae6320::Graphics::VertexFormats::sVertex_mesh[o_vertexCount];
+		// Reading past the end of a mapping is an access violation
+		// and so every offset is validated against the size of the file
+		const auto IsInFile = [&o_mappedFile]( const size_t i_offset, const size_t i_size )
+		{
+			return ( i_offset <= o_mappedFile.size ) && ( i_size <= ( o_mappedFile.size - i_offset ) );
+		};
+		const auto* const fileData = static_cast<const uint8_t*>( o_mappedFile.data );
+		const auto OutputInvalidFileError = [i_path]( const char* const i_reason )
+		{
+			EAE6320_ASSERTF( false, "The mesh file %s is invalid: %s", i_path, i_reason );
+			eae6320::Logging::OutputError( "The mesh file %s is invalid: %s", i_path, i_reason );
+			return eae6320::Results::InvalidFile;
+		};
 
-		if ( !o_vertexData )
+		// Validate the header
+		MeshFormats::sHeader header;
 		{
-			result = eae6320::Results::OutOfMemory;
-			eae6320::Logging::OutputError( "Couldn't allocate memory for the vertices data." );
-			return result;
+			if ( !IsInFile( 0, sizeof( header ) ) )
+			{
+				return result = OutputInvalidFileError( "It is too small to have a header" );
+			}
+			memcpy( &header, fileData, sizeof( header ) );
+			if ( ( header.fourCc != MeshFormats::sHeader::s_fourCc ) || ( header.version != MeshFormats::sHeader::s_version ) )
+			{
+				return result = OutputInvalidFileError( "It isn't a built mesh of the current version (it must be rebuilt)" );
+			}
+			if ( header.vertexSize != sizeof( VertexFormats::sVertex_mesh ) )
+			{
+				return result = OutputInvalidFileError( "Its vertex format doesn't match the game's" );
+			}
+			const auto expectedIndexSize = ( header.indexCount > std::numeric_limits<uint16_t>::max() ) ? sizeof( uint32_t ) : sizeof( uint16_t );
+			if ( header.indexSize != expectedIndexSize )
+			{
+				return result = OutputInvalidFileError( "Its index size doesn't match its index count" );
+			}
+			if ( !IsInFile( sizeof( header ), sizeof( MeshFormats::sSection ) * header.sectionCount ) )
+			{
+				return result = OutputInvalidFileError( "It is too small for its section table" );
+			}
 		}
-
-		memcpy( o_vertexData, reinterpret_cast<void*>( currentOffset ), sizeof( eae6320::Graphics::VertexFormats::sVertex_mesh ) * o_vertexCount );
-
-		currentOffset += sizeof( eae6320::Graphics::VertexFormats::sVertex_mesh ) * o_vertexCount;
-		uint32_t indexCount = 0;
-		memcpy( &indexCount, reinterpret_cast<void*>( currentOffset ), sizeof( uint32_t) );
-		o_triangleCount = indexCount / 3;
-
-		currentOffset += sizeof( uint32_t );
-		bool is32 = indexCount > std::numeric_limits<uint16_t>::max();
-		size_t dataSize = is32 ? sizeof( uint32_t ) : sizeof( uint16_t );
-
-		if( is32 )
-			o_indices = (uint32_t*) malloc( dataSize * indexCount );
-		else
-			o_indices = (uint16_t*) malloc( dataSize * indexCount );
-
-		if ( !o_indices )
+#ifdef EAE6320_ASSERTS_AREENABLED
+		// Verifying the checksum touches every page of the file
+		// and so it is only done in builds that are being debugged
 		{
-			result = eae6320::Results::OutOfMemory;
-			eae6320::Logging::OutputError( "Couldn't allocate memory for the indices data." );
-			return result;
+			const auto offset_data = sizeof( header ) + ( sizeof( MeshFormats::sSection ) * header.sectionCount );
+			if ( MeshFormats::CalculateChecksum( fileData + offset_data, o_mappedFile.size - offset_data ) != header.checksum )
+			{
+				return result = OutputInvalidFileError( "Its checksum doesn't match its contents" );
+			}
+		}
+#endif
+		// Find the sections
+		// (sections that this version of the game doesn't use are skipped)
+		const MeshFormats::sSection* section_vertices = nullptr;
+		const MeshFormats::sSection* section_indices = nullptr;
+		const MeshFormats::sSection* section_submeshes = nullptr;
+		const MeshFormats::sSection* section_bounds = nullptr;
+		const MeshFormats::sSection* section_materials = nullptr;
+		const MeshFormats::sSection* section_lods = nullptr;
+		const MeshFormats::sSection* section_submeshBounds = nullptr;
+		const MeshFormats::sSection* section_occluder = nullptr;
+		const MeshFormats::sSection* section_meshlets = nullptr;
+		const auto* const sections = reinterpret_cast<const MeshFormats::sSection*>( fileData + sizeof( header ) );
+		for ( uint8_t i = 0; i < header.sectionCount; ++i )
+		{
+			const auto& section = sections[i];
+			if ( ( ( section.offset % MeshFormats::dataAlignment ) != 0 ) || !IsInFile( section.offset, section.size ) )
+			{
+				return result = OutputInvalidFileError( "A section is misaligned or outside of the file" );
+			}
+			switch ( section.type )
+			{
+			case MeshFormats::eSection::Vertices: section_vertices = &section; break;
+			case MeshFormats::eSection::Indices: section_indices = &section; break;
+			case MeshFormats::eSection::Submeshes: section_submeshes = &section; break;
+			case MeshFormats::eSection::Bounds: section_bounds = &section; break;
+			case MeshFormats::eSection::Materials: section_materials = &section; break;
+			case MeshFormats::eSection::Lods: section_lods = &section; break;
+			case MeshFormats::eSection::SubmeshBounds: section_submeshBounds = &section; break;
+			case MeshFormats::eSection::Occluder: section_occluder = &section; break;
+			case MeshFormats::eSection::Meshlets: section_meshlets = &section; break;
+			default: break;
+			}
 		}
 
-		memcpy( o_indices, reinterpret_cast<void*>( currentOffset ), dataSize * indexCount );
-
-		currentOffset += dataSize * indexCount;
-		auto dataEndPoint = reinterpret_cast<uintptr_t>( dataFromFile.data );
-		dataEndPoint += dataFromFile.size;
-
-		// Extra materials
-		if ( currentOffset != dataEndPoint )
+		// Vertices and indices are used straight from the mapping
+		if ( !section_vertices || ( section_vertices->size != ( static_cast<size_t>( header.vertexSize ) * header.vertexCount ) ) )
+		{
+			return result = OutputInvalidFileError( "Its vertices are missing or the wrong size" );
+		}
+		if ( !section_indices || ( section_indices->size != ( static_cast<size_t>( header.indexSize ) * header.indexCount ) ) )
 		{
-			memcpy( &o_materialsCount, reinterpret_cast<void*>( currentOffset ), sizeof( uint16_t ) );
-			currentOffset += sizeof( uint16_t );
+			return result = OutputInvalidFileError( "Its indices are missing or the wrong size" );
+		}
+		o_vertexCount = header.vertexCount;
+		o_vertexData = reinterpret_cast<const VertexFormats::sVertex_mesh*>( fileData + section_vertices->offset );
+		o_triangleCount = header.indexCount / 3;
+		o_indices = fileData + section_indices->offset;
 
-			if( o_materialsCount > 0 )
+		// Every level of detail has a submesh for every material
+		// (and the submeshes are what is drawn)
+		{
+			const uint32_t submeshCount = ( section_materials && ( section_materials->count > 0 ) ) ? section_materials->count : 1;
+			if ( !section_submeshes || ( section_submeshes->count != submeshCount )
+				|| ( section_submeshes->size != ( sizeof( MeshFormats::sSubmesh ) * submeshCount ) ) )
 			{
-				o_materials = new (std::nothrow) eae6320::Graphics::cMaterial*[o_materialsCount];
-				if ( !o_materials )
+				return result = OutputInvalidFileError( "Its submeshes are missing or don't match its materials" );
+			}
+			uint32_t lodCount = 1;
+			if ( section_lods && ( section_lods->count > 0 ) )
+			{
+				if ( section_lods->count >= MeshFormats::maxLodCount )
 				{
-					result = eae6320::Results::OutOfMemory;
-					eae6320::Logging::OutputError( "Couldn't allocate memory for the materials data." );
-					return result;
+					return result = OutputInvalidFileError( "It has too many levels of detail" );
 				}
-
-				for ( auto i = 0; i < o_materialsCount; ++i )
+				if ( section_lods->size != ( ( sizeof( MeshFormats::sLod ) + ( sizeof( MeshFormats::sSubmesh ) * submeshCount ) ) * section_lods->count ) )
+				{
+					return result = OutputInvalidFileError( "Its levels of detail are the wrong size" );
+				}
+				lodCount += section_lods->count;
+			}
+			o_submeshes = new (std::nothrow) MeshFormats::sSubmesh[lodCount * submeshCount];
+			if ( !o_submeshes )
+			{
+				result = eae6320::Results::OutOfMemory;
+				EAE6320_ASSERTF( false, "Couldn't allocate memory for the submeshes" );
+				eae6320::Logging::OutputError( "Failed to allocate memory for the submeshes of %s", i_path );
+				return result;
+			}
+			memcpy( o_submeshes, fileData + section_submeshes->offset, section_submeshes->size );
+			o_lodErrors[0] = 0.0f;
+			if ( lodCount > 1 )
+			{
+				const auto lodsSize = sizeof( MeshFormats::sLod ) * section_lods->count;
+				const auto* const lods = reinterpret_cast<const MeshFormats::sLod*>( fileData + section_lods->offset );
+				for ( uint32_t i = 0; i < section_lods->count; ++i )
+				{
+					o_lodErrors[i + 1] = lods[i].error;
+				}
+				memcpy( o_submeshes + submeshCount, fileData + section_lods->offset + lodsSize, section_lods->size - lodsSize );
+			}
+			o_lodCount = static_cast<uint8_t>( lodCount );
+			for ( uint32_t i = 0; i < ( lodCount * submeshCount ); ++i )
+			{
+				const auto& submesh = o_submeshes[i];
+				if ( ( submesh.indexCount > header.indexCount ) || ( submesh.firstIndex > ( header.indexCount - submesh.indexCount ) ) )
+				{
+					return result = OutputInvalidFileError( "A submesh's indices are outside of the index array" );
+				}
+			}
+		}
+		// The vertex positions are relative to the bounds
+		// and so they can't be drawn without them
+		if ( !section_bounds || ( section_bounds->size != sizeof( o_bounds ) ) )
+		{
+			return result = OutputInvalidFileError( "Its bounds are missing or the wrong size" );
+		}
+		memcpy( &o_bounds, fileData + section_bounds->offset, sizeof( o_bounds ) );
+		// The submeshes were validated above
+		{
+			const auto submeshCount = section_submeshes->count;
+			if ( !section_submeshBounds || ( section_submeshBounds->count != submeshCount )
+				|| ( section_submeshBounds->size != ( sizeof( MeshFormats::sBounds ) * submeshCount ) ) )
+			{
+				return result = OutputInvalidFileError( "Its submesh bounds are missing or don't match its submeshes" );
+			}
+			o_submeshBounds = new (std::nothrow) MeshFormats::sBounds[submeshCount];
+			if ( !o_submeshBounds )
+			{
+				result = eae6320::Results::OutOfMemory;
+				EAE6320_ASSERTF( false, "Couldn't allocate memory for the submesh bounds" );
+				eae6320::Logging::OutputError( "Failed to allocate memory for the submesh bounds of %s", i_path );
+				return result;
+			}
+			memcpy( o_submeshBounds, fileData + section_submeshBounds->offset, section_submeshBounds->size );
+		}
+		// Only meshes that were built as occluders have occluder geometry
+		if ( section_occluder && ( section_occluder->count > 0 ) )
+		{
+			MeshFormats::sOccluder occluder;
+			if ( section_occluder->size < sizeof( occluder ) )
+			{
+				return result = OutputInvalidFileError( "Its occluder is the wrong size" );
+			}
+			memcpy( &occluder, fileData + section_occluder->offset, sizeof( occluder ) );
+			const auto size_positions = sizeof( float ) * 3 * static_cast<size_t>( occluder.vertexCount );
+			const auto size_indices = sizeof( uint32_t ) * static_cast<size_t>( occluder.indexCount );
+			if ( ( section_occluder->size != ( sizeof( occluder ) + size_positions + size_indices ) ) || ( ( occluder.indexCount % 3 ) != 0 ) )
+			{
+				return result = OutputInvalidFileError( "Its occluder is the wrong size" );
+			}
+			o_occluder.positions = new (std::nothrow) float[static_cast<size_t>( occluder.vertexCount ) * 3];
+			o_occluder.indices = new (std::nothrow) uint32_t[occluder.indexCount];
+			if ( !o_occluder.positions || !o_occluder.indices )
+			{
+				result = eae6320::Results::OutOfMemory;
+				EAE6320_ASSERTF( false, "Couldn't allocate memory for the occluder" );
+				eae6320::Logging::OutputError( "Failed to allocate memory for the occluder of %s", i_path );
+				return result;
+			}
+			const auto* const occluderData = fileData + section_occluder->offset + sizeof( occluder );
+			memcpy( o_occluder.positions, occluderData, size_positions );
+			memcpy( o_occluder.indices, occluderData + size_positions, size_indices );
+			for ( uint32_t i = 0; i < occluder.indexCount; ++i )
+			{
+				if ( o_occluder.indices[i] >= occluder.vertexCount )
+				{
+					return result = OutputInvalidFileError( "An occluder index is outside of the occluder's positions" );
+				}
+			}
+			o_occluder.vertexCount = occluder.vertexCount;
+			o_occluder.indexCount = occluder.indexCount;
+		}
+		// Meshlets are optional,
+		// but when they exist they must split every full detail submesh exactly
+		// (the culler relies on this to draw a submesh's surviving meshlets as ranges of its indices)
+		if ( section_meshlets && ( section_meshlets->count > 0 ) )
+		{
+			const auto meshletCount = section_meshlets->count;
+			const auto submeshCount = section_submeshes->count;
+			if ( section_meshlets->size != ( sizeof( MeshFormats::sMeshlet ) * static_cast<size_t>( meshletCount ) ) )
+			{
+				return result = OutputInvalidFileError( "Its meshlets are the wrong size" );
+			}
+			o_meshlets = new (std::nothrow) MeshFormats::sMeshlet[meshletCount];
+			o_submeshMeshletRanges = new (std::nothrow) uint32_t[submeshCount + 1];
+			if ( !o_meshlets || !o_submeshMeshletRanges )
+			{
+				result = eae6320::Results::OutOfMemory;
+				EAE6320_ASSERTF( false, "Couldn't allocate memory for the meshlets" );
+				eae6320::Logging::OutputError( "Failed to allocate memory for the meshlets of %s", i_path );
+				return result;
+			}
+			memcpy( o_meshlets, fileData + section_meshlets->offset, section_meshlets->size );
+			uint32_t meshletIndex = 0;
+			for ( uint32_t i = 0; i < submeshCount; ++i )
+			{
+				o_submeshMeshletRanges[i] = meshletIndex;
+				const auto& submesh = o_submeshes[i];
+				const auto index_end = submesh.firstIndex + submesh.indexCount;
+				for ( auto index = submesh.firstIndex; index < index_end; )
 				{
-					eae6320::Graphics::cMaterial* newMaterial;
-					uint32_t materialDataSize = 0;
-					if ( !( result = eae6320::Graphics::cMaterial::Load( reinterpret_cast<void*>( currentOffset ), materialDataSize, newMaterial ) ) )
+					if ( meshletIndex >= meshletCount )
 					{
-						return result;
+						return result = OutputInvalidFileError( "It has fewer meshlets than its submeshes need" );
 					}
+					const auto& meshlet = o_meshlets[meshletIndex++];
+					if ( ( meshlet.firstIndex != index ) || ( meshlet.indexCount == 0 ) || ( ( meshlet.indexCount % 3 ) != 0 )
+						|| ( meshlet.indexCount > ( MeshFormats::maxMeshletTriangleCount * 3 ) ) || ( meshlet.indexCount > ( index_end - index ) ) )
+					{
+						return result = OutputInvalidFileError( "A meshlet's indices don't match its submesh's" );
+					}
+					index += meshlet.indexCount;
+				}
+			}
+			if ( meshletIndex != meshletCount )
+			{
+				return result = OutputInvalidFileError( "It has more meshlets than its submeshes need" );
+			}
+			o_submeshMeshletRanges[submeshCount] = meshletCount;
+			o_meshletCount = meshletCount;
+		}
 
-					currentOffset += materialDataSize;
-					o_materials[i] = newMaterial;
+		if ( section_materials && ( section_materials->count > 0 ) )
+		{
+			if ( section_materials->count > std::numeric_limits<uint16_t>::max() )
+			{
+				return result = OutputInvalidFileError( "It has too many materials" );
+			}
+			o_materialsCount = static_cast<uint16_t>( section_materials->count );
+			o_materials = new (std::nothrow) eae6320::Graphics::cMaterial*[o_materialsCount]();
+			if ( !o_materials )
+			{
+				result = eae6320::Results::OutOfMemory;
+				eae6320::Logging::OutputError( "Couldn't allocate memory for the materials data." );
+				return result;
+			}
+
+			// The materials are stored one after another,
+			// and each one can only read what is left of the section
+			const auto* const materialData = fileData + section_materials->offset;
+			uint32_t materialDataOffset = 0;
+			for ( auto i = 0; i < o_materialsCount; ++i )
+			{
+				eae6320::Graphics::cMaterial* newMaterial;
+				uint32_t materialDataSize = 0;
+				if ( !( result = eae6320::Graphics::cMaterial::Load( materialData + materialDataOffset, section_materials->size - materialDataOffset,
+					materialDataSize, newMaterial ) ) )
+				{
+					eae6320::Logging::OutputError( "Material %d of the mesh file %s couldn't be loaded", i, i_path );
+					return result;
 				}
+
+				materialDataOffset += materialDataSize;
+				o_materials[i] = newMaterial;
 			}
 		}
 
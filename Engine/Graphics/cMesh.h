@@ -7,6 +7,8 @@
 // Includes
 //=========
 
+#include "MeshFormats.h"
+
 #include <Engine/Assets/ReferenceCountedAssets.h>
 
 #include <cstdint>
@@ -24,6 +26,7 @@ namespace eae6320
 {
 	namespace Graphics
 	{
+		class cInstanceBuffer;
 		class cVertexFormat;
 		class cMaterial;
 
@@ -54,6 +57,26 @@ namespace eae6320
 
 			static cResult Load( const std::string& i_meshPath, cMesh*& o_mesh );
 
+			// Meshes that were built as occluders have simplified geometry that the occlusion culler draws
+			// (see MeshFormats::sOccluder)
+			struct sOccluder
+			{
+				// Three floats per vertex, in model space
+				float* positions = nullptr;
+				uint32_t* indices = nullptr;
+				uint32_t vertexCount = 0;
+				uint32_t indexCount = 0;
+			};
+
+			// A range of the full detail indices that is drawn with one submesh's material
+			// (see cMeshletCuller)
+			struct sDrawRange
+			{
+				uint32_t firstIndex;
+				uint32_t indexCount;
+				uint16_t submeshIndex;
+			};
+
 			EAE6320_ASSETS_DECLAREDELETEDREFERENCECOUNTEDFUNCTIONS( cMesh );
 
 			// Reference Counting
@@ -78,6 +101,9 @@ namespace eae6320
 			GLuint m_vertexBufferId = 0;
 
 			GLuint m_elementBufferId = 0;
+
+			// The instance buffer whose attributes are currently recorded in the vertex array
+			GLuint m_instanceBufferId = 0;
 #endif
 			unsigned int m_triangleCount;
 			
@@ -89,6 +115,23 @@ namespace eae6320
 			//=====
 			cMaterial** m_materials = nullptr;
 			uint16_t m_materialsCount = 0;
+			uint16_t m_sortId = 0;
+			// The bounding box and sphere of every vertex in model space
+			MeshFormats::sBounds m_bounds{};
+			// The bounds of each submesh (in model space)
+			MeshFormats::sBounds* m_submeshBounds = nullptr;
+			// The index range of every submesh in every level of detail
+			// (level i's submeshes start at i * GetSubmeshCount())
+			MeshFormats::sSubmesh* m_submeshes = nullptr;
+			// How far each level of detail's surface is from the full detail one
+			float m_lodErrors[MeshFormats::maxLodCount] = {};
+			uint8_t m_lodCount = 1;
+			sOccluder m_occluder;
+			// The full detail submeshes split into small clusters of triangles that can be culled individually
+			// (submesh i's meshlets are the ones from m_submeshMeshletRanges[i] up to m_submeshMeshletRanges[i + 1])
+			MeshFormats::sMeshlet* m_meshlets = nullptr;
+			uint32_t* m_submeshMeshletRanges = nullptr;
+			uint32_t m_meshletCount = 0;
 
 			// Initialization / Clean Up
 			//--------------------------
@@ -100,11 +143,56 @@ namespace eae6320
 			cMesh();
 			~cMesh();
 
+			// Render
+			//-------
+
+			// Binds everything that every submesh shares
+			// (this returns a failure if the mesh can't be drawn with the instance buffer)
+			cResult BindGeometry( const cInstanceBuffer& i_instanceBuffer );
+			void DrawIndices( const uint32_t i_firstIndex, const uint32_t i_indexCount, const uint32_t i_firstInstance, const uint32_t i_instanceCount );
+
 		public:
 
 			// Render
 			//-------
-			void Draw();
+
+			// Draws i_instanceCount copies of the mesh at the given level of detail,
+			// each one using the next instance from i_instanceBuffer starting at i_firstInstance
+			void Draw( const cInstanceBuffer& i_instanceBuffer, const uint32_t i_firstInstance, const uint32_t i_instanceCount = 1, const uint8_t i_lod = 0 );
+			// Draws only the given ranges of the full detail level
+			// (the ranges must be in submesh order so that each material is only bound once)
+			void Draw( const cInstanceBuffer& i_instanceBuffer, const uint32_t i_firstInstance, const uint32_t i_instanceCount,
+				const sDrawRange* const i_ranges, const uint32_t i_rangeCount );
+
+			// Level of Detail
+			//----------------
+
+			// Returns the least detailed level whose error is no bigger than i_maximumError
+			// once it has been multiplied by i_errorScale
+			// (e.g. the scale from model space to the screen)
+			uint8_t SelectLod( const float i_errorScale, const float i_maximumError ) const;
+			uint8_t GetLodCount() const { return m_lodCount; }
+
+			// Access
+			//-------
+
+			// The sort ID is a small dense identifier that the render queue packs into its sort keys
+			// (it is given back when the mesh is destroyed so that it can be reused)
+			uint16_t GetSortId() const { return m_sortId; }
+			// The primary material is the first one, and it determines where the mesh is sorted
+			cMaterial* GetPrimaryMaterial() const { return m_materialsCount > 0 ? m_materials[0] : nullptr; }
+			const MeshFormats::sBounds& GetBounds() const { return m_bounds; }
+			const MeshFormats::sBounds& GetSubmeshBounds( const uint16_t i_submeshIndex ) const { return m_submeshBounds[i_submeshIndex]; }
+			// A mesh without materials is drawn as a single submesh
+			uint16_t GetSubmeshCount() const { return ( m_materialsCount > 0 ) ? m_materialsCount : 1; }
+			// Returns null if the mesh wasn't built as an occluder
+			const sOccluder* GetOccluder() const { return ( m_occluder.indexCount > 0 ) ? &m_occluder : nullptr; }
+			// Meshes that were built without meshlets have a meshlet count of zero
+			const MeshFormats::sMeshlet* GetMeshlets() const { return m_meshlets; }
+			uint32_t GetMeshletCount() const { return m_meshletCount; }
+			// Returns the first of the submesh's meshlets
+			// (i_submeshIndex can be the submesh count, in which case it returns the meshlet count)
+			uint32_t GetFirstMeshlet( const uint16_t i_submeshIndex ) const { return m_submeshMeshletRanges[i_submeshIndex]; }
 		};
 	}
 }
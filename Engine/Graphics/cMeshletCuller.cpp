@@ -0,0 +1,221 @@
+// Includes
+//=========
+
+#include "cMeshletCuller.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Math/cMatrix_transformation.h>
+#include <Engine/Math/sVector.h>
+#include <Engine/Time/Time.h>
+
+// Interface
+//==========
+
+// View
+//-----
+
+void eae6320::Graphics::cMeshletCuller::SetView( const Math::cMatrix_transformation& i_transform_worldToCamera,
+	const Math::cMatrix_transformation& i_transform_cameraToProjected, const Math::sVector& i_cameraPosition_world )
+{
+	const auto transform_worldToProjected = i_transform_cameraToProjected * i_transform_worldToCamera;
+	for ( unsigned int i = 0; i < 4; ++i )
+	{
+		for ( unsigned int j = 0; j < 4; ++j )
+		{
+			m_transform_worldToProjected[i][j] = transform_worldToProjected.GetElement( i, j );
+		}
+	}
+	m_cameraPosition_world[0] = i_cameraPosition_world.x;
+	m_cameraPosition_world[1] = i_cameraPosition_world.y;
+	m_cameraPosition_world[2] = i_cameraPosition_world.z;
+}
+
+// Culling
+//--------
+
+void eae6320::Graphics::cMeshletCuller::Begin( const cMesh& i_mesh )
+{
+	EAE6320_ASSERTF( !m_mesh, "End() wasn't called for the previous mesh" );
+	m_tickCount_begin = Time::GetCurrentSystemTimeTickCount();
+	m_mesh = &i_mesh;
+	m_isVisible.assign( i_mesh.GetMeshletCount(), 0 );
+}
+
+void eae6320::Graphics::cMeshletCuller::AddInstance( const Math::cMatrix_transformation& i_transform_localToWorld )
+{
+	EAE6320_ASSERT( m_mesh );
+	const auto* const meshlets = m_mesh->GetMeshlets();
+	const auto meshletCount = m_mesh->GetMeshletCount();
+
+	float transform_localToWorld[4][4];
+	for ( unsigned int i = 0; i < 4; ++i )
+	{
+		for ( unsigned int j = 0; j < 4; ++j )
+		{
+			transform_localToWorld[i][j] = i_transform_localToWorld.GetElement( i, j );
+		}
+	}
+
+	// The frustum planes are extracted from the local-to-projected transform
+	// so that they are already in model space
+	// (see cFrustumCuller::SetFrustum())
+	float planes[6][4];
+	{
+		float rows[4][4];
+		for ( unsigned int i = 0; i < 4; ++i )
+		{
+			for ( unsigned int j = 0; j < 4; ++j )
+			{
+				rows[i][j] = ( m_transform_worldToProjected[i][0] * transform_localToWorld[0][j] ) + ( m_transform_worldToProjected[i][1] * transform_localToWorld[1][j] )
+					+ ( m_transform_worldToProjected[i][2] * transform_localToWorld[2][j] ) + ( m_transform_worldToProjected[i][3] * transform_localToWorld[3][j] );
+			}
+		}
+		for ( unsigned int i = 0; i < 4; ++i )
+		{
+			planes[0][i] = rows[3][i] + rows[0][i];	// Left
+			planes[1][i] = rows[3][i] - rows[0][i];	// Right
+			planes[2][i] = rows[3][i] + rows[1][i];	// Bottom
+			planes[3][i] = rows[3][i] - rows[1][i];	// Top
+#if defined( EAE6320_PLATFORM_D3D )
+			// Direct3D's projected depth goes from 0 to 1
+			planes[4][i] = rows[2][i];	// Near
+#elif defined( EAE6320_PLATFORM_GL )
+			// OpenGL's projected depth goes from -1 to 1
+			planes[4][i] = rows[3][i] + rows[2][i];	// Near
+#endif
+			planes[5][i] = rows[3][i] - rows[2][i];	// Far
+		}
+		for ( auto& plane : planes )
+		{
+			const auto length = std::sqrt( ( plane[0] * plane[0] ) + ( plane[1] * plane[1] ) + ( plane[2] * plane[2] ) );
+			if ( !( length > 0.0f ) )
+			{
+				// A transform that collapses the mesh can't be culled
+				std::fill( m_isVisible.begin(), m_isVisible.end(), uint8_t( 1 ) );
+				return;
+			}
+			for ( auto& component : plane )
+			{
+				component /= length;
+			}
+		}
+	}
+
+	// The camera is transformed into model space with the inverse of the local-to-world transform
+	// (the inverse of the upper 3x3 is its adjugate divided by its determinant).
+	// A mirrored instance's triangles are wound the other way,
+	// and so its back faces are the ones that are drawn and no meshlet can be culled for facing away
+	float cameraPosition_local[3] = {};
+	bool canConesBeTested = false;
+	{
+		const auto& m = transform_localToWorld;
+		const float adjugate[3][3] =
+		{
+			{ ( m[1][1] * m[2][2] ) - ( m[1][2] * m[2][1] ), ( m[0][2] * m[2][1] ) - ( m[0][1] * m[2][2] ), ( m[0][1] * m[1][2] ) - ( m[0][2] * m[1][1] ) },
+			{ ( m[1][2] * m[2][0] ) - ( m[1][0] * m[2][2] ), ( m[0][0] * m[2][2] ) - ( m[0][2] * m[2][0] ), ( m[0][2] * m[1][0] ) - ( m[0][0] * m[1][2] ) },
+			{ ( m[1][0] * m[2][1] ) - ( m[1][1] * m[2][0] ), ( m[0][1] * m[2][0] ) - ( m[0][0] * m[2][1] ), ( m[0][0] * m[1][1] ) - ( m[0][1] * m[1][0] ) },
+		};
+		const auto determinant = ( m[0][0] * adjugate[0][0] ) + ( m[0][1] * adjugate[1][0] ) + ( m[0][2] * adjugate[2][0] );
+		if ( determinant > 1.0e-12f )
+		{
+			const float offset[] = { m_cameraPosition_world[0] - m[0][3], m_cameraPosition_world[1] - m[1][3], m_cameraPosition_world[2] - m[2][3] };
+			for ( unsigned int i = 0; i < 3; ++i )
+			{
+				cameraPosition_local[i] = ( ( adjugate[i][0] * offset[0] ) + ( adjugate[i][1] * offset[1] ) + ( adjugate[i][2] * offset[2] ) ) / determinant;
+			}
+			canConesBeTested = true;
+		}
+	}
+
+	for ( uint32_t i = 0; i < meshletCount; ++i )
+	{
+		// A meshlet that another instance can see is drawn regardless
+		if ( m_isVisible[i] )
+		{
+			continue;
+		}
+		++m_statistics.testedCount;
+		const auto& meshlet = meshlets[i];
+		// A meshlet is off-screen if its sphere is completely behind one of the planes
+		{
+			auto isInFrustum = true;
+			for ( const auto& plane : planes )
+			{
+				const auto distance = ( plane[0] * meshlet.center[0] ) + ( plane[1] * meshlet.center[1] ) + ( plane[2] * meshlet.center[2] ) + plane[3];
+				if ( distance < -meshlet.radius )
+				{
+					isInFrustum = false;
+					break;
+				}
+			}
+			if ( !isInFrustum )
+			{
+				++m_statistics.culledCount_frustum;
+				continue;
+			}
+		}
+		// A meshlet only has back faces if the camera is behind the plane of every one of its triangles,
+		// which is true if the direction to the camera is outside of the normal cone
+		// (the direction to any point in the sphere is at most a radius away from the direction to the center,
+		// and so the test is conservative for every triangle rather than just at the center)
+		if ( canConesBeTested && ( meshlet.coneCutoff < 1.0f ) )
+		{
+			const float offset[] =
+			{
+				meshlet.center[0] - cameraPosition_local[0], meshlet.center[1] - cameraPosition_local[1], meshlet.center[2] - cameraPosition_local[2]
+			};
+			const auto distance = std::sqrt( ( offset[0] * offset[0] ) + ( offset[1] * offset[1] ) + ( offset[2] * offset[2] ) );
+			const auto projection = ( offset[0] * meshlet.coneAxis[0] ) + ( offset[1] * meshlet.coneAxis[1] ) + ( offset[2] * meshlet.coneAxis[2] );
+			if ( projection >= ( ( meshlet.coneCutoff * ( distance + meshlet.radius ) ) + meshlet.radius ) )
+			{
+				++m_statistics.culledCount_backFacing;
+				continue;
+			}
+		}
+		m_isVisible[i] = 1;
+	}
+}
+
+uint32_t eae6320::Graphics::cMeshletCuller::End( cMesh::sDrawRange* const o_ranges )
+{
+	EAE6320_ASSERT( m_mesh );
+	const auto* const meshlets = m_mesh->GetMeshlets();
+
+	// Adjacent meshlets are adjacent in the index buffer,
+	// and so a run of visible meshlets in the same submesh is drawn as one range
+	uint32_t rangeCount = 0;
+	const auto submeshCount = m_mesh->GetSubmeshCount();
+	for ( uint16_t i = 0; i < submeshCount; ++i )
+	{
+		const auto meshlet_end = m_mesh->GetFirstMeshlet( static_cast<uint16_t>( i + 1 ) );
+		auto isRangeOpen = false;
+		for ( auto j = m_mesh->GetFirstMeshlet( i ); j < meshlet_end; ++j )
+		{
+			const auto& meshlet = meshlets[j];
+			if ( !m_isVisible[j] )
+			{
+				m_statistics.triangleCount_culled += meshlet.indexCount / 3;
+				isRangeOpen = false;
+				continue;
+			}
+			m_statistics.triangleCount_drawn += meshlet.indexCount / 3;
+			if ( isRangeOpen )
+			{
+				EAE6320_ASSERT( ( o_ranges[rangeCount - 1].firstIndex + o_ranges[rangeCount - 1].indexCount ) == meshlet.firstIndex );
+				o_ranges[rangeCount - 1].indexCount += meshlet.indexCount;
+			}
+			else
+			{
+				o_ranges[rangeCount++] = cMesh::sDrawRange{ meshlet.firstIndex, meshlet.indexCount, i };
+				isRangeOpen = true;
+			}
+		}
+	}
+
+	m_statistics.drawRangeCount += rangeCount;
+	m_statistics.tickCount += Time::GetCurrentSystemTimeTickCount() - m_tickCount_begin;
+	m_mesh = nullptr;
+	return rangeCount;
+}
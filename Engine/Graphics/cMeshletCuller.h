@@ -0,0 +1,112 @@
+/*
+	A meshlet culler removes the parts of a mesh that can't be seen by the camera
+	before the mesh is drawn
+
+	Meshes that were built with meshlets (see MeshFormats::sMeshlet) are split into small clusters of triangles,
+	and each cluster has a bounding sphere and a cone that contains every one of its triangles' normals:
+		* A meshlet whose sphere is outside of the view frustum is off-screen
+		* A meshlet whose cone points away from the camera only has back faces
+	The meshlets that survive are merged into as few ranges of the mesh's indices as possible
+
+	The tests are done in each instance's model space
+	(the camera is transformed rather than every meshlet)
+*/
+
+#ifndef EAE6320_GRAPHICS_CMESHLETCULLER_H
+#define EAE6320_GRAPHICS_CMESHLETCULLER_H
+
+// Includes
+//=========
+
+#include "cMesh.h"
+
+#include <cstdint>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Math
+	{
+		class cMatrix_transformation;
+		struct sVector;
+	}
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class cMeshletCuller
+		{
+			// Interface
+			//==========
+
+		public:
+
+			struct sStatistics
+			{
+				// Every meshlet is tested once for every instance that it is drawn with
+				uint64_t testedCount = 0;
+				uint64_t culledCount_frustum = 0;
+				uint64_t culledCount_backFacing = 0;
+				// The triangles that weren't drawn because no instance could see them
+				uint64_t triangleCount_drawn = 0;
+				uint64_t triangleCount_culled = 0;
+				uint64_t drawRangeCount = 0;
+				// How long culling took
+				uint64_t tickCount = 0;
+			};
+
+			// Testing every meshlet for every instance costs more than it saves for large batches,
+			// and so batches with more instances than this should be drawn whole
+			static constexpr uint32_t s_maximumInstanceCount = 4;
+
+			// View
+			//-----
+
+			// This must be called with the same matrices and position that are submitted to Graphics
+			void SetView( const Math::cMatrix_transformation& i_transform_worldToCamera, const Math::cMatrix_transformation& i_transform_cameraToProjected,
+				const Math::sVector& i_cameraPosition_world );
+
+			// Culling
+			//--------
+
+			// Each instance of the mesh is added between Begin() and End(),
+			// and a meshlet is drawn if any of the instances might see it.
+			// o_ranges must have room for one range for every one of the mesh's meshlets,
+			// and End() returns how many ranges were written
+			void Begin( const cMesh& i_mesh );
+			void AddInstance( const Math::cMatrix_transformation& i_transform_localToWorld );
+			uint32_t End( cMesh::sDrawRange* const o_ranges );
+
+			// The statistics accumulate until they are reset
+			const sStatistics& GetStatistics() const { return m_statistics; }
+			void ResetStatistics() { m_statistics = sStatistics(); }
+
+			// Data
+			//=====
+
+		private:
+
+			// The rows of the world-to-projected transform
+			float m_transform_worldToProjected[4][4] = {};
+			float m_cameraPosition_world[3] = {};
+
+			const cMesh* m_mesh = nullptr;
+			// Whether any instance so far might see each meshlet
+			// (the array is kept between meshes so that it only grows occasionally)
+			std::vector<uint8_t> m_isVisible;
+			uint64_t m_tickCount_begin = 0;
+
+			sStatistics m_statistics;
+		};
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_CMESHLETCULLER_H
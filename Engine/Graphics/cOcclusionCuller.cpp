@@ -0,0 +1,1015 @@
+// Includes
+//=========
+
+#include "cOcclusionCuller.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Concurrency/cEvent.h>
+#include <Engine/Concurrency/cThread.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Math/cMatrix_transformation.h>
+#include <Engine/Math/sVector.h>
+#include <Engine/Platform/Platform.h>
+#include <new>
+#include <string>
+#include <utility>
+
+#if defined( _M_IX86 ) || defined( _M_X64 ) || defined( __SSE__ )
+	#define EAE6320_GRAPHICS_ISOCCLUSIONCULLINGVECTORIZED
+	#include <xmmintrin.h>
+#endif
+// The 256-bit path is compiled whenever the compiler can target x86
+// but is only used if the CPU that is running it supports AVX
+#if ( defined( __GNUC__ ) || defined( __clang__ ) ) && ( defined( __i386__ ) || defined( __x86_64__ ) )
+	#define EAE6320_GRAPHICS_ISOCCLUSIONCULLINGAVXAVAILABLE
+	#include <immintrin.h>
+	// GCC and clang only allow AVX intrinsics in functions that are compiled for it
+	#define EAE6320_GRAPHICS_TARGETAVX __attribute__(( target( "avx" ) ))
+#elif defined( _M_IX86 ) || defined( _M_X64 )
+	#define EAE6320_GRAPHICS_ISOCCLUSIONCULLINGAVXAVAILABLE
+	#include <immintrin.h>
+	#include <intrin.h>
+	#define EAE6320_GRAPHICS_TARGETAVX
+#endif
+
+#ifdef EAE6320_GRAPHICS_ISOCCLUSIONBENCHMARKENABLED
+	#include <Engine/Math/Functions.h>
+	#include <Engine/Time/Time.h>
+#endif
+#ifdef EAE6320_GRAPHICS_ISOCCLUSIONTESTENABLED
+	#include <cstdlib>
+	#include <Engine/Math/Functions.h>
+#endif
+
+// Static Data
+//============
+
+namespace
+{
+	constexpr uint64_t s_mask_full = ~uint64_t( 0 );
+
+	// Triangles are clipped against the near plane and the sides of the screen
+	// (the far plane doesn't matter because anything behind it isn't drawn anyway)
+	constexpr unsigned int s_clipPlaneCount = 5;
+	// Each plane can add at most one vertex to a clipped polygon
+	constexpr unsigned int s_maximumClippedVertexCount = 3 + s_clipPlaneCount;
+
+#if defined( EAE6320_PLATFORM_GL )
+	// OpenGL's projected depth goes from -1 to 1
+	constexpr float s_depth_near = -1.0f;
+#else
+	// Direct3D's projected depth goes from 0 to 1
+	// (builds without a graphics API, like the headless tests, use the same range as the Math library)
+	constexpr float s_depth_near = 0.0f;
+#endif
+}
+
+// Each worker thread waits for its start event, rasterizes its band of tiles,
+// and then signals its done event
+struct eae6320::Graphics::cOcclusionCuller::sWorker
+{
+	Concurrency::cThread thread;
+	Concurrency::cEvent event_start;
+	Concurrency::cEvent event_done;
+	cOcclusionCuller* culler = nullptr;
+	unsigned int bandIndex = 0;
+};
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// A projected position is inside a plane if the distance is >= 0
+	float GetClipDistance( const float ( &i_position )[4], const unsigned int i_planeIndex );
+	// Returns which pixels of the tile whose bottom-left pixel is at the given position
+	// are inside all three edges
+	uint64_t CalculateCoverage( const float ( &i_edges )[3][3], const float i_x, const float i_y );
+#ifdef EAE6320_GRAPHICS_ISOCCLUSIONCULLINGAVXAVAILABLE
+	// This returns exactly the same coverage as the 128-bit version but tests a whole row of the tile at a time
+	EAE6320_GRAPHICS_TARGETAVX uint64_t CalculateCoverage_avx( const float ( &i_edges )[3][3], const float i_x, const float i_y );
+	bool IsAvxSupported();
+#endif
+	// Returns the tile that contains the pixel, clamped to the screen
+	uint16_t GetTileIndex( const float i_pixel, const uint16_t i_tileCount );
+	// Black is the near plane and white is the far plane or no occluder
+	uint8_t ConvertDepthToGrayscale( const float i_depth );
+}
+
+// Interface
+//==========
+
+// Frame
+//------
+
+void eae6320::Graphics::cOcclusionCuller::BeginFrame( const Math::cMatrix_transformation& i_transform_worldToCamera,
+	const Math::cMatrix_transformation& i_transform_cameraToProjected )
+{
+	const auto transform_worldToProjected = i_transform_cameraToProjected * i_transform_worldToCamera;
+	for ( unsigned int i = 0; i < 4; ++i )
+	{
+		for ( unsigned int j = 0; j < 4; ++j )
+		{
+			m_transform_worldToProjected[i][j] = transform_worldToProjected.GetElement( i, j );
+		}
+	}
+	std::fill( m_tiles.begin(), m_tiles.end(), sTile{ 0, FLT_MAX, FLT_MAX } );
+	m_triangles.clear();
+}
+
+void eae6320::Graphics::cOcclusionCuller::AddOccluder( const float* const i_positions, const uint32_t i_vertexCount,
+	const uint32_t* const i_indices, const uint32_t i_indexCount,
+	const Math::cMatrix_transformation& i_transform_localToWorld )
+{
+	EAE6320_ASSERT( ( i_indexCount % 3 ) == 0 );
+
+	// Combine the transforms so that each vertex only has to be transformed once
+	float transform_localToProjected[4][4];
+	for ( unsigned int i = 0; i < 4; ++i )
+	{
+		for ( unsigned int j = 0; j < 4; ++j )
+		{
+			transform_localToProjected[i][j] = 0.0f;
+			for ( unsigned int k = 0; k < 4; ++k )
+			{
+				transform_localToProjected[i][j] += m_transform_worldToProjected[i][k] * i_transform_localToWorld.GetElement( k, j );
+			}
+		}
+	}
+	m_vertices_projected.resize( static_cast<size_t>( i_vertexCount ) * 4 );
+	for ( uint32_t i = 0; i < i_vertexCount; ++i )
+	{
+		const auto* const position = i_positions + ( static_cast<size_t>( i ) * 3 );
+		auto* const position_projected = &m_vertices_projected[static_cast<size_t>( i ) * 4];
+		for ( unsigned int j = 0; j < 4; ++j )
+		{
+			const auto& row = transform_localToProjected[j];
+			position_projected[j] = ( row[0] * position[0] ) + ( row[1] * position[1] ) + ( row[2] * position[2] ) + row[3];
+		}
+	}
+
+	for ( uint32_t i = 0; ( i + 2 ) < i_indexCount; i += 3 )
+	{
+		float vertices[3][4];
+		uint8_t outsidePlanes[3] = {};
+		for ( unsigned int j = 0; j < 3; ++j )
+		{
+			const auto index = i_indices[i + j];
+			EAE6320_ASSERT( index < i_vertexCount );
+			std::copy_n( &m_vertices_projected[static_cast<size_t>( index ) * 4], 4, vertices[j] );
+			for ( unsigned int k = 0; k < s_clipPlaneCount; ++k )
+			{
+				if ( GetClipDistance( vertices[j], k ) < 0.0f )
+				{
+					outsidePlanes[j] |= 1 << k;
+				}
+			}
+		}
+		// A triangle that is completely outside of any plane can't be seen
+		if ( ( outsidePlanes[0] & outsidePlanes[1] & outsidePlanes[2] ) != 0 )
+		{
+			continue;
+		}
+		const auto planesToClip = outsidePlanes[0] | outsidePlanes[1] | outsidePlanes[2];
+		if ( planesToClip == 0 )
+		{
+			AddTriangle( vertices );
+			continue;
+		}
+
+		// Clip the triangle against every plane that it crosses (Sutherland-Hodgman)
+		float polygons[2][s_maximumClippedVertexCount][4];
+		unsigned int vertexCount = 3;
+		unsigned int polygonIndex = 0;
+		for ( unsigned int j = 0; j < 3; ++j )
+		{
+			std::copy_n( vertices[j], 4, polygons[0][j] );
+		}
+		for ( unsigned int k = 0; ( k < s_clipPlaneCount ) && ( vertexCount >= 3 ); ++k )
+		{
+			if ( ( planesToClip & ( 1 << k ) ) == 0 )
+			{
+				continue;
+			}
+			const auto& polygon_in = polygons[polygonIndex];
+			auto& polygon_out = polygons[polygonIndex ^ 1];
+			unsigned int vertexCount_out = 0;
+			for ( unsigned int j = 0; j < vertexCount; ++j )
+			{
+				const auto& vertex_current = polygon_in[j];
+				const auto& vertex_next = polygon_in[( j + 1 ) % vertexCount];
+				const auto distance_current = GetClipDistance( vertex_current, k );
+				const auto distance_next = GetClipDistance( vertex_next, k );
+				if ( distance_current >= 0.0f )
+				{
+					std::copy_n( vertex_current, 4, polygon_out[vertexCount_out++] );
+				}
+				if ( ( distance_current >= 0.0f ) != ( distance_next >= 0.0f ) )
+				{
+					const auto t = distance_current / ( distance_current - distance_next );
+					for ( unsigned int l = 0; l < 4; ++l )
+					{
+						polygon_out[vertexCount_out][l] = vertex_current[l] + ( ( vertex_next[l] - vertex_current[l] ) * t );
+					}
+					++vertexCount_out;
+				}
+			}
+			EAE6320_ASSERT( vertexCount_out <= s_maximumClippedVertexCount );
+			vertexCount = vertexCount_out;
+			polygonIndex ^= 1;
+		}
+		// The clipped polygon is convex and keeps the triangle's winding,
+		// and so it can be split into a fan
+		const auto& polygon = polygons[polygonIndex];
+		for ( unsigned int j = 1; ( j + 1 ) < vertexCount; ++j )
+		{
+			for ( unsigned int l = 0; l < 4; ++l )
+			{
+				vertices[0][l] = polygon[0][l];
+				vertices[1][l] = polygon[j][l];
+				vertices[2][l] = polygon[j + 1][l];
+			}
+			AddTriangle( vertices );
+		}
+	}
+}
+
+void eae6320::Graphics::cOcclusionCuller::RenderOccluders()
+{
+	if ( m_triangles.empty() )
+	{
+		return;
+	}
+	for ( uint8_t i = 0; i < m_workerCount; ++i )
+	{
+		m_workers[i].event_start.Signal();
+	}
+	RasterizeBand( 0 );
+	for ( uint8_t i = 0; i < m_workerCount; ++i )
+	{
+		const auto result = Concurrency::WaitForEvent( m_workers[i].event_done );
+		EAE6320_ASSERT( result );
+	}
+}
+
+// Testing
+//--------
+
+bool eae6320::Graphics::cOcclusionCuller::IsVisible( const Math::sVector& i_minimum_world, const Math::sVector& i_maximum_world )
+{
+	++m_statistics.testedCount;
+
+	// Find the box's rectangle on the screen and its nearest depth
+	float x_minimum = FLT_MAX, y_minimum = FLT_MAX, x_maximum = -FLT_MAX, y_maximum = -FLT_MAX;
+	float depth_minimum = FLT_MAX;
+	for ( unsigned int i = 0; i < 8; ++i )
+	{
+		const float corner[3] =
+		{
+			( i & 1 ) ? i_maximum_world.x : i_minimum_world.x,
+			( i & 2 ) ? i_maximum_world.y : i_minimum_world.y,
+			( i & 4 ) ? i_maximum_world.z : i_minimum_world.z
+		};
+		float corner_projected[4];
+		for ( unsigned int j = 0; j < 4; ++j )
+		{
+			const auto& row = m_transform_worldToProjected[j];
+			corner_projected[j] = ( row[0] * corner[0] ) + ( row[1] * corner[1] ) + ( row[2] * corner[2] ) + row[3];
+		}
+		// A box that crosses the near plane covers the camera as far as projected depths are concerned
+		if ( GetClipDistance( corner_projected, 0 ) < 0.0f )
+		{
+			return true;
+		}
+		const auto w_inverse = 1.0f / corner_projected[3];
+		const auto x = ( ( corner_projected[0] * w_inverse * 0.5f ) + 0.5f ) * m_width;
+		const auto y = ( ( corner_projected[1] * w_inverse * 0.5f ) + 0.5f ) * m_height;
+		x_minimum = std::min( x_minimum, x );
+		x_maximum = std::max( x_maximum, x );
+		y_minimum = std::min( y_minimum, y );
+		y_maximum = std::max( y_maximum, y );
+		depth_minimum = std::min( depth_minimum, corner_projected[2] * w_inverse );
+	}
+	if ( ( x_maximum < 0.0f ) || ( y_maximum < 0.0f ) || ( x_minimum >= m_width ) || ( y_minimum >= m_height ) )
+	{
+		return false;
+	}
+
+	// The box is hidden if its nearest depth is behind every tile's reference depth
+	const auto tile_minimumX = GetTileIndex( x_minimum, m_tileCountX ), tile_maximumX = GetTileIndex( x_maximum, m_tileCountX );
+	const auto tile_minimumY = GetTileIndex( y_minimum, m_tileCountY ), tile_maximumY = GetTileIndex( y_maximum, m_tileCountY );
+	for ( auto y = tile_minimumY; y <= tile_maximumY; ++y )
+	{
+		const auto* const tiles = &m_tiles[static_cast<size_t>( y ) * m_tileCountX];
+		for ( auto x = tile_minimumX; x <= tile_maximumX; ++x )
+		{
+			if ( depth_minimum <= tiles[x].depth_reference )
+			{
+				return true;
+			}
+		}
+	}
+	++m_statistics.occludedCount;
+	return false;
+}
+
+// Debugging
+//----------
+
+eae6320::cResult eae6320::Graphics::cOcclusionCuller::SaveDepthImage( const char* const i_path ) const
+{
+	std::string image = "P5\n" + std::to_string( m_width ) + " " + std::to_string( m_height ) + "\n255\n";
+	const auto headerSize = image.size();
+	image.resize( headerSize + ( static_cast<size_t>( m_width ) * m_height ) );
+	auto* pixel = &image[headerSize];
+	// PGM images are stored from top to bottom
+	for ( auto y = static_cast<int>( m_height ) - 1; y >= 0; --y )
+	{
+		for ( unsigned int x = 0; x < m_width; ++x, ++pixel )
+		{
+			const auto& tile = m_tiles[( ( y / s_tileSize ) * m_tileCountX ) + ( x / s_tileSize )];
+			*pixel = static_cast<char>( ConvertDepthToGrayscale( tile.depth_reference ) );
+		}
+	}
+	std::string errorMessage;
+	const auto result = Platform::WriteBinaryFile( i_path, image.data(), image.size(), &errorMessage );
+	if ( !result )
+	{
+		EAE6320_ASSERTF( false, errorMessage.c_str() );
+		Logging::OutputError( "The occlusion culler couldn't save its depth image to \"%s\": %s", i_path, errorMessage.c_str() );
+	}
+	return result;
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::cResult eae6320::Graphics::cOcclusionCuller::Initialize( const uint16_t i_width, const uint16_t i_height, const uint8_t i_workerThreadCount )
+{
+	EAE6320_ASSERT( m_tiles.empty() && !m_workers );
+	if ( ( i_width == 0 ) || ( i_height == 0 ) )
+	{
+		EAE6320_ASSERTF( false, "The occlusion culler's resolution can't be zero" );
+		Logging::OutputError( "The occlusion culler can't be initialized with a resolution of %ux%u", i_width, i_height );
+		return Results::Failure;
+	}
+
+	m_tileCountX = static_cast<uint16_t>( ( i_width + s_tileSize - 1 ) / s_tileSize );
+	m_tileCountY = static_cast<uint16_t>( ( i_height + s_tileSize - 1 ) / s_tileSize );
+	m_width = static_cast<uint16_t>( m_tileCountX * s_tileSize );
+	m_height = static_cast<uint16_t>( m_tileCountY * s_tileSize );
+	m_tiles.assign( static_cast<size_t>( m_tileCountX ) * m_tileCountY, sTile{ 0, FLT_MAX, FLT_MAX } );
+#ifdef EAE6320_GRAPHICS_ISOCCLUSIONCULLINGAVXAVAILABLE
+	m_calculateCoverage = IsAvxSupported() ? CalculateCoverage_avx : CalculateCoverage;
+#else
+	m_calculateCoverage = CalculateCoverage;
+#endif
+
+	// Every band must have at least one row of tiles
+	const auto workerCount = static_cast<uint8_t>( std::min<unsigned int>( i_workerThreadCount, m_tileCountY - 1u ) );
+	if ( workerCount == 0 )
+	{
+		return Results::Success;
+	}
+	m_workers = new (std::nothrow) sWorker[workerCount];
+	if ( !m_workers )
+	{
+		EAE6320_ASSERTF( false, "Couldn't allocate the occlusion culler's workers" );
+		Logging::OutputError( "Failed to allocate %u workers for the occlusion culler", workerCount );
+		return Results::OutOfMemory;
+	}
+	m_shouldWorkersStop = false;
+	for ( uint8_t i = 0; i < workerCount; ++i )
+	{
+		auto& worker = m_workers[i];
+		worker.culler = this;
+		worker.bandIndex = i + 1u;
+		auto result = worker.event_start.Initialize( Concurrency::EventType::ResetAutomaticallyAfterBeingSignaled );
+		if ( result )
+		{
+			result = worker.event_done.Initialize( Concurrency::EventType::ResetAutomaticallyAfterBeingSignaled );
+		}
+		if ( result )
+		{
+			result = worker.thread.Start( RasterizeInBackground, &worker );
+		}
+		if ( !result )
+		{
+			EAE6320_ASSERTF( false, "Couldn't start an occlusion culler worker" );
+			Logging::OutputError( "The occlusion culler couldn't start worker %u", i );
+			CleanUp();
+			return result;
+		}
+		// Only workers whose threads have started are stopped during clean up
+		m_workerCount = i + 1u;
+	}
+
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Graphics::cOcclusionCuller::CleanUp()
+{
+	auto result = Results::Success;
+
+	if ( m_workers )
+	{
+		m_shouldWorkersStop = true;
+		for ( uint8_t i = 0; i < m_workerCount; ++i )
+		{
+			auto& worker = m_workers[i];
+			worker.event_start.Signal();
+			const auto result_thread = Concurrency::WaitForThreadToStop( worker.thread );
+			if ( !result_thread )
+			{
+				EAE6320_ASSERTF( false, "An occlusion culler worker didn't stop" );
+				if ( result )
+				{
+					result = result_thread;
+				}
+			}
+		}
+		delete [] m_workers;
+		m_workers = nullptr;
+		m_workerCount = 0;
+	}
+	m_tiles.clear();
+	m_triangles.clear();
+	m_vertices_projected.clear();
+
+	return result;
+}
+
+eae6320::Graphics::cOcclusionCuller::~cOcclusionCuller()
+{
+	const auto result = CleanUp();
+	EAE6320_ASSERT( result );
+}
+
+// Implementation
+//===============
+
+void eae6320::Graphics::cOcclusionCuller::AddTriangle( const float ( &i_vertices )[3][4] )
+{
+	float x[3], y[3], depth[3];
+	for ( unsigned int i = 0; i < 3; ++i )
+	{
+		const auto w_inverse = 1.0f / i_vertices[i][3];
+		x[i] = ( ( i_vertices[i][0] * w_inverse * 0.5f ) + 0.5f ) * m_width;
+		y[i] = ( ( i_vertices[i][1] * w_inverse * 0.5f ) + 0.5f ) * m_height;
+		depth[i] = i_vertices[i][2] * w_inverse;
+	}
+
+	// Front faces are clockwise, which is a negative area when y is up
+	// (back faces and degenerate triangles can't hide anything that front faces don't)
+	auto area = ( ( x[1] - x[0] ) * ( y[2] - y[0] ) ) - ( ( y[1] - y[0] ) * ( x[2] - x[0] ) );
+	if ( !( area < 0.0f ) )
+	{
+		return;
+	}
+	// The edges are simpler to define for counterclockwise triangles
+	std::swap( x[1], x[2] );
+	std::swap( y[1], y[2] );
+	std::swap( depth[1], depth[2] );
+	area = -area;
+
+	sTriangle triangle;
+	for ( unsigned int i = 0; i < 3; ++i )
+	{
+		// A pixel is inside if it is to the left of the edge
+		const auto j = ( i + 1 ) % 3;
+		auto& edge = triangle.edges[i];
+		edge[0] = y[i] - y[j];
+		edge[1] = x[j] - x[i];
+		edge[2] = -( ( edge[0] * x[i] ) + ( edge[1] * y[i] ) );
+	}
+	{
+		// Projected depth is linear in screen space
+		const auto area_inverse = 1.0f / area;
+		const auto depth_1 = depth[1] - depth[0], depth_2 = depth[2] - depth[0];
+		triangle.depthPlane[0] = ( ( depth_1 * ( y[2] - y[0] ) ) - ( depth_2 * ( y[1] - y[0] ) ) ) * area_inverse;
+		triangle.depthPlane[1] = ( ( depth_2 * ( x[1] - x[0] ) ) - ( depth_1 * ( x[2] - x[0] ) ) ) * area_inverse;
+		triangle.depthPlane[2] = depth[0] - ( triangle.depthPlane[0] * x[0] ) - ( triangle.depthPlane[1] * y[0] );
+	}
+	triangle.depth_maximum = std::max( depth[0], std::max( depth[1], depth[2] ) );
+
+	triangle.tile_minimumX = GetTileIndex( std::min( x[0], std::min( x[1], x[2] ) ), m_tileCountX );
+	triangle.tile_maximumX = GetTileIndex( std::max( x[0], std::max( x[1], x[2] ) ), m_tileCountX );
+	triangle.tile_minimumY = GetTileIndex( std::min( y[0], std::min( y[1], y[2] ) ), m_tileCountY );
+	triangle.tile_maximumY = GetTileIndex( std::max( y[0], std::max( y[1], y[2] ) ), m_tileCountY );
+
+	m_triangles.push_back( triangle );
+	++m_statistics.occluderTriangleCount;
+}
+
+void eae6320::Graphics::cOcclusionCuller::RasterizeBand( const unsigned int i_bandIndex )
+{
+	// Each band is a range of rows of tiles,
+	// and so no two threads ever write to the same tile
+	const unsigned int bandCount = m_workerCount + 1u;
+	const auto row_begin = static_cast<uint16_t>( ( i_bandIndex * m_tileCountY ) / bandCount );
+	const auto row_end = static_cast<uint16_t>( ( ( i_bandIndex + 1 ) * m_tileCountY ) / bandCount );
+
+	for ( const auto& triangle : m_triangles )
+	{
+		const auto y_begin = std::max( triangle.tile_minimumY, row_begin );
+		const auto y_end = std::min( static_cast<uint16_t>( triangle.tile_maximumY + 1 ), row_end );
+		for ( auto y = y_begin; y < y_end; ++y )
+		{
+			// The coverage is sampled at pixel centers
+			const auto pixel_minimumY = static_cast<float>( y * s_tileSize );
+			const auto sample_minimumY = pixel_minimumY + 0.5f, sample_maximumY = pixel_minimumY + ( s_tileSize - 0.5f );
+			auto* const tiles = &m_tiles[static_cast<size_t>( y ) * m_tileCountX];
+			for ( auto x = triangle.tile_minimumX; x <= triangle.tile_maximumX; ++x )
+			{
+				auto& tile = tiles[x];
+				const auto pixel_minimumX = static_cast<float>( x * s_tileSize );
+				const auto sample_minimumX = pixel_minimumX + 0.5f, sample_maximumX = pixel_minimumX + ( s_tileSize - 0.5f );
+
+				// The triangle's depth in the tile can't be farther than its farthest vertex
+				// or the farthest corner of the tile on its plane
+				const auto& plane = triangle.depthPlane;
+				const auto depth = std::min( triangle.depth_maximum,
+					( plane[0] * ( ( plane[0] >= 0.0f ) ? sample_maximumX : sample_minimumX ) )
+					+ ( plane[1] * ( ( plane[1] >= 0.0f ) ? sample_maximumY : sample_minimumY ) ) + plane[2] );
+				if ( depth >= tile.depth_reference )
+				{
+					continue;
+				}
+
+				// An edge is smallest and largest at opposite corners of the tile,
+				// and so the corners show whether the tile is completely inside or outside of the triangle
+				// without testing every pixel
+				auto isCompletelyInside = true;
+				auto isCompletelyOutside = false;
+				for ( const auto& edge : triangle.edges )
+				{
+					const auto value_smallest = ( edge[0] * ( ( edge[0] >= 0.0f ) ? sample_minimumX : sample_maximumX ) )
+						+ ( edge[1] * ( ( edge[1] >= 0.0f ) ? sample_minimumY : sample_maximumY ) ) + edge[2];
+					const auto value_largest = ( edge[0] * ( ( edge[0] >= 0.0f ) ? sample_maximumX : sample_minimumX ) )
+						+ ( edge[1] * ( ( edge[1] >= 0.0f ) ? sample_maximumY : sample_minimumY ) ) + edge[2];
+					isCompletelyInside = isCompletelyInside && ( value_smallest >= 0.0f );
+					isCompletelyOutside = isCompletelyOutside || ( value_largest < 0.0f );
+				}
+				if ( isCompletelyOutside )
+				{
+					continue;
+				}
+				const auto coverage = isCompletelyInside ? s_mask_full : m_calculateCoverage( triangle.edges, pixel_minimumX, pixel_minimumY );
+				if ( coverage == 0 )
+				{
+					continue;
+				}
+
+				if ( coverage == s_mask_full )
+				{
+					// The triangle hides everything behind it in this tile,
+					// including any occluders in the working layer that are behind it
+					tile.depth_reference = depth;
+					if ( tile.depth_working >= depth )
+					{
+						tile.mask = 0;
+					}
+					continue;
+				}
+				// If the triangle is much closer than the working layer then it starts a new one
+				// (merging them would push the working depth too far back to be useful)
+				if ( ( tile.mask != 0 ) && ( ( tile.depth_working - depth ) > ( tile.depth_reference - tile.depth_working ) ) )
+				{
+					tile.mask = 0;
+				}
+				tile.depth_working = ( tile.mask == 0 ) ? depth : std::max( tile.depth_working, depth );
+				tile.mask |= coverage;
+				if ( tile.mask == s_mask_full )
+				{
+					tile.depth_reference = tile.depth_working;
+					tile.mask = 0;
+				}
+			}
+		}
+	}
+}
+
+void eae6320::Graphics::cOcclusionCuller::RasterizeInBackground( void* const io_worker )
+{
+	auto& worker = *static_cast<sWorker*>( io_worker );
+	while ( Concurrency::WaitForEvent( worker.event_start ) )
+	{
+		if ( worker.culler->m_shouldWorkersStop )
+		{
+			break;
+		}
+		worker.culler->RasterizeBand( worker.bandIndex );
+		worker.event_done.Signal();
+	}
+}
+
+#ifdef EAE6320_GRAPHICS_ISOCCLUSIONBENCHMARKENABLED
+
+void eae6320::Graphics::cOcclusionCuller::RunBenchmark()
+{
+	constexpr unsigned int wallCount = 24, objectCount = 20000, iterationCount = 16;
+	constexpr uint8_t workerThreadCounts[] = { 0, 1, 3 };
+
+	// A fixed LCG makes the results comparable between runs
+	uint32_t randomState = 6320;
+	const auto GetRandom = [&randomState]( const float i_minimum, const float i_maximum )
+	{
+		randomState = ( randomState * 1664525u ) + 1013904223u;
+		return i_minimum + ( ( i_maximum - i_minimum ) * ( static_cast<float>( randomState >> 8 ) / static_cast<float>( 1 << 24 ) ) );
+	};
+	const auto GetMilliseconds = []( const uint64_t i_tickCount )
+	{
+		return Time::ConvertTicksToSeconds( i_tickCount ) * 1000.0;
+	};
+
+	// The camera is at the origin looking down negative Z
+	// at a room of walls with many small objects behind them
+	const Math::cMatrix_transformation transform_worldToCamera;
+	const auto transform_cameraToProjected = Math::cMatrix_transformation::CreateCameraToProjectedTransform_perspective(
+		Math::ConvertDegreesToRadians( 60.0f ), 2.0f, 0.1f, 200.0f );
+	// Every wall is a box whose triangles are included with both windings
+	// so that the benchmark doesn't depend on which winding faces the camera
+	std::vector<float> positions;
+	std::vector<uint32_t> indices;
+	for ( unsigned int i = 0; i < wallCount; ++i )
+	{
+		const Math::sVector center( GetRandom( -40.0f, 40.0f ), GetRandom( -8.0f, 4.0f ), GetRandom( -80.0f, -10.0f ) );
+		const Math::sVector extents( GetRandom( 2.0f, 10.0f ), GetRandom( 2.0f, 6.0f ), 0.25f );
+		const auto vertexOffset = static_cast<uint32_t>( positions.size() / 3 );
+		for ( unsigned int j = 0; j < 8; ++j )
+		{
+			positions.push_back( center.x + ( ( j & 1 ) ? extents.x : -extents.x ) );
+			positions.push_back( center.y + ( ( j & 2 ) ? extents.y : -extents.y ) );
+			positions.push_back( center.z + ( ( j & 4 ) ? extents.z : -extents.z ) );
+		}
+		constexpr uint32_t faces[6][4] = { { 0, 1, 3, 2 }, { 4, 5, 7, 6 }, { 0, 1, 5, 4 }, { 2, 3, 7, 6 }, { 0, 2, 6, 4 }, { 1, 3, 7, 5 } };
+		for ( const auto& face : faces )
+		{
+			constexpr uint32_t triangles[4][3] = { { 0, 1, 2 }, { 0, 2, 3 }, { 0, 2, 1 }, { 0, 3, 2 } };
+			for ( const auto& triangle : triangles )
+			{
+				for ( const auto corner : triangle )
+				{
+					indices.push_back( vertexOffset + face[corner] );
+				}
+			}
+		}
+	}
+	std::vector<Math::sVector> objects( objectCount * 2 );
+	for ( unsigned int i = 0; i < objectCount; ++i )
+	{
+		const auto z = GetRandom( -150.0f, -5.0f );
+		// The objects are spread across the view frustum
+		const Math::sVector center( GetRandom( -0.8f, 0.8f ) * -z, GetRandom( -0.4f, 0.4f ) * -z, z );
+		const auto extent = GetRandom( 0.2f, 1.0f );
+		objects[i * 2] = center - extent;
+		objects[( i * 2 ) + 1] = center + extent;
+	}
+
+	Logging::OutputMessage( "Occlusion culling benchmark (%u occluder triangles, %u objects):", static_cast<unsigned int>( indices.size() / 3 ), objectCount );
+	for ( const auto workerThreadCount : workerThreadCounts )
+	{
+		cOcclusionCuller culler;
+		if ( !culler.Initialize( 256, 128, workerThreadCount ) )
+		{
+			Logging::OutputError( "The occlusion culling benchmark couldn't initialize a culler" );
+			return;
+		}
+		uint64_t tickCount_setUp = 0, tickCount_rasterization = 0, tickCount_testing = 0;
+		for ( unsigned int i = 0; i < iterationCount; ++i )
+		{
+			culler.ResetStatistics();
+			const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+			culler.BeginFrame( transform_worldToCamera, transform_cameraToProjected );
+			culler.AddOccluder( positions.data(), static_cast<uint32_t>( positions.size() / 3 ),
+				indices.data(), static_cast<uint32_t>( indices.size() ), Math::cMatrix_transformation() );
+			const auto tickCount_setUpEnd = Time::GetCurrentSystemTimeTickCount();
+			culler.RenderOccluders();
+			const auto tickCount_rasterizationEnd = Time::GetCurrentSystemTimeTickCount();
+			for ( unsigned int j = 0; j < objectCount; ++j )
+			{
+				culler.IsVisible( objects[j * 2], objects[( j * 2 ) + 1] );
+			}
+			const auto tickCount_end = Time::GetCurrentSystemTimeTickCount();
+			tickCount_setUp += tickCount_setUpEnd - tickCount_start;
+			tickCount_rasterization += tickCount_rasterizationEnd - tickCount_setUpEnd;
+			tickCount_testing += tickCount_end - tickCount_rasterizationEnd;
+		}
+		const auto& statistics = culler.GetStatistics();
+		Logging::OutputMessage( "\t%u worker threads: set up %.3f ms, rasterization %.3f ms, testing %.3f ms (%u front-facing triangles, %u of %u objects occluded)",
+			workerThreadCount, GetMilliseconds( tickCount_setUp ) / iterationCount, GetMilliseconds( tickCount_rasterization ) / iterationCount,
+			GetMilliseconds( tickCount_testing ) / iterationCount,
+			statistics.occluderTriangleCount, statistics.occludedCount, statistics.testedCount );
+		culler.CleanUp();
+	}
+}
+
+#endif
+
+#ifdef EAE6320_GRAPHICS_ISOCCLUSIONTESTENABLED
+
+void eae6320::Graphics::cOcclusionCuller::RunReferenceTest()
+{
+	// The camera is at the origin looking down negative Z
+	constexpr uint16_t width = 128, height = 64;
+	const Math::cMatrix_transformation transform_worldToCamera;
+	const auto transform_cameraToProjected = Math::cMatrix_transformation::CreateCameraToProjectedTransform_perspective(
+		Math::ConvertDegreesToRadians( 60.0f ), static_cast<float>( width ) / static_cast<float>( height ), 1.0f, 40.0f );
+
+	// Every occluder is a rectangle that faces the camera or the floor
+	// (they are added with both windings so that the test doesn't depend on which one is the front)
+	std::vector<float> positions;
+	std::vector<uint32_t> indices;
+	const auto AddRectangle = [&positions, &indices]( const Math::sVector& i_corner, const Math::sVector& i_edge_u, const Math::sVector& i_edge_v )
+	{
+		const auto vertexOffset = static_cast<uint32_t>( positions.size() / 3 );
+		const Math::sVector corners[4] = { i_corner, i_corner + i_edge_u, i_corner + i_edge_u + i_edge_v, i_corner + i_edge_v };
+		for ( const auto& corner : corners )
+		{
+			positions.push_back( corner.x );
+			positions.push_back( corner.y );
+			positions.push_back( corner.z );
+		}
+		constexpr uint32_t triangles[4][3] = { { 0, 1, 2 }, { 0, 2, 3 }, { 0, 2, 1 }, { 0, 3, 2 } };
+		for ( const auto& triangle : triangles )
+		{
+			for ( const auto corner : triangle )
+			{
+				indices.push_back( vertexOffset + corner );
+			}
+		}
+	};
+	// A wall that covers the left of the screen from top to bottom
+	AddRectangle( Math::sVector( -12.0f, -6.0f, -10.0f ), Math::sVector( 11.0f, 0.0f, 0.0f ), Math::sVector( 0.0f, 12.0f, 0.0f ) );
+	// A small wall close to the camera
+	AddRectangle( Math::sVector( 0.5f, -1.0f, -4.0f ), Math::sVector( 2.0f, 0.0f, 0.0f ), Math::sVector( 0.0f, 2.0f, 0.0f ) );
+	// A floor that starts behind the camera
+	// (its depth changes across the screen and it has to be clipped against the near plane)
+	AddRectangle( Math::sVector( -3.0f, -1.5f, 1.0f ), Math::sVector( 6.0f, 0.0f, 0.0f ), Math::sVector( 0.0f, 0.0f, -21.0f ) );
+	// Two walls that meet in the middle of a column of tiles
+	// (neither covers those tiles by itself, and so they are only full once the working layer is merged)
+	AddRectangle( Math::sVector( 1.0f, 6.0f, -15.0f ), Math::sVector( 2.3f, 0.0f, 0.0f ), Math::sVector( 0.0f, 3.0f, 0.0f ) );
+	AddRectangle( Math::sVector( 3.3f, 6.0f, -15.0f ), Math::sVector( 12.7f, 0.0f, 0.0f ), Math::sVector( 0.0f, 3.0f, 0.0f ) );
+
+	// The reference depth of every tile as a grayscale value from ConvertDepthToGrayscale(),
+	// with the top row first like the images that SaveDepthImage() writes
+	// (every pixel in a tile has the same depth, and so this is the depth image at one pixel per tile)
+	constexpr unsigned int tileCountX = width / s_tileSize, tileCountY = height / s_tileSize;
+	constexpr const char* referenceImage[tileCountY] =
+	{
+		"ebebebebebebebfffff4f4f4f4f4f4ff",
+		"ebebebebebebebffffffffffffffffff",
+		"ebebebebebebebffffffffffffffffff",
+		"ebebebebebebebffffc4c4c4ffffffff",
+		"ebebebebebebebffffc4c4c4ffffffff",
+		"ebebebebebebebebebebebffffffffff",
+		"ebebebebd2d2d2d2d2d2d2d2ffffffff",
+		"ebebb8b8b8b8b8b8b8b8b8b8b8b8ffff",
+	};
+	struct sBox
+	{
+		const char* description;
+		Math::sVector center;
+		float extent;
+		bool isVisible;
+	};
+	constexpr sBox boxes[] =
+	{
+		{ "behind the left wall", Math::sVector( -6.0f, 0.0f, -20.0f ), 1.0f, false },
+		{ "in front of the left wall", Math::sVector( -3.0f, 0.0f, -6.0f ), 0.5f, true },
+		{ "behind the small wall", Math::sVector( 1.5f, 0.0f, -8.0f ), 0.3f, false },
+		{ "behind the seam of the two walls", Math::sVector( 6.6f, 15.0f, -30.0f ), 0.5f, false },
+		{ "in front of the seam of the two walls", Math::sVector( 1.1f, 2.5f, -5.0f ), 0.1f, true },
+		{ "with nothing in front of it", Math::sVector( 18.0f, -3.0f, -20.0f ), 1.0f, true },
+		{ "above the screen", Math::sVector( 0.0f, 30.0f, -10.0f ), 1.0f, false },
+		{ "around the camera", Math::sVector( 0.0f, 0.0f, 0.0f ), 1.0f, true },
+	};
+
+	// Every combination must match the same reference
+	struct sConfiguration
+	{
+		uint8_t workerThreadCount;
+		bool shouldUse128BitCoverage;
+	};
+	constexpr sConfiguration configurations[] = { { 0, false }, { 2, false }, { 0, true }, { 2, true } };
+	// Depths that are within one gray level of the reference pass
+	// (the projection is calculated differently on Direct3D and OpenGL)
+	constexpr int tolerance = 1;
+	auto wasTestSuccessful = true;
+	for ( const auto& configuration : configurations )
+	{
+		cOcclusionCuller culler;
+		if ( !culler.Initialize( width, height, configuration.workerThreadCount ) )
+		{
+			Logging::OutputError( "The occlusion culling test couldn't initialize a culler" );
+			return;
+		}
+		if ( configuration.shouldUse128BitCoverage )
+		{
+			culler.m_calculateCoverage = CalculateCoverage;
+		}
+		const auto* const coverageName = ( culler.m_calculateCoverage == CalculateCoverage ) ? "128-bit" : "256-bit";
+		culler.BeginFrame( transform_worldToCamera, transform_cameraToProjected );
+		culler.AddOccluder( positions.data(), static_cast<uint32_t>( positions.size() / 3 ),
+			indices.data(), static_cast<uint32_t>( indices.size() ), Math::cMatrix_transformation() );
+		culler.RenderOccluders();
+
+		// Compare the depth image
+		{
+			auto differentTileCount = 0u;
+			std::string image;
+			for ( unsigned int row = 0; row < tileCountY; ++row )
+			{
+				const auto y = tileCountY - 1 - row;
+				std::string imageRow;
+				for ( unsigned int x = 0; x < tileCountX; ++x )
+				{
+					constexpr char hexDigits[] = "0123456789abcdef";
+					const auto gray = ConvertDepthToGrayscale( culler.m_tiles[( y * tileCountX ) + x].depth_reference );
+					imageRow += hexDigits[gray >> 4];
+					imageRow += hexDigits[gray & 0xf];
+					const char referenceHex[] = { referenceImage[row][x * 2], referenceImage[row][( x * 2 ) + 1], '\0' };
+					const auto gray_reference = static_cast<int>( std::strtol( referenceHex, nullptr, 16 ) );
+					if ( std::abs( gray - gray_reference ) > tolerance )
+					{
+						++differentTileCount;
+					}
+				}
+				image += "\n\t\"" + imageRow + "\",";
+			}
+			if ( differentTileCount > 0 )
+			{
+				wasTestSuccessful = false;
+				EAE6320_ASSERTF( false, "%u tiles of the occlusion culler's depth image don't match the reference", differentTileCount );
+				Logging::OutputError( "%u tiles of the occlusion culler's depth image (%u worker threads, %s coverage) don't match the reference. The image was:%s",
+					differentTileCount, configuration.workerThreadCount, coverageName, image.c_str() );
+			}
+		}
+		// Compare the visibility of each box
+		for ( const auto& box : boxes )
+		{
+			const auto isVisible = culler.IsVisible( box.center - box.extent, box.center + box.extent );
+			if ( isVisible != box.isVisible )
+			{
+				wasTestSuccessful = false;
+				EAE6320_ASSERTF( false, "The box %s should be %s", box.description, box.isVisible ? "visible" : "hidden" );
+				Logging::OutputError( "The occlusion culler (%u worker threads, %s coverage) says that the box %s is %s",
+					configuration.workerThreadCount, coverageName, box.description, isVisible ? "visible" : "hidden" );
+			}
+		}
+		culler.CleanUp();
+	}
+	if ( wasTestSuccessful )
+	{
+		Logging::OutputMessage( "The occlusion culling test matched the reference depth image and the visibility of %u boxes with every configuration",
+			static_cast<unsigned int>( sizeof( boxes ) / sizeof( boxes[0] ) ) );
+	}
+}
+
+#endif
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	float GetClipDistance( const float ( &i_position )[4], const unsigned int i_planeIndex )
+	{
+		const auto w = i_position[3];
+		switch ( i_planeIndex )
+		{
+		// The near plane is at z = s_depth_near * w
+		case 0: return i_position[2] - ( s_depth_near * w );
+		case 1: return w + i_position[0];
+		case 2: return w - i_position[0];
+		case 3: return w + i_position[1];
+		default: return w - i_position[1];
+		}
+	}
+
+	uint64_t CalculateCoverage( const float ( &i_edges )[3][3], const float i_x, const float i_y )
+	{
+		uint64_t coverage = 0;
+#ifdef EAE6320_GRAPHICS_ISOCCLUSIONCULLINGVECTORIZED
+		// Each row of eight pixels is tested four at a time
+		__m128 values[3][2], steps[3];
+		{
+			const auto x_left = _mm_add_ps( _mm_set1_ps( i_x ), _mm_setr_ps( 0.5f, 1.5f, 2.5f, 3.5f ) );
+			const auto x_right = _mm_add_ps( _mm_set1_ps( i_x ), _mm_setr_ps( 4.5f, 5.5f, 6.5f, 7.5f ) );
+			for ( unsigned int i = 0; i < 3; ++i )
+			{
+				const auto& edge = i_edges[i];
+				const auto a = _mm_set1_ps( edge[0] );
+				const auto rowValue = _mm_set1_ps( ( edge[1] * ( i_y + 0.5f ) ) + edge[2] );
+				values[i][0] = _mm_add_ps( _mm_mul_ps( a, x_left ), rowValue );
+				values[i][1] = _mm_add_ps( _mm_mul_ps( a, x_right ), rowValue );
+				steps[i] = _mm_set1_ps( edge[1] );
+			}
+		}
+		const auto zero = _mm_setzero_ps();
+		for ( unsigned int y = 0; y < 8; ++y )
+		{
+			auto isInside_left = _mm_cmpge_ps( values[0][0], zero );
+			auto isInside_right = _mm_cmpge_ps( values[0][1], zero );
+			for ( unsigned int i = 1; i < 3; ++i )
+			{
+				isInside_left = _mm_and_ps( isInside_left, _mm_cmpge_ps( values[i][0], zero ) );
+				isInside_right = _mm_and_ps( isInside_right, _mm_cmpge_ps( values[i][1], zero ) );
+			}
+			const auto row = static_cast<uint64_t>( _mm_movemask_ps( isInside_left ) | ( _mm_movemask_ps( isInside_right ) << 4 ) );
+			coverage |= row << ( y * 8 );
+			for ( unsigned int i = 0; i < 3; ++i )
+			{
+				values[i][0] = _mm_add_ps( values[i][0], steps[i] );
+				values[i][1] = _mm_add_ps( values[i][1], steps[i] );
+			}
+		}
+#else
+		for ( unsigned int y = 0; y < 8; ++y )
+		{
+			const auto sampleY = i_y + y + 0.5f;
+			for ( unsigned int x = 0; x < 8; ++x )
+			{
+				const auto sampleX = i_x + x + 0.5f;
+				auto isInside = true;
+				for ( const auto& edge : i_edges )
+				{
+					isInside = isInside && ( ( ( edge[0] * sampleX ) + ( edge[1] * sampleY ) + edge[2] ) >= 0.0f );
+				}
+				if ( isInside )
+				{
+					coverage |= uint64_t( 1 ) << ( ( y * 8 ) + x );
+				}
+			}
+		}
+#endif
+		return coverage;
+	}
+
+#ifdef EAE6320_GRAPHICS_ISOCCLUSIONCULLINGAVXAVAILABLE
+	EAE6320_GRAPHICS_TARGETAVX uint64_t CalculateCoverage_avx( const float ( &i_edges )[3][3], const float i_x, const float i_y )
+	{
+		uint64_t coverage = 0;
+		// Each row of eight pixels is tested at once
+		// (the arithmetic is the same as the 128-bit version so that the results match exactly)
+		__m256 values[3], steps[3];
+		{
+			const auto x = _mm256_add_ps( _mm256_set1_ps( i_x ), _mm256_setr_ps( 0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f ) );
+			for ( unsigned int i = 0; i < 3; ++i )
+			{
+				const auto& edge = i_edges[i];
+				const auto rowValue = _mm256_set1_ps( ( edge[1] * ( i_y + 0.5f ) ) + edge[2] );
+				values[i] = _mm256_add_ps( _mm256_mul_ps( _mm256_set1_ps( edge[0] ), x ), rowValue );
+				steps[i] = _mm256_set1_ps( edge[1] );
+			}
+		}
+		const auto zero = _mm256_setzero_ps();
+		for ( unsigned int y = 0; y < 8; ++y )
+		{
+			const auto isInside = _mm256_and_ps( _mm256_and_ps( _mm256_cmp_ps( values[0], zero, _CMP_GE_OQ ),
+				_mm256_cmp_ps( values[1], zero, _CMP_GE_OQ ) ), _mm256_cmp_ps( values[2], zero, _CMP_GE_OQ ) );
+			coverage |= static_cast<uint64_t>( _mm256_movemask_ps( isInside ) ) << ( y * 8 );
+			for ( unsigned int i = 0; i < 3; ++i )
+			{
+				values[i] = _mm256_add_ps( values[i], steps[i] );
+			}
+		}
+		return coverage;
+	}
+
+	bool IsAvxSupported()
+	{
+#if !defined( __GNUC__ ) && !defined( __clang__ )
+		// The CPU must support AVX and the operating system must save the 256-bit registers when it switches threads
+		int cpuInfo[4];
+		__cpuid( cpuInfo, 1 );
+		constexpr int osxsaveBit = 1 << 27, avxBit = 1 << 28;
+		if ( ( cpuInfo[2] & ( osxsaveBit | avxBit ) ) != ( osxsaveBit | avxBit ) )
+		{
+			return false;
+		}
+		constexpr unsigned long long xmmAndYmmState = 0x6;
+		return ( _xgetbv( 0 ) & xmmAndYmmState ) == xmmAndYmmState;
+#else
+		// This checks the operating system support as well
+		__builtin_cpu_init();
+		return __builtin_cpu_supports( "avx" ) != 0;
+#endif
+	}
+#endif
+
+	uint16_t GetTileIndex( const float i_pixel, const uint16_t i_tileCount )
+	{
+		constexpr auto tileSize = static_cast<float>( eae6320::Graphics::cOcclusionCuller::s_tileSize );
+		return static_cast<uint16_t>( std::min( std::max( std::floor( i_pixel / tileSize ), 0.0f ), static_cast<float>( i_tileCount - 1 ) ) );
+	}
+
+	uint8_t ConvertDepthToGrayscale( const float i_depth )
+	{
+		const auto depth = std::min( std::max( ( i_depth - s_depth_near ) / ( 1.0f - s_depth_near ), 0.0f ), 1.0f );
+		return static_cast<uint8_t>( ( depth * 255.0f ) + 0.5f );
+	}
+}
@@ -0,0 +1,182 @@
+/*
+	An occlusion culler removes objects that are hidden behind other objects
+	before they are submitted
+
+	A small set of occluders (meshes that were built with "isOccluder = true")
+	is rasterized on the CPU into a low-resolution depth buffer,
+	and then the bounding boxes of other objects are tested against it.
+
+	The depth buffer is a grid of 8x8 pixel tiles,
+	and every tile stores two depths and a coverage mask instead of a depth per pixel
+	(Andersson et al.'s "Masked Software Occlusion Culling"):
+		* The reference depth is the farthest depth of occluders that cover the whole tile,
+			and anything behind it is hidden
+		* The working depth and mask accumulate occluders that only cover part of the tile,
+			and when the mask is full the working depth becomes the new reference depth
+
+	The culler doesn't use the graphics API,
+	and so it can run (and be tested) without a window
+*/
+
+#ifndef EAE6320_GRAPHICS_COCCLUSIONCULLER_H
+#define EAE6320_GRAPHICS_COCCLUSIONCULLER_H
+
+// Includes
+//=========
+
+#include "Configuration.h"
+
+#include <cstdint>
+#include <Engine/Results/Results.h>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Math
+	{
+		class cMatrix_transformation;
+		struct sVector;
+	}
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class cOcclusionCuller
+		{
+			// Interface
+			//==========
+
+		public:
+
+			struct sStatistics
+			{
+				uint32_t occluderTriangleCount = 0;
+				uint32_t testedCount = 0;
+				uint32_t occludedCount = 0;
+			};
+
+			static constexpr unsigned int s_tileSize = 8;
+
+			// Frame
+			//------
+
+			// This must be called with the same matrices that are submitted to Graphics
+			// before any occluders are added
+			void BeginFrame( const Math::cMatrix_transformation& i_transform_worldToCamera, const Math::cMatrix_transformation& i_transform_cameraToProjected );
+			// The positions are three floats per vertex in model space,
+			// and front faces are clockwise (see MeshFormats::sOccluder)
+			void AddOccluder( const float* const i_positions, const uint32_t i_vertexCount, const uint32_t* const i_indices, const uint32_t i_indexCount,
+				const Math::cMatrix_transformation& i_transform_localToWorld );
+			// Rasterizes every occluder that was added since BeginFrame()
+			// (the worker threads each rasterize a band of tiles while the calling thread rasterizes the first one)
+			void RenderOccluders();
+
+			// Testing
+			//--------
+
+			// Returns false if the box is completely hidden by the occluders
+			// or completely outside of the screen
+			bool IsVisible( const Math::sVector& i_minimum_world, const Math::sVector& i_maximum_world );
+
+			// The statistics accumulate until they are reset
+			const sStatistics& GetStatistics() const { return m_statistics; }
+			void ResetStatistics() { m_statistics = sStatistics(); }
+
+			// Debugging
+			//----------
+
+			// Writes a grayscale PGM image with the reference depth of every pixel
+			// (black is the near plane and white is the far plane or no occluder)
+			// so that the rasterizer can be compared to reference images
+			cResult SaveDepthImage( const char* const i_path ) const;
+
+#ifdef EAE6320_GRAPHICS_ISOCCLUSIONBENCHMARKENABLED
+			// Culls a synthetic interior and writes the costs to the log
+			static void RunBenchmark();
+#endif
+#ifdef EAE6320_GRAPHICS_ISOCCLUSIONTESTENABLED
+			// Rasterizes a fixed set of occluders with every coverage path and with and without worker threads
+			// and asserts (and writes to the log) if the depth image or the visibility of a fixed set of boxes
+			// doesn't match the stored reference
+			static void RunReferenceTest();
+#endif
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// The resolution is rounded up to whole tiles
+			cResult Initialize( const uint16_t i_width, const uint16_t i_height, const uint8_t i_workerThreadCount );
+			cResult CleanUp();
+
+			cOcclusionCuller() = default;
+			~cOcclusionCuller();
+
+			cOcclusionCuller( const cOcclusionCuller& ) = delete;
+			cOcclusionCuller( cOcclusionCuller&& ) = delete;
+			cOcclusionCuller& operator =( const cOcclusionCuller& ) = delete;
+			cOcclusionCuller& operator =( cOcclusionCuller&& ) = delete;
+
+			// Data
+			//=====
+
+		private:
+
+			struct sTile
+			{
+				// One bit per pixel, row by row from the bottom left
+				uint64_t mask;
+				float depth_reference;
+				float depth_working;
+			};
+			// A triangle that has been clipped and projected into pixels
+			struct sTriangle
+			{
+				// Each edge is ( a, b, c ) where a pixel is inside if ax + by + c >= 0
+				float edges[3][3];
+				// depth = ax + by + c
+				float depthPlane[3];
+				float depth_maximum;
+				uint16_t tile_minimumX, tile_minimumY, tile_maximumX, tile_maximumY;
+			};
+			struct sWorker;
+
+			std::vector<sTile> m_tiles;
+			std::vector<sTriangle> m_triangles;
+			// The projected positions of the occluder being added (four floats per vertex)
+			std::vector<float> m_vertices_projected;
+			// The rows of the world-to-projected transform
+			float m_transform_worldToProjected[4][4] = {};
+			uint16_t m_width = 0, m_height = 0;
+			uint16_t m_tileCountX = 0, m_tileCountY = 0;
+
+			// This is the 256-bit version if the CPU supports AVX
+			// and otherwise the 128-bit (or scalar) version
+			uint64_t ( *m_calculateCoverage )( const float ( &i_edges )[3][3], const float i_x, const float i_y ) = nullptr;
+
+			sWorker* m_workers = nullptr;
+			uint8_t m_workerCount = 0;
+			bool m_shouldWorkersStop = false;
+
+			sStatistics m_statistics;
+
+			// Implementation
+			//===============
+
+		private:
+
+			void AddTriangle( const float ( &i_vertices )[3][4] );
+			void RasterizeBand( const unsigned int i_bandIndex );
+			static void RasterizeInBackground( void* const io_worker );
+		};
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_COCCLUSIONCULLER_H
@@ -0,0 +1,295 @@
+// Includes
+//=========
+
+#include "cRenderQueue.h"
+
+#include "cEffect.h"
+#include "cFrameAllocator.h"
+#include "cMaterial.h"
+#include "cMesh.h"
+#include "cSortIdAllocator.h"
+#include "sRenderCommand.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Math/cMatrix_transformation.h>
+#include <Engine/Math/sVector.h>
+#include <cstring>
+#include <utility>
+
+#ifdef EAE6320_GRAPHICS_ISRENDERQUEUEBENCHMARKENABLED
+	#include <Engine/Time/Time.h>
+#endif
+
+// Static Data
+//============
+
+namespace
+{
+	// Key layout (from most to least significant bit):
+	//	Opaque:			pass(4) | translucent(1) | effect(12) | material(12) | mesh(12) | depth(23)
+	//	Translucent:	pass(4) | translucent(1) | inverted depth(23) | effect(12) | material(12) | mesh(12)
+	constexpr unsigned int s_bitCount_id = 12;
+	constexpr unsigned int s_bitCount_depth = 23;
+	constexpr uint64_t s_mask_id = ( uint64_t( 1 ) << s_bitCount_id ) - 1;
+	static_assert( ( s_mask_id + 1 ) == eae6320::Graphics::cSortIdAllocator::s_idCount, "Every sort ID must fit in a key" );
+	constexpr uint64_t s_mask_depth = ( uint64_t( 1 ) << s_bitCount_depth ) - 1;
+	constexpr uint64_t s_mask_pass = 0xf;
+
+	constexpr unsigned int s_shift_pass = 60;
+	constexpr unsigned int s_shift_translucent = 59;
+
+	// The keys are sorted one byte at a time
+	constexpr unsigned int s_radixBitCount = 8;
+	constexpr unsigned int s_radixBucketCount = 1 << s_radixBitCount;
+	constexpr unsigned int s_radixPassCount = 64 / s_radixBitCount;
+}
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	uint64_t QuantizeDepth( const float i_viewDepth );
+}
+
+// Interface
+//==========
+
+// Sort Keys
+//----------
+
+uint64_t eae6320::Graphics::cRenderQueue::CreateSortKey( const uint8_t i_pass, const bool i_isTranslucent,
+	const uint16_t i_effectId, const uint16_t i_materialId, const uint16_t i_meshId, const float i_viewDepth )
+{
+	EAE6320_ASSERT( i_pass <= s_mask_pass );
+
+	const auto depth = QuantizeDepth( i_viewDepth );
+	const auto state = ( ( i_effectId & s_mask_id ) << ( 2 * s_bitCount_id ) )
+		| ( ( i_materialId & s_mask_id ) << s_bitCount_id )
+		| ( i_meshId & s_mask_id );
+
+	auto sortKey = ( static_cast<uint64_t>( i_pass & s_mask_pass ) << s_shift_pass );
+	if ( !i_isTranslucent )
+	{
+		sortKey |= ( state << s_bitCount_depth ) | depth;
+	}
+	else
+	{
+		// Translucent geometry must be blended back-to-front,
+		// and so the depth is inverted and is more significant than the state
+		sortKey |= ( uint64_t( 1 ) << s_shift_translucent )
+			| ( ( s_mask_depth - depth ) << ( 3 * s_bitCount_id ) )
+			| state;
+	}
+	return sortKey;
+}
+
+uint64_t eae6320::Graphics::cRenderQueue::CreateSortKey( const sRenderCommand& i_renderCommand, const Math::cMatrix_transformation& i_transform_worldToCamera )
+{
+	EAE6320_ASSERT( i_renderCommand.m_mesh );
+	const auto* const mesh = i_renderCommand.m_mesh;
+	const auto* const material = mesh->GetPrimaryMaterial();
+	const auto* const effect = material ? material->GetEffect() : nullptr;
+
+	// The camera looks down the negative Z axis
+	const auto position_camera = i_transform_worldToCamera * i_renderCommand.m_transformation.GetTranslation();
+
+	return CreateSortKey( i_renderCommand.m_renderPass, material ? material->IsTranslucent() : false,
+		effect ? effect->GetSortId() : 0, material ? material->GetSortId() : 0, mesh->GetSortId(),
+		-position_camera.z );
+}
+
+// Queue
+//------
+
+eae6320::cResult eae6320::Graphics::cRenderQueue::Begin( cFrameAllocator& i_frameAllocator, const uint32_t i_capacity )
+{
+	m_count = 0;
+	m_capacity = 0;
+
+	m_entries = i_frameAllocator.Allocate<sEntry>( i_capacity );
+	m_entries_scratch = i_frameAllocator.Allocate<sEntry>( i_capacity );
+	if ( !m_entries || !m_entries_scratch )
+	{
+		EAE6320_ASSERTF( false, "Couldn't allocate memory for the render queue" );
+		Logging::OutputError( "Failed to allocate memory for a render queue of %u commands", i_capacity );
+		return Results::OutOfMemory;
+	}
+	m_capacity = i_capacity;
+
+	return Results::Success;
+}
+
+void eae6320::Graphics::cRenderQueue::Push( const uint64_t i_sortKey, sRenderCommand* const i_command )
+{
+	EAE6320_ASSERTF( m_count < m_capacity, "The render queue is full" );
+	if ( m_count < m_capacity )
+	{
+		auto& entry = m_entries[m_count++];
+		entry.sortKey = i_sortKey;
+		entry.command = i_command;
+	}
+}
+
+void eae6320::Graphics::cRenderQueue::Sort()
+{
+	if ( m_count < 2 )
+	{
+		return;
+	}
+
+	// Build the histograms for every digit with a single read of the keys
+	uint32_t histograms[s_radixPassCount][s_radixBucketCount] = {};
+	for ( uint32_t i = 0; i < m_count; ++i )
+	{
+		auto sortKey = m_entries[i].sortKey;
+		for ( unsigned int j = 0; j < s_radixPassCount; ++j )
+		{
+			++histograms[j][sortKey & ( s_radixBucketCount - 1 )];
+			sortKey >>= s_radixBitCount;
+		}
+	}
+
+	// Least significant digit first so that each pass preserves the order of the previous ones
+	for ( unsigned int j = 0; j < s_radixPassCount; ++j )
+	{
+		auto& histogram = histograms[j];
+		const auto shift = j * s_radixBitCount;
+
+		// If every key has the same digit then this pass wouldn't change anything
+		// (this is common because most frames only use a few passes, effects, and materials)
+		if ( histogram[( m_entries[0].sortKey >> shift ) & ( s_radixBucketCount - 1 )] == m_count )
+		{
+			continue;
+		}
+
+		uint32_t offset = 0;
+		for ( auto& bucket : histogram )
+		{
+			const auto count = bucket;
+			bucket = offset;
+			offset += count;
+		}
+		for ( uint32_t i = 0; i < m_count; ++i )
+		{
+			const auto& entry = m_entries[i];
+			m_entries_scratch[histogram[( entry.sortKey >> shift ) & ( s_radixBucketCount - 1 )]++] = entry;
+		}
+		std::swap( m_entries, m_entries_scratch );
+	}
+}
+
+// Benchmark
+//----------
+
+#ifdef EAE6320_GRAPHICS_ISRENDERQUEUEBENCHMARKENABLED
+
+void eae6320::Graphics::cRenderQueue::RunBenchmark()
+{
+	constexpr uint32_t commandCounts[] = { 10000, 20000, 30000, 40000, 50000, 60000 };
+	constexpr uint32_t maxCommandCount = 60000;
+	constexpr unsigned int iterationCount = 16;
+	// The synthetic scene has a handful of effects, more materials, and many meshes
+	constexpr uint16_t effectCount = 8, materialCount = 64, meshCount = 512;
+
+	// The synthetic commands are only used for their addresses
+	// (the IDs for a command are stored at the same index in a parallel array)
+	struct sIds { uint16_t effect, material, mesh; };
+	cFrameAllocator frameAllocator_scene, frameAllocator_queue;
+	if ( !frameAllocator_scene.Initialize( maxCommandCount * ( sizeof( sRenderCommand ) + sizeof( sIds ) + sizeof( uint64_t ) + 64 ) )
+		|| !frameAllocator_queue.Initialize( maxCommandCount * 2 * sizeof( sEntry ) + 64 ) )
+	{
+		Logging::OutputError( "The render queue benchmark couldn't allocate its data" );
+		return;
+	}
+	auto* const commands = frameAllocator_scene.Allocate<sRenderCommand>( maxCommandCount );
+	auto* const ids = frameAllocator_scene.Allocate<sIds>( maxCommandCount );
+	auto* const sortKeys = frameAllocator_scene.Allocate<uint64_t>( maxCommandCount );
+	if ( !commands || !ids || !sortKeys )
+	{
+		Logging::OutputError( "The render queue benchmark couldn't allocate its data" );
+		return;
+	}
+
+	// A fixed LCG makes the results comparable between runs
+	uint32_t randomState = 6320;
+	const auto GetRandom = [&randomState]( const uint32_t i_max )
+	{
+		randomState = ( randomState * 1664525u ) + 1013904223u;
+		return ( randomState >> 8 ) % i_max;
+	};
+	for ( uint32_t i = 0; i < maxCommandCount; ++i )
+	{
+		auto& id = ids[i];
+		id.mesh = static_cast<uint16_t>( 1 + GetRandom( meshCount ) );
+		// Each mesh always uses the same material, and each material the same effect
+		id.material = static_cast<uint16_t>( 1 + ( id.mesh % materialCount ) );
+		id.effect = static_cast<uint16_t>( 1 + ( id.material % effectCount ) );
+		const auto isTranslucent = ( id.material % 10 ) == 0;
+		const auto viewDepth = 0.5f + static_cast<float>( GetRandom( 100000 ) ) * 0.01f;
+		sortKeys[i] = CreateSortKey( 0, isTranslucent, id.effect, id.material, id.mesh, viewDepth );
+	}
+
+	const auto CountBinds = [ids]( const uint32_t i_commandCount, const auto& i_GetCommandIndex )
+	{
+		uint32_t bindCount = 0;
+		sIds previous = { 0, 0, 0 };
+		for ( uint32_t i = 0; i < i_commandCount; ++i )
+		{
+			const auto& current = ids[i_GetCommandIndex( i )];
+			bindCount += ( current.effect != previous.effect ) ? 1 : 0;
+			bindCount += ( current.material != previous.material ) ? 1 : 0;
+			bindCount += ( current.mesh != previous.mesh ) ? 1 : 0;
+			previous = current;
+		}
+		return bindCount;
+	};
+
+	Logging::OutputMessage( "Render queue benchmark (%u effects, %u materials, %u meshes, %u iterations):",
+		effectCount, materialCount, meshCount, iterationCount );
+	cRenderQueue renderQueue;
+	for ( const auto commandCount : commandCounts )
+	{
+		uint64_t tickCount_total = 0;
+		for ( unsigned int j = 0; j < iterationCount; ++j )
+		{
+			frameAllocator_queue.Reset();
+			const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+			renderQueue.Begin( frameAllocator_queue, commandCount );
+			for ( uint32_t i = 0; i < commandCount; ++i )
+			{
+				renderQueue.Push( sortKeys[i], commands + i );
+			}
+			renderQueue.Sort();
+			tickCount_total += Time::GetCurrentSystemTimeTickCount() - tickCount_start;
+		}
+		const auto bindCount_unsorted = CountBinds( commandCount, []( const uint32_t i_index ) { return i_index; } );
+		const auto bindCount_sorted = CountBinds( commandCount,
+			[&renderQueue, commands]( const uint32_t i_index ) { return static_cast<uint32_t>( renderQueue.GetCommand( i_index ) - commands ); } );
+		Logging::OutputMessage( "\t%u commands: %.3f ms per sort, %u binds unsorted, %u binds sorted",
+			commandCount, Time::ConvertTicksToSeconds( tickCount_total ) * 1000.0 / iterationCount,
+			bindCount_unsorted, bindCount_sorted );
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_ISRENDERQUEUEBENCHMARKENABLED
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	uint64_t QuantizeDepth( const float i_viewDepth )
+	{
+		if ( !( i_viewDepth > 0.0f ) )
+		{
+			return 0;
+		}
+		// The bit pattern of a positive float increases monotonically with its value,
+		// and so the most significant bits can be used directly without knowing the depth range
+		uint32_t bits;
+		memcpy( &bits, &i_viewDepth, sizeof( bits ) );
+		return static_cast<uint64_t>( bits >> ( 31 - s_bitCount_depth ) ) & s_mask_depth;
+	}
+}
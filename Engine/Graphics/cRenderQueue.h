@@ -0,0 +1,104 @@
+/*
+	A render queue orders the render commands that were submitted for a frame
+	so that commands sharing state are drawn together.
+
+	Every command gets a 64-bit sort key, which is radix sorted along with a pointer to the command:
+		* The pass is the most significant field, so passes are always drawn in order
+		* Opaque commands come before translucent ones
+		* Opaque commands are grouped by effect, then material, then mesh, and are drawn front-to-back within a group
+		* Translucent commands are drawn back-to-front, and state is only grouped when depths are equal
+*/
+
+#ifndef EAE6320_GRAPHICS_CRENDERQUEUE_H
+#define EAE6320_GRAPHICS_CRENDERQUEUE_H
+
+// Includes
+//=========
+
+#include "Configuration.h"
+
+#include <cstdint>
+#include <Engine/Results/Results.h>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class cFrameAllocator;
+		struct sRenderCommand;
+	}
+
+	namespace Math
+	{
+		class cMatrix_transformation;
+	}
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class cRenderQueue
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Sort Keys
+			//----------
+
+			static uint64_t CreateSortKey( const uint8_t i_pass, const bool i_isTranslucent,
+				const uint16_t i_effectId, const uint16_t i_materialId, const uint16_t i_meshId,
+				// The distance in front of the camera (negative distances are treated as zero)
+				const float i_viewDepth );
+			static uint64_t CreateSortKey( const sRenderCommand& i_renderCommand, const Math::cMatrix_transformation& i_transform_worldToCamera );
+
+			// Queue
+			//------
+
+			// Empties the queue and allocates space for i_capacity commands from the given frame allocator
+			// (the queue must not be used after the allocator is reset)
+			cResult Begin( cFrameAllocator& i_frameAllocator, const uint32_t i_capacity );
+			void Push( const uint64_t i_sortKey, sRenderCommand* const i_command );
+			// Sorts the pushed commands by key (the sort is stable)
+			void Sort();
+
+			uint32_t GetCount() const { return m_count; }
+			sRenderCommand* GetCommand( const uint32_t i_index ) const { return m_entries[i_index].command; }
+			uint64_t GetSortKey( const uint32_t i_index ) const { return m_entries[i_index].sortKey; }
+
+#ifdef EAE6320_GRAPHICS_ISRENDERQUEUEBENCHMARKENABLED
+			// Sorts synthetic scenes of 10k-60k commands and logs the sort cost
+			// and the number of effect/material/mesh binds before and after sorting
+			static void RunBenchmark();
+#endif
+
+			// Data
+			//=====
+
+		private:
+
+			struct sEntry
+			{
+				uint64_t sortKey;
+				sRenderCommand* command;
+			};
+
+			// The sort ping-pongs between the two arrays
+			// (the memory is owned by the frame allocator that was passed to Begin())
+			sEntry* m_entries = nullptr;
+			sEntry* m_entries_scratch = nullptr;
+			uint32_t m_count = 0;
+			uint32_t m_capacity = 0;
+		};
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_CRENDERQUEUE_H
@@ -53,6 +53,11 @@ namespace
 	} s_shaderTracker;
 }
 
+// Static Data
+//============
+
+eae6320::Assets::cManager<eae6320::Graphics::cShader> eae6320::Graphics::cShader::s_manager;
+
 // Interface
 //==========
 
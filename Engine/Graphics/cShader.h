@@ -13,6 +13,7 @@
 
 #include "Configuration.h"
 
+#include <Engine/Assets/cManager.h>
 #include <Engine/Assets/ReferenceCountedAssets.h>
 
 #include <cstdint>
@@ -81,6 +82,10 @@ namespace eae6320
 			// Initialization / Clean Up
 			//--------------------------
 
+			// Shaders are shared between effects through s_manager
+			// (which calls Load() the first time that a path is requested)
+			static Assets::cManager<cShader> s_manager;
+
 			static cResult Load( const std::string& i_path, cShader*& o_shader, const eShaderType i_type );
 
 			EAE6320_ASSETS_DECLAREDELETEDREFERENCECOUNTEDFUNCTIONS( cShader );
@@ -0,0 +1,48 @@
+// Includes
+//=========
+
+#include "cSortIdAllocator.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+
+// Interface
+//==========
+
+uint16_t eae6320::Graphics::cSortIdAllocator::Acquire()
+{
+	uint16_t id;
+	if ( m_releasedIds.TryToPop( id ) )
+	{
+		return id;
+	}
+	// The counter stops at the last ID
+	// so that it can't wrap around and hand out IDs that are still in use
+	auto nextId = m_nextId.load( std::memory_order_relaxed );
+	while ( nextId < s_idCount )
+	{
+		if ( m_nextId.compare_exchange_weak( nextId, nextId + 1, std::memory_order_relaxed ) )
+		{
+			return static_cast<uint16_t>( nextId );
+		}
+	}
+	// Another thread could have released an ID since the queue was checked
+	if ( m_releasedIds.TryToPop( id ) )
+	{
+		return id;
+	}
+	Logging::OutputError( "More than %u assets of one kind exist, and so their sort IDs are shared", s_idCount - 1u );
+	return 0;
+}
+
+void eae6320::Graphics::cSortIdAllocator::Release( const uint16_t i_id )
+{
+	if ( i_id == 0 )
+	{
+		return;
+	}
+	EAE6320_ASSERT( i_id < s_idCount );
+	const auto wasPushed = m_releasedIds.TryToPush( i_id );
+	EAE6320_ASSERTF( wasPushed, "Sort ID %u was released more times than it was acquired", i_id );
+	static_cast<void>( wasPushed );
+}
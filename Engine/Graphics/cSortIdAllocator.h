@@ -0,0 +1,60 @@
+/*
+	A sort ID allocator hands out the small dense IDs
+	that the render queue packs into its sort keys (see cRenderQueue.h)
+
+	IDs are given back when the asset that owns one is destroyed
+	and are reused before any new ones are handed out,
+	and so the IDs only run out if more assets of one kind exist at the same time than there are IDs.
+	Any thread can acquire and release IDs without locking
+	(assets can be loaded from jobs)
+*/
+
+#ifndef EAE6320_GRAPHICS_CSORTIDALLOCATOR_H
+#define EAE6320_GRAPHICS_CSORTIDALLOCATOR_H
+
+// Includes
+//=========
+
+#include <atomic>
+#include <cstdint>
+#include <Engine/Concurrency/cMpmcQueue.h>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class cSortIdAllocator
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// The render queue's sort keys have 12 bits for each kind of ID,
+			// and 0 is reserved to mean "none" (e.g. a mesh without a material)
+			static constexpr uint16_t s_idCount = 1 << 12;
+
+			// If every ID is in use this returns 0,
+			// which only means that the asset isn't grouped with others like it when sorting
+			uint16_t Acquire();
+			// 0 can be released (it is ignored)
+			void Release( const uint16_t i_id );
+
+			// Data
+			//=====
+
+		private:
+
+			// IDs that have been released are reused first
+			// (there can never be more of them than there are IDs, and so pushing can't fail)
+			Concurrency::cMpmcQueue<uint16_t, s_idCount> m_releasedIds;
+			// The next ID that has never been handed out
+			std::atomic<uint32_t> m_nextId = 1;
+		};
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_CSORTIDALLOCATOR_H
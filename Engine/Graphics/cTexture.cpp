@@ -0,0 +1,258 @@
+// Includes
+//=========
+
+#include "cTexture.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Platform/Platform.h>
+#include <Engine/ScopeGuard/cScopeGuard.h>
+#include <new>
+
+// Static Data
+//============
+
+eae6320::Assets::cManager<eae6320::Graphics::cTexture> eae6320::Graphics::cTexture::s_manager;
+
+std::atomic<uint64_t> eae6320::Graphics::cTexture::s_residentMemorySize( 0 );
+std::atomic<uint32_t> eae6320::Graphics::cTexture::s_residentTextureCount( 0 );
+
+namespace
+{
+	// Direct3D textures are always uploaded as RGBA
+	// but OpenGL textures keep the number of components that the file has
+#if defined( EAE6320_PLATFORM_D3D )
+	constexpr int s_requiredComponentCount = 4;
+#elif defined( EAE6320_PLATFORM_GL )
+	constexpr int s_requiredComponentCount = 0;
+#endif
+}
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	bool IsBuiltTexturePath( const std::string& i_path );
+	eae6320::cResult ValidateBuiltTexture( const eae6320::Platform::sDataFromFile& i_dataFromFile,
+		eae6320::Graphics::TextureFormats::sHeader& o_header, std::string& o_errorMessage );
+}
+
+// Interface
+//==========
+
+// Access
+//-------
+
+std::string eae6320::Graphics::cTexture::NormalizePath( const std::string& i_path )
+{
+	// Windows paths aren't case sensitive and can use either kind of slash
+	std::string normalizedPath;
+	normalizedPath.reserve( i_path.size() );
+	for ( const auto character : i_path )
+	{
+		if ( character == '\\' )
+		{
+			normalizedPath.push_back( '/' );
+		}
+		else
+		{
+			normalizedPath.push_back( static_cast<char>( std::tolower( static_cast<unsigned char>( character ) ) ) );
+		}
+	}
+	// Remove redundant separators and "current directory" components
+	{
+		size_t position;
+		while ( ( position = normalizedPath.find( "//" ) ) != std::string::npos )
+		{
+			normalizedPath.erase( position, 1 );
+		}
+		while ( ( position = normalizedPath.find( "/./" ) ) != std::string::npos )
+		{
+			normalizedPath.erase( position, 2 );
+		}
+		while ( normalizedPath.compare( 0, 2, "./" ) == 0 )
+		{
+			normalizedPath.erase( 0, 2 );
+		}
+	}
+	return normalizedPath;
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cTexture::Load( const std::string& i_path, cTexture*& o_texture )
+{
+	auto result = Results::Success;
+
+	unsigned char* decodedData = nullptr;
+	cTexture* newTexture = nullptr;
+	cScopeGuard scopeGuard( [&o_texture, &result, &decodedData, &newTexture]
+		{
+			if ( decodedData )
+			{
+				free( decodedData );
+				decodedData = nullptr;
+			}
+			if ( result )
+			{
+				EAE6320_ASSERT( newTexture != nullptr );
+				o_texture = newTexture;
+			}
+			else
+			{
+				if ( newTexture )
+				{
+					newTexture->DecrementReferenceCount();
+					newTexture = nullptr;
+				}
+				o_texture = nullptr;
+			}
+		} );
+
+	// Allocate a new texture
+	{
+		newTexture = new ( std::nothrow ) cTexture();
+		if ( !newTexture )
+		{
+			result = Results::OutOfMemory;
+			EAE6320_ASSERTF( false, "Couldn't allocate memory for the texture %s", i_path.c_str() );
+			Logging::OutputError( "Failed to allocate memory for the texture %s", i_path.c_str() );
+			return result;
+		}
+	}
+	unsigned int width = 0, height = 0;
+	if ( IsBuiltTexturePath( i_path ) )
+	{
+		// Built textures are uploaded without being decoded
+		Platform::sDataFromFile dataFromFile;
+		{
+			std::string errorMessage;
+			if ( !( result = Platform::LoadBinaryFile( i_path.c_str(), dataFromFile, &errorMessage ) ) )
+			{
+				EAE6320_ASSERTF( false, errorMessage.c_str() );
+				Logging::OutputError( "Failed to load texture from file %s: %s", i_path.c_str(), errorMessage.c_str() );
+				return result;
+			}
+		}
+		TextureFormats::sHeader header;
+		{
+			std::string errorMessage;
+			if ( !( result = ValidateBuiltTexture( dataFromFile, header, errorMessage ) ) )
+			{
+				EAE6320_ASSERTF( false, errorMessage.c_str() );
+				Logging::OutputError( "The built texture %s is invalid: %s", i_path.c_str(), errorMessage.c_str() );
+				return result;
+			}
+		}
+		if ( !( result = newTexture->Initialize( i_path, header, static_cast<const uint8_t*>( dataFromFile.data ) + sizeof( header ) ) ) )
+		{
+			EAE6320_ASSERTF( false, "Initialization of new texture failed" );
+			return result;
+		}
+		width = header.width;
+		height = header.height;
+	}
+	else
+	{
+		// Decode the image file
+		int componentCount = 0;
+		{
+			int width_decoded = 0, height_decoded = 0;
+			std::string errorMessage;
+			if ( !( result = Platform::LoadTextureFile( i_path.c_str(), decodedData, width_decoded, height_decoded, componentCount,
+				s_requiredComponentCount, &errorMessage ) ) )
+			{
+				EAE6320_ASSERTF( false, errorMessage.c_str() );
+				Logging::OutputError( "Failed to load texture from file %s: %s", i_path.c_str(), errorMessage.c_str() );
+				return result;
+			}
+			if ( s_requiredComponentCount != 0 )
+			{
+				componentCount = s_requiredComponentCount;
+			}
+			width = static_cast<unsigned int>( width_decoded );
+			height = static_cast<unsigned int>( height_decoded );
+		}
+		// Upload the image to the GPU
+		if ( !( result = newTexture->Initialize( i_path, decodedData, width, height, static_cast<unsigned int>( componentCount ) ) ) )
+		{
+			EAE6320_ASSERTF( false, "Initialization of new texture failed" );
+			return result;
+		}
+	}
+
+	const auto residentMemorySize = ( s_residentMemorySize += newTexture->m_memorySize );
+	const auto residentTextureCount = ++s_residentTextureCount;
+	Logging::OutputMessage( "Loaded the texture %s (%u x %u, %.1f KB): %u textures use %.2f MB",
+		i_path.c_str(), width, height, static_cast<double>( newTexture->m_memorySize ) / 1024.0,
+		residentTextureCount, static_cast<double>( residentMemorySize ) / ( 1024.0 * 1024.0 ) );
+
+	return result;
+}
+
+eae6320::Graphics::cTexture::~cTexture()
+{
+	if ( m_memorySize > 0 )
+	{
+		s_residentMemorySize -= m_memorySize;
+		--s_residentTextureCount;
+	}
+
+	const auto result = CleanUp();
+	EAE6320_ASSERT( result );
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	bool IsBuiltTexturePath( const std::string& i_path )
+	{
+		constexpr char extension[] = ".tex";
+		constexpr auto extensionLength = sizeof( extension ) - 1;
+		return ( i_path.size() > extensionLength ) && ( i_path.compare( i_path.size() - extensionLength, extensionLength, extension ) == 0 );
+	}
+
+	eae6320::cResult ValidateBuiltTexture( const eae6320::Platform::sDataFromFile& i_dataFromFile,
+		eae6320::Graphics::TextureFormats::sHeader& o_header, std::string& o_errorMessage )
+	{
+		using namespace eae6320::Graphics;
+
+		if ( i_dataFromFile.size < sizeof( o_header ) )
+		{
+			o_errorMessage = "The file is too small to have a header";
+			return eae6320::Results::InvalidFile;
+		}
+		memcpy( &o_header, i_dataFromFile.data, sizeof( o_header ) );
+		if ( ( o_header.fourCc != TextureFormats::sHeader::s_fourCc ) || ( o_header.version != TextureFormats::sHeader::s_version ) )
+		{
+			o_errorMessage = "The file isn't a built texture of the current version (it must be rebuilt)";
+			return eae6320::Results::InvalidFile;
+		}
+		if ( ( o_header.format >= TextureFormats::eFormat::Count ) || ( o_header.width == 0 ) || ( o_header.height == 0 )
+			|| ( o_header.mipCount == 0 ) || ( o_header.mipCount > TextureFormats::GetFullMipCount( o_header.width, o_header.height ) ) )
+		{
+			o_errorMessage = "The header is invalid";
+			return eae6320::Results::InvalidFile;
+		}
+		size_t expectedSize = sizeof( o_header );
+		for ( uint8_t i = 0; i < o_header.mipCount; ++i )
+		{
+			expectedSize += TextureFormats::GetMipSize( o_header.format,
+				TextureFormats::GetMipDimension( o_header.width, i ), TextureFormats::GetMipDimension( o_header.height, i ) );
+		}
+		if ( i_dataFromFile.size < expectedSize )
+		{
+			o_errorMessage = "The file is smaller than the mips that the header describes";
+			return eae6320::Results::InvalidFile;
+		}
+
+		return eae6320::Results::Success;
+	}
+}
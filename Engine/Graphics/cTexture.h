@@ -0,0 +1,131 @@
+/*
+	A texture is an image that has been uploaded to the GPU
+
+	Built textures (".tex" files written by TextureBuilder) already contain block-compressed mips
+	and are uploaded as they are;
+	other image files are decoded when they are loaded and their mips are generated by the GPU
+
+	Textures are shared:
+	They are loaded through cTexture::s_manager
+	so that every material that uses the same image file gets the same texture
+	(and the file is only decoded and uploaded once)
+*/
+
+#ifndef EAE6320_GRAPHICS_CTEXTURE_H
+#define EAE6320_GRAPHICS_CTEXTURE_H
+
+// Includes
+//=========
+
+#include "Configuration.h"
+#include "TextureFormats.h"
+
+#include <atomic>
+#include <cstdint>
+#include <Engine/Assets/cManager.h>
+#include <Engine/Assets/ReferenceCountedAssets.h>
+#include <Engine/Results/Results.h>
+#include <string>
+
+#ifdef EAE6320_PLATFORM_GL
+	#include "OpenGL/Includes.h"
+#endif
+
+// Forward Declarations
+//=====================
+
+#ifdef EAE6320_PLATFORM_D3D
+	struct ID3D11Texture2D;
+	struct ID3D11ShaderResourceView;
+	struct ID3D11SamplerState;
+#endif
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class cTexture
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Render
+			//-------
+
+			void Bind( const unsigned int i_unit ) const;
+
+			// Access
+			//-------
+
+			static Assets::cManager<cTexture> s_manager;
+
+			// Paths are normalized before they are used as the manager's keys
+			// so that different spellings of the same file share a single texture
+			static std::string NormalizePath( const std::string& i_path );
+
+			// The estimated number of bytes of GPU memory used by this texture (including its mip chain)
+			uint64_t GetMemorySize() const { return m_memorySize; }
+			// The estimated number of bytes of GPU memory used by every texture that is currently loaded
+			static uint64_t GetResidentMemorySize() { return s_residentMemorySize; }
+			static uint32_t GetResidentTextureCount() { return s_residentTextureCount; }
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// This is called by s_manager;
+			// the path must already be normalized
+			static cResult Load( const std::string& i_path, cTexture*& o_texture );
+
+			EAE6320_ASSETS_DECLAREDELETEDREFERENCECOUNTEDFUNCTIONS( cTexture );
+
+			// Reference Counting
+			//-------------------
+
+			EAE6320_ASSETS_DECLAREREFERENCECOUNTINGFUNCTIONS();
+
+			// Data
+			//=====
+
+		private:
+
+#if defined( EAE6320_PLATFORM_D3D )
+			ID3D11Texture2D* m_texture = nullptr;
+			ID3D11ShaderResourceView* m_shaderResourceView = nullptr;
+			ID3D11SamplerState* m_samplerState = nullptr;
+#elif defined( EAE6320_PLATFORM_GL )
+			GLuint m_textureId = 0;
+#endif
+			uint64_t m_memorySize = 0;
+
+			static std::atomic<uint64_t> s_residentMemorySize;
+			static std::atomic<uint32_t> s_residentTextureCount;
+
+			EAE6320_ASSETS_DECLAREREFERENCECOUNT();
+
+			// Implementation
+			//===============
+
+		private:
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// i_data is tightly packed rows of i_width * i_height texels with i_componentCount 8 bit components each
+			cResult Initialize( const std::string& i_path, const uint8_t* const i_data,
+				const unsigned int i_width, const unsigned int i_height, const unsigned int i_componentCount );
+			// i_mipData is every mip that the header describes (the largest first)
+			cResult Initialize( const std::string& i_path, const TextureFormats::sHeader& i_header, const uint8_t* const i_mipData );
+			cResult CleanUp();
+
+			cTexture() = default;
+			~cTexture();
+		};
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_CTEXTURE_H
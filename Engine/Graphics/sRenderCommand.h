@@ -14,6 +14,17 @@ namespace eae6320
 
 			eae6320::Math::cMatrix_transformation m_transformation;
 
+			// Commands are drawn in pass order (see cRenderQueue.h)
+			uint8_t m_renderPass = 0;
+
+			// Commands that use the same mesh are coalesced into a single instanced draw call
+			// unless this is cleared
+			bool m_isInstancingAllowed = true;
+
+			// The level of detail that the mesh is drawn at
+			// (the renderer chooses it every frame from how big the mesh is on screen)
+			uint8_t m_lod = 0;
+
 			cResult CleanUp();
 
 			cResult SetRenderCommand( class cMesh* i_mesh, class cEffect* i_effect = nullptr );
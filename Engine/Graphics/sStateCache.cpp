@@ -0,0 +1,78 @@
+// Includes
+//=========
+
+#include "sStateCache.h"
+
+#include "cRenderState.h"
+
+#include <Engine/Asserts/Asserts.h>
+
+// Static Data
+//============
+
+eae6320::Graphics::sStateCache eae6320::Graphics::sStateCache::g_stateCache;
+
+// Interface
+//==========
+
+// Render
+//-------
+
+void eae6320::Graphics::sStateCache::BindRenderState( const cRenderState& i_renderState )
+{
+	const auto renderStateBits = i_renderState.GetRenderStateBits();
+	if ( !CountBind( renderStateBits == m_renderStateBits ) )
+	{
+		i_renderState.Bind();
+		m_renderStateBits = renderStateBits;
+	}
+}
+
+void eae6320::Graphics::sStateCache::Invalidate()
+{
+	m_renderStateBits = cRenderState::g_invalidRenderStateBits;
+	Invalidate_platformSpecific();
+}
+
+// Statistics
+//-----------
+
+void eae6320::Graphics::sStateCache::BeginFrame()
+{
+	m_statistics_previousFrame = m_statistics;
+	m_bindCount_issued_total += m_statistics.bindCount_issued;
+	m_bindCount_skipped_total += m_statistics.bindCount_skipped;
+	m_statistics = sStatistics();
+
+	Invalidate();
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::Graphics::sStateCache::~sStateCache()
+{
+	const auto result = CleanUp();
+	EAE6320_ASSERT( result );
+}
+
+// Implementation
+//===============
+
+bool eae6320::Graphics::sStateCache::CountBind( const bool i_isAlreadyBound )
+{
+	if ( i_isAlreadyBound )
+	{
+		++m_statistics.bindCount_skipped;
+	}
+	else
+	{
+		++m_statistics.bindCount_issued;
+	}
+	return i_isAlreadyBound;
+}
+
+eae6320::Graphics::sStateCache::sStateCache()
+{
+	Invalidate();
+}
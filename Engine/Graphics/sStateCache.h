@@ -0,0 +1,194 @@
+/*
+	The state cache remembers which objects are currently bound to the GPU
+	so that binding an object that is already bound can be skipped
+
+	Everything that is bound while rendering should go through it.
+	Code that changes bindings without it (e.g. while loading assets)
+	must be followed by Invalidate() so that the cache doesn't get out of date.
+*/
+
+#ifndef EAE6320_GRAPHICS_SSTATECACHE_H
+#define EAE6320_GRAPHICS_SSTATECACHE_H
+
+// Includes
+//=========
+
+#include "Configuration.h"
+
+#include <cstdint>
+#include <Engine/Results/Results.h>
+
+#ifdef EAE6320_PLATFORM_GL
+	#include "OpenGL/Includes.h"
+#endif
+
+// Forward Declarations
+//=====================
+
+#ifdef EAE6320_PLATFORM_D3D
+	struct ID3D11Buffer;
+	struct ID3D11DeviceContext1;
+	struct ID3D11InputLayout;
+	struct ID3D11PixelShader;
+	struct ID3D11SamplerState;
+	struct ID3D11ShaderResourceView;
+	struct ID3D11VertexShader;
+#endif
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class cRenderState;
+	}
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		struct sStateCache
+		{
+			// Statistics
+			//===========
+
+			struct sStatistics
+			{
+				// Binds that were actually sent to the platform-specific graphics API
+				uint32_t bindCount_issued = 0;
+				// Binds that were dropped because the object was already bound
+				uint32_t bindCount_skipped = 0;
+			};
+
+			// Interface
+			//==========
+
+			// Render
+			//-------
+
+			void BindRenderState( const cRenderState& i_renderState );
+#if defined( EAE6320_PLATFORM_D3D )
+			void BindVertexShader( ID3D11VertexShader* const i_vertexShader );
+			void BindFragmentShader( ID3D11PixelShader* const i_fragmentShader );
+			void BindInputLayout( ID3D11InputLayout* const i_inputLayout );
+			void BindVertexBuffer( const unsigned int i_slot, ID3D11Buffer* const i_buffer, const unsigned int i_stride );
+			void BindIndexBuffer( ID3D11Buffer* const i_buffer, const bool i_are32BitIndices );
+			void BindShaderResource( const unsigned int i_unit, ID3D11ShaderResourceView* const i_shaderResourceView );
+			void BindSampler( const unsigned int i_unit, ID3D11SamplerState* const i_samplerState );
+			// i_shaderTypesToBindTo is a concatenation of Graphics::ShaderTypes.
+			// If i_constantCount is zero the whole buffer is bound,
+			// otherwise the range is measured in 16 byte constants (and requires Direct3D 11.1)
+			void BindConstantBuffer( const uint_fast8_t i_shaderTypesToBindTo, const unsigned int i_slot, ID3D11Buffer* const i_buffer,
+				const unsigned int i_firstConstant = 0, const unsigned int i_constantCount = 0 );
+#elif defined( EAE6320_PLATFORM_GL )
+			void BindProgram( const GLuint i_programId );
+			void BindVertexArray( const GLuint i_vertexArrayId );
+			void BindTexture( const GLuint i_unit, const GLuint i_textureId );
+			void BindSampler( const GLuint i_unit, const GLuint i_samplerId );
+			// If i_size is zero the whole buffer is bound
+			void BindConstantBuffer( const GLuint i_slot, const GLuint i_bufferId, const GLintptr i_offset = 0, const GLsizeiptr i_size = 0 );
+#endif
+
+			// Forgets what is bound
+			// (the next bind of every kind will be issued)
+			void Invalidate();
+
+			// Statistics
+			//-----------
+
+			// Starts counting the binds of a new frame
+			// (the cache is also invalidated because assets may have been loaded between frames)
+			void BeginFrame();
+			const sStatistics& GetStatistics_previousFrame() const { return m_statistics_previousFrame; }
+			uint64_t GetBindCount_issued_total() const { return m_bindCount_issued_total; }
+			uint64_t GetBindCount_skipped_total() const { return m_bindCount_skipped_total; }
+
+			// Access
+			//-------
+
+			static sStateCache g_stateCache;
+
+#if defined( EAE6320_PLATFORM_D3D )
+			// Binding a range of a constant buffer requires Direct3D 11.1
+			bool CanBindConstantBufferRanges() const;
+#endif
+
+			// Initialize / Clean Up
+			//----------------------
+
+			cResult Initialize();
+			cResult CleanUp();
+
+			~sStateCache();
+
+			// Data
+			//=====
+
+		private:
+
+			static constexpr unsigned int s_textureUnitCount = 16;
+			static constexpr unsigned int s_constantBufferSlotCount = 8;
+
+			uint8_t m_renderStateBits;
+#if defined( EAE6320_PLATFORM_D3D )
+			// Binding a range of a constant buffer requires the Direct3D 11.1 interface
+			ID3D11DeviceContext1* m_direct3dImmediateContext1 = nullptr;
+
+			struct sConstantBufferRange
+			{
+				ID3D11Buffer* buffer;
+				unsigned int firstConstant;
+				unsigned int constantCount;
+			};
+
+			ID3D11VertexShader* m_vertexShader;
+			ID3D11PixelShader* m_fragmentShader;
+			ID3D11InputLayout* m_inputLayout;
+			ID3D11Buffer* m_vertexBuffers[2];
+			unsigned int m_vertexBufferStrides[2];
+			ID3D11Buffer* m_indexBuffer;
+			bool m_are32BitIndices;
+			ID3D11ShaderResourceView* m_shaderResourceViews[s_textureUnitCount];
+			ID3D11SamplerState* m_samplerStates[s_textureUnitCount];
+			sConstantBufferRange m_constantBuffers_vertex[s_constantBufferSlotCount];
+			sConstantBufferRange m_constantBuffers_fragment[s_constantBufferSlotCount];
+#elif defined( EAE6320_PLATFORM_GL )
+			struct sConstantBufferRange
+			{
+				GLuint bufferId;
+				GLintptr offset;
+				GLsizeiptr size;
+			};
+
+			GLuint m_programId;
+			GLuint m_vertexArrayId;
+			GLuint m_activeTextureUnit;
+			GLuint m_textureIds[s_textureUnitCount];
+			GLuint m_samplerIds[s_textureUnitCount];
+			sConstantBufferRange m_constantBuffers[s_constantBufferSlotCount];
+#endif
+
+			sStatistics m_statistics;
+			sStatistics m_statistics_previousFrame;
+			uint64_t m_bindCount_issued_total = 0;
+			uint64_t m_bindCount_skipped_total = 0;
+
+			// Implementation
+			//===============
+
+		private:
+
+			// Records whether a bind was issued or skipped
+			// (returns i_isAlreadyBound so that it can be used as the condition for skipping the bind)
+			bool CountBind( const bool i_isAlreadyBound );
+			void Invalidate_platformSpecific();
+
+			sStateCache();
+		};
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_SSTATECACHE_H
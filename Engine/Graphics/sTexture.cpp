@@ -0,0 +1,39 @@
+// Includes
+//=========
+
+#include "sTexture.h"
+#include "cTexture.h"
+
+#include <Engine/Asserts/Asserts.h>
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Graphics::sTexture::Load( const std::string& i_path )
+{
+	EAE6320_ASSERT( !m_handle && !m_texture );
+
+	auto result = Results::Success;
+
+	if ( !( result = cTexture::s_manager.Load( cTexture::NormalizePath( i_path ), m_handle ) ) )
+	{
+		return result;
+	}
+	m_texture = cTexture::s_manager.Get( m_handle );
+	EAE6320_ASSERT( m_texture );
+
+	return result;
+}
+
+eae6320::cResult eae6320::Graphics::sTexture::CleanUp()
+{
+	auto result = Results::Success;
+
+	m_texture = nullptr;
+	if ( m_handle )
+	{
+		result = cTexture::s_manager.Release( m_handle );
+	}
+
+	return result;
+}
@@ -5,19 +5,26 @@
 //=========
 
 #include <cstdint>
+#include <Engine/Assets/cHandle.h>
 #include <Engine/Results/Results.h>
+#include <string>
 
-#ifdef EAE6320_PLATFORM_D3D
-struct ID3D11Texture2D;
-struct ID3D11ShaderResourceView;
-struct ID3D11SamplerState;
-#endif
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class cTexture;
+	}
+}
 
 namespace eae6320
 {
 	namespace Graphics
 	{
-		enum eTextureType : uint8_t 
+		enum eTextureType : uint8_t
 		{
 			BaseColorTexture = 1 << 0,
 
@@ -30,20 +37,26 @@ namespace eae6320
 			TransparencyTexture = 1 << 4,
 		};
 
-		struct sTexture 
+		// A material's reference to one of its (shared) textures
+		struct sTexture
 		{
-#if defined( EAE6320_PLATFORM_D3D )
-			ID3D11Texture2D* m_texture = nullptr;
-			ID3D11ShaderResourceView* m_shaderResourceView = nullptr;
-			ID3D11SamplerState* m_samplerState = nullptr;
-#elif defined( EAE6320_PLATFORM_GL )
-			unsigned int m_textureID = 0;
+			Assets::cHandle<cTexture> m_handle;
+			// The texture is looked up once when it is loaded
+			// (the pointer stays valid for as long as the handle is held)
+			cTexture* m_texture = nullptr;
+#if defined( EAE6320_PLATFORM_GL )
+			// The unit that the material's effect samples this texture from
+			// (or -1 if the effect doesn't sample it)
+			int m_textureUnit = -1;
 #endif
 			eTextureType m_textureType;
 
+			// Loads the texture at the path
+			// or shares it if it has already been loaded
+			cResult Load( const std::string& i_path );
 			cResult CleanUp();
 		};
 	}
 }
 
-#endif // EAE6320_GRAPHICS_STEXTURE_H
\ No newline at end of file
+#endif // EAE6320_GRAPHICS_STEXTURE_H
@@ -34,6 +34,12 @@ const eae6320::Math::sVector& eae6320::Math::cMatrix_transformation::GetTranslat
 	return *reinterpret_cast<const sVector*>( &m_03 );
 }
 
+float eae6320::Math::cMatrix_transformation::GetElement( const unsigned int i_row, const unsigned int i_column ) const
+{
+	// Storage is column-major
+	return ( &m_00 )[( i_column * 4 ) + i_row];
+}
+
 // Camera
 //-------
 
@@ -44,14 +50,16 @@ eae6320::Math::cMatrix_transformation eae6320::Math::cMatrix_transformation::Cre
 {
 	const auto yScale = 1.0f / std::tan( i_verticalFieldOfView_inRadians * 0.5f );
 	const auto xScale = yScale / i_aspectRatio;
-#if defined( EAE6320_PLATFORM_D3D )
+#if !defined( EAE6320_PLATFORM_GL )
+	// Direct3D's projected depth goes from 0 to 1,
+	// and builds without a graphics API (e.g. headless tests) use the same range
 	const auto zDistanceScale = i_z_farPlane / ( i_z_nearPlane - i_z_farPlane );
 	return cMatrix_transformation(
 		xScale, 0.0f, 0.0f, 0.0f,
 		0.0f, yScale, 0.0f, 0.0f,
 		0.0f, 0.0f, zDistanceScale, -1.0f,
 		0.0f, 0.0f, i_z_nearPlane * zDistanceScale, 0.0f );
-#elif defined( EAE6320_PLATFORM_GL )
+#else
 	const auto zDistanceScale = 1.0f / ( i_z_nearPlane - i_z_farPlane );
 	return cMatrix_transformation(
 		xScale, 0.0f, 0.0f, 0.0f,
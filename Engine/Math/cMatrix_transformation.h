@@ -66,12 +66,16 @@ namespace eae6320
 			const sVector& GetUpDirection() const;
 			const sVector& GetBackDirection() const;
 			const sVector& GetTranslation() const;
+			// Any element of the 4x4 matrix
+			// (e.g. to extract the planes of a view frustum from a projection)
+			float GetElement( const unsigned int i_row, const unsigned int i_column ) const;
 
 			// Camera
 			//-------
 
 			// A world-to-camera transform (for rendering) can be created by specifying the relative camera data
-			static constexpr cMatrix_transformation CreateWorldToCameraTransform(
+			// (this one isn't constexpr because creating a matrix from a quaternion isn't)
+			static cMatrix_transformation CreateWorldToCameraTransform(
 				const cQuaternion& i_cameraOrientation, const sVector& i_cameraPosition );
 			// If a camera's local-to-world transform has already been created then it can be specified instead to save calculations
 			static constexpr cMatrix_transformation CreateWorldToCameraTransform( const cMatrix_transformation& transform_localCameraToWorld );
@@ -78,7 +78,7 @@ constexpr eae6320::Math::cMatrix_transformation eae6320::Math::cMatrix_transform
 // Camera
 //-------
 
-constexpr eae6320::Math::cMatrix_transformation eae6320::Math::cMatrix_transformation::CreateWorldToCameraTransform(
+inline eae6320::Math::cMatrix_transformation eae6320::Math::cMatrix_transformation::CreateWorldToCameraTransform(
 	const cQuaternion& i_cameraOrientation, const sVector& i_cameraPosition )
 {
 	return CreateWorldToCameraTransform( cMatrix_transformation( i_cameraOrientation, i_cameraPosition ) );
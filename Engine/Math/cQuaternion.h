@@ -14,6 +14,10 @@ namespace eae6320
 	{
 		struct sVector;
 	}
+	namespace Physics
+	{
+		class cRigidBodyBatch;
+	}
 }
 
 // Class Declaration
@@ -91,6 +95,8 @@ namespace eae6320
 			//========
 
 			friend class cMatrix_transformation;
+			// A batch stores the components of many orientations in separate arrays
+			friend class Physics::cRigidBodyBatch;
 		};
 
 		// Friends
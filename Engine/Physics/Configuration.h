@@ -0,0 +1,13 @@
+/*
+	This file provides configurable settings
+	that can be used to modify the physics project
+*/
+
+#ifndef EAE6320_PHYSICS_CONFIGURATION_H
+#define EAE6320_PHYSICS_CONFIGURATION_H
+
+// The rigid body batch benchmark integrates a large number of bodies at initialization
+// and writes the cost of each path (compared to sRigidBodyState::Update()) to the log
+//#define EAE6320_PHYSICS_ISBATCHBENCHMARKENABLED
+
+#endif	// EAE6320_PHYSICS_CONFIGURATION_H
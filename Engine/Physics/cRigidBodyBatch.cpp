@@ -0,0 +1,558 @@
+// Includes
+//=========
+
+#include "cRigidBodyBatch.h"
+
+#include "sRigidBodyState.h"
+
+#include <cmath>
+#include <Engine/Asserts/Asserts.h>
+
+#if defined( __AVX__ )
+	#define EAE6320_PHYSICS_ISBATCHVECTORIZED
+	#define EAE6320_PHYSICS_ISBATCHVECTORIZED_AVX
+	#include <immintrin.h>
+#elif defined( _M_IX86 ) || defined( _M_X64 ) || defined( __SSE2__ )
+	#define EAE6320_PHYSICS_ISBATCHVECTORIZED
+	#define EAE6320_PHYSICS_ISBATCHVECTORIZED_SSE
+	#include <emmintrin.h>
+#elif defined( _M_ARM64 ) || defined( __aarch64__ )
+	// 32-bit ARM NEON always flushes denormals to zero (unlike its scalar instructions),
+	// and so only 64-bit ARM is vectorized
+	#define EAE6320_PHYSICS_ISBATCHVECTORIZED
+	#define EAE6320_PHYSICS_ISBATCHVECTORIZED_NEON
+	#include <arm_neon.h>
+#endif
+
+#ifdef EAE6320_PHYSICS_ISBATCHBENCHMARKENABLED
+	#include <algorithm>
+	#include <cstring>
+	#include <Engine/Logging/Logging.h>
+	#include <Engine/Math/sVector.h>
+	#include <Engine/Time/Time.h>
+#endif
+
+// The scalar path can only match the vectorized path if the compiler doesn't fuse multiplies and adds
+// (GCC must be given -ffp-contract=off instead)
+#if defined( _MSC_VER ) && !defined( __clang__ )
+	#pragma fp_contract( off )
+#elif defined( __clang__ )
+	#pragma STDC FP_CONTRACT OFF
+#endif
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// Pointers to the start of every array
+	struct sArrays
+	{
+		float* position[3];
+		float* velocity[3];
+		const float* acceleration[3];
+		float* orientation[4];	// w, x, y, z
+		const float* angularVelocityAxis[3];
+		const float* angularSpeed;
+	};
+
+	// Each lane type provides the same operations for a different register width,
+	// and the kernel is written once in terms of them.
+	// Every operation is a single correctly rounded IEEE operation,
+	// and so every lane type produces the same bits as sLanes_scalar
+	struct sLanes_scalar
+	{
+		using tFloat = float;
+		using tInt = int32_t;
+		using tMask = bool;
+		static constexpr uint32_t width = 1;
+
+		static tFloat Load( const float* const i_source ) { return *i_source; }
+		static void Store( float* const o_destination, const tFloat i_value ) { *o_destination = i_value; }
+		static tFloat Set( const float i_value ) { return i_value; }
+
+		static tFloat Add( const tFloat i_lhs, const tFloat i_rhs ) { return i_lhs + i_rhs; }
+		static tFloat Subtract( const tFloat i_lhs, const tFloat i_rhs ) { return i_lhs - i_rhs; }
+		static tFloat Multiply( const tFloat i_lhs, const tFloat i_rhs ) { return i_lhs * i_rhs; }
+		static tFloat Divide( const tFloat i_lhs, const tFloat i_rhs ) { return i_lhs / i_rhs; }
+		static tFloat SquareRoot( const tFloat i_value ) { return std::sqrt( i_value ); }
+		static tFloat ReciprocalSquareRoot_approximate( const tFloat i_value ) { return 1.0f / std::sqrt( i_value ); }
+
+		// The value must already be a whole number
+		static tInt ConvertToInt( const tFloat i_value ) { return static_cast<tInt>( i_value ); }
+		static tMask IsBitSet( const tInt i_value, const int32_t i_bit ) { return ( i_value & i_bit ) != 0; }
+		static tFloat Select( const tMask i_mask, const tFloat i_ifTrue, const tFloat i_ifFalse ) { return i_mask ? i_ifTrue : i_ifFalse; }
+		static tFloat NegateIf( const tMask i_mask, const tFloat i_value ) { return i_mask ? -i_value : i_value; }
+	};
+
+#if defined( EAE6320_PHYSICS_ISBATCHVECTORIZED_AVX )
+	// AVX (without AVX2) doesn't have 256-bit integer instructions,
+	// and so bits are tested by converting the masked integers back to floats
+	struct sLanes_vector
+	{
+		using tFloat = __m256;
+		using tInt = __m256i;
+		using tMask = __m256;
+		static constexpr uint32_t width = 8;
+
+		static tFloat Load( const float* const i_source ) { return _mm256_loadu_ps( i_source ); }
+		static void Store( float* const o_destination, const tFloat i_value ) { _mm256_storeu_ps( o_destination, i_value ); }
+		static tFloat Set( const float i_value ) { return _mm256_set1_ps( i_value ); }
+
+		static tFloat Add( const tFloat i_lhs, const tFloat i_rhs ) { return _mm256_add_ps( i_lhs, i_rhs ); }
+		static tFloat Subtract( const tFloat i_lhs, const tFloat i_rhs ) { return _mm256_sub_ps( i_lhs, i_rhs ); }
+		static tFloat Multiply( const tFloat i_lhs, const tFloat i_rhs ) { return _mm256_mul_ps( i_lhs, i_rhs ); }
+		static tFloat Divide( const tFloat i_lhs, const tFloat i_rhs ) { return _mm256_div_ps( i_lhs, i_rhs ); }
+		static tFloat SquareRoot( const tFloat i_value ) { return _mm256_sqrt_ps( i_value ); }
+		static tFloat ReciprocalSquareRoot_approximate( const tFloat i_value )
+		{
+			// One Newton-Raphson step refines the 12-bit estimate to almost full precision
+			const auto estimate = _mm256_rsqrt_ps( i_value );
+			const auto halfValue = _mm256_mul_ps( i_value, _mm256_set1_ps( 0.5f ) );
+			return _mm256_mul_ps( estimate,
+				_mm256_sub_ps( _mm256_set1_ps( 1.5f ), _mm256_mul_ps( halfValue, _mm256_mul_ps( estimate, estimate ) ) ) );
+		}
+
+		static tInt ConvertToInt( const tFloat i_value ) { return _mm256_cvttps_epi32( i_value ); }
+		static tMask IsBitSet( const tInt i_value, const int32_t i_bit )
+		{
+			const auto bits = _mm256_and_ps( _mm256_castsi256_ps( i_value ), _mm256_castsi256_ps( _mm256_set1_epi32( i_bit ) ) );
+			return _mm256_cmp_ps( _mm256_cvtepi32_ps( _mm256_castps_si256( bits ) ), _mm256_setzero_ps(), _CMP_NEQ_OQ );
+		}
+		static tFloat Select( const tMask i_mask, const tFloat i_ifTrue, const tFloat i_ifFalse ) { return _mm256_blendv_ps( i_ifFalse, i_ifTrue, i_mask ); }
+		static tFloat NegateIf( const tMask i_mask, const tFloat i_value ) { return _mm256_xor_ps( i_value, _mm256_and_ps( i_mask, _mm256_set1_ps( -0.0f ) ) ); }
+	};
+#elif defined( EAE6320_PHYSICS_ISBATCHVECTORIZED_SSE )
+	struct sLanes_vector
+	{
+		using tFloat = __m128;
+		using tInt = __m128i;
+		using tMask = __m128;
+		static constexpr uint32_t width = 4;
+
+		static tFloat Load( const float* const i_source ) { return _mm_loadu_ps( i_source ); }
+		static void Store( float* const o_destination, const tFloat i_value ) { _mm_storeu_ps( o_destination, i_value ); }
+		static tFloat Set( const float i_value ) { return _mm_set1_ps( i_value ); }
+
+		static tFloat Add( const tFloat i_lhs, const tFloat i_rhs ) { return _mm_add_ps( i_lhs, i_rhs ); }
+		static tFloat Subtract( const tFloat i_lhs, const tFloat i_rhs ) { return _mm_sub_ps( i_lhs, i_rhs ); }
+		static tFloat Multiply( const tFloat i_lhs, const tFloat i_rhs ) { return _mm_mul_ps( i_lhs, i_rhs ); }
+		static tFloat Divide( const tFloat i_lhs, const tFloat i_rhs ) { return _mm_div_ps( i_lhs, i_rhs ); }
+		static tFloat SquareRoot( const tFloat i_value ) { return _mm_sqrt_ps( i_value ); }
+		static tFloat ReciprocalSquareRoot_approximate( const tFloat i_value )
+		{
+			// One Newton-Raphson step refines the 12-bit estimate to almost full precision
+			const auto estimate = _mm_rsqrt_ps( i_value );
+			const auto halfValue = _mm_mul_ps( i_value, _mm_set1_ps( 0.5f ) );
+			return _mm_mul_ps( estimate, _mm_sub_ps( _mm_set1_ps( 1.5f ), _mm_mul_ps( halfValue, _mm_mul_ps( estimate, estimate ) ) ) );
+		}
+
+		static tInt ConvertToInt( const tFloat i_value ) { return _mm_cvttps_epi32( i_value ); }
+		static tMask IsBitSet( const tInt i_value, const int32_t i_bit )
+		{
+			const auto bit = _mm_set1_epi32( i_bit );
+			return _mm_castsi128_ps( _mm_cmpeq_epi32( _mm_and_si128( i_value, bit ), bit ) );
+		}
+		static tFloat Select( const tMask i_mask, const tFloat i_ifTrue, const tFloat i_ifFalse )
+		{
+			return _mm_or_ps( _mm_and_ps( i_mask, i_ifTrue ), _mm_andnot_ps( i_mask, i_ifFalse ) );
+		}
+		static tFloat NegateIf( const tMask i_mask, const tFloat i_value ) { return _mm_xor_ps( i_value, _mm_and_ps( i_mask, _mm_set1_ps( -0.0f ) ) ); }
+	};
+#elif defined( EAE6320_PHYSICS_ISBATCHVECTORIZED_NEON )
+	struct sLanes_vector
+	{
+		using tFloat = float32x4_t;
+		using tInt = int32x4_t;
+		using tMask = uint32x4_t;
+		static constexpr uint32_t width = 4;
+
+		static tFloat Load( const float* const i_source ) { return vld1q_f32( i_source ); }
+		static void Store( float* const o_destination, const tFloat i_value ) { vst1q_f32( o_destination, i_value ); }
+		static tFloat Set( const float i_value ) { return vdupq_n_f32( i_value ); }
+
+		static tFloat Add( const tFloat i_lhs, const tFloat i_rhs ) { return vaddq_f32( i_lhs, i_rhs ); }
+		static tFloat Subtract( const tFloat i_lhs, const tFloat i_rhs ) { return vsubq_f32( i_lhs, i_rhs ); }
+		static tFloat Multiply( const tFloat i_lhs, const tFloat i_rhs ) { return vmulq_f32( i_lhs, i_rhs ); }
+		static tFloat Divide( const tFloat i_lhs, const tFloat i_rhs ) { return vdivq_f32( i_lhs, i_rhs ); }
+		static tFloat SquareRoot( const tFloat i_value ) { return vsqrtq_f32( i_value ); }
+		static tFloat ReciprocalSquareRoot_approximate( const tFloat i_value )
+		{
+			// The 8-bit estimate needs two Newton-Raphson steps
+			auto estimate = vrsqrteq_f32( i_value );
+			estimate = vmulq_f32( estimate, vrsqrtsq_f32( vmulq_f32( i_value, estimate ), estimate ) );
+			return vmulq_f32( estimate, vrsqrtsq_f32( vmulq_f32( i_value, estimate ), estimate ) );
+		}
+
+		static tInt ConvertToInt( const tFloat i_value ) { return vcvtq_s32_f32( i_value ); }
+		static tMask IsBitSet( const tInt i_value, const int32_t i_bit ) { return vtstq_s32( i_value, vdupq_n_s32( i_bit ) ); }
+		static tFloat Select( const tMask i_mask, const tFloat i_ifTrue, const tFloat i_ifFalse ) { return vbslq_f32( i_mask, i_ifTrue, i_ifFalse ); }
+		static tFloat NegateIf( const tMask i_mask, const tFloat i_value )
+		{
+			return vreinterpretq_f32_u32( veorq_u32( vreinterpretq_u32_f32( i_value ), vandq_u32( i_mask, vdupq_n_u32( 0x80000000u ) ) ) );
+		}
+	};
+#endif
+
+	// Calculates the sine and cosine of angles whose magnitude is less than 2^22
+	template <typename tLanes>
+		void CalculateSineAndCosine( const typename tLanes::tFloat i_angle, typename tLanes::tFloat& o_sine, typename tLanes::tFloat& o_cosine );
+
+	template <typename tLanes, bool tIsFast>
+		void Integrate( const sArrays& i_arrays, const uint32_t i_paddedCount, const float i_secondCountToIntegrate );
+}
+
+// Interface
+//==========
+
+// Bodies
+//-------
+
+uint32_t eae6320::Physics::cRigidBodyBatch::Add( const sRigidBodyState& i_state )
+{
+	const auto index = m_count;
+	if ( index >= m_position_x.size() )
+	{
+		Resize( static_cast<uint32_t>( m_position_x.size() ) + s_laneCount );
+	}
+	++m_count;
+	Set( index, i_state );
+	return index;
+}
+
+void eae6320::Physics::cRigidBodyBatch::Set( const uint32_t i_index, const sRigidBodyState& i_state )
+{
+	EAE6320_ASSERT( i_index < m_count );
+	m_position_x[i_index] = i_state.position.x;
+	m_position_y[i_index] = i_state.position.y;
+	m_position_z[i_index] = i_state.position.z;
+	m_velocity_x[i_index] = i_state.velocity.x;
+	m_velocity_y[i_index] = i_state.velocity.y;
+	m_velocity_z[i_index] = i_state.velocity.z;
+	m_acceleration_x[i_index] = i_state.acceleration.x;
+	m_acceleration_y[i_index] = i_state.acceleration.y;
+	m_acceleration_z[i_index] = i_state.acceleration.z;
+	m_orientation_w[i_index] = i_state.orientation.m_w;
+	m_orientation_x[i_index] = i_state.orientation.m_x;
+	m_orientation_y[i_index] = i_state.orientation.m_y;
+	m_orientation_z[i_index] = i_state.orientation.m_z;
+	m_angularVelocityAxis_x[i_index] = i_state.angularVelocity_axis_local.x;
+	m_angularVelocityAxis_y[i_index] = i_state.angularVelocity_axis_local.y;
+	m_angularVelocityAxis_z[i_index] = i_state.angularVelocity_axis_local.z;
+	m_angularSpeed[i_index] = i_state.angularSpeed;
+}
+
+eae6320::Physics::sRigidBodyState eae6320::Physics::cRigidBodyBatch::Get( const uint32_t i_index ) const
+{
+	EAE6320_ASSERT( i_index < m_count );
+	sRigidBodyState state;
+	state.position = Math::sVector( m_position_x[i_index], m_position_y[i_index], m_position_z[i_index] );
+	state.velocity = Math::sVector( m_velocity_x[i_index], m_velocity_y[i_index], m_velocity_z[i_index] );
+	state.acceleration = Math::sVector( m_acceleration_x[i_index], m_acceleration_y[i_index], m_acceleration_z[i_index] );
+	state.orientation.m_w = m_orientation_w[i_index];
+	state.orientation.m_x = m_orientation_x[i_index];
+	state.orientation.m_y = m_orientation_y[i_index];
+	state.orientation.m_z = m_orientation_z[i_index];
+	state.angularVelocity_axis_local = Math::sVector( m_angularVelocityAxis_x[i_index], m_angularVelocityAxis_y[i_index], m_angularVelocityAxis_z[i_index] );
+	state.angularSpeed = m_angularSpeed[i_index];
+	return state;
+}
+
+void eae6320::Physics::cRigidBodyBatch::Clear()
+{
+	m_count = 0;
+	Resize( 0 );
+}
+
+// Simulation
+//-----------
+
+void eae6320::Physics::cRigidBodyBatch::Update( const float i_secondCountToIntegrate )
+{
+	const auto paddedCount = static_cast<uint32_t>( m_position_x.size() );
+	if ( paddedCount == 0 )
+	{
+		return;
+	}
+	const sArrays arrays
+	{
+		{ m_position_x.data(), m_position_y.data(), m_position_z.data() },
+		{ m_velocity_x.data(), m_velocity_y.data(), m_velocity_z.data() },
+		{ m_acceleration_x.data(), m_acceleration_y.data(), m_acceleration_z.data() },
+		{ m_orientation_w.data(), m_orientation_x.data(), m_orientation_y.data(), m_orientation_z.data() },
+		{ m_angularVelocityAxis_x.data(), m_angularVelocityAxis_y.data(), m_angularVelocityAxis_z.data() },
+		m_angularSpeed.data()
+	};
+	const auto isFast = m_mode == eMode::Fast;
+#ifdef EAE6320_PHYSICS_ISBATCHVECTORIZED
+	if ( m_isVectorized )
+	{
+		if ( isFast )
+		{
+			Integrate<sLanes_vector, true>( arrays, paddedCount, i_secondCountToIntegrate );
+		}
+		else
+		{
+			Integrate<sLanes_vector, false>( arrays, paddedCount, i_secondCountToIntegrate );
+		}
+		return;
+	}
+#endif
+	if ( isFast )
+	{
+		Integrate<sLanes_scalar, true>( arrays, paddedCount, i_secondCountToIntegrate );
+	}
+	else
+	{
+		Integrate<sLanes_scalar, false>( arrays, paddedCount, i_secondCountToIntegrate );
+	}
+}
+
+// Implementation
+//===============
+
+void eae6320::Physics::cRigidBodyBatch::Resize( const uint32_t i_paddedCount )
+{
+	EAE6320_ASSERT( ( i_paddedCount % s_laneCount ) == 0 );
+	// New padding is a body at rest with an identity orientation
+	for ( auto* const array : { &m_position_x, &m_position_y, &m_position_z, &m_velocity_x, &m_velocity_y, &m_velocity_z,
+		&m_acceleration_x, &m_acceleration_y, &m_acceleration_z, &m_orientation_x, &m_orientation_y, &m_orientation_z,
+		&m_angularVelocityAxis_x, &m_angularVelocityAxis_z, &m_angularSpeed } )
+	{
+		array->resize( i_paddedCount, 0.0f );
+	}
+	m_orientation_w.resize( i_paddedCount, 1.0f );
+	m_angularVelocityAxis_y.resize( i_paddedCount, 1.0f );
+}
+
+#ifdef EAE6320_PHYSICS_ISBATCHBENCHMARKENABLED
+
+void eae6320::Physics::cRigidBodyBatch::RunBenchmark()
+{
+	constexpr uint32_t bodyCount = 100000;
+	constexpr unsigned int updateCount = 60;
+	constexpr float secondsPerUpdate = 1.0f / 15.0f;
+
+	// A fixed LCG makes the results comparable between runs
+	uint32_t randomState = 6320;
+	const auto GetRandom = [&randomState]( const float i_minimum, const float i_maximum )
+	{
+		randomState = ( randomState * 1664525u ) + 1013904223u;
+		return i_minimum + ( ( i_maximum - i_minimum ) * ( static_cast<float>( randomState >> 8 ) / static_cast<float>( 1 << 24 ) ) );
+	};
+	const auto GetRandomVector = [&GetRandom]( const float i_extent )
+	{
+		return Math::sVector( GetRandom( -i_extent, i_extent ), GetRandom( -i_extent, i_extent ), GetRandom( -i_extent, i_extent ) );
+	};
+	const auto GetRandomDirection = [&GetRandomVector]()
+	{
+		auto direction = GetRandomVector( 1.0f );
+		while ( Dot( direction, direction ) < 1.0e-4f )
+		{
+			direction = GetRandomVector( 1.0f );
+		}
+		return direction.GetNormalized();
+	};
+	const auto GetMilliseconds = []( const uint64_t i_tickCount )
+	{
+		return Time::ConvertTicksToSeconds( i_tickCount ) * 1000.0;
+	};
+
+	std::vector<sRigidBodyState> states( bodyCount );
+	for ( auto& state : states )
+	{
+		state.position = GetRandomVector( 500.0f );
+		state.velocity = GetRandomVector( 5.0f );
+		state.acceleration = GetRandomVector( 1.0f );
+		state.orientation = Math::cQuaternion( GetRandom( -3.0f, 3.0f ), GetRandomDirection() );
+		state.angularVelocity_axis_local = GetRandomDirection();
+		state.angularSpeed = GetRandom( -3.0f, 3.0f );
+	}
+	cRigidBodyBatch batches[3];
+	batches[0].m_isVectorized = false;
+	batches[2].SetMode( eMode::Fast );
+	for ( auto& batch : batches )
+	{
+		for ( const auto& state : states )
+		{
+			batch.Add( state );
+		}
+	}
+
+	Logging::OutputMessage( "Rigid body batch benchmark (%u bodies, %u updates):", bodyCount, updateCount );
+	{
+		const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+		for ( unsigned int i = 0; i < updateCount; ++i )
+		{
+			for ( auto& state : states )
+			{
+				state.Update( secondsPerUpdate );
+			}
+		}
+		Logging::OutputMessage( "\tsRigidBodyState::Update(): %.3f ms per update",
+			GetMilliseconds( Time::GetCurrentSystemTimeTickCount() - tickCount_start ) / updateCount );
+	}
+	const char* const pathNames[] =
+	{
+		"Scalar (deterministic)",
+#if defined( EAE6320_PHYSICS_ISBATCHVECTORIZED_AVX )
+		"AVX (deterministic)", "AVX (fast)",
+#elif defined( EAE6320_PHYSICS_ISBATCHVECTORIZED_SSE )
+		"SSE2 (deterministic)", "SSE2 (fast)",
+#elif defined( EAE6320_PHYSICS_ISBATCHVECTORIZED_NEON )
+		"NEON (deterministic)", "NEON (fast)",
+#else
+		"Scalar (deterministic)", "Scalar (fast)",
+#endif
+	};
+	for ( size_t i = 0; i < 3; ++i )
+	{
+		const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+		for ( unsigned int j = 0; j < updateCount; ++j )
+		{
+			batches[i].Update( secondsPerUpdate );
+		}
+		const auto tickCount_end = Time::GetCurrentSystemTimeTickCount();
+		// The batch's sine and cosine are approximations,
+		// and so its orientations drift slightly from the CRT's
+		float maximumError_position = 0.0f, maximumError_orientation = 0.0f;
+		for ( uint32_t j = 0; j < bodyCount; ++j )
+		{
+			const auto state = batches[i].Get( j );
+			const auto positionError = state.position - states[j].position;
+			maximumError_position = std::max( maximumError_position, positionError.GetLength() );
+			// q and -q are the same orientation
+			const auto cosine = std::abs( Dot( state.orientation, states[j].orientation ) );
+			maximumError_orientation = std::max( maximumError_orientation, 1.0f - std::min( cosine, 1.0f ) );
+		}
+		Logging::OutputMessage( "\t%s: %.3f ms per update (maximum difference: position %g, orientation 1 - cos %g)",
+			pathNames[i], GetMilliseconds( tickCount_end - tickCount_start ) / updateCount, maximumError_position, maximumError_orientation );
+	}
+	{
+		// The deterministic paths must match exactly
+		uint32_t mismatchCount = 0;
+		const auto& scalar = batches[0];
+		const auto& vectorized = batches[1];
+		for ( uint32_t i = 0; i < bodyCount; ++i )
+		{
+			const float lhs[] = { scalar.m_position_x[i], scalar.m_position_y[i], scalar.m_position_z[i],
+				scalar.m_velocity_x[i], scalar.m_velocity_y[i], scalar.m_velocity_z[i],
+				scalar.m_orientation_w[i], scalar.m_orientation_x[i], scalar.m_orientation_y[i], scalar.m_orientation_z[i] };
+			const float rhs[] = { vectorized.m_position_x[i], vectorized.m_position_y[i], vectorized.m_position_z[i],
+				vectorized.m_velocity_x[i], vectorized.m_velocity_y[i], vectorized.m_velocity_z[i],
+				vectorized.m_orientation_w[i], vectorized.m_orientation_x[i], vectorized.m_orientation_y[i], vectorized.m_orientation_z[i] };
+			if ( memcmp( lhs, rhs, sizeof( lhs ) ) != 0 )
+			{
+				++mismatchCount;
+			}
+		}
+		if ( mismatchCount == 0 )
+		{
+			Logging::OutputMessage( "\tThe deterministic paths are bit-for-bit identical" );
+		}
+		else
+		{
+			EAE6320_ASSERTF( false, "%u bodies were integrated differently by the deterministic paths", mismatchCount );
+			Logging::OutputError( "%u bodies were integrated differently by the deterministic rigid body paths", mismatchCount );
+		}
+	}
+}
+
+#endif	// EAE6320_PHYSICS_ISBATCHBENCHMARKENABLED
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	template <typename tLanes>
+		void CalculateSineAndCosine( const typename tLanes::tFloat i_angle, typename tLanes::tFloat& o_sine, typename tLanes::tFloat& o_cosine )
+	{
+		using L = tLanes;
+
+		// The angle is reduced to [-pi/4, pi/4] by subtracting the nearest multiple of pi/2,
+		// which is split into three parts so that the subtraction is exact
+		// (Cody and Waite's range reduction, with the constants from Cephes).
+		// Adding and subtracting 1.5 * 2^23 rounds to the nearest whole number without any rounding instructions
+		const auto roundingConstant = L::Set( 12582912.0f );
+		const auto quadrant = L::Subtract( L::Add( L::Multiply( i_angle, L::Set( 0.636619772f ) ), roundingConstant ), roundingConstant );
+		auto angle_reduced = L::Subtract( i_angle, L::Multiply( quadrant, L::Set( 1.5703125f ) ) );
+		angle_reduced = L::Subtract( angle_reduced, L::Multiply( quadrant, L::Set( 4.837512969970703125e-4f ) ) );
+		angle_reduced = L::Subtract( angle_reduced, L::Multiply( quadrant, L::Set( 7.54978995489188216e-8f ) ) );
+
+		// Minimax polynomials (from Cephes' sinf() and cosf()) are accurate to about one unit in the last place in the reduced range
+		const auto angle_squared = L::Multiply( angle_reduced, angle_reduced );
+		auto sine = L::Add( L::Multiply( L::Set( -1.9515295891e-4f ), angle_squared ), L::Set( 8.3321608736e-3f ) );
+		sine = L::Add( L::Multiply( sine, angle_squared ), L::Set( -1.6666654611e-1f ) );
+		sine = L::Add( L::Multiply( sine, L::Multiply( angle_squared, angle_reduced ) ), angle_reduced );
+		auto cosine = L::Add( L::Multiply( L::Set( 2.443315711809948e-5f ), angle_squared ), L::Set( -1.388731625493765e-3f ) );
+		cosine = L::Add( L::Multiply( cosine, angle_squared ), L::Set( 4.166664568298827e-2f ) );
+		cosine = L::Add( L::Subtract( L::Set( 1.0f ), L::Multiply( angle_squared, L::Set( 0.5f ) ) ),
+			L::Multiply( cosine, L::Multiply( angle_squared, angle_squared ) ) );
+
+		// The quadrant decides which polynomial is which and what their signs are:
+		//	sin( a + ( q * pi/2 ) ) is sin( a ), cos( a ), -sin( a ), -cos( a ) for q = 0, 1, 2, 3
+		//	cos( a + ( q * pi/2 ) ) is sin( a + ( ( q + 1 ) * pi/2 ) )
+		const auto quadrant_sine = L::ConvertToInt( quadrant );
+		const auto quadrant_cosine = L::ConvertToInt( L::Add( quadrant, L::Set( 1.0f ) ) );
+		const auto isSwapped = L::IsBitSet( quadrant_sine, 1 );
+		o_sine = L::NegateIf( L::IsBitSet( quadrant_sine, 2 ), L::Select( isSwapped, cosine, sine ) );
+		o_cosine = L::NegateIf( L::IsBitSet( quadrant_cosine, 2 ), L::Select( isSwapped, sine, cosine ) );
+	}
+
+	template <typename tLanes, bool tIsFast>
+		void Integrate( const sArrays& i_arrays, const uint32_t i_paddedCount, const float i_secondCountToIntegrate )
+	{
+		using L = tLanes;
+
+		// Every operation is in the same order as in sRigidBodyState::Update()
+		// and the cQuaternion functions that it calls
+		const auto secondCount = L::Set( i_secondCountToIntegrate );
+		for ( uint32_t i = 0; i < i_paddedCount; i += L::width )
+		{
+			// Update position and velocity
+			for ( unsigned int j = 0; j < 3; ++j )
+			{
+				const auto velocity = L::Load( i_arrays.velocity[j] + i );
+				L::Store( i_arrays.position[j] + i, L::Add( L::Load( i_arrays.position[j] + i ), L::Multiply( velocity, secondCount ) ) );
+				L::Store( i_arrays.velocity[j] + i, L::Add( velocity, L::Multiply( L::Load( i_arrays.acceleration[j] + i ), secondCount ) ) );
+			}
+			// Update orientation
+			{
+				// The rotation for this step is made from its axis and angle
+				typename L::tFloat sine, cosine;
+				CalculateSineAndCosine<L>(
+					L::Multiply( L::Multiply( L::Load( i_arrays.angularSpeed + i ), secondCount ), L::Set( 0.5f ) ), sine, cosine );
+				const auto rotation_w = cosine;
+				const auto rotation_x = L::Multiply( L::Load( i_arrays.angularVelocityAxis[0] + i ), sine );
+				const auto rotation_y = L::Multiply( L::Load( i_arrays.angularVelocityAxis[1] + i ), sine );
+				const auto rotation_z = L::Multiply( L::Load( i_arrays.angularVelocityAxis[2] + i ), sine );
+
+				// orientation = orientation * rotation
+				const auto w = L::Load( i_arrays.orientation[0] + i );
+				const auto x = L::Load( i_arrays.orientation[1] + i );
+				const auto y = L::Load( i_arrays.orientation[2] + i );
+				const auto z = L::Load( i_arrays.orientation[3] + i );
+				const auto w_new = L::Subtract( L::Multiply( w, rotation_w ),
+					L::Add( L::Add( L::Multiply( x, rotation_x ), L::Multiply( y, rotation_y ) ), L::Multiply( z, rotation_z ) ) );
+				const auto x_new = L::Add( L::Add( L::Multiply( w, rotation_x ), L::Multiply( x, rotation_w ) ),
+					L::Subtract( L::Multiply( y, rotation_z ), L::Multiply( z, rotation_y ) ) );
+				const auto y_new = L::Add( L::Add( L::Multiply( w, rotation_y ), L::Multiply( y, rotation_w ) ),
+					L::Subtract( L::Multiply( z, rotation_x ), L::Multiply( x, rotation_z ) ) );
+				const auto z_new = L::Add( L::Add( L::Multiply( w, rotation_z ), L::Multiply( z, rotation_w ) ),
+					L::Subtract( L::Multiply( x, rotation_y ), L::Multiply( y, rotation_x ) ) );
+
+				// Normalize
+				const auto length_squared = L::Add( L::Add( L::Add( L::Multiply( w_new, w_new ), L::Multiply( x_new, x_new ) ),
+					L::Multiply( y_new, y_new ) ), L::Multiply( z_new, z_new ) );
+				const auto length_reciprocal = tIsFast
+					? L::ReciprocalSquareRoot_approximate( length_squared )
+					: L::Divide( L::Set( 1.0f ), L::SquareRoot( length_squared ) );
+				L::Store( i_arrays.orientation[0] + i, L::Multiply( w_new, length_reciprocal ) );
+				L::Store( i_arrays.orientation[1] + i, L::Multiply( x_new, length_reciprocal ) );
+				L::Store( i_arrays.orientation[2] + i, L::Multiply( y_new, length_reciprocal ) );
+				L::Store( i_arrays.orientation[3] + i, L::Multiply( z_new, length_reciprocal ) );
+			}
+		}
+	}
+}
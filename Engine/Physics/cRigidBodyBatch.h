@@ -0,0 +1,119 @@
+/*
+	A rigid body batch integrates many rigid bodies at once
+
+	It does the same thing as calling sRigidBodyState::Update() for each body,
+	but the bodies are stored as separate arrays of each component
+	so that several of them can be integrated at once with SIMD instructions
+	(SSE2 or AVX on x86 and NEON on ARM64, depending on what the build targets).
+	The rotation for each step is built with a polynomial approximation of sine and cosine
+	rather than the CRT's functions, which can't be vectorized.
+
+	In the deterministic mode the vectorized path does exactly the same floating point operations
+	in exactly the same order as the scalar path,
+	and so the results are bit-for-bit identical regardless of which one is used
+	(but they are not bit-for-bit identical to sRigidBodyState::Update()).
+	The fast mode normalizes orientations with an approximate reciprocal square root instead,
+	and its results depend on the instruction set.
+*/
+
+#ifndef EAE6320_PHYSICS_CRIGIDBODYBATCH_H
+#define EAE6320_PHYSICS_CRIGIDBODYBATCH_H
+
+// Includes
+//=========
+
+#include "Configuration.h"
+
+#include <cstdint>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Physics
+	{
+		struct sRigidBodyState;
+	}
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Physics
+	{
+		class cRigidBodyBatch
+		{
+			// Interface
+			//==========
+
+		public:
+
+			enum class eMode : uint8_t
+			{
+				Deterministic,
+				Fast,
+			};
+
+			// Bodies
+			//-------
+
+			// Returns the new body's index
+			uint32_t Add( const sRigidBodyState& i_state );
+			void Set( const uint32_t i_index, const sRigidBodyState& i_state );
+			sRigidBodyState Get( const uint32_t i_index ) const;
+			uint32_t GetCount() const { return m_count; }
+			void Clear();
+
+			// Simulation
+			//-----------
+
+			// Integrates every body the same way that sRigidBodyState::Update() does
+			void Update( const float i_secondCountToIntegrate );
+
+			eMode GetMode() const { return m_mode; }
+			void SetMode( const eMode i_mode ) { m_mode = i_mode; }
+
+#ifdef EAE6320_PHYSICS_ISBATCHBENCHMARKENABLED
+			// Integrates a large number of bodies with sRigidBodyState::Update() and with each of the batch's paths,
+			// checks that the deterministic paths match,
+			// and writes the timings to the log
+			static void RunBenchmark();
+#endif
+
+			// Data
+			//=====
+
+		private:
+
+			// The arrays are padded to a multiple of the widest SIMD register
+			// so that the vectorized path never needs a scalar remainder
+			// (the padding is always valid bodies that don't move)
+			static constexpr uint32_t s_laneCount = 8;
+
+			std::vector<float> m_position_x, m_position_y, m_position_z;
+			std::vector<float> m_velocity_x, m_velocity_y, m_velocity_z;
+			std::vector<float> m_acceleration_x, m_acceleration_y, m_acceleration_z;
+			std::vector<float> m_orientation_w, m_orientation_x, m_orientation_y, m_orientation_z;
+			std::vector<float> m_angularVelocityAxis_x, m_angularVelocityAxis_y, m_angularVelocityAxis_z;
+			std::vector<float> m_angularSpeed;
+			uint32_t m_count = 0;
+
+			eMode m_mode = eMode::Deterministic;
+			// This is only cleared to compare the paths
+			bool m_isVectorized = true;
+
+			// Implementation
+			//===============
+
+		private:
+
+			void Resize( const uint32_t i_paddedCount );
+		};
+	}
+}
+
+#endif	// EAE6320_PHYSICS_CRIGIDBODYBATCH_H
@@ -0,0 +1,133 @@
+/*
+	POSIX implementations of the platform functions
+
+	The engine only builds for Windows,
+	but the functions here are also used by tools that run on Linux
+*/
+
+// Includes
+//=========
+
+#include "../Platform.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Platform::MapFileReadOnly( const char* const i_path, sMappedFile& o_mappedFile, std::string* const o_errorMessage )
+{
+	o_mappedFile.Unmap();
+
+	const auto fileDescriptor = open( i_path, O_RDONLY | O_CLOEXEC );
+	if ( fileDescriptor == -1 )
+	{
+		const auto errorCode = errno;
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = std::string( "Failed to open the file \"" ) + i_path + "\" for reading: " + std::strerror( errorCode );
+		}
+		return ( errorCode == ENOENT ) ? Results::FileDoesntExist : Results::Failure;
+	}
+
+	auto result = Results::Success;
+	struct stat fileStatus;
+	if ( fstat( fileDescriptor, &fileStatus ) == 0 )
+	{
+		// An empty file can't be mapped
+		if ( fileStatus.st_size > 0 )
+		{
+			const auto size = static_cast<size_t>( fileStatus.st_size );
+			// The mapping keeps the file mapped after the descriptor is closed
+			auto* const data = mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0 );
+			if ( data != MAP_FAILED )
+			{
+				// The data is usually read from beginning to end
+				madvise( data, size, MADV_SEQUENTIAL );
+				o_mappedFile.data = data;
+				o_mappedFile.size = size;
+			}
+			else
+			{
+				result = Results::Failure;
+				if ( o_errorMessage )
+				{
+					*o_errorMessage = std::string( "Failed to map the file \"" ) + i_path + "\": " + std::strerror( errno );
+				}
+			}
+		}
+	}
+	else
+	{
+		result = Results::Failure;
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = std::string( "Failed to get the size of the file \"" ) + i_path + "\": " + std::strerror( errno );
+		}
+	}
+	close( fileDescriptor );
+
+	return result;
+}
+
+eae6320::cResult eae6320::Platform::WriteBinaryFile( const char* const i_path, const void* const i_data, const size_t i_size, std::string* const o_errorMessage )
+{
+	const auto fileDescriptor = open( i_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644 );
+	if ( fileDescriptor == -1 )
+	{
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = std::string( "Failed to open the file \"" ) + i_path + "\" for writing: " + std::strerror( errno );
+		}
+		return Results::Failure;
+	}
+
+	auto result = Results::Success;
+	// A single write can write less than was asked for
+	const auto* data = static_cast<const char*>( i_data );
+	auto sizeRemaining = i_size;
+	while ( sizeRemaining > 0 )
+	{
+		const auto writtenSize = write( fileDescriptor, data, sizeRemaining );
+		if ( writtenSize < 0 )
+		{
+			if ( errno == EINTR )
+			{
+				continue;
+			}
+			result = Results::Failure;
+			if ( o_errorMessage )
+			{
+				*o_errorMessage = std::string( "Failed to write to the file \"" ) + i_path + "\": " + std::strerror( errno );
+			}
+			break;
+		}
+		data += writtenSize;
+		sizeRemaining -= static_cast<size_t>( writtenSize );
+	}
+	if ( ( close( fileDescriptor ) != 0 ) && result )
+	{
+		result = Results::Failure;
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = std::string( "Failed to close the file \"" ) + i_path + "\": " + std::strerror( errno );
+		}
+	}
+
+	return result;
+}
+
+void eae6320::Platform::sMappedFile::Unmap() noexcept
+{
+	if ( data )
+	{
+		munmap( const_cast<void*>( data ), size );
+		data = nullptr;
+	}
+	size = 0;
+}
@@ -75,6 +75,46 @@ namespace eae6320
 			}
 		};
 
+		// This is a read-only view of an entire file
+		// that the operating system pages in directly from the file system cache
+		// (nothing is copied into allocated memory, and the view is released by Unmap() or the destructor)
+		struct sMappedFile
+		{
+			const void* data = nullptr;
+			size_t size = 0;
+
+			sMappedFile() = default;
+
+			void Unmap() noexcept;
+
+			~sMappedFile()
+			{
+				Unmap();
+			}
+
+			sMappedFile( const sMappedFile& ) = delete;
+			sMappedFile( sMappedFile&& io_movedFrom ) noexcept
+				:
+				data( io_movedFrom.data ), size( io_movedFrom.size )
+			{
+				io_movedFrom.data = nullptr;
+				io_movedFrom.size = 0;
+			}
+			sMappedFile& operator =( const sMappedFile& ) = delete;
+			sMappedFile& operator =( sMappedFile&& io_movedFrom ) noexcept
+			{
+				if ( &io_movedFrom != this )
+				{
+					Unmap();
+					data = io_movedFrom.data;
+					io_movedFrom.data = nullptr;
+					size = io_movedFrom.size;
+					io_movedFrom.size = 0;
+				}
+				return *this;
+			}
+		};
+
 		cResult CopyFile( const char* const i_path_source, const char* const i_path_target,
 			const bool i_shouldFunctionFailIfTargetAlreadyExists = false, const bool i_shouldTargetFileTimeBeModified = false,
 			std::string* o_errorMessage = nullptr );
@@ -87,6 +127,9 @@ namespace eae6320
 		cResult GetLastWriteTime( const char* const i_path, uint64_t& o_lastWriteTime, std::string* const o_errorMessage = nullptr );
 		cResult InvalidateLastWriteTime( const char* const i_path, std::string* const o_errorMessage = nullptr );
 		cResult LoadBinaryFile( const char* const i_path, sDataFromFile& o_data, std::string* const o_errorMessage = nullptr );
+		// Use this instead of LoadBinaryFile() when the data is only read once (e.g. to be uploaded to the GPU)
+		// and doesn't need to outlive the load
+		cResult MapFileReadOnly( const char* const i_path, sMappedFile& o_mappedFile, std::string* const o_errorMessage = nullptr );
 		// This function writes an entire file in a single operation in the most efficient way possible.
 		// If you need to write out more than one smaller chunk to a file, however,
 		// you should use one of the standard library functions that does buffering.
@@ -75,6 +75,19 @@ eae6320::cResult eae6320::Platform::LoadBinaryFile( const char* const i_path, sD
 	return result;
 }
 
+eae6320::cResult eae6320::Platform::MapFileReadOnly( const char* const i_path, sMappedFile& o_mappedFile, std::string* const o_errorMessage )
+{
+	o_mappedFile.Unmap();
+	return Windows::MapFileReadOnly( i_path, o_mappedFile.data, o_mappedFile.size, o_errorMessage );
+}
+
+void eae6320::Platform::sMappedFile::Unmap() noexcept
+{
+	Windows::UnmapFile( data );
+	data = nullptr;
+	size = 0;
+}
+
 eae6320::cResult eae6320::Platform::WriteBinaryFile( const char* const i_path, const void* const i_data, const size_t i_size, std::string* const o_errorMessage )
 {
 	return Windows::WriteBinaryFile( i_path, i_data, i_size, o_errorMessage );
@@ -0,0 +1,17 @@
+/*
+	This file provides configurable settings
+	that can be used to modify the runtime project
+*/
+
+#ifndef EAE6320_RUNTIME_CONFIGURATION_H
+#define EAE6320_RUNTIME_CONFIGURATION_H
+
+// The bounding volume hierarchy benchmark queries a synthetic scene at initialization
+// and writes the query cost (compared to brute force) to the log
+//#define EAE6320_RUNTIME_ISBVHBENCHMARKENABLED
+
+// The entity/component benchmark moves a large number of entities at initialization
+// and writes the time that the systems take (compared to per-object virtual updates) to the log
+//#define EAE6320_RUNTIME_ISECSBENCHMARKENABLED
+
+#endif	// EAE6320_RUNTIME_CONFIGURATION_H
@@ -0,0 +1,89 @@
+/*
+	These are the component types that the engine's systems understand
+
+	A component is only data
+	(the behavior that used to be in iComponent's virtual functions is in Systems.h),
+	and an entity only needs the components that a system uses
+	(e.g. an entity without sVelocity is never moved)
+*/
+
+#ifndef EAE6320_RUNTIME_COMPONENTS_H
+#define EAE6320_RUNTIME_COMPONENTS_H
+
+// Includes
+//=========
+
+#include <cstdint>
+#include <Engine/Math/cQuaternion.h>
+#include <Engine/Math/sVector.h>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class cMesh;
+	}
+}
+
+// Struct Declarations
+//====================
+
+namespace eae6320
+{
+	namespace Runtime
+	{
+		// Motion
+		//-------
+
+		struct sPosition
+		{
+			Math::sVector value;
+		};
+		struct sVelocity
+		{
+			Math::sVector value;	// Distance per second
+		};
+		struct sAcceleration
+		{
+			Math::sVector value;	// Distance per second^2
+		};
+		struct sOrientation
+		{
+			Math::cQuaternion value;
+		};
+		struct sAngularVelocity
+		{
+			Math::sVector axis_local = Math::sVector( 0.0f, 1.0f, 0.0f );	// In local space (not world space)
+			float speed = 0.0f;	// Radians per second (positive values rotate right-handed, negative rotate left-handed)
+		};
+		struct sScale
+		{
+			Math::sVector value = Math::sVector( 1.0f, 1.0f, 1.0f );
+		};
+
+		// Rendering
+		//----------
+
+		// The world doesn't manage the mesh's reference count,
+		// and so whoever creates the entity must keep a reference for as long as the entity uses it
+		struct sMeshRenderer
+		{
+			Graphics::cMesh* mesh = nullptr;
+			bool isVisible = true;
+		};
+
+		// Spatial Queries
+		//----------------
+
+		// The entity's proxy in a cBoundingVolumeHierarchy (see Systems::RegisterSpatialProxy())
+		struct sSpatialProxy
+		{
+			uint32_t proxyId = ~uint32_t( 0 );
+		};
+	}
+}
+
+#endif	// EAE6320_RUNTIME_COMPONENTS_H
@@ -0,0 +1,268 @@
+// Includes
+//=========
+
+#include "Systems.h"
+
+#include "Components.h"
+
+#include <cmath>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Graphics/cMesh.h>
+#include <Engine/Graphics/sRenderCommand.h>
+#include <Engine/Math/cMatrix_transformation.h>
+#include <Engine/Runtime/Spatial/cBoundingVolumeHierarchy.h>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// Transforms a mesh's local box and returns the world box that contains it
+	eae6320::Runtime::cBoundingVolumeHierarchy::sAabb CalculateWorldAabb( const eae6320::Graphics::MeshFormats::sBounds& i_bounds,
+		const eae6320::Math::cMatrix_transformation& i_transform_localToWorld );
+}
+
+// Interface
+//==========
+
+// Motion
+//-------
+
+void eae6320::Runtime::Systems::IntegrateMotion( cWorld& io_world, const float i_secondCountToIntegrate )
+{
+	io_world.ForEachArchetype<sPosition, sVelocity>( [i_secondCountToIntegrate]( const cWorld::cArchetypeView& i_archetype )
+		{
+			const auto count = i_archetype.GetCount();
+			auto* const positions = i_archetype.Get<sPosition>();
+			auto* const velocities = i_archetype.Get<sVelocity>();
+			auto* const accelerations = i_archetype.Get<sAcceleration>();
+			for ( uint32_t i = 0; i < count; ++i )
+			{
+				positions[i].value += velocities[i].value * i_secondCountToIntegrate;
+			}
+			if ( accelerations )
+			{
+				for ( uint32_t i = 0; i < count; ++i )
+				{
+					velocities[i].value += accelerations[i].value * i_secondCountToIntegrate;
+				}
+			}
+		} );
+	io_world.ForEachArchetype<sOrientation, sAngularVelocity>( [i_secondCountToIntegrate]( const cWorld::cArchetypeView& i_archetype )
+		{
+			const auto count = i_archetype.GetCount();
+			auto* const orientations = i_archetype.Get<sOrientation>();
+			const auto* const angularVelocities = i_archetype.Get<sAngularVelocity>();
+			for ( uint32_t i = 0; i < count; ++i )
+			{
+				const auto& angularVelocity = angularVelocities[i];
+				// Most entities don't spin, and their orientations don't need to be touched
+				if ( angularVelocity.speed != 0.0f )
+				{
+					auto& orientation = orientations[i].value;
+					orientation = orientation * Math::cQuaternion( angularVelocity.speed * i_secondCountToIntegrate, angularVelocity.axis_local );
+					orientation.Normalize();
+				}
+			}
+		} );
+}
+
+eae6320::Runtime::Systems::sTransformColumns::sTransformColumns( const cWorld::cArchetypeView& i_archetype )
+	:
+	positions( i_archetype.Get<sPosition>() ), velocities( i_archetype.Get<sVelocity>() ),
+	orientations( i_archetype.Get<sOrientation>() ), angularVelocities( i_archetype.Get<sAngularVelocity>() ),
+	scales( i_archetype.Get<sScale>() )
+{
+
+}
+
+eae6320::Math::cMatrix_transformation eae6320::Runtime::Systems::CalculateTransform_localToWorld( const sTransformColumns& i_columns, const uint32_t i_row,
+	const float i_secondCountToExtrapolate )
+{
+	Math::sVector position;
+	if ( i_columns.positions )
+	{
+		position = i_columns.positions[i_row].value;
+		if ( i_columns.velocities )
+		{
+			position += i_columns.velocities[i_row].value * i_secondCountToExtrapolate;
+		}
+	}
+	Math::cQuaternion orientation;
+	if ( i_columns.orientations )
+	{
+		orientation = i_columns.orientations[i_row].value;
+		if ( i_columns.angularVelocities && ( i_columns.angularVelocities[i_row].speed != 0.0f ) )
+		{
+			const auto& angularVelocity = i_columns.angularVelocities[i_row];
+			orientation = Math::cQuaternion( orientation
+				* Math::cQuaternion( angularVelocity.speed * i_secondCountToExtrapolate, angularVelocity.axis_local ) ).GetNormalized();
+		}
+	}
+	const Math::cMatrix_transformation transform( orientation, position );
+	if ( i_columns.scales )
+	{
+		return Math::cMatrix_transformation( i_columns.scales[i_row].value ) * transform;
+	}
+	return transform;
+}
+
+eae6320::Math::cMatrix_transformation eae6320::Runtime::Systems::CalculateTransform_localToWorld( const cWorld& i_world, const sEntity i_entity,
+	const float i_secondCountToExtrapolate )
+{
+	uint32_t archetypeIndex, row;
+	if ( !i_world.GetLocation( i_entity, archetypeIndex, row ) )
+	{
+		return Math::cMatrix_transformation();
+	}
+	return CalculateTransform_localToWorld( sTransformColumns( i_world.GetArchetype( archetypeIndex ) ), row, i_secondCountToExtrapolate );
+}
+
+// Spatial Queries
+//----------------
+
+eae6320::cResult eae6320::Runtime::Systems::RegisterSpatialProxy( cWorld& io_world, const sEntity i_entity, cBoundingVolumeHierarchy& io_hierarchy )
+{
+	const auto* const meshRenderer = io_world.GetComponent<sMeshRenderer>( i_entity );
+	if ( !meshRenderer || !meshRenderer->mesh )
+	{
+		EAE6320_ASSERTF( false, "An entity can't be registered without a mesh" );
+		return Results::Failure;
+	}
+	UnregisterSpatialProxy( io_world, i_entity, io_hierarchy );
+
+	const auto proxyId = io_hierarchy.CreateProxy( CalculateWorldAabb( meshRenderer->mesh->GetBounds(), CalculateTransform_localToWorld( io_world, i_entity ) ),
+		reinterpret_cast<void*>( static_cast<uintptr_t>( i_entity.id ) ) );
+	if ( proxyId == cBoundingVolumeHierarchy::s_invalidProxyId )
+	{
+		return Results::Failure;
+	}
+	const auto result = io_world.AddComponent( i_entity, sSpatialProxy{ proxyId } );
+	if ( !result )
+	{
+		io_hierarchy.DestroyProxy( proxyId );
+	}
+	return result;
+}
+
+void eae6320::Runtime::Systems::UnregisterSpatialProxy( cWorld& io_world, const sEntity i_entity, cBoundingVolumeHierarchy& io_hierarchy )
+{
+	if ( const auto* const spatialProxy = io_world.GetComponent<sSpatialProxy>( i_entity ) )
+	{
+		io_hierarchy.DestroyProxy( spatialProxy->proxyId );
+		io_world.RemoveComponent<sSpatialProxy>( i_entity );
+	}
+}
+
+void eae6320::Runtime::Systems::UpdateSpatialProxies( const cWorld& i_world, cBoundingVolumeHierarchy& io_hierarchy )
+{
+	i_world.ForEachArchetype<sSpatialProxy, sMeshRenderer>( [&io_hierarchy]( const cWorld::cArchetypeView& i_archetype )
+		{
+			const auto count = i_archetype.GetCount();
+			const auto* const spatialProxies = i_archetype.Get<sSpatialProxy>();
+			const auto* const meshRenderers = i_archetype.Get<sMeshRenderer>();
+			const sTransformColumns transformColumns( i_archetype );
+			for ( uint32_t i = 0; i < count; ++i )
+			{
+				if ( meshRenderers[i].mesh )
+				{
+					io_hierarchy.MoveProxy( spatialProxies[i].proxyId,
+						CalculateWorldAabb( meshRenderers[i].mesh->GetBounds(), CalculateTransform_localToWorld( transformColumns, i ) ) );
+				}
+			}
+		} );
+}
+
+eae6320::Runtime::sEntity eae6320::Runtime::Systems::GetEntity( const cBoundingVolumeHierarchy& i_hierarchy, const uint32_t i_proxyId )
+{
+	return sEntity{ static_cast<uint32_t>( reinterpret_cast<uintptr_t>( i_hierarchy.GetUserData( i_proxyId ) ) ) };
+}
+
+// Rendering
+//----------
+
+void eae6320::Runtime::Systems::GenerateRenderCommands( const cWorld& i_world, const sEntity* const i_entities, const uint32_t i_entityCount,
+	const float i_secondCountToExtrapolate, Graphics::sRenderCommand* const o_renderCommands )
+{
+	// The entities can be in any order,
+	// and so the columns of every archetype are fetched once before any entities are looked up
+	struct sColumns
+	{
+		const sMeshRenderer* meshRenderers = nullptr;
+		sTransformColumns transform;
+	};
+	std::vector<sColumns> archetypeColumns( i_world.GetArchetypeCount() );
+	for ( uint32_t i = 0; i < static_cast<uint32_t>( archetypeColumns.size() ); ++i )
+	{
+		const auto archetype = i_world.GetArchetype( i );
+		archetypeColumns[i] = sColumns{ archetype.Get<sMeshRenderer>(), sTransformColumns( archetype ) };
+	}
+	for ( uint32_t i = 0; i < i_entityCount; ++i )
+	{
+		auto& renderCommand = o_renderCommands[i];
+		renderCommand = Graphics::sRenderCommand();
+		uint32_t archetypeIndex, row;
+		if ( !i_world.GetLocation( i_entities[i], archetypeIndex, row ) )
+		{
+			continue;
+		}
+		const auto& columns = archetypeColumns[archetypeIndex];
+		const auto* const meshRenderers = columns.meshRenderers;
+		if ( meshRenderers && meshRenderers[row].isVisible && meshRenderers[row].mesh )
+		{
+			renderCommand.m_mesh = meshRenderers[row].mesh;
+			renderCommand.m_transformation = CalculateTransform_localToWorld( columns.transform, row, i_secondCountToExtrapolate );
+		}
+	}
+}
+
+void eae6320::Runtime::Systems::GenerateRenderCommands( const cWorld& i_world, const float i_secondCountToExtrapolate,
+	std::vector<Graphics::sRenderCommand>& io_renderCommands )
+{
+	i_world.ForEachArchetype<sMeshRenderer>( [i_secondCountToExtrapolate, &io_renderCommands]( const cWorld::cArchetypeView& i_archetype )
+		{
+			const auto count = i_archetype.GetCount();
+			const auto* const meshRenderers = i_archetype.Get<sMeshRenderer>();
+			const sTransformColumns transformColumns( i_archetype );
+			for ( uint32_t i = 0; i < count; ++i )
+			{
+				if ( meshRenderers[i].isVisible && meshRenderers[i].mesh )
+				{
+					Graphics::sRenderCommand renderCommand;
+					renderCommand.m_mesh = meshRenderers[i].mesh;
+					renderCommand.m_transformation = CalculateTransform_localToWorld( transformColumns, i, i_secondCountToExtrapolate );
+					io_renderCommands.push_back( renderCommand );
+				}
+			}
+		} );
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	eae6320::Runtime::cBoundingVolumeHierarchy::sAabb CalculateWorldAabb( const eae6320::Graphics::MeshFormats::sBounds& i_bounds,
+		const eae6320::Math::cMatrix_transformation& i_transform_localToWorld )
+	{
+		// Each world extent is the sum of the local extents projected onto that world axis
+		// (Arvo's "Transforming Axis-Aligned Bounding Boxes")
+		float center_world[3], extents_world[3];
+		for ( unsigned int i = 0; i < 3; ++i )
+		{
+			center_world[i] = i_transform_localToWorld.GetElement( i, 3 );
+			extents_world[i] = 0.0f;
+			for ( unsigned int j = 0; j < 3; ++j )
+			{
+				const auto element = i_transform_localToWorld.GetElement( i, j );
+				const auto center_local = ( i_bounds.minimum[j] + i_bounds.maximum[j] ) * 0.5f;
+				const auto extent_local = ( i_bounds.maximum[j] - i_bounds.minimum[j] ) * 0.5f;
+				center_world[i] += element * center_local;
+				extents_world[i] += std::abs( element ) * extent_local;
+			}
+		}
+		const eae6320::Math::sVector center( center_world[0], center_world[1], center_world[2] );
+		const eae6320::Math::sVector extents( extents_world[0], extents_world[1], extents_world[2] );
+		return eae6320::Runtime::cBoundingVolumeHierarchy::sAabb{ center - extents, center + extents };
+	}
+}
@@ -0,0 +1,116 @@
+/*
+	Systems update every entity that has the components they need,
+	one archetype's arrays at a time
+
+	These replace the per-object virtual updates of iGameobject and iComponent
+	for the motion, spatial query, and rendering behavior of game objects
+*/
+
+#ifndef EAE6320_RUNTIME_SYSTEMS_H
+#define EAE6320_RUNTIME_SYSTEMS_H
+
+// Includes
+//=========
+
+#include "cWorld.h"
+
+#include <cstdint>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		struct sRenderCommand;
+	}
+	namespace Math
+	{
+		class cMatrix_transformation;
+	}
+	namespace Runtime
+	{
+		class cBoundingVolumeHierarchy;
+		struct sAngularVelocity;
+		struct sOrientation;
+		struct sPosition;
+		struct sScale;
+		struct sVelocity;
+	}
+}
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Runtime
+	{
+		namespace Systems
+		{
+			// Motion
+			//-------
+
+			// Integrates every entity with sPosition and sVelocity
+			// (and sAcceleration if it has one),
+			// and every entity with sOrientation and sAngularVelocity,
+			// the same way that Physics::sRigidBodyState::Update() does
+			void IntegrateMotion( cWorld& io_world, const float i_secondCountToIntegrate );
+
+			// The components of one archetype that a transform is calculated from
+			// (a column is null if the archetype doesn't have that component type).
+			// A system gets them once for each archetype instead of looking up every component of every entity
+			struct sTransformColumns
+			{
+				const sPosition* positions = nullptr;
+				const sVelocity* velocities = nullptr;
+				const sOrientation* orientations = nullptr;
+				const sAngularVelocity* angularVelocities = nullptr;
+				const sScale* scales = nullptr;
+
+				sTransformColumns() = default;
+				explicit sTransformColumns( const cWorld::cArchetypeView& i_archetype );
+			};
+
+			// Returns the local-to-world transform of the entity in the row, predicted from its velocities
+			// (an entity without sPosition, sOrientation, or sScale uses the identity for the missing part)
+			Math::cMatrix_transformation CalculateTransform_localToWorld( const sTransformColumns& i_columns, const uint32_t i_row,
+				const float i_secondCountToExtrapolate = 0.0f );
+			// This looks up the entity's archetype every time,
+			// and so it should only be used for one entity at a time (a system should use the columns instead)
+			Math::cMatrix_transformation CalculateTransform_localToWorld( const cWorld& i_world, const sEntity i_entity,
+				const float i_secondCountToExtrapolate = 0.0f );
+
+			// Spatial Queries
+			//----------------
+
+			// Adds an sSpatialProxy to an entity with an sMeshRenderer
+			// so that the world bounds of its mesh are kept in the hierarchy.
+			// The proxy's user data is the entity (see GetEntity())
+			cResult RegisterSpatialProxy( cWorld& io_world, const sEntity i_entity, cBoundingVolumeHierarchy& io_hierarchy );
+			// This must be called before an entity with a proxy is destroyed
+			void UnregisterSpatialProxy( cWorld& io_world, const sEntity i_entity, cBoundingVolumeHierarchy& io_hierarchy );
+			// Moves every entity's proxy to the current bounds of its mesh
+			void UpdateSpatialProxies( const cWorld& i_world, cBoundingVolumeHierarchy& io_hierarchy );
+			sEntity GetEntity( const cBoundingVolumeHierarchy& i_hierarchy, const uint32_t i_proxyId );
+
+			// Rendering
+			//----------
+
+			// Writes one command for each entity.
+			// An entity without a visible mesh gets a command with a null mesh,
+			// and so the commands line up with the entities.
+			// The commands don't hold references to their meshes
+			// and must not be cleaned up (Graphics::SubmitRenderCommands() takes its own references)
+			void GenerateRenderCommands( const cWorld& i_world, const sEntity* const i_entities, const uint32_t i_entityCount,
+				const float i_secondCountToExtrapolate, Graphics::sRenderCommand* const o_renderCommands );
+			// Appends a command for every entity with a visible mesh
+			void GenerateRenderCommands( const cWorld& i_world, const float i_secondCountToExtrapolate,
+				std::vector<Graphics::sRenderCommand>& io_renderCommands );
+		}
+	}
+}
+
+#endif	// EAE6320_RUNTIME_SYSTEMS_H
@@ -0,0 +1,369 @@
+// Includes
+//=========
+
+#include "cWorld.h"
+
+#include <algorithm>
+#include <new>
+#include <Engine/Logging/Logging.h>
+
+#ifdef EAE6320_RUNTIME_ISECSBENCHMARKENABLED
+	#include "Components.h"
+	#include "Systems.h"
+
+	#include <memory>
+	#include <Engine/Runtime/Component/cMovementComponent.h>
+	#include <Engine/Time/Time.h>
+#endif
+
+// Static Data
+//============
+
+eae6320::Runtime::cWorld::sComponentType eae6320::Runtime::cWorld::s_componentTypes[s_maximumComponentTypeCount];
+std::atomic<unsigned int> eae6320::Runtime::cWorld::s_componentTypeCount( 0 );
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// Columns are aligned to a cache line so that a system's loads never straddle two columns
+	constexpr size_t s_columnAlignment = 64;
+	// An archetype's arrays never have fewer rows than this
+	constexpr uint32_t s_minimumCapacity = 64;
+}
+
+// Interface
+//==========
+
+// Entities
+//---------
+
+void eae6320::Runtime::cWorld::DestroyEntity( const sEntity i_entity )
+{
+	if ( !IsAlive( i_entity ) )
+	{
+		EAE6320_ASSERTF( false, "An entity can't be destroyed if it isn't alive" );
+		return;
+	}
+	auto& record = m_entityRecords[i_entity.GetIndex()];
+	RemoveRow( *m_archetypes[record.archetypeIndex], record.row );
+	record.isAlive = false;
+	// Any handles to the destroyed entity will no longer match its slot
+	++record.generation;
+	m_freeEntityIndices.push_back( i_entity.GetIndex() );
+	--m_entityCount;
+}
+
+bool eae6320::Runtime::cWorld::IsAlive( const sEntity i_entity ) const
+{
+	const auto index = i_entity.GetIndex();
+	if ( index >= m_entityRecords.size() )
+	{
+		return false;
+	}
+	const auto& record = m_entityRecords[index];
+	return record.isAlive && ( record.generation == i_entity.GetGeneration() );
+}
+
+// Iteration
+//----------
+
+bool eae6320::Runtime::cWorld::GetLocation( const sEntity i_entity, uint32_t& o_archetypeIndex, uint32_t& o_row ) const
+{
+	if ( !IsAlive( i_entity ) )
+	{
+		return false;
+	}
+	const auto& record = m_entityRecords[i_entity.GetIndex()];
+	o_archetypeIndex = record.archetypeIndex;
+	o_row = record.row;
+	return true;
+}
+
+eae6320::Runtime::cWorld::cArchetypeView eae6320::Runtime::cWorld::GetArchetype( const uint32_t i_archetypeIndex ) const
+{
+	EAE6320_ASSERT( i_archetypeIndex < m_archetypes.size() );
+	return cArchetypeView( *m_archetypes[i_archetypeIndex] );
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::Runtime::cWorld::~cWorld()
+{
+	for ( auto* const archetype : m_archetypes )
+	{
+		for ( auto* const column : archetype->columns )
+		{
+			::operator delete[]( column, std::align_val_t( s_columnAlignment ) );
+		}
+		delete archetype;
+	}
+	m_archetypes.clear();
+	m_archetypeIndices.clear();
+}
+
+// Implementation
+//===============
+
+uint8_t eae6320::Runtime::cWorld::RegisterComponentType( const size_t i_size, const size_t i_alignment )
+{
+	const auto componentTypeId = s_componentTypeCount.fetch_add( 1 );
+	if ( componentTypeId >= s_maximumComponentTypeCount )
+	{
+		// There is no way to recover from this, and the limit should be increased
+		EAE6320_ASSERTF( false, "There can't be more than %u component types", s_maximumComponentTypeCount );
+		Logging::OutputError( "A component type couldn't be registered because there are already %u types", s_maximumComponentTypeCount );
+		return static_cast<uint8_t>( s_maximumComponentTypeCount - 1 );
+	}
+	EAE6320_ASSERTF( i_alignment <= s_columnAlignment, "A component can't be aligned to more than %u bytes", static_cast<unsigned int>( s_columnAlignment ) );
+	s_componentTypes[componentTypeId] = sComponentType{ i_size, i_alignment };
+	return static_cast<uint8_t>( componentTypeId );
+}
+
+eae6320::Runtime::cWorld::sArchetype* eae6320::Runtime::cWorld::FindOrCreateArchetype( const tSignature i_signature, uint32_t& o_archetypeIndex )
+{
+	{
+		const auto iterator = m_archetypeIndices.find( i_signature );
+		if ( iterator != m_archetypeIndices.end() )
+		{
+			o_archetypeIndex = iterator->second;
+			return m_archetypes[o_archetypeIndex];
+		}
+	}
+	auto* const archetype = new ( std::nothrow ) sArchetype;
+	if ( !archetype )
+	{
+		EAE6320_ASSERTF( false, "Couldn't allocate an archetype" );
+		Logging::OutputError( "Failed to allocate an archetype" );
+		return nullptr;
+	}
+	archetype->signature = i_signature;
+	std::fill( std::begin( archetype->columnIndices ), std::end( archetype->columnIndices ), s_noColumn );
+	for ( uint8_t i = 0; i < s_maximumComponentTypeCount; ++i )
+	{
+		if ( ( i_signature & ( tSignature( 1 ) << i ) ) != 0 )
+		{
+			archetype->columnIndices[i] = static_cast<uint8_t>( archetype->componentTypeIds.size() );
+			archetype->componentTypeIds.push_back( i );
+		}
+	}
+	archetype->columns.resize( archetype->componentTypeIds.size(), nullptr );
+	o_archetypeIndex = static_cast<uint32_t>( m_archetypes.size() );
+	m_archetypes.push_back( archetype );
+	m_archetypeIndices.insert( std::make_pair( i_signature, o_archetypeIndex ) );
+	return archetype;
+}
+
+bool eae6320::Runtime::cWorld::Reserve( sArchetype& io_archetype, const uint32_t i_capacity )
+{
+	if ( i_capacity <= io_archetype.capacity )
+	{
+		return true;
+	}
+	// The capacity at least doubles so that adding an entity is amortized constant time
+	const auto capacity_new = std::max( { i_capacity, io_archetype.capacity * 2, s_minimumCapacity } );
+	std::vector<uint8_t*> columns_new( io_archetype.columns.size(), nullptr );
+	for ( size_t i = 0; i < columns_new.size(); ++i )
+	{
+		const auto componentSize = s_componentTypes[io_archetype.componentTypeIds[i]].size;
+		columns_new[i] = static_cast<uint8_t*>( ::operator new[]( componentSize * capacity_new, std::align_val_t( s_columnAlignment ), std::nothrow ) );
+		if ( !columns_new[i] )
+		{
+			EAE6320_ASSERTF( false, "Couldn't allocate %u components", capacity_new );
+			Logging::OutputError( "Failed to allocate %u components of an archetype", capacity_new );
+			for ( size_t j = 0; j < i; ++j )
+			{
+				::operator delete[]( columns_new[j], std::align_val_t( s_columnAlignment ) );
+			}
+			return false;
+		}
+		if ( io_archetype.columns[i] )
+		{
+			memcpy( columns_new[i], io_archetype.columns[i], componentSize * io_archetype.count );
+			::operator delete[]( io_archetype.columns[i], std::align_val_t( s_columnAlignment ) );
+		}
+	}
+	io_archetype.columns.swap( columns_new );
+	io_archetype.entities.resize( capacity_new );
+	io_archetype.capacity = capacity_new;
+	return true;
+}
+
+eae6320::Runtime::sEntity eae6320::Runtime::cWorld::AllocateEntity( const tSignature i_signature )
+{
+	uint32_t archetypeIndex;
+	auto* const archetype = FindOrCreateArchetype( i_signature, archetypeIndex );
+	if ( !archetype || !Reserve( *archetype, archetype->count + 1 ) )
+	{
+		return s_invalidEntity;
+	}
+	uint32_t entityIndex;
+	if ( !m_freeEntityIndices.empty() )
+	{
+		entityIndex = m_freeEntityIndices.back();
+		m_freeEntityIndices.pop_back();
+	}
+	else
+	{
+		if ( m_entityRecords.size() >= s_maximumEntityCount )
+		{
+			EAE6320_ASSERTF( false, "A world can't have more than %u entities", s_maximumEntityCount );
+			Logging::OutputError( "An entity couldn't be created because the world already has %u entities", s_maximumEntityCount );
+			return s_invalidEntity;
+		}
+		entityIndex = static_cast<uint32_t>( m_entityRecords.size() );
+		m_entityRecords.emplace_back();
+	}
+	auto& record = m_entityRecords[entityIndex];
+	record.archetypeIndex = archetypeIndex;
+	record.row = archetype->count++;
+	record.isAlive = true;
+	const sEntity entity{ entityIndex | ( uint32_t( record.generation ) << 24 ) };
+	archetype->entities[record.row] = entity;
+	++m_entityCount;
+	return entity;
+}
+
+eae6320::cResult eae6320::Runtime::cWorld::MoveEntity( const sEntity i_entity, const tSignature i_signature_new )
+{
+	auto& record = m_entityRecords[i_entity.GetIndex()];
+	uint32_t archetypeIndex_new;
+	auto* const archetype_new = FindOrCreateArchetype( i_signature_new, archetypeIndex_new );
+	if ( !archetype_new || !Reserve( *archetype_new, archetype_new->count + 1 ) )
+	{
+		return Results::OutOfMemory;
+	}
+	// The old archetype is looked up after the new one is created
+	// because creating an archetype can reallocate the list (but never the archetypes themselves)
+	auto& archetype_old = *m_archetypes[record.archetypeIndex];
+	const auto row_new = archetype_new->count++;
+	for ( size_t i = 0; i < archetype_old.componentTypeIds.size(); ++i )
+	{
+		const auto componentTypeId = archetype_old.componentTypeIds[i];
+		const auto columnIndex_new = archetype_new->columnIndices[componentTypeId];
+		if ( columnIndex_new != s_noColumn )
+		{
+			const auto componentSize = s_componentTypes[componentTypeId].size;
+			memcpy( archetype_new->columns[columnIndex_new] + ( componentSize * row_new ),
+				archetype_old.columns[i] + ( componentSize * record.row ), componentSize );
+		}
+	}
+	archetype_new->entities[row_new] = i_entity;
+	RemoveRow( archetype_old, record.row );
+	record.archetypeIndex = archetypeIndex_new;
+	record.row = row_new;
+	return Results::Success;
+}
+
+void eae6320::Runtime::cWorld::RemoveRow( sArchetype& io_archetype, const uint32_t i_row )
+{
+	EAE6320_ASSERT( i_row < io_archetype.count );
+	const auto row_last = --io_archetype.count;
+	if ( i_row != row_last )
+	{
+		for ( size_t i = 0; i < io_archetype.columns.size(); ++i )
+		{
+			const auto componentSize = s_componentTypes[io_archetype.componentTypeIds[i]].size;
+			memcpy( io_archetype.columns[i] + ( componentSize * i_row ), io_archetype.columns[i] + ( componentSize * row_last ), componentSize );
+		}
+		const auto entity_moved = io_archetype.entities[row_last];
+		io_archetype.entities[i_row] = entity_moved;
+		m_entityRecords[entity_moved.GetIndex()].row = i_row;
+	}
+}
+
+void* eae6320::Runtime::cWorld::GetComponentData( const sEntity i_entity, const uint8_t i_componentTypeId ) const
+{
+	if ( !IsAlive( i_entity ) )
+	{
+		return nullptr;
+	}
+	const auto& record = m_entityRecords[i_entity.GetIndex()];
+	const auto& archetype = *m_archetypes[record.archetypeIndex];
+	const auto columnIndex = archetype.columnIndices[i_componentTypeId];
+	if ( columnIndex == s_noColumn )
+	{
+		return nullptr;
+	}
+	return archetype.columns[columnIndex] + ( s_componentTypes[i_componentTypeId].size * record.row );
+}
+
+#ifdef EAE6320_RUNTIME_ISECSBENCHMARKENABLED
+
+void eae6320::Runtime::cWorld::RunBenchmark()
+{
+	constexpr uint32_t entityCount = 100000;
+	constexpr unsigned int updateCount = 60;
+	constexpr float secondsPerUpdate = 1.0f / 15.0f;
+
+	// A fixed LCG makes the results comparable between runs
+	uint32_t randomState = 6320;
+	const auto GetRandom = [&randomState]( const float i_minimum, const float i_maximum )
+	{
+		randomState = ( randomState * 1664525u ) + 1013904223u;
+		return i_minimum + ( ( i_maximum - i_minimum ) * ( static_cast<float>( randomState >> 8 ) / static_cast<float>( 1 << 24 ) ) );
+	};
+	const auto GetRandomVector = [&GetRandom]( const float i_extent )
+	{
+		return Math::sVector( GetRandom( -i_extent, i_extent ), GetRandom( -i_extent, i_extent ), GetRandom( -i_extent, i_extent ) );
+	};
+	const auto GetMilliseconds = []( const uint64_t i_tickCount )
+	{
+		return Time::ConvertTicksToSeconds( i_tickCount ) * 1000.0;
+	};
+
+	Logging::OutputMessage( "Entity/component benchmark (%u entities, %u updates):", entityCount, updateCount );
+
+	// Every object is allocated separately and updated through a virtual call
+	{
+		std::vector<std::unique_ptr<iComponent>> components;
+		components.reserve( entityCount );
+		const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+		for ( uint32_t i = 0; i < entityCount; ++i )
+		{
+			auto* const component = new cMovementComponent;
+			component->SetPosition( GetRandomVector( 500.0f ) );
+			component->SetVeolocity( GetRandomVector( 5.0f ) );
+			component->SetAngularSpeed( GetRandom( -1.0f, 1.0f ) );
+			components.emplace_back( component );
+		}
+		const auto tickCount_created = Time::GetCurrentSystemTimeTickCount();
+		for ( unsigned int i = 0; i < updateCount; ++i )
+		{
+			for ( const auto& component : components )
+			{
+				component->UpdateSimulationBasedOnTime( secondsPerUpdate );
+			}
+		}
+		const auto tickCount_updated = Time::GetCurrentSystemTimeTickCount();
+		Logging::OutputMessage( "\tVirtual components: creation %.3f ms, update %.3f ms per frame",
+			GetMilliseconds( tickCount_created - tickCount_start ), GetMilliseconds( tickCount_updated - tickCount_created ) / updateCount );
+	}
+
+	// The same data is stored by archetype and updated by a system
+	randomState = 6320;
+	{
+		cWorld world;
+		const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+		for ( uint32_t i = 0; i < entityCount; ++i )
+		{
+			const sPosition position{ GetRandomVector( 500.0f ) };
+			const sVelocity velocity{ GetRandomVector( 5.0f ) };
+			sAngularVelocity angularVelocity;
+			angularVelocity.speed = GetRandom( -1.0f, 1.0f );
+			world.CreateEntity( position, velocity, sAcceleration(), sOrientation(), angularVelocity );
+		}
+		const auto tickCount_created = Time::GetCurrentSystemTimeTickCount();
+		for ( unsigned int i = 0; i < updateCount; ++i )
+		{
+			Systems::IntegrateMotion( world, secondsPerUpdate );
+		}
+		const auto tickCount_updated = Time::GetCurrentSystemTimeTickCount();
+		Logging::OutputMessage( "\tArchetype systems: creation %.3f ms, update %.3f ms per frame",
+			GetMilliseconds( tickCount_created - tickCount_start ), GetMilliseconds( tickCount_updated - tickCount_created ) / updateCount );
+	}
+}
+
+#endif	// EAE6320_RUNTIME_ISECSBENCHMARKENABLED
@@ -0,0 +1,239 @@
+/*
+	A world stores entities and their components by archetype
+	so that systems can update many entities by iterating over tightly packed arrays
+	instead of calling virtual functions on every object
+
+	An entity is only a handle, and its data is the set of components that it has:
+		* Every entity with the same set of component types belongs to the same archetype
+		* An archetype stores each of its component types in a separate contiguous array
+			(and so a system only touches the components that it needs)
+		* Adding or removing a component moves the entity to a different archetype,
+			and destroying an entity moves the archetype's last entity into its place
+
+	A handle stays valid until its entity is destroyed,
+	and the generation that is stored in it makes handles to destroyed entities invalid
+	even if their slot is reused
+	(the generation only has 8 bits, and so a stale handle could match again after its slot is reused 256 times)
+
+	Components are copied with memcpy() and are never destructed,
+	and so they must be trivially copyable
+	(a component can refer to an asset but the world doesn't manage the asset's references)
+*/
+
+#ifndef EAE6320_RUNTIME_CWORLD_H
+#define EAE6320_RUNTIME_CWORLD_H
+
+// Includes
+//=========
+
+#include <Engine/Results/Results.h>
+#include <Engine/Runtime/Configuration.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// Struct Declaration
+//===================
+
+namespace eae6320
+{
+	namespace Runtime
+	{
+		// The low 24 bits are the entity's slot and the high 8 bits are the slot's generation
+		// (it fits in a pointer so that it can be used as user data, e.g. by cBoundingVolumeHierarchy)
+		struct sEntity
+		{
+			uint32_t id = ~uint32_t( 0 );
+
+			uint32_t GetIndex() const { return id & 0xffffff; }
+			uint8_t GetGeneration() const { return static_cast<uint8_t>( id >> 24 ); }
+
+			bool operator ==( const sEntity i_rhs ) const { return id == i_rhs.id; }
+			bool operator !=( const sEntity i_rhs ) const { return id != i_rhs.id; }
+		};
+	}
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Runtime
+	{
+		class cWorld
+		{
+			struct sArchetype;
+
+			// Interface
+			//==========
+
+		public:
+
+			static constexpr sEntity s_invalidEntity{};
+			static constexpr unsigned int s_maximumComponentTypeCount = 64;
+			static constexpr uint32_t s_maximumEntityCount = 0x1000000;
+
+			// The components of one archetype that a system iterates over
+			class cArchetypeView
+			{
+			public:
+
+				uint32_t GetCount() const { return m_archetype.count; }
+				const sEntity* GetEntities() const { return m_archetype.entities.data(); }
+				// Returns null if the archetype doesn't have the component type
+				// (this is how a system handles optional components)
+				template <typename tComponent>
+					tComponent* Get() const;
+
+			private:
+
+				friend class cWorld;
+				explicit cArchetypeView( const sArchetype& i_archetype ) : m_archetype( i_archetype ) {}
+				const sArchetype& m_archetype;
+			};
+
+			// Entities
+			//---------
+
+			// Returns s_invalidEntity if the entity couldn't be created
+			template <typename... tComponents>
+				sEntity CreateEntity( const tComponents&... i_components );
+			void DestroyEntity( const sEntity i_entity );
+			bool IsAlive( const sEntity i_entity ) const;
+			uint32_t GetEntityCount() const { return m_entityCount; }
+
+			// Components
+			//-----------
+
+			// Returns null if the entity isn't alive or doesn't have the component.
+			// The pointer is only valid until an entity is created or destroyed
+			// or a component is added or removed
+			template <typename tComponent>
+				tComponent* GetComponent( const sEntity i_entity ) const;
+			// If the entity already has the component it is overwritten
+			template <typename tComponent>
+				cResult AddComponent( const sEntity i_entity, const tComponent& i_component );
+			template <typename tComponent>
+				cResult RemoveComponent( const sEntity i_entity );
+
+			// Iteration
+			//----------
+
+			// Calls i_function( const cArchetypeView& ) for every non-empty archetype that has all of the component types.
+			// Entities must not be created or destroyed (and components must not be added or removed) during the iteration
+			template <typename... tComponents, typename tFunction>
+				void ForEachArchetype( tFunction&& i_function ) const;
+			// Calls i_function( sEntity, tComponents&... ) for every entity that has all of the component types
+			template <typename... tComponents, typename tFunction>
+				void ForEach( tFunction&& i_function ) const;
+			// Returns false if the entity isn't alive.
+			// Otherwise the entity's components are in row o_row of the columns of the archetype with index o_archetypeIndex,
+			// and so a system that is given a list of entities can get the columns of each archetype once
+			// instead of looking up every component of every entity
+			bool GetLocation( const sEntity i_entity, uint32_t& o_archetypeIndex, uint32_t& o_row ) const;
+			// An archetype index stays valid for the lifetime of the world
+			// (the view can be empty, and new archetypes can be created when components are added)
+			uint32_t GetArchetypeCount() const { return static_cast<uint32_t>( m_archetypes.size() ); }
+			cArchetypeView GetArchetype( const uint32_t i_archetypeIndex ) const;
+
+			// Each component type has a small ID the first time it is used
+			template <typename tComponent>
+				static uint8_t GetComponentTypeId();
+
+#ifdef EAE6320_RUNTIME_ISECSBENCHMARKENABLED
+			// Moves a large number of entities at the simulation rate,
+			// comparing the systems to per-object virtual updates,
+			// and writes the timings to the log
+			static void RunBenchmark();
+#endif
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			cWorld() = default;
+			~cWorld();
+
+			cWorld( const cWorld& ) = delete;
+			cWorld( cWorld&& ) = delete;
+			cWorld& operator =( const cWorld& ) = delete;
+			cWorld& operator =( cWorld&& ) = delete;
+
+			// Data
+			//=====
+
+		private:
+
+			// Each bit is a component type ID
+			using tSignature = uint64_t;
+			static constexpr uint8_t s_noColumn = 0xff;
+
+			struct sComponentType
+			{
+				size_t size = 0;
+				size_t alignment = 0;
+			};
+			static sComponentType s_componentTypes[s_maximumComponentTypeCount];
+			static std::atomic<unsigned int> s_componentTypeCount;
+
+			struct sArchetype
+			{
+				tSignature signature = 0;
+				// The column of each component type ID (or s_noColumn)
+				uint8_t columnIndices[s_maximumComponentTypeCount];
+				std::vector<uint8_t> componentTypeIds;
+				// Each column is an array of one component type, aligned to a cache line
+				std::vector<uint8_t*> columns;
+				std::vector<sEntity> entities;
+				uint32_t count = 0;
+				uint32_t capacity = 0;
+			};
+			// The archetypes are never destroyed,
+			// and so an archetype index stays valid for the lifetime of the world
+			std::vector<sArchetype*> m_archetypes;
+			std::unordered_map<tSignature, uint32_t> m_archetypeIndices;
+
+			struct sEntityRecord
+			{
+				uint32_t archetypeIndex = 0;
+				uint32_t row = 0;
+				uint8_t generation = 0;
+				bool isAlive = false;
+			};
+			std::vector<sEntityRecord> m_entityRecords;
+			std::vector<uint32_t> m_freeEntityIndices;
+			uint32_t m_entityCount = 0;
+
+			// Implementation
+			//===============
+
+		private:
+
+			template <typename... tComponents>
+				static tSignature GetSignature();
+
+			static uint8_t RegisterComponentType( const size_t i_size, const size_t i_alignment );
+
+			// Returns nullptr if the archetype couldn't be created
+			sArchetype* FindOrCreateArchetype( const tSignature i_signature, uint32_t& o_archetypeIndex );
+			static bool Reserve( sArchetype& io_archetype, const uint32_t i_capacity );
+			// Returns s_invalidEntity if there isn't any memory;
+			// the new entity's components are uninitialized
+			sEntity AllocateEntity( const tSignature i_signature );
+			// Moves the entity's components that exist in both archetypes
+			// (the components that only exist in the new archetype are uninitialized)
+			cResult MoveEntity( const sEntity i_entity, const tSignature i_signature_new );
+			// Swaps the archetype's last entity into the row
+			void RemoveRow( sArchetype& io_archetype, const uint32_t i_row );
+			void* GetComponentData( const sEntity i_entity, const uint8_t i_componentTypeId ) const;
+		};
+	}
+}
+
+#include "cWorld.inl"
+
+#endif	// EAE6320_RUNTIME_CWORLD_H
@@ -0,0 +1,143 @@
+#ifndef EAE6320_RUNTIME_CWORLD_INL
+#define EAE6320_RUNTIME_CWORLD_INL
+
+// Includes
+//=========
+
+#include "cWorld.h"
+
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <tuple>
+#include <utility>
+
+// Interface
+//==========
+
+// Archetype View
+//---------------
+
+template <typename tComponent>
+tComponent* eae6320::Runtime::cWorld::cArchetypeView::Get() const
+{
+	const auto columnIndex = m_archetype.columnIndices[GetComponentTypeId<tComponent>()];
+	return ( columnIndex != s_noColumn ) ? reinterpret_cast<tComponent*>( m_archetype.columns[columnIndex] ) : nullptr;
+}
+
+// Entities
+//---------
+
+template <typename... tComponents>
+eae6320::Runtime::sEntity eae6320::Runtime::cWorld::CreateEntity( const tComponents&... i_components )
+{
+	const auto entity = AllocateEntity( GetSignature<tComponents...>() );
+	if ( entity != s_invalidEntity )
+	{
+		( memcpy( GetComponentData( entity, GetComponentTypeId<tComponents>() ), &i_components, sizeof( tComponents ) ), ... );
+	}
+	return entity;
+}
+
+// Components
+//-----------
+
+template <typename tComponent>
+tComponent* eae6320::Runtime::cWorld::GetComponent( const sEntity i_entity ) const
+{
+	return static_cast<tComponent*>( GetComponentData( i_entity, GetComponentTypeId<tComponent>() ) );
+}
+
+template <typename tComponent>
+eae6320::cResult eae6320::Runtime::cWorld::AddComponent( const sEntity i_entity, const tComponent& i_component )
+{
+	if ( !IsAlive( i_entity ) )
+	{
+		EAE6320_ASSERTF( false, "A component can't be added to an entity that isn't alive" );
+		return Results::Failure;
+	}
+	const auto componentTypeId = GetComponentTypeId<tComponent>();
+	const auto signature = m_archetypes[m_entityRecords[i_entity.GetIndex()].archetypeIndex]->signature;
+	if ( ( signature & ( tSignature( 1 ) << componentTypeId ) ) == 0 )
+	{
+		const auto result = MoveEntity( i_entity, signature | ( tSignature( 1 ) << componentTypeId ) );
+		if ( !result )
+		{
+			return result;
+		}
+	}
+	memcpy( GetComponentData( i_entity, componentTypeId ), &i_component, sizeof( tComponent ) );
+	return Results::Success;
+}
+
+template <typename tComponent>
+eae6320::cResult eae6320::Runtime::cWorld::RemoveComponent( const sEntity i_entity )
+{
+	if ( !IsAlive( i_entity ) )
+	{
+		EAE6320_ASSERTF( false, "A component can't be removed from an entity that isn't alive" );
+		return Results::Failure;
+	}
+	const auto componentTypeId = GetComponentTypeId<tComponent>();
+	const auto signature = m_archetypes[m_entityRecords[i_entity.GetIndex()].archetypeIndex]->signature;
+	if ( ( signature & ( tSignature( 1 ) << componentTypeId ) ) == 0 )
+	{
+		return Results::Success;
+	}
+	return MoveEntity( i_entity, signature & ~( tSignature( 1 ) << componentTypeId ) );
+}
+
+// Iteration
+//----------
+
+template <typename... tComponents, typename tFunction>
+void eae6320::Runtime::cWorld::ForEachArchetype( tFunction&& i_function ) const
+{
+	const auto signature = GetSignature<tComponents...>();
+	for ( const auto* const archetype : m_archetypes )
+	{
+		if ( ( ( archetype->signature & signature ) == signature ) && ( archetype->count > 0 ) )
+		{
+			i_function( cArchetypeView( *archetype ) );
+		}
+	}
+}
+
+template <typename... tComponents, typename tFunction>
+void eae6320::Runtime::cWorld::ForEach( tFunction&& i_function ) const
+{
+	ForEachArchetype<tComponents...>( [&i_function]( const cArchetypeView& i_archetype )
+		{
+			const auto count = i_archetype.GetCount();
+			const auto* const entities = i_archetype.GetEntities();
+			const auto columns = std::make_tuple( i_archetype.Get<tComponents>()... );
+			for ( uint32_t i = 0; i < count; ++i )
+			{
+				std::apply( [&i_function, &entities, i]( tComponents* const... i_columns )
+					{
+						i_function( entities[i], i_columns[i]... );
+					}, columns );
+			}
+		} );
+}
+
+template <typename tComponent>
+uint8_t eae6320::Runtime::cWorld::GetComponentTypeId()
+{
+	static_assert( std::is_trivially_copyable<tComponent>::value && std::is_trivially_destructible<tComponent>::value,
+		"Components are copied with memcpy() and are never destructed" );
+	// Each type registers itself the first time that it is used
+	// (a function-local static is only initialized once even if several threads use it at the same time)
+	static const auto s_componentTypeId = RegisterComponentType( sizeof( tComponent ), alignof( tComponent ) );
+	return s_componentTypeId;
+}
+
+// Implementation
+//===============
+
+template <typename... tComponents>
+eae6320::Runtime::cWorld::tSignature eae6320::Runtime::cWorld::GetSignature()
+{
+	return ( tSignature( 0 ) | ... | ( tSignature( 1 ) << GetComponentTypeId<tComponents>() ) );
+}
+
+#endif	// EAE6320_RUNTIME_CWORLD_INL
@@ -0,0 +1,1129 @@
+// Includes
+//=========
+
+#include "cBoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+
+#ifdef EAE6320_RUNTIME_ISBVHBENCHMARKENABLED
+	#include <cmath>
+	#include <Engine/Graphics/cFrustumCuller.h>
+	#include <Engine/Math/cMatrix_transformation.h>
+	#include <Engine/Math/cQuaternion.h>
+	#include <Engine/Math/Functions.h>
+	#include <Engine/Time/Time.h>
+#endif
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	using sAabb = eae6320::Runtime::cBoundingVolumeHierarchy::sAabb;
+
+	// Background builds store proxy IDs and build node indices in the same children,
+	// and so proxy IDs must be less than 2^31
+	constexpr uint32_t s_buildLeafFlag = uint32_t( 1 ) << 31;
+	// Centroids are sorted into this many bins along an axis to find where to split
+	constexpr unsigned int s_buildBinCount = 16;
+
+	// A tree with fewer proxies than this is rebuilt immediately rather than in the background
+	constexpr uint32_t s_minimumProxyCount_backgroundBuild = 1024;
+	// The tree is rebuilt when its cost has increased this much since it was built
+	constexpr float s_maximumCostIncrease = 1.5f;
+
+	sAabb Union( const sAabb& i_lhs, const sAabb& i_rhs );
+	sAabb Enlarge( const sAabb& i_aabb, const float i_margin );
+	bool Contains( const sAabb& i_outer, const sAabb& i_inner );
+	bool Overlaps( const sAabb& i_lhs, const sAabb& i_rhs );
+	float GetSurfaceArea( const sAabb& i_aabb );
+	float GetComponent( const eae6320::Math::sVector& i_vector, const unsigned int i_axis );
+	// Returns true if the box is completely behind the plane
+	// and sets o_isInside if it is completely in front of it
+	bool IsOutside( const sAabb& i_aabb, const float ( &i_plane )[4], bool& o_isInside );
+	// Returns true if the ray enters the box before i_maximumDistance,
+	// and o_distance is where it enters (or zero if the origin is inside)
+	bool IntersectRay( const sAabb& i_aabb, const eae6320::Math::sVector& i_origin, const eae6320::Math::sVector& i_direction_inverse,
+		const float i_maximumDistance, float& o_distance );
+}
+
+// Interface
+//==========
+
+// Proxies
+//--------
+
+uint32_t eae6320::Runtime::cBoundingVolumeHierarchy::CreateProxy( const sAabb& i_aabb, void* const i_userData )
+{
+	const auto proxyId = AllocateNode();
+	if ( proxyId >= s_buildLeafFlag )
+	{
+		EAE6320_ASSERTF( false, "A bounding volume hierarchy can't have more than 2^31 nodes" );
+		Logging::OutputError( "A bounding volume hierarchy proxy couldn't be created because there are too many nodes" );
+		FreeNode( proxyId );
+		return s_invalidProxyId;
+	}
+	{
+		auto& node = m_nodes[proxyId];
+		node.aabb = Enlarge( i_aabb, m_aabbMargin );
+		node.height = 0;
+		auto& proxy = m_proxies[proxyId];
+		proxy.aabb = i_aabb;
+		proxy.userData = i_userData;
+	}
+	InsertLeaf( proxyId );
+	++m_proxyCount;
+	++m_refitCount_sinceLastMeasurement;
+	m_hasBuildBeenInvalidated = m_isBuildInProgress;
+	return proxyId;
+}
+
+void eae6320::Runtime::cBoundingVolumeHierarchy::DestroyProxy( const uint32_t i_proxyId )
+{
+	EAE6320_ASSERT( ( i_proxyId < m_nodes.size() ) && ( m_nodes[i_proxyId].height == 0 ) );
+	RemoveLeaf( i_proxyId );
+	FreeNode( i_proxyId );
+	m_proxies[i_proxyId] = sProxy();
+	--m_proxyCount;
+	m_hasBuildBeenInvalidated = m_isBuildInProgress;
+}
+
+bool eae6320::Runtime::cBoundingVolumeHierarchy::MoveProxy( const uint32_t i_proxyId, const sAabb& i_aabb )
+{
+	EAE6320_ASSERT( ( i_proxyId < m_nodes.size() ) && ( m_nodes[i_proxyId].height == 0 ) );
+	m_proxies[i_proxyId].aabb = i_aabb;
+	auto& node = m_nodes[i_proxyId];
+	if ( Contains( node.aabb, i_aabb ) )
+	{
+		return false;
+	}
+	node.aabb = Enlarge( i_aabb, m_aabbMargin );
+	RefitAncestors( node.parent );
+	++m_refitCount_sinceLastMeasurement;
+	return true;
+}
+
+void* eae6320::Runtime::cBoundingVolumeHierarchy::GetUserData( const uint32_t i_proxyId ) const
+{
+	EAE6320_ASSERT( ( i_proxyId < m_nodes.size() ) && ( m_nodes[i_proxyId].height == 0 ) );
+	return m_proxies[i_proxyId].userData;
+}
+
+const eae6320::Runtime::cBoundingVolumeHierarchy::sAabb& eae6320::Runtime::cBoundingVolumeHierarchy::GetAabb( const uint32_t i_proxyId ) const
+{
+	EAE6320_ASSERT( ( i_proxyId < m_nodes.size() ) && ( m_nodes[i_proxyId].height == 0 ) );
+	return m_proxies[i_proxyId].aabb;
+}
+
+// Maintenance
+//------------
+
+void eae6320::Runtime::cBoundingVolumeHierarchy::Update()
+{
+	if ( m_isBuildInProgress )
+	{
+		const auto result = WaitForThreadToStop( m_buildThread, 0 );
+		if ( result == Results::TimeOut )
+		{
+			return;
+		}
+		m_isBuildInProgress = false;
+		if ( result && !m_hasBuildBeenInvalidated )
+		{
+			ReplaceTreeWithBuild();
+		}
+		else
+		{
+			// Measure the tree again during the next update
+			m_refitCount_sinceLastMeasurement = m_proxyCount;
+		}
+		m_hasBuildBeenInvalidated = false;
+		return;
+	}
+
+	// Measuring the cost visits every node,
+	// and so it is only done after a significant fraction of the proxies have been refit
+	if ( ( m_refitCount_sinceLastMeasurement == 0 ) || ( m_refitCount_sinceLastMeasurement < ( m_proxyCount / 8 ) ) )
+	{
+		return;
+	}
+	m_refitCount_sinceLastMeasurement = 0;
+	if ( GetCost() <= ( m_cost_afterBuild * s_maximumCostIncrease ) )
+	{
+		return;
+	}
+	if ( m_proxyCount < s_minimumProxyCount_backgroundBuild )
+	{
+		Rebuild();
+		return;
+	}
+	PrepareBuild();
+	if ( m_buildThread.Start( BuildInBackground, this ) )
+	{
+		m_isBuildInProgress = true;
+	}
+	else
+	{
+		EAE6320_ASSERTF( false, "The bounding volume hierarchy couldn't start a background build" );
+		Logging::OutputError( "The bounding volume hierarchy couldn't start a background build and will be rebuilt immediately instead" );
+		Build( m_build_primitives, m_build_nodes, m_build_root, m_build_cost );
+		ReplaceTreeWithBuild();
+	}
+}
+
+void eae6320::Runtime::cBoundingVolumeHierarchy::Rebuild()
+{
+	if ( m_isBuildInProgress )
+	{
+		WaitForThreadToStop( m_buildThread );
+		m_isBuildInProgress = false;
+		m_hasBuildBeenInvalidated = false;
+	}
+	PrepareBuild();
+	Build( m_build_primitives, m_build_nodes, m_build_root, m_build_cost );
+	ReplaceTreeWithBuild();
+}
+
+float eae6320::Runtime::cBoundingVolumeHierarchy::GetCost() const
+{
+	if ( ( m_root == s_nullNode ) || m_nodes[m_root].IsLeaf() )
+	{
+		return 0.0f;
+	}
+	float surfaceArea_internal = 0.0f;
+	for ( const auto& node : m_nodes )
+	{
+		if ( node.height > 0 )
+		{
+			surfaceArea_internal += GetSurfaceArea( node.aabb );
+		}
+	}
+	const auto surfaceArea_root = GetSurfaceArea( m_nodes[m_root].aabb );
+	return ( surfaceArea_root > 0.0f ) ? ( surfaceArea_internal / surfaceArea_root ) : 0.0f;
+}
+
+// Queries
+//--------
+
+void eae6320::Runtime::cBoundingVolumeHierarchy::QueryFrustum( const float ( &i_planes )[6][4], std::vector<uint32_t>& o_proxyIds ) const
+{
+	if ( m_root == s_nullNode )
+	{
+		return;
+	}
+	// Each entry remembers which planes the node still has to be tested against
+	// (if a node is completely in front of a plane then so are all of its descendants)
+	constexpr uint8_t planeMask_all = ( 1 << 6 ) - 1;
+	struct sEntry { uint32_t nodeIndex; uint8_t planeMask; };
+	std::vector<sEntry> stack;
+	stack.reserve( 64 );
+	stack.push_back( { m_root, planeMask_all } );
+	while ( !stack.empty() )
+	{
+		const auto entry = stack.back();
+		stack.pop_back();
+		const auto& node = m_nodes[entry.nodeIndex];
+		const auto& aabb = node.IsLeaf() ? m_proxies[entry.nodeIndex].aabb : node.aabb;
+		auto planeMask = entry.planeMask;
+		auto isOutside = false;
+		for ( unsigned int i = 0; ( i < 6 ) && !isOutside; ++i )
+		{
+			if ( planeMask & ( 1 << i ) )
+			{
+				bool isInside;
+				isOutside = IsOutside( aabb, i_planes[i], isInside );
+				if ( isInside )
+				{
+					planeMask &= ~( 1 << i );
+				}
+			}
+		}
+		if ( isOutside )
+		{
+			continue;
+		}
+		if ( node.IsLeaf() )
+		{
+			o_proxyIds.push_back( entry.nodeIndex );
+		}
+		else
+		{
+			stack.push_back( { node.children[0], planeMask } );
+			stack.push_back( { node.children[1], planeMask } );
+		}
+	}
+}
+
+void eae6320::Runtime::cBoundingVolumeHierarchy::QuerySphere( const Math::sVector& i_center, const float i_radius, std::vector<uint32_t>& o_proxyIds ) const
+{
+	if ( m_root == s_nullNode )
+	{
+		return;
+	}
+	const auto radiusSquared = i_radius * i_radius;
+	const auto IsOverlapping = [&i_center, radiusSquared]( const sAabb& i_aabb )
+	{
+		// The closest point in the box to the center of the sphere
+		const Math::sVector closestPoint(
+			std::min( std::max( i_center.x, i_aabb.minimum.x ), i_aabb.maximum.x ),
+			std::min( std::max( i_center.y, i_aabb.minimum.y ), i_aabb.maximum.y ),
+			std::min( std::max( i_center.z, i_aabb.minimum.z ), i_aabb.maximum.z ) );
+		const auto offset = closestPoint - i_center;
+		return Dot( offset, offset ) <= radiusSquared;
+	};
+	std::vector<uint32_t> stack;
+	stack.reserve( 64 );
+	stack.push_back( m_root );
+	while ( !stack.empty() )
+	{
+		const auto nodeIndex = stack.back();
+		stack.pop_back();
+		const auto& node = m_nodes[nodeIndex];
+		if ( node.IsLeaf() )
+		{
+			if ( IsOverlapping( m_proxies[nodeIndex].aabb ) )
+			{
+				o_proxyIds.push_back( nodeIndex );
+			}
+		}
+		else if ( IsOverlapping( node.aabb ) )
+		{
+			stack.push_back( node.children[0] );
+			stack.push_back( node.children[1] );
+		}
+	}
+}
+
+void eae6320::Runtime::cBoundingVolumeHierarchy::QueryAabb( const sAabb& i_aabb, std::vector<uint32_t>& o_proxyIds ) const
+{
+	if ( m_root == s_nullNode )
+	{
+		return;
+	}
+	std::vector<uint32_t> stack;
+	stack.reserve( 64 );
+	stack.push_back( m_root );
+	while ( !stack.empty() )
+	{
+		const auto nodeIndex = stack.back();
+		stack.pop_back();
+		const auto& node = m_nodes[nodeIndex];
+		if ( node.IsLeaf() )
+		{
+			if ( Overlaps( m_proxies[nodeIndex].aabb, i_aabb ) )
+			{
+				o_proxyIds.push_back( nodeIndex );
+			}
+		}
+		else if ( Overlaps( node.aabb, i_aabb ) )
+		{
+			stack.push_back( node.children[0] );
+			stack.push_back( node.children[1] );
+		}
+	}
+}
+
+bool eae6320::Runtime::cBoundingVolumeHierarchy::RayCast( const Math::sVector& i_origin, const Math::sVector& i_direction, const float i_maximumDistance,
+	uint32_t& o_proxyId, float& o_distance ) const
+{
+	if ( m_root == s_nullNode )
+	{
+		return false;
+	}
+	// A direction component of zero results in an infinite inverse,
+	// which the slab test handles correctly
+	const Math::sVector direction_inverse( 1.0f / i_direction.x, 1.0f / i_direction.y, 1.0f / i_direction.z );
+	auto closestDistance = i_maximumDistance;
+	auto closestProxyId = s_invalidProxyId;
+	// Each entry remembers where the ray enters the node
+	// so that it can be skipped if something closer has been hit since it was pushed
+	struct sEntry { uint32_t nodeIndex; float distance; };
+	std::vector<sEntry> stack;
+	stack.reserve( 64 );
+	{
+		float distance;
+		if ( !IntersectRay( m_nodes[m_root].aabb, i_origin, direction_inverse, closestDistance, distance ) )
+		{
+			return false;
+		}
+		stack.push_back( { m_root, distance } );
+	}
+	while ( !stack.empty() )
+	{
+		const auto entry = stack.back();
+		stack.pop_back();
+		if ( entry.distance > closestDistance )
+		{
+			continue;
+		}
+		const auto& node = m_nodes[entry.nodeIndex];
+		if ( node.IsLeaf() )
+		{
+			float distance;
+			if ( IntersectRay( m_proxies[entry.nodeIndex].aabb, i_origin, direction_inverse, closestDistance, distance ) )
+			{
+				closestDistance = distance;
+				closestProxyId = entry.nodeIndex;
+			}
+			continue;
+		}
+		sEntry children[2];
+		bool isHit[2];
+		for ( unsigned int i = 0; i < 2; ++i )
+		{
+			children[i].nodeIndex = node.children[i];
+			isHit[i] = IntersectRay( m_nodes[node.children[i]].aabb, i_origin, direction_inverse, closestDistance, children[i].distance );
+		}
+		// The closer child is pushed last so that it is visited first,
+		// which makes it more likely that the farther child can be skipped
+		const unsigned int closerIndex = ( isHit[0] && isHit[1] && ( children[1].distance < children[0].distance ) ) ? 1 : 0;
+		const auto fartherIndex = 1 - closerIndex;
+		if ( isHit[fartherIndex] )
+		{
+			stack.push_back( children[fartherIndex] );
+		}
+		if ( isHit[closerIndex] )
+		{
+			stack.push_back( children[closerIndex] );
+		}
+	}
+	if ( closestProxyId == s_invalidProxyId )
+	{
+		return false;
+	}
+	o_proxyId = closestProxyId;
+	o_distance = closestDistance;
+	return true;
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::Runtime::cBoundingVolumeHierarchy::cBoundingVolumeHierarchy( const float i_aabbMargin )
+	:
+	m_aabbMargin( i_aabbMargin )
+{
+	EAE6320_ASSERT( i_aabbMargin >= 0.0f );
+}
+
+eae6320::Runtime::cBoundingVolumeHierarchy::~cBoundingVolumeHierarchy()
+{
+	if ( m_isBuildInProgress )
+	{
+		WaitForThreadToStop( m_buildThread );
+		m_isBuildInProgress = false;
+	}
+}
+
+// Implementation
+//===============
+
+// Nodes
+//------
+
+uint32_t eae6320::Runtime::cBoundingVolumeHierarchy::AllocateNode()
+{
+	uint32_t nodeIndex;
+	if ( m_freeList != s_nullNode )
+	{
+		nodeIndex = m_freeList;
+		m_freeList = m_nodes[nodeIndex].parent;
+	}
+	else
+	{
+		nodeIndex = static_cast<uint32_t>( m_nodes.size() );
+		m_nodes.emplace_back();
+		m_proxies.emplace_back();
+	}
+	auto& node = m_nodes[nodeIndex];
+	node.parent = s_nullNode;
+	node.children[0] = node.children[1] = s_nullNode;
+	node.height = 0;
+	return nodeIndex;
+}
+
+void eae6320::Runtime::cBoundingVolumeHierarchy::FreeNode( const uint32_t i_nodeIndex )
+{
+	auto& node = m_nodes[i_nodeIndex];
+	node.parent = m_freeList;
+	node.children[0] = node.children[1] = s_nullNode;
+	node.height = -1;
+	m_freeList = i_nodeIndex;
+}
+
+void eae6320::Runtime::cBoundingVolumeHierarchy::InsertLeaf( const uint32_t i_leafIndex )
+{
+	if ( m_root == s_nullNode )
+	{
+		m_root = i_leafIndex;
+		m_nodes[i_leafIndex].parent = s_nullNode;
+		return;
+	}
+
+	// Descend to the sibling that increases the surface area of the tree the least
+	// (Catto's "Dynamic Bounding Volume Hierarchies")
+	const auto aabb_leaf = m_nodes[i_leafIndex].aabb;
+	auto siblingIndex = m_root;
+	while ( !m_nodes[siblingIndex].IsLeaf() )
+	{
+		const auto& node = m_nodes[siblingIndex];
+		const auto surfaceArea = GetSurfaceArea( node.aabb );
+		const auto surfaceArea_combined = GetSurfaceArea( Union( node.aabb, aabb_leaf ) );
+		// The cost of making the leaf and this node siblings
+		const auto cost_here = 2.0f * surfaceArea_combined;
+		// Every ancestor of the leaf's new parent grows
+		const auto cost_inherited = 2.0f * ( surfaceArea_combined - surfaceArea );
+		float costs_child[2];
+		for ( unsigned int i = 0; i < 2; ++i )
+		{
+			const auto& child = m_nodes[node.children[i]];
+			const auto surfaceArea_child = GetSurfaceArea( Union( child.aabb, aabb_leaf ) );
+			costs_child[i] = ( child.IsLeaf() ? surfaceArea_child : ( surfaceArea_child - GetSurfaceArea( child.aabb ) ) ) + cost_inherited;
+		}
+		if ( ( cost_here < costs_child[0] ) && ( cost_here < costs_child[1] ) )
+		{
+			break;
+		}
+		siblingIndex = node.children[( costs_child[0] < costs_child[1] ) ? 0 : 1];
+	}
+
+	// Replace the sibling with a new parent of both nodes
+	const auto parentIndex_new = AllocateNode();
+	const auto parentIndex_old = m_nodes[siblingIndex].parent;
+	{
+		auto& parent = m_nodes[parentIndex_new];
+		parent.parent = parentIndex_old;
+		parent.aabb = Union( aabb_leaf, m_nodes[siblingIndex].aabb );
+		parent.height = m_nodes[siblingIndex].height + 1;
+		parent.children[0] = siblingIndex;
+		parent.children[1] = i_leafIndex;
+	}
+	if ( parentIndex_old != s_nullNode )
+	{
+		auto& parent_old = m_nodes[parentIndex_old];
+		parent_old.children[( parent_old.children[0] == siblingIndex ) ? 0 : 1] = parentIndex_new;
+	}
+	else
+	{
+		m_root = parentIndex_new;
+	}
+	m_nodes[siblingIndex].parent = parentIndex_new;
+	m_nodes[i_leafIndex].parent = parentIndex_new;
+
+	RefitAncestors( parentIndex_old );
+}
+
+void eae6320::Runtime::cBoundingVolumeHierarchy::RemoveLeaf( const uint32_t i_leafIndex )
+{
+	if ( i_leafIndex == m_root )
+	{
+		m_root = s_nullNode;
+		return;
+	}
+
+	// The leaf's sibling replaces their parent
+	const auto parentIndex = m_nodes[i_leafIndex].parent;
+	const auto& parent = m_nodes[parentIndex];
+	const auto grandparentIndex = parent.parent;
+	const auto siblingIndex = parent.children[( parent.children[0] == i_leafIndex ) ? 1 : 0];
+	if ( grandparentIndex != s_nullNode )
+	{
+		auto& grandparent = m_nodes[grandparentIndex];
+		grandparent.children[( grandparent.children[0] == parentIndex ) ? 0 : 1] = siblingIndex;
+		m_nodes[siblingIndex].parent = grandparentIndex;
+		FreeNode( parentIndex );
+		RefitAncestors( grandparentIndex );
+	}
+	else
+	{
+		m_root = siblingIndex;
+		m_nodes[siblingIndex].parent = s_nullNode;
+		FreeNode( parentIndex );
+	}
+	m_nodes[i_leafIndex].parent = s_nullNode;
+}
+
+void eae6320::Runtime::cBoundingVolumeHierarchy::RefitAncestors( uint32_t i_nodeIndex )
+{
+	while ( i_nodeIndex != s_nullNode )
+	{
+		auto& node = m_nodes[i_nodeIndex];
+		const auto& child_0 = m_nodes[node.children[0]];
+		const auto& child_1 = m_nodes[node.children[1]];
+		node.aabb = Union( child_0.aabb, child_1.aabb );
+		node.height = 1 + std::max( child_0.height, child_1.height );
+		i_nodeIndex = node.parent;
+	}
+}
+
+// Building
+//---------
+
+void eae6320::Runtime::cBoundingVolumeHierarchy::PrepareBuild()
+{
+	m_build_primitives.clear();
+	m_build_primitives.reserve( m_proxyCount );
+	for ( uint32_t i = 0; i < static_cast<uint32_t>( m_nodes.size() ); ++i )
+	{
+		if ( m_nodes[i].height == 0 )
+		{
+			m_build_primitives.push_back( { m_nodes[i].aabb, i } );
+		}
+	}
+}
+
+void eae6320::Runtime::cBoundingVolumeHierarchy::Build( std::vector<sBuildPrimitive>& io_primitives, std::vector<sBuildNode>& o_nodes, uint32_t& o_root, float& o_cost )
+{
+	// The tree is built from the top down,
+	// splitting each range of primitives where the surface area heuristic is lowest
+	// (Wald's "On fast Construction of SAH-based Bounding Volume Hierarchies").
+	// Children are always created after their parents,
+	// which ReplaceTreeWithBuild() depends on
+	o_nodes.clear();
+	o_root = s_nullNode;
+	o_cost = 0.0f;
+	if ( io_primitives.empty() )
+	{
+		return;
+	}
+	o_nodes.reserve( io_primitives.size() - 1 );
+
+	const auto GetCentroid = []( const sBuildPrimitive& i_primitive, const unsigned int i_axis )
+	{
+		// The centroid is doubled, which doesn't affect the splits
+		return GetComponent( i_primitive.aabb.minimum, i_axis ) + GetComponent( i_primitive.aabb.maximum, i_axis );
+	};
+	struct sRange { uint32_t begin, end, parentIndex, childIndex; };
+	std::vector<sRange> ranges;
+	ranges.push_back( { 0, static_cast<uint32_t>( io_primitives.size() ), s_nullNode, 0 } );
+	while ( !ranges.empty() )
+	{
+		const auto range = ranges.back();
+		ranges.pop_back();
+		uint32_t child;
+		if ( ( range.end - range.begin ) == 1 )
+		{
+			// Leaves refer to primitives until the tree has been measured
+			child = range.begin | s_buildLeafFlag;
+		}
+		else
+		{
+			auto* const primitives_begin = io_primitives.data() + range.begin;
+			auto* const primitives_end = io_primitives.data() + range.end;
+			const auto count = range.end - range.begin;
+
+			// Split along the axis where the centroids are the most spread out
+			float centroid_minimum[3] = { FLT_MAX, FLT_MAX, FLT_MAX }, centroid_maximum[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+			for ( auto* primitive = primitives_begin; primitive != primitives_end; ++primitive )
+			{
+				for ( unsigned int i = 0; i < 3; ++i )
+				{
+					const auto centroid = GetCentroid( *primitive, i );
+					centroid_minimum[i] = std::min( centroid_minimum[i], centroid );
+					centroid_maximum[i] = std::max( centroid_maximum[i], centroid );
+				}
+			}
+			unsigned int axis = 0;
+			for ( unsigned int i = 1; i < 3; ++i )
+			{
+				if ( ( centroid_maximum[i] - centroid_minimum[i] ) > ( centroid_maximum[axis] - centroid_minimum[axis] ) )
+				{
+					axis = i;
+				}
+			}
+			const auto extent = centroid_maximum[axis] - centroid_minimum[axis];
+
+			auto* primitives_split = primitives_begin + ( count / 2 );
+			auto isSplitFound = false;
+			if ( extent > 0.0f )
+			{
+				const auto binScale = static_cast<float>( s_buildBinCount ) / extent;
+				const auto GetBinIndex = [&]( const sBuildPrimitive& i_primitive )
+				{
+					const auto binIndex = static_cast<unsigned int>( ( GetCentroid( i_primitive, axis ) - centroid_minimum[axis] ) * binScale );
+					return std::min( binIndex, s_buildBinCount - 1 );
+				};
+				struct sBin { sAabb aabb; uint32_t count = 0; };
+				sBin bins[s_buildBinCount];
+				for ( auto* primitive = primitives_begin; primitive != primitives_end; ++primitive )
+				{
+					auto& bin = bins[GetBinIndex( *primitive )];
+					bin.aabb = ( bin.count == 0 ) ? primitive->aabb : Union( bin.aabb, primitive->aabb );
+					++bin.count;
+				}
+				// Sweep from the right to find the cost of everything after each split,
+				// and then from the left to find the cheapest split
+				float costs_right[s_buildBinCount] = {};
+				{
+					sAabb aabb;
+					uint32_t count_right = 0;
+					for ( auto i = s_buildBinCount - 1; i > 0; --i )
+					{
+						if ( bins[i].count > 0 )
+						{
+							aabb = ( count_right == 0 ) ? bins[i].aabb : Union( aabb, bins[i].aabb );
+							count_right += bins[i].count;
+						}
+						costs_right[i] = ( count_right > 0 ) ? ( GetSurfaceArea( aabb ) * static_cast<float>( count_right ) ) : 0.0f;
+					}
+				}
+				auto cost_best = FLT_MAX;
+				unsigned int binIndex_split = 0;
+				{
+					sAabb aabb;
+					uint32_t count_left = 0;
+					for ( unsigned int i = 0; i < ( s_buildBinCount - 1 ); ++i )
+					{
+						if ( bins[i].count > 0 )
+						{
+							aabb = ( count_left == 0 ) ? bins[i].aabb : Union( aabb, bins[i].aabb );
+							count_left += bins[i].count;
+						}
+						if ( ( count_left > 0 ) && ( count_left < count ) )
+						{
+							const auto cost = ( GetSurfaceArea( aabb ) * static_cast<float>( count_left ) ) + costs_right[i + 1];
+							if ( cost < cost_best )
+							{
+								cost_best = cost;
+								binIndex_split = i;
+							}
+						}
+					}
+				}
+				if ( cost_best < FLT_MAX )
+				{
+					primitives_split = std::partition( primitives_begin, primitives_end,
+						[&GetBinIndex, binIndex_split]( const sBuildPrimitive& i_primitive ) { return GetBinIndex( i_primitive ) <= binIndex_split; } );
+					isSplitFound = ( primitives_split != primitives_begin ) && ( primitives_split != primitives_end );
+				}
+			}
+			if ( !isSplitFound )
+			{
+				// If the centroids can't be separated then the range is split in half
+				primitives_split = primitives_begin + ( count / 2 );
+				std::nth_element( primitives_begin, primitives_split, primitives_end,
+					[&GetCentroid, axis]( const sBuildPrimitive& i_lhs, const sBuildPrimitive& i_rhs ) { return GetCentroid( i_lhs, axis ) < GetCentroid( i_rhs, axis ); } );
+			}
+
+			child = static_cast<uint32_t>( o_nodes.size() );
+			o_nodes.push_back( { { s_nullNode, s_nullNode } } );
+			const auto split = range.begin + static_cast<uint32_t>( primitives_split - primitives_begin );
+			ranges.push_back( { range.begin, split, child, 0 } );
+			ranges.push_back( { split, range.end, child, 1 } );
+		}
+		if ( range.parentIndex != s_nullNode )
+		{
+			o_nodes[range.parentIndex].children[range.childIndex] = child;
+		}
+		else
+		{
+			o_root = child;
+		}
+	}
+
+	// The cost is measured with the boxes that the tree was built from
+	// (a background build is refit with newer boxes when it replaces the old tree,
+	// but using those would mean that the cost of moved proxies becomes part of the baseline)
+	{
+		const auto nodeCount = static_cast<uint32_t>( o_nodes.size() );
+		std::vector<sAabb> aabbs( nodeCount );
+		float surfaceArea_internal = 0.0f;
+		for ( auto i = nodeCount; i > 0; --i )
+		{
+			auto& node = o_nodes[i - 1];
+			sAabb aabbs_children[2];
+			for ( unsigned int j = 0; j < 2; ++j )
+			{
+				auto& child = node.children[j];
+				if ( child & s_buildLeafFlag )
+				{
+					const auto& primitive = io_primitives[child & ~s_buildLeafFlag];
+					aabbs_children[j] = primitive.aabb;
+					child = primitive.proxyId | s_buildLeafFlag;
+				}
+				else
+				{
+					aabbs_children[j] = aabbs[child];
+				}
+			}
+			aabbs[i - 1] = Union( aabbs_children[0], aabbs_children[1] );
+			surfaceArea_internal += GetSurfaceArea( aabbs[i - 1] );
+		}
+		if ( o_root & s_buildLeafFlag )
+		{
+			o_root = io_primitives[o_root & ~s_buildLeafFlag].proxyId | s_buildLeafFlag;
+			o_cost = 0.0f;
+		}
+		else
+		{
+			const auto surfaceArea_root = GetSurfaceArea( aabbs[o_root] );
+			o_cost = ( surfaceArea_root > 0.0f ) ? ( surfaceArea_internal / surfaceArea_root ) : 0.0f;
+		}
+	}
+}
+
+void eae6320::Runtime::cBoundingVolumeHierarchy::BuildInBackground( void* const io_hierarchy )
+{
+	auto& hierarchy = *static_cast<cBoundingVolumeHierarchy*>( io_hierarchy );
+	Build( hierarchy.m_build_primitives, hierarchy.m_build_nodes, hierarchy.m_build_root, hierarchy.m_build_cost );
+}
+
+void eae6320::Runtime::cBoundingVolumeHierarchy::ReplaceTreeWithBuild()
+{
+	// The leaves are kept, but every internal node is replaced
+	for ( uint32_t i = 0; i < static_cast<uint32_t>( m_nodes.size() ); ++i )
+	{
+		if ( m_nodes[i].height > 0 )
+		{
+			FreeNode( i );
+		}
+	}
+	if ( m_build_root == s_nullNode )
+	{
+		m_root = s_nullNode;
+	}
+	else if ( m_build_root & s_buildLeafFlag )
+	{
+		m_root = m_build_root & ~s_buildLeafFlag;
+		m_nodes[m_root].parent = s_nullNode;
+	}
+	else
+	{
+		// Every node is allocated before any are referenced
+		// because allocating can move the existing nodes
+		const auto buildNodeCount = static_cast<uint32_t>( m_build_nodes.size() );
+		std::vector<uint32_t> nodeIndices( buildNodeCount );
+		for ( auto& nodeIndex : nodeIndices )
+		{
+			nodeIndex = AllocateNode();
+		}
+		for ( uint32_t i = 0; i < buildNodeCount; ++i )
+		{
+			auto& node = m_nodes[nodeIndices[i]];
+			for ( unsigned int j = 0; j < 2; ++j )
+			{
+				const auto child = m_build_nodes[i].children[j];
+				const auto childIndex = ( child & s_buildLeafFlag ) ? ( child & ~s_buildLeafFlag ) : nodeIndices[child];
+				node.children[j] = childIndex;
+				m_nodes[childIndex].parent = nodeIndices[i];
+			}
+		}
+		m_root = nodeIndices[m_build_root];
+		m_nodes[m_root].parent = s_nullNode;
+		// Children always come after their parents,
+		// and so refitting in reverse order visits every child before its parent.
+		// The leaves' current boxes are used, and so proxies that moved during a background build are accounted for
+		for ( auto i = buildNodeCount; i > 0; --i )
+		{
+			auto& node = m_nodes[nodeIndices[i - 1]];
+			const auto& child_0 = m_nodes[node.children[0]];
+			const auto& child_1 = m_nodes[node.children[1]];
+			node.aabb = Union( child_0.aabb, child_1.aabb );
+			node.height = 1 + std::max( child_0.height, child_1.height );
+		}
+	}
+	m_build_primitives.clear();
+	m_build_nodes.clear();
+	m_build_root = s_nullNode;
+
+	m_cost_afterBuild = m_build_cost;
+	m_refitCount_sinceLastMeasurement = 0;
+}
+
+// Benchmark
+//----------
+
+#ifdef EAE6320_RUNTIME_ISBVHBENCHMARKENABLED
+
+void eae6320::Runtime::cBoundingVolumeHierarchy::RunBenchmark()
+{
+	constexpr uint32_t objectCount = 100000;
+	constexpr unsigned int frustumCount = 64, rayCount = 1024, sphereCount = 1024, moveFrameCount = 8;
+	constexpr float worldSize = 1000.0f;
+
+	// A fixed LCG makes the results comparable between runs
+	uint32_t randomState = 6320;
+	const auto GetRandom = [&randomState]( const float i_minimum, const float i_maximum )
+	{
+		randomState = ( randomState * 1664525u ) + 1013904223u;
+		return i_minimum + ( ( i_maximum - i_minimum ) * ( static_cast<float>( randomState >> 8 ) / static_cast<float>( 1 << 24 ) ) );
+	};
+	const auto GetRandomPosition = [&GetRandom]( const float i_extent )
+	{
+		return Math::sVector( GetRandom( -i_extent, i_extent ), GetRandom( -i_extent, i_extent ), GetRandom( -i_extent, i_extent ) );
+	};
+	const auto GetRandomDirection = [&GetRandomPosition]()
+	{
+		auto direction = GetRandomPosition( 1.0f );
+		while ( Dot( direction, direction ) < 1.0e-4f )
+		{
+			direction = GetRandomPosition( 1.0f );
+		}
+		return direction.GetNormalized();
+	};
+	const auto GetMilliseconds = []( const uint64_t i_tickCount )
+	{
+		return Time::ConvertTicksToSeconds( i_tickCount ) * 1000.0;
+	};
+
+	// Brute force tests every object's box
+	std::vector<sAabb> aabbs( objectCount );
+	const auto CreateAabb = [&GetRandom]( const Math::sVector& i_center )
+	{
+		const Math::sVector extents( GetRandom( 0.5f, 2.5f ), GetRandom( 0.5f, 2.5f ), GetRandom( 0.5f, 2.5f ) );
+		return sAabb{ i_center - extents, i_center + extents };
+	};
+	for ( auto& aabb : aabbs )
+	{
+		aabb = CreateAabb( GetRandomPosition( worldSize * 0.5f ) );
+	}
+
+	Logging::OutputMessage( "Bounding volume hierarchy benchmark (%u objects):", objectCount );
+	cBoundingVolumeHierarchy hierarchy;
+	std::vector<uint32_t> proxyIds( objectCount );
+	{
+		const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+		for ( uint32_t i = 0; i < objectCount; ++i )
+		{
+			proxyIds[i] = hierarchy.CreateProxy( aabbs[i], nullptr );
+		}
+		const auto tickCount_inserted = Time::GetCurrentSystemTimeTickCount();
+		const auto cost_inserted = hierarchy.GetCost();
+		hierarchy.Rebuild();
+		const auto tickCount_built = Time::GetCurrentSystemTimeTickCount();
+		Logging::OutputMessage( "\tInsertion: %.3f ms (cost %.1f), rebuild: %.3f ms (cost %.1f)",
+			GetMilliseconds( tickCount_inserted - tickCount_start ), cost_inserted,
+			GetMilliseconds( tickCount_built - tickCount_inserted ), hierarchy.GetCost() );
+	}
+
+	std::vector<uint32_t> results;
+	results.reserve( objectCount );
+	const auto Compare = [&GetMilliseconds]( const char* const i_queryName, const unsigned int i_queryCount,
+		const uint64_t i_tickCount_hierarchy, const uint64_t i_tickCount_bruteForce, const size_t i_resultCount_hierarchy, const size_t i_resultCount_bruteForce )
+	{
+		Logging::OutputMessage( "\t%s: %.4f ms per query (brute force %.4f ms), %u results (brute force %u)",
+			i_queryName, GetMilliseconds( i_tickCount_hierarchy ) / i_queryCount, GetMilliseconds( i_tickCount_bruteForce ) / i_queryCount,
+			static_cast<unsigned int>( i_resultCount_hierarchy ), static_cast<unsigned int>( i_resultCount_bruteForce ) );
+		EAE6320_ASSERTF( i_resultCount_hierarchy == i_resultCount_bruteForce, "The bounding volume hierarchy's %s query found different results than brute force", i_queryName );
+	};
+
+	// Frustum
+	{
+		Graphics::cFrustumCuller frustumCuller;
+		const auto transform_cameraToProjected = Math::cMatrix_transformation::CreateCameraToProjectedTransform_perspective(
+			Math::ConvertDegreesToRadians( 45.0f ), 16.0f / 9.0f, 0.1f, 200.0f );
+		uint64_t tickCount_hierarchy = 0, tickCount_bruteForce = 0;
+		size_t resultCount_hierarchy = 0, resultCount_bruteForce = 0;
+		for ( unsigned int i = 0; i < frustumCount; ++i )
+		{
+			const Math::cQuaternion orientation( GetRandom( 0.0f, 6.2831853f ), GetRandomDirection() );
+			frustumCuller.SetFrustum( Math::cMatrix_transformation::CreateWorldToCameraTransform( orientation, GetRandomPosition( worldSize * 0.5f ) ),
+				transform_cameraToProjected );
+			const auto& planes = frustumCuller.GetPlanes();
+
+			results.clear();
+			auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+			hierarchy.QueryFrustum( planes, results );
+			tickCount_hierarchy += Time::GetCurrentSystemTimeTickCount() - tickCount_start;
+			resultCount_hierarchy += results.size();
+
+			results.clear();
+			tickCount_start = Time::GetCurrentSystemTimeTickCount();
+			for ( uint32_t j = 0; j < objectCount; ++j )
+			{
+				auto isOutside = false;
+				for ( unsigned int k = 0; ( k < 6 ) && !isOutside; ++k )
+				{
+					bool isInside;
+					isOutside = IsOutside( aabbs[j], planes[k], isInside );
+				}
+				if ( !isOutside )
+				{
+					results.push_back( j );
+				}
+			}
+			tickCount_bruteForce += Time::GetCurrentSystemTimeTickCount() - tickCount_start;
+			resultCount_bruteForce += results.size();
+		}
+		Compare( "Frustum", frustumCount, tickCount_hierarchy, tickCount_bruteForce, resultCount_hierarchy, resultCount_bruteForce );
+	}
+	// Sphere
+	{
+		uint64_t tickCount_hierarchy = 0, tickCount_bruteForce = 0;
+		size_t resultCount_hierarchy = 0, resultCount_bruteForce = 0;
+		for ( unsigned int i = 0; i < sphereCount; ++i )
+		{
+			const auto center = GetRandomPosition( worldSize * 0.5f );
+			const auto radius = GetRandom( 5.0f, 50.0f );
+
+			results.clear();
+			auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+			hierarchy.QuerySphere( center, radius, results );
+			tickCount_hierarchy += Time::GetCurrentSystemTimeTickCount() - tickCount_start;
+			resultCount_hierarchy += results.size();
+
+			results.clear();
+			tickCount_start = Time::GetCurrentSystemTimeTickCount();
+			for ( uint32_t j = 0; j < objectCount; ++j )
+			{
+				const auto& aabb = aabbs[j];
+				const Math::sVector closestPoint(
+					std::min( std::max( center.x, aabb.minimum.x ), aabb.maximum.x ),
+					std::min( std::max( center.y, aabb.minimum.y ), aabb.maximum.y ),
+					std::min( std::max( center.z, aabb.minimum.z ), aabb.maximum.z ) );
+				const auto offset = closestPoint - center;
+				if ( Dot( offset, offset ) <= ( radius * radius ) )
+				{
+					results.push_back( j );
+				}
+			}
+			tickCount_bruteForce += Time::GetCurrentSystemTimeTickCount() - tickCount_start;
+			resultCount_bruteForce += results.size();
+		}
+		Compare( "Sphere", sphereCount, tickCount_hierarchy, tickCount_bruteForce, resultCount_hierarchy, resultCount_bruteForce );
+	}
+	// Ray
+	{
+		uint64_t tickCount_hierarchy = 0, tickCount_bruteForce = 0;
+		size_t hitCount_hierarchy = 0, hitCount_bruteForce = 0;
+		for ( unsigned int i = 0; i < rayCount; ++i )
+		{
+			const auto origin = GetRandomPosition( worldSize * 0.5f );
+			const auto direction = GetRandomDirection();
+			const auto maximumDistance = worldSize;
+
+			auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+			uint32_t proxyId;
+			float distance_hierarchy;
+			const auto isHit_hierarchy = hierarchy.RayCast( origin, direction, maximumDistance, proxyId, distance_hierarchy );
+			tickCount_hierarchy += Time::GetCurrentSystemTimeTickCount() - tickCount_start;
+			hitCount_hierarchy += isHit_hierarchy ? 1 : 0;
+
+			tickCount_start = Time::GetCurrentSystemTimeTickCount();
+			const Math::sVector direction_inverse( 1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z );
+			auto distance_bruteForce = maximumDistance;
+			auto isHit_bruteForce = false;
+			for ( uint32_t j = 0; j < objectCount; ++j )
+			{
+				float distance;
+				if ( IntersectRay( aabbs[j], origin, direction_inverse, distance_bruteForce, distance ) )
+				{
+					distance_bruteForce = distance;
+					isHit_bruteForce = true;
+				}
+			}
+			tickCount_bruteForce += Time::GetCurrentSystemTimeTickCount() - tickCount_start;
+			hitCount_bruteForce += isHit_bruteForce ? 1 : 0;
+			EAE6320_ASSERT( ( isHit_hierarchy == isHit_bruteForce ) && ( !isHit_hierarchy || ( distance_hierarchy == distance_bruteForce ) ) );
+		}
+		Compare( "Ray", rayCount, tickCount_hierarchy, tickCount_bruteForce, hitCount_hierarchy, hitCount_bruteForce );
+	}
+	// Movement
+	{
+		// A tenth of the objects move every frame,
+		// and the hierarchy rebuilds itself in the background when it has become worse enough
+		uint64_t tickCount_refit = 0;
+		for ( unsigned int i = 0; i < moveFrameCount; ++i )
+		{
+			const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+			for ( uint32_t j = i; j < objectCount; j += 10 )
+			{
+				const auto offset = GetRandomPosition( 5.0f );
+				aabbs[j] = sAabb{ aabbs[j].minimum + offset, aabbs[j].maximum + offset };
+				hierarchy.MoveProxy( proxyIds[j], aabbs[j] );
+			}
+			hierarchy.Update();
+			tickCount_refit += Time::GetCurrentSystemTimeTickCount() - tickCount_start;
+		}
+		const auto cost_refit = hierarchy.GetCost();
+		const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+		hierarchy.Rebuild();
+		Logging::OutputMessage( "\tMovement: %.3f ms per frame for %u objects (cost %.1f), rebuild: %.3f ms (cost %.1f)",
+			GetMilliseconds( tickCount_refit ) / moveFrameCount, objectCount / 10, cost_refit,
+			GetMilliseconds( Time::GetCurrentSystemTimeTickCount() - tickCount_start ), hierarchy.GetCost() );
+	}
+}
+
+#endif	// EAE6320_RUNTIME_ISBVHBENCHMARKENABLED
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	sAabb Union( const sAabb& i_lhs, const sAabb& i_rhs )
+	{
+		return sAabb{
+			eae6320::Math::sVector( std::min( i_lhs.minimum.x, i_rhs.minimum.x ), std::min( i_lhs.minimum.y, i_rhs.minimum.y ), std::min( i_lhs.minimum.z, i_rhs.minimum.z ) ),
+			eae6320::Math::sVector( std::max( i_lhs.maximum.x, i_rhs.maximum.x ), std::max( i_lhs.maximum.y, i_rhs.maximum.y ), std::max( i_lhs.maximum.z, i_rhs.maximum.z ) ) };
+	}
+
+	sAabb Enlarge( const sAabb& i_aabb, const float i_margin )
+	{
+		return sAabb{ i_aabb.minimum - i_margin, i_aabb.maximum + i_margin };
+	}
+
+	bool Contains( const sAabb& i_outer, const sAabb& i_inner )
+	{
+		return ( i_outer.minimum.x <= i_inner.minimum.x ) && ( i_outer.minimum.y <= i_inner.minimum.y ) && ( i_outer.minimum.z <= i_inner.minimum.z )
+			&& ( i_inner.maximum.x <= i_outer.maximum.x ) && ( i_inner.maximum.y <= i_outer.maximum.y ) && ( i_inner.maximum.z <= i_outer.maximum.z );
+	}
+
+	bool Overlaps( const sAabb& i_lhs, const sAabb& i_rhs )
+	{
+		return ( i_lhs.minimum.x <= i_rhs.maximum.x ) && ( i_lhs.minimum.y <= i_rhs.maximum.y ) && ( i_lhs.minimum.z <= i_rhs.maximum.z )
+			&& ( i_rhs.minimum.x <= i_lhs.maximum.x ) && ( i_rhs.minimum.y <= i_lhs.maximum.y ) && ( i_rhs.minimum.z <= i_lhs.maximum.z );
+	}
+
+	float GetSurfaceArea( const sAabb& i_aabb )
+	{
+		// Only relative areas matter, and so this is half of the actual surface area
+		const auto size = i_aabb.maximum - i_aabb.minimum;
+		return ( size.x * size.y ) + ( size.y * size.z ) + ( size.z * size.x );
+	}
+
+	float GetComponent( const eae6320::Math::sVector& i_vector, const unsigned int i_axis )
+	{
+		return ( i_axis == 0 ) ? i_vector.x : ( ( i_axis == 1 ) ? i_vector.y : i_vector.z );
+	}
+
+	bool IsOutside( const sAabb& i_aabb, const float ( &i_plane )[4], bool& o_isInside )
+	{
+		// The corner furthest in front of the plane and the corner furthest behind it
+		const auto& a = i_plane[0];
+		const auto& b = i_plane[1];
+		const auto& c = i_plane[2];
+		const auto& d = i_plane[3];
+		const auto distance_front = ( a * ( ( a >= 0.0f ) ? i_aabb.maximum.x : i_aabb.minimum.x ) )
+			+ ( b * ( ( b >= 0.0f ) ? i_aabb.maximum.y : i_aabb.minimum.y ) )
+			+ ( c * ( ( c >= 0.0f ) ? i_aabb.maximum.z : i_aabb.minimum.z ) ) + d;
+		const auto distance_back = ( a * ( ( a >= 0.0f ) ? i_aabb.minimum.x : i_aabb.maximum.x ) )
+			+ ( b * ( ( b >= 0.0f ) ? i_aabb.minimum.y : i_aabb.maximum.y ) )
+			+ ( c * ( ( c >= 0.0f ) ? i_aabb.minimum.z : i_aabb.maximum.z ) ) + d;
+		o_isInside = distance_back >= 0.0f;
+		return distance_front < 0.0f;
+	}
+
+	bool IntersectRay( const sAabb& i_aabb, const eae6320::Math::sVector& i_origin, const eae6320::Math::sVector& i_direction_inverse,
+		const float i_maximumDistance, float& o_distance )
+	{
+		// The ray is inside the box where it is between all three pairs of planes
+		// (Kay and Kajiya's "Ray Tracing Complex Scenes")
+		auto distance_enter = 0.0f;
+		auto distance_exit = i_maximumDistance;
+		for ( unsigned int i = 0; i < 3; ++i )
+		{
+			const auto origin = GetComponent( i_origin, i );
+			const auto direction_inverse = GetComponent( i_direction_inverse, i );
+			const auto distance_minimum = ( GetComponent( i_aabb.minimum, i ) - origin ) * direction_inverse;
+			const auto distance_maximum = ( GetComponent( i_aabb.maximum, i ) - origin ) * direction_inverse;
+			distance_enter = std::max( distance_enter, std::min( distance_minimum, distance_maximum ) );
+			distance_exit = std::min( distance_exit, std::max( distance_minimum, distance_maximum ) );
+		}
+		o_distance = distance_enter;
+		return distance_enter <= distance_exit;
+	}
+}
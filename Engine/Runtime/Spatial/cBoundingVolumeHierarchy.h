@@ -0,0 +1,195 @@
+/*
+	A bounding volume hierarchy is a binary tree of axis-aligned bounding boxes
+	that makes it possible to find the objects in a region of the scene
+	without testing every object
+
+	Each object is represented by a proxy (a leaf of the tree):
+		* A proxy's box is enlarged by a margin when it is stored in the tree,
+			and so small movements don't change the tree at all
+		* When a proxy moves outside of its enlarged box its ancestors are refit,
+			which is cheap but makes the tree worse over time
+		* When the tree has become worse enough it is rebuilt in a background thread
+			and the new tree replaces the old one during a later call to Update()
+*/
+
+#ifndef EAE6320_RUNTIME_CBOUNDINGVOLUMEHIERARCHY_H
+#define EAE6320_RUNTIME_CBOUNDINGVOLUMEHIERARCHY_H
+
+// Includes
+//=========
+
+#include <Engine/Concurrency/cThread.h>
+#include <Engine/Math/sVector.h>
+#include <Engine/Runtime/Configuration.h>
+
+#include <cstdint>
+#include <vector>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Runtime
+	{
+		class cBoundingVolumeHierarchy
+		{
+			// Interface
+			//==========
+
+		public:
+
+			struct sAabb
+			{
+				Math::sVector minimum;
+				Math::sVector maximum;
+			};
+
+			static constexpr uint32_t s_invalidProxyId = ~uint32_t( 0 );
+
+			// Proxies
+			//--------
+
+			// Returns s_invalidProxyId if the proxy couldn't be created
+			uint32_t CreateProxy( const sAabb& i_aabb, void* const i_userData );
+			void DestroyProxy( const uint32_t i_proxyId );
+			// Returns true if the tree had to be refit
+			bool MoveProxy( const uint32_t i_proxyId, const sAabb& i_aabb );
+
+			void* GetUserData( const uint32_t i_proxyId ) const;
+			const sAabb& GetAabb( const uint32_t i_proxyId ) const;
+			uint32_t GetProxyCount() const { return m_proxyCount; }
+
+			// Maintenance
+			//------------
+
+			// This should be called once per simulation update by the thread that owns the hierarchy:
+			// It replaces the tree when a background rebuild has finished,
+			// and starts a new background rebuild if the tree has become too much worse than when it was built
+			void Update();
+			// Rebuilds the tree immediately
+			// (this is useful after many proxies have been created at once, e.g. when a level is loaded)
+			void Rebuild();
+
+			// The expected cost of a query, relative to testing the root
+			// (the sum of the surface areas of every internal node divided by the surface area of the root)
+			float GetCost() const;
+
+			// Queries
+			//--------
+
+			// The IDs of the proxies whose boxes overlap the region are appended to o_proxyIds
+
+			// The planes are stored as ( a, b, c, d ) where a point is inside if ax + by + cz + d >= 0
+			// (e.g. Graphics::cFrustumCuller::GetPlanes())
+			void QueryFrustum( const float ( &i_planes )[6][4], std::vector<uint32_t>& o_proxyIds ) const;
+			void QuerySphere( const Math::sVector& i_center, const float i_radius, std::vector<uint32_t>& o_proxyIds ) const;
+			void QueryAabb( const sAabb& i_aabb, std::vector<uint32_t>& o_proxyIds ) const;
+			// Finds the closest proxy whose box is hit by the ray before i_maximumDistance.
+			// Distances are measured in multiples of the direction's length
+			bool RayCast( const Math::sVector& i_origin, const Math::sVector& i_direction, const float i_maximumDistance,
+				uint32_t& o_proxyId, float& o_distance ) const;
+
+#ifdef EAE6320_RUNTIME_ISBVHBENCHMARKENABLED
+			// Builds a synthetic scene and compares the queries to brute force,
+			// writing the timings to the log
+			static void RunBenchmark();
+#endif
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			// The margin is how far a proxy can move in any direction before the tree has to be refit
+			cBoundingVolumeHierarchy( const float i_aabbMargin = 0.1f );
+			~cBoundingVolumeHierarchy();
+
+			cBoundingVolumeHierarchy( const cBoundingVolumeHierarchy& ) = delete;
+			cBoundingVolumeHierarchy( cBoundingVolumeHierarchy&& ) = delete;
+			cBoundingVolumeHierarchy& operator =( const cBoundingVolumeHierarchy& ) = delete;
+			cBoundingVolumeHierarchy& operator =( cBoundingVolumeHierarchy&& ) = delete;
+
+			// Data
+			//=====
+
+		private:
+
+			static constexpr uint32_t s_nullNode = ~uint32_t( 0 );
+
+			struct sNode
+			{
+				// A leaf's box is the proxy's box enlarged by the margin
+				sAabb aabb;
+				// A node in the free list uses its parent as the next free node
+				uint32_t parent = s_nullNode;
+				uint32_t children[2] = { s_nullNode, s_nullNode };
+				// Leaves have a height of zero and free nodes have a height of -1
+				int32_t height = -1;
+
+				bool IsLeaf() const { return children[0] == s_nullNode; }
+			};
+			// Proxy IDs are the indices of their leaves,
+			// and the exact boxes (which are only needed at the leaves) are stored in a parallel array
+			struct sProxy
+			{
+				sAabb aabb;
+				void* userData = nullptr;
+			};
+			std::vector<sNode> m_nodes;
+			std::vector<sProxy> m_proxies;
+			uint32_t m_root = s_nullNode;
+			uint32_t m_freeList = s_nullNode;
+			uint32_t m_proxyCount = 0;
+			const float m_aabbMargin;
+
+			// The quality of the tree is only measured after enough proxies have been refit
+			uint32_t m_refitCount_sinceLastMeasurement = 0;
+			float m_cost_afterBuild = 0.0f;
+
+			// A background rebuild only reads and writes these members
+			// until the thread has stopped
+			struct sBuildPrimitive
+			{
+				sAabb aabb;
+				uint32_t proxyId;
+			};
+			struct sBuildNode
+			{
+				// A child is either another build node or (if s_buildLeafFlag is set) a proxy ID
+				uint32_t children[2];
+			};
+			std::vector<sBuildPrimitive> m_build_primitives;
+			std::vector<sBuildNode> m_build_nodes;
+			uint32_t m_build_root = s_nullNode;
+			float m_build_cost = 0.0f;
+			Concurrency::cThread m_buildThread;
+			bool m_isBuildInProgress = false;
+			// A background rebuild is discarded if proxies were created or destroyed while it was in progress
+			// (moved proxies don't matter because the new tree is refit when it replaces the old one)
+			bool m_hasBuildBeenInvalidated = false;
+
+			// Implementation
+			//===============
+
+		private:
+
+			// Nodes
+			//------
+
+			uint32_t AllocateNode();
+			void FreeNode( const uint32_t i_nodeIndex );
+			void InsertLeaf( const uint32_t i_leafIndex );
+			void RemoveLeaf( const uint32_t i_leafIndex );
+			void RefitAncestors( uint32_t i_nodeIndex );
+
+			// Building
+			//---------
+
+			void PrepareBuild();
+			static void Build( std::vector<sBuildPrimitive>& io_primitives, std::vector<sBuildNode>& o_nodes, uint32_t& o_root, float& o_cost );
+			static void BuildInBackground( void* const io_hierarchy );
+			void ReplaceTreeWithBuild();
+		};
+	}
+}
+
+#endif	// EAE6320_RUNTIME_CBOUNDINGVOLUMEHIERARCHY_H
@@ -0,0 +1,91 @@
+// Includes
+//=========
+
+#include "../Time.h"
+
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+
+// Static Data
+//============
+
+namespace
+{
+	// The monotonic clock is read in nanoseconds,
+	// and so one tick is always one nanosecond
+	constexpr uint64_t s_tickCountPerSecond = 1000000000;
+}
+
+// Interface
+//==========
+
+// Time
+//-----
+
+uint64_t eae6320::Time::GetCurrentSystemTimeTickCount()
+{
+	struct timespec currentTime;
+	const auto result = clock_gettime( CLOCK_MONOTONIC, &currentTime );
+	// The monotonic clock is always supported,
+	// and so this can only fail if the pointer is bad
+	EAE6320_ASSERTF( result == 0, "clock_gettime() failed" );
+	return ( static_cast<uint64_t>( currentTime.tv_sec ) * s_tickCountPerSecond ) + static_cast<uint64_t>( currentTime.tv_nsec );
+}
+
+double eae6320::Time::ConvertTicksToSeconds( const uint64_t i_tickCount )
+{
+	return static_cast<double>( i_tickCount ) / static_cast<double>( s_tickCountPerSecond );
+}
+
+uint64_t eae6320::Time::ConvertSecondsToTicks( const double i_secondCount )
+{
+	return static_cast<uint64_t>( ( i_secondCount * static_cast<double>( s_tickCountPerSecond ) ) + 0.5 );
+}
+
+double eae6320::Time::ConvertRatePerSecondToRatePerTick( const double i_rate_perSecond )
+{
+	return i_rate_perSecond / static_cast<double>( s_tickCountPerSecond );
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Time::Initialize()
+{
+	auto result = Results::Success;
+
+	// Make sure that the monotonic clock is precise enough to time a frame
+	{
+		struct timespec resolution;
+		if ( clock_getres( CLOCK_MONOTONIC, &resolution ) == 0 )
+		{
+			if ( ( resolution.tv_sec != 0 ) || ( resolution.tv_nsec > 1000 ) )
+			{
+				result = Results::Failure;
+				EAE6320_ASSERT( false );
+				Logging::OutputMessage( "This hardware doesn't support a high resolution monotonic clock!" );
+				return result;
+			}
+		}
+		else
+		{
+			result = Results::Failure;
+			const auto errorMessage = std::strerror( errno );
+			EAE6320_ASSERTF( false, errorMessage );
+			Logging::OutputMessage( "Linux failed to query the monotonic clock's resolution: %s", errorMessage );
+			return result;
+		}
+	}
+
+	Logging::OutputMessage( "Initialized time" );
+
+	return result;
+}
+
+eae6320::cResult eae6320::Time::CleanUp()
+{
+	return Results::Success;
+}
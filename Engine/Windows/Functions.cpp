@@ -1033,6 +1033,151 @@ eae6320::cResult eae6320::Windows::LoadBinaryFile( const char* const i_path, sDa
 	return result;
 }
 
+eae6320::cResult eae6320::Windows::MapFileReadOnly( const char* const i_path, const void*& o_data, size_t& o_size, std::string* const o_errorMessage )
+{
+	auto result = Results::Success;
+
+	HANDLE fileHandle = INVALID_HANDLE_VALUE;
+	HANDLE mappingHandle = NULL;
+
+	// The view keeps the file mapped after both handles are closed
+	const cScopeGuard scopeGuard( [i_path, o_errorMessage, &fileHandle, &mappingHandle]()
+		{
+			if ( mappingHandle != NULL )
+			{
+				if ( CloseHandle( mappingHandle ) == FALSE )
+				{
+					const auto errorCode = GetLastError();
+					if ( o_errorMessage )
+					{
+						std::ostringstream errorMessage;
+						errorMessage << "\n" "Windows failed to close the file mapping handle from \"" << i_path << "\": "
+							<< GetFormattedSystemMessage( errorCode );
+						*o_errorMessage += errorMessage.str();
+					}
+				}
+				mappingHandle = NULL;
+			}
+			if ( fileHandle != INVALID_HANDLE_VALUE )
+			{
+				if ( CloseHandle( fileHandle ) == FALSE )
+				{
+					const auto errorCode = GetLastError();
+					if ( o_errorMessage )
+					{
+						std::ostringstream errorMessage;
+						errorMessage << "\n" "Windows failed to close the file handle from \"" << i_path << "\": "
+							<< GetFormattedSystemMessage( errorCode );
+						*o_errorMessage += errorMessage.str();
+					}
+				}
+				fileHandle = INVALID_HANDLE_VALUE;
+			}
+		} );
+
+	o_data = nullptr;
+	o_size = 0;
+
+	// Open the file
+	{
+		constexpr DWORD desiredAccess = FILE_GENERIC_READ;
+		constexpr DWORD otherProgramsCanStillReadTheFile = FILE_SHARE_READ;
+		constexpr SECURITY_ATTRIBUTES* const useDefaultSecurity = nullptr;
+		constexpr DWORD onlySucceedIfFileExists = OPEN_EXISTING;
+		constexpr DWORD attributes = FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN;
+		constexpr HANDLE dontUseTemplateFile = NULL;
+		fileHandle = CreateFileW( ConvertUtf8ToUtf16( i_path ).c_str(), desiredAccess, otherProgramsCanStillReadTheFile,
+			useDefaultSecurity, onlySucceedIfFileExists, attributes, dontUseTemplateFile );
+		if ( fileHandle == INVALID_HANDLE_VALUE )
+		{
+			const auto errorCode = GetLastError();
+			switch ( errorCode )
+			{
+			case ERROR_FILE_NOT_FOUND:
+			case ERROR_PATH_NOT_FOUND:
+				result = Results::FileDoesntExist;
+				break;
+			default:
+				result = Results::Failure;
+			}
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to open the file \"" << i_path << "\" for reading: " << GetFormattedSystemMessage( errorCode );
+				*o_errorMessage = errorMessage.str();
+			}
+			return result;
+		}
+	}
+	// Get the file's size
+	size_t size = 0;
+	{
+		LARGE_INTEGER fileSize_integer;
+		if ( GetFileSizeEx( fileHandle, &fileSize_integer ) != FALSE )
+		{
+			EAE6320_ASSERT( static_cast<uint64_t>( fileSize_integer.QuadPart ) <= SIZE_MAX );
+			size = static_cast<size_t>( fileSize_integer.QuadPart );
+		}
+		else
+		{
+			const auto errorCode = GetLastError();
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to get the size of the file \"" << i_path << "\": " << GetFormattedSystemMessage( errorCode );
+				*o_errorMessage = errorMessage.str();
+			}
+			result = Results::Failure;
+			return result;
+		}
+	}
+	// An empty file can't be mapped
+	if ( size == 0 )
+	{
+		return result;
+	}
+	// Map the whole file
+	{
+		constexpr SECURITY_ATTRIBUTES* const useDefaultSecurity = nullptr;
+		constexpr DWORD mapTheWholeFile = 0;
+		constexpr LPCWSTR noName = nullptr;
+		mappingHandle = CreateFileMappingW( fileHandle, useDefaultSecurity, PAGE_READONLY, mapTheWholeFile, mapTheWholeFile, noName );
+		if ( mappingHandle == NULL )
+		{
+			const auto errorCode = GetLastError();
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to create a mapping of the file \"" << i_path << "\": " << GetFormattedSystemMessage( errorCode );
+				*o_errorMessage = errorMessage.str();
+			}
+			result = Results::Failure;
+			return result;
+		}
+	}
+	{
+		constexpr DWORD fromTheBeginning = 0;
+		constexpr SIZE_T theWholeFile = 0;
+		const auto* const view = MapViewOfFile( mappingHandle, FILE_MAP_READ, fromTheBeginning, fromTheBeginning, theWholeFile );
+		if ( !view )
+		{
+			const auto errorCode = GetLastError();
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to map a view of the file \"" << i_path << "\": " << GetFormattedSystemMessage( errorCode );
+				*o_errorMessage = errorMessage.str();
+			}
+			result = Results::Failure;
+			return result;
+		}
+		o_data = view;
+		o_size = size;
+	}
+
+	return result;
+}
+
 void eae6320::Windows::OutputErrorMessageForVisualStudio( const char* const i_errorMessage, const char* const i_optionalFilePath,
 	const unsigned int* const i_optionalLineNumber, const unsigned int* const i_optionalColumnNumber )
 {
@@ -1045,6 +1190,15 @@ void eae6320::Windows::OutputWarningMessageForVisualStudio( const char* const i_
 	OutputMessageForVisualStudio( "warning", i_errorMessage, i_optionalFilePath, i_optionalLineNumber, i_optionalColumnNumber );
 }
 
+void eae6320::Windows::UnmapFile( const void* const i_data )
+{
+	if ( i_data )
+	{
+		const auto result = UnmapViewOfFile( i_data );
+		EAE6320_ASSERTF( result != FALSE, GetLastSystemError().c_str() );
+	}
+}
+
 eae6320::cResult eae6320::Windows::WriteBinaryFile( const char* const i_path, const void* const i_data, const size_t i_size, std::string* const o_errorMessage )
 {
 	HANDLE fileHandle = INVALID_HANDLE_VALUE;
@@ -58,10 +58,14 @@ namespace eae6320
 		cResult GetLastWriteTime( const char* const i_path, uint64_t& o_lastWriteTime, std::string* const o_errorMessage = nullptr );
 		cResult InvalidateLastWriteTime( const char* const i_path, std::string* const o_errorMessage = nullptr );
 		cResult LoadBinaryFile( const char* const i_path, sDataFromFile& o_data, std::string* const o_errorMessage = nullptr );
+		// The view of the file stays valid after this function returns until it is passed to UnmapFile()
+		// (an empty file succeeds with a null view)
+		cResult MapFileReadOnly( const char* const i_path, const void*& o_data, size_t& o_size, std::string* const o_errorMessage = nullptr );
 		void OutputErrorMessageForVisualStudio( const char* const i_errorMessage, const char* const i_optionalFilePath = nullptr,
 			const unsigned int* const i_optionalLineNumber = nullptr, const unsigned int* const i_optionalColumnNumber = nullptr );
 		void OutputWarningMessageForVisualStudio( const char* const i_errorMessage, const char* const i_optionalFilePath = nullptr,
 			const unsigned int* const i_optionalLineNumber = nullptr, const unsigned int* const i_optionalColumnNumber = nullptr );
+		void UnmapFile( const void* const i_data );
 		cResult WriteBinaryFile( const char* const i_path, const void* const i_data, const size_t i_size, std::string* const o_errorMessage = nullptr );
 	}
 }
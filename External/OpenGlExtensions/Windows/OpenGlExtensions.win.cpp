@@ -69,6 +69,17 @@ PFNWGLCREATECONTEXTATTRIBSARBPROC wglCreateContextAttribsARB = nullptr;
 PFNGLUNIFORM1FPROC glUniform1f = nullptr;
 PFNGLUNIFORM3FPROC glUniform3f = nullptr;
 PFNGLGENERATEMIPMAPPROC glGenerateMipmap = nullptr;
+PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisor = nullptr;
+PFNGLDRAWELEMENTSINSTANCEDBASEINSTANCEPROC glDrawElementsInstancedBaseInstance = nullptr;
+PFNGLMAPBUFFERRANGEPROC glMapBufferRange = nullptr;
+PFNGLUNMAPBUFFERPROC glUnmapBuffer = nullptr;
+PFNGLBINDBUFFERRANGEPROC glBindBufferRange = nullptr;
+PFNGLFENCESYNCPROC glFenceSync = nullptr;
+PFNGLCLIENTWAITSYNCPROC glClientWaitSync = nullptr;
+PFNGLDELETESYNCPROC glDeleteSync = nullptr;
+PFNGLGETACTIVEUNIFORMPROC glGetActiveUniform = nullptr;
+PFNGLGETUNIFORMIVPROC glGetUniformiv = nullptr;
+PFNGLBUFFERSTORAGEPROC glBufferStorage = nullptr;
 
 // Initialize / Clean Up
 //----------------------
@@ -162,6 +173,17 @@ eae6320::cResult eae6320::OpenGlExtensions::Load( std::string* const o_errorMess
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glUniform1f, PFNGLUNIFORM1FPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glUniform3f, PFNGLUNIFORM3FPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glGenerateMipmap, PFNGLGENERATEMIPMAPPROC);
+		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glVertexAttribDivisor, PFNGLVERTEXATTRIBDIVISORPROC );
+		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glDrawElementsInstancedBaseInstance, PFNGLDRAWELEMENTSINSTANCEDBASEINSTANCEPROC );
+		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glMapBufferRange, PFNGLMAPBUFFERRANGEPROC );
+		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glUnmapBuffer, PFNGLUNMAPBUFFERPROC );
+		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBindBufferRange, PFNGLBINDBUFFERRANGEPROC );
+		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glFenceSync, PFNGLFENCESYNCPROC );
+		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glClientWaitSync, PFNGLCLIENTWAITSYNCPROC );
+		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glDeleteSync, PFNGLDELETESYNCPROC );
+		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glGetActiveUniform, PFNGLGETACTIVEUNIFORMPROC );
+		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glGetUniformiv, PFNGLGETUNIFORMIVPROC );
+		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBufferStorage, PFNGLBUFFERSTORAGEPROC );
 
 #undef EAE6320_OPENGLEXTENSIONS_LOADFUNCTION
 	}
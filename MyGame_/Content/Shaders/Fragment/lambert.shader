@@ -22,9 +22,25 @@ DeclareConstantBuffer( g_constantBuffer_frame, 0 )
 	float3 g_view_position;
 };
 
+DeclareConstantBuffer( g_constantBuffer_material, 1 )
+{
+	float3 g_baseColor;
+	float g_opacity;
+
+	float3 g_specularColor;
+	// For float4 alignment
+	float g_padding_material;
+};
+
 DeclareConstantBuffer( g_constantBuffer_drawCall, 2 )
 {
     float4x4 g_transform_localToWorld;
+
+	float3 g_vertexPosition_offset;
+	float g_padding_drawCall0;
+	float3 g_vertexPosition_scale;
+	float g_padding_drawCall1;
+
 	float3 g_light_position;
 	float3 g_light_color;
 };
@@ -42,8 +58,6 @@ DeclareSampler2D( baseColorTexture, 0 )
 DeclareSampler2D( normalTexture, 1 )
 DeclareSampler2D( specularColorTexture, 2 )
 
-uniform float transparency;
-
 // Entry Point
 //============
 
@@ -29,6 +29,12 @@ DeclareConstantBuffer( g_constantBuffer_frame, 0 )
 DeclareConstantBuffer( g_constantBuffer_drawCall, 2 )
 {
     float4x4 g_transform_localToWorld;
+
+	float3 g_vertexPosition_offset;
+	float g_padding_drawCall0;
+	float3 g_vertexPosition_scale;
+	float g_padding_drawCall1;
+
 	float3 g_light_position;
 	float3 g_light_color;
 };
@@ -52,10 +58,12 @@ vertex_main(void)
 	// Transform the local vertex into world space
 	float4 vertexPosition_world;
 	{
-		// This will be done in a future assignment.
-		// For now, however, local space is treated as if it is the same as world space.
-		float4 vertexPosition_local = float4( i_vertexData.position, 1.0 );
-		vertexPosition_world = mul( g_transform_localToWorld, vertexPosition_local );
+		// The transform comes from the instance buffer
+		// so that many copies of a mesh can be drawn with a single draw call
+		float4x4 transform_localToWorld = CreateMatrixFromColumns( i_vertexData.transform_localToWorld_column0, i_vertexData.transform_localToWorld_column1,
+			i_vertexData.transform_localToWorld_column2, i_vertexData.transform_localToWorld_column3 );
+		float4 vertexPosition_local = float4( DecodeVertexPosition( i_vertexData.position, g_vertexPosition_offset, g_vertexPosition_scale ), 1.0 );
+		vertexPosition_world = mul( transform_localToWorld, vertexPosition_local );
 	}
 	// Calculate the position of this vertex projected onto the display
 	{
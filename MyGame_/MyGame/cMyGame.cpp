@@ -4,9 +4,15 @@
 #include "cMyGame.h"
 
 #include <Engine/Asserts/Asserts.h>
+#include <Engine/Concurrency/cEvent.h>
+#include <Engine/Concurrency/cJobSystem.h>
+#include <Engine/Concurrency/cMutex.h>
+#include <Engine/Concurrency/QueueBenchmark.h>
 #include <Engine/UserInput/UserInput.h>
 #include <Engine/Logging/Logging.h>
 
+#include <Engine/Graphics/cFrustumCuller.h>
+#include <Engine/Graphics/cOcclusionCuller.h>
 #include <Engine/Graphics/Graphics.h>
 #include <Engine/Graphics/sRenderCommand.h>
 #include <Engine/Graphics/cMesh.h>
@@ -14,11 +20,15 @@
 #include <Engine/Graphics/VertexFormats.h>
 
 #include <Engine/Math/Functions.h>
+#include <Engine/Physics/cRigidBodyBatch.h>
+#include <Engine/Runtime/ECS/Components.h>
+#include <Engine/Runtime/ECS/cWorld.h>
+#include <Engine/Runtime/ECS/Systems.h>
 #include <Engine/Runtime/Gameobject/cCamera.h>
-
-#include "Gameobject/cCharacter.h"
+#include <Engine/Runtime/Spatial/cBoundingVolumeHierarchy.h>
 
 #include <utility>
+#include <vector>
 
 // Inherited Implementation
 //=========================
@@ -28,18 +38,28 @@
 
 namespace
 {
-	constexpr auto MAX_COMMAND_BUFFER_SIZE = std::numeric_limits<uint16_t>::max();
-
-	eae6320::Graphics::sRenderCommand s_renderCommand[MAX_COMMAND_BUFFER_SIZE];
-
-	uint16_t s_renderCommandNums = 0;
-
 	eae6320::Runtime::cCamera* s_camera1 = nullptr;
 	eae6320::Runtime::cCamera* s_camera2 = nullptr;
 
 	eae6320::Runtime::cCamera* s_targetCamera = nullptr;
 
-	eae6320::cCharacter s_backpack;
+	// The game's objects are entities whose components are updated by the engine's systems
+	eae6320::Runtime::cWorld s_world;
+	eae6320::Runtime::sEntity s_backpack;
+	// The world doesn't hold references to meshes, and so the game does
+	eae6320::Graphics::cMesh* s_backpackMesh = nullptr;
+
+	// Objects that the camera can't see aren't submitted to Graphics
+	eae6320::Graphics::cFrustumCuller s_frustumCuller;
+	// Objects that are hidden behind occluders aren't submitted either
+	eae6320::Graphics::cOcclusionCuller s_occlusionCuller;
+
+	// Every entity with a mesh is registered so that only the ones near the frustum are visited
+	// (the user data of a proxy is its entity)
+	eae6320::Runtime::cBoundingVolumeHierarchy s_spatialHierarchy;
+	std::vector<uint32_t> s_visibleProxyIds;
+	std::vector<eae6320::Runtime::sEntity> s_visibleEntities;
+	std::vector<eae6320::Graphics::sRenderCommand> s_renderCommands;
 }
 
 void eae6320::cMyGame::UpdateBasedOnInput()
@@ -69,13 +89,6 @@ void eae6320::cMyGame::UpdateSimulationBasedOnInput()
 		SetSimulationRate( 1.0f );
 	}
 
-	// Render Command Buffer full
-	if( s_renderCommandNums >= MAX_COMMAND_BUFFER_SIZE - 2 )
-	{
-		eae6320::Logging::OutputMessage( "Render Command Buffer Full!." );
-		return;
-	}
-
 	if ( UserInput::IsKeyPressed( UserInput::KeyCodes::Num_5 ) )
 	{
 		s_targetCamera = s_camera1;
@@ -87,14 +100,49 @@ void eae6320::cMyGame::UpdateSimulationBasedOnInput()
 
 	s_targetCamera->UpdateSimulationBasedOnInput();
 
-	s_backpack.UpdateSimulationBasedOnInput();
+	// The backpack is moved by setting its velocities, and the systems integrate them
+	{
+		auto* const velocity = s_world.GetComponent<Runtime::sVelocity>( s_backpack );
+		auto* const angularVelocity = s_world.GetComponent<Runtime::sAngularVelocity>( s_backpack );
+		if ( velocity && angularVelocity )
+		{
+			if ( UserInput::IsKeyPressed( UserInput::KeyCodes::W ) && !UserInput::IsKeyPressed( UserInput::KeyCodes::Control ) )
+			{
+				velocity->value = Math::sVector( 0.0f, 1.0f, 0.0f );
+			}
+			else if ( UserInput::IsKeyPressed( UserInput::KeyCodes::S ) && !UserInput::IsKeyPressed( UserInput::KeyCodes::Control ) )
+			{
+				velocity->value = Math::sVector( 0.0f, -1.0f, 0.0f );
+			}
+			else if ( UserInput::IsKeyPressed( UserInput::KeyCodes::A ) )
+			{
+				velocity->value = Math::sVector( -1.0f, 0.0f, 0.0f );
+			}
+			else if ( UserInput::IsKeyPressed( UserInput::KeyCodes::D ) )
+			{
+				velocity->value = Math::sVector( 1.0f, 0.0f, 0.0f );
+			}
+			else if ( UserInput::IsKeyPressed( UserInput::KeyCodes::R ) )
+			{
+				angularVelocity->speed = 1.0f;
+			}
+			else
+			{
+				velocity->value = Math::sVector( 0.0f, 0.0f, 0.0f );
+				angularVelocity->speed = 0.0f;
+			}
+		}
+	}
 }
 
 void eae6320::cMyGame::UpdateSimulationBasedOnTime( const float i_elapsedSecondCount_sinceLastUpdate )
 {
 	s_targetCamera->UpdateSimulationBasedOnTime( i_elapsedSecondCount_sinceLastUpdate );
 
-	s_backpack.UpdateSimulationBasedOnTime( i_elapsedSecondCount_sinceLastUpdate );
+	Runtime::Systems::IntegrateMotion( s_world, i_elapsedSecondCount_sinceLastUpdate );
+	Runtime::Systems::UpdateSpatialProxies( s_world, s_spatialHierarchy );
+
+	s_spatialHierarchy.Update();
 }
 
 void eae6320::cMyGame::SubmitDataToBeRendered( const float i_elapsedSecondCount_systemTime, const float i_elapsedSecondCount_sinceLastSimulationUpdate )
@@ -110,16 +158,53 @@ void eae6320::cMyGame::SubmitDataToBeRendered( const float i_elapsedSecondCount_
 		eae6320::Graphics::SubmitClearColor( clearColor );
 	}
 
-	if ( s_backpack.GenerateRenderData( s_renderCommand[s_renderCommandNums], i_elapsedSecondCount_sinceLastSimulationUpdate ) )
-		s_renderCommandNums++;
-
-	int commandNums = s_renderCommandNums;
-
-	eae6320::Graphics::SubmitRenderCommands( s_renderCommand, commandNums );
-	
-	eae6320::Graphics::SubmitCamera( s_targetCamera->GetViewMatrix( i_elapsedSecondCount_sinceLastSimulationUpdate ), s_targetCamera->GetProjectionMatrix(), s_targetCamera->m_movementComponent.GetPredictPosition( i_elapsedSecondCount_sinceLastSimulationUpdate ) );
+	const auto transform_worldToCamera = s_targetCamera->GetViewMatrix( i_elapsedSecondCount_sinceLastSimulationUpdate );
+	const auto transform_cameraToProjected = s_targetCamera->GetProjectionMatrix();
+	s_frustumCuller.SetFrustum( transform_worldToCamera, transform_cameraToProjected );
+
+	// The hierarchy finds the entities whose boxes might be visible,
+	// the visible occluders are rasterized,
+	// and then the entities that aren't hidden behind them have their meshes' bounding spheres tested at the rendered positions.
+	// The commands don't hold references to their meshes
+	// (Graphics takes its own references when they are submitted),
+	// and so they aren't cleaned up here
+	s_visibleProxyIds.clear();
+	s_spatialHierarchy.QueryFrustum( s_frustumCuller.GetPlanes(), s_visibleProxyIds );
+	s_visibleEntities.resize( s_visibleProxyIds.size() );
+	for ( size_t i = 0; i < s_visibleProxyIds.size(); ++i )
+	{
+		s_visibleEntities[i] = Runtime::Systems::GetEntity( s_spatialHierarchy, s_visibleProxyIds[i] );
+	}
+	s_renderCommands.resize( s_visibleEntities.size() );
+	Runtime::Systems::GenerateRenderCommands( s_world, s_visibleEntities.data(), static_cast<uint32_t>( s_visibleEntities.size() ),
+		i_elapsedSecondCount_sinceLastSimulationUpdate, s_renderCommands.data() );
+	s_occlusionCuller.BeginFrame( transform_worldToCamera, transform_cameraToProjected );
+	for ( const auto& renderCommand : s_renderCommands )
+	{
+		const auto* const occluder = renderCommand.m_mesh ? renderCommand.m_mesh->GetOccluder() : nullptr;
+		if ( occluder )
+		{
+			s_occlusionCuller.AddOccluder( occluder->positions, occluder->vertexCount, occluder->indices, occluder->indexCount,
+				renderCommand.m_transformation );
+		}
+	}
+	s_occlusionCuller.RenderOccluders();
+	{
+		uint32_t visibleCount = 0;
+		for ( size_t i = 0; i < s_renderCommands.size(); ++i )
+		{
+			const auto& aabb = s_spatialHierarchy.GetAabb( s_visibleProxyIds[i] );
+			if ( s_renderCommands[i].m_mesh && s_occlusionCuller.IsVisible( aabb.minimum, aabb.maximum ) )
+			{
+				s_renderCommands[visibleCount++] = s_renderCommands[i];
+			}
+		}
+		visibleCount = s_frustumCuller.Cull( s_renderCommands.data(), visibleCount );
+		eae6320::Graphics::SubmitRenderCommands( s_renderCommands.data(), visibleCount );
+	}
 
-	s_renderCommandNums = 0;
+	eae6320::Graphics::SubmitCamera( transform_worldToCamera, transform_cameraToProjected, s_targetCamera->m_movementComponent.GetPredictPosition( i_elapsedSecondCount_sinceLastSimulationUpdate ),
+		s_targetCamera->m_verticalFieldOfView_inRadians );
 }
 
 // Initialize / Clean Up
@@ -133,14 +218,60 @@ eae6320::cResult eae6320::cMyGame::Initialize()
 	eae6320::Logging::OutputMessage( "My Game: \"%s\" start initialize.", windowName );
 
 	{
-		s_backpack.m_meshComponent.ChangeMesh( "data/Meshes/backpack.dat" );
-		s_backpack.SetUpInput( true );
-		s_backpack.SetUniformScale( 0.8f );
-		eae6320::Math::sVector position( 0.0f, 2.0f, 0.0f );
-		s_backpack.m_movementComponent.SetPosition( position );
-		// s_backpack.m_movementComponent.SetAngularSpeed( 1.0f );
+		if ( !( result = eae6320::Graphics::cMesh::Load( "data/Meshes/backpack.dat", s_backpackMesh ) ) )
+		{
+			EAE6320_ASSERTF( false, "Can't initialize the backpack's mesh" );
+			return result;
+		}
+		const Runtime::sPosition position{ Math::sVector( 0.0f, 2.0f, 0.0f ) };
+		const Runtime::sScale scale{ Math::sVector( 0.8f, 0.8f, 0.8f ) };
+		Runtime::sMeshRenderer meshRenderer;
+		meshRenderer.mesh = s_backpackMesh;
+		s_backpack = s_world.CreateEntity( position, Runtime::sVelocity(), Runtime::sAcceleration(),
+			Runtime::sOrientation(), Runtime::sAngularVelocity(), scale, meshRenderer );
+		if ( s_backpack == Runtime::cWorld::s_invalidEntity )
+		{
+			EAE6320_ASSERTF( false, "Can't create the backpack" );
+			return Results::OutOfMemory;
+		}
+		if ( !( result = Runtime::Systems::RegisterSpatialProxy( s_world, s_backpack, s_spatialHierarchy ) ) )
+		{
+			EAE6320_ASSERTF( false, "Can't register the backpack's mesh" );
+			return result;
+		}
+	}
+
+	// The occluders are rasterized at a low resolution with two worker threads
+	if ( !( result = s_occlusionCuller.Initialize( 256, 128, 2 ) ) )
+	{
+		EAE6320_ASSERTF( false, "Can't initialize the occlusion culler" );
+		return result;
 	}
 
+#ifdef EAE6320_RUNTIME_ISBVHBENCHMARKENABLED
+	eae6320::Runtime::cBoundingVolumeHierarchy::RunBenchmark();
+#endif
+#ifdef EAE6320_RUNTIME_ISECSBENCHMARKENABLED
+	eae6320::Runtime::cWorld::RunBenchmark();
+#endif
+#ifdef EAE6320_PHYSICS_ISBATCHBENCHMARKENABLED
+	eae6320::Physics::cRigidBodyBatch::RunBenchmark();
+#endif
+#ifdef EAE6320_CONCURRENCY_ISJOBBENCHMARKENABLED
+	eae6320::Concurrency::cJobSystem::RunBenchmark();
+#endif
+#ifdef EAE6320_CONCURRENCY_ISSYNCHRONIZATIONBENCHMARKENABLED
+	eae6320::Concurrency::cMutex::RunBenchmark();
+	eae6320::Concurrency::cEvent::RunBenchmark();
+#endif
+#ifdef EAE6320_CONCURRENCY_ISQUEUEBENCHMARKENABLED
+	eae6320::Concurrency::RunQueueBenchmark();
+#endif
+#ifdef EAE6320_GRAPHICS_ISSUBMISSIONTESTENABLED
+	eae6320::Graphics::RunSubmissionTest( *s_backpackMesh );
+	eae6320::Graphics::RunJobSubmissionTest( *s_backpackMesh, GetJobSystem() );
+#endif
+
 	if ( !( result = eae6320::Runtime::cCamera::Load( s_camera1 ) ) )
 	{
 		EAE6320_ASSERTF( false, "Can't initialize camera 1" );
@@ -178,16 +309,31 @@ eae6320::cResult eae6320::cMyGame::Initialize()
 
 eae6320::cResult eae6320::cMyGame::CleanUp()
 {
-	// If early exit, we need to clean render the commands buffer
-	// that hasn't been submitted to graphics
-	for ( size_t i = 0; i < MAX_COMMAND_BUFFER_SIZE; ++i )
 	{
-		s_renderCommand[i].CleanUp();
-		// For the buffer has been submitted and in rendering 
-		// Graphics will clean them
+		const auto& statistics = s_frustumCuller.GetStatistics();
+		eae6320::Logging::OutputMessage( "Frustum culling: %u objects tested, %u culled, %u submitted",
+			statistics.testedCount, statistics.culledCount, statistics.submittedCount );
+	}
+	{
+		const auto& statistics = s_occlusionCuller.GetStatistics();
+		eae6320::Logging::OutputMessage( "Occlusion culling: %u occluder triangles, %u objects tested, %u occluded",
+			statistics.occluderTriangleCount, statistics.testedCount, statistics.occludedCount );
+	}
+	{
+		const auto result_occlusionCuller = s_occlusionCuller.CleanUp();
+		EAE6320_ASSERT( result_occlusionCuller );
 	}
 
-	s_backpack.CleanUp();
+	if ( s_world.IsAlive( s_backpack ) )
+	{
+		Runtime::Systems::UnregisterSpatialProxy( s_world, s_backpack, s_spatialHierarchy );
+		s_world.DestroyEntity( s_backpack );
+	}
+	if ( s_backpackMesh )
+	{
+		s_backpackMesh->DecrementReferenceCount();
+		s_backpackMesh = nullptr;
+	}
 
 	if ( s_camera1 )
 	{
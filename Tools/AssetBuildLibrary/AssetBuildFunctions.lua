@@ -286,6 +286,20 @@ NewAssetTypeInfo( "meshes",
 	}
 )
 
+NewAssetTypeInfo( "textures",
+	{
+		ConvertSourceRelativePathToBuiltRelativePath = function( i_sourceRelativePath )
+			-- Every image format is built into the same block-compressed format
+			local relativeDirectory, file = i_sourceRelativePath:match( "(.-)([^/\\]+)$" )
+			local fileName, extensionWithPeriod = file:match( "([^%.]+)(.*)" )
+			return relativeDirectory .. fileName .. ".tex"
+		end,
+		GetBuilderRelativePath = function()
+			return "TextureBuilder.exe"
+		end
+	}
+)
+
 -- Local Function Definitions
 --===========================
 
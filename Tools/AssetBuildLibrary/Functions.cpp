@@ -117,6 +117,25 @@ eae6320::cResult eae6320::Assets::ConvertSourceRelativePathToBuiltRelativePath(
 	return s_luaState.ConvertSourceRelativePathToBuiltRelativePath( i_sourceRelativePath, i_assetType, o_builtRelativePath, o_errorMessage );
 }
 
+// Informational Output
+//---------------------
+
+void eae6320::Assets::OutputMessage( const char* const i_message, ... )
+{
+	std::string formattedMessage;
+	eae6320::cResult result;
+	{
+		va_list insertions;
+		va_start( insertions, i_message );
+		result = FormatErrorOrWarningMessage( i_message, formattedMessage, insertions );
+		va_end( insertions );
+	}
+	if ( result )
+	{
+		std::cout << formattedMessage << std::endl;
+	}
+}
+
 // Error / Warning Output
 //-----------------------
 
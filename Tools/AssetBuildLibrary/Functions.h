@@ -26,6 +26,13 @@ namespace eae6320
 		eae6320::cResult ConvertSourceRelativePathToBuiltRelativePath( const char* const i_sourceRelativePath, const char* const i_assetType,
 			std::string& o_builtRelativePath, std::string* o_errorMessage = nullptr );
 
+		// Informational Output
+		//---------------------
+
+		// This outputs a message to the build log without it being treated as a warning
+		// (e.g. statistics about the asset that was built)
+		void OutputMessage( const char* const i_message, ... );
+
 		// Error / Warning Output
 		//-----------------------
 
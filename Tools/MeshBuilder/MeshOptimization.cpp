@@ -0,0 +1,504 @@
+// Includes
+//=========
+
+#include "MeshOptimization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	constexpr auto s_invalidIndex = std::numeric_limits<uint32_t>::max();
+
+	// Vertex Cache Optimization
+	//--------------------------
+
+	// The size of the LRU cache that vertex scores are calculated for
+	// (this is deliberately larger than real caches
+	// because it makes the order good for every smaller size)
+	constexpr unsigned int s_cacheSize_scoring = 32;
+
+	float CalculateVertexScore( const int i_cachePosition, const uint32_t i_remainingTriangleCount );
+
+	// Simulation
+	//-----------
+
+	// A FIFO cache of vertex indices
+	class cVertexCache
+	{
+	public:
+
+		// Returns the number of vertices of the triangle that weren't in the cache
+		unsigned int AddTriangle( const uint32_t* const i_triangle );
+		void Clear();
+
+		cVertexCache( const uint32_t i_vertexCount, const unsigned int i_cacheSize );
+
+	private:
+
+		// The "time" that each vertex was last added to the cache
+		std::vector<uint32_t> m_timeStamps;
+		uint32_t m_time;
+		const unsigned int m_cacheSize;
+	};
+}
+
+// Interface
+//==========
+
+eae6320::Assets::MeshOptimization::sVertexCacheStatistics eae6320::Assets::MeshOptimization::AnalyzeVertexCache(
+	const uint32_t* const i_indices, const size_t i_indexCount, const uint32_t i_vertexCount, const unsigned int i_cacheSize )
+{
+	sVertexCacheStatistics statistics;
+
+	const auto triangleCount = i_indexCount / 3;
+	if ( triangleCount == 0 )
+	{
+		return statistics;
+	}
+
+	cVertexCache cache( i_vertexCount, i_cacheSize );
+	std::vector<bool> isVertexUsed( i_vertexCount, false );
+	size_t missCount = 0;
+	size_t usedVertexCount = 0;
+	for ( size_t i = 0; i < triangleCount; ++i )
+	{
+		const auto* const triangle = i_indices + ( i * 3 );
+		missCount += cache.AddTriangle( triangle );
+		for ( size_t j = 0; j < 3; ++j )
+		{
+			if ( !isVertexUsed[triangle[j]] )
+			{
+				isVertexUsed[triangle[j]] = true;
+				++usedVertexCount;
+			}
+		}
+	}
+
+	statistics.averageCacheMissRatio = static_cast<float>( missCount ) / static_cast<float>( triangleCount );
+	statistics.averageTransformToVertexRatio = static_cast<float>( missCount ) / static_cast<float>( usedVertexCount );
+	return statistics;
+}
+
+void eae6320::Assets::MeshOptimization::OptimizeVertexCache( uint32_t* const io_indices, const size_t i_indexCount, const uint32_t i_vertexCount )
+{
+	const auto triangleCount = i_indexCount / 3;
+	if ( triangleCount == 0 )
+	{
+		return;
+	}
+
+	// Find the triangles that use each vertex
+	// (the triangles that haven't been added yet are kept at the beginning of each vertex's list)
+	std::vector<uint32_t> remainingTriangleCounts( i_vertexCount, 0 );
+	for ( size_t i = 0; i < ( triangleCount * 3 ); ++i )
+	{
+		++remainingTriangleCounts[io_indices[i]];
+	}
+	std::vector<uint32_t> adjacencyOffsets( static_cast<size_t>( i_vertexCount ) + 1, 0 );
+	for ( uint32_t i = 0; i < i_vertexCount; ++i )
+	{
+		adjacencyOffsets[i + 1] = adjacencyOffsets[i] + remainingTriangleCounts[i];
+	}
+	std::vector<uint32_t> adjacentTriangles( adjacencyOffsets.back() );
+	{
+		auto nextOffsets = adjacencyOffsets;
+		for ( size_t i = 0; i < ( triangleCount * 3 ); ++i )
+		{
+			adjacentTriangles[nextOffsets[io_indices[i]]++] = static_cast<uint32_t>( i / 3 );
+		}
+	}
+
+	// Calculate the initial scores
+	std::vector<int> cachePositions( i_vertexCount, -1 );
+	std::vector<float> vertexScores( i_vertexCount, 0.0f );
+	for ( uint32_t i = 0; i < i_vertexCount; ++i )
+	{
+		vertexScores[i] = CalculateVertexScore( -1, remainingTriangleCounts[i] );
+	}
+	std::vector<float> triangleScores( triangleCount, 0.0f );
+	std::vector<bool> isTriangleAdded( triangleCount, false );
+	uint32_t bestTriangle = 0;
+	for ( size_t i = 0; i < triangleCount; ++i )
+	{
+		const auto* const triangle = io_indices + ( i * 3 );
+		triangleScores[i] = vertexScores[triangle[0]] + vertexScores[triangle[1]] + vertexScores[triangle[2]];
+		if ( triangleScores[i] > triangleScores[bestTriangle] )
+		{
+			bestTriangle = static_cast<uint32_t>( i );
+		}
+	}
+
+	// Add the best triangle one at a time
+	std::vector<uint32_t> orderedIndices;
+	orderedIndices.reserve( triangleCount * 3 );
+	std::vector<uint32_t> cache, newCache;
+	cache.reserve( s_cacheSize_scoring + 3 );
+	newCache.reserve( s_cacheSize_scoring + 3 );
+	size_t nextUnaddedTriangle = 0;
+	for ( size_t addedTriangleCount = 0; addedTriangleCount < triangleCount; ++addedTriangleCount )
+	{
+		// If no triangle in the cache can be added
+		// then the best remaining one is used
+		// (this only happens when a disconnected piece of the mesh is finished)
+		if ( bestTriangle == s_invalidIndex )
+		{
+			while ( isTriangleAdded[nextUnaddedTriangle] )
+			{
+				++nextUnaddedTriangle;
+			}
+			bestTriangle = static_cast<uint32_t>( nextUnaddedTriangle );
+			for ( auto i = nextUnaddedTriangle + 1; i < triangleCount; ++i )
+			{
+				if ( !isTriangleAdded[i] && ( triangleScores[i] > triangleScores[bestTriangle] ) )
+				{
+					bestTriangle = static_cast<uint32_t>( i );
+				}
+			}
+		}
+
+		const auto* const triangle = io_indices + ( static_cast<size_t>( bestTriangle ) * 3 );
+		orderedIndices.insert( orderedIndices.end(), triangle, triangle + 3 );
+		isTriangleAdded[bestTriangle] = true;
+
+		// Remove the triangle from its vertices' lists of remaining triangles
+		for ( size_t i = 0; i < 3; ++i )
+		{
+			const auto vertex = triangle[i];
+			auto* const remainingTriangles = adjacentTriangles.data() + adjacencyOffsets[vertex];
+			auto& remainingTriangleCount = remainingTriangleCounts[vertex];
+			const auto position = std::find( remainingTriangles, remainingTriangles + remainingTriangleCount, bestTriangle );
+			if ( position != ( remainingTriangles + remainingTriangleCount ) )
+			{
+				std::swap( *position, remainingTriangles[remainingTriangleCount - 1] );
+				--remainingTriangleCount;
+			}
+		}
+
+		// The triangle's vertices move to the front of the cache
+		newCache.clear();
+		for ( size_t i = 0; i < 3; ++i )
+		{
+			if ( std::find( newCache.begin(), newCache.end(), triangle[i] ) == newCache.end() )
+			{
+				newCache.push_back( triangle[i] );
+			}
+		}
+		for ( const auto vertex : cache )
+		{
+			if ( std::find( newCache.begin(), newCache.end(), vertex ) == newCache.end() )
+			{
+				newCache.push_back( vertex );
+			}
+		}
+		// Any vertices that no longer fit are evicted
+		for ( size_t i = s_cacheSize_scoring; i < newCache.size(); ++i )
+		{
+			cachePositions[newCache[i]] = -1;
+			vertexScores[newCache[i]] = CalculateVertexScore( -1, remainingTriangleCounts[newCache[i]] );
+		}
+		for ( size_t i = 0; i < std::min<size_t>( newCache.size(), s_cacheSize_scoring ); ++i )
+		{
+			cachePositions[newCache[i]] = static_cast<int>( i );
+			vertexScores[newCache[i]] = CalculateVertexScore( static_cast<int>( i ), remainingTriangleCounts[newCache[i]] );
+		}
+
+		// Update the scores of the triangles whose vertices changed
+		// and find the best one that hasn't been added yet
+		bestTriangle = s_invalidIndex;
+		auto bestScore = -1.0f;
+		for ( const auto vertex : newCache )
+		{
+			const auto* const remainingTriangles = adjacentTriangles.data() + adjacencyOffsets[vertex];
+			for ( uint32_t i = 0; i < remainingTriangleCounts[vertex]; ++i )
+			{
+				const auto adjacentTriangle = remainingTriangles[i];
+				const auto* const adjacentIndices = io_indices + ( static_cast<size_t>( adjacentTriangle ) * 3 );
+				const auto score = vertexScores[adjacentIndices[0]] + vertexScores[adjacentIndices[1]] + vertexScores[adjacentIndices[2]];
+				triangleScores[adjacentTriangle] = score;
+				if ( score > bestScore )
+				{
+					bestScore = score;
+					bestTriangle = adjacentTriangle;
+				}
+			}
+		}
+
+		if ( newCache.size() > s_cacheSize_scoring )
+		{
+			newCache.resize( s_cacheSize_scoring );
+		}
+		std::swap( cache, newCache );
+	}
+
+	std::copy( orderedIndices.begin(), orderedIndices.end(), io_indices );
+}
+
+void eae6320::Assets::MeshOptimization::OptimizeOverdraw( uint32_t* const io_indices, const size_t i_indexCount,
+	const float* const i_positions, const size_t i_positionStride, const uint32_t i_vertexCount, const float i_threshold )
+{
+	const auto triangleCount = i_indexCount / 3;
+	if ( triangleCount < 2 )
+	{
+		return;
+	}
+
+	// Split the triangles into clusters
+	std::vector<size_t> clusterStarts;
+	{
+		constexpr unsigned int cacheSize = 16;
+		cVertexCache cache( i_vertexCount, cacheSize );
+
+		// Every point where the cache had to start over (i.e. no vertices were reused)
+		// already separates two clusters
+		std::vector<size_t> hardBoundaries;
+		for ( size_t i = 0; i < triangleCount; ++i )
+		{
+			if ( ( cache.AddTriangle( io_indices + ( i * 3 ) ) == 3 ) || ( i == 0 ) )
+			{
+				hardBoundaries.push_back( i );
+			}
+		}
+		hardBoundaries.push_back( triangleCount );
+
+		// Those clusters are split further
+		// wherever the cache efficiency of the triangles so far is close enough to that of the whole cluster
+		for ( size_t i = 0; ( i + 1 ) < hardBoundaries.size(); ++i )
+		{
+			const auto start = hardBoundaries[i];
+			const auto end = hardBoundaries[i + 1];
+
+			cache.Clear();
+			size_t missCount_cluster = 0;
+			for ( size_t j = start; j < end; ++j )
+			{
+				missCount_cluster += cache.AddTriangle( io_indices + ( j * 3 ) );
+			}
+			const auto averageCacheMissRatio_cluster = static_cast<float>( missCount_cluster ) / static_cast<float>( end - start );
+
+			cache.Clear();
+			clusterStarts.push_back( start );
+			size_t missCount = 0;
+			size_t clusterTriangleCount = 0;
+			for ( size_t j = start; j < end; ++j )
+			{
+				missCount += cache.AddTriangle( io_indices + ( j * 3 ) );
+				++clusterTriangleCount;
+				const auto averageCacheMissRatio = static_cast<float>( missCount ) / static_cast<float>( clusterTriangleCount );
+				if ( ( ( j + 1 ) < end ) && ( averageCacheMissRatio <= ( averageCacheMissRatio_cluster * i_threshold ) ) )
+				{
+					clusterStarts.push_back( j + 1 );
+					cache.Clear();
+					missCount = 0;
+					clusterTriangleCount = 0;
+				}
+			}
+		}
+		clusterStarts.push_back( triangleCount );
+	}
+	const auto clusterCount = clusterStarts.size() - 1;
+	if ( clusterCount < 2 )
+	{
+		return;
+	}
+
+	// Clusters that face away from the center of the mesh are likely to occlude other clusters,
+	// and so they are drawn first
+	std::vector<float> sortKeys( clusterCount, 0.0f );
+	{
+		const auto GetPosition = [i_positions, i_positionStride]( const uint32_t i_vertex )
+		{
+			return reinterpret_cast<const float*>( reinterpret_cast<const uint8_t*>( i_positions ) + ( i_vertex * i_positionStride ) );
+		};
+
+		// The area-weighted centroid and normal of every cluster
+		std::vector<float> clusterData( clusterCount * 7, 0.0f );
+		float meshCentroid[3] = {};
+		float meshArea = 0.0f;
+		for ( size_t i = 0; i < clusterCount; ++i )
+		{
+			auto* const centroid = &clusterData[i * 7];
+			auto* const normal = centroid + 3;
+			auto& area = centroid[6];
+			for ( auto j = clusterStarts[i]; j < clusterStarts[i + 1]; ++j )
+			{
+				const auto* const p0 = GetPosition( io_indices[( j * 3 ) + 0] );
+				const auto* const p1 = GetPosition( io_indices[( j * 3 ) + 1] );
+				const auto* const p2 = GetPosition( io_indices[( j * 3 ) + 2] );
+				const float edge1[] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+				const float edge2[] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+				const float crossProduct[] = { ( edge1[1] * edge2[2] ) - ( edge1[2] * edge2[1] ),
+					( edge1[2] * edge2[0] ) - ( edge1[0] * edge2[2] ),
+					( edge1[0] * edge2[1] ) - ( edge1[1] * edge2[0] ) };
+				const auto triangleArea = std::sqrt( ( crossProduct[0] * crossProduct[0] ) + ( crossProduct[1] * crossProduct[1] ) + ( crossProduct[2] * crossProduct[2] ) );
+				for ( size_t k = 0; k < 3; ++k )
+				{
+					centroid[k] += ( ( p0[k] + p1[k] + p2[k] ) / 3.0f ) * triangleArea;
+					normal[k] += crossProduct[k];
+				}
+				area += triangleArea;
+			}
+			for ( size_t k = 0; k < 3; ++k )
+			{
+				meshCentroid[k] += centroid[k];
+			}
+			meshArea += area;
+			if ( area > 0.0f )
+			{
+				for ( size_t k = 0; k < 3; ++k )
+				{
+					centroid[k] /= area;
+				}
+			}
+		}
+		if ( meshArea > 0.0f )
+		{
+			for ( size_t k = 0; k < 3; ++k )
+			{
+				meshCentroid[k] /= meshArea;
+			}
+		}
+		for ( size_t i = 0; i < clusterCount; ++i )
+		{
+			const auto* const centroid = &clusterData[i * 7];
+			const auto* const normal = centroid + 3;
+			const auto normalLength = std::sqrt( ( normal[0] * normal[0] ) + ( normal[1] * normal[1] ) + ( normal[2] * normal[2] ) );
+			if ( normalLength > 0.0f )
+			{
+				sortKeys[i] = ( ( ( centroid[0] - meshCentroid[0] ) * normal[0] ) + ( ( centroid[1] - meshCentroid[1] ) * normal[1] )
+					+ ( ( centroid[2] - meshCentroid[2] ) * normal[2] ) ) / normalLength;
+			}
+		}
+	}
+	std::vector<size_t> clusterOrder( clusterCount );
+	for ( size_t i = 0; i < clusterCount; ++i )
+	{
+		clusterOrder[i] = i;
+	}
+	std::stable_sort( clusterOrder.begin(), clusterOrder.end(), [&sortKeys]( const size_t i_lhs, const size_t i_rhs )
+		{
+			return sortKeys[i_lhs] > sortKeys[i_rhs];
+		} );
+
+	std::vector<uint32_t> orderedIndices;
+	orderedIndices.reserve( triangleCount * 3 );
+	for ( const auto cluster : clusterOrder )
+	{
+		orderedIndices.insert( orderedIndices.end(), io_indices + ( clusterStarts[cluster] * 3 ), io_indices + ( clusterStarts[cluster + 1] * 3 ) );
+	}
+	std::copy( orderedIndices.begin(), orderedIndices.end(), io_indices );
+}
+
+void eae6320::Assets::MeshOptimization::OptimizeVertexFetch( uint32_t* const io_indices, const size_t i_indexCount, const uint32_t i_vertexCount,
+	const std::vector<uint32_t>& i_segmentBoundaries, std::vector<uint32_t>& o_remap )
+{
+	o_remap.assign( i_vertexCount, s_invalidIndex );
+
+	// The next unused index in each segment
+	std::vector<uint32_t> nextIndices( i_segmentBoundaries.begin(), i_segmentBoundaries.end() );
+	const auto AssignIndex = [&i_segmentBoundaries, &nextIndices, &o_remap]( const uint32_t i_vertex )
+	{
+		const auto segment = static_cast<size_t>( std::upper_bound( i_segmentBoundaries.begin(), i_segmentBoundaries.end(), i_vertex ) - i_segmentBoundaries.begin() ) - 1;
+		o_remap[i_vertex] = nextIndices[segment]++;
+	};
+
+	for ( size_t i = 0; i < i_indexCount; ++i )
+	{
+		if ( o_remap[io_indices[i]] == s_invalidIndex )
+		{
+			AssignIndex( io_indices[i] );
+		}
+	}
+	// Vertices that aren't used by any triangle keep their relative order at the end of their segment
+	for ( uint32_t i = 0; i < i_vertexCount; ++i )
+	{
+		if ( o_remap[i] == s_invalidIndex )
+		{
+			AssignIndex( i );
+		}
+	}
+
+	for ( size_t i = 0; i < i_indexCount; ++i )
+	{
+		io_indices[i] = o_remap[io_indices[i]];
+	}
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	// Vertex Cache Optimization
+	//--------------------------
+
+	float CalculateVertexScore( const int i_cachePosition, const uint32_t i_remainingTriangleCount )
+	{
+		// A vertex that isn't used by any remaining triangles doesn't matter
+		if ( i_remainingTriangleCount == 0 )
+		{
+			return -1.0f;
+		}
+
+		auto score = 0.0f;
+		if ( i_cachePosition >= 0 )
+		{
+			// The three vertices of the triangle that was just added get a fixed score
+			// so that the next triangle doesn't simply reuse the most recent edge
+			constexpr auto lastTriangleScore = 0.75f;
+			if ( i_cachePosition < 3 )
+			{
+				score = lastTriangleScore;
+			}
+			else
+			{
+				constexpr auto cacheDecayPower = 1.5f;
+				const auto scaler = 1.0f / static_cast<float>( s_cacheSize_scoring - 3 );
+				score = std::pow( 1.0f - ( static_cast<float>( i_cachePosition - 3 ) * scaler ), cacheDecayPower );
+			}
+		}
+		// Vertices with few remaining triangles are preferred
+		// so that they don't get left behind as isolated triangles
+		constexpr auto valenceBoostScale = 2.0f;
+		constexpr auto valenceBoostPower = 0.5f;
+		score += valenceBoostScale * std::pow( static_cast<float>( i_remainingTriangleCount ), -valenceBoostPower );
+
+		return score;
+	}
+
+	// Simulation
+	//-----------
+
+	unsigned int cVertexCache::AddTriangle( const uint32_t* const i_triangle )
+	{
+		unsigned int missCount = 0;
+		for ( size_t i = 0; i < 3; ++i )
+		{
+			auto& timeStamp = m_timeStamps[i_triangle[i]];
+			// A vertex is in a FIFO cache if fewer than cacheSize other vertices were added after it
+			if ( ( timeStamp == 0 ) || ( ( m_time - timeStamp ) >= m_cacheSize ) )
+			{
+				timeStamp = ++m_time;
+				++missCount;
+			}
+		}
+		return missCount;
+	}
+
+	void cVertexCache::Clear()
+	{
+		// Moving time forward makes every vertex too old to be in the cache
+		m_time += m_cacheSize + 1;
+	}
+
+	cVertexCache::cVertexCache( const uint32_t i_vertexCount, const unsigned int i_cacheSize )
+		:
+		m_timeStamps( i_vertexCount, 0 ), m_time( 0 ), m_cacheSize( i_cacheSize )
+	{
+
+	}
+}
@@ -0,0 +1,64 @@
+/*
+	These functions reorder the triangles and vertices of a mesh
+	so that the GPU can draw it more efficiently
+
+	Every function works on 32 bit indices
+	and only reorders the range of indices that it is given,
+	so that a mesh with several materials can be optimized one material at a time
+*/
+
+#ifndef EAE6320_MESHOPTIMIZATION_H
+#define EAE6320_MESHOPTIMIZATION_H
+
+// Includes
+//=========
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace MeshOptimization
+		{
+			struct sVertexCacheStatistics
+			{
+				// The average number of vertices transformed per triangle ("ACMR")
+				// (between 0.5 for an ideal large mesh and 3 if no vertices are ever reused)
+				float averageCacheMissRatio = 0.0f;
+				// The average number of times each vertex is transformed ("ATVR")
+				// (1 is ideal)
+				float averageTransformToVertexRatio = 0.0f;
+			};
+
+			// Simulates a FIFO post-transform vertex cache
+			sVertexCacheStatistics AnalyzeVertexCache( const uint32_t* const i_indices, const size_t i_indexCount, const uint32_t i_vertexCount,
+				const unsigned int i_cacheSize = 16 );
+
+			// Reorders triangles so that vertices are reused while they are still in the post-transform cache
+			// (using Tom Forsyth's "Linear-Speed Vertex Cache Optimisation")
+			void OptimizeVertexCache( uint32_t* const io_indices, const size_t i_indexCount, const uint32_t i_vertexCount );
+
+			// Reorders clusters of triangles that were produced by OptimizeVertexCache()
+			// so that the triangles that are most likely to occlude others are drawn first
+			// (a new cluster is only started where it costs less than i_threshold times the cluster's cache efficiency)
+			void OptimizeOverdraw( uint32_t* const io_indices, const size_t i_indexCount,
+				const float* const i_positions, const size_t i_positionStride, const uint32_t i_vertexCount, const float i_threshold = 1.05f );
+
+			// Renumbers vertices in the order that the indices first use them
+			// so that vertex fetches are sequential in memory.
+			// A vertex only moves within the range of its segment
+			// (i_segmentBoundaries is sorted, starts with 0, and ends with i_vertexCount),
+			// and o_remap[oldVertexIndex] is its new index
+			void OptimizeVertexFetch( uint32_t* const io_indices, const size_t i_indexCount, const uint32_t i_vertexCount,
+				const std::vector<uint32_t>& i_segmentBoundaries, std::vector<uint32_t>& o_remap );
+		}
+	}
+}
+
+#endif	// EAE6320_MESHOPTIMIZATION_H
@@ -0,0 +1,332 @@
+// Includes
+//=========
+
+#include "MeshSimplification.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+#include <vector>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// The sum of the squared distances to a set of planes
+	// (weighted by the areas of the triangles that the planes came from)
+	struct sQuadric
+	{
+		double a00 = 0.0, a11 = 0.0, a22 = 0.0, a01 = 0.0, a02 = 0.0, a12 = 0.0;
+		double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+		double c = 0.0;
+		double weight = 0.0;
+
+		void AddPlane( const double i_a, const double i_b, const double i_c, const double i_d, const double i_weight );
+		void Add( const sQuadric& i_quadric );
+		// Returns the weighted average of the squared distances from the point to the planes
+		double Evaluate( const float* const i_position ) const;
+	};
+
+	struct sCollapse
+	{
+		uint32_t from;
+		uint32_t to;
+		double cost;
+	};
+
+	// Returns false if moving the vertex would flip (or nearly flip) one of the triangles around it
+	bool IsCollapseValid( const uint32_t i_from, const uint32_t i_to, const uint32_t* const i_indices,
+		const uint32_t* const i_adjacentTriangles, const size_t i_adjacentTriangleCount,
+		const float* const i_positions, const size_t i_positionStride );
+}
+
+// Interface
+//==========
+
+size_t eae6320::Assets::MeshSimplification::Simplify( uint32_t* const io_indices, const size_t i_indexCount,
+	const float* const i_positions, const size_t i_positionStride, const uint32_t i_vertexCount,
+	const size_t i_targetIndexCount, const float i_maximumError, float& o_error )
+{
+	o_error = 0.0f;
+
+	const auto GetPosition = [i_positions, i_positionStride]( const uint32_t i_vertex )
+	{
+		return reinterpret_cast<const float*>( reinterpret_cast<const uint8_t*>( i_positions ) + ( i_positionStride * i_vertex ) );
+	};
+
+	// Every vertex starts with the planes of the triangles that use it
+	std::vector<sQuadric> quadrics( i_vertexCount );
+	for ( size_t i = 0; i < i_indexCount; i += 3 )
+	{
+		const auto* const p0 = GetPosition( io_indices[i + 0] );
+		const auto* const p1 = GetPosition( io_indices[i + 1] );
+		const auto* const p2 = GetPosition( io_indices[i + 2] );
+		const double e0[] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+		const double e1[] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+		double normal[] = { ( e0[1] * e1[2] ) - ( e0[2] * e1[1] ), ( e0[2] * e1[0] ) - ( e0[0] * e1[2] ), ( e0[0] * e1[1] ) - ( e0[1] * e1[0] ) };
+		const auto length = std::sqrt( ( normal[0] * normal[0] ) + ( normal[1] * normal[1] ) + ( normal[2] * normal[2] ) );
+		if ( length <= 0.0 )
+		{
+			continue;
+		}
+		for ( auto& component : normal )
+		{
+			component /= length;
+		}
+		const auto d = -( ( normal[0] * p0[0] ) + ( normal[1] * p0[1] ) + ( normal[2] * p0[2] ) );
+		const auto area = length * 0.5;
+		for ( size_t j = 0; j < 3; ++j )
+		{
+			quadrics[io_indices[i + j]].AddPlane( normal[0], normal[1], normal[2], d, area );
+		}
+	}
+
+	// An edge that is only used in one direction is on the border of the range
+	std::vector<bool> isLocked( i_vertexCount, false );
+	{
+		const auto GetEdgeKey = []( const uint32_t i_from, const uint32_t i_to )
+		{
+			return ( static_cast<uint64_t>( i_from ) << 32 ) | i_to;
+		};
+		std::unordered_set<uint64_t> edges;
+		edges.reserve( i_indexCount );
+		for ( size_t i = 0; i < i_indexCount; i += 3 )
+		{
+			for ( size_t j = 0; j < 3; ++j )
+			{
+				edges.insert( GetEdgeKey( io_indices[i + j], io_indices[i + ( ( j + 1 ) % 3 )] ) );
+			}
+		}
+		for ( size_t i = 0; i < i_indexCount; i += 3 )
+		{
+			for ( size_t j = 0; j < 3; ++j )
+			{
+				const auto from = io_indices[i + j];
+				const auto to = io_indices[i + ( ( j + 1 ) % 3 )];
+				if ( edges.find( GetEdgeKey( to, from ) ) == edges.end() )
+				{
+					isLocked[from] = true;
+					isLocked[to] = true;
+				}
+			}
+		}
+	}
+
+	const auto maximumCost = static_cast<double>( i_maximumError ) * i_maximumError;
+	double cost_collapsed = 0.0;
+	auto indexCount = i_indexCount;
+	std::vector<uint32_t> adjacencyOffsets( static_cast<size_t>( i_vertexCount ) + 1 );
+	std::vector<uint32_t> adjacentTriangles;
+	std::vector<sCollapse> collapses;
+	std::vector<uint32_t> remap( i_vertexCount );
+	std::vector<bool> isTouched( i_vertexCount );
+	// Each pass collapses as many edges as it can without two collapses affecting the same triangles,
+	// cheapest first
+	while ( indexCount > i_targetIndexCount )
+	{
+		// Find the triangles around every vertex
+		{
+			std::fill( adjacencyOffsets.begin(), adjacencyOffsets.end(), 0 );
+			for ( size_t i = 0; i < indexCount; ++i )
+			{
+				++adjacencyOffsets[io_indices[i] + 1];
+			}
+			for ( uint32_t i = 0; i < i_vertexCount; ++i )
+			{
+				adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+			}
+			adjacentTriangles.resize( indexCount );
+			std::vector<uint32_t> counts( i_vertexCount, 0 );
+			for ( size_t i = 0; i < indexCount; ++i )
+			{
+				const auto vertex = io_indices[i];
+				adjacentTriangles[adjacencyOffsets[vertex] + counts[vertex]++] = static_cast<uint32_t>( i / 3 );
+			}
+		}
+		// Choose the cheaper direction of every edge that can be collapsed
+		collapses.clear();
+		for ( size_t i = 0; i < indexCount; i += 3 )
+		{
+			for ( size_t j = 0; j < 3; ++j )
+			{
+				const auto v0 = io_indices[i + j];
+				const auto v1 = io_indices[i + ( ( j + 1 ) % 3 )];
+				// Interior edges are shared by two triangles, and so only one of them adds the edge
+				if ( ( v0 > v1 ) || ( isLocked[v0] && isLocked[v1] ) )
+				{
+					continue;
+				}
+				sQuadric quadric = quadrics[v0];
+				quadric.Add( quadrics[v1] );
+				const auto cost_0to1 = isLocked[v0] ? HUGE_VAL : quadric.Evaluate( GetPosition( v1 ) );
+				const auto cost_1to0 = isLocked[v1] ? HUGE_VAL : quadric.Evaluate( GetPosition( v0 ) );
+				collapses.push_back( ( cost_0to1 <= cost_1to0 ) ? sCollapse{ v0, v1, cost_0to1 } : sCollapse{ v1, v0, cost_1to0 } );
+			}
+		}
+		std::sort( collapses.begin(), collapses.end(), []( const sCollapse& i_lhs, const sCollapse& i_rhs )
+			{
+				return i_lhs.cost < i_rhs.cost;
+			} );
+
+		for ( uint32_t i = 0; i < i_vertexCount; ++i )
+		{
+			remap[i] = i;
+		}
+		std::fill( isTouched.begin(), isTouched.end(), false );
+		const auto triangleCountToRemove = ( indexCount - i_targetIndexCount + 2 ) / 3;
+		size_t removedTriangleCount = 0;
+		size_t collapseCount = 0;
+		for ( const auto& collapse : collapses )
+		{
+			if ( ( collapse.cost > maximumCost ) || ( removedTriangleCount >= triangleCountToRemove ) )
+			{
+				break;
+			}
+			if ( isTouched[collapse.from] || isTouched[collapse.to] )
+			{
+				continue;
+			}
+			const auto* const triangles = adjacentTriangles.data() + adjacencyOffsets[collapse.from];
+			const auto triangleCount = adjacencyOffsets[collapse.from + 1] - adjacencyOffsets[collapse.from];
+			if ( !IsCollapseValid( collapse.from, collapse.to, io_indices, triangles, triangleCount, i_positions, i_positionStride ) )
+			{
+				continue;
+			}
+			// Every vertex of the triangles that change is touched
+			// so that no other collapse in this pass changes them again
+			// (the validity check assumed that their other vertices stay where they are)
+			for ( uint32_t j = 0; j < triangleCount; ++j )
+			{
+				const auto* const triangle = io_indices + ( static_cast<size_t>( triangles[j] ) * 3 );
+				const auto isRemoved = ( triangle[0] == collapse.to ) || ( triangle[1] == collapse.to ) || ( triangle[2] == collapse.to );
+				removedTriangleCount += isRemoved ? 1 : 0;
+				for ( size_t k = 0; k < 3; ++k )
+				{
+					isTouched[triangle[k]] = true;
+				}
+			}
+			remap[collapse.from] = collapse.to;
+			quadrics[collapse.to].Add( quadrics[collapse.from] );
+			cost_collapsed = std::max( cost_collapsed, collapse.cost );
+			++collapseCount;
+		}
+		if ( collapseCount == 0 )
+		{
+			break;
+		}
+
+		// Remove the triangles that collapsed
+		size_t newIndexCount = 0;
+		for ( size_t i = 0; i < indexCount; i += 3 )
+		{
+			const uint32_t triangle[] = { remap[io_indices[i + 0]], remap[io_indices[i + 1]], remap[io_indices[i + 2]] };
+			if ( ( triangle[0] != triangle[1] ) && ( triangle[1] != triangle[2] ) && ( triangle[2] != triangle[0] ) )
+			{
+				io_indices[newIndexCount++] = triangle[0];
+				io_indices[newIndexCount++] = triangle[1];
+				io_indices[newIndexCount++] = triangle[2];
+			}
+		}
+		indexCount = newIndexCount;
+	}
+
+	o_error = static_cast<float>( std::sqrt( cost_collapsed ) );
+	return indexCount;
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	void sQuadric::AddPlane( const double i_a, const double i_b, const double i_c, const double i_d, const double i_weight )
+	{
+		a00 += i_weight * i_a * i_a;
+		a11 += i_weight * i_b * i_b;
+		a22 += i_weight * i_c * i_c;
+		a01 += i_weight * i_a * i_b;
+		a02 += i_weight * i_a * i_c;
+		a12 += i_weight * i_b * i_c;
+		b0 += i_weight * i_a * i_d;
+		b1 += i_weight * i_b * i_d;
+		b2 += i_weight * i_c * i_d;
+		c += i_weight * i_d * i_d;
+		weight += i_weight;
+	}
+
+	void sQuadric::Add( const sQuadric& i_quadric )
+	{
+		a00 += i_quadric.a00;
+		a11 += i_quadric.a11;
+		a22 += i_quadric.a22;
+		a01 += i_quadric.a01;
+		a02 += i_quadric.a02;
+		a12 += i_quadric.a12;
+		b0 += i_quadric.b0;
+		b1 += i_quadric.b1;
+		b2 += i_quadric.b2;
+		c += i_quadric.c;
+		weight += i_quadric.weight;
+	}
+
+	double sQuadric::Evaluate( const float* const i_position ) const
+	{
+		if ( weight <= 0.0 )
+		{
+			return 0.0;
+		}
+		const double x = i_position[0], y = i_position[1], z = i_position[2];
+		const auto error = ( a00 * x * x ) + ( a11 * y * y ) + ( a22 * z * z )
+			+ ( 2.0 * ( ( a01 * x * y ) + ( a02 * x * z ) + ( a12 * y * z ) ) )
+			+ ( 2.0 * ( ( b0 * x ) + ( b1 * y ) + ( b2 * z ) ) )
+			+ c;
+		// Rounding can make the error slightly negative
+		return std::max( error, 0.0 ) / weight;
+	}
+
+	bool IsCollapseValid( const uint32_t i_from, const uint32_t i_to, const uint32_t* const i_indices,
+		const uint32_t* const i_adjacentTriangles, const size_t i_adjacentTriangleCount,
+		const float* const i_positions, const size_t i_positionStride )
+	{
+		const auto GetPosition = [i_positions, i_positionStride]( const uint32_t i_vertex )
+		{
+			return reinterpret_cast<const float*>( reinterpret_cast<const uint8_t*>( i_positions ) + ( i_positionStride * i_vertex ) );
+		};
+		const auto CalculateNormal = []( const float* const i_p0, const float* const i_p1, const float* const i_p2, float* const o_normal )
+		{
+			const float e0[] = { i_p1[0] - i_p0[0], i_p1[1] - i_p0[1], i_p1[2] - i_p0[2] };
+			const float e1[] = { i_p2[0] - i_p0[0], i_p2[1] - i_p0[1], i_p2[2] - i_p0[2] };
+			o_normal[0] = ( e0[1] * e1[2] ) - ( e0[2] * e1[1] );
+			o_normal[1] = ( e0[2] * e1[0] ) - ( e0[0] * e1[2] );
+			o_normal[2] = ( e0[0] * e1[1] ) - ( e0[1] * e1[0] );
+		};
+
+		const auto* const position_to = GetPosition( i_to );
+		for ( size_t i = 0; i < i_adjacentTriangleCount; ++i )
+		{
+			const auto* const triangle = i_indices + ( static_cast<size_t>( i_adjacentTriangles[i] ) * 3 );
+			// The triangles that contain the edge are removed
+			if ( ( triangle[0] == i_to ) || ( triangle[1] == i_to ) || ( triangle[2] == i_to ) )
+			{
+				continue;
+			}
+			// Rotate the triangle so that the vertex that moves is first
+			const auto first = ( triangle[0] == i_from ) ? 0 : ( ( triangle[1] == i_from ) ? 1 : 2 );
+			const auto* const p1 = GetPosition( triangle[( first + 1 ) % 3] );
+			const auto* const p2 = GetPosition( triangle[( first + 2 ) % 3] );
+			float normal_before[3], normal_after[3];
+			CalculateNormal( GetPosition( i_from ), p1, p2, normal_before );
+			CalculateNormal( position_to, p1, p2, normal_after );
+			const auto dot = ( normal_before[0] * normal_after[0] ) + ( normal_before[1] * normal_after[1] ) + ( normal_before[2] * normal_after[2] );
+			const auto lengthSquared_before = ( normal_before[0] * normal_before[0] ) + ( normal_before[1] * normal_before[1] ) + ( normal_before[2] * normal_before[2] );
+			const auto lengthSquared_after = ( normal_after[0] * normal_after[0] ) + ( normal_after[1] * normal_after[1] ) + ( normal_after[2] * normal_after[2] );
+			// The triangle must not turn more than about 75 degrees
+			if ( ( dot <= 0.0f ) || ( ( dot * dot ) < ( 0.0625f * lengthSquared_before * lengthSquared_after ) ) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
@@ -0,0 +1,41 @@
+/*
+	These functions reduce the number of triangles in a mesh
+	so that lower levels of detail can be drawn when it is small on screen
+
+	Triangles are removed by collapsing edges onto one of their existing vertices,
+	and so every level of detail can share the original vertex buffer
+*/
+
+#ifndef EAE6320_MESHSIMPLIFICATION_H
+#define EAE6320_MESHSIMPLIFICATION_H
+
+// Includes
+//=========
+
+#include <cstddef>
+#include <cstdint>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace MeshSimplification
+		{
+			// Removes triangles (in place) until there are at most i_targetIndexCount indices left
+			// or every remaining collapse would move the surface further than i_maximumError.
+			// The cost of a collapse is measured with quadric error metrics
+			// (Garland and Heckbert's "Surface Simplification Using Quadric Error Metrics").
+			// Vertices on an open edge of the given range never move,
+			// and so neither do material boundaries or UV seams (where the vertices are split).
+			// Returns the new index count, and o_error is how far the surface moved (in the units of the positions)
+			size_t Simplify( uint32_t* const io_indices, const size_t i_indexCount,
+				const float* const i_positions, const size_t i_positionStride, const uint32_t i_vertexCount,
+				const size_t i_targetIndexCount, const float i_maximumError, float& o_error );
+		}
+	}
+}
+
+#endif	// EAE6320_MESHSIMPLIFICATION_H
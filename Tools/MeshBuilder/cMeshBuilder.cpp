@@ -2,14 +2,25 @@
 //=========
 
 #include "cMeshBuilder.h"
+#include "MeshOptimization.h"
+#include "MeshSimplification.h"
 
 #include <Tools/AssetBuildLibrary/Functions.h>
+#include <Engine/Graphics/MeshFormats.h>
+#include <Engine/Graphics/VertexFormats.h>
+#include <Engine/Math/Functions.h>
+#include <Tools/TextureBuilder/cTextureBuilder.h>
 #include <Engine/Platform/Platform.h>
 
 #include <External/Lua/Includes.h>
 #include <Engine/ScopeGuard/cScopeGuard.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
 
-#include <fstream>
 
 // Helper Class Declaration
 //=========================
@@ -60,7 +71,18 @@ namespace
 		} indexRange;
 	};
 
-	eae6320::cResult LoadMesh( const char* const i_sourcePath, const char* const i_targetPath, sVertex_mesh*& o_vertexData, void*& o_indices, uint32_t& o_triangleCount, uint32_t& o_vertexCount, sMaterialInfo*& o_materials, uint16_t& o_materialsCount );
+	// A mesh that is authored with "isOccluder = true" also gets simplified geometry
+	// that the occlusion culler draws
+	// (with about "occluderTriangleRatio" of the original triangles)
+	struct sOccluderSettings
+	{
+		bool isOccluder = false;
+		float triangleRatio = 0.25f;
+	};
+
+	eae6320::cResult LoadMesh( const char* const i_sourcePath, const char* const i_targetPath, sVertex_mesh*& o_vertexData, void*& o_indices, uint32_t& o_triangleCount, uint32_t& o_vertexCount, sMaterialInfo*& o_materials, uint16_t& o_materialsCount,
+		sOccluderSettings& o_occluderSettings );
+	eae6320::cResult LoadOccluderSettings( lua_State& io_luaState, const char* const i_sourcePath, sOccluderSettings& o_occluderSettings );
 
 	eae6320::cResult LoadElements( lua_State& io_luaState, void*& o_indices, uint32_t& o_triangleCount );
 	eae6320::cResult LoadElementsValues( lua_State& io_luaState, void*& o_indices, uint32_t& o_triangleCount );
@@ -80,7 +102,52 @@ namespace
 	eae6320::cResult LoadMaterials( lua_State& io_luaState, const std::string& i_sourcePath, const std::string& i_meshName, const std::string& i_targetPath, sMaterialInfo*& o_materials, uint16_t& o_materialsCount );
 	eae6320::cResult LoadMaterial( lua_State& io_luaState, const std::string& i_sourcePath, const std::string& i_meshName, const std::string& i_targetPath, sMaterialInfo* o_materials, uint16_t i_index );
 
+	// Reorders the triangles of each material for the post-transform vertex cache and for overdraw
+	// and then reorders the vertices in the order that they are used
+	// (each material's index and vertex ranges keep the same triangles and vertices)
+	eae6320::cResult OptimizeMesh( const char* const i_path, sVertex_mesh* io_vertexData, void* io_indices, const uint32_t i_indexCount, const uint32_t i_vertexCount,
+		const sMaterialInfo* const i_materials, const uint16_t i_materialsCount );
+
+	// Converts an authored vertex into the compact format that the game uses
+	// (see VertexFormats::sVertex_mesh)
+	// Every level of detail has about half of the triangles of the one before it
+	// (level 0 is the original mesh)
+	constexpr uint8_t s_lodCount = 4;
+	constexpr float s_lodTriangleRatio = 0.5f;
+	// Simplification stops before the surface moves further than this fraction of the mesh's bounding radius
+	constexpr float s_maximumLodError = 0.05f;
+
+	// Simplifies every submesh of the full detail mesh into lower levels of detail
+	// whose indices (which use the original vertices) are returned in o_lodIndices.
+	// There are i_submeshes.size() submeshes in o_lodSubmeshes for every level in o_lods
+	eae6320::cResult GenerateLods( const char* const i_path, const sVertex_mesh* i_vertexData, const void* i_indices, const uint32_t i_indexCount, const uint32_t i_vertexCount,
+		const std::vector<eae6320::Graphics::MeshFormats::sSubmesh>& i_submeshes, std::vector<uint32_t>& o_lodIndices,
+		std::vector<eae6320::Graphics::MeshFormats::sLod>& o_lods, std::vector<eae6320::Graphics::MeshFormats::sSubmesh>& o_lodSubmeshes );
+
+	// An occluder that extends past the original surface would hide things that should be visible,
+	// and so its simplification stops before the surface moves further than this fraction of the mesh's bounding radius
+	constexpr float s_maximumOccluderError = 0.01f;
+
+	// Welds the vertices of the full detail mesh by position (ignoring every other attribute),
+	// simplifies the result, and returns only the positions that the remaining triangles use
+	eae6320::cResult GenerateOccluder( const char* const i_path, const sVertex_mesh* i_vertexData, const void* i_indices, const uint32_t i_indexCount, const uint32_t i_vertexCount,
+		const float i_triangleRatio, std::vector<float>& o_positions, std::vector<uint32_t>& o_indices );
+
+	// Splits every submesh of the full detail mesh into meshlets of consecutive triangles
+	// (the triangles are already in vertex cache order, and so consecutive triangles are close together)
+	// and calculates the sphere and normal cone that the game culls each meshlet with
+	void GenerateMeshlets( const char* const i_path, const sVertex_mesh* i_vertexData, const void* i_indices, const uint32_t i_indexCount, const uint32_t i_vertexCount,
+		const std::vector<eae6320::Graphics::MeshFormats::sSubmesh>& i_submeshes, std::vector<eae6320::Graphics::MeshFormats::sMeshlet>& o_meshlets );
+
+	// Calculates the box and sphere around the given vertices
+	// (or around the first i_count vertices if i_vertexIndices is null)
+	eae6320::Graphics::MeshFormats::sBounds CalculateBounds( const sVertex_mesh* i_vertexData, const uint32_t* i_vertexIndices, const size_t i_count );
+
+	void EncodeVertex( const sVertex_mesh& i_vertex, const eae6320::Graphics::MeshFormats::sBounds& i_bounds, eae6320::Graphics::VertexFormats::sVertex_mesh& o_vertex );
+
 	void GetFilePathandFileName( const std::string& i_path, std::string& o_path, std::string& o_filename );
+	// The textures that materials reference are built into block-compressed ".tex" files
+	std::string GetBuiltTextureName( const std::string& i_fileName );
 }
 
 // Inherited Implementation
@@ -111,6 +178,7 @@ eae6320::cResult eae6320::Assets::cMeshBuilder::Build( const std::vector<std::st
 	uint32_t triangleCount = 0;
 	uint32_t vertexCount = 0;
 	uint16_t materialsCount = 0;
+	sOccluderSettings occluderSettings;
 
 	eae6320::cScopeGuard scopeGuard_onExit( [ &vertexData, &indices, &materials ]
 		{
@@ -128,7 +196,7 @@ eae6320::cResult eae6320::Assets::cMeshBuilder::Build( const std::vector<std::st
 			}
 		});
 
-	if ( !( result = LoadMesh( m_path_source, m_path_target, vertexData, indices, triangleCount, vertexCount, materials, materialsCount ) ) )
+	if ( !( result = LoadMesh( m_path_source, m_path_target, vertexData, indices, triangleCount, vertexCount, materials, materialsCount, occluderSettings ) ) )
 	{
 		eae6320::Assets::OutputErrorMessageWithFileInfo( m_path_target, "Failed to extra Lua mesh file." );
 			return result;
@@ -136,132 +204,352 @@ eae6320::cResult eae6320::Assets::cMeshBuilder::Build( const std::vector<std::st
 
 	indiceCount = triangleCount * 3;
 
-	std::ofstream binaryMeshFile( m_path_target, std::ofstream::binary );
-	if ( binaryMeshFile.is_open() )
+	if ( !( result = OptimizeMesh( m_path_source, vertexData, indices, indiceCount, vertexCount, materials, materialsCount ) ) )
 	{
-		size_t size1 = sizeof( vertexCount );
-		size_t size2 = sizeof( sVertex_mesh ) * vertexCount;
-		size_t size3 = sizeof( indiceCount );
+		return result;
+	}
 
-		size_t dataSize = indiceCount > std::numeric_limits<uint16_t>::max() ? sizeof( uint32_t ) : sizeof( uint16_t );
-		size_t size4 = dataSize * indiceCount;
-		auto bufferSize = size1 + size2 + size3 + size4;
+	using namespace eae6320::Graphics;
 
-		// calculate materials info size
+	// A mesh without materials is a single submesh
+	std::vector<MeshFormats::sSubmesh> submeshes( ( materialsCount > 0 ) ? materialsCount : 1 );
+	if ( materialsCount > 0 )
+	{
+		for ( size_t index = 0; index < materialsCount; ++index )
 		{
-			bufferSize += sizeof( materialsCount );
-
-			for ( size_t index = 0; index < materialsCount; ++index )
+			const auto& material = materials[index];
+			auto& submesh = submeshes[index];
+			// A material that isn't used by any triangles keeps its initial (inverted) ranges
+			if ( material.indexRange.first <= material.indexRange.last )
 			{
-				auto material = materials[index];
-				// every texture name's length is under 255 char
-				bufferSize += 5 * sizeof( uint8_t ); // 5 texture
-
-				bufferSize += material.baseColorTexName.length();
-				bufferSize += material.specularColorTexName.length();
-				bufferSize += material.ambientTexName.length();
-				bufferSize += material.normalTexName.length();
-				bufferSize += material.transparencyTexName.length();
-
-				bufferSize += 4 * sizeof( uint32_t ); // vertex and index range
-
-				bufferSize += 4 * 3 * sizeof(float); // 4 color
+				submesh.firstIndex = static_cast<uint32_t>( material.indexRange.first );
+				submesh.indexCount = static_cast<uint32_t>( material.indexRange.last - material.indexRange.first + 1 );
+			}
+			if ( material.vertexRange.first <= material.vertexRange.last )
+			{
+				submesh.firstVertex = static_cast<uint32_t>( material.vertexRange.first );
+				submesh.vertexCount = static_cast<uint32_t>( material.vertexRange.last - material.vertexRange.first + 1 );
 			}
 		}
+	}
+	else
+	{
+		submeshes[0].indexCount = indiceCount;
+		submeshes[0].vertexCount = vertexCount;
+	}
 
-		char* buffer = new (std::nothrow) char[bufferSize];
+	// The lower levels of detail come after the full detail mesh in the index array
+	std::vector<uint32_t> lodIndices;
+	std::vector<MeshFormats::sLod> lods;
+	std::vector<MeshFormats::sSubmesh> lodSubmeshes;
+	if ( !( result = GenerateLods( m_path_source, vertexData, indices, indiceCount, vertexCount, submeshes, lodIndices, lods, lodSubmeshes ) ) )
+	{
+		return result;
+	}
+	if ( ( static_cast<uint64_t>( indiceCount ) + lodIndices.size() ) > std::numeric_limits<uint32_t>::max() )
+	{
+		result = eae6320::Results::Failure;
+		eae6320::Assets::OutputErrorMessageWithFileInfo( m_path_source, "The mesh has too many indices for the mesh file format" );
+		return result;
+	}
+	const auto indexCount_total = static_cast<uint32_t>( indiceCount + lodIndices.size() );
 
-		if ( !buffer )
+	std::vector<MeshFormats::sMeshlet> meshlets;
+	GenerateMeshlets( m_path_source, vertexData, indices, indiceCount, vertexCount, submeshes, meshlets );
+
+	std::vector<float> occluderPositions;
+	std::vector<uint32_t> occluderIndices;
+	if ( occluderSettings.isOccluder )
+	{
+		if ( !( result = GenerateOccluder( m_path_source, vertexData, indices, indiceCount, vertexCount, occluderSettings.triangleRatio, occluderPositions, occluderIndices ) ) )
 		{
-			result = eae6320::Results::OutOfMemory;
-			eae6320::Assets::OutputErrorMessage( "Couldn't allocate memory for the binary mesh data." );
 			return result;
 		}
+	}
 
-		if( bufferSize >= size1 )
-			memcpy( buffer, &vertexCount, size1 );
-		if ( bufferSize >= size1 + size2 )
-			memcpy( buffer + size1, vertexData, size2 );
-		if ( bufferSize >= size1 + size2 + size3 )
-			memcpy( buffer + size1 + size2, &indiceCount, size3 );
-		if ( bufferSize >= size1 + size2 + size3 + size4 )
-			memcpy( buffer + size1 + size2 + size3, indices, size4 );
-
-		// write materials info
-		{
-			auto currentOffset = reinterpret_cast<uintptr_t>( buffer + size1 + size2 + size3 + size4 );
-			memcpy( reinterpret_cast<void*>( currentOffset ), &materialsCount, sizeof( materialsCount ) );
-			currentOffset += sizeof( materialsCount );
-
-			for ( size_t index = 0; index < materialsCount; ++index )
-			{
-				auto material = materials[index];
-				{
-					uint8_t len = 0;
-					// every texture name's length is under 255 char
-					// Base color
-					memcpy( reinterpret_cast<void*>( currentOffset ), reinterpret_cast<void*>( material.baseColor ), 3 * sizeof( float ) );
-					currentOffset += 3 * sizeof( float );
-					len = static_cast<uint8_t>( material.baseColorTexName.length() );
-					memcpy( reinterpret_cast<void*>( currentOffset ), &len, sizeof( uint8_t ) );
-					currentOffset += sizeof( uint8_t );
-					memcpy( reinterpret_cast<void*>( currentOffset ), material.baseColorTexName.c_str(), len );
-					currentOffset += len;
-
-					// Specular Color
-					memcpy( reinterpret_cast<void*>( currentOffset ), reinterpret_cast<void*>( material.specularColor ), 3 * sizeof( float ) );
-					currentOffset += 3 * sizeof( float );
-					len = static_cast<uint8_t>( material.specularColorTexName.length() );
-					memcpy( reinterpret_cast<void*>( currentOffset ), &len, sizeof( uint8_t ) );
-					currentOffset += sizeof( uint8_t );
-					memcpy( reinterpret_cast<void*>( currentOffset ), material.specularColorTexName.c_str(), len );
-					currentOffset += len;
-
-					// Ambient
-					memcpy( reinterpret_cast<void*>( currentOffset ), reinterpret_cast<void*>( material.ambient ), 3 * sizeof( float ) );
-					currentOffset += 3 * sizeof( float );
-					len = static_cast<uint8_t>( material.ambientTexName.length() );
-					memcpy( reinterpret_cast<void*>( currentOffset ), &len, sizeof( uint8_t ) );
-					currentOffset += sizeof( uint8_t );
-					memcpy( reinterpret_cast<void*>( currentOffset ), material.ambientTexName.c_str(), len );
-					currentOffset += len;
-
-					// Transparency
-					memcpy( reinterpret_cast<void*>( currentOffset ), reinterpret_cast<void*>( material.transparency ), 3 * sizeof( float ) );
-					currentOffset += 3 * sizeof( float );
-					len = static_cast<uint8_t>( material.transparencyTexName.length() );
-					memcpy( reinterpret_cast<void*>( currentOffset ), &len, sizeof( uint8_t ) );
-					currentOffset += sizeof( uint8_t );
-					memcpy( reinterpret_cast<void*>( currentOffset ), material.transparencyTexName.c_str(), len );
-					currentOffset += len;
-
-					// Normal
-					len = static_cast<uint8_t>( material.normalTexName.length() );
-					memcpy( reinterpret_cast<void*>( currentOffset ), &len, sizeof( uint8_t ) );
-					currentOffset += sizeof( uint8_t );
-					memcpy( reinterpret_cast<void*>( currentOffset ), material.normalTexName.c_str(), len );
-					currentOffset += len;
-
-					// Vertex range
-					memcpy( reinterpret_cast<void*>( currentOffset ), &(material.vertexRange.first), sizeof( uint32_t ) );
-					currentOffset += sizeof( uint32_t );
-					memcpy( reinterpret_cast<void*>( currentOffset ), &( material.vertexRange.last ), sizeof( uint32_t ) );
-					currentOffset += sizeof( uint32_t );
-
-					// Index range
-					memcpy( reinterpret_cast<void*>( currentOffset ), &( material.indexRange.first ), sizeof( uint32_t ) );
-					currentOffset += sizeof( uint32_t );
-					memcpy( reinterpret_cast<void*>( currentOffset ), &( material.indexRange.last ), sizeof( uint32_t ) );
-					currentOffset += sizeof( uint32_t );
-				}
+	const size_t indexSize = indexCount_total > std::numeric_limits<uint16_t>::max() ? sizeof( uint32_t ) : sizeof( uint16_t );
+
+	// Calculate the size of every section
+	MeshFormats::sSection sections[9];
+	auto& section_vertices = sections[0];
+	auto& section_indices = sections[1];
+	auto& section_submeshes = sections[2];
+	auto& section_bounds = sections[3];
+	auto& section_materials = sections[4];
+	auto& section_lods = sections[5];
+	auto& section_submeshBounds = sections[6];
+	auto& section_occluder = sections[7];
+	auto& section_meshlets = sections[8];
+	{
+		section_vertices.type = MeshFormats::eSection::Vertices;
+		section_vertices.count = vertexCount;
+		section_vertices.size = static_cast<uint32_t>( sizeof( VertexFormats::sVertex_mesh ) * vertexCount );
+
+		section_indices.type = MeshFormats::eSection::Indices;
+		section_indices.count = indexCount_total;
+		section_indices.size = static_cast<uint32_t>( indexSize * indexCount_total );
+
+		section_submeshes.type = MeshFormats::eSection::Submeshes;
+		section_submeshes.count = static_cast<uint32_t>( submeshes.size() );
+		section_submeshes.size = static_cast<uint32_t>( sizeof( MeshFormats::sSubmesh ) * submeshes.size() );
+
+		section_submeshBounds.type = MeshFormats::eSection::SubmeshBounds;
+		section_submeshBounds.count = static_cast<uint32_t>( submeshes.size() );
+		section_submeshBounds.size = static_cast<uint32_t>( sizeof( MeshFormats::sBounds ) * submeshes.size() );
+
+		section_lods.type = MeshFormats::eSection::Lods;
+		section_lods.count = static_cast<uint32_t>( lods.size() );
+		section_lods.size = static_cast<uint32_t>( ( sizeof( MeshFormats::sLod ) * lods.size() ) + ( sizeof( MeshFormats::sSubmesh ) * lodSubmeshes.size() ) );
+
+		section_occluder.type = MeshFormats::eSection::Occluder;
+		section_occluder.count = occluderIndices.empty() ? 0 : 1;
+		section_occluder.size = occluderIndices.empty() ? 0 : static_cast<uint32_t>( sizeof( MeshFormats::sOccluder )
+			+ ( sizeof( float ) * occluderPositions.size() ) + ( sizeof( uint32_t ) * occluderIndices.size() ) );
+
+		section_meshlets.type = MeshFormats::eSection::Meshlets;
+		section_meshlets.count = static_cast<uint32_t>( meshlets.size() );
+		section_meshlets.size = static_cast<uint32_t>( sizeof( MeshFormats::sMeshlet ) * meshlets.size() );
+
+		section_bounds.type = MeshFormats::eSection::Bounds;
+		section_bounds.count = 1;
+		section_bounds.size = sizeof( MeshFormats::sBounds );
+
+		section_materials.type = MeshFormats::eSection::Materials;
+		section_materials.count = materialsCount;
+		size_t size = 0;
+		for ( size_t index = 0; index < materialsCount; ++index )
+		{
+			const auto& material = materials[index];
+			// every texture name's length is under 255 char
+			size += 5 * sizeof( uint8_t ); // 5 texture
+
+			size += material.baseColorTexName.length();
+			size += material.specularColorTexName.length();
+			size += material.ambientTexName.length();
+			size += material.normalTexName.length();
+			size += material.transparencyTexName.length();
+
+			size += 4 * sizeof( uint32_t ); // vertex and index range
+
+			size += 4 * 3 * sizeof( float ); // 4 color
+		}
+		section_materials.size = static_cast<uint32_t>( size );
+	}
+	constexpr auto sectionCount = static_cast<uint8_t>( sizeof( sections ) / sizeof( sections[0] ) );
+
+	// Every section starts at an aligned offset
+	// so that the game can use the vertices and indices straight from a mapping of the file
+	const auto offset_data = sizeof( MeshFormats::sHeader ) + ( sizeof( MeshFormats::sSection ) * sectionCount );
+	size_t bufferSize = offset_data;
+	for ( auto& section : sections )
+	{
+		const auto offset = MeshFormats::GetAlignedOffset( bufferSize );
+		section.offset = static_cast<uint32_t>( offset );
+		bufferSize = offset + section.size;
+	}
+	if ( bufferSize > std::numeric_limits<uint32_t>::max() )
+	{
+		result = eae6320::Results::Failure;
+		eae6320::Assets::OutputErrorMessageWithFileInfo( m_path_source, "The mesh is too big for the mesh file format" );
+		return result;
+	}
+
+	// The buffer is zeroed so that the padding (and therefore the checksum) is deterministic
+	char* buffer = new (std::nothrow) char[bufferSize]();
+	if ( !buffer )
+	{
+		result = eae6320::Results::OutOfMemory;
+		eae6320::Assets::OutputErrorMessage( "Couldn't allocate memory for the binary mesh data." );
+		return result;
+	}
+	eae6320::cScopeGuard scopeGuard_buffer( [buffer]
+		{
+			delete[] buffer;
+		} );
+
+	// The vertex positions are stored relative to the bounds
+	// and so the bounds must be calculated first
+	const auto bounds = CalculateBounds( vertexData, nullptr, vertexCount );
+	memcpy( buffer + section_bounds.offset, &bounds, sizeof( bounds ) );
+	{
+		const auto is32_source = indiceCount > std::numeric_limits<uint16_t>::max();
+		auto* const submeshBounds = reinterpret_cast<MeshFormats::sBounds*>( buffer + section_submeshBounds.offset );
+		std::vector<uint32_t> submeshVertices;
+		for ( size_t i = 0; i < submeshes.size(); ++i )
+		{
+			const auto& submesh = submeshes[i];
+			submeshVertices.resize( submesh.indexCount );
+			for ( uint32_t j = 0; j < submesh.indexCount; ++j )
+			{
+				const auto index = static_cast<size_t>( submesh.firstIndex ) + j;
+				submeshVertices[j] = is32_source ? static_cast<const uint32_t*>( indices )[index] : static_cast<const uint16_t*>( indices )[index];
+			}
+			submeshBounds[i] = CalculateBounds( vertexData, submeshVertices.data(), submeshVertices.size() );
+		}
+	}
+	{
+		auto* const vertices = reinterpret_cast<VertexFormats::sVertex_mesh*>( buffer + section_vertices.offset );
+		for ( uint32_t i = 0; i < vertexCount; ++i )
+		{
+			EncodeVertex( vertexData[i], bounds, vertices[i] );
+		}
+	}
+	{
+		const auto is32_source = indiceCount > std::numeric_limits<uint16_t>::max();
+		const auto GetIndex = [&]( const uint32_t i_index ) -> uint32_t
+		{
+			if ( i_index >= indiceCount )
+			{
+				return lodIndices[i_index - indiceCount];
+			}
+			return is32_source ? static_cast<const uint32_t*>( indices )[i_index] : static_cast<const uint16_t*>( indices )[i_index];
+		};
+		for ( uint32_t i = 0; i < indexCount_total; ++i )
+		{
+			if ( indexSize == sizeof( uint32_t ) )
+			{
+				reinterpret_cast<uint32_t*>( buffer + section_indices.offset )[i] = GetIndex( i );
+			}
+			else
+			{
+				reinterpret_cast<uint16_t*>( buffer + section_indices.offset )[i] = static_cast<uint16_t>( GetIndex( i ) );
+			}
+		}
+	}
+#if defined( EAE6320_PLATFORM_GL )
+	// OpenGL treats counter-clockwise triangles as front-facing,
+	// and so the winding is swapped here rather than when the mesh is loaded
+	{
+		const auto SwapWinding = []( auto* const io_indices, const uint32_t i_indexCount )
+		{
+			for ( uint32_t i = 0; i < i_indexCount; i += 3 )
+			{
+				std::swap( io_indices[i + 1], io_indices[i + 2] );
 			}
+		};
+		if ( indexSize == sizeof( uint32_t ) )
+		{
+			SwapWinding( reinterpret_cast<uint32_t*>( buffer + section_indices.offset ), indexCount_total );
 		}
+		else
+		{
+			SwapWinding( reinterpret_cast<uint16_t*>( buffer + section_indices.offset ), indexCount_total );
+		}
+	}
+#endif
+	memcpy( buffer + section_submeshes.offset, submeshes.data(), section_submeshes.size );
+	if ( !lods.empty() )
+	{
+		const auto size_lods = sizeof( MeshFormats::sLod ) * lods.size();
+		memcpy( buffer + section_lods.offset, lods.data(), size_lods );
+		memcpy( buffer + section_lods.offset + size_lods, lodSubmeshes.data(), sizeof( MeshFormats::sSubmesh ) * lodSubmeshes.size() );
+	}
 
-		binaryMeshFile.write( buffer, bufferSize );
+	if ( !occluderIndices.empty() )
+	{
+		MeshFormats::sOccluder occluder;
+		occluder.vertexCount = static_cast<uint32_t>( occluderPositions.size() / 3 );
+		occluder.indexCount = static_cast<uint32_t>( occluderIndices.size() );
+		auto* const occluderData = buffer + section_occluder.offset;
+		memcpy( occluderData, &occluder, sizeof( occluder ) );
+		memcpy( occluderData + sizeof( occluder ), occluderPositions.data(), sizeof( float ) * occluderPositions.size() );
+		memcpy( occluderData + sizeof( occluder ) + ( sizeof( float ) * occluderPositions.size() ), occluderIndices.data(), sizeof( uint32_t ) * occluderIndices.size() );
+	}
 
-		delete[] buffer;
+	if ( !meshlets.empty() )
+	{
+		memcpy( buffer + section_meshlets.offset, meshlets.data(), section_meshlets.size );
+	}
 
-		binaryMeshFile.close();
+	// write materials info
+	{
+		auto currentOffset = reinterpret_cast<uintptr_t>( buffer + section_materials.offset );
+
+		for ( size_t index = 0; index < materialsCount; ++index )
+		{
+			auto material = materials[index];
+			{
+				uint8_t len = 0;
+				// every texture name's length is under 255 char
+				// Base color
+				memcpy( reinterpret_cast<void*>( currentOffset ), reinterpret_cast<void*>( material.baseColor ), 3 * sizeof( float ) );
+				currentOffset += 3 * sizeof( float );
+				len = static_cast<uint8_t>( material.baseColorTexName.length() );
+				memcpy( reinterpret_cast<void*>( currentOffset ), &len, sizeof( uint8_t ) );
+				currentOffset += sizeof( uint8_t );
+				memcpy( reinterpret_cast<void*>( currentOffset ), material.baseColorTexName.c_str(), len );
+				currentOffset += len;
+
+				// Specular Color
+				memcpy( reinterpret_cast<void*>( currentOffset ), reinterpret_cast<void*>( material.specularColor ), 3 * sizeof( float ) );
+				currentOffset += 3 * sizeof( float );
+				len = static_cast<uint8_t>( material.specularColorTexName.length() );
+				memcpy( reinterpret_cast<void*>( currentOffset ), &len, sizeof( uint8_t ) );
+				currentOffset += sizeof( uint8_t );
+				memcpy( reinterpret_cast<void*>( currentOffset ), material.specularColorTexName.c_str(), len );
+				currentOffset += len;
+
+				// Ambient
+				memcpy( reinterpret_cast<void*>( currentOffset ), reinterpret_cast<void*>( material.ambient ), 3 * sizeof( float ) );
+				currentOffset += 3 * sizeof( float );
+				len = static_cast<uint8_t>( material.ambientTexName.length() );
+				memcpy( reinterpret_cast<void*>( currentOffset ), &len, sizeof( uint8_t ) );
+				currentOffset += sizeof( uint8_t );
+				memcpy( reinterpret_cast<void*>( currentOffset ), material.ambientTexName.c_str(), len );
+				currentOffset += len;
+
+				// Transparency
+				memcpy( reinterpret_cast<void*>( currentOffset ), reinterpret_cast<void*>( material.transparency ), 3 * sizeof( float ) );
+				currentOffset += 3 * sizeof( float );
+				len = static_cast<uint8_t>( material.transparencyTexName.length() );
+				memcpy( reinterpret_cast<void*>( currentOffset ), &len, sizeof( uint8_t ) );
+				currentOffset += sizeof( uint8_t );
+				memcpy( reinterpret_cast<void*>( currentOffset ), material.transparencyTexName.c_str(), len );
+				currentOffset += len;
+
+				// Normal
+				len = static_cast<uint8_t>( material.normalTexName.length() );
+				memcpy( reinterpret_cast<void*>( currentOffset ), &len, sizeof( uint8_t ) );
+				currentOffset += sizeof( uint8_t );
+				memcpy( reinterpret_cast<void*>( currentOffset ), material.normalTexName.c_str(), len );
+				currentOffset += len;
+
+				// Vertex range
+				memcpy( reinterpret_cast<void*>( currentOffset ), &(material.vertexRange.first), sizeof( uint32_t ) );
+				currentOffset += sizeof( uint32_t );
+				memcpy( reinterpret_cast<void*>( currentOffset ), &( material.vertexRange.last ), sizeof( uint32_t ) );
+				currentOffset += sizeof( uint32_t );
+
+				// Index range
+				memcpy( reinterpret_cast<void*>( currentOffset ), &( material.indexRange.first ), sizeof( uint32_t ) );
+				currentOffset += sizeof( uint32_t );
+				memcpy( reinterpret_cast<void*>( currentOffset ), &( material.indexRange.last ), sizeof( uint32_t ) );
+				currentOffset += sizeof( uint32_t );
+			}
+		}
+	}
+
+	// The header and the section table are written last
+	// because the checksum covers everything after them
+	{
+		MeshFormats::sHeader header;
+		header.vertexSize = static_cast<uint16_t>( sizeof( VertexFormats::sVertex_mesh ) );
+		header.indexSize = static_cast<uint8_t>( indexSize );
+		header.sectionCount = sectionCount;
+		header.vertexCount = vertexCount;
+		header.indexCount = indexCount_total;
+		header.checksum = MeshFormats::CalculateChecksum( buffer + offset_data, bufferSize - offset_data );
+		memcpy( buffer, &header, sizeof( header ) );
+		memcpy( buffer + sizeof( header ), sections, sizeof( sections ) );
+	}
+
+	{
+		std::string errorMessage;
+		if ( !( result = eae6320::Platform::WriteBinaryFile( m_path_target, buffer, bufferSize, &errorMessage ) ) )
+		{
+			eae6320::Assets::OutputErrorMessageWithFileInfo( m_path_target, errorMessage.c_str() );
+			return result;
+		}
 	}
 
 	return result;
@@ -272,7 +560,8 @@ eae6320::cResult eae6320::Assets::cMeshBuilder::Build( const std::vector<std::st
 
 namespace
 {
-	eae6320::cResult LoadMesh( const char* const i_sourcePath, const char* const i_targetPath, sVertex_mesh*& o_vertexData, void*& o_indices, uint32_t& o_triangleCount, uint32_t& o_vertexCount, sMaterialInfo*& o_materials, uint16_t& o_materialsCount )
+	eae6320::cResult LoadMesh( const char* const i_sourcePath, const char* const i_targetPath, sVertex_mesh*& o_vertexData, void*& o_indices, uint32_t& o_triangleCount, uint32_t& o_vertexCount, sMaterialInfo*& o_materials, uint16_t& o_materialsCount,
+		sOccluderSettings& o_occluderSettings )
 	{
 		auto result = eae6320::Results::Success;
 
@@ -367,6 +656,10 @@ namespace
 		{
 			return result;
 		}
+		if ( !( result = LoadOccluderSettings( *luaState, i_sourcePath, o_occluderSettings ) ) )
+		{
+			return result;
+		}
 
 		{
 			std::string sourceFolderPath, sourceMeshFileName;
@@ -382,6 +675,64 @@ namespace
 	}
 
 
+	eae6320::cResult LoadOccluderSettings( lua_State& io_luaState, const char* const i_sourcePath, sOccluderSettings& o_occluderSettings )
+	{
+		auto result = eae6320::Results::Success;
+
+		// Both values are optional
+		{
+			constexpr auto* const key = "isOccluder";
+			lua_pushstring( &io_luaState, key );
+			lua_gettable( &io_luaState, -2 );
+
+			eae6320::cScopeGuard scopeGuard( [&io_luaState]
+				{
+					lua_pop( &io_luaState, 1 );
+				} );
+
+			if ( lua_isboolean( &io_luaState, -1 ) )
+			{
+				o_occluderSettings.isOccluder = lua_toboolean( &io_luaState, -1 ) != 0;
+			}
+			else if ( !lua_isnil( &io_luaState, -1 ) )
+			{
+				result = eae6320::Results::InvalidFile;
+				eae6320::Assets::OutputErrorMessageWithFileInfo( i_sourcePath, "The value at \" %s \" must be a boolean (instead of a %s )", key, luaL_typename( &io_luaState, -1 ) );
+				return result;
+			}
+		}
+		{
+			constexpr auto* const key = "occluderTriangleRatio";
+			lua_pushstring( &io_luaState, key );
+			lua_gettable( &io_luaState, -2 );
+
+			eae6320::cScopeGuard scopeGuard( [&io_luaState]
+				{
+					lua_pop( &io_luaState, 1 );
+				} );
+
+			if ( lua_isnumber( &io_luaState, -1 ) )
+			{
+				const auto triangleRatio = static_cast<float>( lua_tonumber( &io_luaState, -1 ) );
+				if ( !( triangleRatio > 0.0f ) || ( triangleRatio > 1.0f ) )
+				{
+					result = eae6320::Results::InvalidFile;
+					eae6320::Assets::OutputErrorMessageWithFileInfo( i_sourcePath, "The value at \" %s \" must be greater than 0 and no greater than 1", key );
+					return result;
+				}
+				o_occluderSettings.triangleRatio = triangleRatio;
+			}
+			else if ( !lua_isnil( &io_luaState, -1 ) )
+			{
+				result = eae6320::Results::InvalidFile;
+				eae6320::Assets::OutputErrorMessageWithFileInfo( i_sourcePath, "The value at \" %s \" must be a number (instead of a %s )", key, luaL_typename( &io_luaState, -1 ) );
+				return result;
+			}
+		}
+
+		return result;
+	}
+
 	eae6320::cResult LoadElements( lua_State& io_luaState, void*& o_indices, uint32_t& o_triangleCount )
 	{
 		auto result = eae6320::Results::Success;
@@ -1015,14 +1366,14 @@ namespace
 				{ 
 					std::string textureName, texturePath;
 					GetFilePathandFileName( baseColorTexName, texturePath, textureName );
+					textureName = GetBuiltTextureName( textureName );
 
 					std::string targetFilePath = i_targetPath + "/" + meshFileName + "/" + textureName;
 
 					std::string errorMessage;
 
-					eae6320::Platform::CreateDirectoryIfItDoesntExist( targetFilePath.c_str(), &errorMessage );
-
-					if ( !( result = eae6320::Platform::CopyFile( baseColorTexName.c_str(), targetFilePath.c_str(), false, true, &errorMessage ) ) )
+					if ( !( result = eae6320::Assets::cTextureBuilder::BuildTextureFile( baseColorTexName.c_str(), targetFilePath.c_str(),
+						eae6320::Graphics::TextureFormats::eFormat::BC7, true, &errorMessage ) ) )
 					{
 						eae6320::Assets::OutputErrorMessageWithFileInfo( baseColorTexName.c_str(), errorMessage.c_str() );
 						return result;
@@ -1088,14 +1439,14 @@ namespace
 				{
 					std::string textureName, texturePath;
 					GetFilePathandFileName( specularTexName, texturePath, textureName );
+					textureName = GetBuiltTextureName( textureName );
 
 					std::string targetFilePath = i_targetPath + "/" + meshFileName + "/" + textureName;
 
 					std::string errorMessage;
 
-					eae6320::Platform::CreateDirectoryIfItDoesntExist( targetFilePath.c_str(), &errorMessage );
-
-					if ( !( result = eae6320::Platform::CopyFile( specularTexName.c_str(), targetFilePath.c_str(), false, true, &errorMessage ) ) )
+					if ( !( result = eae6320::Assets::cTextureBuilder::BuildTextureFile( specularTexName.c_str(), targetFilePath.c_str(),
+						eae6320::Graphics::TextureFormats::eFormat::BC1, false, &errorMessage ) ) )
 					{
 						eae6320::Assets::OutputErrorMessageWithFileInfo( specularTexName.c_str(), errorMessage.c_str() );
 						return result;
@@ -1183,14 +1534,14 @@ namespace
 				{
 					std::string textureName, texturePath;
 					GetFilePathandFileName( normalTexName, texturePath, textureName );
+					textureName = GetBuiltTextureName( textureName );
 
 					std::string targetFilePath = i_targetPath + "/" + meshFileName + "/" + textureName;
 
 					std::string errorMessage;
 
-					eae6320::Platform::CreateDirectoryIfItDoesntExist( targetFilePath.c_str(), &errorMessage );
-
-					if ( !( result = eae6320::Platform::CopyFile( normalTexName.c_str(), targetFilePath.c_str(), false, true, &errorMessage ) ) )
+					if ( !( result = eae6320::Assets::cTextureBuilder::BuildTextureFile( normalTexName.c_str(), targetFilePath.c_str(),
+						eae6320::Graphics::TextureFormats::eFormat::BC7, false, &errorMessage ) ) )
 					{
 						eae6320::Assets::OutputErrorMessageWithFileInfo( normalTexName.c_str(), errorMessage.c_str() );
 						return result;
@@ -1256,14 +1607,14 @@ namespace
 				{
 					std::string textureName, texturePath;
 					GetFilePathandFileName( transparencyTexName, texturePath, textureName );
+					textureName = GetBuiltTextureName( textureName );
 
 					std::string targetFilePath = i_targetPath + "/" + meshFileName + "/" + textureName;
 
 					std::string errorMessage;
 
-					eae6320::Platform::CreateDirectoryIfItDoesntExist( targetFilePath.c_str(), &errorMessage );
-
-					if ( !( result = eae6320::Platform::CopyFile( transparencyTexName.c_str(), targetFilePath.c_str(), false, true, &errorMessage ) ) )
+					if ( !( result = eae6320::Assets::cTextureBuilder::BuildTextureFile( transparencyTexName.c_str(), targetFilePath.c_str(),
+						eae6320::Graphics::TextureFormats::eFormat::BC7, false, &errorMessage ) ) )
 					{
 						eae6320::Assets::OutputErrorMessageWithFileInfo( transparencyTexName.c_str(), errorMessage.c_str() );
 						return result;
@@ -1369,6 +1720,578 @@ namespace
 		return result;
 	}
 
+	eae6320::cResult OptimizeMesh( const char* const i_path, sVertex_mesh* io_vertexData, void* io_indices, const uint32_t i_indexCount, const uint32_t i_vertexCount,
+		const sMaterialInfo* const i_materials, const uint16_t i_materialsCount )
+	{
+		namespace MeshOptimization = eae6320::Assets::MeshOptimization;
+
+		const auto is32 = i_indexCount > std::numeric_limits<uint16_t>::max();
+		std::vector<uint32_t> indices( i_indexCount );
+		for ( uint32_t i = 0; i < i_indexCount; ++i )
+		{
+			indices[i] = is32 ? static_cast<const uint32_t*>( io_indices )[i] : static_cast<const uint16_t*>( io_indices )[i];
+			if ( indices[i] >= i_vertexCount )
+			{
+				eae6320::Assets::OutputErrorMessageWithFileInfo( i_path, "Index %u refers to vertex %u but there are only %u vertices", i, indices[i], i_vertexCount );
+				return eae6320::Results::InvalidFile;
+			}
+		}
+
+		// Triangles and vertices are only moved within the ranges between material boundaries
+		std::vector<uint32_t> triangleBoundaries{ 0, i_indexCount / 3 };
+		std::vector<uint32_t> vertexBoundaries{ 0, i_vertexCount };
+		for ( uint16_t i = 0; i < i_materialsCount; ++i )
+		{
+			const auto& indexRange = i_materials[i].indexRange;
+			if ( ( indexRange.first <= indexRange.last ) && ( indexRange.last < i_indexCount ) )
+			{
+				if ( ( ( indexRange.first % 3 ) != 0 ) || ( ( ( indexRange.last + 1 ) % 3 ) != 0 ) )
+				{
+					eae6320::Assets::OutputErrorMessageWithFileInfo( i_path, "The index range of material %u doesn't contain whole triangles", i );
+					return eae6320::Results::InvalidFile;
+				}
+				triangleBoundaries.push_back( static_cast<uint32_t>( indexRange.first / 3 ) );
+				triangleBoundaries.push_back( static_cast<uint32_t>( ( indexRange.last + 1 ) / 3 ) );
+			}
+			const auto& vertexRange = i_materials[i].vertexRange;
+			if ( ( vertexRange.first <= vertexRange.last ) && ( vertexRange.last < i_vertexCount ) )
+			{
+				vertexBoundaries.push_back( static_cast<uint32_t>( vertexRange.first ) );
+				vertexBoundaries.push_back( static_cast<uint32_t>( vertexRange.last + 1 ) );
+			}
+		}
+		for ( auto* const boundaries : { &triangleBoundaries, &vertexBoundaries } )
+		{
+			std::sort( boundaries->begin(), boundaries->end() );
+			boundaries->erase( std::unique( boundaries->begin(), boundaries->end() ), boundaries->end() );
+		}
+
+		const auto statistics_before = MeshOptimization::AnalyzeVertexCache( indices.data(), indices.size(), i_vertexCount );
+
+		for ( size_t i = 0; ( i + 1 ) < triangleBoundaries.size(); ++i )
+		{
+			auto* const rangeIndices = indices.data() + ( static_cast<size_t>( triangleBoundaries[i] ) * 3 );
+			const auto rangeIndexCount = static_cast<size_t>( triangleBoundaries[i + 1] - triangleBoundaries[i] ) * 3;
+			MeshOptimization::OptimizeVertexCache( rangeIndices, rangeIndexCount, i_vertexCount );
+			MeshOptimization::OptimizeOverdraw( rangeIndices, rangeIndexCount, &io_vertexData[0].x, sizeof( sVertex_mesh ), i_vertexCount );
+		}
+		{
+			std::vector<uint32_t> remap;
+			MeshOptimization::OptimizeVertexFetch( indices.data(), indices.size(), i_vertexCount, vertexBoundaries, remap );
+			const std::vector<sVertex_mesh> vertices( io_vertexData, io_vertexData + i_vertexCount );
+			for ( uint32_t i = 0; i < i_vertexCount; ++i )
+			{
+				io_vertexData[remap[i]] = vertices[i];
+			}
+		}
+
+		const auto statistics_after = MeshOptimization::AnalyzeVertexCache( indices.data(), indices.size(), i_vertexCount );
+		eae6320::Assets::OutputMessage( "%s: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f", i_path,
+			statistics_before.averageCacheMissRatio, statistics_after.averageCacheMissRatio,
+			statistics_before.averageTransformToVertexRatio, statistics_after.averageTransformToVertexRatio );
+
+		for ( uint32_t i = 0; i < i_indexCount; ++i )
+		{
+			if ( is32 )
+			{
+				static_cast<uint32_t*>( io_indices )[i] = indices[i];
+			}
+			else
+			{
+				static_cast<uint16_t*>( io_indices )[i] = static_cast<uint16_t>( indices[i] );
+			}
+		}
+
+		return eae6320::Results::Success;
+	}
+
+	eae6320::cResult GenerateLods( const char* const i_path, const sVertex_mesh* i_vertexData, const void* i_indices, const uint32_t i_indexCount, const uint32_t i_vertexCount,
+		const std::vector<eae6320::Graphics::MeshFormats::sSubmesh>& i_submeshes, std::vector<uint32_t>& o_lodIndices,
+		std::vector<eae6320::Graphics::MeshFormats::sLod>& o_lods, std::vector<eae6320::Graphics::MeshFormats::sSubmesh>& o_lodSubmeshes )
+	{
+		namespace MeshFormats = eae6320::Graphics::MeshFormats;
+		namespace MeshOptimization = eae6320::Assets::MeshOptimization;
+		namespace MeshSimplification = eae6320::Assets::MeshSimplification;
+
+		o_lodIndices.clear();
+		o_lods.clear();
+		o_lodSubmeshes.clear();
+
+		const auto is32 = i_indexCount > std::numeric_limits<uint16_t>::max();
+		const auto GetIndex = [i_indices, is32]( const size_t i_index ) -> uint32_t
+		{
+			return is32 ? static_cast<const uint32_t*>( i_indices )[i_index] : static_cast<const uint16_t*>( i_indices )[i_index];
+		};
+
+		// The maximum error is relative to the size of the mesh
+		float maximumError = 0.0f;
+		{
+			float center[3] = {};
+			for ( uint32_t i = 0; i < i_vertexCount; ++i )
+			{
+				center[0] += i_vertexData[i].x / i_vertexCount;
+				center[1] += i_vertexData[i].y / i_vertexCount;
+				center[2] += i_vertexData[i].z / i_vertexCount;
+			}
+			float radiusSquared = 0.0f;
+			for ( uint32_t i = 0; i < i_vertexCount; ++i )
+			{
+				const float offset[] = { i_vertexData[i].x - center[0], i_vertexData[i].y - center[1], i_vertexData[i].z - center[2] };
+				radiusSquared = std::max( radiusSquared, ( offset[0] * offset[0] ) + ( offset[1] * offset[1] ) + ( offset[2] * offset[2] ) );
+			}
+			maximumError = std::sqrt( radiusSquared ) * s_maximumLodError;
+		}
+
+		// Every level is simplified from the full detail mesh
+		// so that the errors don't accumulate
+		size_t indexCount_previousLod = i_indexCount;
+		auto ratio = 1.0f;
+		std::vector<uint32_t> submeshIndices;
+		for ( uint8_t lod = 1; lod < std::min( s_lodCount, MeshFormats::maxLodCount ); ++lod )
+		{
+			ratio *= s_lodTriangleRatio;
+
+			MeshFormats::sLod newLod;
+			std::vector<MeshFormats::sSubmesh> newSubmeshes( i_submeshes.size() );
+			const auto indexCount_lodsBefore = o_lodIndices.size();
+			for ( size_t i = 0; i < i_submeshes.size(); ++i )
+			{
+				const auto& submesh = i_submeshes[i];
+				submeshIndices.resize( submesh.indexCount );
+				for ( uint32_t j = 0; j < submesh.indexCount; ++j )
+				{
+					submeshIndices[j] = GetIndex( static_cast<size_t>( submesh.firstIndex ) + j );
+				}
+				const auto targetIndexCount = static_cast<size_t>( submesh.indexCount * ratio ) / 3 * 3;
+				float error = 0.0f;
+				const auto indexCount = MeshSimplification::Simplify( submeshIndices.data(), submeshIndices.size(),
+					&i_vertexData[0].x, sizeof( sVertex_mesh ), i_vertexCount, targetIndexCount, maximumError, error );
+				MeshOptimization::OptimizeVertexCache( submeshIndices.data(), indexCount, i_vertexCount );
+				newLod.error = std::max( newLod.error, error );
+
+				auto& newSubmesh = newSubmeshes[i];
+				newSubmesh.firstIndex = static_cast<uint32_t>( i_indexCount + o_lodIndices.size() );
+				newSubmesh.indexCount = static_cast<uint32_t>( indexCount );
+				newSubmesh.firstVertex = submesh.firstVertex;
+				newSubmesh.vertexCount = submesh.vertexCount;
+				o_lodIndices.insert( o_lodIndices.end(), submeshIndices.begin(), submeshIndices.begin() + indexCount );
+			}
+
+			// A level that isn't much simpler than the one before it isn't worth its memory
+			// (and the next levels would be even less worthwhile)
+			const auto indexCount_lod = o_lodIndices.size() - indexCount_lodsBefore;
+			if ( ( indexCount_lod == 0 ) || ( indexCount_lod > ( indexCount_previousLod * 4 / 5 ) ) )
+			{
+				o_lodIndices.resize( indexCount_lodsBefore );
+				break;
+			}
+			indexCount_previousLod = indexCount_lod;
+
+			o_lods.push_back( newLod );
+			o_lodSubmeshes.insert( o_lodSubmeshes.end(), newSubmeshes.begin(), newSubmeshes.end() );
+			eae6320::Assets::OutputMessage( "%s: LOD %u has %u triangles (error %g)", i_path, static_cast<unsigned int>( lod ),
+				static_cast<unsigned int>( indexCount_lod / 3 ), newLod.error );
+		}
+
+		return eae6320::Results::Success;
+	}
+
+	eae6320::cResult GenerateOccluder( const char* const i_path, const sVertex_mesh* i_vertexData, const void* i_indices, const uint32_t i_indexCount, const uint32_t i_vertexCount,
+		const float i_triangleRatio, std::vector<float>& o_positions, std::vector<uint32_t>& o_indices )
+	{
+		namespace MeshSimplification = eae6320::Assets::MeshSimplification;
+
+		o_positions.clear();
+		o_indices.clear();
+
+		// Vertices that are split for other attributes (e.g. UV seams) would be treated as open edges,
+		// and so every vertex at the same position is merged into one
+		std::vector<uint32_t> weldedVertices( i_vertexCount );
+		std::vector<float> weldedPositions;
+		{
+			std::map<std::tuple<float, float, float>, uint32_t> positionToVertex;
+			for ( uint32_t i = 0; i < i_vertexCount; ++i )
+			{
+				const auto& vertex = i_vertexData[i];
+				const auto insertion = positionToVertex.emplace( std::make_tuple( vertex.x, vertex.y, vertex.z ), static_cast<uint32_t>( weldedPositions.size() / 3 ) );
+				if ( insertion.second )
+				{
+					weldedPositions.insert( weldedPositions.end(), { vertex.x, vertex.y, vertex.z } );
+				}
+				weldedVertices[i] = insertion.first->second;
+			}
+		}
+		const auto weldedVertexCount = static_cast<uint32_t>( weldedPositions.size() / 3 );
+
+		// Triangles that became degenerate when their vertices were welded are removed
+		std::vector<uint32_t> indices;
+		indices.reserve( i_indexCount );
+		{
+			const auto is32 = i_indexCount > std::numeric_limits<uint16_t>::max();
+			const auto GetIndex = [i_indices, is32]( const size_t i_index ) -> uint32_t
+			{
+				return is32 ? static_cast<const uint32_t*>( i_indices )[i_index] : static_cast<const uint16_t*>( i_indices )[i_index];
+			};
+			for ( uint32_t i = 0; ( i + 2 ) < i_indexCount; i += 3 )
+			{
+				const uint32_t triangle[] = { weldedVertices[GetIndex( i )], weldedVertices[GetIndex( i + 1 )], weldedVertices[GetIndex( i + 2 )] };
+				if ( ( triangle[0] != triangle[1] ) && ( triangle[1] != triangle[2] ) && ( triangle[2] != triangle[0] ) )
+				{
+					indices.insert( indices.end(), std::begin( triangle ), std::end( triangle ) );
+				}
+			}
+		}
+
+		float maximumError = 0.0f;
+		{
+			const auto bounds = CalculateBounds( i_vertexData, nullptr, i_vertexCount );
+			maximumError = bounds.radius * s_maximumOccluderError;
+		}
+		const auto targetIndexCount = static_cast<size_t>( indices.size() * i_triangleRatio ) / 3 * 3;
+		float error = 0.0f;
+		const auto indexCount = MeshSimplification::Simplify( indices.data(), indices.size(),
+			weldedPositions.data(), sizeof( float ) * 3, weldedVertexCount, targetIndexCount, maximumError, error );
+
+		// Only the positions that are still used are kept (in the order that they are used)
+		std::vector<uint32_t> remappedVertices( weldedVertexCount, std::numeric_limits<uint32_t>::max() );
+		o_indices.resize( indexCount );
+		for ( size_t i = 0; i < indexCount; ++i )
+		{
+			auto& remappedVertex = remappedVertices[indices[i]];
+			if ( remappedVertex == std::numeric_limits<uint32_t>::max() )
+			{
+				remappedVertex = static_cast<uint32_t>( o_positions.size() / 3 );
+				o_positions.insert( o_positions.end(), weldedPositions.begin() + ( indices[i] * 3 ), weldedPositions.begin() + ( indices[i] * 3 ) + 3 );
+			}
+			o_indices[i] = remappedVertex;
+		}
+
+		eae6320::Assets::OutputMessage( "%s: The occluder has %u triangles (error %g)", i_path,
+			static_cast<unsigned int>( indexCount / 3 ), error );
+
+		return eae6320::Results::Success;
+	}
+
+	void GenerateMeshlets( const char* const i_path, const sVertex_mesh* i_vertexData, const void* i_indices, const uint32_t i_indexCount, const uint32_t i_vertexCount,
+		const std::vector<eae6320::Graphics::MeshFormats::sSubmesh>& i_submeshes, std::vector<eae6320::Graphics::MeshFormats::sMeshlet>& o_meshlets )
+	{
+		using namespace eae6320::Graphics;
+
+		o_meshlets.clear();
+
+		const auto is32 = i_indexCount > std::numeric_limits<uint16_t>::max();
+		const auto GetIndex = [i_indices, is32]( const size_t i_index ) -> uint32_t
+		{
+			return is32 ? static_cast<const uint32_t*>( i_indices )[i_index] : static_cast<const uint16_t*>( i_indices )[i_index];
+		};
+
+		// Each vertex remembers the last meshlet that used it
+		// so that a meshlet's unique vertices can be counted without searching
+		constexpr auto noMeshlet = std::numeric_limits<uint32_t>::max();
+		std::vector<uint32_t> vertexMeshlets( i_vertexCount, noMeshlet );
+		std::vector<uint32_t> meshletVertices;
+		meshletVertices.reserve( MeshFormats::maxMeshletVertexCount );
+		std::vector<float> triangleNormals;
+		triangleNormals.reserve( MeshFormats::maxMeshletTriangleCount * 3 );
+		uint32_t backFacingMeshletCount = 0;
+
+		const auto FinishMeshlet = [&]( MeshFormats::sMeshlet& io_meshlet )
+		{
+			const auto bounds = CalculateBounds( i_vertexData, meshletVertices.data(), meshletVertices.size() );
+			std::copy( std::begin( bounds.center ), std::end( bounds.center ), io_meshlet.center );
+			io_meshlet.radius = bounds.radius;
+
+			// Front faces are clockwise,
+			// and so a triangle's outward normal is ( c - a ) x ( b - a )
+			// (degenerate triangles are never drawn and so they don't constrain the cone)
+			float axis[3] = {};
+			triangleNormals.clear();
+			for ( auto i = io_meshlet.firstIndex; i < ( io_meshlet.firstIndex + io_meshlet.indexCount ); i += 3 )
+			{
+				const auto& a = i_vertexData[GetIndex( i )];
+				const auto& b = i_vertexData[GetIndex( i + 1 )];
+				const auto& c = i_vertexData[GetIndex( i + 2 )];
+				const float ab[] = { b.x - a.x, b.y - a.y, b.z - a.z };
+				const float ac[] = { c.x - a.x, c.y - a.y, c.z - a.z };
+				float normal[] = { ( ac[1] * ab[2] ) - ( ac[2] * ab[1] ), ( ac[2] * ab[0] ) - ( ac[0] * ab[2] ), ( ac[0] * ab[1] ) - ( ac[1] * ab[0] ) };
+				const auto length = std::sqrt( ( normal[0] * normal[0] ) + ( normal[1] * normal[1] ) + ( normal[2] * normal[2] ) );
+				if ( length <= 1.0e-12f )
+				{
+					continue;
+				}
+				for ( size_t j = 0; j < 3; ++j )
+				{
+					normal[j] /= length;
+					axis[j] += normal[j];
+				}
+				triangleNormals.insert( triangleNormals.end(), std::begin( normal ), std::end( normal ) );
+			}
+			const auto axisLength = std::sqrt( ( axis[0] * axis[0] ) + ( axis[1] * axis[1] ) + ( axis[2] * axis[2] ) );
+			if ( triangleNormals.empty() || ( axisLength <= 1.0e-6f ) )
+			{
+				return;
+			}
+			float minimumDot = 1.0f;
+			for ( size_t j = 0; j < 3; ++j )
+			{
+				io_meshlet.coneAxis[j] = axis[j] / axisLength;
+			}
+			for ( size_t i = 0; i < triangleNormals.size(); i += 3 )
+			{
+				minimumDot = std::min( minimumDot, ( triangleNormals[i] * io_meshlet.coneAxis[0] )
+					+ ( triangleNormals[i + 1] * io_meshlet.coneAxis[1] ) + ( triangleNormals[i + 2] * io_meshlet.coneAxis[2] ) );
+			}
+			// The cutoff is the sine of the cone's half angle
+			// (a cone that is close to a hemisphere is never back-facing from anywhere that matters)
+			if ( minimumDot > 0.1f )
+			{
+				io_meshlet.coneCutoff = std::sqrt( 1.0f - ( minimumDot * minimumDot ) );
+				++backFacingMeshletCount;
+			}
+		};
+
+		for ( const auto& submesh : i_submeshes )
+		{
+			auto isMeshletOpen = false;
+			const auto index_end = submesh.firstIndex + submesh.indexCount;
+			for ( auto i = submesh.firstIndex; ( i + 2 ) < index_end; i += 3 )
+			{
+				const uint32_t triangle[] = { GetIndex( i ), GetIndex( i + 1 ), GetIndex( i + 2 ) };
+				// A triangle that would make the current meshlet too big starts a new one
+				if ( isMeshletOpen )
+				{
+					const auto meshletId = static_cast<uint32_t>( o_meshlets.size() - 1 );
+					size_t newVertexCount = 0;
+					for ( size_t j = 0; j < 3; ++j )
+					{
+						const auto isDuplicate = ( ( j > 0 ) && ( triangle[j] == triangle[0] ) ) || ( ( j > 1 ) && ( triangle[j] == triangle[1] ) );
+						newVertexCount += ( ( vertexMeshlets[triangle[j]] != meshletId ) && !isDuplicate ) ? 1 : 0;
+					}
+					if ( ( ( meshletVertices.size() + newVertexCount ) > MeshFormats::maxMeshletVertexCount )
+						|| ( ( ( o_meshlets.back().indexCount / 3 ) + 1 ) > MeshFormats::maxMeshletTriangleCount ) )
+					{
+						FinishMeshlet( o_meshlets.back() );
+						isMeshletOpen = false;
+					}
+				}
+				if ( !isMeshletOpen )
+				{
+					o_meshlets.emplace_back();
+					o_meshlets.back().firstIndex = i;
+					meshletVertices.clear();
+					isMeshletOpen = true;
+				}
+				const auto meshletId = static_cast<uint32_t>( o_meshlets.size() - 1 );
+				for ( const auto vertex : triangle )
+				{
+					if ( vertexMeshlets[vertex] != meshletId )
+					{
+						vertexMeshlets[vertex] = meshletId;
+						meshletVertices.push_back( vertex );
+					}
+				}
+				o_meshlets.back().indexCount += 3;
+			}
+			if ( isMeshletOpen )
+			{
+				FinishMeshlet( o_meshlets.back() );
+			}
+		}
+
+		if ( !o_meshlets.empty() )
+		{
+			eae6320::Assets::OutputMessage( "%s: The mesh has %u meshlets (%.1f triangles each on average, %u with a normal cone)", i_path,
+				static_cast<unsigned int>( o_meshlets.size() ), static_cast<double>( i_indexCount ) / ( 3.0 * o_meshlets.size() ), backFacingMeshletCount );
+		}
+	}
+
+	eae6320::Graphics::MeshFormats::sBounds CalculateBounds( const sVertex_mesh* i_vertexData, const uint32_t* i_vertexIndices, const size_t i_count )
+	{
+		eae6320::Graphics::MeshFormats::sBounds bounds;
+		const auto GetPosition = [i_vertexData, i_vertexIndices]( const size_t i_index )
+		{
+			return &i_vertexData[i_vertexIndices ? i_vertexIndices[i_index] : i_index].x;
+		};
+
+		for ( size_t i = 0; i < i_count; ++i )
+		{
+			const auto* const position = GetPosition( i );
+			for ( size_t j = 0; j < 3; ++j )
+			{
+				bounds.minimum[j] = ( ( i == 0 ) || ( position[j] < bounds.minimum[j] ) ) ? position[j] : bounds.minimum[j];
+				bounds.maximum[j] = ( ( i == 0 ) || ( position[j] > bounds.maximum[j] ) ) ? position[j] : bounds.maximum[j];
+			}
+		}
+		// The sphere is centered on the box
+		// (which is never much bigger than the smallest sphere for the meshes that the game uses)
+		for ( size_t j = 0; j < 3; ++j )
+		{
+			bounds.center[j] = ( bounds.minimum[j] + bounds.maximum[j] ) * 0.5f;
+		}
+		float radiusSquared = 0.0f;
+		for ( size_t i = 0; i < i_count; ++i )
+		{
+			const auto* const position = GetPosition( i );
+			const float offset[] = { position[0] - bounds.center[0], position[1] - bounds.center[1], position[2] - bounds.center[2] };
+			radiusSquared = std::max( radiusSquared, ( offset[0] * offset[0] ) + ( offset[1] * offset[1] ) + ( offset[2] * offset[2] ) );
+		}
+		bounds.radius = std::sqrt( radiusSquared );
+
+		return bounds;
+	}
+
+	void EncodeVertex( const sVertex_mesh& i_vertex, const eae6320::Graphics::MeshFormats::sBounds& i_bounds, eae6320::Graphics::VertexFormats::sVertex_mesh& o_vertex )
+	{
+		const auto Dot = []( const float* const i_lhs, const float* const i_rhs )
+		{
+			return ( i_lhs[0] * i_rhs[0] ) + ( i_lhs[1] * i_rhs[1] ) + ( i_lhs[2] * i_rhs[2] );
+		};
+		const auto Cross = []( const float* const i_lhs, const float* const i_rhs, float* const o_result )
+		{
+			o_result[0] = ( i_lhs[1] * i_rhs[2] ) - ( i_lhs[2] * i_rhs[1] );
+			o_result[1] = ( i_lhs[2] * i_rhs[0] ) - ( i_lhs[0] * i_rhs[2] );
+			o_result[2] = ( i_lhs[0] * i_rhs[1] ) - ( i_lhs[1] * i_rhs[0] );
+		};
+		const auto Normalize = [&Dot]( float* const io_vector )
+		{
+			const auto length = std::sqrt( Dot( io_vector, io_vector ) );
+			if ( length <= 1.0e-6f )
+			{
+				return false;
+			}
+			for ( size_t i = 0; i < 3; ++i )
+			{
+				io_vector[i] /= length;
+			}
+			return true;
+		};
+		const auto ConvertToSnorm16 = []( const float i_value )
+		{
+			const auto value = ( i_value < -1.0f ) ? -1.0f : ( ( i_value > 1.0f ) ? 1.0f : i_value );
+			return static_cast<int16_t>( std::lround( value * 32767.0f ) );
+		};
+
+		// Position
+		{
+			const float position[] = { i_vertex.x, i_vertex.y, i_vertex.z };
+			uint16_t* const quantizedPosition[] = { &o_vertex.x, &o_vertex.y, &o_vertex.z };
+			for ( size_t i = 0; i < 3; ++i )
+			{
+				const auto extent = i_bounds.maximum[i] - i_bounds.minimum[i];
+				const auto t = ( extent > 0.0f ) ? ( ( position[i] - i_bounds.minimum[i] ) / extent ) : 0.0f;
+				*quantizedPosition[i] = static_cast<uint16_t>( std::lround( ( ( t < 0.0f ) ? 0.0f : ( ( t > 1.0f ) ? 1.0f : t ) ) * 65535.0f ) );
+			}
+			o_vertex.padding = 0;
+		}
+		// Tangent frame
+		{
+			// Make the authored frame orthonormal
+			// (if the authored vectors are degenerate any tangent perpendicular to the normal is used)
+			float normal[] = { i_vertex.nx, i_vertex.ny, i_vertex.nz };
+			if ( !Normalize( normal ) )
+			{
+				normal[0] = 0.0f; normal[1] = 0.0f; normal[2] = 1.0f;
+			}
+			float tangent[] = { i_vertex.tx, i_vertex.ty, i_vertex.tz };
+			{
+				const auto projection = Dot( tangent, normal );
+				for ( size_t i = 0; i < 3; ++i )
+				{
+					tangent[i] -= normal[i] * projection;
+				}
+			}
+			if ( !Normalize( tangent ) )
+			{
+				const float axis[] = { ( std::abs( normal[0] ) < 0.9f ) ? 1.0f : 0.0f, ( std::abs( normal[0] ) < 0.9f ) ? 0.0f : 1.0f, 0.0f };
+				float bitangent[3];
+				Cross( normal, axis, bitangent );
+				Cross( bitangent, normal, tangent );
+				Normalize( tangent );
+			}
+			float bitangent[3];
+			Cross( normal, tangent, bitangent );
+			const float authoredBitangent[] = { i_vertex.btx, i_vertex.bty, i_vertex.btz };
+			const auto isMirrored = Dot( bitangent, authoredBitangent ) < 0.0f;
+
+			// Convert the rotation matrix whose columns are the tangent, bitangent, and normal into a quaternion
+			float q[4];	// x, y, z, w
+			{
+				const auto trace = tangent[0] + bitangent[1] + normal[2];
+				if ( trace > 0.0f )
+				{
+					const auto s = std::sqrt( trace + 1.0f ) * 2.0f;
+					q[3] = 0.25f * s;
+					q[0] = ( bitangent[2] - normal[1] ) / s;
+					q[1] = ( normal[0] - tangent[2] ) / s;
+					q[2] = ( tangent[1] - bitangent[0] ) / s;
+				}
+				else if ( ( tangent[0] > bitangent[1] ) && ( tangent[0] > normal[2] ) )
+				{
+					const auto s = std::sqrt( 1.0f + tangent[0] - bitangent[1] - normal[2] ) * 2.0f;
+					q[3] = ( bitangent[2] - normal[1] ) / s;
+					q[0] = 0.25f * s;
+					q[1] = ( bitangent[0] + tangent[1] ) / s;
+					q[2] = ( normal[0] + tangent[2] ) / s;
+				}
+				else if ( bitangent[1] > normal[2] )
+				{
+					const auto s = std::sqrt( 1.0f + bitangent[1] - tangent[0] - normal[2] ) * 2.0f;
+					q[3] = ( normal[0] - tangent[2] ) / s;
+					q[0] = ( bitangent[0] + tangent[1] ) / s;
+					q[1] = 0.25f * s;
+					q[2] = ( normal[1] + bitangent[2] ) / s;
+				}
+				else
+				{
+					const auto s = std::sqrt( 1.0f + normal[2] - tangent[0] - bitangent[1] ) * 2.0f;
+					q[3] = ( tangent[1] - bitangent[0] ) / s;
+					q[0] = ( normal[0] + tangent[2] ) / s;
+					q[1] = ( normal[1] + bitangent[2] ) / s;
+					q[2] = 0.25f * s;
+				}
+			}
+			// q and -q are the same rotation,
+			// and so the sign of w is free to store whether the bitangent is mirrored
+			// (w must not quantize to zero, though, since zero has no sign)
+			{
+				const auto sign = ( q[3] < 0.0f ) ? -1.0f : 1.0f;
+				for ( auto& component : q )
+				{
+					component *= sign;
+				}
+				constexpr auto minimumW = 1.0f / 32767.0f;
+				if ( q[3] < minimumW )
+				{
+					const auto scale = std::sqrt( 1.0f - ( minimumW * minimumW ) );
+					for ( size_t i = 0; i < 3; ++i )
+					{
+						q[i] *= scale;
+					}
+					q[3] = minimumW;
+				}
+				if ( isMirrored )
+				{
+					for ( auto& component : q )
+					{
+						component = -component;
+					}
+				}
+			}
+			o_vertex.qx = ConvertToSnorm16( q[0] );
+			o_vertex.qy = ConvertToSnorm16( q[1] );
+			o_vertex.qz = ConvertToSnorm16( q[2] );
+			o_vertex.qw = ConvertToSnorm16( q[3] );
+		}
+		// Texture coordinates
+		o_vertex.u = eae6320::Math::ConvertFloatToHalf( i_vertex.u );
+		o_vertex.v = eae6320::Math::ConvertFloatToHalf( i_vertex.v );
+		// Color
+		o_vertex.r = i_vertex.r;
+		o_vertex.g = i_vertex.g;
+		o_vertex.b = i_vertex.b;
+		o_vertex.a = i_vertex.a;
+	}
+
 	void GetFilePathandFileName( const std::string& i_path, std::string& o_path, std::string& o_filename )
 	{
 		std::string::size_type found = i_path.find_last_of( "/\\" );
@@ -1384,4 +2307,9 @@ namespace
 			o_filename = i_path;
 		}
 	}
+
+	std::string GetBuiltTextureName( const std::string& i_fileName )
+	{
+		return i_fileName.substr( 0, i_fileName.find_last_of( '.' ) ) + ".tex";
+	}
 }
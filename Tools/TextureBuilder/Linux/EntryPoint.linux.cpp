@@ -0,0 +1,98 @@
+/*
+	This is a command line version of TextureBuilder
+	that doesn't depend on the Windows-only engine projects
+	so that textures can be batch-converted on Linux (e.g. by a build server)
+
+	It isn't part of the Visual Studio solution; from the repository's root directory it can be built with:
+		g++ -std=c++17 -O2 -pthread -I. Tools/TextureBuilder/Linux/EntryPoint.linux.cpp Tools/TextureBuilder/TextureEncoding.cpp -o TextureBuilder
+
+	Usage:
+		TextureBuilder sourcePath targetPath [bc1|bc3|bc5|bc7] [linear]
+*/
+
+// Includes
+//=========
+
+#include "../TextureEncoding.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <Engine/Platform/stb_image.h>
+
+// Entry Point
+//============
+
+int main( int i_argumentCount, char** i_arguments )
+{
+	using namespace eae6320::Assets;
+
+	if ( i_argumentCount < 3 )
+	{
+		std::fprintf( stderr, "Usage: %s sourcePath targetPath [bc1|bc3|bc5|bc7] [linear]\n", i_arguments[0] );
+		return EXIT_FAILURE;
+	}
+	const auto* const path_source = i_arguments[1];
+	const auto* const path_target = i_arguments[2];
+	auto format = eae6320::Graphics::TextureFormats::eFormat::BC7;
+	auto isSRGB = true;
+	for ( int i = 3; i < i_argumentCount; ++i )
+	{
+		const std::string argument( i_arguments[i] );
+		if ( argument == "linear" )
+		{
+			isSRGB = false;
+		}
+		else if ( !TextureEncoding::ParseFormat( argument, format ) )
+		{
+			std::fprintf( stderr, "%s: error: Unknown texture builder argument \"%s\"\n", path_source, argument.c_str() );
+			return EXIT_FAILURE;
+		}
+	}
+
+	// Decode the source image
+	// (it is flipped the same way that the engine's texture loading flips it)
+	TextureEncoding::sImage image;
+	{
+		stbi_set_flip_vertically_on_load( true );
+		int width = 0, height = 0, componentCount = 0;
+		constexpr int requiredComponentCount = 4;
+		auto* const decodedData = stbi_load( path_source, &width, &height, &componentCount, requiredComponentCount );
+		if ( !decodedData )
+		{
+			std::fprintf( stderr, "%s: error: Failed to decode the image (%s)\n", path_source, stbi_failure_reason() );
+			return EXIT_FAILURE;
+		}
+		image.width = static_cast<uint32_t>( width );
+		image.height = static_cast<uint32_t>( height );
+		image.texels.assign( decodedData, decodedData + ( static_cast<size_t>( width ) * height * requiredComponentCount ) );
+		stbi_image_free( decodedData );
+	}
+
+	// Build and write the texture
+	std::vector<uint8_t> builtTexture;
+	{
+		const auto time_start = std::chrono::steady_clock::now();
+		std::string errorMessage;
+		if ( !TextureEncoding::BuildTexture( image, format, isSRGB, builtTexture, &errorMessage ) )
+		{
+			std::fprintf( stderr, "%s: error: %s\n", path_source, errorMessage.c_str() );
+			return EXIT_FAILURE;
+		}
+		const auto duration = std::chrono::duration<double>( std::chrono::steady_clock::now() - time_start ).count();
+		std::printf( "Built %s (%u x %u) into %zu bytes in %.3f seconds\n", path_source, image.width, image.height, builtTexture.size(), duration );
+	}
+	{
+		std::ofstream targetFile( path_target, std::ofstream::binary );
+		if ( !targetFile.write( reinterpret_cast<const char*>( builtTexture.data() ), static_cast<std::streamsize>( builtTexture.size() ) ) )
+		{
+			std::fprintf( stderr, "%s: error: Failed to write the built texture\n", path_target );
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,764 @@
+// Includes
+//=========
+
+#include "TextureEncoding.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	using eae6320::Assets::TextureEncoding::sImage;
+	namespace TextureFormats = eae6320::Graphics::TextureFormats;
+
+	constexpr unsigned int s_texelCountPerBlock = TextureFormats::blockWidth * TextureFormats::blockWidth;
+
+	// A block of texels with components in the [0,255] range
+	struct sTexelBlock
+	{
+		float texels[s_texelCountPerBlock][4];
+	};
+
+	// Writes bits from the least significant to the most significant
+	class cBitWriter
+	{
+	public:
+
+		void Write( const uint32_t i_value, const unsigned int i_bitCount );
+
+		explicit cBitWriter( uint8_t* const o_data ) : m_data( o_data ) {}
+
+	private:
+
+		uint8_t* const m_data;
+		unsigned int m_bitPosition = 0;
+	};
+
+	// Mip Generation
+	//---------------
+
+	float ConvertSrgbToLinear( const uint8_t i_value );
+	uint8_t ConvertLinearToSrgb( const float i_value );
+	uint8_t ConvertToUnorm8( const float i_value );
+	// Filters one dimension of an image with a tent filter whose width matches the reduction
+	void Downsample( const std::vector<float>& i_texels, const uint32_t i_width, const uint32_t i_height,
+		const bool i_isHorizontal, const uint32_t i_newLength, std::vector<float>& o_texels );
+
+	// Block Encoding
+	//---------------
+
+	void LoadBlock( const sImage& i_mip, const uint32_t i_blockX, const uint32_t i_blockY, sTexelBlock& o_block );
+	// Finds the mean and the direction of greatest variance of the first i_componentCount components
+	// of the texels that aren't excluded
+	void FindPrincipalAxis( const sTexelBlock& i_block, const unsigned int i_componentCount, const bool* const i_isTexelExcluded,
+		float( &o_mean )[4], float( &o_axis )[4] );
+	void EncodeBlock( const TextureFormats::eFormat i_format, const sTexelBlock& i_block, uint8_t* const o_block );
+	void EncodeBlock_bc1( const sTexelBlock& i_block, const bool i_isPunchThroughAlphaAllowed, uint8_t* const o_block );
+	void EncodeBlock_bc4( const float( &i_values )[s_texelCountPerBlock], uint8_t* const o_block );
+	// BC7 is encoded with mode 6 (a single subset of RGBA endpoints with 4 bit indices)
+	void EncodeBlock_bc7( const sTexelBlock& i_block, uint8_t* const o_block );
+}
+
+// Interface
+//==========
+
+void eae6320::Assets::TextureEncoding::GenerateMipChain( const sImage& i_image, const bool i_isSRGB, std::vector<sImage>& o_mipChain )
+{
+	o_mipChain.clear();
+	o_mipChain.push_back( i_image );
+
+	// Every mip is filtered from the full precision version of the previous one
+	// (so that quantization errors don't accumulate)
+	auto width = i_image.width;
+	auto height = i_image.height;
+	std::vector<float> texels( static_cast<size_t>( width ) * height * 4 );
+	for ( size_t i = 0; i < texels.size(); ++i )
+	{
+		const auto isAlpha = ( i % 4 ) == 3;
+		texels[i] = ( i_isSRGB && !isAlpha ) ? ConvertSrgbToLinear( i_image.texels[i] ) : ( i_image.texels[i] / 255.0f );
+	}
+
+	std::vector<float> texels_filtered;
+	while ( ( width > 1 ) || ( height > 1 ) )
+	{
+		const auto newWidth = TextureFormats::GetMipDimension( width, 1 );
+		const auto newHeight = TextureFormats::GetMipDimension( height, 1 );
+		Downsample( texels, width, height, true, newWidth, texels_filtered );
+		Downsample( texels_filtered, newWidth, height, false, newHeight, texels );
+		width = newWidth;
+		height = newHeight;
+
+		sImage mip;
+		mip.width = width;
+		mip.height = height;
+		mip.texels.resize( texels.size() );
+		for ( size_t i = 0; i < texels.size(); ++i )
+		{
+			const auto isAlpha = ( i % 4 ) == 3;
+			mip.texels[i] = ( i_isSRGB && !isAlpha ) ? ConvertLinearToSrgb( texels[i] ) : ConvertToUnorm8( texels[i] );
+		}
+		o_mipChain.push_back( std::move( mip ) );
+	}
+}
+
+void eae6320::Assets::TextureEncoding::EncodeMip( const Graphics::TextureFormats::eFormat i_format, const sImage& i_mip, uint8_t* const o_blocks,
+	const unsigned int i_threadCount )
+{
+	const auto blockCount_horizontal = TextureFormats::GetBlockCount( i_mip.width );
+	const auto blockCount_vertical = TextureFormats::GetBlockCount( i_mip.height );
+	const auto bytesPerBlock = TextureFormats::GetBytesPerBlock( i_format );
+
+	const auto EncodeRows = [&i_mip, i_format, o_blocks, blockCount_horizontal, blockCount_vertical, bytesPerBlock](
+		const uint32_t i_firstRow, const uint32_t i_rowStride )
+	{
+		sTexelBlock block;
+		for ( auto blockY = i_firstRow; blockY < blockCount_vertical; blockY += i_rowStride )
+		{
+			for ( uint32_t blockX = 0; blockX < blockCount_horizontal; ++blockX )
+			{
+				LoadBlock( i_mip, blockX, blockY, block );
+				EncodeBlock( i_format, block,
+					o_blocks + ( ( static_cast<size_t>( blockY ) * blockCount_horizontal ) + blockX ) * bytesPerBlock );
+			}
+		}
+	};
+
+	// The rows are interleaved between the threads
+	// so that every thread gets a similar amount of work
+	auto threadCount = ( i_threadCount > 0 ) ? i_threadCount : std::max( std::thread::hardware_concurrency(), 1u );
+	threadCount = std::min( threadCount, blockCount_vertical );
+	if ( threadCount > 1 )
+	{
+		std::vector<std::thread> threads;
+		threads.reserve( threadCount - 1 );
+		for ( unsigned int i = 1; i < threadCount; ++i )
+		{
+			threads.emplace_back( EncodeRows, i, threadCount );
+		}
+		EncodeRows( 0, threadCount );
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+	}
+	else
+	{
+		EncodeRows( 0, 1 );
+	}
+}
+
+eae6320::cResult eae6320::Assets::TextureEncoding::BuildTexture( const sImage& i_image, const Graphics::TextureFormats::eFormat i_format, const bool i_isSRGB,
+	std::vector<uint8_t>& o_builtTexture, std::string* const o_errorMessage )
+{
+	if ( ( i_image.width == 0 ) || ( i_image.height == 0 ) || ( i_image.texels.size() != ( static_cast<size_t>( i_image.width ) * i_image.height * 4 ) ) )
+	{
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = "The image must have at least one texel and 4 components per texel";
+		}
+		return Results::InvalidFile;
+	}
+	if ( i_format >= TextureFormats::eFormat::Count )
+	{
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = "The texture format is invalid";
+		}
+		return Results::Failure;
+	}
+
+	std::vector<sImage> mipChain;
+	GenerateMipChain( i_image, i_isSRGB, mipChain );
+
+	TextureFormats::sHeader header;
+	{
+		header.format = i_format;
+		header.mipCount = static_cast<uint8_t>( mipChain.size() );
+		header.flags = i_isSRGB ? TextureFormats::IsSRGB : 0;
+		header.width = i_image.width;
+		header.height = i_image.height;
+	}
+	size_t size = sizeof( header );
+	for ( const auto& mip : mipChain )
+	{
+		size += TextureFormats::GetMipSize( i_format, mip.width, mip.height );
+	}
+
+	o_builtTexture.resize( size );
+	std::memcpy( o_builtTexture.data(), &header, sizeof( header ) );
+	auto offset = sizeof( header );
+	for ( const auto& mip : mipChain )
+	{
+		EncodeMip( i_format, mip, o_builtTexture.data() + offset );
+		offset += TextureFormats::GetMipSize( i_format, mip.width, mip.height );
+	}
+
+	return Results::Success;
+}
+
+bool eae6320::Assets::TextureEncoding::ParseFormat( const std::string& i_name, Graphics::TextureFormats::eFormat& o_format )
+{
+	std::string name( i_name );
+	std::transform( name.begin(), name.end(), name.begin(), []( const char i_character )
+		{
+			return static_cast<char>( std::tolower( static_cast<unsigned char>( i_character ) ) );
+		} );
+	if ( name == "bc1" )
+	{
+		o_format = TextureFormats::eFormat::BC1;
+	}
+	else if ( name == "bc3" )
+	{
+		o_format = TextureFormats::eFormat::BC3;
+	}
+	else if ( name == "bc5" )
+	{
+		o_format = TextureFormats::eFormat::BC5;
+	}
+	else if ( name == "bc7" )
+	{
+		o_format = TextureFormats::eFormat::BC7;
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	void cBitWriter::Write( const uint32_t i_value, const unsigned int i_bitCount )
+	{
+		for ( unsigned int i = 0; i < i_bitCount; ++i, ++m_bitPosition )
+		{
+			if ( ( i_value >> i ) & 1 )
+			{
+				m_data[m_bitPosition / 8] |= static_cast<uint8_t>( 1u << ( m_bitPosition % 8 ) );
+			}
+		}
+	}
+
+	// Mip Generation
+	//---------------
+
+	float ConvertSrgbToLinear( const uint8_t i_value )
+	{
+		static const auto s_table = []
+		{
+			std::vector<float> table( 256 );
+			for ( size_t i = 0; i < table.size(); ++i )
+			{
+				const auto value = static_cast<float>( i ) / 255.0f;
+				table[i] = ( value <= 0.04045f ) ? ( value / 12.92f ) : std::pow( ( value + 0.055f ) / 1.055f, 2.4f );
+			}
+			return table;
+		}();
+		return s_table[i_value];
+	}
+
+	uint8_t ConvertLinearToSrgb( const float i_value )
+	{
+		const auto value = std::min( std::max( i_value, 0.0f ), 1.0f );
+		return ConvertToUnorm8( ( value <= 0.0031308f ) ? ( value * 12.92f ) : ( ( 1.055f * std::pow( value, 1.0f / 2.4f ) ) - 0.055f ) );
+	}
+
+	uint8_t ConvertToUnorm8( const float i_value )
+	{
+		return static_cast<uint8_t>( ( std::min( std::max( i_value, 0.0f ), 1.0f ) * 255.0f ) + 0.5f );
+	}
+
+	void Downsample( const std::vector<float>& i_texels, const uint32_t i_width, const uint32_t i_height,
+		const bool i_isHorizontal, const uint32_t i_newLength, std::vector<float>& o_texels )
+	{
+		const auto length = i_isHorizontal ? i_width : i_height;
+		const auto newWidth = i_isHorizontal ? i_newLength : i_width;
+		const auto newHeight = i_isHorizontal ? i_height : i_newLength;
+		o_texels.assign( static_cast<size_t>( newWidth ) * newHeight * 4, 0.0f );
+
+		// The tent covers every source texel that overlaps the destination texel
+		// (when halving this is the familiar [1 3 3 1] / 8 kernel)
+		const auto scale = static_cast<float>( length ) / static_cast<float>( i_newLength );
+		for ( uint32_t destination = 0; destination < i_newLength; ++destination )
+		{
+			const auto center = ( ( static_cast<float>( destination ) + 0.5f ) * scale ) - 0.5f;
+			const auto first = static_cast<int>( std::floor( center - scale ) );
+			const auto last = static_cast<int>( std::ceil( center + scale ) );
+			float weights[64];
+			int sources[64];
+			unsigned int tapCount = 0;
+			float weightSum = 0.0f;
+			for ( auto source = first; ( source <= last ) && ( tapCount < 64 ); ++source )
+			{
+				const auto weight = 1.0f - ( std::abs( static_cast<float>( source ) - center ) / scale );
+				if ( weight > 0.0f )
+				{
+					// Textures repeat by default and so the filter wraps around the edges
+					sources[tapCount] = ( ( source % static_cast<int>( length ) ) + static_cast<int>( length ) ) % static_cast<int>( length );
+					weights[tapCount] = weight;
+					weightSum += weight;
+					++tapCount;
+				}
+			}
+			for ( unsigned int i = 0; i < tapCount; ++i )
+			{
+				weights[i] /= weightSum;
+			}
+
+			const auto otherLength = i_isHorizontal ? i_height : i_width;
+			for ( uint32_t other = 0; other < otherLength; ++other )
+			{
+				const auto destinationIndex = i_isHorizontal
+					? ( ( static_cast<size_t>( other ) * newWidth ) + destination ) : ( ( static_cast<size_t>( destination ) * newWidth ) + other );
+				auto* const destinationTexel = &o_texels[destinationIndex * 4];
+				for ( unsigned int i = 0; i < tapCount; ++i )
+				{
+					const auto sourceIndex = i_isHorizontal
+						? ( ( static_cast<size_t>( other ) * i_width ) + sources[i] ) : ( ( static_cast<size_t>( sources[i] ) * i_width ) + other );
+					const auto* const sourceTexel = &i_texels[sourceIndex * 4];
+					for ( unsigned int c = 0; c < 4; ++c )
+					{
+						destinationTexel[c] += sourceTexel[c] * weights[i];
+					}
+				}
+			}
+		}
+	}
+
+	// Block Encoding
+	//---------------
+
+	void LoadBlock( const sImage& i_mip, const uint32_t i_blockX, const uint32_t i_blockY, sTexelBlock& o_block )
+	{
+		// Blocks that hang over the edge of a small mip repeat the edge texels
+		for ( uint32_t y = 0; y < TextureFormats::blockWidth; ++y )
+		{
+			const auto sourceY = std::min( ( i_blockY * TextureFormats::blockWidth ) + y, i_mip.height - 1 );
+			for ( uint32_t x = 0; x < TextureFormats::blockWidth; ++x )
+			{
+				const auto sourceX = std::min( ( i_blockX * TextureFormats::blockWidth ) + x, i_mip.width - 1 );
+				const auto* const texel = &i_mip.texels[( ( static_cast<size_t>( sourceY ) * i_mip.width ) + sourceX ) * 4];
+				for ( unsigned int c = 0; c < 4; ++c )
+				{
+					o_block.texels[( y * TextureFormats::blockWidth ) + x][c] = texel[c];
+				}
+			}
+		}
+	}
+
+	void FindPrincipalAxis( const sTexelBlock& i_block, const unsigned int i_componentCount, const bool* const i_isTexelExcluded,
+		float( &o_mean )[4], float( &o_axis )[4] )
+	{
+		float minimum[4] = { 255.0f, 255.0f, 255.0f, 255.0f };
+		float maximum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		unsigned int texelCount = 0;
+		for ( auto& component : o_mean )
+		{
+			component = 0.0f;
+		}
+		for ( unsigned int i = 0; i < s_texelCountPerBlock; ++i )
+		{
+			if ( !i_isTexelExcluded || !i_isTexelExcluded[i] )
+			{
+				for ( unsigned int c = 0; c < i_componentCount; ++c )
+				{
+					o_mean[c] += i_block.texels[i][c];
+					minimum[c] = std::min( minimum[c], i_block.texels[i][c] );
+					maximum[c] = std::max( maximum[c], i_block.texels[i][c] );
+				}
+				++texelCount;
+			}
+		}
+		for ( unsigned int c = 0; c < 4; ++c )
+		{
+			o_mean[c] = ( ( c < i_componentCount ) && ( texelCount > 0 ) ) ? ( o_mean[c] / static_cast<float>( texelCount ) ) : 0.0f;
+		}
+
+		float covariance[4][4] = {};
+		for ( unsigned int i = 0; i < s_texelCountPerBlock; ++i )
+		{
+			if ( !i_isTexelExcluded || !i_isTexelExcluded[i] )
+			{
+				for ( unsigned int r = 0; r < i_componentCount; ++r )
+				{
+					for ( unsigned int c = 0; c < i_componentCount; ++c )
+					{
+						covariance[r][c] += ( i_block.texels[i][r] - o_mean[r] ) * ( i_block.texels[i][c] - o_mean[c] );
+					}
+				}
+			}
+		}
+
+		// Power iteration starting from the diagonal of the bounding box
+		for ( unsigned int c = 0; c < 4; ++c )
+		{
+			o_axis[c] = ( c < i_componentCount ) ? ( maximum[c] - minimum[c] ) : 0.0f;
+		}
+		for ( unsigned int iteration = 0; iteration < 8; ++iteration )
+		{
+			float axis[4] = {};
+			for ( unsigned int r = 0; r < i_componentCount; ++r )
+			{
+				for ( unsigned int c = 0; c < i_componentCount; ++c )
+				{
+					axis[r] += covariance[r][c] * o_axis[c];
+				}
+			}
+			float length = 0.0f;
+			for ( unsigned int c = 0; c < i_componentCount; ++c )
+			{
+				length = std::max( length, std::abs( axis[c] ) );
+			}
+			if ( length <= 0.0f )
+			{
+				break;
+			}
+			for ( unsigned int c = 0; c < i_componentCount; ++c )
+			{
+				o_axis[c] = axis[c] / length;
+			}
+		}
+		float lengthSquared = 0.0f;
+		for ( unsigned int c = 0; c < i_componentCount; ++c )
+		{
+			lengthSquared += o_axis[c] * o_axis[c];
+		}
+		if ( lengthSquared > 0.0f )
+		{
+			const auto length = std::sqrt( lengthSquared );
+			for ( unsigned int c = 0; c < i_componentCount; ++c )
+			{
+				o_axis[c] /= length;
+			}
+		}
+	}
+
+	void EncodeBlock( const TextureFormats::eFormat i_format, const sTexelBlock& i_block, uint8_t* const o_block )
+	{
+		switch ( i_format )
+		{
+		case TextureFormats::eFormat::BC1:
+			EncodeBlock_bc1( i_block, true, o_block );
+			break;
+		case TextureFormats::eFormat::BC3:
+			{
+				float alphas[s_texelCountPerBlock];
+				for ( unsigned int i = 0; i < s_texelCountPerBlock; ++i )
+				{
+					alphas[i] = i_block.texels[i][3];
+				}
+				EncodeBlock_bc4( alphas, o_block );
+				EncodeBlock_bc1( i_block, false, o_block + 8 );
+			}
+			break;
+		case TextureFormats::eFormat::BC5:
+			{
+				for ( unsigned int c = 0; c < 2; ++c )
+				{
+					float values[s_texelCountPerBlock];
+					for ( unsigned int i = 0; i < s_texelCountPerBlock; ++i )
+					{
+						values[i] = i_block.texels[i][c];
+					}
+					EncodeBlock_bc4( values, o_block + ( c * 8 ) );
+				}
+			}
+			break;
+		case TextureFormats::eFormat::BC7:
+			EncodeBlock_bc7( i_block, o_block );
+			break;
+		default:
+			break;
+		}
+	}
+
+	void EncodeBlock_bc1( const sTexelBlock& i_block, const bool i_isPunchThroughAlphaAllowed, uint8_t* const o_block )
+	{
+		const auto Quantize565 = []( const float( &i_color )[4] )
+		{
+			const auto Quantize = []( const float i_value, const unsigned int i_maxValue )
+			{
+				return static_cast<uint16_t>( ( std::min( std::max( i_value, 0.0f ), 255.0f ) * i_maxValue / 255.0f ) + 0.5f );
+			};
+			return static_cast<uint16_t>( ( Quantize( i_color[0], 31 ) << 11 ) | ( Quantize( i_color[1], 63 ) << 5 ) | Quantize( i_color[2], 31 ) );
+		};
+		const auto Expand565 = []( const uint16_t i_color, float( &o_color )[3] )
+		{
+			const auto r = ( i_color >> 11 ) & 0x1f, g = ( i_color >> 5 ) & 0x3f, b = i_color & 0x1f;
+			o_color[0] = static_cast<float>( ( r << 3 ) | ( r >> 2 ) );
+			o_color[1] = static_cast<float>( ( g << 2 ) | ( g >> 4 ) );
+			o_color[2] = static_cast<float>( ( b << 3 ) | ( b >> 2 ) );
+		};
+
+		// Transparent texels don't influence the colors
+		bool isTransparent[s_texelCountPerBlock];
+		auto hasTransparency = false;
+		auto areAllTransparent = true;
+		for ( unsigned int i = 0; i < s_texelCountPerBlock; ++i )
+		{
+			isTransparent[i] = i_isPunchThroughAlphaAllowed && ( i_block.texels[i][3] < 128.0f );
+			hasTransparency = hasTransparency || isTransparent[i];
+			areAllTransparent = areAllTransparent && isTransparent[i];
+		}
+
+		uint16_t color0 = 0, color1 = 0;
+		uint32_t indices = 0;
+		if ( !areAllTransparent )
+		{
+			float mean[4], axis[4];
+			FindPrincipalAxis( i_block, 3, isTransparent, mean, axis );
+			float projection_min = 0.0f, projection_max = 0.0f;
+			for ( unsigned int i = 0; i < s_texelCountPerBlock; ++i )
+			{
+				if ( !isTransparent[i] )
+				{
+					float projection = 0.0f;
+					for ( unsigned int c = 0; c < 3; ++c )
+					{
+						projection += ( i_block.texels[i][c] - mean[c] ) * axis[c];
+					}
+					projection_min = std::min( projection_min, projection );
+					projection_max = std::max( projection_max, projection );
+				}
+			}
+			float endpoint0[4] = {}, endpoint1[4] = {};
+			for ( unsigned int c = 0; c < 3; ++c )
+			{
+				endpoint0[c] = mean[c] + ( axis[c] * projection_max );
+				endpoint1[c] = mean[c] + ( axis[c] * projection_min );
+			}
+			color0 = Quantize565( endpoint0 );
+			color1 = Quantize565( endpoint1 );
+			// The order of the endpoints selects the mode:
+			// color0 > color1 means four colors, otherwise three colors and transparent black
+			if ( hasTransparency ? ( color0 > color1 ) : ( color0 < color1 ) )
+			{
+				std::swap( color0, color1 );
+			}
+
+			float palette[4][3];
+			Expand565( color0, palette[0] );
+			Expand565( color1, palette[1] );
+			const auto isFourColorMode = color0 > color1;
+			for ( unsigned int c = 0; c < 3; ++c )
+			{
+				if ( isFourColorMode )
+				{
+					palette[2][c] = ( ( 2.0f * palette[0][c] ) + palette[1][c] ) / 3.0f;
+					palette[3][c] = ( palette[0][c] + ( 2.0f * palette[1][c] ) ) / 3.0f;
+				}
+				else
+				{
+					palette[2][c] = ( palette[0][c] + palette[1][c] ) / 2.0f;
+					palette[3][c] = 0.0f;
+				}
+			}
+			const unsigned int colorCount = isFourColorMode ? 4 : 3;
+			for ( unsigned int i = 0; i < s_texelCountPerBlock; ++i )
+			{
+				uint32_t index = 3;
+				if ( !isTransparent[i] )
+				{
+					auto error_best = std::numeric_limits<float>::max();
+					for ( uint32_t p = 0; p < colorCount; ++p )
+					{
+						float error = 0.0f;
+						for ( unsigned int c = 0; c < 3; ++c )
+						{
+							const auto difference = i_block.texels[i][c] - palette[p][c];
+							error += difference * difference;
+						}
+						if ( error < error_best )
+						{
+							error_best = error;
+							index = p;
+						}
+					}
+				}
+				indices |= index << ( i * 2 );
+			}
+		}
+		else
+		{
+			// Equal endpoints select the three color mode, where index 3 is transparent
+			indices = 0xffffffff;
+		}
+
+		o_block[0] = static_cast<uint8_t>( color0 & 0xff );
+		o_block[1] = static_cast<uint8_t>( color0 >> 8 );
+		o_block[2] = static_cast<uint8_t>( color1 & 0xff );
+		o_block[3] = static_cast<uint8_t>( color1 >> 8 );
+		for ( unsigned int i = 0; i < 4; ++i )
+		{
+			o_block[4 + i] = static_cast<uint8_t>( indices >> ( i * 8 ) );
+		}
+	}
+
+	void EncodeBlock_bc4( const float( &i_values )[s_texelCountPerBlock], uint8_t* const o_block )
+	{
+		float minimum = 255.0f, maximum = 0.0f;
+		for ( const auto value : i_values )
+		{
+			minimum = std::min( minimum, value );
+			maximum = std::max( maximum, value );
+		}
+		const auto value0 = static_cast<uint8_t>( maximum + 0.5f );
+		const auto value1 = static_cast<uint8_t>( minimum + 0.5f );
+
+		uint64_t indices = 0;
+		// If the endpoints are equal every index is 0
+		if ( value0 > value1 )
+		{
+			// value0 > value1 selects eight interpolated values
+			float palette[8];
+			palette[0] = value0;
+			palette[1] = value1;
+			for ( unsigned int i = 1; i < 7; ++i )
+			{
+				palette[i + 1] = ( ( ( 7 - i ) * static_cast<float>( value0 ) ) + ( i * static_cast<float>( value1 ) ) ) / 7.0f;
+			}
+			for ( unsigned int i = 0; i < s_texelCountPerBlock; ++i )
+			{
+				uint64_t index = 0;
+				auto error_best = std::numeric_limits<float>::max();
+				for ( uint64_t p = 0; p < 8; ++p )
+				{
+					const auto error = std::abs( i_values[i] - palette[p] );
+					if ( error < error_best )
+					{
+						error_best = error;
+						index = p;
+					}
+				}
+				indices |= index << ( i * 3 );
+			}
+		}
+
+		o_block[0] = value0;
+		o_block[1] = value1;
+		for ( unsigned int i = 0; i < 6; ++i )
+		{
+			o_block[2 + i] = static_cast<uint8_t>( indices >> ( i * 8 ) );
+		}
+	}
+
+	void EncodeBlock_bc7( const sTexelBlock& i_block, uint8_t* const o_block )
+	{
+		constexpr uint32_t weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+		float mean[4], axis[4];
+		FindPrincipalAxis( i_block, 4, nullptr, mean, axis );
+		float projection_min = 0.0f, projection_max = 0.0f;
+		for ( unsigned int i = 0; i < s_texelCountPerBlock; ++i )
+		{
+			float projection = 0.0f;
+			for ( unsigned int c = 0; c < 4; ++c )
+			{
+				projection += ( i_block.texels[i][c] - mean[c] ) * axis[c];
+			}
+			projection_min = std::min( projection_min, projection );
+			projection_max = std::max( projection_max, projection );
+		}
+
+		// Each endpoint is 7 bits per component and a shared least significant "p-bit",
+		// and the p-bit that reproduces the endpoint best is chosen
+		uint32_t endpoints[2][4];
+		uint32_t pBits[2];
+		for ( unsigned int e = 0; e < 2; ++e )
+		{
+			float endpoint[4];
+			for ( unsigned int c = 0; c < 4; ++c )
+			{
+				endpoint[c] = std::min( std::max( mean[c] + ( axis[c] * ( ( e == 0 ) ? projection_min : projection_max ) ), 0.0f ), 255.0f );
+			}
+			auto error_best = std::numeric_limits<float>::max();
+			for ( uint32_t pBit = 0; pBit < 2; ++pBit )
+			{
+				uint32_t quantized[4];
+				float error = 0.0f;
+				for ( unsigned int c = 0; c < 4; ++c )
+				{
+					const auto value = std::floor( ( ( endpoint[c] - static_cast<float>( pBit ) ) / 2.0f ) + 0.5f );
+					quantized[c] = static_cast<uint32_t>( std::min( std::max( value, 0.0f ), 127.0f ) );
+					const auto difference = endpoint[c] - static_cast<float>( ( quantized[c] << 1 ) | pBit );
+					error += difference * difference;
+				}
+				if ( error < error_best )
+				{
+					error_best = error;
+					pBits[e] = pBit;
+					std::memcpy( endpoints[e], quantized, sizeof( quantized ) );
+				}
+			}
+		}
+
+		uint32_t indices[s_texelCountPerBlock];
+		{
+			float palette[16][4];
+			for ( unsigned int p = 0; p < 16; ++p )
+			{
+				for ( unsigned int c = 0; c < 4; ++c )
+				{
+					const auto value0 = ( endpoints[0][c] << 1 ) | pBits[0];
+					const auto value1 = ( endpoints[1][c] << 1 ) | pBits[1];
+					palette[p][c] = static_cast<float>( ( ( ( 64 - weights[p] ) * value0 ) + ( weights[p] * value1 ) + 32 ) >> 6 );
+				}
+			}
+			for ( unsigned int i = 0; i < s_texelCountPerBlock; ++i )
+			{
+				auto error_best = std::numeric_limits<float>::max();
+				for ( uint32_t p = 0; p < 16; ++p )
+				{
+					float error = 0.0f;
+					for ( unsigned int c = 0; c < 4; ++c )
+					{
+						const auto difference = i_block.texels[i][c] - palette[p][c];
+						error += difference * difference;
+					}
+					if ( error < error_best )
+					{
+						error_best = error;
+						indices[i] = p;
+					}
+				}
+			}
+		}
+		// The most significant bit of the first index isn't stored and must be zero
+		if ( indices[0] & 0x8 )
+		{
+			std::swap( endpoints[0], endpoints[1] );
+			std::swap( pBits[0], pBits[1] );
+			for ( auto& index : indices )
+			{
+				index = 15 - index;
+			}
+		}
+
+		std::memset( o_block, 0, 16 );
+		cBitWriter bitWriter( o_block );
+		// Mode 6 is a 1 after six 0s
+		bitWriter.Write( 1 << 6, 7 );
+		for ( unsigned int c = 0; c < 4; ++c )
+		{
+			bitWriter.Write( endpoints[0][c], 7 );
+			bitWriter.Write( endpoints[1][c], 7 );
+		}
+		bitWriter.Write( pBits[0], 1 );
+		bitWriter.Write( pBits[1], 1 );
+		bitWriter.Write( indices[0], 3 );
+		for ( unsigned int i = 1; i < s_texelCountPerBlock; ++i )
+		{
+			bitWriter.Write( indices[i], 4 );
+		}
+	}
+}
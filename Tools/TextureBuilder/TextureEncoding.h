@@ -0,0 +1,58 @@
+/*
+	These functions convert decoded images into built textures
+	(see Engine/Graphics/TextureFormats.h)
+
+	They only depend on the standard library
+	so that they can be used both by the Windows builder
+	and by the command line tool that batch-converts textures on Linux
+*/
+
+#ifndef EAE6320_TEXTUREENCODING_H
+#define EAE6320_TEXTUREENCODING_H
+
+// Includes
+//=========
+
+#include <cstdint>
+#include <Engine/Graphics/TextureFormats.h>
+#include <Engine/Results/Results.h>
+#include <string>
+#include <vector>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace TextureEncoding
+		{
+			struct sImage
+			{
+				// 4 8-bit components (RGBA) per texel, with tightly packed rows
+				std::vector<uint8_t> texels;
+				uint32_t width = 0;
+				uint32_t height = 0;
+			};
+
+			// Every mip is filtered from the one above it with a tent filter that wraps around the edges
+			// (color textures are filtered in linear space)
+			void GenerateMipChain( const sImage& i_image, const bool i_isSRGB, std::vector<sImage>& o_mipChain );
+
+			// Encodes a mip into GetMipSize() bytes of blocks
+			// (the rows of blocks are split between i_threadCount threads, or every hardware thread if it is zero)
+			void EncodeMip( const Graphics::TextureFormats::eFormat i_format, const sImage& i_mip, uint8_t* const o_blocks,
+				const unsigned int i_threadCount = 0 );
+
+			// Builds a complete texture file (header and every mip) from a decoded image
+			cResult BuildTexture( const sImage& i_image, const Graphics::TextureFormats::eFormat i_format, const bool i_isSRGB,
+				std::vector<uint8_t>& o_builtTexture, std::string* const o_errorMessage = nullptr );
+
+			// Parses a format name ("bc1", "bc3", "bc5", or "bc7")
+			bool ParseFormat( const std::string& i_name, Graphics::TextureFormats::eFormat& o_format );
+		}
+	}
+}
+
+#endif	// EAE6320_TEXTUREENCODING_H
@@ -0,0 +1,89 @@
+// Includes
+//=========
+
+#include "cTextureBuilder.h"
+
+#include "TextureEncoding.h"
+
+#include <Engine/Platform/Platform.h>
+#include <Engine/ScopeGuard/cScopeGuard.h>
+#include <Tools/AssetBuildLibrary/Functions.h>
+
+// Interface
+//==========
+
+// Build
+//------
+
+eae6320::cResult eae6320::Assets::cTextureBuilder::BuildTextureFile( const char* const i_path_source, const char* const i_path_target,
+	const Graphics::TextureFormats::eFormat i_format, const bool i_isSRGB, std::string* const o_errorMessage )
+{
+	auto result = Results::Success;
+
+	// Decode the source image
+	TextureEncoding::sImage image;
+	{
+		unsigned char* decodedData = nullptr;
+		cScopeGuard scopeGuard_decodedData( [&decodedData]
+			{
+				if ( decodedData )
+				{
+					free( decodedData );
+					decodedData = nullptr;
+				}
+			} );
+		int width = 0, height = 0, componentCount = 0;
+		constexpr int requiredComponentCount = 4;
+		if ( !( result = Platform::LoadTextureFile( i_path_source, decodedData, width, height, componentCount, requiredComponentCount, o_errorMessage ) ) )
+		{
+			return result;
+		}
+		image.width = static_cast<uint32_t>( width );
+		image.height = static_cast<uint32_t>( height );
+		image.texels.assign( decodedData, decodedData + ( static_cast<size_t>( width ) * height * requiredComponentCount ) );
+	}
+
+	// Build and write the texture
+	std::vector<uint8_t> builtTexture;
+	if ( !( result = TextureEncoding::BuildTexture( image, i_format, i_isSRGB, builtTexture, o_errorMessage ) ) )
+	{
+		return result;
+	}
+	if ( !( result = Platform::CreateDirectoryIfItDoesntExist( i_path_target, o_errorMessage ) ) )
+	{
+		return result;
+	}
+	return Platform::WriteBinaryFile( i_path_target, builtTexture.data(), builtTexture.size(), o_errorMessage );
+}
+
+// Inherited Implementation
+//=========================
+
+// Build
+//------
+
+eae6320::cResult eae6320::Assets::cTextureBuilder::Build( const std::vector<std::string>& i_arguments )
+{
+	auto format = Graphics::TextureFormats::eFormat::BC7;
+	auto isSRGB = true;
+	for ( const auto& argument : i_arguments )
+	{
+		if ( argument == "linear" )
+		{
+			isSRGB = false;
+		}
+		else if ( !TextureEncoding::ParseFormat( argument, format ) )
+		{
+			OutputErrorMessageWithFileInfo( m_path_source, "Unknown texture builder argument \"%s\"", argument.c_str() );
+			return Results::Failure;
+		}
+	}
+
+	std::string errorMessage;
+	const auto result = BuildTextureFile( m_path_source, m_path_target, format, isSRGB, &errorMessage );
+	if ( !result )
+	{
+		OutputErrorMessageWithFileInfo( m_path_source, errorMessage.c_str() );
+	}
+	return result;
+}
@@ -0,0 +1,56 @@
+/*
+	This class builds textures
+
+	The source image is decoded, a complete mip chain is generated,
+	and every mip is block-compressed so that the game can upload it directly
+	(see Engine/Graphics/TextureFormats.h)
+
+	Optional arguments:
+		* The format ("bc1", "bc3", "bc5", or "bc7"; the default is "bc7")
+		* "linear" if the texels aren't sRGB colors (e.g. normal or specular maps)
+*/
+
+#ifndef EAE6320_CTEXTUREBUILDER_H
+#define EAE6320_CTEXTUREBUILDER_H
+
+// Includes
+//=========
+
+#include <Engine/Graphics/TextureFormats.h>
+#include <Tools/AssetBuildLibrary/iBuilder.h>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		class cTextureBuilder final : public iBuilder
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Build
+			//------
+
+			// This is also used by other builders that build the textures that their assets reference
+			static cResult BuildTextureFile( const char* const i_path_source, const char* const i_path_target,
+				const Graphics::TextureFormats::eFormat i_format, const bool i_isSRGB, std::string* const o_errorMessage = nullptr );
+
+			// Inherited Implementation
+			//=========================
+
+		private:
+
+			// Build
+			//------
+
+			cResult Build( const std::vector<std::string>& i_arguments ) final;
+		};
+	}
+}
+
+#endif // EAE6320_CTEXTUREBUILDER_H